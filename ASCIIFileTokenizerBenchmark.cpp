@@ -0,0 +1,272 @@
+/***********************************************************************
+ASCIIFileTokenizerBenchmark - Headless program to measure the read
+throughput of the buffered ASCII file tokenizer against fscanf and
+getline+sscanf on a synthetic meshtal-style data file, and to check its
+number conversion against strtod.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <Misc/Timer.h>
+
+#include <Concrete/ASCIIFileTokenizer.h>
+
+double randUniform(double min,double max) // Returns a uniformly distributed random number in [min, max)
+	{
+	return min+(max-min)*double(rand())/(double(RAND_MAX)+1.0);
+	}
+
+double powerOfTen(int exponent) // Returns an integer power of ten
+	{
+	double result=1.0;
+	for(int i=0;i<exponent;++i)
+		result*=10.0;
+	for(int i=0;i>exponent;--i)
+		result/=10.0;
+	return result;
+	}
+
+void writeMeshFile(const char* fileName,int gridSize) // Writes a meshtal-style file of five numbers per grid vertex
+	{
+	FILE* file=fopen(fileName,"wt");
+	fprintf(file,"%d %d %d\n",gridSize,gridSize,gridSize);
+	size_t numVertices=size_t(gridSize)*size_t(gridSize)*size_t(gridSize);
+	for(size_t i=0;i<numVertices;++i)
+		{
+		double flux=randUniform(0.0,1.0)*powerOfTen(rand()%16-12);
+		fprintf(file," %.3f %.3f %.3f %.5E %.4f\n",randUniform(-100.0,100.0),randUniform(-100.0,100.0),randUniform(-100.0,100.0),flux,randUniform(0.0,1.0));
+		}
+	fclose(file);
+	}
+
+void writeMixedFile(const char* fileName,std::vector<std::string>& numbers,size_t numNumbers) // Writes numbers in mixed C and Fortran notations and returns their C notations
+	{
+	FILE* file=fopen(fileName,"wt");
+	char number[128];
+	for(size_t i=0;i<numNumbers;++i)
+		{
+		switch(rand()%6)
+			{
+			case 0:
+				snprintf(number,sizeof(number),"%.17g",randUniform(-1.0,1.0)*powerOfTen(rand()%600-300));
+				break;
+			
+			case 1:
+				snprintf(number,sizeof(number),"%.6e",randUniform(0.0,1.0)*powerOfTen(rand()%628-320));
+				break;
+			
+			case 2:
+				snprintf(number,sizeof(number),"%d",rand()-RAND_MAX/2);
+				break;
+			
+			case 3:
+				snprintf(number,sizeof(number),"%.3fD%+03d",randUniform(-10.0,10.0),rand()%61-30);
+				break;
+			
+			case 4:
+				snprintf(number,sizeof(number),"%.25f",randUniform(0.0,1.0));
+				break;
+			
+			default:
+				snprintf(number,sizeof(number),"%.12E",randUniform(-1.0e-5,1.0e-5));
+			}
+		fprintf(file,"%s%c",number,rand()%10<3?'\n':' ');
+		
+		/* Store the number in C notation: */
+		for(char* nPtr=number;*nPtr!='\0';++nPtr)
+			if(*nPtr=='D')
+				*nPtr='e';
+		numbers.push_back(number);
+		}
+	fclose(file);
+	}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	int gridSize=60; // Number of vertices along each axis of the synthetic mesh file
+	size_t numNumbers=200000; // Number of mixed-notation numbers checked against strtod
+	int numRepeats=2; // Number of times each reader is timed
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"size")==0)
+				{
+				++i;
+				if(i<argc)
+					gridSize=atoi(argv[i]);
+				else
+					std::cerr<<"ASCIIFileTokenizerBenchmark: ignored dangling -size option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"numbers")==0)
+				{
+				++i;
+				if(i<argc)
+					numNumbers=size_t(atol(argv[i]));
+				else
+					std::cerr<<"ASCIIFileTokenizerBenchmark: ignored dangling -numbers option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"repeats")==0)
+				{
+				++i;
+				if(i<argc)
+					numRepeats=atoi(argv[i]);
+				else
+					std::cerr<<"ASCIIFileTokenizerBenchmark: ignored dangling -repeats option"<<std::endl;
+				}
+			else
+				std::cerr<<"ASCIIFileTokenizerBenchmark: ignored unrecognized option "<<argv[i]<<std::endl;
+			}
+		}
+	if(gridSize<1||numRepeats<1)
+		{
+		std::cerr<<"ASCIIFileTokenizerBenchmark: invalid benchmark parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create the synthetic data files: */
+	char meshFileName[]="/tmp/ASCIIFileTokenizerBenchmarkMeshXXXXXX";
+	char mixedFileName[]="/tmp/ASCIIFileTokenizerBenchmarkMixedXXXXXX";
+	int meshFd=mkstemp(meshFileName);
+	int mixedFd=mkstemp(mixedFileName);
+	if(meshFd<0||mixedFd<0)
+		{
+		std::cerr<<"ASCIIFileTokenizerBenchmark: unable to create temporary files"<<std::endl;
+		return 1;
+		}
+	close(meshFd);
+	close(mixedFd);
+	srand(1);
+	writeMeshFile(meshFileName,gridSize);
+	std::vector<std::string> numbers;
+	writeMixedFile(mixedFileName,numbers,numNumbers);
+	struct stat meshStat;
+	stat(meshFileName,&meshStat);
+	double meshSize=double(meshStat.st_size)/(1024.0*1024.0);
+	size_t numVertices=size_t(gridSize)*size_t(gridSize)*size_t(gridSize);
+	std::cout<<"Mesh file          : "<<gridSize<<"^3 vertices, "<<meshSize<<" MB"<<std::endl;
+	
+	int result=0;
+	try
+		{
+		/* Check the tokenizer's number conversion against strtod: */
+		size_t numMismatches=0;
+		{
+		Visualization::Concrete::ASCIIFileTokenizer tokenizer(mixedFileName,4096);
+		for(std::vector<std::string>::const_iterator nIt=numbers.begin();nIt!=numbers.end();++nIt)
+			{
+			double expected=strtod(nIt->c_str(),0);
+			double value=tokenizer.readDouble();
+			if(memcmp(&expected,&value,sizeof(double))!=0)
+				{
+				if(numMismatches<5)
+					std::cout<<"Mismatch           : "<<*nIt<<std::endl;
+				++numMismatches;
+				}
+			}
+		if(!tokenizer.eof())
+			++numMismatches;
+		}
+		std::cout<<"Conversion check   : "<<numbers.size()<<" numbers, "<<numMismatches<<" mismatches against strtod"<<std::endl;
+		if(numMismatches!=0)
+			result=1;
+		
+		for(int repeat=0;repeat<numRepeats;++repeat)
+			{
+			double checkSums[3]={0.0,0.0,0.0};
+			
+			/* Read the mesh file with fscanf: */
+			Misc::Timer fscanfTimer;
+			{
+			FILE* file=fopen(meshFileName,"rt");
+			int size[3];
+			if(fscanf(file,"%d %d %d",&size[0],&size[1],&size[2])!=3)
+				result=1;
+			for(size_t i=0;i<numVertices;++i)
+				{
+				double values[5];
+				if(fscanf(file,"%lf %lf %lf %lf %lf",&values[0],&values[1],&values[2],&values[3],&values[4])!=5)
+					result=1;
+				checkSums[0]+=values[3];
+				}
+			fclose(file);
+			}
+			fscanfTimer.elapse();
+			
+			/* Read the mesh file with getline and sscanf: */
+			Misc::Timer sscanfTimer;
+			{
+			std::ifstream file(meshFileName);
+			std::string line;
+			std::getline(file,line);
+			while(std::getline(file,line))
+				{
+				double values[5];
+				if(sscanf(line.c_str(),"%lf %lf %lf %lf %lf",&values[0],&values[1],&values[2],&values[3],&values[4])!=5)
+					result=1;
+				checkSums[1]+=values[3];
+				}
+			}
+			sscanfTimer.elapse();
+			
+			/* Read the mesh file with the tokenizer: */
+			Misc::Timer tokenizerTimer;
+			{
+			Visualization::Concrete::ASCIIFileTokenizer tokenizer(meshFileName);
+			for(int i=0;i<3;++i)
+				tokenizer.readInteger();
+			for(size_t i=0;i<numVertices;++i)
+				{
+				double values[5];
+				tokenizer.readValues(values,5);
+				checkSums[2]+=values[3];
+				}
+			}
+			tokenizerTimer.elapse();
+			
+			std::cout<<"Pass "<<repeat<<"             : fscanf "<<meshSize/fscanfTimer.getTime()<<" MB/s, getline+sscanf "<<meshSize/sscanfTimer.getTime()<<" MB/s, tokenizer "<<meshSize/tokenizerTimer.getTime()<<" MB/s"<<std::endl;
+			if(checkSums[0]!=checkSums[2]||checkSums[1]!=checkSums[2])
+				{
+				std::cout<<"Checksum mismatch  : "<<checkSums[0]<<", "<<checkSums[1]<<", "<<checkSums[2]<<std::endl;
+				result=1;
+				}
+			}
+		}
+	catch(const std::runtime_error& err)
+		{
+		std::cerr<<"ASCIIFileTokenizerBenchmark: caught exception "<<err.what()<<std::endl;
+		result=1;
+		}
+	
+	/* Clean up: */
+	unlink(meshFileName);
+	unlink(mixedFileName);
+	
+	return result;
+	}
@@ -33,14 +33,71 @@ namespace Visualization {
 
 namespace Abstract {
 
+/**********************************
+Static elements of class Algorithm:
+**********************************/
+
+unsigned int Algorithm::defaultNumThreads=1;
+unsigned int Algorithm::elementStreamPositionBits=0;
+unsigned int Algorithm::elementStreamNormalBits=12;
+bool Algorithm::localSlaveExtraction=false;
+bool Algorithm::defaultUseCellIndex=true;
+bool Algorithm::defaultUseEdgeSlabs=true;
+bool Algorithm::defaultIncrementalUpdate=false;
+bool Algorithm::defaultProgressiveRefinement=false;
+bool Algorithm::defaultUseGradientCache=true;
+
 /***************************
 Methods of class Algortithm:
 ***************************/
 
+void Algorithm::setDefaultNumThreads(unsigned int newDefaultNumThreads)
+	{
+	defaultNumThreads=newDefaultNumThreads>0?newDefaultNumThreads:1;
+	}
+
+void Algorithm::setElementStreamPrecision(unsigned int newPositionBits,unsigned int newNormalBits)
+	{
+	elementStreamPositionBits=newPositionBits;
+	elementStreamNormalBits=newNormalBits;
+	}
+
+void Algorithm::setLocalSlaveExtraction(bool newLocalSlaveExtraction)
+	{
+	localSlaveExtraction=newLocalSlaveExtraction;
+	}
+
+void Algorithm::setDefaultUseCellIndex(bool newDefaultUseCellIndex)
+	{
+	defaultUseCellIndex=newDefaultUseCellIndex;
+	}
+
+void Algorithm::setDefaultUseEdgeSlabs(bool newDefaultUseEdgeSlabs)
+	{
+	defaultUseEdgeSlabs=newDefaultUseEdgeSlabs;
+	}
+
+void Algorithm::setDefaultIncrementalUpdate(bool newDefaultIncrementalUpdate)
+	{
+	defaultIncrementalUpdate=newDefaultIncrementalUpdate;
+	}
+
+void Algorithm::setDefaultProgressiveRefinement(bool newDefaultProgressiveRefinement)
+	{
+	defaultProgressiveRefinement=newDefaultProgressiveRefinement;
+	}
+
+void Algorithm::setDefaultUseGradientCache(bool newDefaultUseGradientCache)
+	{
+	defaultUseGradientCache=newDefaultUseGradientCache;
+	}
+
 Algorithm::Algorithm(VariableManager* sVariableManager,Comm::MulticastPipe* sPipe)
 	:variableManager(sVariableManager),pipe(sPipe),
 	 master(pipe==0||pipe->isMaster()),
-	 busyFunction(0)
+	 busyFunction(0),
+	 numThreads(defaultNumThreads),
+	 firstGeometryTime(0.0),finalGeometryTime(0.0)
 	{
 	}
 
@@ -53,6 +110,17 @@ Algorithm::~Algorithm(void)
 	delete busyFunction;
 	}
 
+void Algorithm::setNumThreads(unsigned int newNumThreads)
+	{
+	numThreads=newNumThreads>0?newNumThreads:1;
+	}
+
+void Algorithm::setGeometryTimes(double newFirstGeometryTime,double newFinalGeometryTime)
+	{
+	firstGeometryTime=newFirstGeometryTime;
+	finalGeometryTime=newFinalGeometryTime;
+	}
+
 void Algorithm::setBusyFunction(Algorithm::BusyFunction* newBusyFunction)
 	{
 	/* Delete the previous busy function: */
@@ -77,6 +145,11 @@ bool Algorithm::hasIncrementalCreator(void) const
 	return false;
 	}
 
+bool Algorithm::hasDeterministicCreator(void) const
+	{
+	return false;
+	}
+
 GLMotif::Widget* Algorithm::createSettingsDialog(GLMotif::WidgetManager* widgetManager)
 	{
 	return 0;
@@ -98,6 +171,21 @@ Element* Algorithm::createElement(Parameters* extractParameters)
 	return 0;
 	}
 
+unsigned int Algorithm::getNumPreviewStages(void) const
+	{
+	return 0;
+	}
+
+Element* Algorithm::createPreviewElement(Parameters* extractParameters,unsigned int)
+	{
+	/* Inherit the parameters object: */
+	delete extractParameters;
+	
+	/* Signal an error: */
+	Misc::throwStdErr("Algorithm: No preview element creation method defined");
+	return 0;
+	}
+
 Element* Algorithm::startElement(Parameters* extractParameters)
 	{
 	/* Inherit the parameters object: */
@@ -124,6 +212,16 @@ void Algorithm::continueSlaveElement(void)
 	/* Just don't do anything */
 	}
 
+size_t Algorithm::getNumVisitedCells(void) const
+	{
+	return 0;
+	}
+
+size_t Algorithm::getNumRevisitedCells(void) const
+	{
+	return 0;
+	}
+
 }
 
 }
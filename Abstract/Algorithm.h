@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_ABSTRACT_ALGORITHM_INCLUDED
 #define VISUALIZATION_ABSTRACT_ALGORITHM_INCLUDED
 
+#include <stddef.h>
 #include <Misc/FunctionCalls.h>
 
 #include <Abstract/DataSet.h>
@@ -60,10 +61,22 @@ class Algorithm
 	
 	/* Elements: */
 	private:
+	static unsigned int defaultNumThreads; // Number of threads newly created algorithms may use to extract visualization elements
+	static unsigned int elementStreamPositionBits; // Number of bits per quantized position component when streaming visualization elements to the slave nodes of a cluster; 0 streams uncompressed elements
+	static unsigned int elementStreamNormalBits; // Number of bits per quantized normal vector component when streaming visualization elements
+	static bool localSlaveExtraction; // Flag whether the slave nodes of a cluster extract visualization elements themselves if the algorithm's creation methods are deterministic
+	static bool defaultUseCellIndex; // Flag whether newly created algorithms only visit the cells found by a value range index instead of sweeping all cells, if they support one
+	static bool defaultUseEdgeSlabs; // Flag whether newly created algorithms share the vertices of surfaces extracted from structured grids through edge slabs instead of a hash table, if they support it
+	static bool defaultIncrementalUpdate; // Flag whether newly created algorithms update their previous visualization element instead of extracting from scratch, if they support it
+	static bool defaultProgressiveRefinement; // Flag whether newly created algorithms deliver coarse previews before complete visualization elements, if they support them
+	static bool defaultUseGradientCache; // Flag whether newly created algorithms look up smooth shading gradients in their data sets' gradient caches, if they support them
 	VariableManager* variableManager; // Pointer to the variable manager containing the source data set and variables for this algorithm
 	Comm::MulticastPipe* pipe; // Multicast pipe to synchronize element extraction in a cluster-based environment; created externally but owned by Algorithm object
 	bool master; // Flag if this instance of the algorithm runs on the master node of a visualization cluster
 	BusyFunction* busyFunction; // Function called at regular intervals during a long-running operation
+	unsigned int numThreads; // Number of threads this algorithm may use to extract visualization elements
+	double firstGeometryTime; // Time in seconds from the most recent extraction request until its first preview or complete visualization element was available
+	double finalGeometryTime; // Time in seconds from the most recent extraction request until its complete visualization element was available
 	
 	/* Constructors and destructors: */
 	public:
@@ -75,6 +88,50 @@ class Algorithm
 	virtual ~Algorithm(void); // Destroys the visualization algorithm
 	
 	/* Methods: */
+	static unsigned int getDefaultNumThreads(void) // Returns the default number of extraction threads
+		{
+		return defaultNumThreads;
+		}
+	static void setDefaultNumThreads(unsigned int newDefaultNumThreads); // Sets the number of extraction threads for subsequently created algorithms
+	static unsigned int getElementStreamPositionBits(void) // Returns the number of bits per quantized position component in streamed visualization elements
+		{
+		return elementStreamPositionBits;
+		}
+	static unsigned int getElementStreamNormalBits(void) // Returns the number of bits per quantized normal vector component in streamed visualization elements
+		{
+		return elementStreamNormalBits;
+		}
+	static void setElementStreamPrecision(unsigned int newPositionBits,unsigned int newNormalBits); // Sets the quantization precision of visualization elements streamed to slave nodes; zero position bits streams uncompressed elements
+	static bool getLocalSlaveExtraction(void) // Returns true if slave nodes extract visualization elements of deterministic algorithms themselves
+		{
+		return localSlaveExtraction;
+		}
+	static void setLocalSlaveExtraction(bool newLocalSlaveExtraction); // Sets whether slave nodes extract visualization elements of deterministic algorithms themselves
+	static bool getDefaultUseCellIndex(void) // Returns true if newly created algorithms use value range indices
+		{
+		return defaultUseCellIndex;
+		}
+	static void setDefaultUseCellIndex(bool newDefaultUseCellIndex); // Sets whether subsequently created algorithms use value range indices
+	static bool getDefaultUseEdgeSlabs(void) // Returns true if newly created algorithms share surface vertices through edge slabs
+		{
+		return defaultUseEdgeSlabs;
+		}
+	static void setDefaultUseEdgeSlabs(bool newDefaultUseEdgeSlabs); // Sets whether subsequently created algorithms share surface vertices through edge slabs
+	static bool getDefaultIncrementalUpdate(void) // Returns true if newly created algorithms update their previous visualization elements
+		{
+		return defaultIncrementalUpdate;
+		}
+	static void setDefaultIncrementalUpdate(bool newDefaultIncrementalUpdate); // Sets whether subsequently created algorithms update their previous visualization elements
+	static bool getDefaultProgressiveRefinement(void) // Returns true if newly created algorithms deliver coarse previews
+		{
+		return defaultProgressiveRefinement;
+		}
+	static void setDefaultProgressiveRefinement(bool newDefaultProgressiveRefinement); // Sets whether subsequently created algorithms deliver coarse previews
+	static bool getDefaultUseGradientCache(void) // Returns true if newly created algorithms look up smooth shading gradients in gradient caches
+		{
+		return defaultUseGradientCache;
+		}
+	static void setDefaultUseGradientCache(bool newDefaultUseGradientCache); // Sets whether subsequently created algorithms look up smooth shading gradients in gradient caches
 	VariableManager* getVariableManager(void) const // Returns the algorithm's variable manager
 		{
 		return variableManager;
@@ -87,6 +144,28 @@ class Algorithm
 		{
 		return master;
 		}
+	bool extractsLocally(void) const // Returns true if all nodes of a cluster extract visualization elements themselves instead of streaming them from the master
+		{
+		return pipe!=0&&localSlaveExtraction&&hasDeterministicCreator();
+		}
+	Comm::MulticastPipe* getElementPipe(void) const // Returns the pipe across which newly created visualization elements are streamed to the slave nodes, or 0 if elements are not streamed
+		{
+		return extractsLocally()?0:pipe;
+		}
+	unsigned int getNumThreads(void) const // Returns the number of threads the algorithm may use
+		{
+		return numThreads;
+		}
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads the algorithm may use
+	double getFirstGeometryTime(void) const // Returns the time from the most recent extraction request until its first geometry was available in seconds
+		{
+		return firstGeometryTime;
+		}
+	double getFinalGeometryTime(void) const // Returns the time from the most recent extraction request until its complete visualization element was available in seconds
+		{
+		return finalGeometryTime;
+		}
+	void setGeometryTimes(double newFirstGeometryTime,double newFinalGeometryTime); // Records the times until the first geometry and the complete visualization element of an extraction request were available
 	void setBusyFunction(BusyFunction* newBusyFunction); // Sets the busy function; object inherits function call object
 	void callBusyFunction(float completionPercentage) // Calls the busy function with a new percentage value
 		{
@@ -97,15 +176,20 @@ class Algorithm
 	virtual bool hasGlobalCreator(void) const; // Returns true if the algorithm has a global creation method
 	virtual bool hasSeededCreator(void) const; // Returns true if the algorithm has a seeded creation method
 	virtual bool hasIncrementalCreator(void) const; // Returns true if the algorithm has incremental creation methods
+	virtual bool hasDeterministicCreator(void) const; // Returns true if the algorithm's creation methods create identical visualization elements from identical parameters on every node of a cluster
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager); // Returns a new UI widget to change internal settings of the algorithm
 	virtual Parameters* cloneParameters(void) const =0; // Returns a copy of the algorithm's current extraction parameters
 	virtual void setSeedLocator(const DataSet::Locator* seedLocator); // Updates the algorithm's current extraction parameters according to the given seed locator
 	virtual Element* createElement(Parameters* extractParameters); // Creates a complete visualization element using the current extraction settings; inherits parameter object
+	virtual unsigned int getNumPreviewStages(void) const; // Returns the number of coarse previews of increasing resolution to deliver before a complete visualization element is created; 0 disables previews
+	virtual Element* createPreviewElement(Parameters* extractParameters,unsigned int stage); // Creates a coarse preview of a visualization element for the given refinement stage, starting from 0; inherits parameter object
 	virtual Element* startElement(Parameters* extractParameters); // Starts creating a visualization element using the current extraction settings; inherits parameter object
 	virtual bool continueElement(const Realtime::AlarmTimer& alarm); // Continues creating the current element; returns true if element is complete
 	virtual void finishElement(void); // Cleans up after an element has been created
 	virtual Element* startSlaveElement(Parameters* extractParameters) =0; // Starts creating a visualization element on the slave node(s) of a cluster environment; inherits parameter object
 	virtual void continueSlaveElement(void); // Receives a fragment of a visualization element on the slave node(s) of a cluster environment
+	virtual size_t getNumVisitedCells(void) const; // Returns the number of data set cells visited while creating the most recent visualization element, or 0 if the algorithm does not count visited cells
+	virtual size_t getNumRevisitedCells(void) const; // Returns the number of visited cells that already contributed to the algorithm's previous visualization element during an incremental update, or 0
 	};
 
 }
@@ -29,6 +29,12 @@ namespace Visualization {
 
 namespace Abstract {
 
+/********************************
+Static elements of class DataSet:
+********************************/
+
+size_t DataSet::gradientCacheBudget=0;
+
 /*********************************
 Methods of class DataSet::Locator:
 *********************************/
@@ -65,6 +71,11 @@ bool DataSet::Locator::setOrientation(const DataSet::Orientation& newOrientation
 Methods of class DataSet:
 ************************/
 
+void DataSet::setGradientCacheBudget(size_t newGradientCacheBudget)
+	{
+	gradientCacheBudget=newGradientCacheBudget;
+	}
+
 int DataSet::getNumScalarVariables(void) const
 	{
 	return 0;
@@ -82,6 +93,24 @@ ScalarExtractor* DataSet::getScalarExtractor(int scalarVariableIndex) const
 	return 0;
 	}
 
+DataSet::VScalarRange DataSet::calcScalarVariableRange(int scalarVariableIndex) const
+	{
+	/* Calculate the range using a temporary scalar extractor: */
+	ScalarExtractor* scalarExtractor=getScalarExtractor(scalarVariableIndex);
+	VScalarRange result=calcScalarValueRange(scalarExtractor);
+	delete scalarExtractor;
+	
+	return result;
+	}
+
+void DataSet::calcScalarVariableHistogram(int scalarVariableIndex,const DataSet::VScalarRange& valueRange,DataSet::VScalarHistogram& histogram) const
+	{
+	/* Count the values using a temporary scalar extractor: */
+	ScalarExtractor* scalarExtractor=getScalarExtractor(scalarVariableIndex);
+	calcScalarValueHistogram(scalarExtractor,valueRange,histogram);
+	delete scalarExtractor;
+	}
+
 int DataSet::getNumVectorVariables(void) const
 	{
 	return 0;
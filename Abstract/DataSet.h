@@ -24,7 +24,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_ABSTRACT_DATASET_INCLUDED
 #define VISUALIZATION_ABSTRACT_DATASET_INCLUDED
 
+#include <stddef.h>
 #include <utility>
+#include <vector>
 #include <Geometry/Point.h>
 #include <Geometry/Rotation.h>
 #include <Geometry/Box.h>
@@ -54,6 +56,7 @@ class DataSet
 	typedef ScalarExtractor::Scalar VScalar; // Scalar value type
 	typedef VectorExtractor::Vector VVector; // Vector value type
 	typedef std::pair<VScalar,VScalar> VScalarRange; // Type for scalar value ranges
+	typedef std::vector<size_t> VScalarHistogram; // Type for histograms counting scalar values in equally-sized bins across a value range
 	
 	class Locator // Class to encapsulate probes to evaluate data sets at arbitrary positions
 		{
@@ -89,6 +92,10 @@ class DataSet
 		virtual VVector calcVector(const VectorExtractor* vectorExtractor) const =0; // Calculates vector value at current locator position (locator must be valid)
 		};
 	
+	/* Elements: */
+	private:
+	static size_t gradientCacheBudget; // Maximum number of bytes each data set may use to cache the vertex gradients of its scalar variables; 0 disables gradient caching
+	
 	/* Constructors and destructors: */
 	public:
 	DataSet(void) // Default constructor
@@ -103,6 +110,11 @@ class DataSet
 		}
 	
 	/* Methods: */
+	static size_t getGradientCacheBudget(void) // Returns the maximum number of bytes each data set may use to cache vertex gradients
+		{
+		return gradientCacheBudget;
+		}
+	static void setGradientCacheBudget(size_t newGradientCacheBudget); // Sets the maximum number of bytes each data set may use to cache vertex gradients; 0 disables gradient caching
 	virtual CoordinateTransformer* getCoordinateTransformer(void) const =0; // Returns a new coordinate transformer from the data set's Cartesian coordinates back to its source coordinates
 	virtual Box getDomainBox(void) const =0; // Returns an axis-aligned box enclosing the data set's domain
 	virtual Scalar calcAverageCellSize(void) const =0; // Returns an estimate of the data set's average cell size
@@ -110,6 +122,9 @@ class DataSet
 	virtual const char* getScalarVariableName(int scalarVariableIndex) const; // Returns descriptive name of a scalar variable
 	virtual ScalarExtractor* getScalarExtractor(int scalarVariableIndex) const; // Returns scalar extractor for a scalar variable
 	virtual VScalarRange calcScalarValueRange(const ScalarExtractor* scalarExtractor) const =0; // Calculates the range of scalar values extracted by the given extractor
+	virtual VScalarRange calcScalarVariableRange(int scalarVariableIndex) const; // Returns the value range of a scalar variable; data sets may return a range they calculated together with those of their other scalar variables
+	virtual void calcScalarValueHistogram(const ScalarExtractor* scalarExtractor,const VScalarRange& valueRange,VScalarHistogram& histogram) const =0; // Counts the scalar values extracted by the given extractor into the histogram's bins, which evenly divide the given value range
+	virtual void calcScalarVariableHistogram(int scalarVariableIndex,const VScalarRange& valueRange,VScalarHistogram& histogram) const; // Counts the values of a scalar variable into the histogram's bins; data sets may return a histogram they counted together with those of their other scalar variables
 	virtual int getNumVectorVariables(void) const; // Returns number of vector variables contained in the data set
 	virtual const char* getVectorVariableName(int vectorVariableIndex) const; // Returns descriptive name of a vector variable
 	virtual VectorExtractor* getVectorExtractor(int vectorVariableIndex) const; // Returns vector extractor for a vector variable
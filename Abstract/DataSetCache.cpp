@@ -0,0 +1,312 @@
+/***********************************************************************
+DataSetCache - Class to store loaded data sets in versioned binary cache
+files next to their source files, to skip parsing the source files on
+subsequent loads.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Abstract/DataSetCache.h>
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <Misc/ThrowStdErr.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+namespace {
+
+/*************************************
+Constants describing the cache format:
+*************************************/
+
+const char cacheFileSuffix[]=".3dvcache"; // Suffix appended to the source file name to form the cache file name
+const char headerMagic[8]={'3','D','V','C','a','c','h','e'}; // Identifier at the beginning of every cache file
+const char trailerMagic[8]={'3','D','V','C','E','n','d','\0'}; // Identifier at the end of every completely written cache file
+const unsigned int cacheFormatVersion=1; // Version of the cache file format; must be increased whenever the layout of any cached data set type changes
+const unsigned int byteOrderMark=0x01020304U; // Value to detect cache files written on machines of different byte order
+const size_t arrayAlignment=16; // Alignment of arrays in cache files
+
+/****************
+Helper functions:
+****************/
+
+struct SourceStamp // Structure identifying the state of a file named by a data set argument
+	{
+	/* Elements: */
+	public:
+	unsigned long long size; // Size of the file; zero if the argument does not name a regular file
+	long long time; // Modification time of the file; zero if the argument does not name a regular file
+	};
+
+bool getSourceStamps(const std::vector<std::string>& args,std::vector<SourceStamp>& stamps) // Returns the sizes and modification times of all files named by the data set arguments; returns false if the first argument does not name a regular file
+	{
+	stamps.clear();
+	for(std::vector<std::string>::const_iterator aIt=args.begin();aIt!=args.end();++aIt)
+		{
+		SourceStamp stamp;
+		struct stat sourceStat;
+		if(stat(aIt->c_str(),&sourceStat)==0&&S_ISREG(sourceStat.st_mode))
+			{
+			stamp.size=(unsigned long long)sourceStat.st_size;
+			stamp.time=(long long)sourceStat.st_mtime;
+			}
+		else if(aIt==args.begin())
+			return false;
+		else
+			{
+			stamp.size=0;
+			stamp.time=0;
+			}
+		stamps.push_back(stamp);
+		}
+	return !stamps.empty();
+	}
+
+}
+
+/*************************************
+Methods of class DataSetCache::Writer:
+*************************************/
+
+void DataSetCache::Writer::writeRaw(const void* data,size_t size)
+	{
+	if(size>0&&fwrite(data,1,size,file)!=size)
+		Misc::throwStdErr("DataSetCache::Writer: Error while writing cache file %s",tempFileName.c_str());
+	offset+=size;
+	}
+
+void DataSetCache::Writer::align(void)
+	{
+	static const char padding[arrayAlignment]={0};
+	writeRaw(padding,(arrayAlignment-offset%arrayAlignment)%arrayAlignment);
+	}
+
+DataSetCache::Writer::Writer(const char* moduleClassName,const std::vector<std::string>& args)
+	:cacheFileName(getCacheFileName(args)),
+	 file(0),offset(0)
+	{
+	/* Identify the source files: */
+	std::vector<SourceStamp> stamps;
+	if(!getSourceStamps(args,stamps))
+		Misc::throwStdErr("DataSetCache::Writer::Writer: Data set arguments do not name a source file");
+	
+	/* Create a temporary file in the cache file's directory, so that committing can rename it atomically: */
+	char pidBuffer[32];
+	snprintf(pidBuffer,sizeof(pidBuffer),".%d",int(getpid()));
+	tempFileName=cacheFileName;
+	tempFileName.append(pidBuffer);
+	file=fopen(tempFileName.c_str(),"wb");
+	if(file==0)
+		Misc::throwStdErr("DataSetCache::Writer::Writer: Unable to create cache file %s",tempFileName.c_str());
+	
+	/* Write the cache file header: */
+	writeRaw(headerMagic,sizeof(headerMagic));
+	write<unsigned int>(cacheFormatVersion);
+	write<unsigned int>(byteOrderMark);
+	write<unsigned int>((unsigned int)sizeof(size_t));
+	writeString(moduleClassName);
+	write<unsigned int>((unsigned int)args.size());
+	for(unsigned int i=0;i<args.size();++i)
+		{
+		writeString(args[i].c_str());
+		write<unsigned long long>(stamps[i].size);
+		write<long long>(stamps[i].time);
+		}
+	}
+
+DataSetCache::Writer::~Writer(void)
+	{
+	if(file!=0)
+		{
+		/* Discard the incomplete cache file: */
+		fclose(file);
+		unlink(tempFileName.c_str());
+		}
+	}
+
+void DataSetCache::Writer::writeString(const char* string)
+	{
+	unsigned int length=(unsigned int)strlen(string);
+	write<unsigned int>(length);
+	writeRaw(string,length);
+	}
+
+void DataSetCache::Writer::commit(void)
+	{
+	/* Mark the cache file as complete: */
+	writeRaw(trailerMagic,sizeof(trailerMagic));
+	
+	/* Close the temporary file and replace the previous cache file: */
+	int closeResult=fclose(file);
+	file=0;
+	if(closeResult!=0||rename(tempFileName.c_str(),cacheFileName.c_str())!=0)
+		{
+		unlink(tempFileName.c_str());
+		Misc::throwStdErr("DataSetCache::Writer::commit: Unable to write cache file %s",cacheFileName.c_str());
+		}
+	}
+
+/*************************************
+Methods of class DataSetCache::Reader:
+*************************************/
+
+const char* DataSetCache::Reader::readRaw(size_t size)
+	{
+	if(size>dataSize-offset)
+		Misc::throwStdErr("DataSetCache::Reader: Truncated cache file");
+	const char* result=mapping+offset;
+	offset+=size;
+	return result;
+	}
+
+void DataSetCache::Reader::align(void)
+	{
+	readRaw((arrayAlignment-offset%arrayAlignment)%arrayAlignment);
+	}
+
+DataSetCache::Reader::Reader(const char* moduleClassName,const std::vector<std::string>& args)
+	:fd(-1),mapping(0),mappingSize(0),dataSize(0),offset(0)
+	{
+	/* Identify the source files: */
+	std::vector<SourceStamp> stamps;
+	if(!getSourceStamps(args,stamps))
+		Misc::throwStdErr("DataSetCache::Reader::Reader: Data set arguments do not name a source file");
+	
+	/* Map the cache file: */
+	std::string cacheFileName=getCacheFileName(args);
+	fd=open(cacheFileName.c_str(),O_RDONLY);
+	if(fd<0)
+		Misc::throwStdErr("DataSetCache::Reader::Reader: Unable to open cache file %s",cacheFileName.c_str());
+	struct stat cacheStat;
+	if(fstat(fd,&cacheStat)!=0||size_t(cacheStat.st_size)<sizeof(headerMagic)+sizeof(trailerMagic))
+		{
+		close(fd);
+		Misc::throwStdErr("DataSetCache::Reader::Reader: Invalid cache file %s",cacheFileName.c_str());
+		}
+	mappingSize=size_t(cacheStat.st_size);
+	void* mapResult=mmap(0,mappingSize,PROT_READ,MAP_SHARED,fd,0);
+	if(mapResult==MAP_FAILED)
+		{
+		close(fd);
+		Misc::throwStdErr("DataSetCache::Reader::Reader: Unable to map cache file %s",cacheFileName.c_str());
+		}
+	mapping=static_cast<const char*>(mapResult);
+	
+	/* Cached data sets are read front to back: */
+	madvise(mapResult,mappingSize,MADV_SEQUENTIAL);
+	
+	try
+		{
+		/* Check that the cache file is complete and was written by a compatible version: */
+		if(memcmp(mapping,headerMagic,sizeof(headerMagic))!=0||memcmp(mapping+mappingSize-sizeof(trailerMagic),trailerMagic,sizeof(trailerMagic))!=0)
+			Misc::throwStdErr("DataSetCache::Reader::Reader: Cache file %s is not a complete cache file",cacheFileName.c_str());
+		dataSize=mappingSize-sizeof(trailerMagic);
+		readRaw(sizeof(headerMagic));
+		if(read<unsigned int>()!=cacheFormatVersion||read<unsigned int>()!=byteOrderMark||read<unsigned int>()!=sizeof(size_t))
+			Misc::throwStdErr("DataSetCache::Reader::Reader: Cache file %s has incompatible format",cacheFileName.c_str());
+		
+		/* Check that the cache file was written by the same module from the same arguments: */
+		if(readString()!=moduleClassName)
+			Misc::throwStdErr("DataSetCache::Reader::Reader: Cache file %s was written by a different module",cacheFileName.c_str());
+		if(read<unsigned int>()!=args.size())
+			Misc::throwStdErr("DataSetCache::Reader::Reader: Cache file %s was written from different arguments",cacheFileName.c_str());
+		for(unsigned int i=0;i<args.size();++i)
+			{
+			if(readString()!=args[i])
+				Misc::throwStdErr("DataSetCache::Reader::Reader: Cache file %s was written from different arguments",cacheFileName.c_str());
+			
+			/* Check that the file named by the argument did not change since the cache file was written: */
+			if(read<unsigned long long>()!=stamps[i].size||read<long long>()!=stamps[i].time)
+				Misc::throwStdErr("DataSetCache::Reader::Reader: Cache file %s is outdated",cacheFileName.c_str());
+			}
+		}
+	catch(...)
+		{
+		/* Clean up and re-throw the exception: */
+		munmap(mapResult,mappingSize);
+		close(fd);
+		throw;
+		}
+	}
+
+DataSetCache::Reader::~Reader(void)
+	{
+	munmap(const_cast<char*>(mapping),mappingSize);
+	close(fd);
+	}
+
+std::string DataSetCache::Reader::readString(void)
+	{
+	unsigned int length=read<unsigned int>();
+	const char* string=readRaw(length);
+	return std::string(string,string+length);
+	}
+
+/*************************************
+Static elements of class DataSetCache:
+*************************************/
+
+bool DataSetCache::enabled=true;
+
+/*****************************
+Methods of class DataSetCache:
+*****************************/
+
+void DataSetCache::setEnabled(bool newEnabled)
+	{
+	enabled=newEnabled;
+	}
+
+std::string DataSetCache::getCacheFileName(const std::vector<std::string>& args)
+	{
+	std::string result=args[0];
+	result.append(cacheFileSuffix);
+	return result;
+	}
+
+bool DataSetCache::hasSourceFile(const std::vector<std::string>& args)
+	{
+	std::vector<SourceStamp> stamps;
+	return getSourceStamps(args,stamps);
+	}
+
+bool DataSetCache::isCurrent(const char* moduleClassName,const std::vector<std::string>& args)
+	{
+	try
+		{
+		/* Try mapping and validating the cache file: */
+		Reader reader(moduleClassName,args);
+		return true;
+		}
+	catch(const std::runtime_error&)
+		{
+		return false;
+		}
+	}
+
+}
+
+}
@@ -0,0 +1,144 @@
+/***********************************************************************
+DataSetCache - Class to store loaded data sets in versioned binary cache
+files next to their source files, to skip parsing the source files on
+subsequent loads.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_ABSTRACT_DATASETCACHE_INCLUDED
+#define VISUALIZATION_ABSTRACT_DATASETCACHE_INCLUDED
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace Visualization {
+
+namespace Abstract {
+
+class DataSetCache
+	{
+	/* Embedded classes: */
+	public:
+	class Writer // Class to write a cache file; the cache file only replaces a previous cache file when committed
+		{
+		/* Elements: */
+		private:
+		std::string cacheFileName; // Name of the cache file
+		std::string tempFileName; // Name of the temporary file receiving the cache file's contents
+		FILE* file; // Temporary file; null after committing
+		size_t offset; // Current write position in the temporary file
+		
+		/* Private methods: */
+		void writeRaw(const void* data,size_t size); // Writes the given number of bytes
+		void align(void); // Pads the file to the next array alignment boundary
+		
+		/* Constructors and destructors: */
+		public:
+		Writer(const char* moduleClassName,const std::vector<std::string>& args); // Creates a cache file for a data set loaded by the given module from the given arguments, and writes the cache file header
+		private:
+		Writer(const Writer& source); // Prohibit copy constructor
+		Writer& operator=(const Writer& source); // Prohibit assignment operator
+		public:
+		~Writer(void); // Deletes the temporary file if the cache file was not committed
+		
+		/* Methods: */
+		template <class DataParam>
+		void write(const DataParam& value) // Writes a single value
+			{
+			writeRaw(&value,sizeof(DataParam));
+			}
+		template <class DataParam>
+		void write(const DataParam* values,size_t numValues) // Writes an array of values, aligned such that they can be accessed directly in a mapped cache file
+			{
+			align();
+			writeRaw(values,numValues*sizeof(DataParam));
+			}
+		void writeString(const char* string); // Writes a string
+		void commit(void); // Finishes the cache file and atomically replaces any previous cache file
+		};
+	
+	class Reader // Class to read a memory-mapped cache file
+		{
+		/* Elements: */
+		private:
+		int fd; // File descriptor of the cache file
+		const char* mapping; // Memory-mapped contents of the cache file
+		size_t mappingSize; // Size of the cache file
+		size_t dataSize; // Size of the cache file without its trailer
+		size_t offset; // Current read position in the cache file
+		
+		/* Private methods: */
+		const char* readRaw(size_t size); // Returns a pointer to the given number of bytes and advances the read position
+		void align(void); // Advances the read position to the next array alignment boundary
+		
+		/* Constructors and destructors: */
+		public:
+		Reader(const char* moduleClassName,const std::vector<std::string>& args); // Maps the cache file of a data set loaded by the given module from the given arguments; throws exception if the cache file does not exist, is incomplete, or is outdated
+		private:
+		Reader(const Reader& source); // Prohibit copy constructor
+		Reader& operator=(const Reader& source); // Prohibit assignment operator
+		public:
+		~Reader(void); // Unmaps the cache file
+		
+		/* Methods: */
+		template <class DataParam>
+		DataParam read(void) // Reads a single value
+			{
+			DataParam result;
+			memcpy(&result,readRaw(sizeof(DataParam)),sizeof(DataParam));
+			return result;
+			}
+		template <class DataParam>
+		void read(DataParam* values,size_t numValues) // Reads an array of values
+			{
+			memcpy(values,map<DataParam>(numValues),numValues*sizeof(DataParam));
+			}
+		template <class DataParam>
+		const DataParam* map(size_t numValues) // Returns a pointer to an array of values inside the mapped cache file
+			{
+			align();
+			return reinterpret_cast<const DataParam*>(readRaw(numValues*sizeof(DataParam)));
+			}
+		std::string readString(void); // Reads a string
+		};
+	
+	/* Elements: */
+	private:
+	static bool enabled; // Flag whether data set caching is enabled
+	
+	/* Methods: */
+	public:
+	static bool isEnabled(void) // Returns true if data set caching is enabled
+		{
+		return enabled;
+		}
+	static void setEnabled(bool newEnabled); // Enables or disables data set caching
+	static std::string getCacheFileName(const std::vector<std::string>& args); // Returns the name of the cache file for the given data set arguments
+	static bool hasSourceFile(const std::vector<std::string>& args); // Returns true if the first data set argument names a regular file; the sizes and modification times of all files named by the arguments identify the cached data set
+	static bool isCurrent(const char* moduleClassName,const std::vector<std::string>& args); // Returns true if there is a complete and up-to-date cache file for the given module and data set arguments
+	};
+
+}
+
+}
+
+#endif
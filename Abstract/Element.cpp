@@ -33,6 +33,21 @@ namespace Abstract {
 Methods of class Element:
 ************************/
 
+size_t Element::getNumVertices(void) const
+	{
+	return 0;
+	}
+
+size_t Element::getNumTriangles(void) const
+	{
+	return 0;
+	}
+
+unsigned int Element::calcChecksum(void) const
+	{
+	return (unsigned int)(getSize());
+	}
+
 bool Element::usesTransparency(void) const
 	{
 	return false;
@@ -43,6 +58,11 @@ GLMotif::Widget* Element::createSettingsDialog(GLMotif::WidgetManager* widgetMan
 	return 0;
 	}
 
+void Element::frame(void)
+	{
+	/* Just don't do anything */
+	}
+
 }
 
 }
@@ -83,8 +83,12 @@ class Element:public Threads::RefCounted
 		}
 	virtual std::string getName(void) const =0; // Returns a descriptive name for the visualization element
 	virtual size_t getSize(void) const =0; // Returns some size value for the visualization element to compare it to other elements of the same type (number of triangles, points, etc.)
+	virtual size_t getNumVertices(void) const; // Returns the number of vertices in the visualization element's geometry, or 0 if the element does not count them
+	virtual size_t getNumTriangles(void) const; // Returns the number of triangles in the visualization element's geometry, or 0 if the element has no triangles
+	virtual unsigned int calcChecksum(void) const; // Returns a checksum over the visualization element's geometry to compare it to the same element extracted on another node of a cluster
 	virtual bool usesTransparency(void) const; // Returns true if the visualization element uses transparency (and needs to be rendered last)
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager); // Returns a new UI widget to change internal settings of the element
+	virtual void frame(void); // Updates an animated visualization element once per application frame, before it is rendered
 	virtual void glRenderAction(GLContextData& contextData) const =0; // Renders a visualization element into the current OpenGL context
 	};
 
@@ -23,7 +23,11 @@ with the 3D Data Visualizer; if not, write to the Free Software
 Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 ***********************************************************************/
 
+#include <unistd.h>
+#include <iostream>
+#include <stdexcept>
 #include <Misc/ThrowStdErr.h>
+#include <Comm/MulticastPipe.h>
 
 #include <Abstract/Module.h>
 
@@ -31,10 +35,35 @@ namespace Visualization {
 
 namespace Abstract {
 
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+unsigned int getNumProcessors(void) // Returns the number of online processors
+	{
+	long numProcessors=sysconf(_SC_NPROCESSORS_ONLN);
+	return numProcessors>0?(unsigned int)numProcessors:1U;
+	}
+
+}
+
+/*******************************
+Static elements of class Module:
+*******************************/
+
+unsigned int Module::numLoadThreads=getNumProcessors();
+
 /***********************
 Methods of class Module:
 ***********************/
 
+void Module::setNumLoadThreads(unsigned int newNumLoadThreads)
+	{
+	numLoadThreads=newNumLoadThreads>0?newNumLoadThreads:getNumProcessors();
+	}
+
 Module::Module(const char* sClassName)
 	:Plugins::Factory(sClassName)
 	{
@@ -44,6 +73,72 @@ Module::~Module(void)
 	{
 	}
 
+bool Module::isDataSetCacheable(void) const
+	{
+	return false;
+	}
+
+void Module::writeDataSetCache(const DataSet*,DataSetCache::Writer&) const
+	{
+	Misc::throwStdErr("Module::writeDataSetCache: module %s does not support data set caching",getClassName());
+	}
+
+DataSet* Module::readDataSetCache(DataSetCache::Reader&) const
+	{
+	Misc::throwStdErr("Module::readDataSetCache: module %s does not support data set caching",getClassName());
+	return 0;
+	}
+
+DataSet* Module::loadCached(const std::vector<std::string>& args,Comm::MulticastPipe* pipe,bool writeCache) const
+	{
+	/* Parse the source file directly if caching is disabled or not supported: */
+	if(!DataSetCache::isEnabled()||!isDataSetCacheable()||!DataSetCache::hasSourceFile(args))
+		return load(args,pipe);
+	
+	/* Check for an up-to-date cache file on the master node, and let all nodes agree on whether to use it: */
+	bool master=pipe==0||pipe->isMaster();
+	int useCache=0;
+	if(master)
+		{
+		useCache=DataSetCache::isCurrent(getClassName(),args)?1:0;
+		if(pipe!=0)
+			{
+			pipe->write<int>(useCache);
+			pipe->finishMessage();
+			}
+		}
+	else
+		useCache=pipe->read<int>();
+	
+	if(useCache!=0)
+		{
+		/* Read the data set from the mapped cache file: */
+		DataSetCache::Reader cache(getClassName(),args);
+		return readDataSetCache(cache);
+		}
+	
+	/* Parse the source file: */
+	DataSet* result=load(args,pipe);
+	
+	if(master&&writeCache)
+		{
+		try
+			{
+			/* Write the loaded data set to a new cache file: */
+			DataSetCache::Writer cache(getClassName(),args);
+			writeDataSetCache(result,cache);
+			cache.commit();
+			}
+		catch(const std::runtime_error& err)
+			{
+			/* Carry on without a cache file: */
+			std::cerr<<"Module::loadCached: Unable to cache data set due to exception "<<err.what()<<std::endl;
+			}
+		}
+	
+	return result;
+	}
+
 int Module::getNumScalarAlgorithms(void) const
 	{
 	return 0;
@@ -29,6 +29,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string>
 #include <vector>
 #include <Plugins/Factory.h>
+#include <Abstract/DataSetCache.h>
 
 /* Forward declarations: */
 namespace Comm {
@@ -52,6 +53,10 @@ namespace Abstract {
 
 class Module:public Plugins::Factory
 	{
+	/* Elements: */
+	private:
+	static unsigned int numLoadThreads; // Number of threads modules may use to read the source files of a data set
+	
 	/* Constructors and destructors: */
 	public:
 	Module(const char* sClassName); // Default constructor with class name of concrete module class
@@ -62,7 +67,16 @@ class Module:public Plugins::Factory
 	virtual ~Module(void); // Destroys the module
 	
 	/* Methods: */
+	static unsigned int getNumLoadThreads(void) // Returns the number of threads modules may use to read the source files of a data set
+		{
+		return numLoadThreads;
+		}
+	static void setNumLoadThreads(unsigned int newNumLoadThreads); // Sets the number of threads modules may use to read source files; zero uses one thread per online processor
 	virtual DataSet* load(const std::vector<std::string>& args,Comm::MulticastPipe* pipe) const =0; // Loads a data set from the given list of arguments
+	virtual bool isDataSetCacheable(void) const; // Returns true if the module can write its data sets to and read them from data set cache files
+	virtual void writeDataSetCache(const DataSet* dataSet,DataSetCache::Writer& cache) const; // Writes the given data set to a data set cache file
+	virtual DataSet* readDataSetCache(DataSetCache::Reader& cache) const; // Reads a data set from a data set cache file
+	DataSet* loadCached(const std::vector<std::string>& args,Comm::MulticastPipe* pipe,bool writeCache =true) const; // Loads a data set from the given list of arguments, using an up-to-date data set cache file if there is one, and writes a cache file otherwise if writeCache is true and this is the master node
 	virtual DataSetRenderer* getRenderer(const DataSet* dataSet) const =0; // Creates a renderer for the given data set
 	virtual int getNumScalarAlgorithms(void) const; // Returns number of available visualization algorithms
 	virtual const char* getScalarAlgorithmName(int scalarAlgorithmIndex) const; // Returns the name of the given algorithm
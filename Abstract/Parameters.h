@@ -62,6 +62,13 @@ class Parameters
 	virtual void write(Comm::MulticastPipe& pipe,const VariableManager* variableManager) const =0; // Writes parameters to a multicast pipe
 	virtual void write(Comm::ClusterPipe& pipe,const VariableManager* variableManager) const =0; // Writes parameters to a cluster pipe
 	virtual Parameters* clone(void) const =0; // Returns an exact copy of the parameter object
+	virtual bool setSmoothShading(bool) // Selects smooth or flat shading if the parameter object supports both; returns false if it does not
+		{
+		return false;
+		}
+	virtual void dataSetChanged(VariableManager*) // Re-binds the parameter object to the variable manager's current data set, e.g., by re-locating seed points after the data set was replaced
+		{
+		}
 	};
 
 }
@@ -0,0 +1,322 @@
+/***********************************************************************
+TimeVaryingDataSet - Class to represent a sequence of time steps of a
+data set that are loaded by the same module from data set arguments
+differing only in a time step index, keeping a bounded cache of loaded
+time steps and prefetching the neighbors of the current time step on a
+background thread.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdexcept>
+#include <Misc/ThrowStdErr.h>
+
+#include <Abstract/DataSet.h>
+#include <Abstract/Module.h>
+
+#include <Abstract/TimeVaryingDataSet.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+/*******************************************
+Static elements of class TimeVaryingDataSet:
+*******************************************/
+
+const char* TimeVaryingDataSet::timeStepPlaceholder="%t";
+
+/***********************************
+Methods of class TimeVaryingDataSet:
+***********************************/
+
+TimeVaryingDataSet::CachedTimeStepList::iterator TimeVaryingDataSet::findCachedTimeStep(unsigned int timeStep)
+	{
+	CachedTimeStepList::iterator ctsIt;
+	for(ctsIt=cache.begin();ctsIt!=cache.end()&&ctsIt->timeStep!=timeStep;++ctsIt)
+		;
+	return ctsIt;
+	}
+
+bool TimeVaryingDataSet::isEvictable(unsigned int timeStep) const
+	{
+	if(timeStep==currentTimeStep||timeStep==previousTimeStep||timeStep==requestedTimeStep)
+		return false;
+	if(currentTimeStep<numTimeSteps&&(timeStep+1==currentTimeStep||timeStep==currentTimeStep+1))
+		return false;
+	return true;
+	}
+
+void TimeVaryingDataSet::evictTimeSteps(void)
+	{
+	while(cache.size()>maxNumCachedTimeSteps)
+		{
+		/* Find the least recently used evictable time step: */
+		CachedTimeStepList::iterator lruIt=cache.end();
+		for(CachedTimeStepList::iterator ctsIt=cache.begin();ctsIt!=cache.end();++ctsIt)
+			if(isEvictable(ctsIt->timeStep)&&(lruIt==cache.end()||lruIt->lastUse>ctsIt->lastUse))
+				lruIt=ctsIt;
+		if(lruIt==cache.end())
+			break;
+		
+		/* Delete the time step: */
+		delete lruIt->dataSet;
+		cache.erase(lruIt);
+		}
+	}
+
+unsigned int TimeVaryingDataSet::findPrefetchTimeStep(void)
+	{
+	/* Don't prefetch before the application displays a time step: */
+	if(currentTimeStep==numTimeSteps)
+		return numTimeSteps;
+	
+	/* Don't prefetch if the cache is full and no cached time step can be evicted to make room: */
+	if(cache.size()>=maxNumCachedTimeSteps)
+		{
+		CachedTimeStepList::iterator ctsIt;
+		for(ctsIt=cache.begin();ctsIt!=cache.end()&&!isEvictable(ctsIt->timeStep);++ctsIt)
+			;
+		if(ctsIt==cache.end())
+			return numTimeSteps;
+		}
+	
+	/* Prefetch the next time step first, and then the previous one: */
+	unsigned int candidates[2];
+	unsigned int numCandidates=0;
+	if(currentTimeStep+1<numTimeSteps)
+		candidates[numCandidates++]=currentTimeStep+1;
+	if(currentTimeStep>0)
+		candidates[numCandidates++]=currentTimeStep-1;
+	for(unsigned int i=0;i<numCandidates;++i)
+		if(candidates[i]!=requestedTimeStep&&findCachedTimeStep(candidates[i])==cache.end())
+			return candidates[i];
+	
+	return numTimeSteps;
+	}
+
+DataSet* TimeVaryingDataSet::loadTimeStep(unsigned int timeStep) const
+	{
+	/* Load the time step without synchronizing with other cluster nodes, as time steps are loaded independently on each node; only the master node writes cache files: */
+	return module->loadCached(getArgs(timeStep),0,master);
+	}
+
+void* TimeVaryingDataSet::prefetcherThreadMethod(void)
+	{
+	while(true)
+		{
+		/* Wait until there is a time step to prefetch: */
+		unsigned int timeStep;
+		{
+		Threads::Mutex::Lock cacheLock(cacheMutex);
+		while(!shutdownPrefetcher&&(timeStep=findPrefetchTimeStep())==numTimeSteps)
+			cacheCond.wait(cacheMutex);
+		if(shutdownPrefetcher)
+			break;
+		prefetchingTimeStep=timeStep;
+		}
+		
+		/* Load the time step: */
+		CachedTimeStep cts;
+		cts.timeStep=timeStep;
+		cts.dataSet=0;
+		try
+			{
+			cts.dataSet=loadTimeStep(timeStep);
+			}
+		catch(const std::runtime_error& err)
+			{
+			/* Keep the failed time step in the cache to not retry it in the background; getTimeStep retries and reports the error: */
+			}
+		
+		/* Store the time step in the cache: */
+		{
+		Threads::Mutex::Lock cacheLock(cacheMutex);
+		cts.lastUse=++useCounter;
+		cache.push_back(cts);
+		prefetchingTimeStep=numTimeSteps;
+		evictTimeSteps();
+		cacheCond.broadcast();
+		}
+		}
+	
+	return 0;
+	}
+
+TimeVaryingDataSet::TimeVaryingDataSet(const Module* sModule,const std::vector<std::string>& sArgTemplate,int sFirstTimeStepIndex,int sLastTimeStepIndex,int sTimeStepIndexIncrement,unsigned int sMaxNumCachedTimeSteps,bool sMaster)
+	:module(sModule),master(sMaster),
+	 argTemplate(sArgTemplate),
+	 firstTimeStepIndex(sFirstTimeStepIndex),timeStepIndexIncrement(sTimeStepIndexIncrement),
+	 numTimeSteps(0),
+	 maxNumCachedTimeSteps(sMaxNumCachedTimeSteps),
+	 useCounter(0),
+	 shutdownPrefetcher(false)
+	{
+	/* Check the time step range: */
+	if(!isArgTemplate(argTemplate))
+		Misc::throwStdErr("TimeVaryingDataSet::TimeVaryingDataSet: Data set arguments do not contain time step placeholder %s",timeStepPlaceholder);
+	if(timeStepIndexIncrement<=0||sLastTimeStepIndex<firstTimeStepIndex)
+		Misc::throwStdErr("TimeVaryingDataSet::TimeVaryingDataSet: Invalid time step range %d-%d with increment %d",firstTimeStepIndex,sLastTimeStepIndex,timeStepIndexIncrement);
+	numTimeSteps=(unsigned int)((sLastTimeStepIndex-firstTimeStepIndex)/timeStepIndexIncrement+1);
+	
+	/* The cache must hold at least the previous, current, and next time steps: */
+	if(maxNumCachedTimeSteps<3)
+		maxNumCachedTimeSteps=3;
+	
+	/* Initialize the cache state: */
+	currentTimeStep=numTimeSteps;
+	previousTimeStep=numTimeSteps;
+	requestedTimeStep=numTimeSteps;
+	prefetchingTimeStep=numTimeSteps;
+	
+	/* Start the prefetcher thread: */
+	prefetcherThread.start(this,&TimeVaryingDataSet::prefetcherThreadMethod);
+	}
+
+TimeVaryingDataSet::~TimeVaryingDataSet(void)
+	{
+	/* Shut down the prefetcher thread; this waits until a time step that is currently being prefetched is loaded: */
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	shutdownPrefetcher=true;
+	cacheCond.broadcast();
+	}
+	prefetcherThread.join();
+	
+	/* Delete all cached time steps: */
+	for(CachedTimeStepList::iterator ctsIt=cache.begin();ctsIt!=cache.end();++ctsIt)
+		delete ctsIt->dataSet;
+	}
+
+bool TimeVaryingDataSet::isArgTemplate(const std::vector<std::string>& args)
+	{
+	for(std::vector<std::string>::const_iterator aIt=args.begin();aIt!=args.end();++aIt)
+		if(aIt->find(timeStepPlaceholder)!=std::string::npos)
+			return true;
+	return false;
+	}
+
+std::vector<std::string> TimeVaryingDataSet::getArgs(unsigned int timeStep) const
+	{
+	/* Format the time step index: */
+	char timeStepIndex[32];
+	snprintf(timeStepIndex,sizeof(timeStepIndex),"%d",getTimeStepIndex(timeStep));
+	
+	/* Replace all placeholders in all arguments: */
+	std::string placeholder=timeStepPlaceholder;
+	std::vector<std::string> result=argTemplate;
+	for(std::vector<std::string>::iterator rIt=result.begin();rIt!=result.end();++rIt)
+		{
+		std::string::size_type pos;
+		while((pos=rIt->find(placeholder))!=std::string::npos)
+			rIt->replace(pos,placeholder.length(),timeStepIndex);
+		}
+	
+	return result;
+	}
+
+bool TimeVaryingDataSet::isCached(unsigned int timeStep)
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	CachedTimeStepList::iterator ctsIt=findCachedTimeStep(timeStep);
+	return ctsIt!=cache.end()&&ctsIt->dataSet!=0;
+	}
+
+DataSet* TimeVaryingDataSet::getTimeStep(unsigned int timeStep)
+	{
+	if(timeStep>=numTimeSteps)
+		Misc::throwStdErr("TimeVaryingDataSet::getTimeStep: Invalid time step %u",timeStep);
+	
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	
+	/* Protect the time step from eviction until it becomes the current time step: */
+	requestedTimeStep=timeStep;
+	
+	/* Wait if the prefetcher is currently loading the time step: */
+	while(prefetchingTimeStep==timeStep)
+		cacheCond.wait(cacheMutex);
+	
+	/* Return the time step if it is cached: */
+	CachedTimeStepList::iterator ctsIt=findCachedTimeStep(timeStep);
+	if(ctsIt!=cache.end())
+		{
+		if(ctsIt->dataSet!=0)
+			{
+			ctsIt->lastUse=++useCounter;
+			return ctsIt->dataSet;
+			}
+		
+		/* Retry loading a time step that failed to prefetch: */
+		cache.erase(ctsIt);
+		}
+	}
+	
+	/* Load the time step on the calling thread: */
+	CachedTimeStep cts;
+	cts.timeStep=timeStep;
+	try
+		{
+		cts.dataSet=loadTimeStep(timeStep);
+		}
+	catch(...)
+		{
+		/* Release the time step and re-throw the exception: */
+		{
+		Threads::Mutex::Lock cacheLock(cacheMutex);
+		requestedTimeStep=numTimeSteps;
+		}
+		throw;
+		}
+	
+	/* Store the time step in the cache: */
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	cts.lastUse=++useCounter;
+	cache.push_back(cts);
+	evictTimeSteps();
+	}
+	
+	return cts.dataSet;
+	}
+
+void TimeVaryingDataSet::setCurrentTimeStep(unsigned int newCurrentTimeStep)
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	
+	/* Update the time step state: */
+	if(currentTimeStep!=newCurrentTimeStep)
+		{
+		previousTimeStep=currentTimeStep;
+		currentTimeStep=newCurrentTimeStep;
+		}
+	requestedTimeStep=numTimeSteps;
+	
+	/* Drop time steps the application no longer uses: */
+	evictTimeSteps();
+	
+	/* Wake up the prefetcher: */
+	cacheCond.broadcast();
+	}
+
+}
+
+}
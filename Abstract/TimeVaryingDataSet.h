@@ -0,0 +1,127 @@
+/***********************************************************************
+TimeVaryingDataSet - Class to represent a sequence of time steps of a
+data set that are loaded by the same module from data set arguments
+differing only in a time step index, keeping a bounded cache of loaded
+time steps and prefetching the neighbors of the current time step on a
+background thread.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_ABSTRACT_TIMEVARYINGDATASET_INCLUDED
+#define VISUALIZATION_ABSTRACT_TIMEVARYINGDATASET_INCLUDED
+
+#include <string>
+#include <vector>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Abstract {
+class DataSet;
+class Module;
+}
+}
+
+namespace Visualization {
+
+namespace Abstract {
+
+class TimeVaryingDataSet
+	{
+	/* Embedded classes: */
+	private:
+	struct CachedTimeStep // Structure for a loaded or failed time step in the cache
+		{
+		/* Elements: */
+		public:
+		unsigned int timeStep; // Index of the time step in the sequence
+		DataSet* dataSet; // Pointer to the loaded data set; null if loading failed
+		unsigned int lastUse; // Value of the use counter when the time step was last requested
+		};
+	
+	typedef std::vector<CachedTimeStep> CachedTimeStepList;
+	
+	/* Elements: */
+	public:
+	static const char* timeStepPlaceholder; // String in data set arguments that is replaced by a time step index
+	private:
+	const Module* module; // Module used to load all time steps
+	bool master; // Flag whether this is the master node of a cluster, which is the only node writing data set cache files
+	std::vector<std::string> argTemplate; // Data set arguments containing the time step placeholder
+	int firstTimeStepIndex; // Time step index of the first time step in the sequence
+	int timeStepIndexIncrement; // Increment between time step indices of subsequent time steps
+	unsigned int numTimeSteps; // Number of time steps in the sequence
+	unsigned int maxNumCachedTimeSteps; // Maximum number of loaded time steps to keep in the cache
+	Threads::Mutex cacheMutex; // Mutex protecting the time step cache and the prefetcher state
+	Threads::Cond cacheCond; // Condition variable signalling changes in the cache or the prefetcher state
+	CachedTimeStepList cache; // List of cached time steps
+	unsigned int useCounter; // Counter to determine the least recently used time step
+	unsigned int currentTimeStep; // Index of the time step currently displayed by the application
+	unsigned int previousTimeStep; // Index of the time step displayed before the current one; kept in the cache until the next time step change
+	unsigned int requestedTimeStep; // Index of the time step most recently returned by getTimeStep, or numTimeSteps if none
+	unsigned int prefetchingTimeStep; // Index of the time step currently being loaded by the prefetcher, or numTimeSteps if none
+	bool shutdownPrefetcher; // Flag to tell the prefetcher thread to shut down
+	Threads::Thread prefetcherThread; // Thread loading the neighbors of the current time step in the background
+	
+	/* Private methods: */
+	CachedTimeStepList::iterator findCachedTimeStep(unsigned int timeStep); // Returns the cache entry for the given time step, or the end of the cache list; cache mutex must be locked
+	bool isEvictable(unsigned int timeStep) const; // Returns true if the given time step is neither in use by the application nor a neighbor of the current time step; cache mutex must be locked
+	void evictTimeSteps(void); // Deletes least recently used time steps until the cache is within its size limit; cache mutex must be locked
+	unsigned int findPrefetchTimeStep(void); // Returns the index of the next time step the prefetcher should load, or numTimeSteps if there is none; cache mutex must be locked
+	DataSet* loadTimeStep(unsigned int timeStep) const; // Loads the given time step without using the cache
+	void* prefetcherThreadMethod(void); // Loads the neighbors of the current time step until shut down
+	
+	/* Constructors and destructors: */
+	public:
+	TimeVaryingDataSet(const Module* sModule,const std::vector<std::string>& sArgTemplate,int sFirstTimeStepIndex,int sLastTimeStepIndex,int sTimeStepIndexIncrement,unsigned int sMaxNumCachedTimeSteps,bool sMaster); // Creates a time-varying data set for the given module and argument template on the master or a slave node of a cluster; does not load any time steps yet
+	private:
+	TimeVaryingDataSet(const TimeVaryingDataSet& source); // Prohibit copy constructor
+	TimeVaryingDataSet& operator=(const TimeVaryingDataSet& source); // Prohibit assignment operator
+	public:
+	~TimeVaryingDataSet(void); // Stops the prefetcher and deletes all cached time steps
+	
+	/* Methods: */
+	static bool isArgTemplate(const std::vector<std::string>& args); // Returns true if any of the given data set arguments contains the time step placeholder
+	unsigned int getNumTimeSteps(void) const // Returns the number of time steps in the sequence
+		{
+		return numTimeSteps;
+		}
+	int getTimeStepIndex(unsigned int timeStep) const // Returns the time step index passed to the module for the given time step
+		{
+		return firstTimeStepIndex+int(timeStep)*timeStepIndexIncrement;
+		}
+	std::vector<std::string> getArgs(unsigned int timeStep) const; // Returns the data set arguments to load the given time step
+	unsigned int getCurrentTimeStep(void) const // Returns the index of the current time step
+		{
+		return currentTimeStep;
+		}
+	bool isCached(unsigned int timeStep); // Returns true if the given time step is loaded and in the cache
+	DataSet* getTimeStep(unsigned int timeStep); // Returns the given time step, loading it on the calling thread or waiting for the prefetcher if it is not cached; throws exception if the time step cannot be loaded; data set is owned by the cache
+	void setCurrentTimeStep(unsigned int newCurrentTimeStep); // Sets the time step currently displayed by the application, and starts prefetching its neighbors
+	};
+
+}
+
+}
+
+#endif
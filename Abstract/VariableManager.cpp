@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string.h>
 #include <stdio.h>
 #include <stdexcept>
+#include <Misc/ThrowStdErr.h>
 #include <Misc/CreateNumberedFileName.h>
 #include <GL/GLColorMap.h>
 #include <GLMotif/StyleSheet.h>
@@ -71,13 +72,27 @@ void VariableManager::prepareScalarVariable(int scalarVariableIndex)
 	/* Get a new scalar extractor: */
 	sv.scalarExtractor=dataSet->getScalarExtractor(scalarVariableIndex);
 	
-	/* Calculate the scalar extractor's value range: */
-	sv.valueRange=dataSet->calcScalarValueRange(sv.scalarExtractor);
+	/* Calculate the scalar variable's value range: */
+	sv.valueRange=dataSet->calcScalarVariableRange(scalarVariableIndex);
+	
+	/* Count the scalar variable's values into one histogram bin per color map entry: */
+	sv.valueHistogram.resize(256);
+	dataSet->calcScalarVariableHistogram(scalarVariableIndex,sv.valueRange,sv.valueHistogram);
 	
 	/* Create a 256-entry OpenGL color map for rendering: */
 	sv.colorMap=new GLColorMap(GLColorMap::GREYSCALE|GLColorMap::RAMP_ALPHA,1.0f,1.0f,sv.valueRange.first,sv.valueRange.second);
 	}
 
+void VariableManager::deleteRetiredExtractors(void)
+	{
+	for(std::vector<ScalarExtractor*>::iterator seIt=retiredScalarExtractors.begin();seIt!=retiredScalarExtractors.end();++seIt)
+		delete *seIt;
+	retiredScalarExtractors.clear();
+	for(std::vector<VectorExtractor*>::iterator veIt=retiredVectorExtractors.begin();veIt!=retiredVectorExtractors.end();++veIt)
+		delete *veIt;
+	retiredVectorExtractors.clear();
+	}
+
 void VariableManager::colorMapChangedCallback(Misc::CallbackData* cbData)
 	{
 	/* Export the changed palette to the current color map: */
@@ -102,7 +117,7 @@ void VariableManager::savePaletteCallback(Misc::CallbackData* cbData)
 		}
 	}
 
-VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName)
+VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName,bool headless)
 	:dataSet(sDataSet),
 	 defaultColorMapName(0),
 	 scalarVariables(0),
@@ -124,19 +139,22 @@ VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultCol
 	if(numScalarVariables>0)
 		scalarVariables=new ScalarVariable[numScalarVariables];
 	
-	/* Get the style sheet: */
-	const GLMotif::StyleSheet& ss=*Vrui::getWidgetManager()->getStyleSheet();
-	
-	/* Create the color bar dialog: */
-	colorBarDialogPopup=new GLMotif::PopupWindow("ColorBarDialogPopup",Vrui::getWidgetManager(),"Color Bar");
-	
-	/* Create the color bar widget: */
-	colorBar=new GLMotif::ColorBar("ColorBar",colorBarDialogPopup,ss.fontHeight*5.0f,6,5);
-	
-	/* Create the palette editor: */
-	paletteEditor=new PaletteEditor;
-	paletteEditor->getColorMapChangedCallbacks().add(this,&VariableManager::colorMapChangedCallback);
-	paletteEditor->getSavePaletteCallbacks().add(this,&VariableManager::savePaletteCallback);
+	if(!headless)
+		{
+		/* Get the style sheet: */
+		const GLMotif::StyleSheet& ss=*Vrui::getWidgetManager()->getStyleSheet();
+		
+		/* Create the color bar dialog: */
+		colorBarDialogPopup=new GLMotif::PopupWindow("ColorBarDialogPopup",Vrui::getWidgetManager(),"Color Bar");
+		
+		/* Create the color bar widget: */
+		colorBar=new GLMotif::ColorBar("ColorBar",colorBarDialogPopup,ss.fontHeight*5.0f,6,5);
+		
+		/* Create the palette editor: */
+		paletteEditor=new PaletteEditor;
+		paletteEditor->getColorMapChangedCallbacks().add(this,&VariableManager::colorMapChangedCallback);
+		paletteEditor->getSavePaletteCallbacks().add(this,&VariableManager::savePaletteCallback);
+		}
 	
 	/* Initialize the vector extractor array: */
 	numVectorVariables=dataSet->getNumVectorVariables();
@@ -164,10 +182,39 @@ VariableManager::~VariableManager(void)
 		delete[] vectorExtractors;
 		}
 	
+	deleteRetiredExtractors();
+	
 	delete colorBarDialogPopup;
 	delete paletteEditor;
 	}
 
+void VariableManager::setDataSet(const DataSet* newDataSet)
+	{
+	/* Check that the new data set contains the same variables: */
+	if(newDataSet->getNumScalarVariables()!=numScalarVariables||newDataSet->getNumVectorVariables()!=numVectorVariables)
+		Misc::throwStdErr("VariableManager::setDataSet: New data set has different variables than the current data set");
+	
+	/* Delete the extractors retired by the previous data set change: */
+	deleteRetiredExtractors();
+	
+	Threads::Mutex::Lock variablesLock(variablesMutex);
+	dataSet=newDataSet;
+	
+	/* Replace all prepared extractors; the old ones might still be in use by extractor threads: */
+	for(int i=0;i<numScalarVariables;++i)
+		if(scalarVariables[i].scalarExtractor!=0)
+			{
+			retiredScalarExtractors.push_back(scalarVariables[i].scalarExtractor);
+			scalarVariables[i].scalarExtractor=dataSet->getScalarExtractor(i);
+			}
+	for(int i=0;i<numVectorVariables;++i)
+		if(vectorExtractors[i]!=0)
+			{
+			retiredVectorExtractors.push_back(vectorExtractors[i]);
+			vectorExtractors[i]=dataSet->getVectorExtractor(i);
+			}
+	}
+
 const DataSet* VariableManager::getDataSetByScalarVariable(int scalarVariableIndex) const
 	{
 	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
@@ -191,8 +238,18 @@ void VariableManager::setCurrentScalarVariable(int newCurrentScalarVariableIndex
 	
 	/* Check if the scalar variable has not been requested before: */
 	ScalarVariable& sv=scalarVariables[newCurrentScalarVariableIndex];
+	{
+	Threads::Mutex::Lock variablesLock(variablesMutex);
 	if(sv.scalarExtractor==0)
 		prepareScalarVariable(newCurrentScalarVariableIndex);
+	}
+	
+	if(paletteEditor==0)
+		{
+		/* There is no user interface to update: */
+		currentScalarVariableIndex=newCurrentScalarVariableIndex;
+		return;
+		}
 	
 	/* Save the palette editor's current palette: */
 	if(currentScalarVariableIndex>=0)
@@ -230,6 +287,9 @@ void VariableManager::setCurrentScalarVariable(int newCurrentScalarVariableIndex
 		sv.palette=0;
 		}
 	
+	/* Show the scalar variable's value histogram in the palette editor: */
+	paletteEditor->getColorMap()->setHistogram(sv.valueHistogram,sv.valueRange);
+	
 	/* Update the palette editor's title: */
 	char title[256];
 	snprintf(title,sizeof(title),"Palette Editor - %s",dataSet->getScalarVariableName(newCurrentScalarVariableIndex));
@@ -240,6 +300,7 @@ void VariableManager::setCurrentScalarVariable(int newCurrentScalarVariableIndex
 	colorBarDialogPopup->setTitleString(title);
 	colorBar->setColorMap(sv.colorMap);
 	colorBar->setValueRange(sv.valueRange.first,sv.valueRange.second);
+	colorBar->setHistogram(sv.valueHistogram,sv.valueRange.first,sv.valueRange.second);
 	}
 
 void VariableManager::setCurrentVectorVariable(int newCurrentVectorVariableIndex)
@@ -248,8 +309,11 @@ void VariableManager::setCurrentVectorVariable(int newCurrentVectorVariableIndex
 		return;
 	
 	/* Check if the vector variable has not been requested before: */
+	{
+	Threads::Mutex::Lock variablesLock(variablesMutex);
 	if(vectorExtractors[newCurrentVectorVariableIndex]==0)
 		vectorExtractors[newCurrentVectorVariableIndex]=dataSet->getVectorExtractor(newCurrentVectorVariableIndex);
+	}
 	
 	/* Update the current vector variable: */
 	currentVectorVariableIndex=newCurrentVectorVariableIndex;
@@ -261,8 +325,11 @@ const ScalarExtractor* VariableManager::getScalarExtractor(int scalarVariableInd
 		return 0;
 	
 	/* Check if the scalar variable has not been requested before: */
+	{
+	Threads::Mutex::Lock variablesLock(variablesMutex);
 	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
 		prepareScalarVariable(scalarVariableIndex);
+	}
 	
 	return scalarVariables[scalarVariableIndex].scalarExtractor;
 	}
@@ -273,20 +340,41 @@ const DataSet::VScalarRange& VariableManager::getScalarValueRange(int scalarVari
 		return scalarVariables[currentScalarVariableIndex].valueRange;
 	
 	/* Check if the scalar variable has not been requested before: */
+	{
+	Threads::Mutex::Lock variablesLock(variablesMutex);
 	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
 		prepareScalarVariable(scalarVariableIndex);
+	}
 	
 	return scalarVariables[scalarVariableIndex].valueRange;
 	}
 
+const DataSet::VScalarHistogram& VariableManager::getScalarValueHistogram(int scalarVariableIndex)
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
+		return scalarVariables[currentScalarVariableIndex].valueHistogram;
+	
+	/* Check if the scalar variable has not been requested before: */
+	{
+	Threads::Mutex::Lock variablesLock(variablesMutex);
+	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
+		prepareScalarVariable(scalarVariableIndex);
+	}
+	
+	return scalarVariables[scalarVariableIndex].valueHistogram;
+	}
+
 const GLColorMap* VariableManager::getColorMap(int scalarVariableIndex)
 	{
 	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
 		return 0;
 	
 	/* Check if the scalar variable has not been requested before: */
+	{
+	Threads::Mutex::Lock variablesLock(variablesMutex);
 	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
 		prepareScalarVariable(scalarVariableIndex);
+	}
 	
 	return scalarVariables[scalarVariableIndex].colorMap;
 	}
@@ -297,14 +385,20 @@ const VectorExtractor* VariableManager::getVectorExtractor(int vectorVariableInd
 		return 0;
 	
 	/* Check if the vector variable has not been requested before: */
+	{
+	Threads::Mutex::Lock variablesLock(variablesMutex);
 	if(vectorExtractors[vectorVariableIndex]==0)
 		vectorExtractors[vectorVariableIndex]=dataSet->getVectorExtractor(vectorVariableIndex);
+	}
 	
 	return vectorExtractors[vectorVariableIndex];
 	}
 
 void VariableManager::showColorBar(bool show)
 	{
+	if(colorBarDialogPopup==0)
+		return;
+	
 	/* Hide or show color bar dialog based on parameter: */
 	if(show)
 		Vrui::popupPrimaryWidget(colorBarDialogPopup,Vrui::getNavigationTransformation().transform(Vrui::getDisplayCenter()));
@@ -314,6 +408,9 @@ void VariableManager::showColorBar(bool show)
 
 void VariableManager::showPaletteEditor(bool show)
 	{
+	if(paletteEditor==0)
+		return;
+	
 	/* Hide or show color bar dialog based on parameter: */
 	if(show)
 		Vrui::popupPrimaryWidget(paletteEditor,Vrui::getNavigationTransformation().transform(Vrui::getDisplayCenter()));
@@ -329,6 +426,9 @@ void VariableManager::createPalette(int newPaletteType)
 	typedef ColorMap::ColorMapValue Color;
 	typedef ColorMap::ControlPoint ControlPoint;
 	
+	if(paletteEditor==0)
+		return;
+	
 	/* Get the current color map's value range: */
 	const ValueRange& valueRange=paletteEditor->getColorMap()->getValueRange();
 	double o=valueRange.first;
@@ -438,12 +538,18 @@ void VariableManager::createPalette(int newPaletteType)
 
 void VariableManager::loadPalette(const char* paletteFileName)
 	{
+	if(paletteEditor==0)
+		return;
+	
 	/* Load the given palette file: */
 	paletteEditor->loadPalette(paletteFileName,scalarVariables[currentScalarVariableIndex].valueRange);
 	}
 
 void VariableManager::insertPaletteEditorControlPoint(double newControlPoint)
 	{
+	if(paletteEditor==0)
+		return;
+	
 	paletteEditor->getColorMap()->insertControlPoint(newControlPoint);
 	}
 
@@ -23,6 +23,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_ABSTRACT_VARIABLEMANAGER_INCLUDED
 #define VISUALIZATION_ABSTRACT_VARIABLEMANAGER_INCLUDED
 
+#include <vector>
+#include <Threads/Mutex.h>
 #include <Abstract/DataSet.h>
 #include <PaletteEditor.h>
 
@@ -64,6 +66,7 @@ class VariableManager
 		public:
 		ScalarExtractor* scalarExtractor; // Scalar extractor for the scalar variable
 		DataSet::VScalarRange valueRange; // Value range of the scalar variable
+		DataSet::VScalarHistogram valueHistogram; // Histogram of the scalar variable's values across its value range
 		GLColorMap* colorMap; // The color map to render the scalar variable
 		PaletteEditor::Storage* palette; // Pointer to palette editor state for the scalar variable
 		
@@ -84,18 +87,23 @@ class VariableManager
 	VectorExtractor** vectorExtractors; // Array of extractors for the data set's vector variables
 	int currentScalarVariableIndex; // The index of the currently selected scalar variable
 	int currentVectorVariableIndex; // The index of the currently selected vector variable
+	std::vector<ScalarExtractor*> retiredScalarExtractors; // Scalar extractors for the previous data set, kept alive until the next data set change
+	std::vector<VectorExtractor*> retiredVectorExtractors; // Vector extractors for the previous data set, kept alive until the next data set change
+	Threads::Mutex variablesMutex; // Mutex serializing on-demand preparation of scalar and vector variables requested by concurrent extractor threads
 	
 	/* Private methods: */
 	void prepareScalarVariable(int scalarVariableIndex);
+	void deleteRetiredExtractors(void);
 	void colorMapChangedCallback(Misc::CallbackData* cbData);
 	void savePaletteCallback(Misc::CallbackData* cbData);
 	
 	/* Constructors and destructors: */
 	public:
-	VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName); // Creates variable manager for the given data set
+	VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName,bool headless =false); // Creates variable manager for the given data set; does not create color bar or palette editor if headless flag is true
 	~VariableManager(void);
 	
 	/* Methods: */
+	void setDataSet(const DataSet* newDataSet); // Replaces the data set with another one containing the same variables, such as another time step; keeps all value ranges and color maps
 	int getNumScalarVariables(void) const // Returns the number of scalar variables in the data set
 		{
 		return numScalarVariables;
@@ -126,6 +134,7 @@ class VariableManager
 	void setCurrentVectorVariable(int newCurrentVectorVariable); // Sets the currently selected vector variable
 	const ScalarExtractor* getScalarExtractor(int scalarVariableIndex); // Returns a new scalar extractor for the given scalar variable
 	const DataSet::VScalarRange& getScalarValueRange(int scalarVariableIndex); // Returns the value range of the given scalar variable
+	const DataSet::VScalarHistogram& getScalarValueHistogram(int scalarVariableIndex); // Returns the value histogram of the given scalar variable
 	const GLColorMap* getColorMap(int scalarVariableIndex); // Returns the color map for the given scalar variable
 	const VectorExtractor* getVectorExtractor(int vectorVariableIndex); // Returns a new vector extractor for the given vector variable
 	const ScalarExtractor* getCurrentScalarExtractor(void) const // Returns the current scalar extractor
@@ -136,6 +145,10 @@ class VariableManager
 		{
 		return scalarVariables[currentScalarVariableIndex].valueRange;
 		}
+	const DataSet::VScalarHistogram& getCurrentScalarValueHistogram(void) const // Returns the current scalar value histogram
+		{
+		return scalarVariables[currentScalarVariableIndex].valueHistogram;
+		}
 	const GLColorMap* getCurrentColorMap(void) const // Returns the current color map
 		{
 		return scalarVariables[currentScalarVariableIndex].colorMap;
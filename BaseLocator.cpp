@@ -45,3 +45,8 @@ void BaseLocator::glRenderActionTransparent(GLContextData& contextData) const
 	{
 	/* Render nothing */
 	}
+
+void BaseLocator::dataSetChanged(void)
+	{
+	/* Do nothing */
+	}
@@ -42,6 +42,7 @@ class BaseLocator:public Vrui::LocatorToolAdapter
 	virtual void highlightLocator(GLContextData& contextData) const; // Renders the locator itself
 	virtual void glRenderAction(GLContextData& contextData) const; // Renders opaque elements and other objects controlled by the locator
 	virtual void glRenderActionTransparent(GLContextData& contextData) const; // Renders transparent elements and other objects controlled by the locator
+	virtual void dataSetChanged(void); // Notifies the locator that the application switched to a different data set, such as another time step
 	};
 
 #endif
@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <string.h>
 #include <stdio.h>
+#include <Math/Math.h>
 #include <GL/gl.h>
 #include <GL/GLColorTemplates.h>
 #include <GL/GLTexCoordTemplates.h>
@@ -137,7 +138,8 @@ ColorBar::ColorBar(const char* sName,Container* sParent,GLfloat sColorBarHeight,
 	 font(0),
 	 tickMarkLabelPrecision(sTickMarkLabelPrecision),
 	 numTickMarks(sNumTickMarks),tickMarks(new TickMark[numTickMarks]),
-	 tickMarksVersion(1)
+	 tickMarksVersion(1),
+	 histogramMin(0.0),histogramMax(1.0)
 	{
 	/* Get the style sheet: */
 	const StyleSheet* ss=getStyleSheet();
@@ -351,6 +353,34 @@ void ColorBar::draw(GLContextData& contextData) const
 		glEnable(GL_TEXTURE_2D);
 	if(!texture1DEnabled)
 		glDisable(GL_TEXTURE_1D);
+	
+	if(!histogram.empty())
+		{
+		/* Draw the value histogram as a step curve over the color bar: */
+		GLfloat x1=colorBarBox.origin[0];
+		GLfloat x2=colorBarBox.origin[0]+colorBarBox.size[0];
+		GLfloat y1=colorBarBox.origin[1];
+		GLfloat y2=colorBarBox.origin[1]+colorBarBox.size[1];
+		double xScale=double(x2-x1)/(valueMax-valueMin);
+		double binWidth=(histogramMax-histogramMin)/double(histogram.size());
+		glColor(foregroundColor);
+		glBegin(GL_LINE_STRIP);
+		for(size_t i=0;i<histogram.size();++i)
+			{
+			GLfloat y=y1+histogram[i]*(y2-y1);
+			for(size_t j=0;j<2;++j)
+				{
+				GLfloat x=GLfloat(double(x1)+(histogramMin+binWidth*double(i+j)-valueMin)*xScale);
+				if(x<x1)
+					x=x1;
+				else if(x>x2)
+					x=x2;
+				glVertex3f(x,y,colorBarBox.origin[2]+marginWidth*0.125f);
+				}
+			}
+		glEnd();
+		}
+	
 	if(lightingEnabled)
 		glEnable(GL_LIGHTING);
 	
@@ -419,4 +449,26 @@ void ColorBar::setValueRange(double newValueMin,double newValueMax)
 		resize(Box(Vector(0.0f,0.0f,0.0f),calcNaturalSize()));
 	}
 
+void ColorBar::setHistogram(const std::vector<size_t>& newHistogram,double newHistogramMin,double newHistogramMax)
+	{
+	histogramMin=newHistogramMin;
+	histogramMax=newHistogramMax;
+	
+	/* Find the largest bin count: */
+	size_t maxCount=0;
+	for(std::vector<size_t>::const_iterator hIt=newHistogram.begin();hIt!=newHistogram.end();++hIt)
+		if(maxCount<*hIt)
+			maxCount=*hIt;
+	
+	/* Scale the bin counts logarithmically, so that sparsely populated value ranges remain visible: */
+	histogram.clear();
+	if(maxCount>0)
+		{
+		histogram.reserve(newHistogram.size());
+		double scale=1.0/Math::log(double(maxCount)+1.0);
+		for(std::vector<size_t>::const_iterator hIt=newHistogram.begin();hIt!=newHistogram.end();++hIt)
+			histogram.push_back(GLfloat(Math::log(double(*hIt)+1.0)*scale));
+		}
+	}
+
 }
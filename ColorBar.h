@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef COLORBAR_INCLUDED
 #define COLORBAR_INCLUDED
 
+#include <vector>
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 #include <GL/GLFont.h>
@@ -86,6 +87,8 @@ class ColorBar:public Widget,public GLObject
 	int numTickMarks; // Number of tick marks to place underneath color bar
 	TickMark* tickMarks; // Array of tick mark labels
 	GLuint tickMarksVersion; // Version number of all tick marks
+	double histogramMin,histogramMax; // Value range covered by the value histogram
+	std::vector<GLfloat> histogram; // Logarithmically scaled bin heights of the value histogram drawn over the color bar, or empty
 	
 	/* Private methods: */
 	void updateTickMarks(void); // Updates tick marks after any changes
@@ -107,6 +110,7 @@ class ColorBar:public Widget,public GLObject
 	/* New methods: */
 	void setColorMap(GLColorMap* newColorMap); // Sets a new color map
 	void setValueRange(double newValueMin,double newValueMax); // Sets a new value range
+	void setHistogram(const std::vector<size_t>& newHistogram,double newHistogramMin,double newHistogramMax); // Sets a histogram of the mapped values to draw over the color bar; empty histogram disables drawing
 	};
 
 }
@@ -201,6 +201,30 @@ void ColorMap::draw(GLContextData& contextData) const
 		glVertex3f(cpPtr->x,y1,z);
 		}
 	glEnd();
+	if(!histogram.empty())
+		{
+		/* Draw the value histogram as a step curve: */
+		GLfloat x1=colorMapAreaBox.getCorner(0)[0];
+		GLfloat x2=colorMapAreaBox.getCorner(1)[0];
+		double xScale=double(x2-x1)/(valueRange.second-valueRange.first);
+		double binWidth=(histogramRange.second-histogramRange.first)/double(histogram.size());
+		glColor3f(0.5f,0.5f,0.5f);
+		glBegin(GL_LINE_STRIP);
+		for(size_t i=0;i<histogram.size();++i)
+			{
+			GLfloat y=y1+histogram[i]*(y2-y1);
+			for(size_t j=0;j<2;++j)
+				{
+				GLfloat x=GLfloat(double(x1)+(histogramRange.first+binWidth*double(i+j)-valueRange.first)*xScale);
+				if(x<x1)
+					x=x1;
+				else if(x>x2)
+					x=x2;
+				glVertex3f(x,y,z+marginWidth*0.125f);
+				}
+			}
+		glEnd();
+		}
 	GLfloat lineWidth;
 	glGetFloatv(GL_LINE_WIDTH,&lineWidth);
 	glLineWidth(3.0f);
@@ -419,6 +443,27 @@ void ColorMap::setSelectedControlPointColor(const Color& newSelectedControlPoint
 	selectedControlPointColor=newSelectedControlPointColor;
 	}
 
+void ColorMap::setHistogram(const std::vector<size_t>& newHistogram,const ColorMap::ValueRange& newHistogramRange)
+	{
+	histogramRange=newHistogramRange;
+	
+	/* Find the largest bin count: */
+	size_t maxCount=0;
+	for(std::vector<size_t>::const_iterator hIt=newHistogram.begin();hIt!=newHistogram.end();++hIt)
+		if(maxCount<*hIt)
+			maxCount=*hIt;
+	
+	/* Scale the bin counts logarithmically, so that sparsely populated value ranges remain visible: */
+	histogram.clear();
+	if(maxCount>0)
+		{
+		histogram.reserve(newHistogram.size());
+		double scale=1.0/Math::log(double(maxCount)+1.0);
+		for(std::vector<size_t>::const_iterator hIt=newHistogram.begin();hIt!=newHistogram.end();++hIt)
+			histogram.push_back(GLfloat(Math::log(double(*hIt)+1.0)*scale));
+		}
+	}
+
 int ColorMap::getNumControlPoints(void) const
 	{
 	int result=0;
@@ -165,6 +165,8 @@ class ColorMap:public Widget
 	ControlPoint* selected; // Pointer to currently selected control point
 	bool isDragging; // Flag whether a control point is being dragged
 	Point::Vector dragOffset; // Offset between pointer and dragged control point in widget coordinates
+	ValueRange histogramRange; // Value range covered by the value histogram
+	std::vector<GLfloat> histogram; // Logarithmically scaled bin heights of the value histogram drawn over the color map area, or empty
 	
 	/* Private methods: */
 	void deleteColorMap(void); // Deletes the current color map so it can be recreated
@@ -189,6 +191,7 @@ class ColorMap:public Widget
 	void setPreferredSize(const Vector& newPreferredSize); // Sets a new preferred size
 	void setControlPointSize(GLfloat newControlPointSize); // Sets a new size for control points
 	void setSelectedControlPointColor(const Color& newSelectedControlPointColor); // Sets the color for the selected control points
+	void setHistogram(const std::vector<size_t>& newHistogram,const ValueRange& newHistogramRange); // Sets a histogram of the mapped values to draw over the color map area; empty histogram disables drawing
 	Misc::CallbackList& getSelectedControlPointChangedCallbacks(void) // Returns list of selected control point change callbacks
 		{
 		return selectedControlPointChangedCallbacks;
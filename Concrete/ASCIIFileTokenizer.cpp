@@ -0,0 +1,376 @@
+/***********************************************************************
+ASCIIFileTokenizer - Class to read numbers and lines from large ASCII
+data files through a block buffer, using a locale-independent number
+parser that does not allocate memory per token or per line.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/ASCIIFileTokenizer.h>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <Misc/ThrowStdErr.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/*************************************************************
+Powers of ten that are exactly representable as double values:
+*************************************************************/
+
+const double powersOf10[23]=
+	{
+	1.0e0,1.0e1,1.0e2,1.0e3,1.0e4,1.0e5,1.0e6,1.0e7,1.0e8,1.0e9,1.0e10,1.0e11,
+	1.0e12,1.0e13,1.0e14,1.0e15,1.0e16,1.0e17,1.0e18,1.0e19,1.0e20,1.0e21,1.0e22
+	};
+
+}
+
+/***********************************
+Methods of class ASCIIFileTokenizer:
+***********************************/
+
+bool ASCIIFileTokenizer::fillBuffer(void)
+	{
+	if(atEof)
+		return false;
+	
+	/* Move unread data to the beginning of the buffer: */
+	size_t unreadSize=bufferEnd-pos;
+	if(pos!=buffer)
+		memmove(buffer,pos,unreadSize);
+	
+	/* Grow the buffer if it is full of unread data: */
+	if(unreadSize==bufferSize)
+		{
+		char* newBuffer=new char[bufferSize*2+1];
+		memcpy(newBuffer,buffer,unreadSize);
+		delete[] buffer;
+		buffer=newBuffer;
+		bufferSize*=2;
+		}
+	pos=buffer;
+	bufferEnd=buffer+unreadSize;
+	
+	/* Read the next block from the file: */
+	ssize_t readSize;
+	do
+		{
+		readSize=read(fd,bufferEnd,bufferSize-unreadSize);
+		}
+	while(readSize<0&&errno==EINTR);
+	if(readSize<0)
+		Misc::throwStdErr("ASCIIFileTokenizer::fillBuffer: Error while reading file %s",fileName.c_str());
+	bufferEnd+=readSize;
+	*bufferEnd='\0';
+	if(readSize==0)
+		atEof=true;
+	
+	return readSize>0;
+	}
+
+char* ASCIIFileTokenizer::findLineEnd(void)
+	{
+	size_t searchOffset=0;
+	while(true)
+		{
+		/* Search the unread part of the buffer for a line break: */
+		char* lineEnd=static_cast<char*>(memchr(pos+searchOffset,'\n',bufferEnd-(pos+searchOffset)));
+		if(lineEnd!=0)
+			return lineEnd;
+		
+		/* Read more data; the last line ends at the end of the file: */
+		searchOffset=bufferEnd-pos;
+		if(!fillBuffer())
+			return bufferEnd;
+		}
+	}
+
+void ASCIIFileTokenizer::skipSpace(void)
+	{
+	while(true)
+		{
+		while(*pos==' '||*pos=='\t'||*pos=='\r')
+			++pos;
+		if(pos!=bufferEnd||!fillBuffer())
+			break;
+		}
+	}
+
+void ASCIIFileTokenizer::throwParseError(const char* methodName,const char* what) const
+	{
+	Misc::throwStdErr("ASCIIFileTokenizer::%s: Expected %s in line %u of file %s",methodName,what,lineNumber,fileName.c_str());
+	}
+
+ASCIIFileTokenizer::ASCIIFileTokenizer(const char* sFileName,size_t sBufferSize)
+	:fileName(sFileName),
+	 fd(open(sFileName,O_RDONLY)),
+	 bufferSize(sBufferSize),buffer(0),bufferEnd(0),pos(0),
+	 atEof(false),
+	 lineNumber(1)
+	{
+	if(fd<0)
+		Misc::throwStdErr("ASCIIFileTokenizer::ASCIIFileTokenizer: Unable to open file %s",sFileName);
+	
+	/* Create an empty buffer: */
+	if(bufferSize<maxTokenLength)
+		bufferSize=maxTokenLength;
+	buffer=new char[bufferSize+1];
+	bufferEnd=buffer;
+	*bufferEnd='\0';
+	pos=buffer;
+	}
+
+ASCIIFileTokenizer::~ASCIIFileTokenizer(void)
+	{
+	delete[] buffer;
+	close(fd);
+	}
+
+void ASCIIFileTokenizer::skipWhitespace(void)
+	{
+	while(true)
+		{
+		for(;*pos==' '||*pos=='\t'||*pos=='\r'||*pos=='\n';++pos)
+			if(*pos=='\n')
+				++lineNumber;
+		if(pos!=bufferEnd||!fillBuffer())
+			break;
+		}
+	}
+
+void ASCIIFileTokenizer::skipCommentLines(char commentChar)
+	{
+	skipWhitespace();
+	while(*pos==commentChar)
+		{
+		skipLine();
+		skipWhitespace();
+		}
+	}
+
+bool ASCIIFileTokenizer::eof(void)
+	{
+	skipWhitespace();
+	return pos==bufferEnd;
+	}
+
+bool ASCIIFileTokenizer::eol(void)
+	{
+	skipSpace();
+	return *pos=='\n'||pos==bufferEnd;
+	}
+
+void ASCIIFileTokenizer::skipLine(void)
+	{
+	pos=findLineEnd();
+	if(pos!=bufferEnd)
+		{
+		++pos;
+		++lineNumber;
+		}
+	}
+
+size_t ASCIIFileTokenizer::readLine(char* line,size_t lineSize)
+	{
+	/* Find the end of the line and strip a DOS line break: */
+	char* lineEnd=findLineEnd();
+	size_t lineLength=lineEnd-pos;
+	if(lineLength>0&&lineEnd[-1]=='\r')
+		--lineLength;
+	
+	/* Copy the line: */
+	size_t copyLength=lineLength<lineSize-1?lineLength:lineSize-1;
+	memcpy(line,pos,copyLength);
+	line[copyLength]='\0';
+	
+	/* Skip the line break: */
+	pos=lineEnd;
+	if(pos!=bufferEnd)
+		{
+		++pos;
+		++lineNumber;
+		}
+	
+	return lineLength;
+	}
+
+bool ASCIIFileTokenizer::findInLine(const char* string)
+	{
+	char* lineEnd=findLineEnd();
+	size_t stringLength=strlen(string);
+	for(char* sPtr=pos;sPtr+stringLength<=lineEnd;++sPtr)
+		if(*sPtr==*string&&memcmp(sPtr,string,stringLength)==0)
+			{
+			pos=sPtr+stringLength;
+			return true;
+			}
+	return false;
+	}
+
+bool ASCIIFileTokenizer::findLine(const char* string)
+	{
+	while(!findInLine(string))
+		{
+		/* Bail out if the current line is the last one: */
+		if(findLineEnd()==bufferEnd)
+			return false;
+		skipLine();
+		}
+	return true;
+	}
+
+long ASCIIFileTokenizer::readInteger(void)
+	{
+	skipWhitespace();
+	ensureToken();
+	
+	/* Parse the sign: */
+	char* tPtr=pos;
+	bool negative=*tPtr=='-';
+	if(*tPtr=='-'||*tPtr=='+')
+		++tPtr;
+	
+	/* Parse the digits: */
+	if(*tPtr<'0'||*tPtr>'9')
+		throwParseError("readInteger","integer");
+	long result=0;
+	for(;*tPtr>='0'&&*tPtr<='9';++tPtr)
+		result=result*10+long(*tPtr-'0');
+	pos=tPtr;
+	
+	return negative?-result:result;
+	}
+
+double ASCIIFileTokenizer::readDouble(void)
+	{
+	skipWhitespace();
+	ensureToken();
+	
+	/* Parse the sign: */
+	char* tokenStart=pos;
+	char* tPtr=pos;
+	bool negative=*tPtr=='-';
+	if(*tPtr=='-'||*tPtr=='+')
+		++tPtr;
+	
+	/* Parse the integer and fractional digits, keeping up to 19 significant digits in a 64-bit mantissa: */
+	unsigned long long mantissa=0;
+	int numSignificantDigits=0;
+	int exponent=0;
+	bool haveDigits=false;
+	for(;*tPtr>='0'&&*tPtr<='9';++tPtr)
+		{
+		haveDigits=true;
+		if(numSignificantDigits<19)
+			{
+			mantissa=mantissa*10ULL+(unsigned long long)(*tPtr-'0');
+			if(mantissa!=0ULL)
+				++numSignificantDigits;
+			}
+		else
+			++exponent;
+		}
+	if(*tPtr=='.')
+		{
+		for(++tPtr;*tPtr>='0'&&*tPtr<='9';++tPtr)
+			{
+			haveDigits=true;
+			if(numSignificantDigits<19)
+				{
+				mantissa=mantissa*10ULL+(unsigned long long)(*tPtr-'0');
+				if(mantissa!=0ULL)
+					++numSignificantDigits;
+				--exponent;
+				}
+			}
+		}
+	
+	if(haveDigits)
+		{
+		/* Parse the exponent in C or Fortran notation: */
+		if(*tPtr=='e'||*tPtr=='E'||*tPtr=='d'||*tPtr=='D')
+			{
+			char* ePtr=tPtr+1;
+			bool negativeExponent=*ePtr=='-';
+			if(*ePtr=='-'||*ePtr=='+')
+				++ePtr;
+			if(*ePtr>='0'&&*ePtr<='9')
+				{
+				int fileExponent=0;
+				for(;*ePtr>='0'&&*ePtr<='9';++ePtr)
+					if(fileExponent<100000)
+						fileExponent=fileExponent*10+int(*ePtr-'0');
+				exponent+=negativeExponent?-fileExponent:fileExponent;
+				tPtr=ePtr;
+				}
+			}
+		pos=tPtr;
+		
+		/* Convert exactly with a single rounding if the mantissa and the power of ten are exactly representable: */
+		double result;
+		if(mantissa==0ULL)
+			result=0.0;
+		else if(mantissa<=(1ULL<<53)&&exponent>=-22&&exponent<=22)
+			result=exponent>=0?double(mantissa)*powersOf10[exponent]:double(mantissa)/powersOf10[-exponent];
+		else
+			{
+			/* Let the C library round rare long or extreme numbers correctly: */
+			char token[maxTokenLength+1];
+			size_t tokenLength=tPtr-tokenStart;
+			if(tokenLength>maxTokenLength)
+				tokenLength=maxTokenLength;
+			memcpy(token,tokenStart,tokenLength);
+			token[tokenLength]='\0';
+			for(char* cPtr=token;*cPtr!='\0';++cPtr)
+				if(*cPtr=='d'||*cPtr=='D')
+					*cPtr='e';
+			return strtod(token,0);
+			}
+		
+		return negative?-result:result;
+		}
+	else
+		{
+		/* Let the C library parse special values like infinities or NaNs: */
+		char token[maxTokenLength+1];
+		size_t tokenLength=0;
+		for(char* cPtr=tokenStart;tokenLength<maxTokenLength&&*cPtr!='\0'&&*cPtr!=' '&&*cPtr!='\t'&&*cPtr!='\r'&&*cPtr!='\n';++cPtr,++tokenLength)
+			token[tokenLength]=*cPtr;
+		token[tokenLength]='\0';
+		char* tokenEnd;
+		double result=strtod(token,&tokenEnd);
+		if(tokenEnd==token)
+			throwParseError("readDouble","number");
+		pos=tokenStart+(tokenEnd-token);
+		
+		return result;
+		}
+	}
+
+}
+
+}
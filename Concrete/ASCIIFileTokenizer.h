@@ -0,0 +1,99 @@
+/***********************************************************************
+ASCIIFileTokenizer - Class to read numbers and lines from large ASCII
+data files through a block buffer, using a locale-independent number
+parser that does not allocate memory per token or per line.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_ASCIIFILETOKENIZER_INCLUDED
+#define VISUALIZATION_CONCRETE_ASCIIFILETOKENIZER_INCLUDED
+
+#include <stddef.h>
+#include <string>
+
+namespace Visualization {
+
+namespace Concrete {
+
+class ASCIIFileTokenizer
+	{
+	/* Elements: */
+	private:
+	static const size_t maxTokenLength=256; // Maximum length of a number token; longer tokens are split
+	std::string fileName; // Name of the file, for error messages
+	int fd; // File descriptor of the file
+	size_t bufferSize; // Allocated size of the buffer, excluding the terminating sentinel
+	char* buffer; // Buffer holding a block of the file
+	char* bufferEnd; // End of the valid data in the buffer; always points to a NUL sentinel
+	char* pos; // Current read position in the buffer
+	bool atEof; // Flag whether the entire file has been read into the buffer
+	unsigned int lineNumber; // Number of the line containing the current read position, starting at 1
+	
+	/* Private methods: */
+	bool fillBuffer(void); // Moves unread data to the beginning of the buffer, grows the buffer if it is full, and appends more data from the file; returns false if the file is already completely read
+	void ensureToken(void) // Ensures that the buffer holds a complete token at the current read position
+		{
+		if(size_t(bufferEnd-pos)<maxTokenLength&&!atEof)
+			fillBuffer();
+		}
+	char* findLineEnd(void); // Ensures that the buffer holds the rest of the current line and returns a pointer to its end
+	void skipSpace(void); // Skips whitespace inside the current line
+	void throwParseError(const char* methodName,const char* what) const; // Throws an exception describing a parse error at the current read position
+	
+	/* Constructors and destructors: */
+	public:
+	ASCIIFileTokenizer(const char* sFileName,size_t sBufferSize =1024*1024); // Opens the given file for reading with the given initial buffer size
+	private:
+	ASCIIFileTokenizer(const ASCIIFileTokenizer& source); // Prohibit copy constructor
+	ASCIIFileTokenizer& operator=(const ASCIIFileTokenizer& source); // Prohibit assignment operator
+	public:
+	~ASCIIFileTokenizer(void); // Closes the file
+	
+	/* Methods: */
+	const std::string& getFileName(void) const // Returns the name of the file
+		{
+		return fileName;
+		}
+	unsigned int getLineNumber(void) const // Returns the number of the line containing the current read position
+		{
+		return lineNumber;
+		}
+	void skipWhitespace(void); // Skips whitespace including line breaks
+	void skipCommentLines(char commentChar); // Skips whitespace and all lines whose first non-whitespace character is the given comment character
+	bool eof(void); // Skips whitespace including line breaks; returns true if the end of the file was reached
+	bool eol(void); // Skips whitespace inside the current line; returns true if the end of the line or file was reached
+	void skipLine(void); // Skips the rest of the current line including its line break
+	size_t readLine(char* line,size_t lineSize); // Copies the rest of the current line without its line break into the given buffer, truncating if necessary, and skips the line break; returns the line's length
+	bool findInLine(const char* string); // Searches for the given string in the rest of the current line; moves the read position behind the string and returns true if found; leaves the read position unchanged otherwise
+	bool findLine(const char* string); // Skips lines until finding one that contains the given string; moves the read position behind the string and returns true if found
+	long readInteger(void); // Reads a decimal integer; throws exception if there is none
+	double readDouble(void); // Reads a floating-point number in C or Fortran notation; throws exception if there is none
+	template <class ValueParam>
+	void readValues(ValueParam* values,size_t numValues) // Reads the given number of floating-point numbers and converts them to the given type
+		{
+		for(size_t i=0;i<numValues;++i)
+			values[i]=ValueParam(readDouble());
+		}
+	};
+
+}
+
+}
+
+#endif
@@ -20,9 +20,11 @@ with the 3D Data Visualizer; if not, write to the Free Software
 Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 ***********************************************************************/
 
+#include <vector>
 #include <Misc/File.h>
 #include <Plugins/FactoryManager.h>
 
+#include <Concrete/MappedFile.h>
 #include <Concrete/AnalyzeFile.h>
 
 namespace Visualization {
@@ -104,19 +106,23 @@ Helper functions:
 ****************/
 
 template <class ScalarParam>
-void readArray(Misc::File& file,Misc::Array<float,3>& array)
+void readArray(Misc::File& file,float* values,size_t numValues)
 	{
-	/* Create a temporary array: */
-	Misc::Array<ScalarParam,3> tempArray(array.getSize());
+	/* Create a temporary buffer holding one block of the file: */
+	const size_t blockSize=65536;
+	std::vector<ScalarParam> block(blockSize);
 	
-	/* Read the file into the temporary array: */
-	file.read<ScalarParam>(tempArray.getArray(),tempArray.getNumElements());
-	
-	/* Copy and convert data from the temporary array into the final array: */
-	const ScalarParam* sPtr=tempArray.getArray();
-	float* dPtr=array.getArray();
-	for(int i=array.getNumElements();i>0;--i,++sPtr,++dPtr)
-		*dPtr=float(*sPtr);
+	for(size_t blockStart=0;blockStart<numValues;blockStart+=blockSize)
+		{
+		/* Read the next block from the file: */
+		size_t blockEnd=blockStart+blockSize<numValues?blockStart+blockSize:numValues;
+		file.read<ScalarParam>(&block[0],blockEnd-blockStart);
+		
+		/* Copy and convert data from the block into the final array: */
+		const ScalarParam* sPtr=&block[0];
+		for(size_t i=blockStart;i<blockEnd;++i,++sPtr,++values)
+			*values=float(*sPtr);
+		}
 	}
 
 }
@@ -169,38 +175,49 @@ Visualization::Abstract::DataSet* AnalyzeFile::load(const std::vector<std::strin
 		cellSize[i]=imageDim.pixDim[3-i];
 		}
 	DataSet* result=new DataSet;
-	result->getDs().setData(numVertices,cellSize);
 	
 	/* Open the image file: */
 	char imageFileName[2048];
 	snprintf(imageFileName,sizeof(imageFileName),"%s.img",args[0].c_str());
 	Misc::File imageFile(imageFileName,"rb",endianness);
 	
-	/* Read the vertex values from file: */
-	switch(imageDim.dataType)
+	/* Map the vertex values directly from the image file if they are stored as floats in the host's byte order: */
+	size_t numValues=size_t(numVertices.calcIncrement(-1));
+	MappedFile* mappedFile=0;
+	if(imageDim.dataType==16&&MappedFile::isNativeEndianness(endianness))
+		mappedFile=MappedFile::mapArray<DS::Value>(imageFileName,0,numValues);
+	if(mappedFile!=0)
+		result->getDs().adoptData(numVertices,cellSize,mappedFile->getArray<DS::Value>(0),mappedFile);
+	else
 		{
-		case 2: // unsigned char
-			readArray<unsigned char>(imageFile,result->getDs().getVertices());
-			break;
-		
-		case 4: // signed short
-			readArray<signed short int>(imageFile,result->getDs().getVertices());
-			break;
-		
-		case 8: // signed int
-			readArray<signed int>(imageFile,result->getDs().getVertices());
-			break;
-		
-		case 16: // float
-			imageFile.read(result->getDs().getVertices().getArray(),result->getDs().getVertices().getNumElements());
-			break;
-		
-		case 64: // double
-			readArray<double>(imageFile,result->getDs().getVertices());
-			break;
-		
-		default:
-			Misc::throwStdErr("AnalyzeFile::load: Unsupported data type %d in input file %s",imageDim.dataType,imageFileName);
+		/* Read the vertex values from file, converting them to floats and swapping their byte order if necessary: */
+		result->getDs().setData(numVertices,cellSize);
+		float* values=result->getDs().getVertexArray();
+		switch(imageDim.dataType)
+			{
+			case 2: // unsigned char
+				readArray<unsigned char>(imageFile,values,numValues);
+				break;
+			
+			case 4: // signed short
+				readArray<signed short int>(imageFile,values,numValues);
+				break;
+			
+			case 8: // signed int
+				readArray<signed int>(imageFile,values,numValues);
+				break;
+			
+			case 16: // float
+				imageFile.read(values,numValues);
+				break;
+			
+			case 64: // double
+				readArray<double>(imageFile,values,numValues);
+				break;
+			
+			default:
+				Misc::throwStdErr("AnalyzeFile::load: Unsupported data type %d in input file %s",imageDim.dataType,imageFileName);
+			}
 		}
 	
 	return result;
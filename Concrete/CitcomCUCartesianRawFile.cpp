@@ -25,18 +25,181 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <stdio.h>
 #include <iostream>
 #include <iomanip>
+#include <string>
+#include <vector>
 #include <Misc/SelfDestructPointer.h>
 #include <Misc/ThrowStdErr.h>
 #include <Misc/File.h>
 #include <Plugins/FactoryManager.h>
 #include <Math/Math.h>
 
+#include <Concrete/ParallelFileReader.h>
+
 #include <Concrete/CitcomCUCartesianRawFile.h>
 
 namespace Visualization {
 
 namespace Concrete {
 
+namespace {
+
+/*******************************************************************
+Helper classes to read the per-CPU files of a parallel CitcomCU run:
+*******************************************************************/
+
+class CpuFileReader // Base class for functors reading the files written by one CPU into the CPU's block of the data set's grid
+	{
+	/* Elements: */
+	protected:
+	DS& dataSet; // Data set receiving the files' contents
+	std::string baseFileName; // Base name of the run's data files
+	DS::Index numCpus; // Number of CPUs along each grid dimension
+	DS::Index cpuNumVertices; // Number of grid vertices per CPU along each grid dimension
+	int totalCpuNumVertices; // Total number of grid vertices per CPU
+	
+	/* Constructors and destructors: */
+	public:
+	CpuFileReader(DS& sDataSet,const std::string& sBaseFileName,const DS::Index& sNumCpus,const DS::Index& sCpuNumVertices)
+		:dataSet(sDataSet),
+		 baseFileName(sBaseFileName),
+		 numCpus(sNumCpus),cpuNumVertices(sCpuNumVertices),
+		 totalCpuNumVertices(cpuNumVertices.calcIncrement(-1))
+		{
+		}
+	
+	/* Methods: */
+	int getCpu(unsigned int fileIndex,DS::Index& cpuIndex,DS::Index& cpuBase) const // Returns the CPU index and grid base index of the CPU writing the given file in sequential order; returns the CPU's linear number
+		{
+		for(int i=2;i>=0;--i)
+			{
+			cpuIndex[i]=int(fileIndex%(unsigned int)numCpus[i]);
+			fileIndex/=(unsigned int)numCpus[i];
+			}
+		for(int i=0;i<3;++i)
+			cpuBase[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
+		return (cpuIndex[1]*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
+		}
+	bool isOwner(const DS::Index& cpuIndex,const DS::Index& index) const // Returns true if the given CPU stores the given vertex of its block; vertices shared by neighboring CPUs are stored by the last CPU in sequential order
+		{
+		for(int i=0;i<3;++i)
+			if(index[i]==cpuNumVertices[i]-1&&cpuIndex[i]<numCpus[i]-1)
+				return false;
+		return true;
+		}
+	};
+
+class GridFileReader:public CpuFileReader // Functor reading a CPU's grid definition files
+	{
+	/* Constructors and destructors: */
+	public:
+	GridFileReader(DS& sDataSet,const std::string& sBaseFileName,const DS::Index& sNumCpus,const DS::Index& sCpuNumVertices)
+		:CpuFileReader(sDataSet,sBaseFileName,sNumCpus,sCpuNumVertices)
+		{
+		}
+	
+	/* Methods: */
+	void operator()(unsigned int fileIndex) const // Reads the given CPU's grid definition files
+		{
+		/* Calculate the base grid index and linear number for this CPU: */
+		DS::Index cpuIndex,cpuBase;
+		int cpuNumber=getCpu(fileIndex,cpuIndex,cpuBase);
+		
+		/* Read the CPU's grid definition files: */
+		std::vector<float> gridVertices[3];
+		for(int i=0;i<3;++i)
+			{
+			/* Read the grid file into a temporary array, skipping the first (bogus) element: */
+			gridVertices[i].resize(totalCpuNumVertices);
+			char gridFileName[1024];
+			snprintf(gridFileName,sizeof(gridFileName),"%s.%c.%d",baseFileName.c_str(),'x'+i,cpuNumber);
+			Misc::File gridFile(gridFileName,"rb",Misc::File::LittleEndian);
+			gridFile.seekSet(sizeof(float));
+			gridFile.read(&gridVertices[i][0],totalCpuNumVertices);
+			}
+		
+		/* Assemble and write the CPU's grid vertices: */
+		DS::Index index;
+		int linearIndex=0;
+		for(index[1]=0;index[1]<cpuNumVertices[1];++index[1])
+			for(index[0]=0;index[0]<cpuNumVertices[0];++index[0])
+				for(index[2]=0;index[2]<cpuNumVertices[2];++index[2],++linearIndex)
+					if(isOwner(cpuIndex,index))
+						{
+						/* Get a reference to the vertex in the merged grid: */
+						DS::Point& vertex=dataSet.getVertexPosition(DS::Index(cpuBase[0]+index[0],cpuBase[1]+index[1],cpuBase[2]+index[2]));
+						
+						/* Copy the grid point: */
+						for(int i=0;i<3;++i)
+							vertex[i]=Scalar(gridVertices[i][linearIndex]);
+						}
+		}
+	};
+
+class DataFileReader:public CpuFileReader // Functor reading a CPU's data file for one time step
+	{
+	/* Elements: */
+	private:
+	const std::string& variableName; // Name of the variable stored in the data files
+	int timeStepIndex; // Index of the time step to read
+	bool isVector; // Flag whether the variable is a vector variable
+	bool logScalar; // Flag whether to store the logarithm of scalar values
+	int sliceIndex; // Index of the first slice receiving the variable's values
+	
+	/* Constructors and destructors: */
+	public:
+	DataFileReader(DS& sDataSet,const std::string& sBaseFileName,const DS::Index& sNumCpus,const DS::Index& sCpuNumVertices,const std::string& sVariableName,int sTimeStepIndex,bool sIsVector,bool sLogScalar,int sSliceIndex)
+		:CpuFileReader(sDataSet,sBaseFileName,sNumCpus,sCpuNumVertices),
+		 variableName(sVariableName),
+		 timeStepIndex(sTimeStepIndex),
+		 isVector(sIsVector),logScalar(sLogScalar),
+		 sliceIndex(sSliceIndex)
+		{
+		}
+	
+	/* Methods: */
+	void operator()(unsigned int fileIndex) const // Reads the given CPU's data file
+		{
+		/* Calculate the base grid index and linear number for this CPU: */
+		DS::Index cpuIndex,cpuBase;
+		int cpuNumber=getCpu(fileIndex,cpuIndex,cpuBase);
+		
+		/* Read the data file into a temporary array, skipping the first (bogus) element: */
+		size_t numDataValues=isVector?totalCpuNumVertices*3:totalCpuNumVertices;
+		std::vector<float> dataValues(numDataValues);
+		char dataFileName[1024];
+		snprintf(dataFileName,sizeof(dataFileName),"%s.%s.%d.%d",baseFileName.c_str(),variableName.c_str(),cpuNumber,timeStepIndex);
+		Misc::File dataFile(dataFileName,"rb",Misc::File::LittleEndian);
+		dataFile.seekSet(sizeof(float));
+		dataFile.read(&dataValues[0],numDataValues);
+		
+		/* Write the CPU's data values: */
+		DS::Index index;
+		const float* dvPtr=&dataValues[0];
+		for(index[1]=0;index[1]<cpuNumVertices[1];++index[1])
+			for(index[0]=0;index[0]<cpuNumVertices[0];++index[0])
+				for(index[2]=0;index[2]<cpuNumVertices[2];++index[2],dvPtr+=isVector?3:1)
+					if(isOwner(cpuIndex,index))
+						{
+						DS::Index gridIndex(cpuBase[0]+index[0],cpuBase[1]+index[1],cpuBase[2]+index[2]);
+						if(isVector)
+							{
+							/* Store the vector value: */
+							DataValue::VVector vector;
+							for(int i=0;i<3;++i)
+								{
+								vector[i]=VScalar(dvPtr[i]);
+								dataSet.getVertexValue(sliceIndex+i,gridIndex)=vector[i];
+								}
+							dataSet.getVertexValue(sliceIndex+3,gridIndex)=VScalar(Geometry::mag(vector));
+							}
+						else
+							dataSet.getVertexValue(sliceIndex,gridIndex)=logScalar?VScalar(Math::log10(double(*dvPtr))):VScalar(*dvPtr);
+						}
+		}
+	};
+
+}
+
 /*****************************************
 Methods of class CitcomCUCartesianRawFile:
 *****************************************/
@@ -98,58 +261,17 @@ Visualization::Abstract::DataSet* CitcomCUCartesianRawFile::load(const std::vect
 	DS::Index cpuNumVertices;
 	for(int i=0;i<3;++i)
 		cpuNumVertices[i]=(numVertices[i]-1)/numCpus[i]+1;
-	int totalCpuNumVertices=cpuNumVertices.calcIncrement(-1);
 	
-	/* Create temporary arrays to hold the grid vertex components: */
-	float* gridVertices[3];
-	for(int i=0;i<3;++i)
-		gridVertices[i]=new float[totalCpuNumVertices];
+	/* Compute the number of files per variable: */
+	unsigned int numFiles=(unsigned int)numCpus.calcIncrement(-1);
 	
-	/* Read grid and value files from each CPU and merge them into the data set: */
+	/* Read the grid definition files for all CPUs: */
 	std::cout<<"Reading grid vertex positions...   0%"<<std::flush;
-	int cpuCounter=0;
-	for(DS::Index cpuIndex(0);cpuIndex[0]<numCpus[0];cpuIndex.preInc(numCpus),++cpuCounter)
-		{
-		/* Calculate the base grid index and linear number for this CPU: */
-		DS::Index cpuBase;
-		for(int i=0;i<3;++i)
-			cpuBase[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
-		int cpuNumber=(cpuIndex[1]*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
-		
-		/* Read the CPU's grid definition files: */
-		for(int i=0;i<3;++i)
-			{
-			/* Read the grid file into the temporary array, skipping the first (bogus) element: */
-			char gridFileName[1024];
-			snprintf(gridFileName,sizeof(gridFileName),"%s.%c.%d",argIt->c_str(),'x'+i,cpuNumber);
-			Misc::File gridFile(gridFileName,"rb",Misc::File::LittleEndian);
-			gridFile.seekSet(sizeof(float));
-			gridFile.read(gridVertices[i],totalCpuNumVertices);
-			}
-		
-		/* Assemble and write the CPU's grid vertices: */
-		DS::Index index;
-		int linearIndex=0;
-		for(index[1]=0;index[1]<cpuNumVertices[1];++index[1])
-			for(index[0]=0;index[0]<cpuNumVertices[0];++index[0])
-				for(index[2]=0;index[2]<cpuNumVertices[2];++index[2],++linearIndex)
-					{
-					/* Get a reference to the vertex in the merged grid: */
-					DS::Point& vertex=dataSet.getVertexPosition(DS::Index(cpuBase[0]+index[0],cpuBase[1]+index[1],cpuBase[2]+index[2]));
-					
-					/* Copy the grid point: */
-					for(int i=0;i<3;++i)
-						vertex[i]=Scalar(gridVertices[i][linearIndex]);
-					}
-		
-		std::cout<<"\b\b\b\b"<<std::setw(3)<<((cpuCounter+1)*100)/numCpus.calcIncrement(-1)<<"%"<<std::flush;
-		}
+	GridFileReader gridFileReader(dataSet,*argIt,numCpus,cpuNumVertices);
+	ParallelFileReader<GridFileReader> gridReader(gridFileReader,numFiles);
+	gridReader.read(getNumLoadThreads());
 	std::cout<<"\b\b\b\bdone"<<std::endl;
 
-	/* Delete the grid vertex arrays: */
-	for(int i=0;i<3;++i)
-		delete[] gridVertices[i];
-	
 	/* Finalize the grid structure: */
 	std::cout<<"Finalizing grid structure..."<<std::flush;
 	dataSet.finalizeGrid();
@@ -228,60 +350,12 @@ Visualization::Abstract::DataSet* CitcomCUCartesianRawFile::load(const std::vect
 				dataSet.addSlice();
 				}
 			
-			/* Create a temporary array for the data values: */
-			float* dataValues=new float[nextVector?totalCpuNumVertices*3:totalCpuNumVertices];
-			
 			/* Read data files for all CPUs: */
-			cpuCounter=0;
-			for(DS::Index cpuIndex(0);cpuIndex[0]<numCpus[0];cpuIndex.preInc(numCpus),++cpuCounter)
-				{
-				/* Calculate the base grid index and linear number for this CPU: */
-				DS::Index cpuBase;
-				for(int i=0;i<3;++i)
-					cpuBase[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
-				int cpuNumber=(cpuIndex[1]*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
-				
-				/* Open the data file: */
-				char dataFileName[1024];
-				snprintf(dataFileName,sizeof(dataFileName),"%s.%s.%d.%d",args[0].c_str(),argIt->c_str(),cpuNumber,timeStepIndex);
-				Misc::File dataFile(dataFileName,"rb",Misc::File::LittleEndian);
-				dataFile.seekSet(sizeof(float));
-				dataFile.read(dataValues,nextVector?totalCpuNumVertices*3:totalCpuNumVertices);
-				
-				/* Write the CPU's data values: */
-				DS::Index index;
-				float* dvPtr=dataValues;
-				for(index[1]=0;index[1]<cpuNumVertices[1];++index[1])
-					for(index[0]=0;index[0]<cpuNumVertices[0];++index[0])
-						for(index[2]=0;index[2]<cpuNumVertices[2];++index[2])
-							{
-							DS::Index gridIndex(cpuBase[0]+index[0],cpuBase[1]+index[1],cpuBase[2]+index[2]);
-							if(nextVector)
-								{
-								/* Store the vector value: */
-								DataValue::VVector vector;
-								for(int i=0;i<3;++i)
-									{
-									vector[i]=VScalar(dvPtr[i]);
-									dataSet.getVertexValue(sliceIndex+i,gridIndex)=vector[i];
-									}
-								dataSet.getVertexValue(sliceIndex+3,gridIndex)=VScalar(Geometry::mag(vector));
-								dvPtr+=3;
-								}
-							else
-								{
-								dataSet.getVertexValue(sliceIndex,gridIndex)=logNextScalar?VScalar(Math::log10(double(*dvPtr))):VScalar(*dvPtr);
-								++dvPtr;
-								}
-							}
-				
-				std::cout<<"\b\b\b\b"<<std::setw(3)<<((cpuCounter+1)*100)/numCpus.calcIncrement(-1)<<"%"<<std::flush;
-				}
+			DataFileReader dataFileReader(dataSet,args[0],numCpus,cpuNumVertices,*argIt,timeStepIndex,nextVector,logNextScalar,sliceIndex);
+			ParallelFileReader<DataFileReader> dataReader(dataFileReader,numFiles);
+			dataReader.read(getNumLoadThreads());
 			std::cout<<"\b\b\b\bdone"<<std::endl;
 			
-			/* Delete the temporary array: */
-			delete[] dataValues;
-			
 			if(nextVector)
 				nextVector=false;
 			else
@@ -38,6 +38,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Concrete/SphericalCoordinateTransformer.h>
 #include <Concrete/EarthDataSet.h>
 #include <Concrete/CitcomSCfgFileParser.h>
+#include <Concrete/ParallelFileReader.h>
 
 #include <Concrete/CitcomSRegionalASCIIFile.h>
 
@@ -45,6 +46,267 @@ namespace Visualization {
 
 namespace Concrete {
 
+namespace {
+
+/******************************************************************
+Helper classes to read the per-CPU files of a parallel CitcomS run:
+******************************************************************/
+
+class CpuFileReader // Base class for functors reading the file written by one CPU into the CPU's block of the data set's grid
+	{
+	/* Elements: */
+	protected:
+	DS& dataSet; // Data set receiving the files' contents
+	DS::Index numCpus; // Number of CPUs along each grid dimension
+	DS::Index cpuNumVertices; // Number of grid vertices per CPU along each grid dimension
+	int totalCpuNumVertices; // Total number of grid vertices per CPU
+	
+	/* Constructors and destructors: */
+	public:
+	CpuFileReader(DS& sDataSet,const DS::Index& sNumCpus,const DS::Index& sCpuNumVertices)
+		:dataSet(sDataSet),
+		 numCpus(sNumCpus),cpuNumVertices(sCpuNumVertices),
+		 totalCpuNumVertices(cpuNumVertices.calcIncrement(-1))
+		{
+		}
+	
+	/* Methods: */
+	int getCpu(unsigned int fileIndex,DS::Index& cpuIndex,DS::Index& cpuBaseIndex) const // Returns the CPU index and grid base index of the CPU writing the given file in sequential order; returns the CPU's linear index
+		{
+		for(int i=2;i>=0;--i)
+			{
+			cpuIndex[i]=int(fileIndex%(unsigned int)numCpus[i]);
+			fileIndex/=(unsigned int)numCpus[i];
+			}
+		for(int i=0;i<3;++i)
+			cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
+		return (cpuIndex[1]*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
+		}
+	bool isOwner(const DS::Index& cpuIndex,const DS::Index& gridIndex) const // Returns true if the given CPU stores the given vertex of its block; vertices shared by neighboring CPUs are stored by the last CPU in sequential order
+		{
+		for(int i=0;i<3;++i)
+			if(gridIndex[i]==cpuNumVertices[i]-1&&cpuIndex[i]<numCpus[i]-1)
+				return false;
+		return true;
+		}
+	};
+
+class CoordFileReader:public CpuFileReader // Functor reading a CPU's grid coordinate file
+	{
+	/* Elements: */
+	private:
+	const std::string& dataDir; // Directory containing the run's data files
+	const std::string& dataFileName; // Base name of the run's data files
+	bool storeSphericals; // Flag whether to store the vertices' spherical coordinates in the first three slices
+	
+	/* Constructors and destructors: */
+	public:
+	CoordFileReader(DS& sDataSet,const DS::Index& sNumCpus,const DS::Index& sCpuNumVertices,const std::string& sDataDir,const std::string& sDataFileName,bool sStoreSphericals)
+		:CpuFileReader(sDataSet,sNumCpus,sCpuNumVertices),
+		 dataDir(sDataDir),dataFileName(sDataFileName),
+		 storeSphericals(sStoreSphericals)
+		{
+		}
+	
+	/* Methods: */
+	void operator()(unsigned int fileIndex) const // Reads the given CPU's coordinate file
+		{
+		/* Prepare the spherical-to-Cartesian formula: */
+		const double a=6378.14e3; // Equatorial radius in m
+		// const double f=1.0/298.247; // Geoid flattening factor (not used, since there could be vector values)
+		const double scaleFactor=1.0e-3; // Scale factor for Cartesian coordinates
+		
+		/* Find the CPU's position in the grid: */
+		DS::Index cpuIndex,cpuBaseIndex;
+		int cpuLinearIndex=getCpu(fileIndex,cpuIndex,cpuBaseIndex);
+		DS::GridArray& grid=dataSet.getGrid();
+		
+		/* Open the CPU's coordinate file: */
+		char coordFileName[1024];
+		snprintf(coordFileName,sizeof(coordFileName),"%s/%s.coord.%d",dataDir.c_str(),dataFileName.c_str(),cpuLinearIndex);
+		Misc::File coordFile(coordFileName,"rt");
+		
+		/* Read and check the header line: */
+		char line[256];
+		coordFile.gets(line,sizeof(line));
+		int dummy,coordFileNumVertices;
+		if(sscanf(line,"%d %d",&dummy,&coordFileNumVertices)!=2)
+			Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in coordinate file %s",coordFileName);
+		if(coordFileNumVertices!=totalCpuNumVertices)
+			Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in coordinate file %s",coordFileName);
+		
+		/* Read the grid vertices: */
+		DS::Index gridIndex;
+		for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
+			for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
+				for(gridIndex[2]=0;gridIndex[2]<cpuNumVertices[2];++gridIndex[2])
+					{
+					/* Read the next line: */
+					coordFile.gets(line,sizeof(line));
+					
+					/* Parse the grid vertex: */
+					double colatitude,longitude,radius;
+					if(sscanf(line,"%lf %lf %lf",&colatitude,&longitude,&radius)!=3)
+						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in coordinate file %s",coordFileName);
+					if(!isOwner(cpuIndex,gridIndex))
+						continue;
+					double latitude=Math::rad(90.0)-colatitude;
+					double s0=Math::sin(latitude);
+					double c0=Math::cos(latitude);
+					double s1=Math::sin(longitude);
+					double c1=Math::cos(longitude);
+					double r=radius*a*scaleFactor;
+					double xy=r*c0;
+					DS::Index gIndex=cpuBaseIndex+gridIndex;
+					DS::Point& vertex=grid(gIndex);
+					vertex[0]=Scalar(xy*c1);
+					vertex[1]=Scalar(xy*s1);
+					vertex[2]=Scalar(r*s0);
+					
+					if(storeSphericals)
+						{
+						dataSet.getVertexValue(0,gIndex)=Scalar(Math::deg(colatitude));
+						dataSet.getVertexValue(1,gIndex)=Scalar(Math::deg(longitude));
+						dataSet.getVertexValue(2,gIndex)=Scalar(r);
+						}
+					}
+		}
+	};
+
+class DataValueFileReader:public CpuFileReader // Functor reading a CPU's data value file for one time step
+	{
+	/* Elements: */
+	private:
+	const std::string& dataDir; // Directory containing the run's data files
+	const std::string& dataFileName; // Base name of the run's data files
+	const std::string& variableName; // Name of the variable stored in the data value files
+	int timeStepIndex; // Index of the time step to read
+	bool isVeloFile; // Flag whether the files are the special two-variable velo files
+	bool isVector; // Flag whether the variable is a vector variable
+	bool logScalar; // Flag whether to store the logarithm of scalar values
+	int sliceIndex; // Index of the first slice receiving the variable's values
+	
+	/* Constructors and destructors: */
+	public:
+	DataValueFileReader(DS& sDataSet,const DS::Index& sNumCpus,const DS::Index& sCpuNumVertices,const std::string& sDataDir,const std::string& sDataFileName,const std::string& sVariableName,int sTimeStepIndex,bool sIsVeloFile,bool sIsVector,bool sLogScalar,int sSliceIndex)
+		:CpuFileReader(sDataSet,sNumCpus,sCpuNumVertices),
+		 dataDir(sDataDir),dataFileName(sDataFileName),variableName(sVariableName),
+		 timeStepIndex(sTimeStepIndex),
+		 isVeloFile(sIsVeloFile),isVector(sIsVector),logScalar(sLogScalar),
+		 sliceIndex(sSliceIndex)
+		{
+		}
+	
+	/* Methods: */
+	void operator()(unsigned int fileIndex) const // Reads the given CPU's data value file
+		{
+		/* Find the CPU's position in the grid: */
+		DS::Index cpuIndex,cpuBaseIndex;
+		int cpuLinearIndex=getCpu(fileIndex,cpuIndex,cpuBaseIndex);
+		const DS::GridArray& grid=dataSet.getGrid();
+		
+		/* Open the CPU's data value file: */
+		char dataValueFileName[1024];
+		snprintf(dataValueFileName,sizeof(dataValueFileName),"%s/%s.%s.%d.%d",dataDir.c_str(),dataFileName.c_str(),variableName.c_str(),cpuLinearIndex,timeStepIndex);
+		Misc::File dataValueFile(dataValueFileName,"rt");
+		
+		char line[256];
+		if(isVeloFile)
+			{
+			/* Read and check the two header lines in the velo file: */
+			dataValueFile.gets(line,sizeof(line));
+			int dataValueFileTimeStepIndex,dataValueFileNumVertices;
+			double dummy1;
+			if(sscanf(line,"%d %d %lf",&dataValueFileTimeStepIndex,&dataValueFileNumVertices,&dummy1)!=3)
+				Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName);
+			if(dataValueFileNumVertices!=totalCpuNumVertices)
+				Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName);
+			dataValueFile.gets(line,sizeof(line));
+			int dummy2;
+			if(sscanf(line,"%d %d",&dummy2,&dataValueFileNumVertices)!=2)
+				Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName);
+			if(dataValueFileNumVertices!=totalCpuNumVertices)
+				Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName);
+			}
+		else
+			{
+			/* Read and check the header line: */
+			dataValueFile.gets(line,sizeof(line));
+			int dummy,dataValueFileNumVertices;
+			if(sscanf(line,"%d %d",&dummy,&dataValueFileNumVertices)!=2)
+				Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName);
+			if(dataValueFileNumVertices!=totalCpuNumVertices)
+				Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName);
+			}
+		
+		/* Read the grid vertices: */
+		DS::Index gridIndex;
+		for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
+			for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
+				for(gridIndex[2]=0;gridIndex[2]<cpuNumVertices[2];++gridIndex[2])
+					{
+					/* Read the next line: */
+					dataValueFile.gets(line,sizeof(line));
+					
+					DS::Index index=cpuBaseIndex+gridIndex;
+					if(isVeloFile||isVector)
+						{
+						/* Read the vector components: */
+						double colatitude,longitude,radius,temp;
+						if(isVeloFile)
+							{
+							if(sscanf(line,"%lf %lf %lf %lf",&colatitude,&longitude,&radius,&temp)!=4)
+								Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in data value file %s",dataValueFileName);
+							}
+						else
+							{
+							if(sscanf(line,"%lf %lf %lf",&colatitude,&longitude,&radius)!=3)
+								Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in data value file %s",dataValueFileName);
+							}
+						if(!isOwner(cpuIndex,gridIndex))
+							continue;
+						
+						/* Convert the vector from spherical to Cartesian coordinates: */
+						const DS::Point& p=grid(index);
+						double xy=Math::sqr(double(p[0]))+Math::sqr(double(p[1]));
+						double r=xy+Math::sqr(double(p[2]));
+						xy=Math::sqrt(xy);
+						r=Math::sqrt(r);
+						double s0=double(p[2])/r;
+						double c0=xy/r;
+						double s1=double(p[1])/xy;
+						double c1=double(p[0])/xy;
+						DataValue::VVector vector;
+						vector[0]=VScalar(c1*(c0*radius+s0*colatitude)-s1*longitude);
+						vector[1]=VScalar(s1*(c0*radius+s0*colatitude)+c1*longitude);
+						vector[2]=VScalar(s0*radius-c0*colatitude);
+						dataSet.getVertexValue(sliceIndex+0,index)=VScalar(colatitude);
+						dataSet.getVertexValue(sliceIndex+1,index)=VScalar(longitude);
+						dataSet.getVertexValue(sliceIndex+2,index)=VScalar(radius);
+						for(int i=0;i<3;++i)
+							dataSet.getVertexValue(sliceIndex+3+i,index)=vector[i];
+						dataSet.getVertexValue(sliceIndex+6,index)=VScalar(Geometry::mag(vector));
+						if(isVeloFile)
+							dataSet.getVertexValue(sliceIndex+7,index)=logScalar?VScalar(Math::log10(temp)):VScalar(temp);
+						}
+					else
+						{
+						/* Read the scalar value: */
+						double value;
+						if(sscanf(line,"%lf",&value)!=1)
+							Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in data value file %s",dataValueFileName);
+						if(!isOwner(cpuIndex,gridIndex))
+							continue;
+						
+						/* Store the data value: */
+						dataSet.getVertexValue(sliceIndex,index)=logScalar?VScalar(Math::log10(value)):VScalar(value);
+						}
+					}
+		}
+	};
+
+}
+
 /*****************************************
 Methods of class CitcomSRegionalASCIIFile:
 *****************************************/
@@ -110,75 +372,15 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 	DS::Index cpuNumVertices;
 	for(int i=0;i<3;++i)
 		cpuNumVertices[i]=(numVertices[i]-1)/numCpus[i]+1;
-	int totalCpuNumVertices=cpuNumVertices.calcIncrement(-1);
 	
-	/* Prepare the spherical-to-Cartesian formula: */
-	const double a=6378.14e3; // Equatorial radius in m
-	// const double f=1.0/298.247; // Geoid flattening factor (not used, since there could be vector values)
-	const double scaleFactor=1.0e-3; // Scale factor for Cartesian coordinates
+	/* Compute the number of files per variable: */
+	unsigned int numFiles=(unsigned int)numCpus.calcIncrement(-1);
 	
 	/* Read the grid coordinate files for all CPUs: */
 	std::cout<<"Reading grid vertex positions...   0%"<<std::flush;
-	int cpuCounter=0;
-	DS::GridArray& grid=dataSet.getGrid();
-	for(DS::Index cpuIndex(0);cpuIndex[0]<numCpus[0];cpuIndex.preInc(numCpus),++cpuCounter)
-		{
-		/* Open the CPU's coordinate file: */
-		char coordFileName[1024];
-		int cpuLinearIndex=(cpuIndex[1]*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
-		snprintf(coordFileName,sizeof(coordFileName),"%s/%s.coord.%d",dataDir.c_str(),dataFileName.c_str(),cpuLinearIndex);
-		Misc::File coordFile(coordFileName,"rt");
-		
-		/* Read and check the header line: */
-		char line[256];
-		coordFile.gets(line,sizeof(line));
-		int dummy,coordFileNumVertices;
-		if(sscanf(line,"%d %d",&dummy,&coordFileNumVertices)!=2)
-			Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in coordinate file %s",coordFileName);
-		if(coordFileNumVertices!=totalCpuNumVertices)
-			Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in coordinate file %s",coordFileName);
-		
-		/* Compute the CPU's base index in the surface's grid: */
-		DS::Index cpuBaseIndex;
-		for(int i=0;i<3;++i)
-			cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
-		
-		/* Read the grid vertices: */
-		DS::Index gridIndex;
-		for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
-			for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
-				for(gridIndex[2]=0;gridIndex[2]<cpuNumVertices[2];++gridIndex[2])
-					{
-					/* Read the next line: */
-					coordFile.gets(line,sizeof(line));
-					
-					/* Parse the grid vertex: */
-					double colatitude,longitude,radius;
-					if(sscanf(line,"%lf %lf %lf",&colatitude,&longitude,&radius)!=3)
-						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in coordinate file %s",coordFileName);
-					double latitude=Math::rad(90.0)-colatitude;
-					double s0=Math::sin(latitude);
-					double c0=Math::cos(latitude);
-					double s1=Math::sin(longitude);
-					double c1=Math::cos(longitude);
-					double r=radius*a*scaleFactor;
-					double xy=r*c0;
-					DS::Index gIndex=cpuBaseIndex+gridIndex;
-					DS::Point& vertex=grid(gIndex);
-					vertex[0]=Scalar(xy*c1);
-					vertex[1]=Scalar(xy*s1);
-					vertex[2]=Scalar(r*s0);
-					
-					if(storeSphericals)
-						{
-						dataSet.getVertexValue(0,gIndex)=Scalar(Math::deg(colatitude));
-						dataSet.getVertexValue(1,gIndex)=Scalar(Math::deg(longitude));
-						dataSet.getVertexValue(2,gIndex)=Scalar(r);
-						}
-					}
-		
-		std::cout<<"\b\b\b\b"<<std::setw(3)<<((cpuCounter+1)*100)/numCpus.calcIncrement(-1)<<"%"<<std::flush;
-		}
+	CoordFileReader coordFileReader(dataSet,numCpus,cpuNumVertices,dataDir,dataFileName,storeSphericals);
+	ParallelFileReader<CoordFileReader> coordReader(coordFileReader,numFiles);
+	coordReader.read(getNumLoadThreads());
 	std::cout<<"\b\b\b\bdone"<<std::endl;
 	
 	/* Finalize the grid structure: */
@@ -272,112 +474,9 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 				}
 			
 			/* Read data files for all CPUs: */
-			cpuCounter=0;
-			DS::GridArray& grid=dataSet.getGrid();
-			for(DS::Index cpuIndex(0);cpuIndex[0]<numCpus[0];cpuIndex.preInc(numCpus),++cpuCounter)
-				{
-				/* Open the CPU's data value file: */
-				char dataValueFileName[1024];
-				int cpuLinearIndex=(cpuIndex[1]*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
-				snprintf(dataValueFileName,sizeof(dataValueFileName),"%s/%s.%s.%d.%d",dataDir.c_str(),dataFileName.c_str(),argIt->c_str(),cpuLinearIndex,timeStepIndex);
-				Misc::File dataValueFile(dataValueFileName,"rt");
-				
-				char line[256];
-				if(isVeloFile)
-					{
-					/* Read and check the two header lines in the velo file: */
-					dataValueFile.gets(line,sizeof(line));
-					int dataValueFileTimeStepIndex,dataValueFileNumVertices;
-					double dummy1;
-					if(sscanf(line,"%d %d %lf",&dataValueFileTimeStepIndex,&dataValueFileNumVertices,&dummy1)!=3)
-						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName);
-					if(dataValueFileNumVertices!=totalCpuNumVertices)
-						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName);
-					dataValueFile.gets(line,sizeof(line));
-					int dummy2;
-					if(sscanf(line,"%d %d",&dummy2,&dataValueFileNumVertices)!=2)
-						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName);
-					if(dataValueFileNumVertices!=totalCpuNumVertices)
-						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName);
-					}
-				else
-					{
-					/* Read and check the header line: */
-					dataValueFile.gets(line,sizeof(line));
-					int dummy,dataValueFileNumVertices;
-					if(sscanf(line,"%d %d",&dummy,&dataValueFileNumVertices)!=2)
-						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName);
-					if(dataValueFileNumVertices!=totalCpuNumVertices)
-						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName);
-					}
-				
-				/* Compute the CPU's base index in the surface's grid: */
-				DS::Index cpuBaseIndex;
-				for(int i=0;i<3;++i)
-					cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
-				
-				/* Read the grid vertices: */
-				DS::Index gridIndex;
-				for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
-					for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
-						for(gridIndex[2]=0;gridIndex[2]<cpuNumVertices[2];++gridIndex[2])
-							{
-							/* Read the next line: */
-							dataValueFile.gets(line,sizeof(line));
-							
-							DS::Index index=cpuBaseIndex+gridIndex;
-							if(isVeloFile||nextVector)
-								{
-								/* Read the vector components: */
-								double colatitude,longitude,radius,temp;
-								if(isVeloFile)
-									{
-									if(sscanf(line,"%lf %lf %lf %lf",&colatitude,&longitude,&radius,&temp)!=4)
-										Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in data value file %s",dataValueFileName);
-									}
-								else
-									{
-									if(sscanf(line,"%lf %lf %lf",&colatitude,&longitude,&radius)!=3)
-										Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in data value file %s",dataValueFileName);
-									}
-								
-								/* Convert the vector from spherical to Cartesian coordinates: */
-								const DS::Point& p=grid(index);
-								double xy=Math::sqr(double(p[0]))+Math::sqr(double(p[1]));
-								double r=xy+Math::sqr(double(p[2]));
-								xy=Math::sqrt(xy);
-								r=Math::sqrt(r);
-								double s0=double(p[2])/r;
-								double c0=xy/r;
-								double s1=double(p[1])/xy;
-								double c1=double(p[0])/xy;
-								DataValue::VVector vector;
-								vector[0]=VScalar(c1*(c0*radius+s0*colatitude)-s1*longitude);
-								vector[1]=VScalar(s1*(c0*radius+s0*colatitude)+c1*longitude);
-								vector[2]=VScalar(s0*radius-c0*colatitude);
-								dataSet.getVertexValue(sliceIndex+0,index)=VScalar(colatitude);
-								dataSet.getVertexValue(sliceIndex+1,index)=VScalar(longitude);
-								dataSet.getVertexValue(sliceIndex+2,index)=VScalar(radius);
-								for(int i=0;i<3;++i)
-									dataSet.getVertexValue(sliceIndex+3+i,index)=vector[i];
-								dataSet.getVertexValue(sliceIndex+6,index)=VScalar(Geometry::mag(vector));
-								if(isVeloFile)
-									dataSet.getVertexValue(sliceIndex+7,index)=logNextScalar?VScalar(Math::log10(temp)):VScalar(temp);
-								}
-							else
-								{
-								/* Read the scalar value: */
-								double value;
-								if(sscanf(line,"%lf",&value)!=1)
-									Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in data value file %s",dataValueFileName);
-								
-								/* Store the data value: */
-								dataSet.getVertexValue(sliceIndex,index)=logNextScalar?VScalar(Math::log10(value)):VScalar(value);
-								}
-							}
-				
-				std::cout<<"\b\b\b\b"<<std::setw(3)<<((cpuCounter+1)*100)/numCpus.calcIncrement(-1)<<"%"<<std::flush;
-				}
+			DataValueFileReader dataValueFileReader(dataSet,numCpus,cpuNumVertices,dataDir,dataFileName,*argIt,timeStepIndex,isVeloFile,nextVector,logNextScalar,sliceIndex);
+			ParallelFileReader<DataValueFileReader> dataValueReader(dataValueFileReader,numFiles);
+			dataValueReader.read(getNumLoadThreads());
 			std::cout<<"\b\b\b\bdone"<<std::endl;
 			
 			if(nextVector)
@@ -20,6 +20,7 @@ with the 3D Data Visualizer; if not, write to the Free Software
 Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 ***********************************************************************/
 
+#include <vector>
 #include <Misc/LargeFile.h>
 #include <Plugins/FactoryManager.h>
 
@@ -55,13 +56,20 @@ Visualization::Abstract::DataSet* FloatGridFile::load(const std::vector<std::str
 	DataSet* result=new DataSet;
 	result->getDs().setData(numVertices);
 	
-	/* Read the vertex positions from file: */
+	/* Read the vertex positions from file in blocks: */
 	DS::Array& vertices=result->getDs().getVertices();
-	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+	size_t numGridVertices=size_t(vertices.getNumElements());
+	const size_t blockSize=65536;
+	std::vector<DS::Scalar> positionBlock(blockSize*3);
+	DS::Array::iterator vIt=vertices.begin();
+	for(size_t blockStart=0;blockStart<numGridVertices;blockStart+=blockSize)
 		{
-		DS::Point p;
-		gridFile.read<DS::Scalar>(p.getComponents(),3);
-		vertices(index).pos=p;
+		size_t blockEnd=blockStart+blockSize<numGridVertices?blockStart+blockSize:numGridVertices;
+		gridFile.read<DS::Scalar>(&positionBlock[0],(blockEnd-blockStart)*3);
+		const DS::Scalar* bPtr=&positionBlock[0];
+		for(size_t i=blockStart;i<blockEnd;++i,++vIt,bPtr+=3)
+			for(int j=0;j<3;++j)
+				vIt->pos[j]=bPtr[j];
 		}
 	
 	/* Construct data file name: */
@@ -77,9 +85,17 @@ Visualization::Abstract::DataSet* FloatGridFile::load(const std::vector<std::str
 	if(numVertices[0]!=numDataVertices[0]||numVertices[1]!=numDataVertices[1]||numVertices[2]!=numDataVertices[2])
 		Misc::throwStdErr("FloatGridFile::load: Size of data file %s does not match grid file %s",dataFilename,gridFilename);
 	
-	/* Read the vertex values from file: */
-	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
-		vertices(index).value=dataFile.read<float>();
+	/* Read the vertex values from file in blocks: */
+	std::vector<float> valueBlock(blockSize);
+	vIt=vertices.begin();
+	for(size_t blockStart=0;blockStart<numGridVertices;blockStart+=blockSize)
+		{
+		size_t blockEnd=blockStart+blockSize<numGridVertices?blockStart+blockSize:numGridVertices;
+		dataFile.read<float>(&valueBlock[0],blockEnd-blockStart);
+		const float* bPtr=&valueBlock[0];
+		for(size_t i=blockStart;i<blockEnd;++i,++vIt,++bPtr)
+			vIt->value=*bPtr;
+		}
 	
 	/* Finalize the grid structure: */
 	result->getDs().finalizeGrid();
@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/File.h>
 #include <Plugins/FactoryManager.h>
 
+#include <Concrete/MappedFile.h>
 #include <Concrete/FloatVolFile.h>
 
 namespace Visualization {
@@ -59,10 +60,21 @@ Visualization::Abstract::DataSet* FloatVolFile::load(const std::vector<std::stri
 		cellSize[i]=float(domainSize[i])/float(numVertices[i]-1);
 		}
 	DataSet* result=new DataSet;
-	result->getDs().setData(numVertices,cellSize);
 	
-	/* Read the vertex values from file: */
-	file.read(result->getDs().getVertices().getArray(),result->getDs().getVertices().getNumElements());
+	/* Map the vertex values directly from the file if they are stored in the host's byte order: */
+	const size_t headerSize=4*sizeof(int)+3*sizeof(float);
+	size_t numValues=size_t(numVertices.calcIncrement(-1));
+	MappedFile* mappedFile=0;
+	if(MappedFile::isNativeEndianness(Misc::File::BigEndian))
+		mappedFile=MappedFile::mapArray<DS::Value>(args[0].c_str(),headerSize,numValues);
+	if(mappedFile!=0)
+		result->getDs().adoptData(numVertices,cellSize,mappedFile->getArray<DS::Value>(headerSize),mappedFile);
+	else
+		{
+		/* Read the vertex values from file, swapping their byte order if necessary: */
+		result->getDs().setData(numVertices,cellSize);
+		file.read(result->getDs().getVertexArray(),numValues);
+		}
 	
 	return result;
 	}
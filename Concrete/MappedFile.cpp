@@ -0,0 +1,87 @@
+/***********************************************************************
+MappedFile - Class to map raw binary data files privately into memory,
+such that data sets can adopt the arrays stored in them as vertex
+storage without reading or copying.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/MappedFile.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <Misc/ThrowStdErr.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/***************************
+Methods of class MappedFile:
+***************************/
+
+MappedFile::MappedFile(const char* fileName)
+	:mapping(0),mappingSize(0)
+	{
+	/* Open the file: */
+	int fd=open(fileName,O_RDONLY);
+	if(fd<0)
+		Misc::throwStdErr("MappedFile::MappedFile: Unable to open file %s",fileName);
+	struct stat fileStat;
+	if(fstat(fd,&fileStat)!=0||fileStat.st_size==0)
+		{
+		close(fd);
+		Misc::throwStdErr("MappedFile::MappedFile: Unable to map file %s",fileName);
+		}
+	mappingSize=size_t(fileStat.st_size);
+	
+	/* Map the file copy-on-write, so that data sets can modify adopted arrays: */
+	void* mapResult=mmap(0,mappingSize,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+	
+	/* The mapping stays valid after the file is closed: */
+	close(fd);
+	if(mapResult==MAP_FAILED)
+		Misc::throwStdErr("MappedFile::MappedFile: Unable to map file %s",fileName);
+	mapping=static_cast<char*>(mapResult);
+	}
+
+MappedFile::~MappedFile(void)
+	{
+	munmap(mapping,mappingSize);
+	}
+
+bool MappedFile::isNativeEndianness(Misc::File::Endianness endianness)
+	{
+	/* Determine the host's endianness: */
+	unsigned int test=1U;
+	bool hostLittleEndian=*reinterpret_cast<unsigned char*>(&test)==1U;
+	
+	if(endianness==Misc::File::LittleEndian)
+		return hostLittleEndian;
+	else if(endianness==Misc::File::BigEndian)
+		return !hostLittleEndian;
+	else
+		return true;
+	}
+
+}
+
+}
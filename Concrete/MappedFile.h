@@ -0,0 +1,85 @@
+/***********************************************************************
+MappedFile - Class to map raw binary data files privately into memory,
+such that data sets can adopt the arrays stored in them as vertex
+storage without reading or copying.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_MAPPEDFILE_INCLUDED
+#define VISUALIZATION_CONCRETE_MAPPEDFILE_INCLUDED
+
+#include <stddef.h>
+#include <stdexcept>
+#include <Misc/File.h>
+
+#include <Templatized/ExternalStorage.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+class MappedFile:public Visualization::Templatized::ExternalStorage
+	{
+	/* Elements: */
+	private:
+	char* mapping; // Memory-mapped contents of the file
+	size_t mappingSize; // Size of the file
+	
+	/* Constructors and destructors: */
+	public:
+	MappedFile(const char* fileName); // Maps the given file into memory; writes to the mapping are private and do not change the file; throws exception if the file can not be mapped
+	virtual ~MappedFile(void); // Unmaps the file
+	
+	/* Methods: */
+	static bool isNativeEndianness(Misc::File::Endianness endianness); // Returns true if multi-byte values stored in the given endianness can be used without swapping
+	template <class DataParam>
+	static MappedFile* mapArray(const char* fileName,size_t offset,size_t numValues) // Maps the given file if it contains the given number of values at the given byte offset; returns null if the file is too short or can not be mapped
+		{
+		MappedFile* result=0;
+		try
+			{
+			result=new MappedFile(fileName);
+			}
+		catch(const std::runtime_error&)
+			{
+			return 0;
+			}
+		if(result->mappingSize<offset||(result->mappingSize-offset)/sizeof(DataParam)<numValues)
+			{
+			delete result;
+			return 0;
+			}
+		return result;
+		}
+	size_t getSize(void) const // Returns the size of the mapped file
+		{
+		return mappingSize;
+		}
+	template <class DataParam>
+	DataParam* getArray(size_t offset) // Returns a pointer to an array of values at the given byte offset inside the mapped file
+		{
+		return reinterpret_cast<DataParam*>(mapping+offset);
+		}
+	};
+
+}
+
+}
+
+#endif
@@ -1,4 +1,4 @@
-***********************************************************************
+/***********************************************************************
 Noise - Class for Perlin noise arrays with spline evaluation.
 Copyright (c) 2000-2007 Oliver Kreylos
 
@@ -0,0 +1,138 @@
+/***********************************************************************
+ParallelFileReader - Class to read a set of independent input files,
+such as the per-CPU files written by parallel simulation codes, on
+multiple threads.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_CONCRETE_PARALLELFILEREADER_IMPLEMENTATION
+
+#include <stdio.h>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <Threads/Thread.h>
+
+#include <Concrete/ParallelFileReader.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/***********************************
+Methods of class ParallelFileReader:
+***********************************/
+
+template <class FileReaderParam>
+inline
+void*
+ParallelFileReader<FileReaderParam>::readerThreadMethod(
+	void)
+	{
+	while(true)
+		{
+		/* Grab the next unread file: */
+		unsigned int fileIndex;
+		{
+		Threads::Mutex::Lock readerLock(readerMutex);
+		if(nextFileIndex==numFiles)
+			break;
+		fileIndex=nextFileIndex;
+		++nextFileIndex;
+		}
+		
+		/* Read the file and remember its error message if it fails: */
+		std::string errorMessage;
+		try
+			{
+			fileReader(fileIndex);
+			}
+		catch(const std::runtime_error& err)
+			{
+			errorMessage=err.what();
+			if(errorMessage.empty())
+				errorMessage="Unknown error";
+			}
+		catch(...)
+			{
+			errorMessage="Unknown error";
+			}
+		
+		/* Report progress: */
+		{
+		Threads::Mutex::Lock readerLock(readerMutex);
+		errorMessages[fileIndex]=errorMessage;
+		++numReadFiles;
+		std::cout<<"\b\b\b\b"<<std::setw(3)<<(numReadFiles*100)/numFiles<<"%"<<std::flush;
+		}
+		}
+	
+	return 0;
+	}
+
+template <class FileReaderParam>
+inline
+ParallelFileReader<FileReaderParam>::ParallelFileReader(
+	typename ParallelFileReader<FileReaderParam>::FileReader& sFileReader,
+	unsigned int sNumFiles)
+	:fileReader(sFileReader),
+	 numFiles(sNumFiles),
+	 nextFileIndex(0),numReadFiles(0),
+	 errorMessages(sNumFiles)
+	{
+	}
+
+template <class FileReaderParam>
+inline
+void
+ParallelFileReader<FileReaderParam>::read(
+	unsigned int numThreads)
+	{
+	/* Read all files on the current thread and numThreads-1 worker threads: */
+	if(numThreads>numFiles)
+		numThreads=numFiles;
+	Threads::Thread* readerThreads=numThreads>1?new Threads::Thread[numThreads-1]:0;
+	for(unsigned int i=1;i<numThreads;++i)
+		readerThreads[i-1].start(this,&ParallelFileReader::readerThreadMethod);
+	readerThreadMethod();
+	for(unsigned int i=1;i<numThreads;++i)
+		readerThreads[i-1].join();
+	delete[] readerThreads;
+	
+	/* Report all failed files in file order, independent of the number of threads: */
+	unsigned int numFailedFiles=0;
+	std::string message;
+	for(unsigned int fileIndex=0;fileIndex<numFiles;++fileIndex)
+		if(!errorMessages[fileIndex].empty())
+			{
+			++numFailedFiles;
+			message.push_back('\n');
+			message.append(errorMessages[fileIndex]);
+			}
+	if(numFailedFiles>0)
+		{
+		char header[128];
+		snprintf(header,sizeof(header),"ParallelFileReader::read: Unable to read %u of %u files:",numFailedFiles,numFiles);
+		throw std::runtime_error(header+message);
+		}
+	}
+
+}
+
+}
@@ -0,0 +1,70 @@
+/***********************************************************************
+ParallelFileReader - Class to read a set of independent input files,
+such as the per-CPU files written by parallel simulation codes, on
+multiple threads.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_PARALLELFILEREADER_INCLUDED
+#define VISUALIZATION_CONCRETE_PARALLELFILEREADER_INCLUDED
+
+#include <string>
+#include <vector>
+#include <Threads/Mutex.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+template <class FileReaderParam>
+class ParallelFileReader
+	{
+	/* Embedded classes: */
+	public:
+	typedef FileReaderParam FileReader; // Type of functor reading a single file; called as fileReader(fileIndex) and throws exception on error
+	
+	/* Elements: */
+	private:
+	FileReader& fileReader; // Functor reading a single file
+	unsigned int numFiles; // Number of files to read
+	Threads::Mutex readerMutex; // Mutex protecting the reader state
+	unsigned int nextFileIndex; // Index of the next file to be read by any thread
+	unsigned int numReadFiles; // Number of files that have been read, successfully or not
+	std::vector<std::string> errorMessages; // Error message for each file; empty for files that were read successfully
+	
+	/* Private methods: */
+	void* readerThreadMethod(void); // Reads files until all files have been read
+	
+	/* Constructors and destructors: */
+	public:
+	ParallelFileReader(FileReader& sFileReader,unsigned int sNumFiles); // Creates a reader for the given number of files
+	
+	/* Methods: */
+	void read(unsigned int numThreads); // Reads all files on the given number of threads and prints percentage progress to std::cout; throws exception listing all files that could not be read
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_CONCRETE_PARALLELFILEREADER_IMPLEMENTATION
+#include <Concrete/ParallelFileReader.cpp>
+#endif
+
+#endif
@@ -10,14 +10,13 @@ The ExampleModule is free software under the GNU General Public License.
 ***********************************************************************/
 
 #include <math.h>
-#include <stdio.h>
-#include <iostream>
-#include <Plugins/FactoryManager.h>
 #include <string>
+#include <Misc/ThrowStdErr.h>
+#include <Plugins/FactoryManager.h>
+
+#include <Concrete/ASCIIFileTokenizer.h>
+
 #include <Concrete/RealMCNP.h>
-#include <fstream>
-#include <string>
-#include <sstream>
 
 #define PI 3.1415926535897932384626
 namespace Visualization {
@@ -49,75 +48,30 @@ class and has to be written.
 	/* Create the result data set: */
 	DataSet* result=new DataSet;
 
-        /*Declare data to hold number of vertexes and help read file*/
-        int x_dim=0;
-        int y_dim=0;
-        int z_dim=0;
-        std::string line;
-        std::ifstream myfile;
-        size_t found;
-        
-        /*Read the Mesh Tally file provided*/
-        myfile.open(args[0].c_str());
-        for(int i=0; i<10000; i++)
-        {
-          //determining the number of x points
-          found= line.find("X direction:");
-          if(found!=std::string::npos)
-          {
-            line= line.substr(found+12, 100000);
-            double xs;
-            const char *p=line.c_str();
-            int n;
-            while(sscanf(p, "%lf%n ", &xs, &n)==1)
-            {
-              p+=n;//progress further through the string
-              x_dim++;
-            }
-          }
-          //determining the number of y points
-            found= line.find("Y direction:");
-            if(found!=std::string::npos)
-            {
-              line= line.substr(found+12, 100000);
-              double ys;
-              const char *p=line.c_str();
-              int n;
-              while(sscanf(p, "%lf%n ", &ys, &n)==1)
-              {
-                 p+=n;//progress further through the string
-                 y_dim++;
-              }
-            }
-            //determining the number of z points
-            found= line.find("Z direction:");
-            if(found!=std::string::npos)
-            {
-              line= line.substr(found+12, 100000);
-              double zs;
-              const char *p=line.c_str();
-              int n;
-              while(sscanf(p, "%lf%n ", &zs, &n)==1)
-              {
-                p+=n;//progress further through the string
-                z_dim++;
-              }
-            }
-            //searching for the begining of the data, once found, reading will temporarily stop, indicated by keyword "Result"
-            getline(myfile, line);
-            found= line.find("Result");
-            if(found!= std::string::npos)//Once result is found, stop reading
-            {
-              break;
-            }
-
-        }
-
+	/* Open the Mesh Tally file provided: */
+	ASCIIFileTokenizer file(args[0].c_str());
+	
+	/* Count the mesh boundaries listed in the X, Y, and Z direction lines of the header: */
+	static const char* const directionTags[3]={"X direction:","Y direction:","Z direction:"};
+	int dims[3];
+	for(int i=0;i<3;++i)
+		{
+		if(!file.findLine(directionTags[i]))
+			Misc::throwStdErr("RealMCNP::load: Missing \"%s\" line in file %s",directionTags[i],args[0].c_str());
+		for(dims[i]=0;!file.eol();++dims[i])
+			file.readDouble();
+		}
+	
+	/* Skip the column header line preceding the data, indicated by keyword "Result": */
+	if(!file.findLine("Result"))
+		Misc::throwStdErr("RealMCNP::load: Missing data header line in file %s",args[0].c_str());
+	file.skipLine();
+	
         DS::Index numVertices; // DS::Index is a helper type containing three integers NI, NJ, NK
         /* Use the numbers of points found above to set the numVerticies. Must subtract one because we counted a range:*/
-        numVertices[0]=x_dim-1;
-        numVertices[1]=y_dim-1;
-        numVertices[2]=z_dim-1;
+        numVertices[0]=dims[0]-1;
+        numVertices[1]=dims[1]-1;
+        numVertices[2]=dims[2]-1;
         
 	/* Define the result data set's grid layout: */
 	DS& dataSet=result->getDs(); // Get the internal data representation from the result data set
@@ -139,8 +93,10 @@ class and has to be written.
 				{
 				/* Read the vertex position, flux, and relative error values: */
                                   double pos[3],flux, relative_err;
-                                  getline(myfile, line);
-                                  sscanf(line.c_str(),"%lf %lf %lf %lf %lf",&pos[0],&pos[1],&pos[2],&flux, &relative_err);
+				  file.readValues(pos,3);
+				  flux=file.readDouble();
+				  relative_err=file.readDouble();
+				  file.skipLine(); // Ignore any additional columns
 				  
 				  /*Rotating and resizing the data to fit correctly in the core*/
 				  double temp_x= pos[0];
@@ -154,9 +110,6 @@ class and has to be written.
                                 dataSet.getVertexValue(1,index)=DS::ValueScalar(relative_err); //Store the vertex's relative error
                                 }
 	
-	/* Close the input file: */
-        myfile.close();
-
         /* Finalize the data set's grid structure (required): */
 	dataSet.finalizeGrid();
 	
@@ -164,6 +117,11 @@ class and has to be written.
 	return result;
 	}
 
+bool RealMCNP::isDataSetCacheable(void) const
+	{
+	return true;
+	}
+
 }
 
 }
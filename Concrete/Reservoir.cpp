@@ -8,9 +8,10 @@ This module was modeled after the ExampleModule from 3D Visualizer.
 The ExampleModule is free software under the GNU General Public License.
 ***********************************************************************/
 #include <math.h>
-#include <stdio.h>
 #include <Plugins/FactoryManager.h>
 
+#include <Concrete/ASCIIFileTokenizer.h>
+
 #include <Concrete/Reservoir.h>
 #define PI 3.1415926535897932384626
 namespace Visualization {
@@ -43,12 +44,12 @@ class and has to be written.
 	DataSet* result=new DataSet;
 	
 	/* Open the input file: */
-	FILE* file=fopen(args[0].c_str(),"rt"); // args[0] is the first module command line parameter
+	ASCIIFileTokenizer file(args[0].c_str()); // args[0] is the first module command line parameter
 	
-	int status;
 	/* Read the input file's header: */
 	DS::Index numVertices; // DS::Index is a helper type containing three integers NI, NJ, NK
-	status = fscanf(file,"%d %d %d",&numVertices[0],&numVertices[1],&numVertices[2]);
+	for(int i=0;i<3;++i)
+		numVertices[i]=int(file.readInteger());
 	
 	/* Define the result data set's grid layout: */
 	DS& dataSet=result->getDs(); // Get the internal data representation from the result data set
@@ -98,7 +99,19 @@ class and has to be written.
 				{
 				/* Read the vertex position and flux and relative error values: */
 				  double pos[3],depth,dz,dznet,permeability,porosity,pressure,gas,oil,water,vx,vy,vz;
-				  status = fscanf(file,"%lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf",&pos[0],&pos[1],&pos[2],&depth, &dz, &dznet, &permeability, &porosity, &pressure, &gas, &oil, &water, &vx, &vy, &vz);
+				  file.readValues(pos,3);
+				  depth=file.readDouble();
+				  dz=file.readDouble();
+				  dznet=file.readDouble();
+				  permeability=file.readDouble();
+				  porosity=file.readDouble();
+				  pressure=file.readDouble();
+				  gas=file.readDouble();
+				  oil=file.readDouble();
+				  water=file.readDouble();
+				  vx=file.readDouble();
+				  vy=file.readDouble();
+				  vz=file.readDouble();
 
 				/* Store the position and value in the data set: */
 				dataSet.getVertexPosition(index)=DS::Point(pos); // Store the vertex' position
@@ -120,9 +133,6 @@ class and has to be written.
 				dataSet.getVertexValue(11,index)=DS::ValueScalar(vz);
 				}
 	
-	/* Close the input file: */
-	fclose(file);
-	
 	/* Finalize the data set's grid structure (required): */
 	dataSet.finalizeGrid();
 	
@@ -130,6 +140,11 @@ class and has to be written.
 	return result;
 	}
 
+bool Reservoir::isDataSetCacheable(void) const
+	{
+	return true;
+	}
+
 }
 
 }
@@ -15,9 +15,10 @@ This module was modeled after the ExampleModule from 3D Visualizer.
 The ExampleModule is free software under the GNU General Public License.
 ***********************************************************************/
 #include <math.h>
-#include <stdio.h>
 #include <Plugins/FactoryManager.h>
 
+#include <Concrete/ASCIIFileTokenizer.h>
+
 #include <Concrete/SimpleMCNP.h>
 #define PI 3.1415926535897932384626
 namespace Visualization {
@@ -50,12 +51,12 @@ class and has to be written.
 	DataSet* result=new DataSet;
 	
 	/* Open the input file: */
-	FILE* file=fopen(args[0].c_str(),"rt"); // args[0] is the first module command line parameter
+	ASCIIFileTokenizer file(args[0].c_str()); // args[0] is the first module command line parameter
 	
-	int status;
 	/* Read the input file's header: */
 	DS::Index numVertices; // DS::Index is a helper type containing three integers NI, NJ, NK
-	status = fscanf(file,"%d %d %d",&numVertices[0],&numVertices[1],&numVertices[2]);
+	for(int i=0;i<3;++i)
+		numVertices[i]=int(file.readInteger());
 	
 	/* Define the result data set's grid layout: */
 	DS& dataSet=result->getDs(); // Get the internal data representation from the result data set
@@ -77,7 +78,9 @@ class and has to be written.
 				{
 				/* Read the vertex position and flux and relative error values: */
 				  double pos[3],flux, relative_err;
-				  status = fscanf(file,"%lf %lf %lf %lf %lf",&pos[0],&pos[1],&pos[2],&flux, &relative_err);
+				  file.readValues(pos,3);
+				  flux=file.readDouble();
+				  relative_err=file.readDouble();
 			        /*Rotating and resizing the data to fit correctly in the core*/
 				  double temp_x= pos[0];
 				  pos[0]= ((pos[0]*cos(PI/4)) - (pos[1]*sin(PI/4)))*0.01;
@@ -90,9 +93,6 @@ class and has to be written.
 				dataSet.getVertexValue(1,index)=DS::ValueScalar(relative_err); // Store the vertex' relative error
 				}
 	
-	/* Close the input file: */
-	fclose(file);
-	
 	/* Finalize the data set's grid structure (required): */
 	dataSet.finalizeGrid();
 	
@@ -100,6 +100,11 @@ class and has to be written.
 	return result;
 	}
 
+bool SimpleMCNP::isDataSetCacheable(void) const
+	{
+	return true;
+	}
+
 }
 
 }
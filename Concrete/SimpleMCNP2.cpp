@@ -21,9 +21,10 @@ with the 3D Data Visualizer; if not, write to the Free Software
 Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 ***********************************************************************/
 
-#include <stdio.h>
 #include <Plugins/FactoryManager.h>
 
+#include <Concrete/ASCIIFileTokenizer.h>
+
 #include <Concrete/SimpleMCNP2.h>
 
 namespace Visualization {
@@ -56,11 +57,12 @@ class and has to be written.
 	DataSet* result=new DataSet;
 	
 	/* Open the input file: */
-	FILE* file=fopen(args[0].c_str(),"rt"); // args[0] is the first module command line parameter
+	ASCIIFileTokenizer file(args[0].c_str()); // args[0] is the first module command line parameter
 	
 	/* Read the input file's header: */
 	DS::Index numVertices; // DS::Index is a helper type containing three integers NI, NJ, NK
-	fscanf(file,"%d %d %d",&numVertices[0],&numVertices[1],&numVertices[2]);
+	for(int i=0;i<3;++i)
+		numVertices[i]=int(file.readInteger());
 	
 	/* Define the result data set's grid layout: */
 	DS& dataSet=result->getDs(); // Get the internal data representation from the result data set
@@ -80,16 +82,14 @@ class and has to be written.
 				{
 				/* Read the vertex position and flux value: */
 				double pos[3],flux;
-				fscanf(file,"%lf %lf %lf %lf",&pos[0],&pos[1],&pos[2],&flux);
+				file.readValues(pos,3);
+				flux=file.readDouble();
 				
 				/* Store the position and value in the data set: */
 				dataSet.getVertexPosition(index)=DS::Point(pos); // Store the vertex' position
 				dataSet.getVertexValue(0,index)=DS::ValueScalar(flux); // Store the vertex' flux
 				}
 	
-	/* Close the input file: */
-	fclose(file);
-	
 	/* Finalize the data set's grid structure (required): */
 	dataSet.finalizeGrid();
 	
@@ -97,6 +97,11 @@ class and has to be written.
 	return result;
 	}
 
+bool SimpleMCNP2::isDataSetCacheable(void) const
+	{
+	return true;
+	}
+
 }
 
 }
@@ -74,6 +74,7 @@ class SimpleMCNP2:public BaseModule
 	module class and has to be written.
 	*********************************************************************/
 	virtual Visualization::Abstract::DataSet* load(const std::vector<std::string>& args, Comm::MulticastPipe* pipe) const; // Method to load a data set from a file
+	virtual bool isDataSetCacheable(void) const; // Returns true; data sets are fully defined by the files named by their arguments
 	};
 
 }
@@ -15,9 +15,10 @@ This module was modeled after the ExampleModule from 3D Visualizer.
 The ExampleModule is free software under the GNU General Public License.
 ***********************************************************************/
 #include <math.h>
-#include <stdio.h>
 #include <Plugins/FactoryManager.h>
 
+#include <Concrete/ASCIIFileTokenizer.h>
+
 #include <Concrete/SimpleMCNPFluxOnly.h>
 #define PI 3.1415926535897932384626
 namespace Visualization {
@@ -50,11 +51,12 @@ class and has to be written.
 	DataSet* result=new DataSet;
 	
 	/* Open the input file: */
-	FILE* file=fopen(args[0].c_str(),"rt"); // args[0] is the first module command line parameter
+	ASCIIFileTokenizer file(args[0].c_str()); // args[0] is the first module command line parameter
 	
 	/* Read the input file's header: */
 	DS::Index numVertices; // DS::Index is a helper type containing three integers NI, NJ, NK
-	fscanf(file,"%d %d %d",&numVertices[0],&numVertices[1],&numVertices[2]);
+	for(int i=0;i<3;++i)
+		numVertices[i]=int(file.readInteger());
 	
 	/* Define the result data set's grid layout: */
 	DS& dataSet=result->getDs(); // Get the internal data representation from the result data set
@@ -76,7 +78,8 @@ class and has to be written.
 				{
 				/* Read the vertex position, flux value: */
                                   double pos[3],flux;
-				  fscanf(file,"%lf %lf %lf %lf",&pos[0],&pos[1],&pos[2],&flux);
+				  file.readValues(pos,3);
+				  flux=file.readDouble();
 				
 				/*Rotating and resizing the data to fit correctly in the core*/
 				  double temp_x= pos[0];
@@ -89,9 +92,6 @@ class and has to be written.
 				dataSet.getVertexValue(0,index)=DS::ValueScalar(flux); // Store the vertex' flux 
                                 }
 	
-	/* Close the input file: */
-	fclose(file);
-	
 	/* Finalize the data set's grid structure (required): */
 	dataSet.finalizeGrid();
 	
@@ -99,6 +99,11 @@ class and has to be written.
 	return result;
 	}
 
+bool SimpleMCNPFluxOnly::isDataSetCacheable(void) const
+	{
+	return true;
+	}
+
 }
 
 }
@@ -28,10 +28,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <iomanip>
 #include <Misc/SelfDestructPointer.h>
 #include <Misc/ThrowStdErr.h>
-#include <Misc/File.h>
 #include <Plugins/FactoryManager.h>
 #include <Math/Math.h>
 
+#include <Concrete/ASCIIFileTokenizer.h>
+
 #include <Concrete/StructuredGridASCII.h>
 
 namespace Visualization {
@@ -66,7 +67,7 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 	
 	/* Open the grid definition file: */
 	std::cout<<"Reading grid file "<<*argIt<<"..."<<std::flush;
-	Misc::File gridFile(argIt->c_str(),"rt");
+	ASCIIFileTokenizer gridFile(argIt->c_str());
 	
 	/* Parse the grid file header: */
 	DS::Index numVertices(-1,-1,-1);
@@ -81,8 +82,8 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 			Misc::throwStdErr("StructuredGridASCII::load: early end-of-file in grid file %s",argIt->c_str());
 		
 		/* Read the next line from the file: */
-		gridFile.gets(line,sizeof(line));
-		++lineIndex;
+		lineIndex=gridFile.getLineNumber();
+		gridFile.readLine(line,sizeof(line));
 		
 		/* Skip comment lines: */
 		if(line[0]!='#')
@@ -156,55 +157,52 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 	DS::Index index(0);
 	while(index[2]<numVertices[2])
 		{
-		/* Read the next line: */
-		gridFile.gets(line,sizeof(line));
-		++lineIndex;
+		/* Skip comment lines: */
+		gridFile.skipCommentLines('#');
 		
-		if(line[0]!='#')
+		/* Parse the line: */
+		DS::Point& vertex=dataSet.getVertexPosition(index);
+		if(sphericalCoordinates)
 			{
-			/* Parse the line: */
-			DS::Point& vertex=dataSet.getVertexPosition(index);
-			if(sphericalCoordinates)
-				{
-				/* Read the vertex' position in spherical coordinates: */
-				double longitude,latitude,radius;
-				if(sscanf(line,"%lf %lf %lf",&longitude,&latitude,&radius)!=3)
-					Misc::throwStdErr("StructuredGridASCII::load: Invalid spherical vertex coordinate in line %u in grid file %s",lineIndex,argIt->c_str());
-				
-				/* Convert the vertex position to Cartesian coordinates: */
-				double s0=Math::sin(latitude);
-				double c0=Math::cos(latitude);
-				double r=radius*scaleFactor;
-				double xy=r*c0;
-				double s1=Math::sin(longitude);
-				double c1=Math::cos(longitude);
-				vertex[0]=Scalar(xy*c1);
-				vertex[1]=Scalar(xy*s1);
-				vertex[2]=Scalar(r*s0);
-				
-				if(storeSphericals)
-					{
-					/* Store the spherical coordinate components in the first three value slices: */
-					dataSet.getVertexValue(0,index)=Scalar(Math::deg(latitude));
-					dataSet.getVertexValue(1,index)=Scalar(Math::deg(longitude));
-					dataSet.getVertexValue(2,index)=Scalar(r);
-					}
-				}
-			else
+			/* Read the vertex' position in spherical coordinates: */
+			double longitude=gridFile.readDouble();
+			double latitude=gridFile.readDouble();
+			double radius=gridFile.readDouble();
+			
+			/* Convert the vertex position to Cartesian coordinates: */
+			double s0=Math::sin(latitude);
+			double c0=Math::cos(latitude);
+			double r=radius*scaleFactor;
+			double xy=r*c0;
+			double s1=Math::sin(longitude);
+			double c1=Math::cos(longitude);
+			vertex[0]=Scalar(xy*c1);
+			vertex[1]=Scalar(xy*s1);
+			vertex[2]=Scalar(r*s0);
+			
+			if(storeSphericals)
 				{
-				/* Read the vertex' position in Cartesian coordinates: */
-				if(sscanf(line,"%f %f %f",&vertex[0],&vertex[1],&vertex[2])!=3)
-					Misc::throwStdErr("StructuredGridASCII::load: Invalid Cartesian vertex coordinate in line %u in grid file %s",lineIndex,argIt->c_str());
+				/* Store the spherical coordinate components in the first three value slices: */
+				dataSet.getVertexValue(0,index)=Scalar(Math::deg(latitude));
+				dataSet.getVertexValue(1,index)=Scalar(Math::deg(longitude));
+				dataSet.getVertexValue(2,index)=Scalar(r);
 				}
-			
-			/* Go to the next vertex: */
-			int incDim;
-			for(incDim=0;incDim<2&&index[incDim]==numVertices[incDim]-1;++incDim)
-				index[incDim]=0;
-			++index[incDim];
-			if(incDim==2)
-				std::cout<<"\b\b\b\b"<<std::setw(3)<<(index[2]*100)/numVertices[2]<<"%"<<std::flush;
 			}
+		else
+			{
+			/* Read the vertex' position in Cartesian coordinates: */
+			for(int i=0;i<3;++i)
+				vertex[i]=Scalar(gridFile.readDouble());
+			}
+		gridFile.skipLine();
+		
+		/* Go to the next vertex: */
+		int incDim;
+		for(incDim=0;incDim<2&&index[incDim]==numVertices[incDim]-1;++incDim)
+			index[incDim]=0;
+		++index[incDim];
+		if(incDim==2)
+			std::cout<<"\b\b\b\b"<<std::setw(3)<<(index[2]*100)/numVertices[2]<<"%"<<std::flush;
 		}
 	std::cout<<"\b\b\b\bdone"<<std::endl;
 	
@@ -223,12 +221,11 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 			{
 			/* Open the slice file: */
 			std::cout<<"Reading slice file "<<*argIt<<"..."<<std::flush;
-			Misc::File sliceFile(argIt->c_str(),"rt");
+			ASCIIFileTokenizer sliceFile(argIt->c_str());
 			
 			/* Parse the slice file header: */
 			bool vectorValue=false;
 			int sliceIndex=dataSet.getNumSlices();
-			lineIndex=0;
 			parsedHeaderLines=0;
 			while(parsedHeaderLines<2)
 				{
@@ -237,8 +234,8 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 					Misc::throwStdErr("StructuredGridASCII::load: early end-of-file in slice file %s",argIt->c_str());
 				
 				/* Read the next line from the file: */
-				sliceFile.gets(line,sizeof(line));
-				++lineIndex;
+				lineIndex=sliceFile.getLineNumber();
+				sliceFile.readLine(line,sizeof(line));
 				
 				/* Skip comment lines: */
 				if(line[0]!='#')
@@ -347,74 +344,68 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 			DS::Index index(0);
 			while(index[2]<numVertices[2])
 				{
-				/* Read the next line: */
-				sliceFile.gets(line,sizeof(line));
-				++lineIndex;
-
-				if(line[0]!='#')
+				/* Skip comment lines: */
+				sliceFile.skipCommentLines('#');
+				
+				/* Parse the line: */
+				if(vectorValue)
 					{
-					/* Parse the line: */
-					if(vectorValue)
+					DataValue::VVector vector;
+					if(sphericalCoordinates)
 						{
-						DataValue::VVector vector;
-						if(sphericalCoordinates)
-							{
-							/* Read the vector attribute in spherical coordinates: */
-							double longitude,latitude,radius;
-							if(sscanf(line,"%lf %lf %lf",&longitude,&latitude,&radius)!=3)
-								Misc::throwStdErr("StructuredGridASCII::load: Invalid spherical vector attribute in line %u in slice file %s",lineIndex,argIt->c_str());
-							
-							/* Convert the vector to Cartesian coordinates: */
-							const DS::Point& p=dataSet.getVertexPosition(index);
-							double xy=Math::sqr(double(p[0]))+Math::sqr(double(p[1]));
-							double r=xy+Math::sqr(double(p[2]));
-							xy=Math::sqrt(xy);
-							r=Math::sqrt(r);
-							double s0=double(p[2])/r;
-							double c0=xy/r;
-							double s1=double(p[1])/xy;
-							double c1=double(p[0])/xy;
-							vector[0]=Scalar(c1*(c0*radius-s0*latitude)-s1*longitude);
-							vector[1]=Scalar(s1*(c0*radius-s0*latitude)+c1*longitude);
-							vector[2]=Scalar(c0*latitude+s0*radius);
-							}
-						else
-							{
-							/* Read the vector attribute in Cartesian coordinates: */
-							if(sscanf(line,"%f %f %f",&vector[0],&vector[1],&vector[2])!=3)
-								Misc::throwStdErr("StructuredGridASCII::load: Invalid Cartesian vector attribute in line %u in slice file %s",lineIndex,argIt->c_str());
-							}
+						/* Read the vector attribute in spherical coordinates: */
+						double longitude=sliceFile.readDouble();
+						double latitude=sliceFile.readDouble();
+						double radius=sliceFile.readDouble();
 						
-						/* Store the vector's components and magnitude: */
+						/* Convert the vector to Cartesian coordinates: */
+						const DS::Point& p=dataSet.getVertexPosition(index);
+						double xy=Math::sqr(double(p[0]))+Math::sqr(double(p[1]));
+						double r=xy+Math::sqr(double(p[2]));
+						xy=Math::sqrt(xy);
+						r=Math::sqrt(r);
+						double s0=double(p[2])/r;
+						double c0=xy/r;
+						double s1=double(p[1])/xy;
+						double c1=double(p[0])/xy;
+						vector[0]=Scalar(c1*(c0*radius-s0*latitude)-s1*longitude);
+						vector[1]=Scalar(s1*(c0*radius-s0*latitude)+c1*longitude);
+						vector[2]=Scalar(c0*latitude+s0*radius);
+						}
+					else
+						{
+						/* Read the vector attribute in Cartesian coordinates: */
 						for(int i=0;i<3;++i)
-							dataSet.getVertexValue(sliceIndex+i,index)=vector[i];
-						dataSet.getVertexValue(sliceIndex+3,index)=Scalar(Geometry::mag(vector));
+							vector[i]=Scalar(sliceFile.readDouble());
+						}
+					
+					/* Store the vector's components and magnitude: */
+					for(int i=0;i<3;++i)
+						dataSet.getVertexValue(sliceIndex+i,index)=vector[i];
+					dataSet.getVertexValue(sliceIndex+3,index)=Scalar(Geometry::mag(vector));
+					}
+				else
+					{
+					/* Read the scalar attribute: */
+					if(logNextScalar)
+						{
+						double value=sliceFile.readDouble();
+						dataSet.getVertexValue(sliceIndex,index)=Scalar(Math::log10(value));
 						}
 					else
 						{
-						/* Read the scalar attribute: */
-						if(logNextScalar)
-							{
-							double value;
-							if(sscanf(line,"%lf",&value)!=1)
-								Misc::throwStdErr("StructuredGridASCII::load: Invalid logarithmic scalar vertex attribute in line %u in slice file %s",lineIndex,argIt->c_str());
-							dataSet.getVertexValue(sliceIndex,index)=Scalar(Math::log10(value));
-							}
-						else
-							{
-							if(sscanf(line,"%f",&dataSet.getVertexValue(sliceIndex,index))!=1)
-								Misc::throwStdErr("StructuredGridASCII::load: Invalid scalar vertex attribute in line %u in slice file %s",lineIndex,argIt->c_str());
-							}
+						dataSet.getVertexValue(sliceIndex,index)=Scalar(sliceFile.readDouble());
 						}
-
-					/* Go to the next vertex: */
-					int incDim;
-					for(incDim=0;incDim<2&&index[incDim]==numVertices[incDim]-1;++incDim)
-						index[incDim]=0;
-					++index[incDim];
-					if(incDim==2)
-						std::cout<<"\b\b\b\b"<<std::setw(3)<<(index[2]*100)/numVertices[2]<<"%"<<std::flush;
 					}
+				sliceFile.skipLine();
+
+				/* Go to the next vertex: */
+				int incDim;
+				for(incDim=0;incDim<2&&index[incDim]==numVertices[incDim]-1;++incDim)
+					index[incDim]=0;
+				++index[incDim];
+				if(incDim==2)
+					std::cout<<"\b\b\b\b"<<std::setw(3)<<(index[2]*100)/numVertices[2]<<"%"<<std::flush;
 				}
 			std::cout<<"\b\b\b\bdone"<<std::endl;
 			}
@@ -424,6 +415,11 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 	return result.releaseTarget();
 	}
 
+bool StructuredGridASCII::isDataSetCacheable(void) const
+	{
+	return true;
+	}
+
 }
 
 }
@@ -52,6 +52,7 @@ class StructuredGridASCII:public BaseModule
 	
 	/* Methods: */
 	virtual Visualization::Abstract::DataSet* load(const std::vector<std::string>& args,Comm::MulticastPipe* pipe) const;
+	virtual bool isDataSetCacheable(void) const; // Returns true; data sets are fully defined by the files named by their arguments
 	};
 
 }
@@ -242,6 +242,11 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 	return result.releaseTarget();
 	}
 
+bool StructuredGridVTK::isDataSetCacheable(void) const
+	{
+	return true;
+	}
+
 }
 
 }
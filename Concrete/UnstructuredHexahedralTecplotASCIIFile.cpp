@@ -293,6 +293,11 @@ Visualization::Abstract::DataSet* UnstructuredHexahedralTecplotASCIIFile::load(c
 	dataSet.finalizeGrid();
 	std::cout<<" done"<<std::endl;
 	
+	/* Precompute the grid's vertex gradient matrices: */
+	std::cout<<"Precomputing vertex gradients..."<<std::flush;
+	dataSet.calcGradientMatrices(getNumLoadThreads());
+	std::cout<<" done"<<std::endl;
+	
 	/* Return the result data set: */
 	return result.releaseTarget();
 	}
@@ -186,6 +186,9 @@ Visualization::Abstract::DataSet* UnstructuredPlot3DFile::load(const std::vector
 	snprintf(gridFilename,sizeof(gridFilename),"%s.grid",args[0].c_str());
 	readGrid(&result->getDs(),gridFilename);
 	
+	/* Precompute the grid's vertex gradient matrices to speed up isosurface and streamline extraction: */
+	result->getDs().calcGradientMatrices(getNumLoadThreads());
+	
 	/* Read the data values: */
 	char solutionFilename[1024];
 	snprintf(solutionFilename,sizeof(solutionFilename),"%s.sol",args[0].c_str());
@@ -21,10 +21,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 ***********************************************************************/
 
 #include <stdio.h>
+#include <vector>
 #include <Misc/File.h>
 #include <Plugins/FactoryManager.h>
 #include <Math/Math.h>
 
+#include <Concrete/MappedFile.h>
 #include <Concrete/VecVolFile.h>
 
 namespace Visualization {
@@ -61,18 +63,33 @@ Visualization::Abstract::DataSet* VecVolFile::load(const std::vector<std::string
 		cellSize[i]=float(domainSize[i])/float(numVertices[i]-1);
 		}
 	DataSet* result=new DataSet;
-	result->getDs().setData(numVertices,cellSize);
 	
 	/* Set the data value's name: */
 	result->getDataValue().setVectorVariableName("Velocity");
 	
-	/* Read the vertex values from file: */
-	DS::Array& vertices=result->getDs().getVertices();
-	for(DS::Array::iterator vIt=vertices.begin();vIt!=vertices.end();++vIt)
+	/* Map the vertex values directly from the file if they are stored in the host's byte order and in the data set's vector layout: */
+	const size_t headerSize=4*sizeof(int)+3*sizeof(float);
+	size_t numValues=size_t(numVertices.calcIncrement(-1));
+	MappedFile* mappedFile=0;
+	if(sizeof(DS::Value)==3*sizeof(float)&&MappedFile::isNativeEndianness(Misc::File::BigEndian))
+		mappedFile=MappedFile::mapArray<DS::Value>(args[0].c_str(),headerSize,numValues);
+	if(mappedFile!=0)
+		result->getDs().adoptData(numVertices,cellSize,mappedFile->getArray<DS::Value>(headerSize),mappedFile);
+	else
 		{
-		float vec[3];
-		file.read(vec,3);
-		*vIt=DS::Value(vec[0],vec[1],vec[2]);
+		/* Read the vertex values from file in blocks, swapping their byte order if necessary: */
+		result->getDs().setData(numVertices,cellSize);
+		DS::Value* vPtr=result->getDs().getVertexArray();
+		const size_t blockSize=65536;
+		std::vector<float> block(blockSize*3);
+		for(size_t blockStart=0;blockStart<numValues;blockStart+=blockSize)
+			{
+			size_t blockEnd=blockStart+blockSize<numValues?blockStart+blockSize:numValues;
+			file.read(&block[0],(blockEnd-blockStart)*3);
+			const float* bPtr=&block[0];
+			for(size_t i=blockStart;i<blockEnd;++i,++vPtr,bPtr+=3)
+				*vPtr=DS::Value(bPtr[0],bPtr[1],bPtr[2]);
+			}
 		}
 	
 	return result;
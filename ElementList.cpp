@@ -270,6 +270,13 @@ void ElementList::hideElementList(void)
 	widgetManager->popdownWidget(elementListDialogPopup);
 	}
 
+void ElementList::frame(void)
+	{
+	/* Update all visualization elements, including hidden ones to keep animations in step: */
+	for(ListElementList::iterator veIt=elements.begin();veIt!=elements.end();++veIt)
+		veIt->element->frame();
+	}
+
 void ElementList::renderElements(GLContextData& contextData,bool transparent) const
 	{
 	/* Render all visualization elements whose transparency flags match the given flag: */
@@ -93,8 +93,25 @@ class ElementList
 	void clear(void); // Deletes all elements from the list
 	void addElement(Element* newElement,const char* elementName); // Adds a new visualization element to the list
 	void saveElements(const char* elementFileName,bool ascii,const Visualization::Abstract::VariableManager* variableManager) const; // Saves all visible visualization elements to the given file
+	size_t getNumElements(void) const // Returns the number of visualization elements in the list
+		{
+		return elements.size();
+		}
+	const Element* getElement(size_t index) const // Returns the visualization element of the given index
+		{
+		return elements[index].element.getPointer();
+		}
+	const std::string& getElementName(size_t index) const // Returns the name of the algorithm that created the visualization element of the given index
+		{
+		return elements[index].name;
+		}
+	bool isElementVisible(size_t index) const // Returns true if the visualization element of the given index is being rendered
+		{
+		return elements[index].show;
+		}
 	void showElementList(const GLMotif::WidgetManager::Transformation& transformation); // Shows the element list dialog
 	void hideElementList(void); // Hides the element list dialog
+	void frame(void); // Updates all visualization elements once per application frame
 	void renderElements(GLContextData& contextData,bool transparent) const; // Renders all visible transparent or opaque elements
 	};
 
@@ -0,0 +1,442 @@
+/***********************************************************************
+ElementLoader - Helper class to re-extract visualization elements saved
+in element files on a pool of background threads, and to deliver them
+to the element list in the same order on all nodes of a cluster.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "ElementLoader.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Misc/File.h>
+#include <Comm/MulticastPipe.h>
+#include <Vrui/Vrui.h>
+
+#include <Abstract/VariableManager.h>
+#include <Abstract/Parameters.h>
+#include <Abstract/Algorithm.h>
+#include <Abstract/Element.h>
+#include <Abstract/Module.h>
+#include <Wrappers/ParametersIOHelper.h>
+
+#include "ElementList.h"
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+unsigned int getNumProcessors(void) // Returns the number of online processors
+	{
+	long numProcessors=sysconf(_SC_NPROCESSORS_ONLN);
+	return numProcessors>0?(unsigned int)numProcessors:1U;
+	}
+
+}
+
+/***********************************
+Methods of class ElementLoader::Job:
+***********************************/
+
+ElementLoader::Job::Job(const char* sName,ElementLoader::Algorithm* sAlgorithm,ElementLoader::Parameters* sParameters)
+	:name(sName),
+	 algorithm(sAlgorithm),
+	 parameters(sParameters),
+	 element(0),
+	 extractionTime(0.0),
+	 finished(false)
+	{
+	}
+
+ElementLoader::Job::~Job(void)
+	{
+	delete parameters;
+	delete algorithm;
+	}
+
+/******************************
+Methods of class ElementLoader:
+******************************/
+
+void* ElementLoader::extractorThreadMethod(void)
+	{
+	/* Extract visualization elements until shut down: */
+	while(true)
+		{
+		/* Wait until there is a job that may be started: */
+		unsigned int jobIndex;
+		Job* job;
+		{
+		Threads::Mutex::Lock jobLock(jobMutex);
+		while(nextJobIndex>=numStartableJobs)
+			{
+			if(shutdown)
+				return 0;
+			jobQueueCond.wait(jobMutex);
+			}
+		
+		/* Grab the next job: */
+		jobIndex=(unsigned int)nextJobIndex;
+		job=jobs[nextJobIndex];
+		++nextJobIndex;
+		}
+		
+		/* The algorithm inherits the extraction parameters: */
+		Parameters* parameters=job->parameters;
+		job->parameters=0;
+		
+		/* Extract the visualization element: */
+		Misc::Timer extractionTimer;
+		try
+			{
+			if(master||job->algorithm->extractsLocally())
+				job->element=job->algorithm->createElement(parameters);
+			else
+				{
+				/* Receive the visualization element from the master: */
+				job->element=job->algorithm->startSlaveElement(parameters);
+				job->algorithm->continueSlaveElement();
+				}
+			}
+		catch(const std::runtime_error& err)
+			{
+			std::cerr<<"ElementLoader: Caught exception "<<err.what()<<" while creating "<<job->name<<std::endl;
+			job->element=0;
+			}
+		extractionTimer.elapse();
+		job->extractionTime=extractionTimer.getTime();
+		
+		/* Hand the finished job to the main thread: */
+		{
+		Threads::Mutex::Lock jobLock(jobMutex);
+		job->finished=true;
+		++numFinishedJobs;
+		if(master)
+			finishedJobIndices.push_back(jobIndex);
+		jobFinishedCond.broadcast();
+		}
+		Vrui::requestUpdate();
+		}
+	
+	return 0;
+	}
+
+ElementLoader::Algorithm* ElementLoader::createAlgorithm(const char* name)
+	{
+	/* Create an extractor for the given name: */
+	Algorithm* result=0;
+	for(int i=0;result==0&&i<module->getNumScalarAlgorithms();++i)
+		if(strcmp(name,module->getScalarAlgorithmName(i))==0)
+			result=module->getScalarAlgorithm(i,variableManager,Vrui::openPipe());
+	for(int i=0;result==0&&i<module->getNumVectorAlgorithms();++i)
+		if(strcmp(name,module->getVectorAlgorithmName(i))==0)
+			result=module->getVectorAlgorithm(i,variableManager,Vrui::openPipe());
+	
+	/* Share the algorithm's extraction threads among the extractor threads, which run their jobs' algorithms concurrently; each algorithm keeps at least one thread: */
+	if(result!=0)
+		result->setNumThreads(result->getNumThreads()/numThreads);
+	
+	return result;
+	}
+
+ElementLoader::ElementLoader(ElementLoader::Module* sModule,ElementLoader::VariableManager* sVariableManager,Comm::MulticastPipe* sPipe,unsigned int sNumThreads)
+	:module(sModule),variableManager(sVariableManager),
+	 pipe(sPipe),master(pipe==0||pipe->isMaster()),
+	 numThreads(sNumThreads>0?sNumThreads:getNumProcessors()),
+	 extractorThreads(0),
+	 numStartableJobs(0),nextJobIndex(0),numFinishedJobs(0),
+	 numDeliveredJobs(0),
+	 shutdown(false)
+	{
+	/* Start the extractor threads: */
+	extractorThreads=new Threads::Thread[numThreads];
+	for(unsigned int i=0;i<numThreads;++i)
+		extractorThreads[i].start(this,&ElementLoader::extractorThreadMethod);
+	}
+
+ElementLoader::~ElementLoader(void)
+	{
+	/* Stop the master from starting any more jobs: */
+	unsigned int numStartedJobs;
+	{
+	Threads::Mutex::Lock jobLock(jobMutex);
+	if(master)
+		numStartableJobs=nextJobIndex;
+	numStartedJobs=(unsigned int)nextJobIndex;
+	}
+	
+	if(pipe!=0)
+		{
+		/* Tell the slaves which jobs the master started, because their elements are already on the way: */
+		if(master)
+			{
+			pipe->write<unsigned int>(numStartedJobs);
+			pipe->finishMessage();
+			}
+		else
+			numStartedJobs=pipe->read<unsigned int>();
+		}
+	
+	/* Tell the extractor threads to exit after finishing all started jobs: */
+	{
+	Threads::Mutex::Lock jobLock(jobMutex);
+	if(numStartableJobs<numStartedJobs)
+		numStartableJobs=numStartedJobs;
+	shutdown=true;
+	jobQueueCond.broadcast();
+	}
+	for(unsigned int i=0;i<numThreads;++i)
+		extractorThreads[i].join();
+	delete[] extractorThreads;
+	
+	/* Delete all undelivered jobs: */
+	for(std::vector<Job*>::iterator jIt=jobs.begin();jIt!=jobs.end();++jIt)
+		delete *jIt;
+	
+	delete pipe;
+	}
+
+void ElementLoader::loadElements(const char* elementFileName,bool ascii)
+	{
+	if(master)
+		{
+		/* Open the element file: */
+		Misc::File elementFile(elementFileName,ascii?"r":"rb",ascii?Misc::File::DontCare:Misc::File::LittleEndian);
+		
+		/* Read all elements from the file: */
+		while(true)
+			{
+			/* Read the next algorithm name; a malformed name ends the file, so the slaves stay in sync: */
+			char name[256];
+			bool haveName=false;
+			try
+				{
+				haveName=Visualization::Wrappers::readElementAlgorithmName(elementFile,ascii,name);
+				}
+			catch(const std::runtime_error& err)
+				{
+				std::cerr<<"ElementLoader: Caught exception "<<err.what()<<" while reading "<<elementFileName<<std::endl;
+				}
+			if(!haveName)
+				{
+				/* Tell the slaves to bail out: */
+				if(pipe!=0)
+					{
+					pipe->write<unsigned int>(0);
+					pipe->finishMessage();
+					}
+				
+				/* Bail out: */
+				break;
+				}
+			unsigned int nameLength=(unsigned int)strlen(name);
+			
+			if(pipe!=0)
+				{
+				/* Send the algorithm name to the slaves: */
+				pipe->write<unsigned int>(nameLength);
+				pipe->write(name,nameLength);
+				}
+			
+			/* Create an extractor for the given name: */
+			Algorithm* algorithm=createAlgorithm(name);
+			if(algorithm!=0)
+				{
+				/* Read the element's extraction parameters from the file: */
+				Parameters* parameters=algorithm->cloneParameters();
+				parameters->read(elementFile,ascii,variableManager);
+				
+				if(pipe!=0)
+					{
+					/* Send the extraction parameters to the slaves: */
+					parameters->write(*pipe,variableManager);
+					pipe->finishMessage();
+					}
+				
+				/* Queue the element for extraction: */
+				Threads::Mutex::Lock jobLock(jobMutex);
+				jobs.push_back(new Job(name,algorithm,parameters));
+				numStartableJobs=jobs.size();
+				jobQueueCond.signal();
+				}
+			}
+		}
+	else
+		{
+		/* Receive all visualization elements from the master: */
+		while(true)
+			{
+			/* Receive the algorithm name from the master: */
+			unsigned int nameLength=pipe->read<unsigned int>();
+			if(nameLength==0) // Check for end-of-file indicator
+				break;
+			char name[256];
+			pipe->read(name,nameLength);
+			name[nameLength]='\0';
+			
+			/* Create an extractor for the given name: */
+			Algorithm* algorithm=createAlgorithm(name);
+			if(algorithm!=0)
+				{
+				/* Receive the extraction parameters: */
+				Parameters* parameters=algorithm->cloneParameters();
+				parameters->read(*pipe,variableManager);
+				
+				/* Queue the element; it is started once the master starts it: */
+				Threads::Mutex::Lock jobLock(jobMutex);
+				jobs.push_back(new Job(name,algorithm,parameters));
+				}
+			}
+		}
+	}
+
+void ElementLoader::reloadElements(const ElementList& elementList)
+	{
+	/* Queue all visible visualization elements in list order, which is the same on all nodes: */
+	for(size_t i=0;i<elementList.getNumElements();++i)
+		if(elementList.isElementVisible(i))
+			{
+			/* Create an extractor for the element's algorithm: */
+			const std::string& name=elementList.getElementName(i);
+			Algorithm* algorithm=createAlgorithm(name.c_str());
+			if(algorithm==0)
+				continue;
+			
+			/* Copy the element's extraction parameters and re-bind them to the current data set: */
+			Parameters* parameters=elementList.getElement(i)->getParameters()->clone();
+			try
+				{
+				parameters->dataSetChanged(variableManager);
+				}
+			catch(const std::runtime_error& err)
+				{
+				std::cerr<<"ElementLoader: Caught exception "<<err.what()<<" while re-binding "<<name<<std::endl;
+				delete parameters;
+				parameters=0;
+				}
+			if(parameters==0||!parameters->isValid())
+				{
+				/* Skip elements that cannot be extracted from the current data set: */
+				delete parameters;
+				delete algorithm;
+				continue;
+				}
+			
+			/* Queue the element for extraction; on slave nodes, it is started once the master starts it: */
+			Threads::Mutex::Lock jobLock(jobMutex);
+			jobs.push_back(new Job(name.c_str(),algorithm,parameters));
+			if(master)
+				{
+				numStartableJobs=jobs.size();
+				jobQueueCond.signal();
+				}
+			}
+	}
+
+void ElementLoader::deliverElements(ElementList& elementList,bool wait)
+	{
+	if(!hasPendingElements())
+		return;
+	
+	/* Determine the finished jobs to deliver, in the master's order of completion: */
+	std::vector<unsigned int> deliveredJobIndices;
+	if(master)
+		{
+		unsigned int numStartedJobs;
+		{
+		Threads::Mutex::Lock jobLock(jobMutex);
+		if(wait)
+			{
+			/* Wait until all queued jobs are finished: */
+			while(numFinishedJobs<jobs.size())
+				jobFinishedCond.wait(jobMutex);
+			}
+		deliveredJobIndices.swap(finishedJobIndices);
+		numStartedJobs=(unsigned int)nextJobIndex;
+		}
+		
+		if(pipe!=0)
+			{
+			/* Send the number of started jobs and the delivery order to the slaves: */
+			pipe->write<unsigned int>(numStartedJobs);
+			pipe->write<unsigned int>((unsigned int)deliveredJobIndices.size());
+			if(!deliveredJobIndices.empty())
+				pipe->write(&deliveredJobIndices[0],deliveredJobIndices.size());
+			pipe->finishMessage();
+			}
+		}
+	else
+		{
+		/* Receive the number of started jobs and the delivery order from the master: */
+		unsigned int numStartedJobs=pipe->read<unsigned int>();
+		deliveredJobIndices.resize(pipe->read<unsigned int>());
+		if(!deliveredJobIndices.empty())
+			pipe->read(&deliveredJobIndices[0],deliveredJobIndices.size());
+		
+		Threads::Mutex::Lock jobLock(jobMutex);
+		
+		/* Let the extractor threads start all jobs started by the master: */
+		if(numStartableJobs<numStartedJobs)
+			{
+			numStartableJobs=numStartedJobs;
+			jobQueueCond.broadcast();
+			}
+		
+		/* Wait until the jobs delivered by the master are finished locally; their elements are already on the way: */
+		for(std::vector<unsigned int>::const_iterator djIt=deliveredJobIndices.begin();djIt!=deliveredJobIndices.end();++djIt)
+			while(!jobs[*djIt]->finished)
+				jobFinishedCond.wait(jobMutex);
+		}
+	
+	/* Add the delivered visualization elements to the element list: */
+	for(std::vector<unsigned int>::const_iterator djIt=deliveredJobIndices.begin();djIt!=deliveredJobIndices.end();++djIt)
+		{
+		Job* job=jobs[*djIt];
+		if(job->element!=0)
+			{
+			if(master)
+				std::cout<<"Created "<<job->name<<" in "<<job->extractionTime*1000.0<<" ms"<<std::endl;
+			elementList.addElement(job->element.getPointer(),job->name.c_str());
+			job->element=0;
+			}
+		
+		/* Destroy the extractor: */
+		delete job->algorithm;
+		job->algorithm=0;
+		++numDeliveredJobs;
+		}
+	
+	if(numDeliveredJobs==jobs.size())
+		{
+		/* Delete all delivered jobs: */
+		Threads::Mutex::Lock jobLock(jobMutex);
+		for(std::vector<Job*>::iterator jIt=jobs.begin();jIt!=jobs.end();++jIt)
+			delete *jIt;
+		jobs.clear();
+		numStartableJobs=0;
+		nextJobIndex=0;
+		numFinishedJobs=0;
+		numDeliveredJobs=0;
+		}
+	}
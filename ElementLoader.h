@@ -0,0 +1,116 @@
+/***********************************************************************
+ElementLoader - Helper class to re-extract visualization elements saved
+in element files on a pool of background threads, and to deliver them
+to the element list in the same order on all nodes of a cluster.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef ELEMENTLOADER_INCLUDED
+#define ELEMENTLOADER_INCLUDED
+
+#include <string>
+#include <vector>
+#include <Misc/Autopointer.h>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
+
+/* Forward declarations: */
+namespace Comm {
+class MulticastPipe;
+}
+namespace Visualization {
+namespace Abstract {
+class VariableManager;
+class Parameters;
+class Algorithm;
+class Element;
+class Module;
+}
+}
+class ElementList;
+
+class ElementLoader
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::VariableManager VariableManager;
+	typedef Visualization::Abstract::Parameters Parameters;
+	typedef Visualization::Abstract::Algorithm Algorithm;
+	typedef Visualization::Abstract::Element Element;
+	typedef Visualization::Abstract::Module Module;
+	typedef Misc::Autopointer<Element> ElementPointer;
+	
+	private:
+	struct Job // Structure for a saved visualization element waiting for extraction
+		{
+		/* Elements: */
+		public:
+		std::string name; // Name of the algorithm that creates the visualization element
+		Algorithm* algorithm; // Algorithm creating the visualization element
+		Parameters* parameters; // Extraction parameters read from the element file; inherited by the algorithm when extraction starts
+		ElementPointer element; // The finished visualization element, or null if extraction failed
+		double extractionTime; // Time it took to extract the visualization element in seconds
+		bool finished; // Flag whether an extractor thread is done with the visualization element
+		
+		/* Constructors and destructors: */
+		Job(const char* sName,Algorithm* sAlgorithm,Parameters* sParameters);
+		~Job(void);
+		};
+	
+	/* Elements: */
+	Module* module; // Visualization module providing the algorithms
+	VariableManager* variableManager; // Variable manager for the created algorithms
+	Comm::MulticastPipe* pipe; // Pipe to send element files and the delivery order of finished visualization elements to the slave nodes of a cluster
+	bool master; // Flag if this loader runs on the master node of a cluster
+	unsigned int numThreads; // Number of extractor threads
+	Threads::Thread* extractorThreads; // Array of extractor threads
+	
+	/* Extractor thread communication: */
+	Threads::Mutex jobMutex; // Mutex protecting the job queue
+	Threads::Cond jobQueueCond; // Condition variable for idle extractor threads to block on
+	Threads::Cond jobFinishedCond; // Condition variable signalled whenever an extractor thread finishes a visualization element
+	std::vector<Job*> jobs; // List of all visualization elements not yet delivered to the element list, in element file order
+	size_t numStartableJobs; // Number of jobs extractor threads may start; limited by the number of jobs the master started on slave nodes
+	size_t nextJobIndex; // Index of the next job to be started by an extractor thread
+	size_t numFinishedJobs; // Number of jobs finished by extractor threads
+	std::vector<unsigned int> finishedJobIndices; // Indices of finished jobs not yet delivered to the element list, in order of completion
+	size_t numDeliveredJobs; // Number of jobs already delivered to the element list
+	bool shutdown; // Flag telling the extractor threads to exit once they run out of startable jobs
+	
+	/* Private methods: */
+	void* extractorThreadMethod(void); // The extractor thread method
+	Algorithm* createAlgorithm(const char* name); // Creates an algorithm of the given name, or returns 0 if there is no such algorithm
+	
+	/* Constructors and destructors: */
+	public:
+	ElementLoader(Module* sModule,VariableManager* sVariableManager,Comm::MulticastPipe* sPipe,unsigned int sNumThreads); // Creates an element loader with the given number of extractor threads, or one thread per online processor if zero; inherits pipe; must be called on all nodes of a cluster
+	~ElementLoader(void); // Waits for all visualization elements currently being extracted and discards all others; must be called on all nodes of a cluster
+	
+	/* Methods: */
+	void loadElements(const char* elementFileName,bool ascii); // Reads all visualization elements from the given element file and queues them for extraction; must be called on all nodes of a cluster
+	void reloadElements(const ElementList& elementList); // Queues all visible visualization elements of the given element list for extraction from copies of their extraction parameters, re-bound to the variable manager's current data set; must be called on all nodes of a cluster
+	bool hasPendingElements(void) const // Returns true if there are queued visualization elements not yet delivered to the element list
+		{
+		return numDeliveredJobs<jobs.size();
+		}
+	void deliverElements(ElementList& elementList,bool wait); // Adds all finished visualization elements to the given element list in order of completion; waits for all queued elements if wait flag is true; must be called on all nodes of a cluster
+	};
+
+#endif
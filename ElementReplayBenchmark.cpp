@@ -0,0 +1,475 @@
+/***********************************************************************
+ElementReplayBenchmark - Headless program to measure the performance of
+visualization algorithms by loading a data set through a visualization
+module and re-extracting all visualization elements saved in an element
+file, without opening a display.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Misc/File.h>
+#include <Misc/FileNameExtensions.h>
+#include <Misc/Autopointer.h>
+#include <Plugins/FactoryManager.h>
+
+#include <Abstract/DataSet.h>
+#include <Abstract/VariableManager.h>
+#include <Abstract/Parameters.h>
+#include <Abstract/Algorithm.h>
+#include <Abstract/Element.h>
+#include <Abstract/Module.h>
+#include <Abstract/DataSetCache.h>
+#include <Wrappers/ParametersIOHelper.h>
+
+/* Types of the replayed visualization pipeline: */
+typedef Visualization::Abstract::Module Module;
+typedef Plugins::FactoryManager<Module> ModuleManager;
+typedef Visualization::Abstract::DataSet DataSet;
+typedef Visualization::Abstract::VariableManager VariableManager;
+typedef Visualization::Abstract::Parameters Parameters;
+typedef Visualization::Abstract::Algorithm Algorithm;
+typedef Visualization::Abstract::Element Element;
+typedef Misc::Autopointer<Element> ElementPointer;
+
+double getPeakMemory(void) // Returns the peak resident set size of the process in megabytes
+	{
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF,&usage)!=0)
+		return 0.0;
+	return double(usage.ru_maxrss)/1024.0;
+	}
+
+struct Configuration // Structure for algorithm settings under which each element is re-extracted
+	{
+	/* Elements: */
+	public:
+	unsigned int numThreads; // Number of extraction threads
+	bool useCellIndex; // Flag whether algorithms only visit cells found by a value range index
+	bool useEdgeSlabs; // Flag whether algorithms share the vertices of surfaces extracted from structured grids through edge slabs instead of a hash table
+	bool incrementalUpdate; // Flag whether algorithms update the previous element of the same algorithm instead of extracting from scratch
+	int shading; // Shading mode forced onto elements that support flat and smooth shading; -1 keeps each element's own mode, 0 forces flat, 1 forces smooth shading
+	bool useGradientCache; // Flag whether algorithms look up smooth shading gradients in the data set's gradient caches
+	
+	/* Methods: */
+	void apply(void) const // Sets the defaults of subsequently created algorithms
+		{
+		Algorithm::setDefaultNumThreads(numThreads);
+		Algorithm::setDefaultUseCellIndex(useCellIndex);
+		Algorithm::setDefaultUseEdgeSlabs(useEdgeSlabs);
+		Algorithm::setDefaultIncrementalUpdate(incrementalUpdate);
+		Algorithm::setDefaultUseGradientCache(useGradientCache);
+		}
+	Parameters* applyShading(const Parameters* parameters) const // Returns a copy of the given extraction parameters with the configuration's shading mode
+		{
+		Parameters* result=parameters->clone();
+		if(shading>=0)
+			result->setSmoothShading(shading!=0);
+		return result;
+		}
+	bool sameAs(const Configuration& other,bool compareNumThreads,bool compareEdgeSlabs,bool compareGradientCache) const // Returns true if the configuration equals the other in all settings except the ones not to be compared
+		{
+		return (!compareNumThreads||numThreads==other.numThreads)&&useCellIndex==other.useCellIndex&&(!compareEdgeSlabs||useEdgeSlabs==other.useEdgeSlabs)&&incrementalUpdate==other.incrementalUpdate&&shading==other.shading&&(!compareGradientCache||useGradientCache==other.useGradientCache);
+		}
+	void print(std::ostream& os) const // Prints the configuration
+		{
+		os<<numThreads<<(numThreads==1?" thread, ":" threads, ");
+		os<<(useCellIndex?"cell index":"cell sweep");
+		os<<(useEdgeSlabs?", edge slabs":", edge hash");
+		if(incrementalUpdate)
+			os<<", incremental";
+		if(shading==0)
+			os<<", flat";
+		else if(shading==1)
+			os<<(useGradientCache?", smooth, gradient cache":", smooth, gradients on the fly");
+		}
+	};
+
+Algorithm* createAlgorithm(Module* module,VariableManager* variableManager,const char* name) // Creates an algorithm of the given name, or returns 0 if the module has no such algorithm
+	{
+	Algorithm* result=0;
+	for(int i=0;result==0&&i<module->getNumScalarAlgorithms();++i)
+		if(strcmp(name,module->getScalarAlgorithmName(i))==0)
+			result=module->getScalarAlgorithm(i,variableManager,0);
+	for(int i=0;result==0&&i<module->getNumVectorAlgorithms();++i)
+		if(strcmp(name,module->getVectorAlgorithmName(i))==0)
+			result=module->getVectorAlgorithm(i,variableManager,0);
+	return result;
+	}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	std::string moduleClassName="";
+	std::vector<std::string> dataSetArgs;
+	const char* elementFileName=0;
+	bool compareCellIndex=false;
+	bool compareEdgeSlabs=false;
+	bool compareIncremental=false;
+	bool compareGradientCache=false;
+	unsigned int maxScalingThreads=0;
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"class")==0)
+				{
+				/* Get visualization module class name and data set arguments from command line: */
+				++i;
+				if(i<argc)
+					{
+					moduleClassName=argv[i];
+					++i;
+					while(i<argc&&strcmp(argv[i],";")!=0)
+						{
+						dataSetArgs.push_back(argv[i]);
+						++i;
+						}
+					}
+				else
+					std::cerr<<"ElementReplayBenchmark: ignored dangling -class option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"threads")==0)
+				{
+				++i;
+				if(i<argc)
+					Algorithm::setDefaultNumThreads((unsigned int)(atoi(argv[i])));
+				else
+					std::cerr<<"ElementReplayBenchmark: ignored dangling -threads option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"loadThreads")==0)
+				{
+				++i;
+				if(i<argc)
+					Module::setNumLoadThreads((unsigned int)(atoi(argv[i])));
+				else
+					std::cerr<<"ElementReplayBenchmark: ignored dangling -loadThreads option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"gradientCacheSize")==0)
+				{
+				++i;
+				if(i<argc)
+					DataSet::setGradientCacheBudget(size_t(atoi(argv[i]))*size_t(1024*1024));
+				else
+					std::cerr<<"ElementReplayBenchmark: ignored dangling -gradientCacheSize option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"noCache")==0)
+				Visualization::Abstract::DataSetCache::setEnabled(false);
+			else if(strcasecmp(argv[i]+1,"compareCellIndex")==0)
+				compareCellIndex=true;
+			else if(strcasecmp(argv[i]+1,"compareEdgeSlabs")==0)
+				compareEdgeSlabs=true;
+			else if(strcasecmp(argv[i]+1,"compareIncremental")==0)
+				compareIncremental=true;
+			else if(strcasecmp(argv[i]+1,"compareGradientCache")==0)
+				compareGradientCache=true;
+			else if(strcasecmp(argv[i]+1,"previews")==0)
+				Algorithm::setDefaultProgressiveRefinement(true);
+			else if(strcasecmp(argv[i]+1,"scaling")==0)
+				{
+				++i;
+				if(i<argc)
+					maxScalingThreads=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"ElementReplayBenchmark: ignored dangling -scaling option"<<std::endl;
+				}
+			else
+				std::cerr<<"ElementReplayBenchmark: ignored unrecognized option "<<argv[i]<<std::endl;
+			}
+		else if(elementFileName==0)
+			elementFileName=argv[i];
+		else
+			std::cerr<<"ElementReplayBenchmark: ignored extra argument "<<argv[i]<<std::endl;
+		}
+	if(moduleClassName==""||dataSetArgs.empty()||elementFileName==0)
+		{
+		std::cerr<<"Usage: ElementReplayBenchmark [-threads <num>] [-loadThreads <num>] [-gradientCacheSize <MB>] [-noCache] [-compareCellIndex] [-compareEdgeSlabs] [-compareIncremental] [-compareGradientCache] [-previews] [-scaling <max threads>] -class <module class name> <data set arguments> ; <element file name>"<<std::endl;
+		return 1;
+		}
+	
+	/* Create the list of configurations under which to re-extract each element: */
+	std::vector<Configuration> configurations;
+	Configuration defaultConfiguration;
+	defaultConfiguration.numThreads=Algorithm::getDefaultNumThreads();
+	defaultConfiguration.useCellIndex=Algorithm::getDefaultUseCellIndex();
+	defaultConfiguration.useEdgeSlabs=Algorithm::getDefaultUseEdgeSlabs();
+	defaultConfiguration.incrementalUpdate=false;
+	defaultConfiguration.shading=-1;
+	defaultConfiguration.useGradientCache=Algorithm::getDefaultUseGradientCache();
+	configurations.push_back(defaultConfiguration);
+	if(compareCellIndex)
+		{
+		/* Compare sweeping all cells against only visiting the cells found by the value range index: */
+		std::vector<Configuration> newConfigurations;
+		for(std::vector<Configuration>::iterator cIt=configurations.begin();cIt!=configurations.end();++cIt)
+			for(int i=0;i<2;++i)
+				{
+				newConfigurations.push_back(*cIt);
+				newConfigurations.back().useCellIndex=i==0;
+				}
+		configurations=newConfigurations;
+		}
+	if(compareEdgeSlabs)
+		{
+		/* Compare sharing surface vertices through a hash table against sharing them through edge slabs: */
+		std::vector<Configuration> newConfigurations;
+		for(std::vector<Configuration>::iterator cIt=configurations.begin();cIt!=configurations.end();++cIt)
+			for(int i=0;i<2;++i)
+				{
+				newConfigurations.push_back(*cIt);
+				newConfigurations.back().useEdgeSlabs=i==1;
+				}
+		configurations=newConfigurations;
+		}
+	if(compareIncremental)
+		{
+		/* Compare extracting each element from scratch against updating the previous element of the same algorithm: */
+		std::vector<Configuration> newConfigurations;
+		for(std::vector<Configuration>::iterator cIt=configurations.begin();cIt!=configurations.end();++cIt)
+			for(int i=0;i<2;++i)
+				{
+				newConfigurations.push_back(*cIt);
+				newConfigurations.back().incrementalUpdate=i==1;
+				}
+		configurations=newConfigurations;
+		}
+	if(compareGradientCache)
+		{
+		/* Compare flat shading, smooth shading with gradients calculated on the fly, and smooth shading with cached gradients: */
+		std::vector<Configuration> newConfigurations;
+		for(std::vector<Configuration>::iterator cIt=configurations.begin();cIt!=configurations.end();++cIt)
+			for(int i=0;i<3;++i)
+				{
+				newConfigurations.push_back(*cIt);
+				newConfigurations.back().shading=i==0?0:1;
+				newConfigurations.back().useGradientCache=i==2;
+				}
+		configurations=newConfigurations;
+		
+		/* Let the data sets cache the gradients of all scalar variables unless a budget was given: */
+		if(DataSet::getGradientCacheBudget()==0)
+			DataSet::setGradientCacheBudget(~size_t(0));
+		}
+	if(maxScalingThreads>0)
+		{
+		/* Extract with one thread, and all powers of two up to and including the maximum number of threads: */
+		std::vector<Configuration> newConfigurations;
+		for(std::vector<Configuration>::iterator cIt=configurations.begin();cIt!=configurations.end();++cIt)
+			for(unsigned int numThreads=1;;numThreads*=2)
+				{
+				if(numThreads>maxScalingThreads)
+					numThreads=maxScalingThreads;
+				newConfigurations.push_back(*cIt);
+				newConfigurations.back().numThreads=numThreads;
+				if(numThreads==maxScalingThreads)
+					break;
+				}
+		configurations=newConfigurations;
+		}
+	
+	/* Binary element files are written in little endian byte order: */
+	bool ascii=Misc::hasCaseExtension(elementFileName,".asciielem");
+	
+	ModuleManager moduleManager(VISUALIZER_MODULENAMETEMPLATE);
+	DataSet* dataSet=0;
+	VariableManager* variableManager=0;
+	std::vector<Algorithm*> incrementalAlgorithms(configurations.size(),0); // Algorithms kept alive between consecutive elements by incremental configurations
+	std::vector<std::string> incrementalAlgorithmNames(configurations.size()); // Names of the kept algorithms
+	int result=0;
+	try
+		{
+		/* Load the visualization module and the data set: */
+		Module* module=moduleManager.loadClass(moduleClassName.c_str());
+		Misc::Timer loadTimer;
+		dataSet=module->loadCached(dataSetArgs,0);
+		loadTimer.elapse();
+		std::cout<<"Data set loading   : "<<loadTimer.getTime()*1000.0<<" ms, peak memory "<<getPeakMemory()<<" MB"<<std::endl;
+		
+		/* Create a variable manager without color bar and palette editor: */
+		variableManager=new VariableManager(dataSet,0,true);
+		
+		/* Re-extract all elements from the element file: */
+		Misc::File elementFile(elementFileName,ascii?"r":"rb",ascii?Misc::File::DontCare:Misc::File::LittleEndian);
+		unsigned int numElements=0;
+		std::vector<double> totalTimes(configurations.size(),0.0);
+		char name[256];
+		while(Visualization::Wrappers::readElementAlgorithmName(elementFile,ascii,name))
+			{
+			/* Create an algorithm for the given name to read the element's parameters: */
+			Algorithm* algorithm=createAlgorithm(module,variableManager,name);
+			if(algorithm==0)
+				{
+				/* The element's parameters can not be skipped without the algorithm; bail out: */
+				std::cerr<<"ElementReplayBenchmark: unknown algorithm "<<name<<" in element file"<<std::endl;
+				result=1;
+				break;
+				}
+			
+			/* Read the element's extraction parameters from the file: */
+			Parameters* parameters=algorithm->cloneParameters();
+			parameters->read(elementFile,ascii,variableManager);
+			delete algorithm;
+			++numElements;
+			
+			if(configurations.size()>1)
+				{
+				/* Extract the element once to build all caches and indices shared by the configurations: */
+				configurations[0].apply();
+				Parameters* warmupParameters=parameters->clone();
+				if(compareGradientCache)
+					{
+					/* Build the gradient cache as well: */
+					Algorithm::setDefaultUseGradientCache(true);
+					warmupParameters->setSmoothShading(true);
+					}
+				algorithm=createAlgorithm(module,variableManager,name);
+				Misc::Timer extractionTimer;
+				ElementPointer element=algorithm->createElement(warmupParameters);
+				extractionTimer.elapse();
+				std::cout<<"Element "<<numElements<<" ("<<name<<"): first extraction "<<extractionTimer.getTime()*1000.0<<" ms, peak memory "<<getPeakMemory()<<" MB"<<std::endl;
+				element=0;
+				delete algorithm;
+				}
+			
+			/* Extract the element under all configurations: */
+			for(size_t ci=0;ci<configurations.size();++ci)
+				{
+				/* Create an algorithm with the configuration's settings, or keep updating the previous element's algorithm if it has the same name: */
+				configurations[ci].apply();
+				if(configurations[ci].incrementalUpdate&&incrementalAlgorithms[ci]!=0&&incrementalAlgorithmNames[ci]==name)
+					algorithm=incrementalAlgorithms[ci];
+				else
+					{
+					delete incrementalAlgorithms[ci];
+					incrementalAlgorithms[ci]=0;
+					algorithm=createAlgorithm(module,variableManager,name);
+					}
+				
+				/* Extract the element, preceded by its coarse previews if the algorithm delivers any: */
+				Misc::Timer extractionTimer;
+				unsigned int numPreviewStages=algorithm->getNumPreviewStages();
+				double firstGeometryTime=0.0;
+				for(unsigned int stage=0;stage<numPreviewStages;++stage)
+					{
+					ElementPointer preview=algorithm->createPreviewElement(configurations[ci].applyShading(parameters),stage);
+					if(stage==0)
+						firstGeometryTime=extractionTimer.peekTime();
+					}
+				ElementPointer element=algorithm->createElement(configurations[ci].applyShading(parameters));
+				extractionTimer.elapse();
+				double extractionTime=extractionTimer.getTime();
+				algorithm->setGeometryTimes(numPreviewStages>0?firstGeometryTime:extractionTime,extractionTime);
+				totalTimes[ci]+=extractionTime;
+				
+				/* Print the element's statistics: */
+				std::cout<<"Element "<<numElements<<" ("<<name<<", ";
+				configurations[ci].print(std::cout);
+				std::cout<<"): ";
+				if(numPreviewStages>0)
+					std::cout<<"first geometry after "<<algorithm->getFirstGeometryTime()*1000.0<<" ms, final geometry after "<<algorithm->getFinalGeometryTime()*1000.0<<" ms, ";
+				else
+					std::cout<<extractionTime*1000.0<<" ms, ";
+				size_t numVisitedCells=algorithm->getNumVisitedCells();
+				if(numVisitedCells>0)
+					{
+					std::cout<<numVisitedCells<<" cells visited, ";
+					size_t numRevisitedCells=algorithm->getNumRevisitedCells();
+					if(numRevisitedCells>0)
+						std::cout<<numRevisitedCells<<" of them revisited, ";
+					}
+				else
+					std::cout<<"cells visited not counted, ";
+				if(element!=0)
+					{
+					/* Print the element's vertex and triangle counts, or its generic size if it does not count them: */
+					size_t numVertices=element->getNumVertices();
+					size_t numTriangles=element->getNumTriangles();
+					if(numVertices>0||numTriangles>0)
+						{
+						std::cout<<numVertices<<" vertices, ";
+						if(numTriangles>0)
+							std::cout<<numTriangles<<" triangles, ";
+						}
+					else
+						std::cout<<"element size "<<element->getSize()<<", ";
+					}
+				else
+					std::cout<<"no element, ";
+				std::cout<<"peak memory "<<getPeakMemory()<<" MB"<<std::endl;
+				
+				/* Destroy the element and the algorithm, unless the configuration updates the next element with it: */
+				element=0;
+				if(configurations[ci].incrementalUpdate)
+					{
+					incrementalAlgorithms[ci]=algorithm;
+					incrementalAlgorithmNames[ci]=name;
+					}
+				else
+					delete algorithm;
+				}
+			delete parameters;
+			}
+		for(size_t ci=0;ci<configurations.size();++ci)
+			{
+			std::cout<<"Total extraction   : "<<numElements<<" elements in "<<totalTimes[ci]*1000.0<<" ms (";
+			configurations[ci].print(std::cout);
+			std::cout<<")";
+			
+			/* Print the speed-up against the same configuration on one thread: */
+			if(maxScalingThreads>0&&configurations[ci].numThreads>1)
+				for(size_t ci0=0;ci0<ci;++ci0)
+					if(configurations[ci0].numThreads==1&&configurations[ci0].sameAs(configurations[ci],false,true,true))
+						std::cout<<", speed-up "<<totalTimes[ci0]/totalTimes[ci];
+			
+			/* Print the speed-up against the same configuration sharing vertices through a hash table: */
+			if(compareEdgeSlabs&&configurations[ci].useEdgeSlabs)
+				for(size_t ci0=0;ci0<ci;++ci0)
+					if(!configurations[ci0].useEdgeSlabs&&configurations[ci0].sameAs(configurations[ci],true,false,true))
+						std::cout<<", speed-up over edge hash "<<totalTimes[ci0]/totalTimes[ci];
+			
+			/* Print the speed-up against the same configuration calculating smooth shading gradients on the fly: */
+			if(compareGradientCache&&configurations[ci].useGradientCache)
+				for(size_t ci0=0;ci0<ci;++ci0)
+					if(!configurations[ci0].useGradientCache&&configurations[ci0].sameAs(configurations[ci],true,true,false))
+						std::cout<<", speed-up over gradients on the fly "<<totalTimes[ci0]/totalTimes[ci];
+			std::cout<<std::endl;
+			}
+		std::cout<<"Peak memory        : "<<getPeakMemory()<<" MB"<<std::endl;
+		}
+	catch(const std::runtime_error& err)
+		{
+		std::cerr<<"ElementReplayBenchmark: caught exception "<<err.what()<<std::endl;
+		result=1;
+		}
+	
+	/* Clean up: */
+	for(std::vector<Algorithm*>::iterator iaIt=incrementalAlgorithms.begin();iaIt!=incrementalAlgorithms.end();++iaIt)
+		delete *iaIt;
+	delete variableManager;
+	delete dataSet;
+	
+	return result;
+	}
@@ -0,0 +1,241 @@
+/***********************************************************************
+ElementStreamBenchmark - Headless program to measure the compression
+ratio, accuracy, and encoding and decoding throughput of the element
+stream codec on a synthetic indexed triangle mesh, by encoding and
+decoding the mesh in loopback in the same batches an indexed triangle
+set would send across a multicast pipe.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <vector>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+#include <Geometry/Point.h>
+#include <Geometry/Box.h>
+
+#include <Templatized/ElementStreamCodec.h>
+
+/* Types of the benchmark mesh and codec: */
+typedef GLVertex<void,0,void,0,float,float,3> Vertex;
+typedef Visualization::Templatized::ElementStreamCodec<Vertex> Codec;
+typedef Codec::Index Index;
+typedef Geometry::Box<float,3> Box;
+
+struct Batch // Structure describing one batch of vertices and triangles as sent by an indexed triangle set
+	{
+	/* Elements: */
+	public:
+	size_t firstVertex; // Index of the first vertex in the batch
+	size_t numVertices; // Number of vertices in the batch
+	size_t firstTriangle; // Index of the first triangle in the batch
+	size_t numTriangles; // Number of triangles in the batch
+	};
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	int meshSize=512; // Number of vertices around each of the benchmark torus' two circles
+	unsigned int positionBits=16; // Number of bits per quantized position component
+	unsigned int normalBits=12; // Number of bits per quantized normal vector component
+	unsigned int numIterations=10; // Number of times the mesh is encoded and decoded
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"size")==0)
+				{
+				++i;
+				if(i<argc)
+					meshSize=atoi(argv[i]);
+				else
+					std::cerr<<"ElementStreamBenchmark: ignored dangling -size option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"positionBits")==0)
+				{
+				++i;
+				if(i<argc)
+					positionBits=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"ElementStreamBenchmark: ignored dangling -positionBits option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"normalBits")==0)
+				{
+				++i;
+				if(i<argc)
+					normalBits=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"ElementStreamBenchmark: ignored dangling -normalBits option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"iterations")==0)
+				{
+				++i;
+				if(i<argc)
+					numIterations=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"ElementStreamBenchmark: ignored dangling -iterations option"<<std::endl;
+				}
+			else
+				std::cerr<<"ElementStreamBenchmark: ignored unrecognized option "<<argv[i]<<std::endl;
+			}
+		}
+	if(meshSize<3||positionBits==0||positionBits>Codec::maxNumBits||numIterations==0)
+		{
+		std::cerr<<"ElementStreamBenchmark: invalid benchmark parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create a torus mesh inside the domain [-4, 4]^3: */
+	const float pi=Math::Constants<float>::pi;
+	const float majorRadius=3.0f;
+	const float minorRadius=1.0f;
+	std::vector<Vertex> vertices;
+	vertices.reserve(size_t(meshSize)*size_t(meshSize));
+	for(int i=0;i<meshSize;++i)
+		{
+		float u=2.0f*pi*float(i)/float(meshSize);
+		for(int j=0;j<meshSize;++j)
+			{
+			float v=2.0f*pi*float(j)/float(meshSize);
+			Vertex vertex;
+			vertex.normal[0]=Math::cos(u)*Math::cos(v);
+			vertex.normal[1]=Math::sin(u)*Math::cos(v);
+			vertex.normal[2]=Math::sin(v);
+			for(int k=0;k<3;++k)
+				vertex.position[k]=vertex.normal[k]*minorRadius;
+			vertex.position[0]+=Math::cos(u)*majorRadius;
+			vertex.position[1]+=Math::sin(u)*majorRadius;
+			vertices.push_back(vertex);
+			}
+		}
+	std::vector<Index> indices;
+	indices.reserve(size_t(meshSize)*size_t(meshSize)*6);
+	for(int i=0;i<meshSize;++i)
+		for(int j=0;j<meshSize;++j)
+			{
+			Index i00=Index(i*meshSize+j);
+			Index i01=Index(i*meshSize+(j+1)%meshSize);
+			Index i10=Index(((i+1)%meshSize)*meshSize+j);
+			Index i11=Index(((i+1)%meshSize)*meshSize+(j+1)%meshSize);
+			indices.push_back(i00);
+			indices.push_back(i10);
+			indices.push_back(i11);
+			indices.push_back(i00);
+			indices.push_back(i11);
+			indices.push_back(i01);
+			}
+	size_t numTriangles=indices.size()/3;
+	
+	/* Split the mesh into batches of the same size as an indexed triangle set's index chunks, each sending all vertices referenced by the batch that were not sent before: */
+	const size_t batchSize=3333;
+	std::vector<Batch> batches;
+	size_t numSentVertices=0;
+	for(size_t firstTriangle=0;firstTriangle<numTriangles;firstTriangle+=batchSize)
+		{
+		Batch batch;
+		batch.firstVertex=numSentVertices;
+		batch.firstTriangle=firstTriangle;
+		batch.numTriangles=numTriangles-firstTriangle<batchSize?numTriangles-firstTriangle:batchSize;
+		for(size_t i=firstTriangle*3;i<(firstTriangle+batch.numTriangles)*3;++i)
+			if(numSentVertices<=size_t(indices[i]))
+				numSentVertices=size_t(indices[i])+1;
+		batch.numVertices=numSentVertices-batch.firstVertex;
+		batches.push_back(batch);
+		}
+	
+	/* Create the codec: */
+	Codec codec;
+	Box domain(Box::Point(-4.0f,-4.0f,-4.0f),Box::Point(4.0f,4.0f,4.0f));
+	codec.setDomain(domain);
+	codec.setPrecision(positionBits,normalBits);
+	
+	/* Encode the mesh repeatedly: */
+	std::vector<Codec::Buffer> buffers(batches.size());
+	Misc::Timer encodeTimer;
+	for(unsigned int iteration=0;iteration<numIterations;++iteration)
+		for(size_t bi=0;bi<batches.size();++bi)
+			{
+			const Batch& b=batches[bi];
+			buffers[bi].clear();
+			codec.encode(&vertices[b.firstVertex],b.numVertices,&indices[b.firstTriangle*3],b.numTriangles*3,Index(b.firstVertex),buffers[bi]);
+			}
+	encodeTimer.elapse();
+	
+	/* Decode the mesh repeatedly: */
+	std::vector<Vertex> decodedVertices(vertices.size());
+	std::vector<Index> decodedIndices(indices.size());
+	Misc::Timer decodeTimer;
+	for(unsigned int iteration=0;iteration<numIterations;++iteration)
+		for(size_t bi=0;bi<batches.size();++bi)
+			{
+			const Batch& b=batches[bi];
+			codec.decode(&buffers[bi][0],&decodedVertices[b.firstVertex],b.numVertices,&decodedIndices[b.firstTriangle*3],b.numTriangles*3,Index(b.firstVertex));
+			}
+	decodeTimer.elapse();
+	
+	/* Calculate the number of sent bytes, including the batch headers written by an indexed triangle set: */
+	size_t rawSize=batches.size()*3*sizeof(unsigned int)+vertices.size()*sizeof(Vertex)+indices.size()*sizeof(Index);
+	size_t encodedSize=batches.size()*3*sizeof(unsigned int);
+	for(size_t bi=0;bi<buffers.size();++bi)
+		encodedSize+=buffers[bi].size();
+	
+	/* Calculate the decoding errors: */
+	size_t numIndexErrors=0;
+	for(size_t i=0;i<indices.size();++i)
+		if(decodedIndices[i]!=indices[i])
+			++numIndexErrors;
+	double maxPositionError=0.0;
+	double minNormalCos=1.0;
+	for(size_t i=0;i<vertices.size();++i)
+		{
+		double dist2=0.0;
+		double dot=0.0;
+		for(int j=0;j<3;++j)
+			{
+			dist2+=Math::sqr(double(decodedVertices[i].position[j])-double(vertices[i].position[j]));
+			dot+=double(decodedVertices[i].normal[j])*double(vertices[i].normal[j]);
+			}
+		if(maxPositionError<dist2)
+			maxPositionError=dist2;
+		if(minNormalCos>dot)
+			minNormalCos=dot;
+		}
+	maxPositionError=Math::sqrt(maxPositionError);
+	double maxNormalAngle=minNormalCos<1.0?Math::deg(Math::acos(minNormalCos)):0.0;
+	
+	/* Print the results: */
+	double encodeTime=encodeTimer.getTime();
+	double decodeTime=decodeTimer.getTime();
+	double numProcessed=double(vertices.size())*double(numIterations);
+	double rawMegabytes=double(rawSize)*double(numIterations)/(1024.0*1024.0);
+	std::cout<<"Mesh size          : "<<vertices.size()<<" vertices, "<<numTriangles<<" triangles in "<<batches.size()<<" batches"<<std::endl;
+	std::cout<<"Precision          : "<<codec.getPositionBits()<<" position bits, "<<codec.getNormalBits()<<" normal bits"<<std::endl;
+	std::cout<<"Uncompressed bytes : "<<rawSize<<std::endl;
+	std::cout<<"Compressed bytes   : "<<encodedSize<<" ("<<double(rawSize)/double(encodedSize)<<":1)"<<std::endl;
+	std::cout<<"Encoding           : "<<encodeTime*1000.0/double(numIterations)<<" ms per mesh, "<<numProcessed/encodeTime<<" vertices/s, "<<rawMegabytes/encodeTime<<" MB/s"<<std::endl;
+	std::cout<<"Decoding           : "<<decodeTime*1000.0/double(numIterations)<<" ms per mesh, "<<numProcessed/decodeTime<<" vertices/s, "<<rawMegabytes/decodeTime<<" MB/s"<<std::endl;
+	std::cout<<"Max position error : "<<maxPositionError<<std::endl;
+	std::cout<<"Max normal error   : "<<maxNormalAngle<<" degrees"<<std::endl;
+	std::cout<<"Index errors       : "<<numIndexErrors<<std::endl;
+	
+	return numIndexErrors==0?0:1;
+	}
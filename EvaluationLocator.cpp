@@ -171,3 +171,13 @@ void EvaluationLocator::highlightLocator(GLContextData& contextData) const
 	if(locator->isValid())
 		application->dataSetRenderer->highlightLocator(locator,contextData);
 	}
+
+void EvaluationLocator::dataSetChanged(void)
+	{
+	/* Replace the locator with one for the new data set at the same position: */
+	Locator* newLocator=application->dataSet->getLocator();
+	newLocator->setPosition(locator->getPosition());
+	newLocator->setOrientation(locator->getOrientation());
+	delete locator;
+	locator=newLocator;
+	}
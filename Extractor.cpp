@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "Extractor.h"
 
+#include <iostream>
 #include <Misc/Time.h>
 #include <Realtime/AlarmTimer.h>
 #include <Comm/MulticastPipe.h>
@@ -49,6 +50,7 @@ void* Extractor::masterExtractorThreadMethod(void)
 		/* Wait until there is a seed request: */
 		Parameters* parameters;
 		unsigned int requestID;
+		Misc::Timer extractionTimer;
 		{
 		Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
 		#ifdef __DARWIN__
@@ -69,8 +71,9 @@ void* Extractor::masterExtractorThreadMethod(void)
 		parameters=seedParameters;
 		seedParameters=0;
 		
-		/* Grab the seed request ID: */
+		/* Grab the seed request ID and the time at which it was posted: */
 		requestID=seedRequestID;
+		extractionTimer=seedRequestTimer;
 		}
 		
 		/* Get the next free visualization element: */
@@ -98,12 +101,17 @@ void* Extractor::masterExtractorThreadMethod(void)
 				trackedElementIDs[nextIndex]=requestID;
 				
 				/* Continue extracting the visualization element until it is done: */
+				bool complete;
 				bool keepGrowing;
+				double firstGeometryTime=-1.0;
 				do
 					{
 					/* Grow the visualization element by a little bit: */
 					alarm.armTimer(expirationTime);
-					keepGrowing=!extractor->continueElement(alarm);
+					complete=extractor->continueElement(alarm);
+					keepGrowing=!complete;
+					if(firstGeometryTime<0.0)
+						firstGeometryTime=extractionTimer.peekTime();
 					
 					/* Push this visualization element to the main thread: */
 					mostRecentIndex=nextIndex;
@@ -127,17 +135,96 @@ void* Extractor::masterExtractorThreadMethod(void)
 				
 				/* Finish the element: */
 				extractor->finishElement();
+				if(complete)
+					extractor->setGeometryTimes(firstGeometryTime,extractionTimer.peekTime());
+				
+				if(extractor->extractsLocally())
+					{
+					/* Tell the slave nodes whether the visualization element was completed, and send its checksum if so: */
+					extractor->getPipe()->write<unsigned int>(complete?1:0);
+					if(complete)
+						extractor->getPipe()->write<unsigned int>(trackedElements[nextIndex]->calcChecksum());
+					extractor->getPipe()->finishMessage();
+					}
 				}
 			else
 				{
+				/* Extract and deliver the previews, each one replacing the previous one, until there is another seed request: */
+				unsigned int numPreviewStages=extractor->getNumPreviewStages();
+				bool superseded=false;
+				double firstGeometryTime=0.0;
+				for(unsigned int stage=0;stage<numPreviewStages&&!superseded;++stage)
+					{
+					/* Always deliver the first preview, but skip the remaining ones if there is another seed request: */
+					if(stage>0)
+						{
+						Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
+						superseded=seedParameters!=0;
+						}
+					
+					if(!superseded)
+						{
+						if(extractor->getPipe()!=0)
+							{
+							/* Tell the slave nodes that another preview is coming: */
+							extractor->getPipe()->write<unsigned int>(1);
+							extractor->getPipe()->finishMessage();
+							}
+						
+						/* Previews are never returned as finished visualization elements: */
+						trackedElements[nextIndex]=extractor->createPreviewElement(parameters->clone(),stage);
+						trackedElementIDs[nextIndex]=0;
+						if(stage==0)
+							firstGeometryTime=extractionTimer.peekTime();
+						
+						/* Push the preview to the main thread: */
+						mostRecentIndex=nextIndex;
+						update();
+						
+						/* Get the next free visualization element: */
+						nextIndex=(lockedIndex+1)%3;
+						if(nextIndex==mostRecentIndex)
+							nextIndex=(nextIndex+1)%3;
+						}
+					}
+				
+				if(numPreviewStages>0&&!superseded)
+					{
+					/* Skip the visualization element as well if there is another seed request: */
+					Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
+					superseded=seedParameters!=0;
+					}
+				
+				if(extractor->getPipe()!=0)
+					{
+					/* Tell the slave nodes that no more previews are coming, and whether the visualization element is coming: */
+					extractor->getPipe()->write<unsigned int>(0);
+					extractor->getPipe()->write<unsigned int>(superseded?0:1);
+					extractor->getPipe()->finishMessage();
+					}
+				
+				if(superseded)
+					{
+					/* Abandon the request; the most recent preview stays visible until the next request delivers geometry: */
+					delete parameters;
+					continue;
+					}
+				
 				/* Extract the visualization element: */
 				trackedElements[nextIndex]=extractor->createElement(parameters);
 				trackedElementIDs[nextIndex]=requestID;
+				double finalGeometryTime=extractionTimer.peekTime();
+				extractor->setGeometryTimes(numPreviewStages>0?firstGeometryTime:finalGeometryTime,finalGeometryTime);
 				
 				if(extractor->getPipe()!=0)
 					{
 					/* Tell the slave nodes that the current visualization element is finished: */
 					extractor->getPipe()->write<unsigned int>(0);
+					if(extractor->extractsLocally())
+						{
+						/* Send the visualization element's checksum: */
+						extractor->getPipe()->write<unsigned int>(trackedElements[nextIndex]->calcChecksum());
+						}
 					extractor->getPipe()->finishMessage();
 					}
 				
@@ -176,6 +263,8 @@ void* Extractor::slaveExtractorThreadMethod(void)
 	Threads::Thread::setCancelType(Threads::Thread::CANCEL_ASYNCHRONOUS);
 	
 	/* Receive visualization elements from master until interrupted: */
+	Realtime::AlarmTimer alarm;
+	Misc::Time expirationTime(0.1);
 	while(true)
 		{
 		/* Wait for a new visualization element: */
@@ -200,20 +289,113 @@ void* Extractor::slaveExtractorThreadMethod(void)
 			Parameters* parameters=extractor->cloneParameters();
 			parameters->read(*extractor->getPipe(),extractor->getVariableManager());
 			
-			/* Start receiving the visualization element from the master: */
-			trackedElements[nextIndex]=extractor->startSlaveElement(parameters);
-			trackedElementIDs[nextIndex]=requestID;
+			if(!extractor->hasIncrementalCreator())
+				{
+				/* Receive or extract the previews that precede the visualization element until the master stops: */
+				for(unsigned int stage=0;extractor->getPipe()->read<unsigned int>()!=0;++stage)
+					{
+					if(extractor->extractsLocally())
+						trackedElements[nextIndex]=extractor->createPreviewElement(parameters->clone(),stage);
+					else
+						trackedElements[nextIndex]=extractor->startSlaveElement(parameters->clone());
+					trackedElementIDs[nextIndex]=0;
+					
+					/* Push the preview to the main thread: */
+					mostRecentIndex=nextIndex;
+					update();
+					
+					/* Get the next free visualization element: */
+					nextIndex=(lockedIndex+1)%3;
+					if(nextIndex==mostRecentIndex)
+						nextIndex=(nextIndex+1)%3;
+					}
+				
+				/* Check whether the master abandoned the request because there was another seed request: */
+				if(extractor->getPipe()->read<unsigned int>()==0)
+					{
+					delete parameters;
+					continue;
+					}
+				}
 			
-			/* Receive fragments of the visualization element until finished: */
-			do
+			if(extractor->extractsLocally()&&extractor->hasIncrementalCreator())
+				{
+				/* Start extracting the visualization element locally: */
+				trackedElements[nextIndex]=extractor->startElement(parameters);
+				trackedElementIDs[nextIndex]=requestID;
+				
+				/* Grow the visualization element in lockstep with the master until the master stops: */
+				bool complete=false;
+				while(extractor->getPipe()->read<unsigned int>()!=0)
+					{
+					if(!complete)
+						{
+						/* Grow the visualization element by a little bit: */
+						alarm.armTimer(expirationTime);
+						complete=extractor->continueElement(alarm);
+						}
+					
+					/* Push this visualization element to the main thread: */
+					mostRecentIndex=nextIndex;
+					update();
+					}
+				
+				/* Check whether the master completed the visualization element or was interrupted by another seed request: */
+				bool masterComplete=extractor->getPipe()->read<unsigned int>()!=0;
+				if(masterComplete)
+					{
+					/* Complete the visualization element as well: */
+					while(!complete)
+						{
+						alarm.armTimer(expirationTime);
+						complete=extractor->continueElement(alarm);
+						}
+					}
+				
+				/* Finish the element: */
+				extractor->finishElement();
+				
+				/* Push this visualization element to the main thread: */
+				mostRecentIndex=nextIndex;
+				update();
+				
+				if(masterComplete)
+					{
+					/* Check the visualization element against the master's: */
+					checkLocalElement(trackedElements[nextIndex].getPointer(),requestID);
+					}
+				}
+			else if(extractor->extractsLocally())
 				{
-				extractor->continueSlaveElement();
+				/* Extract the visualization element locally: */
+				trackedElements[nextIndex]=extractor->createElement(parameters);
+				trackedElementIDs[nextIndex]=requestID;
+				
+				/* Check the visualization element against the master's: */
+				extractor->getPipe()->read<unsigned int>();
+				checkLocalElement(trackedElements[nextIndex].getPointer(),requestID);
 				
 				/* Push this visualization element to the main thread: */
 				mostRecentIndex=nextIndex;
 				update();
 				}
-			while(extractor->getPipe()->read<unsigned int>()!=0);
+			else
+				{
+				/* Start receiving the visualization element from the master: */
+				trackedElements[nextIndex]=extractor->startSlaveElement(parameters);
+				trackedElementIDs[nextIndex]=requestID;
+				
+				/* Receive fragments of the visualization element until finished: */
+				do
+					{
+					extractor->continueSlaveElement();
+					
+					/* Push this visualization element to the main thread: */
+					mostRecentIndex=nextIndex;
+					update();
+					}
+				while(extractor->getPipe()->read<unsigned int>()!=0);
+				}
 			}
 		else
 			{
@@ -233,6 +415,17 @@ void* Extractor::slaveExtractorThreadMethod(void)
 	return 0;
 	}
 
+void Extractor::checkLocalElement(const Extractor::Element* element,unsigned int requestID)
+	{
+	/* Receive the master's checksum: */
+	unsigned int masterChecksum=extractor->getPipe()->read<unsigned int>();
+	
+	/* Compare it to the locally extracted visualization element: */
+	unsigned int checksum=element!=0?element->calcChecksum():0;
+	if(checksum!=masterChecksum)
+		std::cerr<<"Extractor: "<<extractor->getName()<<" element for seed request "<<requestID<<" diverges from master node's element (checksum "<<checksum<<" instead of "<<masterChecksum<<")"<<std::endl;
+	}
+
 Extractor::Extractor(Extractor::Algorithm* sExtractor)
 	:extractor(sExtractor),
 	 #ifdef __DARWIN__
@@ -305,6 +498,7 @@ void Extractor::seedRequest(unsigned int newSeedRequestID,Extractor::Parameters*
 	delete seedParameters;
 	seedParameters=newSeedParameters;
 	seedRequestID=newSeedRequestID;
+	seedRequestTimer.elapse();
 	seedRequestCond.signal();
 	}
 
@@ -321,11 +515,15 @@ Extractor::ElementPointer Extractor::checkUpdates(void)
 		{
 		/* Delete the previously locked visualization element: */
 		trackedElements[lockedIndex]=0;
-
+		
 		/* Lock the most recent visualization element: */
 		lockedIndex=mostRecentIndex;
 		}
 	
+	/* Update the tracked visualization element: */
+	if(trackedElements[lockedIndex]!=0)
+		trackedElements[lockedIndex]->frame();
+	
 	/* Check if the final element from a concluded dragging operation or an immediate extraction has arrived: */
 	ElementPointer result=0;
 	if(finalElementPending&&trackedElementIDs[lockedIndex]==finalSeedRequestID)
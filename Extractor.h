@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define EXTRACTOR_INCLUDED
 
 #include <Misc/Autopointer.h>
+#include <Misc/Timer.h>
 #include <Threads/Mutex.h>
 #include <Threads/Cond.h>
 #include <Threads/Thread.h>
@@ -69,6 +70,7 @@ class Extractor
 	Threads::Cond seedRequestCond; // Condition variable for the extractor thread to block on
 	Parameters* volatile seedParameters; // Extraction parameters for the most recently requested visualization element
 	volatile unsigned int seedRequestID; // ID of current seed request
+	Misc::Timer seedRequestTimer; // Timer restarted whenever a seed request is posted, to measure the time until the request's geometry is available
 	
 	/* Extractor thread communication output: */
 	volatile int lockedIndex; // Index of locked element
@@ -80,6 +82,7 @@ class Extractor
 	private:
 	void* masterExtractorThreadMethod(void); // The extractor thread method for single computers or masters in a cluster environment
 	void* slaveExtractorThreadMethod(void); // The extractor thread method for slaves in a cluster environment
+	void checkLocalElement(const Element* element,unsigned int requestID); // Compares the checksum of a locally extracted visualization element on a slave node to the checksum sent by the master
 	
 	/* Constructors and destructors: */
 	public:
@@ -264,6 +264,16 @@ void ExtractorLocator::glRenderActionTransparent(GLContextData& contextData) con
 	draw(contextData,true);
 	}
 
+void ExtractorLocator::dataSetChanged(void)
+	{
+	/* Replace the locator with one for the new data set at the same position; the algorithm picks up the new data set from the variable manager: */
+	Locator* newLocator=application->dataSet->getLocator();
+	newLocator->setPosition(locator->getPosition());
+	newLocator->setOrientation(locator->getOrientation());
+	delete locator;
+	locator=newLocator;
+	}
+
 void ExtractorLocator::update(void)
 	{
 	Vrui::requestUpdate();
@@ -69,6 +69,7 @@ class ExtractorLocator:public BaseLocator,public Extractor
 	virtual void highlightLocator(GLContextData& contextData) const;
 	virtual void glRenderAction(GLContextData& contextData) const;
 	virtual void glRenderActionTransparent(GLContextData& contextData) const;
+	virtual void dataSetChanged(void);
 	
 	/* Methods from Extractor: */
 	virtual void update(void);
@@ -0,0 +1,294 @@
+/***********************************************************************
+LocatorBenchmark - Headless program to measure the cell box hierarchy
+construction time, memory size, and point location work of curvilinear
+data sets, and the cost of evaluating arrow rakes, on an analytically
+distorted grid.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+#include <Geometry/ValuedPoint.h>
+
+#include <Templatized/CellBoxTree.h>
+#include <Templatized/Curvilinear.h>
+#include <Templatized/VectorExtractor.h>
+#include <Templatized/VectorScalarExtractor.h>
+
+/* Types of the benchmark data set, its value extractors, and its cell box hierarchy: */
+typedef Geometry::Vector<float,3> Value;
+typedef Visualization::Templatized::Curvilinear<double,3,Value> DS;
+typedef Visualization::Templatized::VectorExtractor<Value,Value> VE;
+typedef Visualization::Templatized::ScalarExtractor<float,Value> SE;
+typedef Visualization::Templatized::CellBoxTree<DS::Scalar,DS::dimension,DS::CellID> BoxTree;
+typedef Geometry::ValuedPoint<DS::Point,DS::CellID> CellCenter; // Type of the cell center kd-tree entries replaced by the cell box hierarchy
+
+double randUniform(double min,double max) // Returns a uniformly distributed random number in [min, max)
+	{
+	return min+(max-min)*double(rand())/(double(RAND_MAX)+1.0);
+	}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	int gridSize=64; // Number of vertices along each axis of the benchmark grid
+	double distortion=0.5; // Amplitude of the grid distortion in units of the undistorted cell size
+	size_t numPoints=100000; // Number of located query points
+	unsigned int numSteps=100; // Number of traced steps per query point
+	unsigned int maxNumThreads=4; // Maximum number of hierarchy construction threads
+	int rakeSize=256; // Number of arrows along each axis of the evaluated arrow rake
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"size")==0)
+				{
+				++i;
+				if(i<argc)
+					gridSize=atoi(argv[i]);
+				else
+					std::cerr<<"LocatorBenchmark: ignored dangling -size option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"distortion")==0)
+				{
+				++i;
+				if(i<argc)
+					distortion=atof(argv[i]);
+				else
+					std::cerr<<"LocatorBenchmark: ignored dangling -distortion option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"points")==0)
+				{
+				++i;
+				if(i<argc)
+					numPoints=size_t(atol(argv[i]));
+				else
+					std::cerr<<"LocatorBenchmark: ignored dangling -points option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"steps")==0)
+				{
+				++i;
+				if(i<argc)
+					numSteps=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"LocatorBenchmark: ignored dangling -steps option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"rakeSize")==0)
+				{
+				++i;
+				if(i<argc)
+					rakeSize=atoi(argv[i]);
+				else
+					std::cerr<<"LocatorBenchmark: ignored dangling -rakeSize option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"threads")==0)
+				{
+				++i;
+				if(i<argc)
+					maxNumThreads=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"LocatorBenchmark: ignored dangling -threads option"<<std::endl;
+				}
+			else
+				std::cerr<<"LocatorBenchmark: ignored unrecognized option "<<argv[i]<<std::endl;
+			}
+		}
+	if(gridSize<2||numPoints==0||maxNumThreads==0||rakeSize<1)
+		{
+		std::cerr<<"LocatorBenchmark: invalid benchmark parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create a curvilinear grid spanning [0, 2*pi]^3 whose vertices are displaced by a smooth sinusoidal field: */
+	DS::Index numVertices(gridSize,gridSize,gridSize);
+	DS ds(numVertices);
+	double cellSize=2.0*Math::Constants<double>::pi/double(gridSize-1);
+	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		double p[3];
+		for(int i=0;i<3;++i)
+			p[i]=double(index[i])*cellSize;
+		DS::Point& pos=ds.getVertexPosition(index);
+		pos[0]=p[0]+distortion*cellSize*Math::sin(p[1]*2.0)*Math::sin(p[2]);
+		pos[1]=p[1]+distortion*cellSize*Math::sin(p[2]*2.0)*Math::sin(p[0]);
+		pos[2]=p[2]+distortion*cellSize*Math::sin(p[0]*2.0)*Math::sin(p[1]);
+		Value& v=ds.getVertexValue(index);
+		v[0]=float(Math::sin(p[2])+Math::cos(p[1]));
+		v[1]=float(Math::sin(p[0])+Math::cos(p[2]));
+		v[2]=float(Math::sin(p[1])+Math::cos(p[0]));
+		}
+	Misc::Timer finalizeTimer;
+	ds.finalizeGrid();
+	finalizeTimer.elapse();
+	
+	/* Print the sizes of the cell box hierarchy and of the cell center kd-tree it replaced: */
+	std::cout<<"Grid size          : "<<gridSize<<"^3 vertices, "<<ds.getTotalNumCells()<<" cells"<<std::endl;
+	std::cout<<"Grid finalization  : "<<finalizeTimer.getTime()*1000.0<<" ms"<<std::endl;
+	std::cout<<"Cell box hierarchy : "<<double(ds.getLocatorMemorySize())/(1024.0*1024.0)<<" MB"<<std::endl;
+	std::cout<<"Cell center kd-tree: "<<double(ds.getTotalNumCells()*sizeof(CellCenter))/(1024.0*1024.0)<<" MB"<<std::endl;
+	
+	/* Measure the hierarchy construction time on increasing numbers of threads: */
+	std::vector<BoxTree::CellBox> cellBoxes;
+	cellBoxes.reserve(ds.getTotalNumCells());
+	for(DS::CellIterator cIt=ds.beginCells();cIt!=ds.endCells();++cIt)
+		{
+		BoxTree::CellBox cb;
+		cb.box=BoxTree::Box::empty;
+		for(int i=0;i<DS::CellTopology::numVertices;++i)
+			cb.box.addPoint(cIt->getVertexPosition(i));
+		cb.cellID=cIt->getID();
+		cellBoxes.push_back(cb);
+		}
+	double singleThreadTime=0.0;
+	for(unsigned int numThreads=1;;numThreads*=2)
+		{
+		if(numThreads>maxNumThreads)
+			numThreads=maxNumThreads;
+		
+		/* Create a hierarchy from scratch: */
+		BoxTree tree;
+		BoxTree::CellBox* cbPtr=tree.createTree(cellBoxes.size());
+		std::copy(cellBoxes.begin(),cellBoxes.end(),cbPtr);
+		Misc::Timer buildTimer;
+		tree.releaseBoxes(numThreads);
+		buildTimer.elapse();
+		
+		double time=buildTimer.getTime();
+		if(numThreads==1)
+			singleThreadTime=time;
+		std::cout<<"Hierarchy creation : "<<time*1000.0<<" ms on "<<numThreads<<(numThreads==1?" thread":" threads");
+		if(numThreads>1)
+			std::cout<<", speed-up "<<singleThreadTime/time;
+		std::cout<<std::endl;
+		
+		if(numThreads==maxNumThreads)
+			break;
+		}
+	
+	/* Locate random query points from scratch, and trace short random walks from each of them: */
+	DS::Locator locator=ds.getLocator();
+	const DS::Box& domain=ds.getDomainBox();
+	size_t numFound=0;
+	size_t numTraced=0;
+	double locateTime=0.0;
+	double traceTime=0.0;
+	srand(1);
+	for(size_t point=0;point<numPoints;++point)
+		{
+		DS::Point p;
+		for(int i=0;i<3;++i)
+			p[i]=randUniform(domain.min[i],domain.max[i]);
+		Misc::Timer locateTimer;
+		bool found=locator.locatePoint(p,false);
+		locateTimer.elapse();
+		locateTime+=locateTimer.getTime();
+		if(!found)
+			continue;
+		++numFound;
+		
+		DS::Vector step;
+		for(int i=0;i<3;++i)
+			step[i]=randUniform(-0.25,0.25)*cellSize;
+		Misc::Timer traceTimer;
+		for(unsigned int i=0;i<numSteps;++i)
+			{
+			p+=step;
+			if(!locator.locatePoint(p,true))
+				break;
+			++numTraced;
+			}
+		traceTimer.elapse();
+		traceTime+=traceTimer.getTime();
+		}
+	
+	/* Print the results: */
+	std::cout<<"Located points     : "<<numFound<<" of "<<numPoints<<" in "<<locateTime*1000.0<<" ms ("<<locateTime*1.0e6/double(numPoints)<<" us per point)"<<std::endl;
+	std::cout<<"Traced points      : "<<numTraced<<" in "<<traceTime*1000.0<<" ms ("<<(numTraced>0?traceTime*1.0e6/double(numTraced):0.0)<<" us per point)"<<std::endl;
+	#ifdef PERF_COUNTLOCATORSTEPS
+	const Visualization::Templatized::LocatorStepCounters& counters=locator.getStepCounters();
+	std::cout<<"Searches           : "<<counters.numSearches<<" ("<<counters.numRestarts<<" restarts after tracing failures)"<<std::endl;
+	std::cout<<"Candidate cells    : "<<counters.numCandidates<<" ("<<double(counters.numCandidates)/double(counters.numSearches>0?counters.numSearches:1)<<" per search)"<<std::endl;
+	std::cout<<"Tracing steps      : "<<counters.numSteps<<" ("<<double(counters.numSteps)/double(numTraced>0?numTraced:1)<<" per traced point)"<<std::endl;
+	#endif
+	
+	/* Create an arrow rake of base points in a plane through the domain's center, in rake order: */
+	size_t numArrows=size_t(rakeSize)*size_t(rakeSize);
+	std::vector<DS::Point> bases;
+	bases.reserve(numArrows);
+	for(int y=0;y<rakeSize;++y)
+		for(int x=0;x<rakeSize;++x)
+			{
+			DS::Point b=Geometry::mid(domain.min,domain.max);
+			b[0]=domain.min[0]+(domain.max[0]-domain.min[0])*(double(x)+0.5)/double(rakeSize);
+			b[1]=domain.min[1]+(domain.max[1]-domain.min[1])*(double(y)+0.5)/double(rakeSize);
+			bases.push_back(b);
+			}
+	std::vector<VE::DestValue> directions(numArrows);
+	std::vector<SE::DestValue> scalarValues(numArrows);
+	bool* valids=new bool[numArrows];
+	VE ve;
+	SE se;
+	
+	/* Evaluate the rake by locating each arrow from scratch and evaluating both variables: */
+	DS::Locator pointLocator=ds.getLocator();
+	Misc::Timer pointTimer;
+	for(size_t i=0;i<numArrows;++i)
+		if((valids[i]=pointLocator.locatePoint(bases[i],false)))
+			{
+			directions[i]=pointLocator.calcValue(ve);
+			scalarValues[i]=pointLocator.calcValue(se);
+			}
+	pointTimer.elapse();
+	
+	/* Evaluate the rake in two batches, one per variable: */
+	DS::Locator twoBatchLocator=ds.getLocator();
+	Misc::Timer twoBatchTimer;
+	twoBatchLocator.calcValues(numArrows,&bases[0],false,ve,&directions[0],valids);
+	twoBatchLocator.calcValues(numArrows,&bases[0],false,se,&scalarValues[0],valids);
+	twoBatchTimer.elapse();
+	
+	/* Evaluate the rake in one batch locating each arrow once: */
+	DS::Locator batchLocator=ds.getLocator();
+	Misc::Timer batchTimer;
+	size_t numValidArrows=batchLocator.calcValues(numArrows,&bases[0],false,ve,&directions[0],se,&scalarValues[0],valids);
+	batchTimer.elapse();
+	
+	delete[] valids;
+	
+	/* Print the results: */
+	std::cout<<"Arrow rake         : "<<rakeSize<<"^2 arrows, "<<numValidArrows<<" inside the domain"<<std::endl;
+	std::cout<<"Per-arrow locate   : "<<pointTimer.getTime()*1000.0<<" ms"<<std::endl;
+	std::cout<<"Two batches        : "<<twoBatchTimer.getTime()*1000.0<<" ms"<<std::endl;
+	std::cout<<"Combined batch     : "<<batchTimer.getTime()*1000.0<<" ms"<<std::endl;
+	#ifdef PERF_COUNTLOCATORSTEPS
+	std::cout<<"Per-arrow searches : "<<pointLocator.getStepCounters().numSearches<<" searches, "<<pointLocator.getStepCounters().numSteps<<" tracing steps"<<std::endl;
+	std::cout<<"Two batch searches : "<<twoBatchLocator.getStepCounters().numSearches<<" searches, "<<twoBatchLocator.getStepCounters().numSteps<<" tracing steps"<<std::endl;
+	std::cout<<"Batch searches     : "<<batchLocator.getStepCounters().numSearches<<" searches, "<<batchLocator.getStepCounters().numSteps<<" tracing steps"<<std::endl;
+	#endif
+	
+	return 0;
+	}
@@ -0,0 +1,446 @@
+/***********************************************************************
+MacroCellGrid - Class to partition a voxel block into coarse macro cells
+storing the range of voxel values inside each cell, to classify macro
+cells as empty or occupied under a set of color maps so that raycasters
+can skip empty regions.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <MacroCellGrid.h>
+
+#include <Math/Math.h>
+#include <Math/Constants.h>
+#include <Threads/Thread.h>
+
+/******************************
+Methods of class MacroCellGrid:
+******************************/
+
+void MacroCellGrid::processSlabs(void* (MacroCellGrid::*threadMethod)(MacroCellGrid::Slab*),unsigned int firstLayer,unsigned int lastLayer,bool& changed)
+	{
+	/* Split the layer range into one slab per thread: */
+	unsigned int numLayers=lastLayer-firstLayer;
+	unsigned int numSlabs=numThreads<numLayers?numThreads:numLayers;
+	if(numSlabs==0)
+		return;
+	Slab* slabs=new Slab[numSlabs];
+	for(unsigned int i=0;i<numSlabs;++i)
+		{
+		slabs[i].firstLayer=firstLayer+(numLayers*i)/numSlabs;
+		slabs[i].lastLayer=firstLayer+(numLayers*(i+1))/numSlabs;
+		slabs[i].changed=false;
+		}
+	
+	/* Process the first slab on the current thread and all other slabs on worker threads: */
+	Threads::Thread* workerThreads=numSlabs>1?new Threads::Thread[numSlabs-1]:0;
+	for(unsigned int i=1;i<numSlabs;++i)
+		workerThreads[i-1].start(this,threadMethod,&slabs[i]);
+	(this->*threadMethod)(&slabs[0]);
+	for(unsigned int i=1;i<numSlabs;++i)
+		workerThreads[i-1].join();
+	delete[] workerThreads;
+	
+	for(unsigned int i=0;i<numSlabs;++i)
+		if(slabs[i].changed)
+			changed=true;
+	delete[] slabs;
+	}
+
+void* MacroCellGrid::updateRangesThreadMethod(MacroCellGrid::Slab* slab)
+	{
+	/* Calculate the range of macro cells overlapping the block in x and y: */
+	unsigned int cellMin[2],cellMax[2];
+	for(int i=0;i<2;++i)
+		{
+		cellMin[i]=blockOrigin[i]>0?(blockOrigin[i]-1)/cellSize:0;
+		cellMax[i]=(blockOrigin[i]+blockSize[i]-1)/cellSize+1;
+		if(cellMax[i]>numCells[i])
+			cellMax[i]=numCells[i];
+		}
+	
+	unsigned int cellIndex[3];
+	for(cellIndex[2]=slab->firstLayer;cellIndex[2]<slab->lastLayer;++cellIndex[2])
+		for(cellIndex[1]=cellMin[1];cellIndex[1]<cellMax[1];++cellIndex[1])
+			for(cellIndex[0]=cellMin[0];cellIndex[0]<cellMax[0];++cellIndex[0])
+				{
+				/* Intersect the macro cell's voxels with the block: */
+				unsigned int first[3],last[3];
+				bool overlaps=true;
+				for(int i=0;i<3;++i)
+					{
+					getCellVoxels(cellIndex[i],i,first[i],last[i]);
+					if(first[i]<blockOrigin[i])
+						first[i]=blockOrigin[i];
+					if(last[i]>blockOrigin[i]+blockSize[i]-1)
+						last[i]=blockOrigin[i]+blockSize[i]-1;
+					if(first[i]>last[i])
+						overlaps=false;
+					}
+				if(!overlaps)
+					continue;
+				
+				/* Merge the voxel values into the macro cell's value range: */
+				Voxel* range=cellRanges+(((size_t(cellIndex[2])*size_t(numCells[1])+size_t(cellIndex[1]))*size_t(numCells[0])+size_t(cellIndex[0]))*numChannels+blockChannel)*2;
+				Voxel min=range[0];
+				Voxel max=range[1];
+				const Voxel* vPtr2=blockVoxels+ptrdiff_t(first[2]-blockOrigin[2])*blockStrides[2];
+				for(unsigned int z=first[2];z<=last[2];++z,vPtr2+=blockStrides[2])
+					{
+					const Voxel* vPtr1=vPtr2+ptrdiff_t(first[1]-blockOrigin[1])*blockStrides[1];
+					for(unsigned int y=first[1];y<=last[1];++y,vPtr1+=blockStrides[1])
+						{
+						const Voxel* vPtr0=vPtr1+ptrdiff_t(first[0]-blockOrigin[0])*blockStrides[0];
+						for(unsigned int x=first[0];x<=last[0];++x,vPtr0+=blockStrides[0])
+							{
+							if(min>*vPtr0)
+								min=*vPtr0;
+							if(max<*vPtr0)
+								max=*vPtr0;
+							}
+						}
+					}
+				range[0]=min;
+				range[1]=max;
+				}
+	
+	return 0;
+	}
+
+void* MacroCellGrid::classifyThreadMethod(MacroCellGrid::Slab* slab)
+	{
+	size_t cellLinearIndex=size_t(slab->firstLayer)*size_t(numCells[1])*size_t(numCells[0]);
+	const Voxel* range=cellRanges+cellLinearIndex*numChannels*2;
+	Voxel* occPtr=occupancy+cellLinearIndex;
+	size_t numSlabCells=size_t(slab->lastLayer-slab->firstLayer)*size_t(numCells[1])*size_t(numCells[0]);
+	for(size_t i=0;i<numSlabCells;++i,range+=numChannels*2,++occPtr)
+		{
+		bool affected=!classified;
+		bool occupied=false;
+		for(int channel=0;channel<numChannels;++channel)
+			{
+			/* Skip channels that never received any voxels: */
+			if(range[channel*2+0]>range[channel*2+1])
+				continue;
+			
+			/* Widen the value range by one color map entry to account for linear interpolation in the color map: */
+			int lo=int(range[channel*2+0])-1;
+			if(lo<0)
+				lo=0;
+			int hi=int(range[channel*2+1])+1;
+			if(hi>255)
+				hi=255;
+			
+			if(changeMins[channel]<=hi&&changeMaxs[channel]>=lo)
+				affected=true;
+			const unsigned int* counts=opaqueCounts+channel*257;
+			if(counts[hi+1]!=counts[lo])
+				occupied=true;
+			}
+		
+		if(affected)
+			{
+			Voxel newOcc=occupied?Voxel(255):Voxel(0);
+			if(*occPtr!=newOcc)
+				{
+				*occPtr=newOcc;
+				slab->changed=true;
+				}
+			}
+		}
+	
+	return 0;
+	}
+
+MacroCellGrid::MacroCellGrid(const unsigned int sDataSize[3],int sNumChannels,unsigned int sCellSize)
+	:numChannels(sNumChannels),cellSize(sCellSize),
+	 totalNumCells(1),
+	 numThreads(1),
+	 cellRanges(0),
+	 classified(false),
+	 opaques(new bool[numChannels*256]),opaqueCounts(new unsigned int[numChannels*257]),
+	 changeMins(new int[numChannels]),changeMaxs(new int[numChannels]),
+	 occupancy(0),occupancyVersion(0),
+	 blockChannel(0),blockVoxels(0),blockStrides(0)
+	{
+	/* Calculate the number of macro cells: */
+	for(int i=0;i<3;++i)
+		{
+		dataSize[i]=sDataSize[i];
+		numCells[i]=dataSize[i]>1?(dataSize[i]-2)/cellSize+1:1;
+		totalNumCells*=size_t(numCells[i]);
+		}
+	
+	/* Initialize the value ranges and the occupancy array: */
+	cellRanges=new Voxel[totalNumCells*numChannels*2];
+	occupancy=new Voxel[totalNumCells];
+	resetRanges();
+	
+	/* Initialize the opacity tables: */
+	for(int i=0;i<numChannels*256;++i)
+		opaques[i]=false;
+	for(int i=0;i<numChannels*257;++i)
+		opaqueCounts[i]=0;
+	}
+
+MacroCellGrid::~MacroCellGrid(void)
+	{
+	delete[] cellRanges;
+	delete[] opaques;
+	delete[] opaqueCounts;
+	delete[] changeMins;
+	delete[] changeMaxs;
+	delete[] occupancy;
+	}
+
+void MacroCellGrid::setNumThreads(unsigned int newNumThreads)
+	{
+	numThreads=newNumThreads>0?newNumThreads:1;
+	}
+
+void MacroCellGrid::resetRanges(void)
+	{
+	Threads::Mutex::Lock classifyLock(classifyMutex);
+	
+	/* Set all value ranges to empty: */
+	Voxel* rPtr=cellRanges;
+	for(size_t i=0;i<totalNumCells*numChannels;++i,rPtr+=2)
+		{
+		rPtr[0]=Voxel(255);
+		rPtr[1]=Voxel(0);
+		}
+	
+	/* Mark all macro cells as occupied until the next classification: */
+	for(size_t i=0;i<totalNumCells;++i)
+		occupancy[i]=Voxel(255);
+	classified=false;
+	++occupancyVersion;
+	}
+
+void MacroCellGrid::updateRanges(int channel,const unsigned int sBlockOrigin[3],const unsigned int sBlockSize[3],const MacroCellGrid::Voxel* sBlockVoxels,const ptrdiff_t sBlockStrides[3])
+	{
+	Threads::Mutex::Lock classifyLock(classifyMutex);
+	
+	/* Store the block layout: */
+	blockChannel=channel;
+	for(int i=0;i<3;++i)
+		{
+		blockOrigin[i]=sBlockOrigin[i];
+		blockSize[i]=sBlockSize[i];
+		}
+	blockVoxels=sBlockVoxels;
+	blockStrides=sBlockStrides;
+	
+	/* Update all layers of macro cells overlapping the block: */
+	unsigned int firstLayer=blockOrigin[2]>0?(blockOrigin[2]-1)/cellSize:0;
+	unsigned int lastLayer=(blockOrigin[2]+blockSize[2]-1)/cellSize+1;
+	if(lastLayer>numCells[2])
+		lastLayer=numCells[2];
+	bool changed=false;
+	processSlabs(&MacroCellGrid::updateRangesThreadMethod,firstLayer,lastLayer,changed);
+	
+	/* Invalidate the classification: */
+	classified=false;
+	}
+
+bool MacroCellGrid::classify(const float* const channelOpacities[],ptrdiff_t opacityStride)
+	{
+	Threads::Mutex::Lock classifyLock(classifyMutex);
+	
+	/* Find the range of voxel values whose opaque flags changed in each channel: */
+	bool anyChanges=false;
+	for(int channel=0;channel<numChannels;++channel)
+		{
+		changeMins[channel]=256;
+		changeMaxs[channel]=-1;
+		bool* chOpaques=opaques+channel*256;
+		const float* opPtr=channelOpacities[channel];
+		for(int i=0;i<256;++i)
+			{
+			bool opaque=opPtr!=0&&opPtr[i*opacityStride]>0.0f;
+			if(chOpaques[i]!=opaque)
+				{
+				chOpaques[i]=opaque;
+				if(changeMins[channel]>i)
+					changeMins[channel]=i;
+				changeMaxs[channel]=i;
+				}
+			}
+		
+		if(changeMins[channel]<=changeMaxs[channel])
+			{
+			/* Update the channel's prefix sums: */
+			unsigned int* counts=opaqueCounts+channel*257;
+			counts[0]=0;
+			for(int i=0;i<256;++i)
+				counts[i+1]=counts[i]+(chOpaques[i]?1U:0U);
+			anyChanges=true;
+			}
+		}
+	
+	/* Bail out if the current classification is still valid: */
+	if(classified&&!anyChanges)
+		return false;
+	
+	/* Reclassify all macro cells affected by the changes: */
+	bool changed=false;
+	processSlabs(&MacroCellGrid::classifyThreadMethod,0,numCells[2],changed);
+	classified=true;
+	if(changed)
+		++occupancyVersion;
+	
+	return changed;
+	}
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+inline float sampleVolume(const MacroCellGrid::Voxel* voxels,const ptrdiff_t voxelStrides[3],const unsigned int dataSize[3],const float pos[3])
+	{
+	/* Emulate a clamped trilinear 3D texture lookup: */
+	const MacroCellGrid::Voxel* base=voxels;
+	float ds[3];
+	ptrdiff_t steps[3];
+	for(int i=0;i<3;++i)
+		{
+		float p=pos[i];
+		if(p<0.0f)
+			p=0.0f;
+		if(p>float(dataSize[i]-1))
+			p=float(dataSize[i]-1);
+		unsigned int index=(unsigned int)Math::floor(p);
+		if(index>dataSize[i]-2)
+			index=dataSize[i]>1?dataSize[i]-2:0;
+		ds[i]=p-float(index);
+		base+=ptrdiff_t(index)*voxelStrides[i];
+		steps[i]=dataSize[i]>1?voxelStrides[i]:0;
+		}
+	float v00=float(base[0])*(1.0f-ds[0])+float(base[steps[0]])*ds[0];
+	float v10=float(base[steps[1]])*(1.0f-ds[0])+float(base[steps[1]+steps[0]])*ds[0];
+	float v01=float(base[steps[2]])*(1.0f-ds[0])+float(base[steps[2]+steps[0]])*ds[0];
+	float v11=float(base[steps[2]+steps[1]])*(1.0f-ds[0])+float(base[steps[2]+steps[1]+steps[0]])*ds[0];
+	float v0=v00*(1.0f-ds[1])+v10*ds[1];
+	float v1=v01*(1.0f-ds[1])+v11*ds[1];
+	return (v0*(1.0f-ds[2])+v1*ds[2])/255.0f;
+	}
+
+inline void lookupColorMap(const float* colorMap,float value,float color[4])
+	{
+	/* Emulate a clamped linear 1D texture lookup into 256 texels: */
+	float x=value*256.0f-0.5f;
+	if(x<0.0f)
+		x=0.0f;
+	if(x>255.0f)
+		x=255.0f;
+	int index=int(Math::floor(x));
+	if(index>254)
+		index=254;
+	float d=x-float(index);
+	for(int i=0;i<4;++i)
+		color[i]=colorMap[index*4+i]*(1.0f-d)+colorMap[(index+1)*4+i]*d;
+	}
+
+}
+
+void MacroCellGrid::castRay(const MacroCellGrid::Voxel* voxels,const ptrdiff_t voxelStrides[3],const float* colorMap,const float rayStart[3],const float rayStep[3],float lambda,float lambdaMax,bool skipEmpty,float color[4],unsigned int& numSamples) const
+	{
+	for(int i=0;i<4;++i)
+		color[i]=0.0f;
+	numSamples=0;
+	
+	/* Limit the ray to the same number of steps as the raycasting shader: */
+	float lambdaEnd=lambda+1499.0f;
+	if(lambdaEnd>lambdaMax)
+		lambdaEnd=lambdaMax;
+	
+	/* Calculate the ray direction in macro cell space: */
+	float cellStep[3],cellSide[3];
+	for(int i=0;i<3;++i)
+		{
+		cellStep[i]=rayStep[i]/float(cellSize);
+		if(cellStep[i]==0.0f)
+			cellStep[i]=1.0e-10f;
+		cellSide[i]=cellStep[i]>=0.0f?1.0f:0.0f;
+		}
+	
+	if(lambda>=lambdaMax)
+		return;
+	for(int iteration=0;iteration<1500;++iteration)
+		{
+		/* Calculate the sample position: */
+		float pos[3];
+		for(int i=0;i<3;++i)
+			pos[i]=rayStart[i]+rayStep[i]*lambda;
+		
+		if(skipEmpty)
+			{
+			/* Find the macro cell containing the sample position: */
+			float cellPos[3],cell[3];
+			unsigned int cellIndex[3];
+			for(int i=0;i<3;++i)
+				{
+				cellPos[i]=pos[i]/float(cellSize);
+				cell[i]=Math::floor(cellPos[i]);
+				if(cell[i]<0.0f)
+					cell[i]=0.0f;
+				if(cell[i]>float(numCells[i]-1))
+					cell[i]=float(numCells[i]-1);
+				cellIndex[i]=(unsigned int)cell[i];
+				}
+			
+			if(!isOccupied(cellIndex))
+				{
+				if(lambda>=lambdaEnd)
+					break;
+				
+				/* Skip all samples inside the empty macro cell: */
+				float exit=Math::Constants<float>::max;
+				for(int i=0;i<3;++i)
+					{
+					float e=(cell[i]+cellSide[i]-cellPos[i])/cellStep[i];
+					if(exit>e)
+						exit=e;
+					}
+				float numSkips=Math::floor(exit>0.0f?exit:0.0f)+1.0f;
+				float maxSkips=Math::ceil(lambdaEnd-lambda);
+				lambda+=numSkips<maxSkips?numSkips:maxSkips;
+				continue;
+				}
+			}
+		
+		/* Get the volume data value at the current sample position: */
+		float vol[4];
+		lookupColorMap(colorMap,sampleVolume(voxels,voxelStrides,dataSize,pos),vol);
+		++numSamples;
+		
+		/* Accumulate color and opacity: */
+		float trans=1.0f-color[3];
+		for(int i=0;i<4;++i)
+			color[i]+=vol[i]*trans;
+		
+		/* Bail out when opacity hits 1.0: */
+		if(color[3]>=1.0f-1.0f/256.0f||lambda>=lambdaEnd)
+			break;
+		
+		/* Advance the sample position: */
+		lambda+=1.0f;
+		}
+	}
@@ -0,0 +1,124 @@
+/***********************************************************************
+MacroCellGrid - Class to partition a voxel block into coarse macro cells
+storing the range of voxel values inside each cell, to classify macro
+cells as empty or occupied under a set of color maps so that raycasters
+can skip empty regions.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef MACROCELLGRID_INCLUDED
+#define MACROCELLGRID_INCLUDED
+
+#include <stddef.h>
+#include <Threads/Mutex.h>
+
+class MacroCellGrid
+	{
+	/* Embedded classes: */
+	public:
+	typedef unsigned char Voxel; // Type for voxel data
+	
+	private:
+	struct Slab // Structure describing a range of macro cell layers processed by one thread
+		{
+		/* Elements: */
+		public:
+		unsigned int firstLayer,lastLayer; // Range of macro cell layers along the z axis, lastLayer exclusive
+		bool changed; // Flag whether the classification of any macro cell in the slab changed
+		};
+	
+	/* Elements: */
+	unsigned int dataSize[3]; // Size of the voxel block
+	int numChannels; // Number of scalar channels per voxel
+	unsigned int cellSize; // Edge length of a macro cell in voxel cells; neighboring macro cells share their boundary voxels
+	unsigned int numCells[3]; // Number of macro cells in each dimension
+	size_t totalNumCells; // Total number of macro cells
+	unsigned int numThreads; // Number of threads used to update value ranges and classify macro cells
+	Voxel* cellRanges; // Array of minimum and maximum voxel values for each channel of each macro cell, in x-fastest order
+	
+	Threads::Mutex classifyMutex; // Mutex serializing classification from multiple rendering threads
+	bool classified; // Flag whether the occupancy array is valid for the current value ranges
+	bool* opaques; // Flags for each channel and voxel value whether the value is not fully transparent
+	unsigned int* opaqueCounts; // Prefix sums of the opaque flags for each channel
+	int* changeMins; // Smallest voxel value for each channel whose opaque flag changed during the current classification
+	int* changeMaxs; // Largest voxel value for each channel whose opaque flag changed during the current classification
+	Voxel* occupancy; // Array of occupancy flags for each macro cell; zero for empty, 255 for occupied
+	unsigned int occupancyVersion; // Version number of the occupancy array to track changes
+	
+	/* State of the current value range update: */
+	int blockChannel; // Channel receiving the current block of voxels
+	unsigned int blockOrigin[3]; // Index of the current block's first voxel
+	unsigned int blockSize[3]; // Size of the current block
+	const Voxel* blockVoxels; // Pointer to the current block's first voxel
+	const ptrdiff_t* blockStrides; // Voxel strides of the current block
+	
+	/* Private methods: */
+	void getCellVoxels(unsigned int cellIndex,int dimension,unsigned int& first,unsigned int& last) const // Returns the inclusive range of voxels covered by the given macro cell index along the given dimension
+		{
+		first=cellIndex*cellSize;
+		last=first+cellSize;
+		if(last>dataSize[dimension]-1)
+			last=dataSize[dimension]-1;
+		}
+	void processSlabs(void* (MacroCellGrid::*threadMethod)(Slab*),unsigned int firstLayer,unsigned int lastLayer,bool& changed); // Processes the given range of macro cell layers on multiple threads
+	void* updateRangesThreadMethod(Slab* slab); // Merges the current block's voxel values into the value ranges of the slab's macro cells
+	void* classifyThreadMethod(Slab* slab); // Reclassifies the slab's macro cells affected by the current opacity changes
+	
+	/* Constructors and destructors: */
+	public:
+	MacroCellGrid(const unsigned int sDataSize[3],int sNumChannels,unsigned int sCellSize); // Creates a macro cell grid of the given macro cell size for a voxel block of the given size and number of channels
+	private:
+	MacroCellGrid(const MacroCellGrid& source); // Prohibit copy constructor
+	MacroCellGrid& operator=(const MacroCellGrid& source); // Prohibit assignment operator
+	public:
+	~MacroCellGrid(void); // Destroys the macro cell grid
+	
+	/* Methods: */
+	const unsigned int* getNumCells(void) const // Returns the number of macro cells in each dimension
+		{
+		return numCells;
+		}
+	unsigned int getCellSize(void) const // Returns the edge length of a macro cell in voxel cells
+		{
+		return cellSize;
+		}
+	unsigned int getNumThreads(void) const // Returns the number of threads used to update and classify the grid
+		{
+		return numThreads;
+		}
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads used to update and classify the grid
+	void resetRanges(void); // Resets the value ranges of all macro cells before the voxel block is updated
+	void updateRanges(int channel,const unsigned int sBlockOrigin[3],const unsigned int sBlockSize[3],const Voxel* sBlockVoxels,const ptrdiff_t sBlockStrides[3]); // Merges the given channel of the given block of voxels into the value ranges of all macro cells overlapping the block
+	bool classify(const float* const channelOpacities[],ptrdiff_t opacityStride); // Classifies all macro cells based on the given per-channel tables of 256 opacities with the given stride; null tables denote disabled channels; returns true if the occupancy array changed
+	const Voxel* getOccupancy(void) const // Returns the macro cell occupancy array
+		{
+		return occupancy;
+		}
+	unsigned int getOccupancyVersion(void) const // Returns the version number of the occupancy array
+		{
+		return occupancyVersion;
+		}
+	bool isOccupied(const unsigned int cellIndex[3]) const // Returns true if the given macro cell is not fully transparent
+		{
+		return occupancy[(size_t(cellIndex[2])*size_t(numCells[1])+size_t(cellIndex[1]))*size_t(numCells[0])+size_t(cellIndex[0])]!=Voxel(0);
+		}
+	void castRay(const Voxel* voxels,const ptrdiff_t voxelStrides[3],const float* colorMap,const float rayStart[3],const float rayStep[3],float lambda,float lambdaMax,bool skipEmpty,float color[4],unsigned int& numSamples) const; // Reference implementation of the raycasting shader on a single-channel voxel block in voxel index space, using a color map of 256 pre-multiplied RGBA colors; skips empty macro cells if skipEmpty is true
+	};
+
+#endif
@@ -0,0 +1,160 @@
+/***********************************************************************
+ParticleAdvectorBenchmark - Headless program to measure the particle
+advection throughput of the templatized particle advector in an
+analytic flow field.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+
+#include <Templatized/Cartesian.h>
+#include <Templatized/VectorExtractor.h>
+#include <Templatized/VectorScalarExtractor.h>
+#include <Templatized/ParticleAdvector.h>
+
+/* Types of the benchmark data set and particle advector: */
+typedef Geometry::Vector<float,3> Value;
+typedef Visualization::Templatized::Cartesian<double,3,Value> DS;
+typedef Visualization::Templatized::VectorExtractor<Value,Value> VE;
+typedef Visualization::Templatized::ScalarExtractor<float,Value> SE;
+typedef Visualization::Templatized::ParticleAdvector<DS,VE,SE> ParticleAdvector;
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	int gridSize=64; // Number of vertices along each axis of the benchmark grid
+	size_t numParticles=100000; // Number of advected particles
+	unsigned int numThreads=1; // Number of advection threads
+	unsigned int numFrames=100; // Number of measured animation frames
+	unsigned int numStepsPerFrame=1; // Number of advection steps per animation frame
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"size")==0)
+				{
+				++i;
+				if(i<argc)
+					gridSize=atoi(argv[i]);
+				else
+					std::cerr<<"ParticleAdvectorBenchmark: ignored dangling -size option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"particles")==0)
+				{
+				++i;
+				if(i<argc)
+					numParticles=size_t(atol(argv[i]));
+				else
+					std::cerr<<"ParticleAdvectorBenchmark: ignored dangling -particles option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"threads")==0)
+				{
+				++i;
+				if(i<argc)
+					numThreads=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"ParticleAdvectorBenchmark: ignored dangling -threads option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"frames")==0)
+				{
+				++i;
+				if(i<argc)
+					numFrames=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"ParticleAdvectorBenchmark: ignored dangling -frames option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"steps")==0)
+				{
+				++i;
+				if(i<argc)
+					numStepsPerFrame=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"ParticleAdvectorBenchmark: ignored dangling -steps option"<<std::endl;
+				}
+			else
+				std::cerr<<"ParticleAdvectorBenchmark: ignored unrecognized option "<<argv[i]<<std::endl;
+			}
+		}
+	if(gridSize<2||numParticles==0||numThreads==0)
+		{
+		std::cerr<<"ParticleAdvectorBenchmark: invalid benchmark parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create a Cartesian grid spanning [0, 2*pi]^3 and sample an ABC flow on it: */
+	DS::Index numVertices(gridSize,gridSize,gridSize);
+	DS::Size cellSize;
+	for(int i=0;i<3;++i)
+		cellSize[i]=2.0*Math::Constants<double>::pi/double(gridSize-1);
+	DS ds(numVertices,cellSize);
+	const double a=Math::sqrt(3.0);
+	const double b=Math::sqrt(2.0);
+	const double c=1.0;
+	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		DS::Point p=ds.getVertexPosition(index);
+		Value& v=ds.getVertexValue(index);
+		v[0]=float(a*Math::sin(p[2])+c*Math::cos(p[1]));
+		v[1]=float(b*Math::sin(p[0])+a*Math::cos(p[2]));
+		v[2]=float(c*Math::sin(p[1])+b*Math::cos(p[0]));
+		}
+	
+	/* Create a particle advector seeding particles in a sphere around the domain's center: */
+	ParticleAdvector pa(&ds,VE(),SE());
+	pa.setStepSize(ds.calcAverageCellSize()*0.25);
+	pa.setLifeTime(ds.calcAverageCellSize()*50.0);
+	pa.setNumThreads(numThreads);
+	DS::Point seedCenter=Geometry::mid(ds.getDomainBox().min,ds.getDomainBox().max);
+	DS::Locator seedLocator=ds.getLocator();
+	if(!seedLocator.locatePoint(seedCenter)||!pa.setSeed(seedCenter,Math::Constants<double>::pi*0.5,seedLocator))
+		{
+		std::cerr<<"ParticleAdvectorBenchmark: unable to locate seed point"<<std::endl;
+		return 1;
+		}
+	pa.setNumParticles(numParticles);
+	
+	/* Run one unmeasured frame to start the worker threads and warm up the caches: */
+	pa.advect(numStepsPerFrame);
+	pa.resetCounters();
+	
+	/* Run the measured frames: */
+	Misc::Timer timer;
+	for(unsigned int frame=0;frame<numFrames;++frame)
+		pa.advect(numStepsPerFrame);
+	timer.elapse();
+	
+	/* Print the results: */
+	double time=timer.getTime();
+	std::cout<<"Grid size          : "<<gridSize<<"^3 vertices"<<std::endl;
+	std::cout<<"Number of particles: "<<numParticles<<std::endl;
+	std::cout<<"Number of threads  : "<<numThreads<<std::endl;
+	std::cout<<"Number of frames   : "<<numFrames<<" ("<<numStepsPerFrame<<" steps per frame)"<<std::endl;
+	std::cout<<"Total time         : "<<time*1000.0<<" ms ("<<time*1000.0/double(numFrames)<<" ms per frame)"<<std::endl;
+	std::cout<<"Particle steps     : "<<pa.getNumParticleSteps()<<" ("<<pa.getNumReseeds()<<" re-seeded particles)"<<std::endl;
+	std::cout<<"Particle steps/s   : "<<double(pa.getNumParticleSteps())/time<<std::endl;
+	
+	return 0;
+	}
@@ -77,6 +77,10 @@ class Polyhedron
 	Polyhedron(const Polyhedron& source); // Copy constructor
 	
 	/* Methods: */
+	bool isEmpty(void) const // Returns true if the polyhedron has no faces
+		{
+		return edges.empty();
+		}
 	Polyhedron* clip(const Plane& plane) const; // Returns a new polyhedron resulting from clipping this one against the given plane
 	void drawEdges(void) const; // Draws the polyhedron's edges
 	void drawFaces(void) const; // Draws the polyhedron's faces
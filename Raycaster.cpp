@@ -43,9 +43,11 @@ Methods of class Raycaster::DataItem:
 Raycaster::DataItem::DataItem(void)
 	:hasNPOTDTextures(GLARBTextureNonPowerOfTwo::isSupported()),
 	 depthTextureID(0),depthFramebufferID(0),
+	 occupancyTextureID(0),occupancyTextureVersion(0),
 	 mcScaleLoc(-1),mcOffsetLoc(-1),
 	 depthSamplerLoc(-1),depthMatrixLoc(-1),depthSizeLoc(-1),
-	 eyePositionLoc(-1),stepSizeLoc(-1)
+	 eyePositionLoc(-1),stepSizeLoc(-1),
+	 occupancySamplerLoc(-1),mcellScaleLoc(-1),mcellOffsetLoc(-1),mcellTexScaleLoc(-1),mcellMaxLoc(-1)
 	{
 	/* Check for the required OpenGL extensions: */
 	if(!GLShader::isSupported())
@@ -83,6 +85,9 @@ Raycaster::DataItem::DataItem(void)
 	glDrawBuffer(GL_NONE);
 	glReadBuffer(GL_NONE);
 	glBindFramebufferEXT(GL_FRAMEBUFFER_EXT,0);
+	
+	/* Create the macro cell occupancy texture object: */
+	glGenTextures(1,&occupancyTextureID);
 	}
 
 Raycaster::DataItem::~DataItem(void)
@@ -90,6 +95,9 @@ Raycaster::DataItem::~DataItem(void)
 	/* Destroy the depth texture and framebuffer: */
 	glDeleteFramebuffersEXT(1,&depthFramebufferID);
 	glDeleteTextures(1,&depthTextureID);
+	
+	/* Destroy the macro cell occupancy texture object: */
+	glDeleteTextures(1,&occupancyTextureID);
 	}
 
 void Raycaster::DataItem::initDepthBuffer(void)
@@ -142,9 +150,9 @@ Methods of class Raycaster:
 void Raycaster::initDataItem(Raycaster::DataItem* dataItem) const
 	{
 	/* Calculate the appropriate volume texture's size: */
-	if(dataItem->hasNPOTDTextures)
+	if(dataItem->hasNPOTDTextures||brickedTextures)
 		{
-		/* Use the data size directly: */
+		/* Use the data size directly; brick textures are sized independently: */
 		for(int i=0;i<3;++i)
 			dataItem->textureSize[i]=dataSize[i];
 		}
@@ -167,6 +175,35 @@ void Raycaster::initDataItem(Raycaster::DataItem* dataItem) const
 		dataItem->mcOffset[i]=GLfloat(tcMin[i]-domain.min[i]*scale);
 		}
 	dataItem->texCoords=Box(tcMin,tcMax);
+	
+	/* Calculate the appropriate occupancy texture's size: */
+	const unsigned int* numCells=macroCellGrid.getNumCells();
+	for(int i=0;i<3;++i)
+		{
+		if(dataItem->hasNPOTDTextures)
+			dataItem->occupancyTextureSize[i]=numCells[i];
+		else
+			for(dataItem->occupancyTextureSize[i]=1;dataItem->occupancyTextureSize[i]<GLsizei(numCells[i]);dataItem->occupancyTextureSize[i]<<=1)
+				;
+		}
+	
+	/* Calculate the transformations from data space to macro cell space, and from macro cell space to occupancy texture space: */
+	for(int i=0;i<3;++i)
+		{
+		dataItem->mcellScale[i]=GLfloat(dataItem->textureSize[i])/GLfloat(macroCellGrid.getCellSize());
+		dataItem->mcellOffset[i]=-0.5f/GLfloat(macroCellGrid.getCellSize());
+		dataItem->mcellTexScale[i]=1.0f/GLfloat(dataItem->occupancyTextureSize[i]);
+		}
+	
+	/* Create the macro cell occupancy texture: */
+	glBindTexture(GL_TEXTURE_3D,dataItem->occupancyTextureID);
+	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_R,GL_CLAMP_TO_EDGE);
+	glTexImage3DEXT(GL_TEXTURE_3D,0,GL_INTENSITY,dataItem->occupancyTextureSize[0],dataItem->occupancyTextureSize[1],dataItem->occupancyTextureSize[2],0,GL_LUMINANCE,GL_UNSIGNED_BYTE,0);
+	glBindTexture(GL_TEXTURE_3D,0);
 	}
 
 void Raycaster::initShader(Raycaster::DataItem* dataItem) const
@@ -181,6 +218,12 @@ void Raycaster::initShader(Raycaster::DataItem* dataItem) const
 	
 	dataItem->eyePositionLoc=dataItem->shader.getUniformLocation("eyePosition");
 	dataItem->stepSizeLoc=dataItem->shader.getUniformLocation("stepSize");
+	
+	dataItem->occupancySamplerLoc=dataItem->shader.getUniformLocation("occupancySampler");
+	dataItem->mcellScaleLoc=dataItem->shader.getUniformLocation("mcellScale");
+	dataItem->mcellOffsetLoc=dataItem->shader.getUniformLocation("mcellOffset");
+	dataItem->mcellTexScaleLoc=dataItem->shader.getUniformLocation("mcellTexScale");
+	dataItem->mcellMaxLoc=dataItem->shader.getUniformLocation("mcellMax");
 	}
 
 void Raycaster::bindShader(const Raycaster::PTransform& pmv,const Raycaster::PTransform& mv,Raycaster::DataItem* dataItem) const
@@ -215,6 +258,43 @@ void Raycaster::unbindShader(Raycaster::DataItem* dataItem) const
 	glBindTexture(GL_TEXTURE_2D,0);
 	}
 
+void Raycaster::bindMacroCells(Raycaster::DataItem* dataItem,int textureUnit) const
+	{
+	/* Bind the occupancy texture: */
+	glActiveTextureARB(GL_TEXTURE0_ARB+textureUnit);
+	glBindTexture(GL_TEXTURE_3D,dataItem->occupancyTextureID);
+	glUniform1iARB(dataItem->occupancySamplerLoc,textureUnit);
+	
+	/* Check if the occupancy texture needs to be updated: */
+	if(dataItem->occupancyTextureVersion!=macroCellGrid.getOccupancyVersion())
+		{
+		/* Upload the new macro cell occupancy: */
+		const unsigned int* numCells=macroCellGrid.getNumCells();
+		GLint oldUnpackAlignment;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT,&oldUnpackAlignment);
+		glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+		glTexSubImage3DEXT(GL_TEXTURE_3D,0,0,0,0,numCells[0],numCells[1],numCells[2],GL_LUMINANCE,GL_UNSIGNED_BYTE,macroCellGrid.getOccupancy());
+		glPixelStorei(GL_UNPACK_ALIGNMENT,oldUnpackAlignment);
+		
+		/* Mark the occupancy texture as up-to-date: */
+		dataItem->occupancyTextureVersion=macroCellGrid.getOccupancyVersion();
+		}
+	
+	/* Set up the macro cell space transformation: */
+	glUniform3fvARB(dataItem->mcellScaleLoc,1,dataItem->mcellScale);
+	glUniform3fvARB(dataItem->mcellOffsetLoc,1,dataItem->mcellOffset);
+	glUniform3fvARB(dataItem->mcellTexScaleLoc,1,dataItem->mcellTexScale);
+	const unsigned int* numCells=macroCellGrid.getNumCells();
+	glUniform3fARB(dataItem->mcellMaxLoc,GLfloat(numCells[0]-1),GLfloat(numCells[1]-1),GLfloat(numCells[2]-1));
+	}
+
+void Raycaster::unbindMacroCells(Raycaster::DataItem*,int textureUnit) const
+	{
+	/* Unbind the occupancy texture: */
+	glActiveTextureARB(GL_TEXTURE0_ARB+textureUnit);
+	glBindTexture(GL_TEXTURE_3D,0);
+	}
+
 Polyhedron<Raycaster::Scalar>* Raycaster::clipDomain(const Raycaster::PTransform& pmv,const Raycaster::PTransform& mv) const
 	{
 	/* Clip the render domain against the view frustum's front plane: */
@@ -255,10 +335,18 @@ Polyhedron<Raycaster::Scalar>* Raycaster::clipDomain(const Raycaster::PTransform
 	return clippedDomain;
 	}
 
-Raycaster::Raycaster(const unsigned int sDataSize[3],const Raycaster::Box& sDomain)
+void Raycaster::drawClippedDomain(const Raycaster::PTransform&,const Raycaster::PTransform&,const Polyhedron<Raycaster::Scalar>& clippedDomain,Raycaster::DataItem*) const
+	{
+	/* Draw the clipped domain's faces in one go: */
+	clippedDomain.drawFaces();
+	}
+
+Raycaster::Raycaster(const unsigned int sDataSize[3],const Raycaster::Box& sDomain,int sNumChannels)
 	:domain(sDomain),domainExtent(0),cellSize(0),
 	 renderDomain(Polyhedron<Scalar>::Point(domain.min),Polyhedron<Scalar>::Point(domain.max)),
-	 stepSize(1)
+	 brickedTextures(false),
+	 stepSize(1),
+	 macroCellGrid(sDataSize,sNumChannels,8)
 	{
 	/* Copy the data sizes and calculate the data strides and cell size: */
 	ptrdiff_t stride=1;
@@ -326,7 +414,7 @@ void Raycaster::glRenderAction(GLContextData& contextData) const
 	glDepthMask(GL_FALSE);
 	glCullFace(GL_BACK);
 	if(clippedDomain!=0)
-		clippedDomain->drawFaces();
+		drawClippedDomain(pmv,mv,*clippedDomain,dataItem);
 	
 	/* Uninstall the GLSL shader program: */
 	unbindShader(dataItem);
@@ -32,6 +32,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/GLShader.h>
 
 #include <Polyhedron.h>
+#include <MacroCellGrid.h>
 
 class Raycaster:public GLObject
 	{
@@ -58,6 +59,12 @@ class Raycaster:public GLObject
 		GLuint depthFramebufferID; // Framebuffer object ID to render to the ray termination buffer
 		GLsizei depthTextureSize[2]; // Current size of the depth texture
 		
+		GLuint occupancyTextureID; // Texture object ID for the macro cell occupancy texture
+		GLsizei occupancyTextureSize[3]; // Size of the macro cell occupancy texture
+		unsigned int occupancyTextureVersion; // Version number of the macro cell occupancy texture
+		GLfloat mcellScale[3],mcellOffset[3]; // Scale factors and offsets from data space to macro cell space
+		GLfloat mcellTexScale[3]; // Scale factors from macro cell space to occupancy texture space
+		
 		GLShader shader; // Shader object for the raycasting algorithm
 		int mcScaleLoc; // Location of the scale factors from model coordinates to data coordinates
 		int mcOffsetLoc; // Location of the offset from model coordinates to data coordinates
@@ -66,6 +73,11 @@ class Raycaster:public GLObject
 		int depthSizeLoc; // Location of the depth texture size uniform variable
 		int eyePositionLoc; // Location of the eye position uniform variable
 		int stepSizeLoc; // Location of the step size uniform variable
+		int occupancySamplerLoc; // Location of the macro cell occupancy texture sampler
+		int mcellScaleLoc; // Location of the scale factors from data coordinates to macro cell coordinates
+		int mcellOffsetLoc; // Location of the offset from data coordinates to macro cell coordinates
+		int mcellTexScaleLoc; // Location of the scale factors from macro cell coordinates to occupancy texture coordinates
+		int mcellMaxLoc; // Location of the largest macro cell index
 		
 		/* Constructors and destructors: */
 		DataItem(void);
@@ -83,8 +95,10 @@ class Raycaster:public GLObject
 	Scalar domainExtent; // Length of longest ray through domain
 	Scalar cellSize; // The data set's cell size
 	Polyhedron<Scalar> renderDomain; // Polyhedron used to render the clipped data set
+	bool brickedTextures; // Flag whether the volume data is held in separate fixed-size brick textures instead of a single volume texture; data space then spans the unpadded volume data
 	
 	Scalar stepSize; // The ray casting step size in cell size units
+	mutable MacroCellGrid macroCellGrid; // Grid of macro cells to skip regions that are fully transparent under the current color maps
 	
 	/* Protected methods: */
 	protected:
@@ -92,11 +106,14 @@ class Raycaster:public GLObject
 	virtual void initShader(DataItem* dataItem) const; // Initializes the GLSL raycasting shader
 	virtual void bindShader(const PTransform& pmv,const PTransform& mv,DataItem* dataItem) const; // Prepares the GLSL raycasting shader for rendering
 	virtual void unbindShader(DataItem* dataItem) const; // Unbinds the GLSL raycasting shader after rendering
+	void bindMacroCells(DataItem* dataItem,int textureUnit) const; // Uploads the macro cell grid's current occupancy if it changed and binds it to the given texture unit
+	void unbindMacroCells(DataItem* dataItem,int textureUnit) const; // Unbinds the macro cell occupancy texture from the given texture unit
 	Polyhedron<Scalar>* clipDomain(const PTransform& pmv,const PTransform& mv) const; // Clips the domain against the view frustum and all clipping planes and returns the resulting polyhedron
+	virtual void drawClippedDomain(const PTransform& pmv,const PTransform& mv,const Polyhedron<Scalar>& clippedDomain,DataItem* dataItem) const; // Draws the clipped domain's front faces with the bound raycasting shader
 	
 	/* Constructors and destructors: */
 	public:
-	Raycaster(const unsigned int sDataSize[3],const Box& sDomain); // Creates a raycaster for the given data and domain sizes
+	Raycaster(const unsigned int sDataSize[3],const Box& sDomain,int sNumChannels =1); // Creates a raycaster for the given data and domain sizes and number of scalar channels
 	virtual ~Raycaster(void); // Destroys the raycaster
 	
 	/* New methods: */
@@ -124,6 +141,10 @@ class Raycaster:public GLObject
 		{
 		return cellSize;
 		}
+	MacroCellGrid& getMacroCellGrid(void) // Returns the raycaster's macro cell grid
+		{
+		return macroCellGrid;
+		}
 	Scalar getStepSize(void) const // Returns the raycaster's step size in cell size units
 		{
 		return stepSize;
@@ -42,7 +42,8 @@ Methods of class ScalarEvaluationLocator:
 
 ScalarEvaluationLocator::ScalarEvaluationLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* sApplication)
 	:EvaluationLocator(sLocatorTool,sApplication,"Scalar Evaluation Dialog"),
-	 scalarExtractor(application->variableManager->getCurrentScalarExtractor()),
+	 scalarVariableIndex(application->variableManager->getCurrentScalarVariable()),
+	 scalarExtractor(application->variableManager->getScalarExtractor(scalarVariableIndex)),
 	 valueValid(false)
 	{
 	/* Add to the evaluation dialog: */
@@ -104,6 +105,16 @@ void ScalarEvaluationLocator::motionCallback(Vrui::LocatorTool::MotionCallbackDa
 		}
 	}
 
+void ScalarEvaluationLocator::dataSetChanged(void)
+	{
+	/* Call the base class method: */
+	EvaluationLocator::dataSetChanged();
+	
+	/* Get the scalar extractor for the new data set: */
+	scalarExtractor=application->variableManager->getScalarExtractor(scalarVariableIndex);
+	valueValid=false;
+	}
+
 void ScalarEvaluationLocator::insertControlPointCallback(Misc::CallbackData* cbData)
 	{
 	/* Insert a new control point into the color map: */
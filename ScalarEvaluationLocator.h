@@ -43,6 +43,7 @@ class ScalarEvaluationLocator:public EvaluationLocator
 	typedef ScalarExtractor::Scalar Scalar;
 	
 	/* Elements: */
+	int scalarVariableIndex; // Index of the evaluated scalar variable
 	const ScalarExtractor* scalarExtractor; // Extractor for the evaluated scalar value
 	GLMotif::TextField* value; // The value text field
 	bool valueValid; // Flag if the evaluation value is valid
@@ -56,6 +57,9 @@ class ScalarEvaluationLocator:public EvaluationLocator
 	/* Methods from Vrui::LocatorToolAdapter: */
 	virtual void motionCallback(Vrui::LocatorTool::MotionCallbackData* cbData);
 	
+	/* Methods from class BaseLocator: */
+	virtual void dataSetChanged(void);
+	
 	/* New methods: */
 	void insertControlPointCallback(Misc::CallbackData* cbData);
 	};
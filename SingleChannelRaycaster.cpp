@@ -23,11 +23,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <SingleChannelRaycaster.h>
 
 #include <string>
+#include <algorithm>
+#include <Math/Math.h>
 #include <GL/gl.h>
 #include <GL/GLContextData.h>
 #include <GL/Extensions/GLARBTextureFloat.h>
 #include <GL/GLShader.h>
 
+#include <VoxelBrickStore.h>
+
 /*************************************************
 Methods of class SingleChannelRaycaster::DataItem:
 *************************************************/
@@ -36,7 +40,8 @@ SingleChannelRaycaster::DataItem::DataItem(void)
 	:haveFloatTextures(GLARBTextureFloat::isSupported()),
 	 volumeTextureID(0),volumeTextureVersion(0),
 	 colorMapTextureID(0),
-	 volumeSamplerLoc(-1),colorMapSamplerLoc(-1)
+	 volumeSamplerLoc(-1),colorMapSamplerLoc(-1),
+	 brickMinLoc(-1),brickMaxLoc(-1),brickTexScaleLoc(-1),brickTexOffsetLoc(-1)
 	{
 	/* Initialize all required OpenGL extensions: */
 	if(haveFloatTextures)
@@ -56,8 +61,18 @@ SingleChannelRaycaster::DataItem::~DataItem(void)
 	
 	/* Destroy the color map texture object: */
 	glDeleteTextures(1,&colorMapTextureID);
+	
+	/* Destroy the brick texture objects: */
+	if(!brickTextureIDs.empty())
+		glDeleteTextures(brickTextureIDs.size(),&brickTextureIDs[0]);
 	}
 
+/***********************************************
+Static elements of class SingleChannelRaycaster:
+***********************************************/
+
+size_t SingleChannelRaycaster::brickTextureMemory=size_t(256)*size_t(1024*1024);
+
 /***************************************
 Methods of class SingleChannelRaycaster:
 ***************************************/
@@ -70,15 +85,46 @@ void SingleChannelRaycaster::initDataItem(Raycaster::DataItem* dataItem) const
 	/* Get a pointer to the data item: */
 	DataItem* myDataItem=dynamic_cast<DataItem*>(dataItem);
 	
-	/* Create the data volume texture: */
-	glBindTexture(GL_TEXTURE_3D,myDataItem->volumeTextureID);
-	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_S,GL_CLAMP);
-	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_T,GL_CLAMP);
-	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_R,GL_CLAMP);
-	glTexImage3DEXT(GL_TEXTURE_3D,0,GL_INTENSITY,myDataItem->textureSize[0],myDataItem->textureSize[1],myDataItem->textureSize[2],0,GL_LUMINANCE,GL_UNSIGNED_BYTE,0);
-	glBindTexture(GL_TEXTURE_3D,0);
+	if(brickStore!=0)
+		{
+		/* Calculate how many brick textures fit into the texture memory budget: */
+		size_t totalNumTextureBricks=size_t(numTextureBricks[0])*size_t(numTextureBricks[1])*size_t(numTextureBricks[2]);
+		size_t numBrickTextures=brickTextureMemory/(size_t(textureBrickSize)*size_t(textureBrickSize)*size_t(textureBrickSize)*sizeof(Voxel));
+		if(numBrickTextures>totalNumTextureBricks)
+			numBrickTextures=totalNumTextureBricks;
+		if(numBrickTextures<1)
+			numBrickTextures=1;
+		
+		/* Create the brick textures; they are filled on demand while rendering: */
+		myDataItem->brickTextureIDs.resize(numBrickTextures,0);
+		glGenTextures(numBrickTextures,&myDataItem->brickTextureIDs[0]);
+		for(size_t i=0;i<numBrickTextures;++i)
+			{
+			glBindTexture(GL_TEXTURE_3D,myDataItem->brickTextureIDs[i]);
+			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_R,GL_CLAMP_TO_EDGE);
+			glTexImage3DEXT(GL_TEXTURE_3D,0,GL_INTENSITY,textureBrickSize,textureBrickSize,textureBrickSize,0,GL_LUMINANCE,GL_UNSIGNED_BYTE,0);
+			myDataItem->textureBricks.push_back(~0U);
+			myDataItem->textureLruPos.push_back(myDataItem->textureLru.insert(myDataItem->textureLru.end(),(unsigned int)i));
+			}
+		glBindTexture(GL_TEXTURE_3D,0);
+		myDataItem->brickTextures.resize(totalNumTextureBricks,~0U);
+		}
+	else
+		{
+		/* Create the data volume texture: */
+		glBindTexture(GL_TEXTURE_3D,myDataItem->volumeTextureID);
+		glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_S,GL_CLAMP);
+		glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_T,GL_CLAMP);
+		glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_R,GL_CLAMP);
+		glTexImage3DEXT(GL_TEXTURE_3D,0,GL_INTENSITY,myDataItem->textureSize[0],myDataItem->textureSize[1],myDataItem->textureSize[2],0,GL_LUMINANCE,GL_UNSIGNED_BYTE,0);
+		glBindTexture(GL_TEXTURE_3D,0);
+		}
 	
 	/* Create the color map texture: */
 	glBindTexture(GL_TEXTURE_1D,myDataItem->colorMapTextureID);
@@ -99,6 +145,10 @@ void SingleChannelRaycaster::initShader(Raycaster::DataItem* dataItem) const
 	/* Get the shader's uniform locations: */
 	myDataItem->volumeSamplerLoc=myDataItem->shader.getUniformLocation("volumeSampler");
 	myDataItem->colorMapSamplerLoc=myDataItem->shader.getUniformLocation("colorMapSampler");
+	myDataItem->brickMinLoc=myDataItem->shader.getUniformLocation("brickMin");
+	myDataItem->brickMaxLoc=myDataItem->shader.getUniformLocation("brickMax");
+	myDataItem->brickTexScaleLoc=myDataItem->shader.getUniformLocation("brickTexScale");
+	myDataItem->brickTexOffsetLoc=myDataItem->shader.getUniformLocation("brickTexOffset");
 	}
 
 void SingleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const Raycaster::PTransform& mv,Raycaster::DataItem* dataItem) const
@@ -109,19 +159,29 @@ void SingleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const R
 	/* Get a pointer to the data item: */
 	DataItem* myDataItem=dynamic_cast<DataItem*>(dataItem);
 	
-	/* Bind the volume texture: */
+	/* Bind the volume texture unit; brick textures are bound one brick at a time while drawing: */
 	glActiveTextureARB(GL_TEXTURE1_ARB);
-	glBindTexture(GL_TEXTURE_3D,myDataItem->volumeTextureID);
 	glUniform1iARB(myDataItem->volumeSamplerLoc,1);
-	
-	/* Check if the volume texture needs to be updated: */
-	if(myDataItem->volumeTextureVersion!=dataVersion)
+	if(brickStore==0)
 		{
-		/* Upload the new volume data: */
-		glTexSubImage3DEXT(GL_TEXTURE_3D,0,0,0,0,dataSize[0],dataSize[1],dataSize[2],GL_LUMINANCE,GL_UNSIGNED_BYTE,data);
+		/* Bind the volume texture: */
+		glBindTexture(GL_TEXTURE_3D,myDataItem->volumeTextureID);
 		
-		/* Mark the volume texture as up-to-date: */
-		myDataItem->volumeTextureVersion=dataVersion;
+		/* Check if the volume texture needs to be updated: */
+		if(myDataItem->volumeTextureVersion!=dataVersion)
+			{
+			/* Upload the new volume data: */
+			glTexSubImage3DEXT(GL_TEXTURE_3D,0,0,0,0,dataSize[0],dataSize[1],dataSize[2],GL_LUMINANCE,GL_UNSIGNED_BYTE,data);
+			
+			/* Mark the volume texture as up-to-date: */
+			myDataItem->volumeTextureVersion=dataVersion;
+			}
+		
+		/* Let the single volume texture cover all of data space: */
+		glUniform3fARB(myDataItem->brickMinLoc,-1.0f,-1.0f,-1.0f);
+		glUniform3fARB(myDataItem->brickMaxLoc,2.0f,2.0f,2.0f);
+		glUniform3fARB(myDataItem->brickTexScaleLoc,1.0f,1.0f,1.0f);
+		glUniform3fARB(myDataItem->brickTexOffsetLoc,0.0f,0.0f,0.0f);
 		}
 	
 	/* Bind the color map texture: */
@@ -134,10 +194,21 @@ void SingleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const R
 	adjustedColorMap.changeTransparency(stepSize*transparencyGamma);
 	adjustedColorMap.premultiplyAlpha();
 	glTexImage1D(GL_TEXTURE_1D,0,myDataItem->haveFloatTextures?GL_RGBA32F_ARB:GL_RGBA,256,0,GL_RGBA,GL_FLOAT,adjustedColorMap.getColors());
+	
+	/* Reclassify the macro cells if the color map's transparent entries changed: */
+	const float* opacities[1];
+	opacities[0]=adjustedColorMap.getColors()[0].getRgba()+3;
+	macroCellGrid.classify(opacities,4);
+	
+	/* Bind the macro cell occupancy texture: */
+	bindMacroCells(myDataItem,3);
 	}
 
 void SingleChannelRaycaster::unbindShader(Raycaster::DataItem* dataItem) const
 	{
+	/* Unbind the macro cell occupancy texture: */
+	unbindMacroCells(dataItem,3);
+	
 	/* Unbind the color map texture: */
 	glActiveTextureARB(GL_TEXTURE2_ARB);
 	glBindTexture(GL_TEXTURE_1D,0);
@@ -150,17 +221,214 @@ void SingleChannelRaycaster::unbindShader(Raycaster::DataItem* dataItem) const
 	Raycaster::unbindShader(dataItem);
 	}
 
+void SingleChannelRaycaster::drawClippedDomain(const Raycaster::PTransform& pmv,const Raycaster::PTransform& mv,const Polyhedron<Raycaster::Scalar>& clippedDomain,Raycaster::DataItem* dataItem) const
+	{
+	/* Draw a single volume texture in one go: */
+	if(brickStore==0)
+		{
+		Raycaster::drawClippedDomain(pmv,mv,clippedDomain,dataItem);
+		return;
+		}
+	
+	/* Get a pointer to the data item: */
+	DataItem* myDataItem=dynamic_cast<DataItem*>(dataItem);
+	
+	/* Invalidate all brick textures if the volume data changed: */
+	if(myDataItem->volumeTextureVersion!=dataVersion)
+		{
+		std::fill(myDataItem->textureBricks.begin(),myDataItem->textureBricks.end(),~0U);
+		std::fill(myDataItem->brickTextures.begin(),myDataItem->brickTextures.end(),~0U);
+		myDataItem->volumeTextureVersion=dataVersion;
+		}
+	
+	/* Order the texture bricks along each axis from back to front as seen from the eye position: */
+	Point eye=pmv.inverseTransform(PTransform::HVector(0,0,1,0)).toPoint();
+	std::vector<unsigned int> brickOrders[3];
+	for(int i=0;i<3;++i)
+		{
+		/* Find the index of the texture brick containing the eye along this axis: */
+		Scalar eyeVoxel=(eye[i]*Scalar(myDataItem->mcScale[i])+Scalar(myDataItem->mcOffset[i]))*Scalar(dataSize[i])-Scalar(0.5);
+		Scalar eyeBrickFloor=Math::floor(eyeVoxel/Scalar(textureBrickSize-1));
+		int eyeBrick=eyeBrickFloor<Scalar(-1)?-1:eyeBrickFloor>Scalar(numTextureBricks[i])?int(numTextureBricks[i]):int(eyeBrickFloor);
+		
+		/* Draw bricks on either side of the eye from the outside in, and the brick containing the eye last: */
+		for(int b=0;b<eyeBrick;++b)
+			brickOrders[i].push_back(b);
+		for(int b=int(numTextureBricks[i])-1;b>eyeBrick;--b)
+			brickOrders[i].push_back(b);
+		if(eyeBrick>=0&&eyeBrick<int(numTextureBricks[i]))
+			brickOrders[i].push_back(eyeBrick);
+		}
+	
+	/* Prepare uploading brick textures: */
+	GLint oldUnpackAlignment;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT,&oldUnpackAlignment);
+	glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+	std::vector<Voxel> brickVoxels;
+	glActiveTextureARB(GL_TEXTURE1_ARB);
+	
+	/* Draw all non-empty texture bricks from back to front: */
+	for(std::vector<unsigned int>::const_iterator zIt=brickOrders[2].begin();zIt!=brickOrders[2].end();++zIt)
+		for(std::vector<unsigned int>::const_iterator yIt=brickOrders[1].begin();yIt!=brickOrders[1].end();++yIt)
+			for(std::vector<unsigned int>::const_iterator xIt=brickOrders[0].begin();xIt!=brickOrders[0].end();++xIt)
+				{
+				/* Calculate the brick's voxel box; neighboring bricks overlap by one voxel to interpolate seamlessly: */
+				unsigned int brickIndex[3]={*xIt,*yIt,*zIt};
+				unsigned int brickOrigin[3],brickSize[3];
+				for(int i=0;i<3;++i)
+					{
+					brickOrigin[i]=brickIndex[i]*(textureBrickSize-1);
+					brickSize[i]=dataSize[i]-brickOrigin[i];
+					if(brickSize[i]>textureBrickSize)
+						brickSize[i]=textureBrickSize;
+					}
+				
+				/* Skip bricks that are fully transparent under the current color map: */
+				if(!isBrickOccupied(brickOrigin,brickSize))
+					continue;
+				
+				/* Calculate the brick's region between its first and last voxel centers in data and model coordinates: */
+				GLfloat dcMin[3],dcMax[3];
+				Point mcMin,mcMax;
+				for(int i=0;i<3;++i)
+					{
+					dcMin[i]=(GLfloat(brickOrigin[i])+0.5f)/GLfloat(dataSize[i]);
+					dcMax[i]=(GLfloat(brickOrigin[i]+brickSize[i])-0.5f)/GLfloat(dataSize[i]);
+					mcMin[i]=(Scalar(dcMin[i])-Scalar(myDataItem->mcOffset[i]))/Scalar(myDataItem->mcScale[i]);
+					mcMax[i]=(Scalar(dcMax[i])-Scalar(myDataItem->mcOffset[i]))/Scalar(myDataItem->mcScale[i]);
+					}
+				
+				/* Clip the clipped domain against the brick's region: */
+				Polyhedron<Scalar>* brickDomain=new Polyhedron<Scalar>(clippedDomain);
+				for(int i=0;i<3&&!brickDomain->isEmpty();++i)
+					{
+					Plane::Vector normal(Scalar(0),Scalar(0),Scalar(0));
+					normal[i]=Scalar(-1);
+					Polyhedron<Scalar>* newBrickDomain=brickDomain->clip(Plane(normal,-mcMin[i]));
+					delete brickDomain;
+					brickDomain=newBrickDomain;
+					normal[i]=Scalar(1);
+					newBrickDomain=brickDomain->clip(Plane(normal,mcMax[i]));
+					delete brickDomain;
+					brickDomain=newBrickDomain;
+					}
+				if(brickDomain->isEmpty())
+					{
+					delete brickDomain;
+					continue;
+					}
+				
+				/* Check if the brick is already held in a brick texture: */
+				unsigned int brickLinearIndex=(brickIndex[2]*numTextureBricks[1]+brickIndex[1])*numTextureBricks[0]+brickIndex[0];
+				unsigned int textureIndex=myDataItem->brickTextures[brickLinearIndex];
+				if(textureIndex!=~0U)
+					glBindTexture(GL_TEXTURE_3D,myDataItem->brickTextureIDs[textureIndex]);
+				else
+					{
+					/* Take over the least recently used brick texture: */
+					textureIndex=myDataItem->textureLru.front();
+					if(myDataItem->textureBricks[textureIndex]!=~0U)
+						myDataItem->brickTextures[myDataItem->textureBricks[textureIndex]]=~0U;
+					myDataItem->textureBricks[textureIndex]=brickLinearIndex;
+					myDataItem->brickTextures[brickLinearIndex]=textureIndex;
+					
+					/* Copy the brick's voxels out of the brick store, which pages them in from its swap file as needed: */
+					ptrdiff_t brickStrides[3];
+					brickStrides[0]=1;
+					brickStrides[1]=ptrdiff_t(brickSize[0]);
+					brickStrides[2]=ptrdiff_t(brickSize[0])*ptrdiff_t(brickSize[1]);
+					brickVoxels.resize(size_t(brickStrides[2])*size_t(brickSize[2]));
+					brickStore->copyBox(brickOrigin,brickSize,&brickVoxels[0],brickStrides);
+					
+					/* Upload the brick: */
+					glBindTexture(GL_TEXTURE_3D,myDataItem->brickTextureIDs[textureIndex]);
+					glTexSubImage3DEXT(GL_TEXTURE_3D,0,0,0,0,brickSize[0],brickSize[1],brickSize[2],GL_LUMINANCE,GL_UNSIGNED_BYTE,&brickVoxels[0]);
+					}
+				
+				/* Mark the brick texture as most recently used: */
+				myDataItem->textureLru.splice(myDataItem->textureLru.end(),myDataItem->textureLru,myDataItem->textureLruPos[textureIndex]);
+				
+				/* Set up the brick's region and the transformation from data space to brick texture space: */
+				glUniform3fvARB(myDataItem->brickMinLoc,1,dcMin);
+				glUniform3fvARB(myDataItem->brickMaxLoc,1,dcMax);
+				GLfloat texScale[3],texOffset[3];
+				for(int i=0;i<3;++i)
+					{
+					texScale[i]=GLfloat(dataSize[i])/GLfloat(textureBrickSize);
+					texOffset[i]=-GLfloat(brickOrigin[i])/GLfloat(textureBrickSize);
+					}
+				glUniform3fvARB(myDataItem->brickTexScaleLoc,1,texScale);
+				glUniform3fvARB(myDataItem->brickTexOffsetLoc,1,texOffset);
+				
+				/* Draw the brick's front faces: */
+				brickDomain->drawFaces();
+				delete brickDomain;
+				}
+	
+	/* Clean up: */
+	glBindTexture(GL_TEXTURE_3D,0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT,oldUnpackAlignment);
+	}
+
+bool SingleChannelRaycaster::isBrickOccupied(const unsigned int brickOrigin[3],const unsigned int brickSize[3]) const
+	{
+	/* Find the range of macro cells overlapping the voxel box: */
+	const unsigned int* numCells=macroCellGrid.getNumCells();
+	unsigned int cellMin[3],cellMax[3];
+	for(int i=0;i<3;++i)
+		{
+		cellMin[i]=brickOrigin[i]/macroCellGrid.getCellSize();
+		cellMax[i]=(brickOrigin[i]+brickSize[i]-1)/macroCellGrid.getCellSize();
+		if(cellMax[i]>=numCells[i])
+			cellMax[i]=numCells[i]-1;
+		}
+	
+	/* Check the macro cells: */
+	unsigned int cellIndex[3];
+	for(cellIndex[2]=cellMin[2];cellIndex[2]<=cellMax[2];++cellIndex[2])
+		for(cellIndex[1]=cellMin[1];cellIndex[1]<=cellMax[1];++cellIndex[1])
+			for(cellIndex[0]=cellMin[0];cellIndex[0]<=cellMax[0];++cellIndex[0])
+				if(macroCellGrid.isOccupied(cellIndex))
+					return true;
+	
+	return false;
+	}
+
 SingleChannelRaycaster::SingleChannelRaycaster(const unsigned int sDataSize[3],const Raycaster::Box& sDomain)
 	:Raycaster(sDataSize,sDomain),
-	 data(new Voxel[dataSize[0]*dataSize[1]*dataSize[2]]),dataVersion(0),
+	 data(new Voxel[dataSize[0]*dataSize[1]*dataSize[2]]),brickStore(0),textureBrickSize(0),dataVersion(0),
 	 colorMap(0),transparencyGamma(1.0f)
 	{
+	for(int i=0;i<3;++i)
+		numTextureBricks[i]=0;
+	}
+
+SingleChannelRaycaster::SingleChannelRaycaster(VoxelBrickStore* sBrickStore,const Raycaster::Box& sDomain)
+	:Raycaster(sBrickStore->getSize(),sDomain),
+	 data(0),brickStore(sBrickStore),textureBrickSize(2),dataVersion(0),
+	 colorMap(0),transparencyGamma(1.0f)
+	{
+	/* Render the volume data from separate brick textures: */
+	brickedTextures=true;
+	
+	/* Use power-of-two brick textures at least as large as the brick store's bricks: */
+	while(textureBrickSize<brickStore->getBrickSize())
+		textureBrickSize<<=1;
+	
+	/* Cover the voxel block with texture bricks sharing one layer of voxels with their neighbors: */
+	for(int i=0;i<3;++i)
+		{
+		numTextureBricks[i]=(dataSize[i]+textureBrickSize-3)/(textureBrickSize-1);
+		if(numTextureBricks[i]<1)
+			numTextureBricks[i]=1;
+		}
 	}
 
 SingleChannelRaycaster::~SingleChannelRaycaster(void)
 	{
 	/* Delete the volume dataset: */
 	delete[] data;
+	delete brickStore;
 	}
 
 void SingleChannelRaycaster::initContext(GLContextData& contextData) const
@@ -185,6 +453,11 @@ void SingleChannelRaycaster::initContext(GLContextData& contextData) const
 	initShader(dataItem);
 	}
 
+void SingleChannelRaycaster::setBrickTextureMemory(size_t newBrickTextureMemory)
+	{
+	brickTextureMemory=newBrickTextureMemory;
+	}
+
 void SingleChannelRaycaster::setStepSize(Raycaster::Scalar newStepSize)
 	{
 	/* Call the base class method: */
@@ -193,6 +466,30 @@ void SingleChannelRaycaster::setStepSize(Raycaster::Scalar newStepSize)
 
 void SingleChannelRaycaster::updateData(void)
 	{
+	/* Recalculate the macro cells' value ranges: */
+	macroCellGrid.resetRanges();
+	if(brickStore!=0)
+		{
+		const unsigned int* numBricks=brickStore->getNumBricks();
+		unsigned int brickIndex[3];
+		for(brickIndex[2]=0;brickIndex[2]<numBricks[2];++brickIndex[2])
+			for(brickIndex[1]=0;brickIndex[1]<numBricks[1];++brickIndex[1])
+				for(brickIndex[0]=0;brickIndex[0]<numBricks[0];++brickIndex[0])
+					{
+					unsigned int brickOrigin[3],brickExtent[3];
+					brickStore->getBrickBox(brickIndex,brickOrigin,brickExtent);
+					ptrdiff_t brickStrides[3];
+					brickStore->getBrickStrides(brickIndex,brickStrides);
+					macroCellGrid.updateRanges(0,brickOrigin,brickExtent,brickStore->lockBrick(brickIndex,false),brickStrides);
+					brickStore->unlockBrick(brickIndex);
+					}
+		}
+	else
+		{
+		unsigned int blockOrigin[3]={0,0,0};
+		macroCellGrid.updateRanges(0,blockOrigin,dataSize,data,dataStrides);
+		}
+	
 	/* Bump up the data version number: */
 	++dataVersion;
 	}
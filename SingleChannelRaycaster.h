@@ -23,11 +23,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef SINGLECHANNELRAYCASTER_INCLUDED
 #define SINGLECHANNELRAYCASTER_INCLUDED
 
+#include <list>
+#include <vector>
 #include <GL/gl.h>
 #include <GL/GLColorMap.h>
 
 #include <Raycaster.h>
 
+/* Forward declarations: */
+class VoxelBrickStore;
+
 class SingleChannelRaycaster:public Raycaster
 	{
 	/* Embedded classes: */
@@ -44,8 +49,18 @@ class SingleChannelRaycaster:public Raycaster
 		unsigned int volumeTextureVersion; // Version number of volume data texture
 		GLuint colorMapTextureID; // Texture object ID for stepsize-adjusted color map texture
 		
+		std::vector<GLuint> brickTextureIDs; // Texture object IDs of the bounded set of brick textures if the volume dataset is stored in a brick store
+		std::vector<unsigned int> textureBricks; // Index of the texture brick held by each brick texture, or ~0U if the brick texture is unused
+		std::vector<unsigned int> brickTextures; // Index of the brick texture holding each texture brick, or ~0U if the texture brick is not resident
+		std::list<unsigned int> textureLru; // List of brick textures, from least to most recently used
+		std::vector<std::list<unsigned int>::iterator> textureLruPos; // Position of each brick texture in the usage list
+		
 		int volumeSamplerLoc; // Location of the volume data texture sampler
 		int colorMapSamplerLoc; // Location of the color map texture sampler
+		int brickMinLoc; // Location of the lower corner of the current brick in data coordinates
+		int brickMaxLoc; // Location of the upper corner of the current brick in data coordinates
+		int brickTexScaleLoc; // Location of the scale factors from data coordinates to brick texture coordinates
+		int brickTexOffsetLoc; // Location of the offset from data coordinates to brick texture coordinates
 		
 		/* Constructors and destructors: */
 		DataItem(void);
@@ -53,8 +68,14 @@ class SingleChannelRaycaster:public Raycaster
 		};
 	
 	/* Elements: */
+	private:
+	static size_t brickTextureMemory; // Maximum total size of brick textures per OpenGL context in bytes
+	
 	protected:
-	Voxel* data; // Pointer to the volume dataset
+	Voxel* data; // Pointer to the volume dataset; null if the dataset is stored in a brick store
+	VoxelBrickStore* brickStore; // Pointer to the brick store holding the volume dataset; null if the dataset is stored in a single voxel block
+	unsigned int textureBrickSize; // Edge length of a brick texture; neighboring texture bricks share one layer of voxels
+	unsigned int numTextureBricks[3]; // Number of texture bricks covering the brick store's voxel block in each dimension
 	unsigned int dataVersion; // Version number of the volume dataset to track changes
 	const GLColorMap* colorMap; // Pointer to the color map
 	GLfloat transparencyGamma; // Adjustment factor for color map's overall opacity
@@ -65,10 +86,13 @@ class SingleChannelRaycaster:public Raycaster
 	virtual void initShader(Raycaster::DataItem* dataItem) const;
 	virtual void bindShader(const PTransform& pmv,const PTransform& mv,Raycaster::DataItem* dataItem) const;
 	virtual void unbindShader(Raycaster::DataItem* dataItem) const;
+	virtual void drawClippedDomain(const PTransform& pmv,const PTransform& mv,const Polyhedron<Scalar>& clippedDomain,Raycaster::DataItem* dataItem) const;
+	bool isBrickOccupied(const unsigned int brickOrigin[3],const unsigned int brickSize[3]) const; // Returns true if any macro cell overlapping the given voxel box is not fully transparent
 	
 	/* Constructors and destructors: */
 	public:
 	SingleChannelRaycaster(const unsigned int sDataSize[3],const Box& sDomain); // Creates a volume renderer
+	SingleChannelRaycaster(VoxelBrickStore* sBrickStore,const Box& sDomain); // Creates a volume renderer for the volume dataset in the given brick store; raycaster inherits brick store object
 	virtual ~SingleChannelRaycaster(void); // Destroys the raycaster
 	
 	/* Methods from GLObject: */
@@ -78,6 +102,11 @@ class SingleChannelRaycaster:public Raycaster
 	virtual void setStepSize(Scalar newStepSize);
 	
 	/* New methods: */
+	static size_t getBrickTextureMemory(void) // Returns the maximum total size of brick textures per OpenGL context
+		{
+		return brickTextureMemory;
+		}
+	static void setBrickTextureMemory(size_t newBrickTextureMemory); // Sets the maximum total size of brick textures per OpenGL context for subsequently initialized contexts
 	const Voxel* getData(void) const // Returns pointer to the volume dataset
 		{
 		return data;
@@ -86,6 +115,10 @@ class SingleChannelRaycaster:public Raycaster
 		{
 		return data;
 		}
+	VoxelBrickStore* getBrickStore(void) const // Returns pointer to the brick store holding the volume dataset
+		{
+		return brickStore;
+		}
 	virtual void updateData(void); // Notifies the raycaster that the volume dataset has changed
 	const GLColorMap* getColorMap(void) const // Returns the raycaster's color map
 		{
@@ -0,0 +1,400 @@
+/***********************************************************************
+StreamsurfaceExtractorTest - Headless program to check watertightness
+and the triangle budget of adaptively refined stream surfaces in an
+analytic turbulent flow field.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+#include <map>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+#define NONSTANDARD_GLVERTEX_TEMPLATES
+#include <GL/gl.h>
+#include <GL/GLVertex.h>
+
+#include <Templatized/Cartesian.h>
+#include <Templatized/VectorExtractor.h>
+#include <Templatized/VectorScalarExtractor.h>
+#include <Templatized/StreamsurfaceExtractor.h>
+#include <Concrete/Noise.h>
+
+class TestSurface // Stream surface representation recording the surface layer of each vertex
+	{
+	/* Embedded classes: */
+	public:
+	typedef GLVertex<double,1,void,0,double,double,3> Vertex; // Data type for stream surface vertices, as used by the stream surface visualization element
+	typedef GLuint Index; // Type for vertex indices
+	
+	/* Elements: */
+	std::vector<Vertex> vertices; // Array of surface vertices
+	std::vector<unsigned int> vertexLayers; // Array of the surface layer index of each vertex
+	std::vector<Index> triangles; // Array of vertex index triples
+	unsigned int currentLayer; // Index of the surface layer currently being created
+	Vertex nextVertex; // Vertex currently being written by the stream surface extractor
+	Index nextTriangle[3]; // Triangle currently being written by the stream surface extractor
+	
+	/* Constructors and destructors: */
+	TestSurface(void)
+		:currentLayer(0)
+		{
+		}
+	
+	/* Methods: */
+	Vertex* getNextVertex(void)
+		{
+		return &nextVertex;
+		}
+	Index addVertex(void)
+		{
+		vertices.push_back(nextVertex);
+		vertexLayers.push_back(currentLayer);
+		return Index(vertices.size()-1);
+		}
+	Index* getNextTriangle(void)
+		{
+		return nextTriangle;
+		}
+	void addTriangle(void)
+		{
+		for(int i=0;i<3;++i)
+			triangles.push_back(nextTriangle[i]);
+		}
+	void flush(void)
+		{
+		}
+	size_t getElementSize(void) const // Returns the number of triangles, like the stream surface visualization element
+		{
+		return triangles.size()/3;
+		}
+	};
+
+/* Types of the test data set and stream surface extractor: */
+typedef Geometry::Vector<float,3> Value;
+typedef Visualization::Templatized::Cartesian<double,3,Value> DS;
+typedef Visualization::Templatized::VectorExtractor<Value,Value> VE;
+typedef Visualization::Templatized::ScalarExtractor<float,Value> SE;
+typedef Visualization::Templatized::StreamsurfaceExtractor<DS,VE,SE,TestSurface> SSE;
+
+class ExtractionLimit // Continue functor limiting the number of surface layers and triangles, and monitoring the front size
+	{
+	/* Elements: */
+	private:
+	TestSurface& surface; // The monitored stream surface
+	const SSE& sse; // The stream surface extractor
+	unsigned int maxNumLayers; // Maximum number of surface layers to create
+	size_t maxNumTriangles; // Triangle budget, checked between layers like the stream surface extractor wrapper does
+	unsigned int& maxNumFrontStreamlines; // Largest front observed between layers
+	
+	/* Constructors and destructors: */
+	public:
+	ExtractionLimit(TestSurface& sSurface,const SSE& sSse,unsigned int sMaxNumLayers,size_t sMaxNumTriangles,unsigned int& sMaxNumFrontStreamlines)
+		:surface(sSurface),sse(sSse),maxNumLayers(sMaxNumLayers),maxNumTriangles(sMaxNumTriangles),maxNumFrontStreamlines(sMaxNumFrontStreamlines)
+		{
+		}
+	
+	/* Methods: */
+	bool operator()(void) const
+		{
+		if(maxNumFrontStreamlines<sse.getNumFrontStreamlines())
+			maxNumFrontStreamlines=sse.getNumFrontStreamlines();
+		if(surface.currentLayer+1>=maxNumLayers||surface.getElementSize()>=maxNumTriangles)
+			return false;
+		++surface.currentLayer;
+		return true;
+		}
+	};
+
+struct SurfaceMetrics // Structure for topological metrics of an extracted stream surface
+	{
+	/* Elements: */
+	public:
+	size_t numDegenerateTriangles; // Number of triangles with repeated or invalid vertex indices
+	size_t numBoundaryEdges; // Number of edges used by exactly one triangle
+	size_t numGapEdges; // Number of boundary edges not on the first or last surface layer, i.e., tears in the surface
+	size_t numNonManifoldEdges; // Number of edges used by more than two triangles
+	};
+
+SurfaceMetrics calcSurfaceMetrics(const TestSurface& surface) // Counts boundary, gap, and non-manifold edges of a stream surface
+	{
+	SurfaceMetrics result;
+	result.numDegenerateTriangles=0;
+	result.numBoundaryEdges=0;
+	result.numGapEdges=0;
+	result.numNonManifoldEdges=0;
+	
+	/* Count the number of triangles sharing each edge: */
+	typedef std::pair<TestSurface::Index,TestSurface::Index> Edge;
+	std::map<Edge,unsigned int> edgeCounts;
+	size_t numVertices=surface.vertices.size();
+	for(size_t i=0;i<surface.triangles.size();i+=3)
+		{
+		const TestSurface::Index* t=&surface.triangles[i];
+		if(t[0]>=numVertices||t[1]>=numVertices||t[2]>=numVertices||t[0]==t[1]||t[1]==t[2]||t[2]==t[0])
+			{
+			++result.numDegenerateTriangles;
+			continue;
+			}
+		for(int j=0;j<3;++j)
+			{
+			TestSurface::Index i0=t[j];
+			TestSurface::Index i1=t[(j+1)%3];
+			++edgeCounts[i0<i1?Edge(i0,i1):Edge(i1,i0)];
+			}
+		}
+	
+	/* Classify the edges; a watertight surface only has boundary edges along its first and last layers: */
+	for(std::map<Edge,unsigned int>::const_iterator ecIt=edgeCounts.begin();ecIt!=edgeCounts.end();++ecIt)
+		{
+		if(ecIt->second==1)
+			{
+			++result.numBoundaryEdges;
+			unsigned int l0=surface.vertexLayers[ecIt->first.first];
+			unsigned int l1=surface.vertexLayers[ecIt->first.second];
+			if(l0!=l1||(l0!=0&&l0!=surface.currentLayer))
+				++result.numGapEdges;
+			}
+		else if(ecIt->second>2)
+			++result.numNonManifoldEdges;
+		}
+	
+	return result;
+	}
+
+bool check(bool condition,const char* description,unsigned int& numFailures) // Reports the outcome of a single check
+	{
+	std::cout<<(condition?"  passed: ":"  FAILED: ")<<description<<std::endl;
+	if(!condition)
+		++numFailures;
+	return condition;
+	}
+
+struct ExtractionResult // Structure for the outcome of a single stream surface extraction
+	{
+	/* Elements: */
+	public:
+	TestSurface surface; // The extracted stream surface
+	SurfaceMetrics metrics; // Topological metrics of the extracted stream surface
+	unsigned int maxNumFrontStreamlines; // Largest front observed between layers
+	unsigned int numExits; // Number of streamlines that left the data set's domain
+	double maxSpacingRatio; // Largest distance between connected streamlines in any layer, relative to the seed spacing
+	double time; // Extraction time in seconds
+	};
+
+void extractTube(SSE& sse,const DS& ds,unsigned int numStreamlines,double radius,unsigned int maxNumLayers,size_t maxNumTriangles,ExtractionResult& result) // Extracts a stream surface from a circle of seed points in the domain's bottom plane
+	{
+	/* Seed a closed circle of streamlines, as the stream surface extractor wrapper does: */
+	DS::Point center=Geometry::mid(ds.getDomainBox().min,ds.getDomainBox().max);
+	center[2]=ds.getDomainBox().min[2]+ds.calcAverageCellSize();
+	sse.setClosed(true);
+	sse.setNumStreamlines(numStreamlines);
+	for(unsigned int i=0;i<numStreamlines;++i)
+		{
+		double angle=2.0*Math::Constants<double>::pi*double(i)/double(numStreamlines);
+		DS::Point p=center;
+		p[0]+=Math::cos(angle)*radius;
+		p[1]+=Math::sin(angle)*radius;
+		DS::Locator locator=ds.getLocator();
+		locator.locatePoint(p);
+		sse.initializeStreamline(i,p,locator);
+		}
+	
+	/* Extract the stream surface: */
+	Misc::Timer timer;
+	result.maxNumFrontStreamlines=0;
+	sse.startStreamsurface(result.surface);
+	sse.continueStreamsurface(ExtractionLimit(result.surface,sse,maxNumLayers,maxNumTriangles,result.maxNumFrontStreamlines));
+	timer.elapse();
+	result.time=timer.getTime();
+	result.numExits=(unsigned int)(numStreamlines+sse.getNumInsertions()-sse.getNumRemovals())-sse.getNumFrontStreamlines();
+	result.maxSpacingRatio=sse.getSeedSpacing()>0.0?sse.getMaxFrontSpacing()/sse.getSeedSpacing():0.0;
+	sse.finishStreamsurface();
+	result.metrics=calcSurfaceMetrics(result.surface);
+	
+	std::cout<<"  layers           : "<<sse.getNumLayers()<<", "<<result.surface.vertices.size()<<" vertices, "<<result.surface.getElementSize()<<" triangles, "<<result.time*1000.0<<" ms"<<std::endl;
+	std::cout<<"  front            : "<<sse.getNumInsertions()<<" insertions, "<<sse.getNumRemovals()<<" removals, at most "<<result.maxNumFrontStreamlines<<" streamlines, "<<result.numExits<<" left the domain"<<std::endl;
+	std::cout<<"  spacing          : seed spacing "<<sse.getSeedSpacing()<<", maximum front spacing "<<result.maxSpacingRatio<<" times seed spacing"<<std::endl;
+	std::cout<<"  edges            : "<<result.metrics.numBoundaryEdges<<" boundary, "<<result.metrics.numGapEdges<<" gap, "<<result.metrics.numNonManifoldEdges<<" non-manifold, "<<result.metrics.numDegenerateTriangles<<" degenerate triangles"<<std::endl;
+	}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	int gridSize=64; // Number of vertices along each axis of the test grid
+	unsigned int numStreamlines=32; // Number of seed streamlines
+	double strain=2.5; // Strain rate of the flow stretching the stream surface along x and compressing it along y
+	double turbulence=0.25; // Magnitude of the turbulent component of the flow
+	size_t maxNumTriangles=8000; // Triangle budget for the budget check
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"size")==0)
+				{
+				++i;
+				if(i<argc)
+					gridSize=atoi(argv[i]);
+				else
+					std::cerr<<"StreamsurfaceExtractorTest: ignored dangling -size option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"streamlines")==0)
+				{
+				++i;
+				if(i<argc)
+					numStreamlines=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"StreamsurfaceExtractorTest: ignored dangling -streamlines option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"strain")==0)
+				{
+				++i;
+				if(i<argc)
+					strain=atof(argv[i]);
+				else
+					std::cerr<<"StreamsurfaceExtractorTest: ignored dangling -strain option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"turbulence")==0)
+				{
+				++i;
+				if(i<argc)
+					turbulence=atof(argv[i]);
+				else
+					std::cerr<<"StreamsurfaceExtractorTest: ignored dangling -turbulence option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"triangles")==0)
+				{
+				++i;
+				if(i<argc)
+					maxNumTriangles=size_t(atol(argv[i]));
+				else
+					std::cerr<<"StreamsurfaceExtractorTest: ignored dangling -triangles option"<<std::endl;
+				}
+			else
+				std::cerr<<"StreamsurfaceExtractorTest: ignored unrecognized option "<<argv[i]<<std::endl;
+			}
+		}
+	if(gridSize<8||numStreamlines<4||maxNumTriangles==0)
+		{
+		std::cerr<<"StreamsurfaceExtractorTest: invalid test parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create a Cartesian grid spanning [0, 1]^3 and sample a strained upward flow with a turbulent component from the turbulence generator's noise function: */
+	DS::Index numVertices(gridSize,gridSize,gridSize);
+	DS::Size cellSize;
+	for(int i=0;i<3;++i)
+		cellSize[i]=1.0/double(gridSize-1);
+	DS ds(numVertices,cellSize);
+	Visualization::Concrete::Noise ns(5,3);
+	double turbulenceMean[3]={0.0,0.0,0.0};
+	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		Value& v=ds.getVertexValue(index);
+		for(int i=0;i<3;++i)
+			{
+			Visualization::Concrete::Noise::Point p;
+			for(int j=0;j<3;++j)
+				p[j]=float(index[j])*0.05f+float(i)*10.0f;
+			v[i]=ns.calcTurbulence(p,4);
+			turbulenceMean[i]+=double(v[i]);
+			}
+		}
+	for(int i=0;i<3;++i)
+		turbulenceMean[i]/=double(ds.getTotalNumVertices());
+	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		DS::Point p=ds.getVertexPosition(index);
+		Value& v=ds.getVertexValue(index);
+		v[0]=float(strain*(p[0]-0.5)+turbulence*(double(v[0])-turbulenceMean[0]));
+		v[1]=float(-strain*(p[1]-0.5)+turbulence*(double(v[1])-turbulenceMean[1]));
+		v[2]=float(1.0+turbulence*(double(v[2])-turbulenceMean[2]));
+		}
+	
+	/* Trace the stream surfaces for a bit more than half the domain's height, so that no streamline leaves the domain: */
+	double stepSize=ds.calcAverageCellSize()*0.25;
+	unsigned int maxNumLayers=(unsigned int)(Math::floor(0.6/stepSize));
+	double radius=0.1;
+	std::cout<<"Grid size          : "<<gridSize<<"^3 vertices"<<std::endl;
+	std::cout<<"Seed circle        : "<<numStreamlines<<" streamlines, radius "<<radius<<", "<<maxNumLayers<<" layers"<<std::endl;
+	
+	unsigned int numFailures=0;
+	
+	/* Extract a stream surface without front adaptation as reference: */
+	std::cout<<"Fixed front:"<<std::endl;
+	ExtractionResult fixed;
+	{
+	SSE sse(&ds,VE(),SE());
+	sse.setStepSize(stepSize);
+	sse.setSpacingFactors(0.0,1.0e30);
+	extractTube(sse,ds,numStreamlines,radius,maxNumLayers,~size_t(0),fixed);
+	}
+	check(fixed.numExits==0,"no streamline left the domain",numFailures);
+	check(fixed.metrics.numDegenerateTriangles==0&&fixed.metrics.numNonManifoldEdges==0,"surface is a manifold without degenerate triangles",numFailures);
+	check(fixed.metrics.numGapEdges==0,"surface is watertight between its first and last layers",numFailures);
+	
+	/* Extract a stream surface with front refinement and coarsening: */
+	std::cout<<"Adaptive front:"<<std::endl;
+	ExtractionResult adaptive;
+	{
+	SSE sse(&ds,VE(),SE());
+	sse.setStepSize(stepSize);
+	extractTube(sse,ds,numStreamlines,radius,maxNumLayers,~size_t(0),adaptive);
+	check(sse.getNumInsertions()>0,"streamlines were inserted where the flow diverges",numFailures);
+	check(sse.getNumRemovals()>0,"streamlines were removed where the flow converges",numFailures);
+	check(adaptive.maxSpacingRatio<=1.25*double(sse.getMaxSpacingFactor()),"front spacing stays close to the refinement threshold",numFailures);
+	}
+	check(adaptive.numExits==0,"no streamline left the domain",numFailures);
+	check(adaptive.metrics.numDegenerateTriangles==0&&adaptive.metrics.numNonManifoldEdges==0,"surface is a manifold without degenerate triangles",numFailures);
+	check(adaptive.metrics.numGapEdges==0,"surface is watertight across inserted and removed streamlines",numFailures);
+	check(adaptive.maxSpacingRatio<fixed.maxSpacingRatio,"front adaptation reduces the maximum front spacing",numFailures);
+	
+	/* Extract a stream surface under a front size limit and a triangle budget: */
+	std::cout<<"Budgeted front:"<<std::endl;
+	ExtractionResult budgeted;
+	unsigned int maxNumFrontStreamlines=numStreamlines+numStreamlines/4;
+	{
+	SSE sse(&ds,VE(),SE());
+	sse.setStepSize(stepSize);
+	sse.setMaxNumFrontStreamlines(maxNumFrontStreamlines);
+	extractTube(sse,ds,numStreamlines,radius,maxNumLayers,maxNumTriangles,budgeted);
+	}
+	size_t maxNumLayerTriangles=size_t(maxNumFrontStreamlines)*2;
+	check(budgeted.maxNumFrontStreamlines<=maxNumFrontStreamlines,"front never exceeds the streamline limit",numFailures);
+	check(budgeted.maxNumFrontStreamlines==maxNumFrontStreamlines,"front refinement ran into the streamline limit",numFailures);
+	check(budgeted.surface.getElementSize()>=maxNumTriangles||budgeted.surface.currentLayer+1==maxNumLayers,"extraction ran until the triangle budget or the layer limit was reached",numFailures);
+	check(budgeted.surface.getElementSize()<maxNumTriangles+maxNumLayerTriangles,"triangle budget is exceeded by at most one surface layer",numFailures);
+	check(budgeted.surface.getElementSize()<=size_t(budgeted.surface.currentLayer)*maxNumLayerTriangles,"no surface layer has more than two triangles per front streamline",numFailures);
+	check(budgeted.metrics.numDegenerateTriangles==0&&budgeted.metrics.numNonManifoldEdges==0,"surface is a manifold without degenerate triangles",numFailures);
+	check(budgeted.metrics.numGapEdges==0,"surface is watertight under the triangle budget",numFailures);
+	
+	if(numFailures!=0)
+		{
+		std::cout<<numFailures<<" check(s) failed"<<std::endl;
+		return 1;
+		}
+	std::cout<<"All checks passed"<<std::endl;
+	return 0;
+	}
@@ -61,9 +61,9 @@ Cartesian<ScalarParam,dimensionParam,ValueParam>::Cell::getVertexID(
 	{
 	// TODO: Try which version is faster
 	#if 1
-	return VertexID(VertexID::Index((baseVertex-ds->vertices.getArray())+ds->vertexOffsets[vertexIndex]));
+	return VertexID(VertexID::Index((baseVertex-ds->vertexArray)+ds->vertexOffsets[vertexIndex]));
 	#else
-	return VertexID(VertexID::Index(ds->vertices.calcLinearIndex(index)+ds->vertexOffsets[vertexIndex]));
+	return VertexID(VertexID::Index(ds->numVertices.calcOffset(index)+ds->vertexOffsets[vertexIndex]));
 	#endif
 	}
 
@@ -124,7 +124,7 @@ typename Cartesian<ScalarParam,dimensionParam,ValueParam>::EdgeID
 Cartesian<ScalarParam,dimensionParam,ValueParam>::Cell::getEdgeID(
 	int edgeIndex) const
 	{
-	EdgeID::Index index(baseVertex-ds->vertices.getArray());
+	EdgeID::Index index(baseVertex-ds->vertexArray);
 	index+=ds->vertexOffsets[CellTopology::edgeVertexIndices[edgeIndex][0]];
 	index*=dimension;
 	index+=edgeIndex>>(dimension-1);
@@ -160,9 +160,9 @@ Cartesian<ScalarParam,dimensionParam,ValueParam>::Cell::getNeighbourID(
 	{
 	// TODO: Try which version is faster
 	#if 1
-	CellID::Index baseIndex(baseVertex-ds->vertices.getArray());
+	CellID::Index baseIndex(baseVertex-ds->vertexArray);
 	#else
-	CellID::Index baseIndex(ds->vertices.calcLinearIndex(index));
+	CellID::Index baseIndex(ds->numVertices.calcOffset(index));
 	#endif
 	int direction=neighbourIndex>>1;
 	if(neighbourIndex&0x1)
@@ -234,7 +234,7 @@ Cartesian<ScalarParam,dimensionParam,ValueParam>::Locator::locatePoint(
 		}
 	
 	/* Update the cell's base vertex: */
-	baseVertex=ds->vertices.getAddress(index);
+	baseVertex=ds->vertexArray+ds->numVertices.calcOffset(index);
 	
 	return result;
 	}
@@ -327,7 +327,7 @@ Cartesian<ScalarParam,dimensionParam,ValueParam>::calcVertexGradient(
 	const ScalarExtractorParam& extractor) const
 	{
 	Vector result;
-	const Value* vertex=vertices.getAddress(vertexIndex);
+	const Value* vertex=vertexArray+numVertices.calcOffset(vertexIndex);
 	for(int i=0;i<dimension;++i)
 		{
 		if(vertexIndex[i]==0)
@@ -360,11 +360,59 @@ Cartesian<ScalarParam,dimensionParam,ValueParam>::calcVertexGradient(
 	return result;
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueParam>
+inline
+void
+Cartesian<ScalarParam,dimensionParam,ValueParam>::initStructure(
+	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Size& sCellSize)
+	{
+	/* Initialize vertex stride array: */
+	for(int i=0;i<dimension;++i)
+		vertexStrides[i]=numVertices.calcIncrement(i);
+	
+	/* Initialize the cell size: */
+	cellSize=sCellSize;
+	
+	/* Calculate number of cells: */
+	for(int i=0;i<dimension;++i)
+		numCells[i]=numVertices[i]-1;
+	
+	/* Initialize vertex offset array: */
+	for(int i=0;i<CellTopology::numVertices;++i)
+		{
+		/* Vertex indices are, as usual, bit masks of a vertex' position in cell coordinates: */
+		vertexOffsets[i]=0;
+		for(int j=0;j<dimension;++j)
+			if(i&(1<<j))
+				vertexOffsets[i]+=vertexStrides[j];
+		}
+	
+	/* Initialize vertex list bounds: */
+	Index vertexIndex(0);
+	firstVertex=Vertex(this,vertexIndex);
+	vertexIndex[0]=numVertices[0];
+	lastVertex=Vertex(this,vertexIndex);
+	
+	/* Initialize cell list bounds: */
+	Index cellIndex(0);
+	firstCell=Cell(this,cellIndex);
+	cellIndex[0]=numCells[0];
+	lastCell=Cell(this,cellIndex);
+	
+	/* Initialize domain bounding box: */
+	Point domainMax;
+	for(int i=0;i<dimension;++i)
+		domainMax[i]=Scalar(numCells[i])*cellSize[i];
+	domainBox=Box(Point::origin,domainMax);
+	}
+
 template <class ScalarParam,int dimensionParam,class ValueParam>
 inline
 Cartesian<ScalarParam,dimensionParam,ValueParam>::Cartesian(
 	void)
 	:numVertices(0),
+	 vertexArray(0),
+	 vertexStorage(0),
 	 numCells(0),
 	 cellSize(Scalar(0)),
 	 domainBox(Box::empty)
@@ -394,16 +442,32 @@ Cartesian<ScalarParam,dimensionParam,ValueParam>::Cartesian(
 	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Index& sNumVertices,
 	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Size& sCellSize,
 	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Value* sVertexValues)
+	:vertexArray(0),
+	 vertexStorage(0)
 	{
 	setData(sNumVertices,sCellSize,sVertexValues);
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueParam>
+inline
+Cartesian<ScalarParam,dimensionParam,ValueParam>::Cartesian(
+	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Index& sNumVertices,
+	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Size& sCellSize,
+	typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Value* sVertexValues,
+	ExternalStorage* sVertexStorage)
+	:vertexArray(0),
+	 vertexStorage(0)
+	{
+	adoptData(sNumVertices,sCellSize,sVertexValues,sVertexStorage);
+	}
+
 template <class ScalarParam,int dimensionParam,class ValueParam>
 inline
 Cartesian<ScalarParam,dimensionParam,ValueParam>::~Cartesian(
 	void)
 	{
-	/* Nothing to do, incidentally... */
+	/* Release adopted vertex storage: */
+	delete vertexStorage;
 	}
 
 template <class ScalarParam,int dimensionParam,class ValueParam>
@@ -414,48 +478,17 @@ Cartesian<ScalarParam,dimensionParam,ValueParam>::setData(
 	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Size& sCellSize,
 	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Value* sVertexValues)
 	{
+	/* Release previously adopted vertex storage: */
+	delete vertexStorage;
+	vertexStorage=0;
+	
 	/* Resize the vertex array: */
 	numVertices=sNumVertices;
 	vertices.resize(numVertices);
+	vertexArray=vertices.getArray();
 	
-	/* Initialize vertex stride array: */
-	for(int i=0;i<dimension;++i)
-		vertexStrides[i]=numVertices.calcIncrement(i);
-	
-	/* Initialize the cell size: */
-	cellSize=sCellSize;
-	
-	/* Calculate number of cells: */
-	for(int i=0;i<dimension;++i)
-		numCells[i]=numVertices[i]-1;
-	
-	/* Initialize vertex offset array: */
-	for(int i=0;i<CellTopology::numVertices;++i)
-		{
-		/* Vertex indices are, as usual, bit masks of a vertex' position in cell coordinates: */
-		vertexOffsets[i]=0;
-		for(int j=0;j<dimension;++j)
-			if(i&(1<<j))
-				vertexOffsets[i]+=vertexStrides[j];
-		}
-	
-	/* Initialize vertex list bounds: */
-	Index vertexIndex(0);
-	firstVertex=Vertex(this,vertexIndex);
-	vertexIndex[0]=numVertices[0];
-	lastVertex=Vertex(this,vertexIndex);
-	
-	/* Initialize cell list bounds: */
-	Index cellIndex(0);
-	firstCell=Cell(this,cellIndex);
-	cellIndex[0]=numCells[0];
-	lastCell=Cell(this,cellIndex);
-	
-	/* Initialize domain bounding box: */
-	Point domainMax;
-	for(int i=0;i<dimension;++i)
-		domainMax[i]=Scalar(numCells[i])*cellSize[i];
-	domainBox=Box(Point::origin,domainMax);
+	/* Initialize the grid structure: */
+	initStructure(sCellSize);
 	
 	/* Copy source vertex values, if present: */
 	if(sVertexValues!=0)
@@ -468,6 +501,29 @@ Cartesian<ScalarParam,dimensionParam,ValueParam>::setData(
 		}
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueParam>
+inline
+void
+Cartesian<ScalarParam,dimensionParam,ValueParam>::adoptData(
+	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Index& sNumVertices,
+	const typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Size& sCellSize,
+	typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Value* sVertexValues,
+	ExternalStorage* sVertexStorage)
+	{
+	/* Release the owned vertex array and any previously adopted vertex storage: */
+	vertices.resize(Index(0));
+	if(vertexStorage!=sVertexStorage)
+		delete vertexStorage;
+	
+	/* Adopt the given vertex storage: */
+	numVertices=sNumVertices;
+	vertexArray=sVertexValues;
+	vertexStorage=sVertexStorage;
+	
+	/* Initialize the grid structure: */
+	initStructure(sCellSize);
+	}
+
 
 template <class ScalarParam,int dimensionParam,class ValueParam>
 inline
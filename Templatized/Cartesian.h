@@ -29,9 +29,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
 
+#include <Templatized/ExternalStorage.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/LocatorBatch.h>
 
 namespace Visualization {
 
@@ -91,7 +93,7 @@ class Cartesian
 		template <class ValueExtractorParam>
 		typename ValueExtractorParam::DestValue getValue(const ValueExtractorParam& extractor) const // Returns vertex' value based on given extractor
 			{
-			return extractor.getValue(ds->vertices(index));
+			return extractor.getValue(ds->vertexArray[ds->numVertices.calcOffset(index)]);
 			}
 		template <class ScalarExtractorParam>
 		Vector calcGradient(const ScalarExtractorParam& extractor) const // Returns gradient at the vertex, based on given scalar extractor
@@ -100,7 +102,7 @@ class Cartesian
 			}
 		VertexID getID(void) const // Returns vertex' ID
 			{
-			return VertexID(VertexID::Index(ds->vertices.calcLinearIndex(index)));
+			return VertexID(VertexID::Index(ds->numVertices.calcOffset(index)));
 			}
 		
 		/* Iterator methods: */
@@ -150,7 +152,7 @@ class Cartesian
 			{
 			}
 		Cell(const Cartesian* sDs,const Index& sIndex)
-			:ds(sDs),index(sIndex),baseVertex(ds->vertices.getAddress(index))
+			:ds(sDs),index(sIndex),baseVertex(ds->vertexArray+ds->numVertices.calcOffset(index))
 			{
 			}
 		
@@ -176,9 +178,9 @@ class Cartesian
 			{
 			// TODO: Try which version is faster
 			#if 1
-			return CellID(CellID::Index(baseVertex-ds->vertices.getArray()));
+			return CellID(CellID::Index(baseVertex-ds->vertexArray));
 			#else
-			return CellID(CellID::Index(ds->vertices.calcLinearIndex(index)));
+			return CellID(CellID::Index(ds->numVertices.calcOffset(index)));
 			#endif
 			}
 		CellID getNeighbourID(int neighbourIndex) const; // Returns ID of neighbour across the given face of the cell
@@ -195,7 +197,7 @@ class Cartesian
 		Cell& operator++(void) // Pre-increment operator
 			{
 			index.preInc(ds->numCells);
-			baseVertex=ds->vertices.getAddress(index);
+			baseVertex=ds->vertexArray+ds->numVertices.calcOffset(index);
 			return *this;
 			}
 		};
@@ -237,6 +239,21 @@ class Cartesian
 		typename ValueExtractorParam::DestValue calcValue(const ValueExtractorParam& extractor) const; // Calculates value at last located position, based on given value extractor
 		template <class ScalarExtractorParam>
 		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position, based on given scalar extractor
+		template <class ValueExtractorParam>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam& extractor,typename ValueExtractorParam::DestValue values[],bool valids[]) // Locates the given positions in order and calculates their values based on given value extractor; traces first position from last located position if traceHint is true; returns number of positions inside the data set
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor,values,valids);
+			}
+		template <class ValueExtractorParam1,class ValueExtractorParam2>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam1& extractor1,typename ValueExtractorParam1::DestValue values1[],const ValueExtractorParam2& extractor2,typename ValueExtractorParam2::DestValue values2[],bool valids[]) // Ditto; calculates the values of two value extractors from a single point location per position
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor1,values1,extractor2,values2,valids);
+			}
+		template <class ScalarExtractorParam>
+		size_t calcValuesAndGradients(size_t numPoints,const Point positions[],bool traceHint,const ScalarExtractorParam& extractor,typename ScalarExtractorParam::DestValue values[],Vector gradients[],bool valids[]) // Ditto; additionally calculates gradients based on given scalar extractor
+			{
+			return batchCalcValuesAndGradients(*this,numPoints,positions,traceHint,extractor,values,gradients,valids);
+			}
 		};
 	
 	friend class Vertex;
@@ -246,7 +263,9 @@ class Cartesian
 	/* Elements: */
 	private:
 	Index numVertices; // Number of vertices in data set in each dimension
-	Array vertices; // Array of vertices defining data set
+	Array vertices; // Array of vertices defining data set, if the data set owns its vertex storage
+	Value* vertexArray; // Pointer to the data set's vertex storage; either points into the vertex array or to adopted external storage
+	ExternalStorage* vertexStorage; // Object owning adopted external vertex storage; null if the data set owns its vertex storage, or the adopted storage is owned by the caller
 	int vertexStrides[dimension]; // Array of pointer stride values in the vertex array
 	Index numCells; // Number of cells in data set in each dimension
 	int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
@@ -257,22 +276,29 @@ class Cartesian
 	
 	template <class ScalarExtractorParam>
 	Vector calcVertexGradient(const Index& vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at a vertex based on the given scalar extractor
+	void initStructure(const Size& sCellSize); // Initializes the data set's grid structure after the number of vertices and the vertex storage have been set
 	
 	/* Constructors and destructors: */
 	public:
 	Cartesian(void); // Creates an "empty" data set
 	Cartesian(const Index& sNumVertices,const Size& sCellSize,const Value* sVertexValues =0); // Creates a data set of the given number of vertices and cell size; copies vertex data if pointer is not null
+	Cartesian(const Index& sNumVertices,const Size& sCellSize,Value* sVertexValues,ExternalStorage* sVertexStorage); // Creates a data set of the given number of vertices and cell size that adopts the given vertex data without copying; takes ownership of the storage object if it is not null
 	~Cartesian(void); // Destroys the data set
 	
 	/* Data set construction methods: */
 	void setData(const Index& sNumVertices,const Size& sCellSize,const Value* sVertexValues =0); // Sets the number of vertices and cell size of the data set; copies vertex data if pointer is not null
+	void adoptData(const Index& sNumVertices,const Size& sCellSize,Value* sVertexValues,ExternalStorage* sVertexStorage); // Sets the number of vertices and cell size of the data set and adopts the given vertex data without copying; takes ownership of the storage object if it is not null, which is deleted when the data set no longer uses the vertex data
 	
 	/* Low-level data access methods: */
 	const Index& getNumVertices(void) const // Returns number of vertices in the data set
 		{
 		return numVertices;
 		}
-	const Array& getVertices(void) const // Returns the vertices defining the data set
+	bool ownsVertices(void) const // Returns true if the data set's vertices are stored in its own vertex array
+		{
+		return vertexArray==vertices.getArray();
+		}
+	const Array& getVertices(void) const // Returns the vertices defining the data set; only valid if the data set owns its vertices
 		{
 		return vertices;
 		}
@@ -280,14 +306,22 @@ class Cartesian
 		{
 		return vertices;
 		}
+	const Value* getVertexArray(void) const // Returns the data set's vertex storage as a C array
+		{
+		return vertexArray;
+		}
+	Value* getVertexArray(void) // Ditto
+		{
+		return vertexArray;
+		}
 	Point getVertexPosition(const Index& vertexIndex) const; // Returns a vertex' position
 	const Value& getVertexValue(const Index& vertexIndex) const // Returns a vertex' data value
 		{
-		return vertices(vertexIndex);
+		return vertexArray[numVertices.calcOffset(vertexIndex)];
 		}
 	Value& getVertexValue(const Index& vertexIndex) // Ditto
 		{
-		return vertices(vertexIndex);
+		return vertexArray[numVertices.calcOffset(vertexIndex)];
 		}
 	const Index& getNumCells(void) const // Returns number of cells in grid
 		{
@@ -305,7 +339,7 @@ class Cartesian
 		}
 	Vertex getVertex(const VertexID& vertexID) const // Returns vertex of given valid ID
 		{
-		return Vertex(this,vertices.calcIndex(vertexID.getIndex()));
+		return Vertex(this,numVertices.calcIndex(vertexID.getIndex()));
 		}
 	const VertexIterator& beginVertices(void) const // Returns iterator to first vertex in the data set
 		{
@@ -321,7 +355,7 @@ class Cartesian
 		}
 	Cell getCell(const CellID& cellID) const // Return cell of given valid ID
 		{
-		return Cell(this,vertices.calcIndex(cellID.getIndex()));
+		return Cell(this,numVertices.calcIndex(cellID.getIndex()));
 		}
 	const CellIterator& beginCells(void) const // Returns iterator to first cell in the data set
 		{
@@ -0,0 +1,490 @@
+/***********************************************************************
+CellBoxTree - Class for bounding volume hierarchies over the bounding
+boxes of data set cells, to quickly find all cells that can contain a
+given point.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_CELLBOXTREE_IMPLEMENTATION
+
+#include <algorithm>
+#include <Threads/Thread.h>
+#include <Math/Constants.h>
+
+#include <Templatized/CellBoxTree.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/***********************************
+Methods of class CellBoxTree::Query:
+***********************************/
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::Query::Query(
+	const CellBoxTree<ScalarParam,dimensionParam,CellIDParam>& sTree,
+	const typename CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::Point& sPosition)
+	:tree(sTree),
+	 position(sPosition),
+	 stackSize(0),
+	 leafPtr(0),leafEnd(0)
+	{
+	/* Start traversal at the root node: */
+	if(!tree.nodes.empty())
+		stack[stackSize++]=0;
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+const typename CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::CellBox*
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::Query::getNextBox(
+	void)
+	{
+	while(true)
+		{
+		/* Return the next cell box in the current leaf node that contains the query point: */
+		while(leafPtr!=leafEnd)
+			{
+			const CellBox* cbPtr=leafPtr;
+			++leafPtr;
+			if(contains(cbPtr->box,position))
+				return cbPtr;
+			}
+		
+		/* Bail out if there are no more nodes to traverse: */
+		if(stackSize==0)
+			return 0;
+		
+		/* Traverse the next node if it contains the query point: */
+		size_t nodeIndex=stack[--stackSize];
+		const Node& node=tree.nodes[nodeIndex];
+		if(contains(node.box,position))
+			{
+			if(node.numBoxes>0)
+				{
+				/* Test the leaf node's cell boxes next: */
+				leafPtr=&tree.boxes[node.first];
+				leafEnd=leafPtr+node.numBoxes;
+				}
+			else
+				{
+				/* Traverse the left child first: */
+				stack[stackSize++]=node.first;
+				stack[stackSize++]=nodeIndex+1;
+				}
+			}
+		}
+	}
+
+/********************************************
+Methods of class CellBoxTree::SubtreeBuilder:
+********************************************/
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+void*
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::SubtreeBuilder::createSubtree(
+	void)
+	{
+	tree->createSubtree(nodeIndex,first,numSubtreeBoxes,depth,numThreads);
+	
+	return 0;
+	}
+
+/****************************
+Methods of class CellBoxTree:
+****************************/
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+size_t
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::calcNumNodes(
+	size_t numSubtreeBoxes,
+	int depth)
+	{
+	/*********************************************************************
+	Median splits divide n boxes into n/2 and n-n/2 boxes, so all nodes on
+	the same level of a subtree contain either m or m+1 boxes for some m.
+	Count the nodes one level at a time:
+	*********************************************************************/
+	
+	size_t result=0;
+	size_t levelSize=numSubtreeBoxes; // Smaller number of boxes in any node on the current level
+	size_t numSmallNodes=1; // Number of nodes containing levelSize boxes on the current level
+	size_t numLargeNodes=0; // Number of nodes containing levelSize+1 boxes on the current level
+	while(true)
+		{
+		result+=numSmallNodes+numLargeNodes;
+		
+		/* Count the nodes on the current level that are split: */
+		if(depth>=maxDepth-1)
+			break;
+		size_t numSplitSmallNodes=levelSize>maxLeafSize?numSmallNodes:0;
+		size_t numSplitLargeNodes=levelSize+1>maxLeafSize?numLargeNodes:0;
+		if(numSplitSmallNodes+numSplitLargeNodes==0)
+			break;
+		
+		/* Count the children of the split nodes: */
+		if(levelSize%2==0)
+			{
+			numSmallNodes=numSplitSmallNodes*2+numSplitLargeNodes;
+			numLargeNodes=numSplitLargeNodes;
+			}
+		else
+			{
+			numSmallNodes=numSplitSmallNodes;
+			numLargeNodes=numSplitSmallNodes+numSplitLargeNodes*2;
+			}
+		levelSize/=2;
+		++depth;
+		}
+	
+	return result;
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+void
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::createSubtree(
+	size_t nodeIndex,
+	size_t first,
+	size_t numSubtreeBoxes,
+	int depth,
+	unsigned int numThreads)
+	{
+	Node& node=nodes[nodeIndex];
+	
+	/* Calculate the bounding box of all cell boxes, and the bounding box of their centers: */
+	Box box=boxes[first].box;
+	Box centerBox=Box::empty;
+	for(size_t i=first;i<first+numSubtreeBoxes;++i)
+		{
+		const Box& cb=boxes[i].box;
+		Point center;
+		for(int j=0;j<dimension;++j)
+			{
+			if(box.min[j]>cb.min[j])
+				box.min[j]=cb.min[j];
+			if(box.max[j]<cb.max[j])
+				box.max[j]=cb.max[j];
+			center[j]=(cb.min[j]+cb.max[j])*Scalar(0.5);
+			}
+		centerBox.addPoint(center);
+		}
+	node.box=box;
+	
+	/* Create a leaf node if there are few enough boxes, or the traversal stack would overflow: */
+	if(numSubtreeBoxes<=maxLeafSize||depth>=maxDepth-1)
+		{
+		node.first=first;
+		node.numBoxes=numSubtreeBoxes;
+		return;
+		}
+	
+	/* Split the cell boxes at the median of their centers along the widest extent of the centers: */
+	int axis=0;
+	for(int i=1;i<dimension;++i)
+		if(centerBox.max[i]-centerBox.min[i]>centerBox.max[axis]-centerBox.min[axis])
+			axis=i;
+	size_t numLeftBoxes=numSubtreeBoxes/2;
+	std::nth_element(boxes.begin()+first,boxes.begin()+(first+numLeftBoxes),boxes.begin()+(first+numSubtreeBoxes),CenterCompare(axis));
+	
+	/* Create the node's children; the left child immediately follows the node, and the right child follows the left child's subtree: */
+	node.numBoxes=0;
+	node.first=nodeIndex+1+calcNumNodes(numLeftBoxes,depth+1);
+	if(numThreads>1&&numSubtreeBoxes>=minThreadBoxes)
+		{
+		/* Create the right child on a separate thread while creating the left child on the calling thread: */
+		SubtreeBuilder rightBuilder;
+		rightBuilder.tree=this;
+		rightBuilder.nodeIndex=node.first;
+		rightBuilder.first=first+numLeftBoxes;
+		rightBuilder.numSubtreeBoxes=numSubtreeBoxes-numLeftBoxes;
+		rightBuilder.depth=depth+1;
+		rightBuilder.numThreads=numThreads/2;
+		Threads::Thread rightThread;
+		rightThread.start(&rightBuilder,&SubtreeBuilder::createSubtree);
+		createSubtree(nodeIndex+1,first,numLeftBoxes,depth+1,numThreads-numThreads/2);
+		rightThread.join();
+		}
+	else
+		{
+		createSubtree(nodeIndex+1,first,numLeftBoxes,depth+1,1);
+		createSubtree(node.first,first+numLeftBoxes,numSubtreeBoxes-numLeftBoxes,depth+1,1);
+		}
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+template <class LocatorParam>
+inline
+typename CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::Scalar
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::newtonRaphsonIterate(
+	LocatorParam& locator,
+	const typename CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::Point& position,
+	int maxNumSteps)
+	{
+	Scalar maxOut=Scalar(0);
+	for(int step=0;maxNumSteps<0||step<maxNumSteps;++step)
+		{
+		/* Do one step: */
+		bool converged=locator.newtonRaphsonStep(position);
+		
+		/* Check for signs of convergence failure: */
+		maxOut=Scalar(0);
+		for(int i=0;i<dimension;++i)
+			{
+			if(maxOut<-locator.cellPos[i])
+				maxOut=-locator.cellPos[i];
+			else if(maxOut<locator.cellPos[i]-Scalar(1))
+				maxOut=locator.cellPos[i]-Scalar(1);
+			}
+		if(converged||maxOut>Scalar(1)) // Tolerate at most one cell size out (this is somewhat ad-hoc)
+			break;
+		}
+	
+	return maxOut;
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::CellBoxTree(
+	void)
+	{
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+typename CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::CellBox*
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::createTree(
+	size_t numCellBoxes)
+	{
+	/* Discard the previous hierarchy: */
+	nodes.clear();
+	
+	/* Create the cell box array: */
+	boxes.clear();
+	boxes.resize(numCellBoxes);
+	return numCellBoxes>0?&boxes[0]:0;
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+void
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::releaseBoxes(
+	unsigned int numThreads)
+	{
+	/* Allocate all nodes up front, so that separate threads can create disjoint subtrees: */
+	nodes.clear();
+	if(!boxes.empty())
+		{
+		nodes.resize(calcNumNodes(boxes.size(),0));
+		
+		/* Create the hierarchy: */
+		createSubtree(0,0,boxes.size(),0,numThreads);
+		}
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+inline
+size_t
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::getMemorySize(
+	void) const
+	{
+	return sizeof(CellBoxTree)+boxes.capacity()*sizeof(CellBox)+nodes.capacity()*sizeof(Node);
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+template <class DataSinkParam>
+inline
+void
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::writeCache(
+	DataSinkParam& dataSink) const
+	{
+	/* Write the cell box array and the node array: */
+	dataSink.template write<size_t>(boxes.size());
+	if(!boxes.empty())
+		dataSink.template write<CellBox>(&boxes[0],boxes.size());
+	dataSink.template write<size_t>(nodes.size());
+	if(!nodes.empty())
+		dataSink.template write<Node>(&nodes[0],nodes.size());
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+template <class DataSourceParam>
+inline
+void
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::readCache(
+	DataSourceParam& dataSource)
+	{
+	/* Read the cell box array and the node array: */
+	boxes.resize(dataSource.template read<size_t>());
+	if(!boxes.empty())
+		dataSource.template read<CellBox>(&boxes[0],boxes.size());
+	nodes.resize(dataSource.template read<size_t>());
+	if(!nodes.empty())
+		dataSource.template read<Node>(&nodes[0],nodes.size());
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+template <class LocatorParam>
+inline
+bool
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::findStartCell(
+	LocatorParam& locator,
+	const typename CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::Point& position) const
+	{
+	#ifdef PERF_COUNTLOCATORSTEPS
+	++locator.stepCounters.numSearches;
+	#endif
+	
+	/* Test all cells whose bounding boxes contain the query position: */
+	Query query(*this,position);
+	const CellBox* bestCellBox=0;
+	Scalar bestMaxOut=Math::Constants<Scalar>::max;
+	for(const CellBox* cbPtr=query.getNextBox();cbPtr!=0;cbPtr=query.getNextBox())
+		{
+		#ifdef PERF_COUNTLOCATORSTEPS
+		++locator.stepCounters.numCandidates;
+		#endif
+		
+		/* Go to the candidate cell: */
+		locator.startCell(cbPtr->cellID);
+		
+		/* Perform a bounded number of Newton-Raphson steps until the iteration converges, or leaves the cell: */
+		Scalar maxOut=newtonRaphsonIterate(locator,position,20);
+		
+		/* Stop searching if the candidate cell contains the query position: */
+		if(maxOut==Scalar(0))
+			return true;
+		
+		/* Remember the candidate cell that came closest: */
+		if(bestMaxOut>maxOut)
+			{
+			bestCellBox=cbPtr;
+			bestMaxOut=maxOut;
+			}
+		}
+	
+	/* Bail out if no cell's bounding box contains the query position: */
+	if(bestCellBox==0)
+		return false;
+	
+	/* Start tracing from the closest candidate cell: */
+	locator.startCell(bestCellBox->cellID);
+	
+	return true;
+	}
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+template <class LocatorParam>
+inline
+bool
+CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::locatePoint(
+	LocatorParam& locator,
+	const typename CellBoxTree<ScalarParam,dimensionParam,CellIDParam>::Point& position,
+	bool traceHint) const
+	{
+	/* If traceHint parameter is false or locator is invalid, start searching from scratch: */
+	if(!traceHint||locator.cantTrace)
+		{
+		/* Start searching from a cell whose bounding box contains the query position: */
+		if(!findStartCell(locator,position)) // Bail out if no cell can contain the query position
+			return false;
+		
+		/* Now we can trace: */
+		locator.cantTrace=false;
+		}
+	
+	/* Perform Newton-Raphson iteration until it converges and the current cell contains the query point: */
+	Scalar maxOut=Scalar(0);
+	CellID previousCellID; // Cell ID to detect "thrashing" between cells
+	CellID currentCellID=locator.getCellID(); // Ditto
+	Scalar previousMaxMove=Scalar(0); // Reason we went into the current cell
+	for(int iteration=0;iteration<10;++iteration)
+		{
+		/* Perform Newton-Raphson iteration in the current cell until it converges, or goes really bad: */
+		maxOut=newtonRaphsonIterate(locator,position,-1);
+		
+		/* Check if the current cell contains the query position: */
+		if(maxOut==Scalar(0))
+			return true;
+		
+		/* Check if this was the first step, and we're way off: */
+		if(iteration==0&&maxOut>Scalar(5))
+			{
+			/* We had a tracing failure; just start searching from scratch: */
+			#ifdef PERF_COUNTLOCATORSTEPS
+			++locator.stepCounters.numRestarts;
+			#endif
+			if(!findStartCell(locator,position)) // Bail out if no cell can contain the query position
+				{
+				/* At this point, the locator is borked. Better not trace next time: */
+				locator.cantTrace=true;
+				
+				/* And we're outside the grid, too: */
+				return false;
+				}
+			
+			/* Continue from the found cell: */
+			previousCellID=currentCellID;
+			currentCellID=locator.getCellID();
+			previousMaxMove=maxOut;
+			
+			/* Start over: */
+			continue;
+			}
+		
+		/* Otherwise, try moving to a different cell: */
+		Scalar maxMove=Scalar(0);
+		if(!locator.moveToNeighbour(maxMove))
+			{
+			/* At this point, the locator is borked. Better not trace next time: */
+			locator.cantTrace=true;
+			
+			/* We're not in the current cell, and can't move anywhere else -- we're outside the grid: */
+			return false;
+			}
+		
+		#ifdef PERF_COUNTLOCATORSTEPS
+		++locator.stepCounters.numSteps;
+		#endif
+		
+		/* Check if we've just moved back into the cell we just came from: */
+		CellID nextCellID=locator.getCellID();
+		if(nextCellID==previousCellID&&maxMove<=previousMaxMove)
+			return true;
+		
+		/* Check for thrashing on the next iteration step: */
+		previousCellID=currentCellID;
+		currentCellID=nextCellID;
+		previousMaxMove=maxMove;
+		}
+	
+	/* Just to be safe, don't trace on the next step: */
+	locator.cantTrace=true;
+	
+	/* Return true if the final cell contains the query position, with some fudge: */
+	return maxOut<Scalar(1.0e-4);
+	}
+
+}
+
+}
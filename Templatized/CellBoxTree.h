@@ -0,0 +1,217 @@
+/***********************************************************************
+CellBoxTree - Class for bounding volume hierarchies over the bounding
+boxes of data set cells, to quickly find all cells that can contain a
+given point.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_CELLBOXTREE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_CELLBOXTREE_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Geometry/Point.h>
+#include <Geometry/Box.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+#ifdef PERF_COUNTLOCATORSTEPS
+struct LocatorStepCounters // Structure to count the work done by a single locator
+	{
+	/* Elements: */
+	public:
+	size_t numSearches; // Number of point location searches started from scratch
+	size_t numCandidates; // Number of candidate cells tested during searches
+	size_t numRestarts; // Number of searches restarted due to tracing failures
+	size_t numSteps; // Number of cell-to-cell steps taken while tracing
+	
+	/* Constructors and destructors: */
+	LocatorStepCounters(void)
+		:numSearches(0),numCandidates(0),numRestarts(0),numSteps(0)
+		{
+		}
+	
+	/* Methods: */
+	LocatorStepCounters& operator+=(const LocatorStepCounters& other) // Adds the counts of another locator
+		{
+		numSearches+=other.numSearches;
+		numCandidates+=other.numCandidates;
+		numRestarts+=other.numRestarts;
+		numSteps+=other.numSteps;
+		return *this;
+		}
+	LocatorStepCounters& operator-=(const LocatorStepCounters& other) // Subtracts the counts of another locator, e.g., the counts a copied locator started out with
+		{
+		numSearches-=other.numSearches;
+		numCandidates-=other.numCandidates;
+		numRestarts-=other.numRestarts;
+		numSteps-=other.numSteps;
+		return *this;
+		}
+	};
+#endif
+
+template <class ScalarParam,int dimensionParam,class CellIDParam>
+class CellBoxTree
+	{
+	/* Embedded classes: */
+	public:
+	typedef ScalarParam Scalar; // Scalar type of the data set's domain
+	static const int dimension=dimensionParam; // Dimension of the data set's domain
+	typedef Geometry::Point<Scalar,dimensionParam> Point; // Type for points in the data set's domain
+	typedef Geometry::Box<Scalar,dimensionParam> Box; // Type for axis-aligned boxes in the data set's domain
+	typedef CellIDParam CellID; // Type of the data set's cell IDs
+	
+	struct CellBox // Structure associating a cell's bounding box and its ID
+		{
+		/* Elements: */
+		public:
+		Box box; // Bounding box of all the cell's vertices
+		CellID cellID; // ID of the cell
+		};
+	
+	private:
+	static const size_t maxLeafSize=4; // Maximum number of cell boxes in a leaf node
+	static const int maxDepth=64; // Maximum depth of the hierarchy; limits size of traversal stacks
+	static const size_t minThreadBoxes=16384; // Minimum number of cell boxes in a subtree to create one of its children on a separate thread
+	
+	struct Node // Structure for hierarchy nodes
+		{
+		/* Elements: */
+		public:
+		Box box; // Bounding box of all cell boxes in the node's subtree
+		size_t first; // Index of the node's first cell box for leaves, or index of the node's right child for interior nodes (left child immediately follows the node)
+		size_t numBoxes; // Number of cell boxes in a leaf node, or zero for interior nodes
+		};
+	
+	class CenterCompare // Functor to compare cell boxes by their centers along one axis
+		{
+		/* Elements: */
+		private:
+		int axis; // Comparison axis
+		
+		/* Constructors and destructors: */
+		public:
+		CenterCompare(int sAxis)
+			:axis(sAxis)
+			{
+			}
+		
+		/* Methods: */
+		bool operator()(const CellBox& cb1,const CellBox& cb2) const
+			{
+			return cb1.box.min[axis]+cb1.box.max[axis]<cb2.box.min[axis]+cb2.box.max[axis];
+			}
+		};
+	
+	struct SubtreeBuilder // Structure to create a subtree of the hierarchy on a separate thread
+		{
+		/* Elements: */
+		public:
+		CellBoxTree* tree; // The hierarchy
+		size_t nodeIndex; // Index of the subtree's root node
+		size_t first; // Index of the subtree's first cell box
+		size_t numSubtreeBoxes; // Number of cell boxes in the subtree
+		int depth; // Depth of the subtree's root node
+		unsigned int numThreads; // Number of threads that may create the subtree
+		
+		/* Methods: */
+		void* createSubtree(void); // Creates the subtree
+		};
+	
+	public:
+	class Query // Class to enumerate all cell boxes containing a query point
+		{
+		/* Elements: */
+		private:
+		const CellBoxTree& tree; // The traversed hierarchy
+		Point position; // The query point
+		size_t stack[maxDepth*2]; // Stack of nodes still to be traversed
+		int stackSize; // Number of nodes on the stack
+		const CellBox* leafPtr; // Next cell box to test in the current leaf node
+		const CellBox* leafEnd; // End of cell boxes in the current leaf node
+		
+		/* Constructors and destructors: */
+		public:
+		Query(const CellBoxTree& sTree,const Point& sPosition); // Starts a query for the given point
+		
+		/* Methods: */
+		const CellBox* getNextBox(void); // Returns the next cell box containing the query point, or null if there are no more boxes
+		};
+	
+	friend class Query;
+	friend struct SubtreeBuilder;
+	
+	/* Elements: */
+	private:
+	std::vector<CellBox> boxes; // Array of cell boxes, in hierarchy leaf order
+	std::vector<Node> nodes; // Array of hierarchy nodes; root is first node
+	
+	/* Private methods: */
+	static bool contains(const Box& box,const Point& p) // Returns true if the closed box contains the given point
+		{
+		for(int i=0;i<dimension;++i)
+			if(p[i]<box.min[i]||p[i]>box.max[i])
+				return false;
+		return true;
+		}
+	static size_t calcNumNodes(size_t numSubtreeBoxes,int depth); // Returns the number of nodes in a subtree containing the given number of cell boxes, whose root is at the given depth
+	template <class LocatorParam>
+	static Scalar newtonRaphsonIterate(LocatorParam& locator,const Point& position,int maxNumSteps); // Performs Newton-Raphson steps in the locator's current cell until the iteration converges or leaves the cell by more than one cell size, or for at most the given number of steps if non-negative; returns the distance outside the cell in cell coordinates
+	void createSubtree(size_t nodeIndex,size_t first,size_t numSubtreeBoxes,int depth,unsigned int numThreads); // Creates the subtree for the given range of cell boxes, starting at the given node, using the given number of threads
+	
+	/* Constructors and destructors: */
+	public:
+	CellBoxTree(void); // Creates an empty hierarchy
+	private:
+	CellBoxTree(const CellBoxTree& source); // Prohibit copy constructor
+	CellBoxTree& operator=(const CellBoxTree& source); // Prohibit assignment operator
+	
+	/* Methods: */
+	public:
+	CellBox* createTree(size_t numCellBoxes); // Returns an array of cell boxes to be filled in by the caller before calling releaseBoxes()
+	void releaseBoxes(unsigned int numThreads =1); // Creates the hierarchy from the previously filled-in cell box array using the given number of threads
+	size_t getNumBoxes(void) const // Returns the number of cell boxes in the hierarchy
+		{
+		return boxes.size();
+		}
+	size_t getMemorySize(void) const; // Returns the approximate memory size of the hierarchy in bytes
+	template <class DataSinkParam>
+	void writeCache(DataSinkParam& dataSink) const; // Writes the hierarchy to a binary data sink
+	template <class DataSourceParam>
+	void readCache(DataSourceParam& dataSource); // Replaces the hierarchy with one previously written by writeCache
+	
+	/* Point location methods shared by curvilinear data set locators; the locator must befriend the hierarchy and provide cellPos, cantTrace, getCellID(), newtonRaphsonStep(position), startCell(cellID), and moveToNeighbour(maxMove): */
+	template <class LocatorParam>
+	bool findStartCell(LocatorParam& locator,const Point& position) const; // Moves the locator to the cell most likely containing the given position among all cells whose bounding boxes contain it; returns false if there are no such cells
+	template <class LocatorParam>
+	bool locatePoint(LocatorParam& locator,const Point& position,bool traceHint) const; // Sets the locator to the given position by tracing from its current cell, or by searching from scratch if traceHint is false or tracing fails; returns true if the position is inside the found cell
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_CELLBOXTREE_IMPLEMENTATION
+#include <Templatized/CellBoxTree.cpp>
+#endif
+
+#endif
@@ -0,0 +1,284 @@
+/***********************************************************************
+CellValueRangeTree - Class to index blocks of data set cells by the
+range of scalar values they span, to quickly find all cells that can
+intersect an isosurface of a given isovalue.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_CELLVALUERANGETREE_IMPLEMENTATION
+
+#include <algorithm>
+#include <Math/Math.h>
+
+#include <Templatized/CellValueRangeTree.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/***********************************
+Methods of class CellValueRangeTree:
+***********************************/
+
+template <class DataSetParam,class ScalarExtractorParam>
+inline
+unsigned int
+CellValueRangeTree<DataSetParam,ScalarExtractorParam>::createSubtree(
+	unsigned int firstBlock,
+	unsigned int numBlocks)
+	{
+	if(numBlocks==0)
+		return ~0U;
+	
+	/* Find the median of the blocks' range centers to use as the node's split value: */
+	unsigned int* bis=&minSortedBlocks[firstBlock];
+	std::vector<VScalar> centers;
+	centers.reserve(numBlocks);
+	for(unsigned int i=0;i<numBlocks;++i)
+		centers.push_back(Math::mid(blocks[bis[i]].min,blocks[bis[i]].max));
+	typename std::vector<VScalar>::iterator medianIt=centers.begin()+numBlocks/2;
+	std::nth_element(centers.begin(),medianIt,centers.end());
+	VScalar center=*medianIt;
+	
+	/* Partition the blocks into those entirely below, straddling, and entirely above the split value: */
+	unsigned int lo=0;
+	unsigned int mid=0;
+	unsigned int hi=numBlocks;
+	while(mid<hi)
+		{
+		const CellBlock& b=blocks[bis[mid]];
+		if(b.max<center)
+			{
+			std::swap(bis[lo],bis[mid]);
+			++lo;
+			++mid;
+			}
+		else if(b.min>center)
+			{
+			--hi;
+			std::swap(bis[mid],bis[hi]);
+			}
+		else
+			++mid;
+		}
+	
+	/* Create the node; the block whose range center is the median always straddles, so the subtrees are strictly smaller: */
+	unsigned int nodeIndex=nodes.size();
+	Node node;
+	node.center=center;
+	node.firstBlock=firstBlock+lo;
+	node.numBlocks=hi-lo;
+	nodes.push_back(node);
+	
+	/* Sort the straddling blocks by ascending range minimum and by descending range maximum: */
+	std::copy(bis+lo,bis+hi,&maxSortedBlocks[firstBlock+lo]);
+	std::sort(bis+lo,bis+hi,BlockMinCompare(&blocks[0]));
+	std::sort(&maxSortedBlocks[firstBlock+lo],&maxSortedBlocks[firstBlock+lo]+(hi-lo),BlockMaxCompare(&blocks[0]));
+	
+	/* Create the node's subtrees: */
+	unsigned int leftChild=createSubtree(firstBlock,lo);
+	unsigned int rightChild=createSubtree(firstBlock+hi,numBlocks-hi);
+	nodes[nodeIndex].children[0]=leftChild;
+	nodes[nodeIndex].children[1]=rightChild;
+	
+	return nodeIndex;
+	}
+
+template <class DataSetParam,class ScalarExtractorParam>
+inline
+size_t
+CellValueRangeTree<DataSetParam,ScalarExtractorParam>::storeCellRanges(
+	std::vector<unsigned int>& activeBlocks,
+	std::vector<typename CellValueRangeTree<DataSetParam,ScalarExtractorParam>::CellRange>& activeCells,
+	size_t maxRangeSize) const
+	{
+	/* Sort the found blocks back into cell iteration order to keep extraction results identical to a full sweep: */
+	std::sort(activeBlocks.begin(),activeBlocks.end());
+	
+	/* Merge runs of adjacent blocks into cell ranges: */
+	size_t numActiveCells=0;
+	for(std::vector<unsigned int>::const_iterator abIt=activeBlocks.begin();abIt!=activeBlocks.end();++abIt)
+		{
+		const CellBlock& block=blocks[*abIt];
+		if(abIt!=activeBlocks.begin()&&*abIt==abIt[-1]+1&&activeCells.back().numCells+block.numCells<=maxRangeSize)
+			activeCells.back().numCells+=block.numCells;
+		else
+			{
+			CellRange range;
+			range.firstCellID=block.firstCellID;
+			range.numCells=block.numCells;
+			activeCells.push_back(range);
+			}
+		numActiveCells+=block.numCells;
+		}
+	
+	return numActiveCells;
+	}
+
+template <class DataSetParam,class ScalarExtractorParam>
+inline
+CellValueRangeTree<DataSetParam,ScalarExtractorParam>::CellValueRangeTree(
+	const typename CellValueRangeTree<DataSetParam,ScalarExtractorParam>::DataSet* sDataSet,
+	const typename CellValueRangeTree<DataSetParam,ScalarExtractorParam>::ScalarExtractor& scalarExtractor,
+	unsigned int sBlockSize)
+	:dataSet(sDataSet),
+	 blockSize(sBlockSize)
+	{
+	/* Calculate the value ranges of all cell blocks in cell iteration order: */
+	blocks.reserve((dataSet->getTotalNumCells()+blockSize-1)/blockSize);
+	typename DataSet::CellIterator cIt=dataSet->beginCells();
+	while(cIt!=dataSet->endCells())
+		{
+		CellBlock block;
+		block.firstCellID=cIt->getID();
+		block.numCells=0;
+		block.min=block.max=cIt->getVertexValue(0,scalarExtractor);
+		for(;block.numCells<blockSize&&cIt!=dataSet->endCells();++block.numCells,++cIt)
+			{
+			for(int i=0;i<CellTopology::numVertices;++i)
+				{
+				VScalar value=cIt->getVertexValue(i,scalarExtractor);
+				if(block.min>value)
+					block.min=value;
+				if(block.max<value)
+					block.max=value;
+				}
+			}
+		blocks.push_back(block);
+		}
+	
+	/* Create the interval tree: */
+	unsigned int numBlocks=blocks.size();
+	minSortedBlocks.reserve(numBlocks);
+	for(unsigned int i=0;i<numBlocks;++i)
+		minSortedBlocks.push_back(i);
+	maxSortedBlocks.resize(numBlocks);
+	createSubtree(0,numBlocks);
+	}
+
+template <class DataSetParam,class ScalarExtractorParam>
+inline
+size_t
+CellValueRangeTree<DataSetParam,ScalarExtractorParam>::getMemorySize(
+	void) const
+	{
+	size_t result=sizeof(CellValueRangeTree);
+	result+=blocks.capacity()*sizeof(CellBlock);
+	result+=nodes.capacity()*sizeof(Node);
+	result+=(minSortedBlocks.capacity()+maxSortedBlocks.capacity())*sizeof(unsigned int);
+	return result;
+	}
+
+template <class DataSetParam,class ScalarExtractorParam>
+inline
+size_t
+CellValueRangeTree<DataSetParam,ScalarExtractorParam>::findActiveCells(
+	typename CellValueRangeTree<DataSetParam,ScalarExtractorParam>::VScalar isovalue,
+	std::vector<typename CellValueRangeTree<DataSetParam,ScalarExtractorParam>::CellRange>& activeCells,
+	size_t maxRangeSize) const
+	{
+	activeCells.clear();
+	
+	/* Descend the interval tree and collect all blocks whose value ranges contain the isovalue: */
+	std::vector<unsigned int> activeBlocks;
+	unsigned int nodeIndex=nodes.empty()?~0U:0U;
+	while(nodeIndex!=~0U)
+		{
+		const Node& node=nodes[nodeIndex];
+		if(isovalue<node.center)
+			{
+			/* All straddling blocks extend above the isovalue; collect those that also extend below it: */
+			for(unsigned int i=0;i<node.numBlocks&&blocks[minSortedBlocks[node.firstBlock+i]].min<=isovalue;++i)
+				activeBlocks.push_back(minSortedBlocks[node.firstBlock+i]);
+			nodeIndex=node.children[0];
+			}
+		else if(isovalue>node.center)
+			{
+			/* All straddling blocks extend below the isovalue; collect those that also extend above it: */
+			for(unsigned int i=0;i<node.numBlocks&&blocks[maxSortedBlocks[node.firstBlock+i]].max>=isovalue;++i)
+				activeBlocks.push_back(maxSortedBlocks[node.firstBlock+i]);
+			nodeIndex=node.children[1];
+			}
+		else
+			{
+			/* All straddling blocks contain the isovalue, and no other blocks do: */
+			for(unsigned int i=0;i<node.numBlocks;++i)
+				activeBlocks.push_back(minSortedBlocks[node.firstBlock+i]);
+			nodeIndex=~0U;
+			}
+		}
+	
+	/* Store the found blocks as cell ranges: */
+	return storeCellRanges(activeBlocks,activeCells,maxRangeSize);
+	}
+
+template <class DataSetParam,class ScalarExtractorParam>
+inline
+size_t
+CellValueRangeTree<DataSetParam,ScalarExtractorParam>::findActiveCells(
+	typename CellValueRangeTree<DataSetParam,ScalarExtractorParam>::VScalar minValue,
+	typename CellValueRangeTree<DataSetParam,ScalarExtractorParam>::VScalar maxValue,
+	std::vector<typename CellValueRangeTree<DataSetParam,ScalarExtractorParam>::CellRange>& activeCells,
+	size_t maxRangeSize) const
+	{
+	activeCells.clear();
+	
+	/* Traverse the interval tree and collect all blocks whose value ranges overlap the value interval: */
+	std::vector<unsigned int> activeBlocks;
+	std::vector<unsigned int> nodeStack;
+	if(!nodes.empty())
+		nodeStack.push_back(0U);
+	while(!nodeStack.empty())
+		{
+		const Node& node=nodes[nodeStack.back()];
+		nodeStack.pop_back();
+		if(maxValue<node.center)
+			{
+			/* All straddling blocks extend above the value interval; collect those that also extend below its maximum: */
+			for(unsigned int i=0;i<node.numBlocks&&blocks[minSortedBlocks[node.firstBlock+i]].min<=maxValue;++i)
+				activeBlocks.push_back(minSortedBlocks[node.firstBlock+i]);
+			if(node.children[0]!=~0U)
+				nodeStack.push_back(node.children[0]);
+			}
+		else if(minValue>node.center)
+			{
+			/* All straddling blocks extend below the value interval; collect those that also extend above its minimum: */
+			for(unsigned int i=0;i<node.numBlocks&&blocks[maxSortedBlocks[node.firstBlock+i]].max>=minValue;++i)
+				activeBlocks.push_back(maxSortedBlocks[node.firstBlock+i]);
+			if(node.children[1]!=~0U)
+				nodeStack.push_back(node.children[1]);
+			}
+		else
+			{
+			/* All straddling blocks overlap the value interval, and both subtrees can contain more: */
+			for(unsigned int i=0;i<node.numBlocks;++i)
+				activeBlocks.push_back(minSortedBlocks[node.firstBlock+i]);
+			for(int i=0;i<2;++i)
+				if(node.children[i]!=~0U)
+					nodeStack.push_back(node.children[i]);
+			}
+		}
+	
+	/* Store the found blocks as cell ranges: */
+	return storeCellRanges(activeBlocks,activeCells,maxRangeSize);
+	}
+
+}
+
+}
@@ -0,0 +1,161 @@
+/***********************************************************************
+CellValueRangeTree - Class to index blocks of data set cells by the
+range of scalar values they span, to quickly find all cells that can
+intersect an isosurface of a given isovalue.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_CELLVALUERANGETREE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_CELLVALUERANGETREE_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam,class ScalarExtractorParam>
+class CellValueRangeTree
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of the indexed data set
+	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
+	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef typename DataSet::CellID CellID; // Type of the data set's cell IDs
+	
+	private:
+	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
+	
+	public:
+	struct CellRange // Structure for runs of consecutive cells in the data set's cell iteration order
+		{
+		/* Elements: */
+		public:
+		CellID firstCellID; // ID of the first cell in the run
+		size_t numCells; // Number of cells in the run
+		};
+	
+	private:
+	struct CellBlock // Structure for fixed-size blocks of consecutive cells
+		{
+		/* Elements: */
+		public:
+		CellID firstCellID; // ID of the first cell in the block
+		unsigned int numCells; // Number of cells in the block (only the last block can be smaller than the block size)
+		VScalar min,max; // Range of scalar values at all vertices of all cells in the block
+		};
+	
+	struct Node // Structure for nodes of the interval tree
+		{
+		/* Elements: */
+		public:
+		VScalar center; // Split value of the node
+		unsigned int firstBlock,numBlocks; // Range of the node's straddling blocks in the sorted block index arrays
+		unsigned int children[2]; // Indices of the node's left and right children, or ~0U for empty subtrees
+		};
+	
+	class BlockMinCompare // Functor to sort block indices by ascending range minimum
+		{
+		/* Elements: */
+		private:
+		const CellBlock* blocks; // Pointer to the block array
+		
+		/* Constructors and destructors: */
+		public:
+		BlockMinCompare(const CellBlock* sBlocks)
+			:blocks(sBlocks)
+			{
+			}
+		
+		/* Methods: */
+		bool operator()(unsigned int b1,unsigned int b2) const
+			{
+			return blocks[b1].min<blocks[b2].min;
+			}
+		};
+	
+	class BlockMaxCompare // Functor to sort block indices by descending range maximum
+		{
+		/* Elements: */
+		private:
+		const CellBlock* blocks; // Pointer to the block array
+		
+		/* Constructors and destructors: */
+		public:
+		BlockMaxCompare(const CellBlock* sBlocks)
+			:blocks(sBlocks)
+			{
+			}
+		
+		/* Methods: */
+		bool operator()(unsigned int b1,unsigned int b2) const
+			{
+			return blocks[b1].max>blocks[b2].max;
+			}
+		};
+	
+	/* Elements: */
+	const DataSet* dataSet; // The indexed data set
+	unsigned int blockSize; // Maximum number of cells per block
+	std::vector<CellBlock> blocks; // Array of cell blocks in cell iteration order
+	std::vector<Node> nodes; // Array of interval tree nodes; root is first node
+	std::vector<unsigned int> minSortedBlocks; // Indices of each node's straddling blocks, sorted by ascending range minimum
+	std::vector<unsigned int> maxSortedBlocks; // Indices of each node's straddling blocks, sorted by descending range maximum
+	
+	/* Private methods: */
+	unsigned int createSubtree(unsigned int firstBlock,unsigned int numBlocks); // Creates interval subtree for the given range of the block index arrays; returns index of subtree's root
+	size_t storeCellRanges(std::vector<unsigned int>& activeBlocks,std::vector<CellRange>& activeCells,size_t maxRangeSize) const; // Sorts the given blocks into cell iteration order and stores them as runs of consecutive cells; returns total number of stored cells
+	
+	/* Constructors and destructors: */
+	public:
+	CellValueRangeTree(const DataSet* sDataSet,const ScalarExtractor& scalarExtractor,unsigned int sBlockSize =64); // Creates an index for the given data set and scalar extractor using blocks of the given size
+	private:
+	CellValueRangeTree(const CellValueRangeTree& source); // Prohibit copy constructor
+	CellValueRangeTree& operator=(const CellValueRangeTree& source); // Prohibit assignment operator
+	
+	/* Methods: */
+	public:
+	const DataSet* getDataSet(void) const // Returns the indexed data set
+		{
+		return dataSet;
+		}
+	unsigned int getBlockSize(void) const // Returns the maximum number of cells per block
+		{
+		return blockSize;
+		}
+	size_t getNumBlocks(void) const // Returns the number of cell blocks in the index
+		{
+		return blocks.size();
+		}
+	size_t getMemorySize(void) const; // Returns the approximate memory size of the index in bytes
+	size_t findActiveCells(VScalar isovalue,std::vector<CellRange>& activeCells,size_t maxRangeSize =~size_t(0)) const; // Stores all cells that can intersect the isosurface of the given isovalue as runs of consecutive cells in cell iteration order, not merging blocks into runs longer than the given size; returns total number of stored cells
+	size_t findActiveCells(VScalar minValue,VScalar maxValue,std::vector<CellRange>& activeCells,size_t maxRangeSize =~size_t(0)) const; // Ditto; stores all cells that can intersect an isosurface of any isovalue in the given closed interval
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_CELLVALUERANGETREE_IMPLEMENTATION
+#include <Templatized/CellValueRangeTree.cpp>
+#endif
+
+#endif
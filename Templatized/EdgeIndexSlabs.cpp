@@ -0,0 +1,129 @@
+/***********************************************************************
+EdgeIndexSlabs - Class to map the edge IDs of structured grids to vertex
+indices in extracted surfaces without hashing, by storing the vertex
+indices of two consecutive slabs of edges in a ring buffer while cells
+are visited in iteration order.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_EDGEINDEXSLABS_IMPLEMENTATION
+
+#include <Templatized/EdgeIndexSlabs.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/*******************************
+Methods of class EdgeIndexSlabs:
+*******************************/
+
+template <class IndexParam>
+inline
+void
+EdgeIndexSlabs<IndexParam>::clearSlabs(
+	size_t firstSlab,
+	size_t numSlabs)
+	{
+	Index* iPtr=indices+firstSlab*slabSize;
+	Index* iEnd=iPtr+numSlabs*slabSize;
+	for(;iPtr!=iEnd;++iPtr)
+		*iPtr=~Index(0);
+	}
+
+template <class IndexParam>
+inline
+EdgeIndexSlabs<IndexParam>::EdgeIndexSlabs(
+	void)
+	:slabSize(0),
+	 indices(0),
+	 baseEdgeIndex(0)
+	{
+	}
+
+template <class IndexParam>
+inline
+EdgeIndexSlabs<IndexParam>::~EdgeIndexSlabs(
+	void)
+	{
+	delete[] indices;
+	}
+
+template <class IndexParam>
+inline
+void
+EdgeIndexSlabs<IndexParam>::setSlabSize(
+	size_t newSlabSize)
+	{
+	if(slabSize!=newSlabSize)
+		{
+		/* Re-allocate the ring buffer: */
+		delete[] indices;
+		slabSize=newSlabSize;
+		indices=slabSize>0?new Index[slabSize*2]:0;
+		}
+	
+	/* Clear the map: */
+	clear();
+	}
+
+template <class IndexParam>
+inline
+void
+EdgeIndexSlabs<IndexParam>::clear(
+	void)
+	{
+	clearSlabs(0,2);
+	baseEdgeIndex=0;
+	}
+
+template <class IndexParam>
+inline
+void
+EdgeIndexSlabs<IndexParam>::setVertex(
+	size_t edgeIndex,
+	typename EdgeIndexSlabs<IndexParam>::Index vertexIndex)
+	{
+	/* Ignore edges behind the ring buffer; they can only occur if cells are not visited in iteration order: */
+	if(edgeIndex<baseEdgeIndex)
+		return;
+	
+	if(edgeIndex>=baseEdgeIndex+slabSize*2)
+		{
+		/* Move the ring buffer forward such that the edge's slab becomes the upper slab: */
+		size_t newBaseEdgeIndex=(edgeIndex/slabSize-1)*slabSize;
+		if(newBaseEdgeIndex==baseEdgeIndex+slabSize)
+			{
+			/* Clear the old lower slab, which becomes the new upper slab: */
+			clearSlabs((baseEdgeIndex/slabSize)%2,1);
+			}
+		else
+			{
+			/* None of the old slabs are retained: */
+			clearSlabs(0,2);
+			}
+		baseEdgeIndex=newBaseEdgeIndex;
+		}
+	
+	indices[edgeIndex%(slabSize*2)]=vertexIndex;
+	}
+
+}
+
+}
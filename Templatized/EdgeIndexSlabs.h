@@ -0,0 +1,210 @@
+/***********************************************************************
+EdgeIndexSlabs - Class to map the edge IDs of structured grids to vertex
+indices in extracted surfaces without hashing, by storing the vertex
+indices of two consecutive slabs of edges in a ring buffer while cells
+are visited in iteration order.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_EDGEINDEXSLABS_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_EDGEINDEXSLABS_INCLUDED
+
+#include <stddef.h>
+
+#include <Templatized/LinearIndexID.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class Cartesian;
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class Curvilinear;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCartesian;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCurvilinear;
+}
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class EdgeIndexSlabTraits // Generic traits class for data sets whose edge IDs are not dense linear indices
+	{
+	/* Elements: */
+	public:
+	static const bool denseEdgeIDs=false; // Flag whether the data set's edge IDs are linear indices that only increase by slabs while cells are visited in iteration order
+	
+	/* Methods: */
+	static size_t getSlabSize(const DataSetParam&) // Returns the number of edge IDs in one slab
+		{
+		return 0;
+		}
+	template <class EdgeIDParam>
+	static size_t getEdgeIndex(const EdgeIDParam&) // Returns the linear index of the given edge ID; never called for data sets without dense edge IDs
+		{
+		return 0;
+		}
+	static typename DataSetParam::CellID getCellID(const DataSetParam&,size_t) // Returns the ID of the cell at the given position in cell iteration order; never called for data sets without dense edge IDs
+		{
+		return typename DataSetParam::CellID();
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class EdgeIndexSlabTraits<Cartesian<ScalarParam,dimensionParam,ValueParam> >
+	{
+	/* Elements: */
+	public:
+	static const bool denseEdgeIDs=true;
+	
+	/* Methods: */
+	static size_t getSlabSize(const Cartesian<ScalarParam,dimensionParam,ValueParam>& dataSet) // One slab contains the edges starting in one vertex layer along the slowest-varying index
+		{
+		return size_t(dataSet.getNumVertices().calcIncrement(0))*size_t(dimensionParam);
+		}
+	static size_t getEdgeIndex(const LinearIndexID& edgeID)
+		{
+		return size_t(edgeID.getIndex());
+		}
+	static LinearIndexID getCellID(const Cartesian<ScalarParam,dimensionParam,ValueParam>& dataSet,size_t cellIndex) // Cells are iterated in the order of their base vertices, and identified by their base vertices' linear indices
+		{
+		return LinearIndexID(LinearIndexID::Index(dataSet.getNumVertices().calcOffset(dataSet.getNumCells().calcIndex(int(cellIndex)))));
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class EdgeIndexSlabTraits<Curvilinear<ScalarParam,dimensionParam,ValueParam> >
+	{
+	/* Elements: */
+	public:
+	static const bool denseEdgeIDs=true;
+	
+	/* Methods: */
+	static size_t getSlabSize(const Curvilinear<ScalarParam,dimensionParam,ValueParam>& dataSet)
+		{
+		return size_t(dataSet.getNumVertices().calcIncrement(0))*size_t(dimensionParam);
+		}
+	static size_t getEdgeIndex(const LinearIndexID& edgeID)
+		{
+		return size_t(edgeID.getIndex());
+		}
+	static LinearIndexID getCellID(const Curvilinear<ScalarParam,dimensionParam,ValueParam>& dataSet,size_t cellIndex)
+		{
+		return LinearIndexID(LinearIndexID::Index(dataSet.getNumVertices().calcOffset(dataSet.getNumCells().calcIndex(int(cellIndex)))));
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class EdgeIndexSlabTraits<SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	/* Elements: */
+	public:
+	static const bool denseEdgeIDs=true;
+	
+	/* Methods: */
+	static size_t getSlabSize(const SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>& dataSet)
+		{
+		return size_t(dataSet.getNumVertices().calcIncrement(0))*size_t(dimensionParam);
+		}
+	static size_t getEdgeIndex(const LinearIndexID& edgeID)
+		{
+		return size_t(edgeID.getIndex());
+		}
+	static LinearIndexID getCellID(const SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>& dataSet,size_t cellIndex)
+		{
+		return LinearIndexID(LinearIndexID::Index(dataSet.getNumVertices().calcOffset(dataSet.getNumCells().calcIndex(int(cellIndex)))));
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class EdgeIndexSlabTraits<SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	/* Elements: */
+	public:
+	static const bool denseEdgeIDs=true;
+	
+	/* Methods: */
+	static size_t getSlabSize(const SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>& dataSet)
+		{
+		return size_t(dataSet.getNumVertices().calcIncrement(0))*size_t(dimensionParam);
+		}
+	static size_t getEdgeIndex(const LinearIndexID& edgeID)
+		{
+		return size_t(edgeID.getIndex());
+		}
+	static LinearIndexID getCellID(const SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>& dataSet,size_t cellIndex)
+		{
+		return LinearIndexID(LinearIndexID::Index(dataSet.getNumVertices().calcOffset(dataSet.getNumCells().calcIndex(int(cellIndex)))));
+		}
+	};
+
+template <class IndexParam>
+class EdgeIndexSlabs
+	{
+	/* Embedded classes: */
+	public:
+	typedef IndexParam Index; // Type of vertex indices
+	
+	/* Elements: */
+	private:
+	size_t slabSize; // Number of edge IDs in one slab
+	Index* indices; // Ring buffer of vertex indices for two slabs of edges; ~Index(0) marks edges without vertex
+	size_t baseEdgeIndex; // Linear index of the first edge in the lower slab currently held in the ring buffer; always a multiple of the slab size
+	
+	/* Private methods: */
+	void clearSlabs(size_t firstSlab,size_t numSlabs); // Marks all edges in the given range of ring buffer slabs as having no vertex
+	
+	/* Constructors and destructors: */
+	public:
+	EdgeIndexSlabs(void); // Creates an empty map; slab size must be set before use
+	private:
+	EdgeIndexSlabs(const EdgeIndexSlabs& source); // Prohibit copy constructor
+	EdgeIndexSlabs& operator=(const EdgeIndexSlabs& source); // Prohibit assignment operator
+	public:
+	~EdgeIndexSlabs(void);
+	
+	/* Methods: */
+	size_t getSlabSize(void) const // Returns the number of edge IDs in one slab
+		{
+		return slabSize;
+		}
+	void setSlabSize(size_t newSlabSize); // Sets the number of edge IDs in one slab and clears the map
+	void clear(void); // Removes all edges from the map and moves the ring buffer back to the first slab
+	Index findVertex(size_t edgeIndex) const // Returns the index of the vertex on the edge of the given linear index, or ~Index(0) if the edge has no vertex
+		{
+		if(edgeIndex<baseEdgeIndex||edgeIndex>=baseEdgeIndex+slabSize*2)
+			return ~Index(0);
+		return indices[edgeIndex%(slabSize*2)];
+		}
+	void setVertex(size_t edgeIndex,Index vertexIndex); // Stores the index of the vertex on the edge of the given linear index; moves the ring buffer forward if the edge is beyond the upper slab
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_EDGEINDEXSLABS_IMPLEMENTATION
+#include <Templatized/EdgeIndexSlabs.cpp>
+#endif
+
+#endif
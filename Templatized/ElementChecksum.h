@@ -0,0 +1,72 @@
+/***********************************************************************
+ElementChecksum - Helper class to accumulate a checksum over the raw
+vertex and index data of a visualization element, to detect when the
+same element extracted independently on several nodes of a cluster
+diverges.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_ELEMENTCHECKSUM_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_ELEMENTCHECKSUM_INCLUDED
+
+#include <stddef.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class ElementChecksum // Class to accumulate a 32-bit FNV-1a hash over a sequence of bytes
+	{
+	/* Elements: */
+	private:
+	unsigned int checksum; // Current checksum
+	
+	/* Constructors and destructors: */
+	public:
+	ElementChecksum(void) // Creates the checksum of an empty byte sequence
+		:checksum(2166136261U)
+		{
+		}
+	
+	/* Methods: */
+	void add(const void* data,size_t dataSize) // Adds the given bytes to the checksum
+		{
+		const unsigned char* dPtr=static_cast<const unsigned char*>(data);
+		for(size_t i=0;i<dataSize;++i,++dPtr)
+			{
+			checksum^=(unsigned int)(*dPtr);
+			checksum*=16777619U;
+			}
+		}
+	template <class ValueParam>
+	void add(const ValueParam& value) // Adds the raw representation of the given value to the checksum
+		{
+		add(&value,sizeof(ValueParam));
+		}
+	unsigned int getChecksum(void) const // Returns the current checksum
+		{
+		return checksum;
+		}
+	};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,395 @@
+/***********************************************************************
+ElementStreamCodec - Class to compress batches of triangle set vertices
+and vertex indices for streaming from the master node to the slave nodes
+of a cluster, by quantizing vertex positions relative to a domain box,
+quantizing vertex normals in octahedral coordinates, and delta-coding
+vertex indices.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_ELEMENTSTREAMCODEC_IMPLEMENTATION
+
+#include <string.h>
+#include <Math/Math.h>
+
+#include <Templatized/ElementStreamCodec.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/**************************************************************
+Helper functions and classes to encode and decode vertex parts:
+**************************************************************/
+
+inline unsigned int quantizeStreamValue(double value,double min,double scale,unsigned int maxValue) // Quantizes a value relative to a range
+	{
+	double q=(value-min)*scale;
+	if(q<=0.0)
+		return 0;
+	else if(q>=double(maxValue))
+		return maxValue;
+	else
+		return (unsigned int)(q+0.5);
+	}
+
+template <class VertexPartParam>
+inline void appendRawStreamPart(const VertexPartParam& part,std::vector<unsigned char>& buffer) // Appends the raw representation of a vertex part to a buffer
+	{
+	const unsigned char* partPtr=reinterpret_cast<const unsigned char*>(&part);
+	buffer.insert(buffer.end(),partPtr,partPtr+sizeof(VertexPartParam));
+	}
+
+template <class VertexPartParam>
+inline void readRawStreamPart(const unsigned char*& bufferPtr,VertexPartParam& part) // Reads the raw representation of a vertex part from a buffer
+	{
+	memcpy(&part,bufferPtr,sizeof(VertexPartParam));
+	bufferPtr+=sizeof(VertexPartParam);
+	}
+
+template <class TexCoordScalarParam>
+struct StreamTexCoordPart // Helper class to copy texture coordinates verbatim
+	{
+	/* Methods: */
+	public:
+	template <class VertexParam>
+	static void encode(const VertexParam& vertex,std::vector<unsigned char>& buffer)
+		{
+		appendRawStreamPart(vertex.texCoord,buffer);
+		}
+	template <class VertexParam>
+	static void decode(const unsigned char*& bufferPtr,VertexParam& vertex)
+		{
+		readRawStreamPart(bufferPtr,vertex.texCoord);
+		}
+	};
+
+template <>
+struct StreamTexCoordPart<void> // Specialized helper class for vertices without texture coordinates
+	{
+	/* Methods: */
+	public:
+	template <class VertexParam>
+	static void encode(const VertexParam&,std::vector<unsigned char>&)
+		{
+		}
+	template <class VertexParam>
+	static void decode(const unsigned char*&,VertexParam&)
+		{
+		}
+	};
+
+template <class ColorScalarParam>
+struct StreamColorPart // Helper class to copy colors verbatim
+	{
+	/* Methods: */
+	public:
+	template <class VertexParam>
+	static void encode(const VertexParam& vertex,std::vector<unsigned char>& buffer)
+		{
+		appendRawStreamPart(vertex.color,buffer);
+		}
+	template <class VertexParam>
+	static void decode(const unsigned char*& bufferPtr,VertexParam& vertex)
+		{
+		readRawStreamPart(bufferPtr,vertex.color);
+		}
+	};
+
+template <>
+struct StreamColorPart<void> // Specialized helper class for vertices without colors
+	{
+	/* Methods: */
+	public:
+	template <class VertexParam>
+	static void encode(const VertexParam&,std::vector<unsigned char>&)
+		{
+		}
+	template <class VertexParam>
+	static void decode(const unsigned char*&,VertexParam&)
+		{
+		}
+	};
+
+template <class NormalScalarParam>
+struct StreamNormalPart // Helper class to quantize normal vectors in octahedral coordinates
+	{
+	/* Methods: */
+	public:
+	template <class VertexParam,class BitWriterParam>
+	static void encode(const VertexParam& vertex,unsigned int normalBits,BitWriterParam& writer)
+		{
+		/* Project the normal onto the octahedron: */
+		double n[3];
+		for(int i=0;i<3;++i)
+			n[i]=double(vertex.normal[i]);
+		double l1=Math::abs(n[0])+Math::abs(n[1])+Math::abs(n[2]);
+		double u=0.0;
+		double v=0.0;
+		if(l1>0.0)
+			{
+			u=n[0]/l1;
+			v=n[1]/l1;
+			if(n[2]<0.0)
+				{
+				/* Fold the lower half of the octahedron over the upper half: */
+				double fu=(1.0-Math::abs(v))*(u>=0.0?1.0:-1.0);
+				double fv=(1.0-Math::abs(u))*(v>=0.0?1.0:-1.0);
+				u=fu;
+				v=fv;
+				}
+			}
+		
+		/* Quantize the octahedral coordinates: */
+		unsigned int maxValue=(1U<<normalBits)-1U;
+		double scale=0.5*double(maxValue);
+		writer.write(quantizeStreamValue(u,-1.0,scale,maxValue),normalBits);
+		writer.write(quantizeStreamValue(v,-1.0,scale,maxValue),normalBits);
+		}
+	template <class VertexParam,class BitReaderParam>
+	static void decode(BitReaderParam& reader,unsigned int normalBits,VertexParam& vertex)
+		{
+		/* Dequantize the octahedral coordinates: */
+		double scale=2.0/double((1U<<normalBits)-1U);
+		double u=double(reader.read(normalBits))*scale-1.0;
+		double v=double(reader.read(normalBits))*scale-1.0;
+		
+		/* Unfold the octahedron: */
+		double n[3];
+		n[2]=1.0-Math::abs(u)-Math::abs(v);
+		if(n[2]<0.0)
+			{
+			n[0]=(1.0-Math::abs(v))*(u>=0.0?1.0:-1.0);
+			n[1]=(1.0-Math::abs(u))*(v>=0.0?1.0:-1.0);
+			}
+		else
+			{
+			n[0]=u;
+			n[1]=v;
+			}
+		double len=Math::sqrt(n[0]*n[0]+n[1]*n[1]+n[2]*n[2]);
+		for(int i=0;i<3;++i)
+			vertex.normal[i]=NormalScalarParam(n[i]/len);
+		}
+	};
+
+template <>
+struct StreamNormalPart<void> // Specialized helper class for vertices without normal vectors
+	{
+	/* Methods: */
+	public:
+	template <class VertexParam,class BitWriterParam>
+	static void encode(const VertexParam&,unsigned int,BitWriterParam&)
+		{
+		}
+	template <class VertexParam,class BitReaderParam>
+	static void decode(BitReaderParam&,unsigned int,VertexParam&)
+		{
+		}
+	};
+
+}
+
+/***********************************
+Methods of class ElementStreamCodec:
+***********************************/
+
+template <class TexCoordScalarParam,GLsizei numTexCoordComponentsParam,class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+inline
+void
+ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::encodeIndex(
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Index index,
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Index& prevIndex,
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Buffer& buffer)
+	{
+	/* Map the signed index difference to an unsigned integer with small values for small differences: */
+	Index code=index>=prevIndex?(index-prevIndex)<<1:((prevIndex-index)<<1)-1U;
+	prevIndex=index;
+	
+	/* Write the code seven bits at a time, least significant bits first: */
+	while(code>=0x80U)
+		{
+		buffer.push_back((unsigned char)((code&0x7fU)|0x80U));
+		code>>=7;
+		}
+	buffer.push_back((unsigned char)code);
+	}
+
+template <class TexCoordScalarParam,GLsizei numTexCoordComponentsParam,class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+inline
+typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Index
+ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::decodeIndex(
+	const unsigned char*& bufferPtr,
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Index& prevIndex)
+	{
+	/* Read the code seven bits at a time: */
+	Index code=0;
+	for(int shift=0;;shift+=7,++bufferPtr)
+		{
+		code|=Index(*bufferPtr&0x7fU)<<shift;
+		if((*bufferPtr&0x80U)==0)
+			break;
+		}
+	++bufferPtr;
+	
+	/* Apply the signed index difference: */
+	if(code&0x1U)
+		prevIndex-=(code+1U)>>1;
+	else
+		prevIndex+=code>>1;
+	return prevIndex;
+	}
+
+template <class TexCoordScalarParam,GLsizei numTexCoordComponentsParam,class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+inline
+ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::ElementStreamCodec(
+	void)
+	:positionBits(0),normalBits(0)
+	{
+	for(int i=0;i<dimension;++i)
+		{
+		domainMin[i]=Scalar(0);
+		domainMax[i]=Scalar(0);
+		}
+	}
+
+template <class TexCoordScalarParam,GLsizei numTexCoordComponentsParam,class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+inline
+void
+ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::setPrecision(
+	unsigned int newPositionBits,
+	unsigned int newNormalBits)
+	{
+	positionBits=newPositionBits<maxNumBits?newPositionBits:maxNumBits;
+	if(newNormalBits<2)
+		normalBits=2;
+	else
+		normalBits=newNormalBits<maxNumBits?newNormalBits:maxNumBits;
+	}
+
+template <class TexCoordScalarParam,GLsizei numTexCoordComponentsParam,class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+inline
+void
+ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::encode(
+	const typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Vertex* vertices,
+	size_t numVertices,
+	const typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Index* indices,
+	size_t numIndices,
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Index baseIndex,
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Buffer& buffer) const
+	{
+	/* Write the batch header so that the decoder does not need to share the encoder's settings: */
+	buffer.push_back((unsigned char)positionBits);
+	buffer.push_back((unsigned char)normalBits);
+	for(int i=0;i<dimension;++i)
+		appendRawStreamPart(domainMin[i],buffer);
+	for(int i=0;i<dimension;++i)
+		appendRawStreamPart(domainMax[i],buffer);
+	
+	if(numVertices>0)
+		{
+		/* Copy all vertex parts that are not quantized: */
+		for(size_t vi=0;vi<numVertices;++vi)
+			{
+			StreamTexCoordPart<TexCoordScalarParam>::encode(vertices[vi],buffer);
+			StreamColorPart<ColorScalarParam>::encode(vertices[vi],buffer);
+			}
+		
+		/* Calculate the position quantization factors: */
+		unsigned int maxValue=(1U<<positionBits)-1U;
+		double scale[dimension];
+		for(int i=0;i<dimension;++i)
+			scale[i]=domainMax[i]>domainMin[i]?double(maxValue)/(double(domainMax[i])-double(domainMin[i])):0.0;
+		
+		/* Quantize all normal vectors and positions: */
+		BitWriter writer(buffer);
+		for(size_t vi=0;vi<numVertices;++vi)
+			{
+			StreamNormalPart<NormalScalarParam>::encode(vertices[vi],normalBits,writer);
+			for(int i=0;i<dimension;++i)
+				writer.write(quantizeStreamValue(double(vertices[vi].position[i]),double(domainMin[i]),scale[i],maxValue),positionBits);
+			}
+		writer.finish();
+		}
+	
+	/* Delta-code all vertex indices: */
+	Index prevIndex=baseIndex;
+	for(size_t ii=0;ii<numIndices;++ii)
+		encodeIndex(indices[ii],prevIndex,buffer);
+	}
+
+template <class TexCoordScalarParam,GLsizei numTexCoordComponentsParam,class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+inline
+const unsigned char*
+ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::decode(
+	const unsigned char* bufferPtr,
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Vertex* vertices,
+	size_t numVertices,
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Index* indices,
+	size_t numIndices,
+	typename ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >::Index baseIndex) const
+	{
+	/* Read the batch header: */
+	unsigned int batchPositionBits=*(bufferPtr++);
+	unsigned int batchNormalBits=*(bufferPtr++);
+	Scalar batchDomainMin[dimension];
+	for(int i=0;i<dimension;++i)
+		readRawStreamPart(bufferPtr,batchDomainMin[i]);
+	Scalar batchDomainMax[dimension];
+	for(int i=0;i<dimension;++i)
+		readRawStreamPart(bufferPtr,batchDomainMax[i]);
+	
+	if(numVertices>0)
+		{
+		/* Copy all vertex parts that are not quantized: */
+		for(size_t vi=0;vi<numVertices;++vi)
+			{
+			StreamTexCoordPart<TexCoordScalarParam>::decode(bufferPtr,vertices[vi]);
+			StreamColorPart<ColorScalarParam>::decode(bufferPtr,vertices[vi]);
+			}
+		
+		/* Calculate the position dequantization factors: */
+		double scale[dimension];
+		for(int i=0;i<dimension;++i)
+			scale[i]=(double(batchDomainMax[i])-double(batchDomainMin[i]))/double((1U<<batchPositionBits)-1U);
+		
+		/* Dequantize all normal vectors and positions: */
+		BitReader reader(bufferPtr);
+		for(size_t vi=0;vi<numVertices;++vi)
+			{
+			StreamNormalPart<NormalScalarParam>::decode(reader,batchNormalBits,vertices[vi]);
+			for(int i=0;i<dimension;++i)
+				vertices[vi].position[i]=Scalar(double(batchDomainMin[i])+double(reader.read(batchPositionBits))*scale[i]);
+			}
+		bufferPtr=reader.finish();
+		}
+	
+	/* Decode all vertex indices: */
+	Index prevIndex=baseIndex;
+	for(size_t ii=0;ii<numIndices;++ii)
+		indices[ii]=decodeIndex(bufferPtr,prevIndex);
+	
+	return bufferPtr;
+	}
+
+}
+
+}
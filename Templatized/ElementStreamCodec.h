@@ -0,0 +1,179 @@
+/***********************************************************************
+ElementStreamCodec - Class to compress batches of triangle set vertices
+and vertex indices for streaming from the master node to the slave nodes
+of a cluster, by quantizing vertex positions relative to a domain box,
+quantizing vertex normals in octahedral coordinates, and delta-coding
+vertex indices.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_ELEMENTSTREAMCODEC_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_ELEMENTSTREAMCODEC_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <GL/gl.h>
+#define NONSTANDARD_GLVERTEX_TEMPLATES
+#include <GL/GLVertex.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class VertexParam>
+class ElementStreamCodec; // Generic codec class; only defined for GLVertex vertex types
+
+template <class TexCoordScalarParam,GLsizei numTexCoordComponentsParam,class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+class ElementStreamCodec<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >
+	{
+	/* Embedded classes: */
+	public:
+	typedef GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> Vertex; // Type of encoded vertices
+	typedef GLuint Index; // Type of encoded vertex indices
+	typedef PositionScalarParam Scalar; // Scalar type of vertex positions
+	static const int dimension=numPositionComponentsParam; // Number of vertex position components
+	typedef std::vector<unsigned char> Buffer; // Type for buffers holding encoded batches
+	
+	private:
+	class BitWriter // Class to append fixed-width unsigned integers to a buffer
+		{
+		/* Elements: */
+		private:
+		Buffer& buffer; // Buffer receiving the encoded bits
+		unsigned int bits; // Bits not yet written to the buffer
+		unsigned int numBits; // Number of bits not yet written to the buffer; always less than 8 between calls
+		
+		/* Constructors and destructors: */
+		public:
+		BitWriter(Buffer& sBuffer)
+			:buffer(sBuffer),bits(0),numBits(0)
+			{
+			}
+		
+		/* Methods: */
+		void write(unsigned int value,unsigned int valueNumBits) // Appends the given number of low bits of the given value; at most 24 bits at a time
+			{
+			bits|=value<<numBits;
+			numBits+=valueNumBits;
+			while(numBits>=8)
+				{
+				buffer.push_back((unsigned char)(bits&0xffU));
+				bits>>=8;
+				numBits-=8;
+				}
+			}
+		void finish(void) // Pads the written bits to the next byte boundary
+			{
+			if(numBits>0)
+				buffer.push_back((unsigned char)(bits&0xffU));
+			bits=0;
+			numBits=0;
+			}
+		};
+	
+	class BitReader // Class to read fixed-width unsigned integers from a buffer
+		{
+		/* Elements: */
+		private:
+		const unsigned char* bufferPtr; // Pointer to the next unread byte
+		unsigned int bits; // Bits read from the buffer but not yet returned
+		unsigned int numBits; // Number of bits read from the buffer but not yet returned
+		
+		/* Constructors and destructors: */
+		public:
+		BitReader(const unsigned char* sBufferPtr)
+			:bufferPtr(sBufferPtr),bits(0),numBits(0)
+			{
+			}
+		
+		/* Methods: */
+		unsigned int read(unsigned int valueNumBits) // Reads an unsigned integer of the given number of bits; at most 24 bits at a time
+			{
+			while(numBits<valueNumBits)
+				{
+				bits|=(unsigned int)(*bufferPtr)<<numBits;
+				++bufferPtr;
+				numBits+=8;
+				}
+			unsigned int result=bits&((1U<<valueNumBits)-1U);
+			bits>>=valueNumBits;
+			numBits-=valueNumBits;
+			return result;
+			}
+		const unsigned char* finish(void) // Skips the remaining bits of the current byte and returns a pointer to the next unread byte
+			{
+			bits=0;
+			numBits=0;
+			return bufferPtr;
+			}
+		};
+	
+	/* Elements: */
+	public:
+	static const unsigned int maxNumBits=24; // Maximum number of bits per quantized position or normal component
+	private:
+	unsigned int positionBits; // Number of bits per quantized position component; 0 disables compression
+	unsigned int normalBits; // Number of bits per quantized octahedral normal component
+	Scalar domainMin[dimension]; // Lower corner of the domain box relative to which positions are quantized
+	Scalar domainMax[dimension]; // Upper corner of the domain box
+	
+	/* Private methods: */
+	static void encodeIndex(Index index,Index& prevIndex,Buffer& buffer); // Appends the difference between the given and previous index as a variable-length integer
+	static Index decodeIndex(const unsigned char*& bufferPtr,Index& prevIndex); // Reads a difference from the buffer and returns the index it encodes
+	
+	/* Constructors and destructors: */
+	public:
+	ElementStreamCodec(void); // Creates a codec with compression disabled
+	
+	/* Methods: */
+	bool isEnabled(void) const // Returns true if compression is enabled
+		{
+		return positionBits>0;
+		}
+	unsigned int getPositionBits(void) const // Returns the number of bits per quantized position component
+		{
+		return positionBits;
+		}
+	unsigned int getNormalBits(void) const // Returns the number of bits per quantized normal component
+		{
+		return normalBits;
+		}
+	void setPrecision(unsigned int newPositionBits,unsigned int newNormalBits); // Sets the number of bits per quantized position and normal component; zero position bits disables compression
+	template <class BoxParam>
+	void setDomain(const BoxParam& domain) // Sets the domain box relative to which positions are quantized; positions outside the box are clamped
+		{
+		for(int i=0;i<dimension;++i)
+			{
+			domainMin[i]=Scalar(domain.min[i]);
+			domainMax[i]=Scalar(domain.max[i]);
+			}
+		}
+	void encode(const Vertex* vertices,size_t numVertices,const Index* indices,size_t numIndices,Index baseIndex,Buffer& buffer) const; // Appends a batch of vertices and vertex indices to the buffer; indices are predicted starting from the given base index
+	const unsigned char* decode(const unsigned char* bufferPtr,Vertex* vertices,size_t numVertices,Index* indices,size_t numIndices,Index baseIndex) const; // Decodes a batch of vertices and vertex indices encoded with any precision and domain from the buffer; returns a pointer behind the batch
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_ELEMENTSTREAMCODEC_IMPLEMENTATION
+#include <Templatized/ElementStreamCodec.cpp>
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+/***********************************************************************
+ExternalStorage - Base class for objects owning blocks of memory that
+are adopted by data sets as vertex storage without copying, such as
+memory-mapped data files.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_EXTERNALSTORAGE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_EXTERNALSTORAGE_INCLUDED
+
+namespace Visualization {
+
+namespace Templatized {
+
+class ExternalStorage
+	{
+	/* Constructors and destructors: */
+	public:
+	ExternalStorage(void)
+		{
+		}
+	private:
+	ExternalStorage(const ExternalStorage& source); // Prohibit copy constructor
+	ExternalStorage& operator=(const ExternalStorage& source); // Prohibit assignment operator
+	public:
+	virtual ~ExternalStorage(void) // Releases the owned memory
+		{
+		}
+	};
+
+}
+
+}
+
+#endif
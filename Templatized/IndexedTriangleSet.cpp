@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_TEMPLATIZED_INDEXEDTRIANGLESET_IMPLEMENTATION
 
+#include <vector>
 #include <Misc/ThrowStdErr.h>
 #include <Comm/MulticastPipe.h>
 #define GL_GLEXT_PROTOTYPES 1
@@ -33,6 +34,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/GLExtensionManager.h>
 #include <GL/Extensions/GLARBVertexBufferObject.h>
 
+#include <Templatized/ElementChecksum.h>
 #include <Templatized/IndexedTriangleSet.h>
 
 namespace Visualization {
@@ -98,9 +100,7 @@ IndexedTriangleSet<VertexParam>::addNewVertexChunk(
 		if(vertexTail!=0&&(numUnsentVertices=vertexChunkSize-tailNumSentVertices)>0)
 			{
 			/* Send unsent vertices in the last chunk across the pipe: */
-			pipe->write<unsigned int>((unsigned int)numUnsentVertices);
-			pipe->write<unsigned int>(0U);
-			pipe->write<Vertex>(vertexTail->vertices+tailNumSentVertices,numUnsentVertices);
+			writeBatch(vertexTail->vertices+tailNumSentVertices,numUnsentVertices,0,0);
 			pipe->finishMessage();
 			}
 		
@@ -136,14 +136,8 @@ IndexedTriangleSet<VertexParam>::addNewIndexChunk(
 			size_t numUnsentVertices=vertexTail!=0?vertexChunkSize-numVerticesLeft-tailNumSentVertices:0;
 			
 			/* Send unsent vertices and triangles in the last chunks across the pipe: */
-			pipe->write<unsigned int>(numUnsentVertices);
-			pipe->write<unsigned int>(numUnsentTriangles);
-			if(numUnsentVertices>0)
-				{
-				pipe->write<Vertex>(vertexTail->vertices+tailNumSentVertices,numUnsentVertices);
-				tailNumSentVertices+=numUnsentVertices;
-				}
-			pipe->write<Index>(indexTail->indices+tailNumSentTriangles*3,numUnsentTriangles*3);
+			writeBatch(numUnsentVertices>0?vertexTail->vertices+tailNumSentVertices:0,numUnsentVertices,indexTail->indices+tailNumSentTriangles*3,numUnsentTriangles);
+			tailNumSentVertices+=numUnsentVertices;
 			pipe->finishMessage();
 			}
 		
@@ -163,6 +157,40 @@ IndexedTriangleSet<VertexParam>::addNewIndexChunk(
 	nextTriangle=indexTail->indices;
 	}
 
+template <class VertexParam>
+inline
+void
+IndexedTriangleSet<VertexParam>::writeBatch(
+	const typename IndexedTriangleSet<VertexParam>::Vertex* batchVertices,
+	size_t numBatchVertices,
+	const typename IndexedTriangleSet<VertexParam>::Index* batchIndices,
+	size_t numBatchTriangles)
+	{
+	/* Write the batch header: */
+	pipe->write<unsigned int>((unsigned int)numBatchVertices);
+	pipe->write<unsigned int>((unsigned int)numBatchTriangles);
+	
+	if(codec.isEnabled())
+		{
+		/* Compress the batch, predicting vertex indices from the index of the batch's first vertex: */
+		streamBuffer.clear();
+		codec.encode(batchVertices,numBatchVertices,batchIndices,numBatchTriangles*3,Index(numVertices-numBatchVertices),streamBuffer);
+		
+		/* Send the compressed batch: */
+		pipe->write<unsigned int>((unsigned int)streamBuffer.size());
+		pipe->write<unsigned char>(&streamBuffer[0],streamBuffer.size());
+		}
+	else
+		{
+		/* Send the batch uncompressed: */
+		pipe->write<unsigned int>(0U);
+		if(numBatchVertices>0)
+			pipe->write<Vertex>(batchVertices,numBatchVertices);
+		if(numBatchTriangles>0)
+			pipe->write<Index>(batchIndices,numBatchTriangles*3);
+		}
+	}
+
 template <class VertexParam>
 inline
 IndexedTriangleSet<VertexParam>::IndexedTriangleSet(
@@ -244,6 +272,58 @@ IndexedTriangleSet<VertexParam>::clear(
 	nextTriangle=0;
 	}
 
+template <class VertexParam>
+inline
+void
+IndexedTriangleSet<VertexParam>::append(
+	const IndexedTriangleSet<VertexParam>& source,
+	typename IndexedTriangleSet<VertexParam>::Index* vertexIndexMap)
+	{
+	/* Append all unmapped source vertices one chunk at a time: */
+	Index indexOffset=Index(numVertices);
+	size_t sourceIndex=0;
+	size_t verticesToCopy=source.numVertices;
+	for(const VertexChunk* chPtr=source.vertexHead;verticesToCopy>0;chPtr=chPtr->succ)
+		{
+		/* Calculate the number of vertices in this chunk: */
+		size_t numChunkVertices=verticesToCopy;
+		if(numChunkVertices>vertexChunkSize)
+			numChunkVertices=vertexChunkSize;
+		
+		/* Copy the vertices: */
+		for(size_t i=0;i<numChunkVertices;++i,++sourceIndex)
+			if(vertexIndexMap==0||vertexIndexMap[sourceIndex]==~Index(0))
+				{
+				*getNextVertex()=chPtr->vertices[i];
+				Index newIndex=addVertex();
+				if(vertexIndexMap!=0)
+					vertexIndexMap[sourceIndex]=newIndex;
+				}
+		verticesToCopy-=numChunkVertices;
+		}
+	
+	/* Append all source triangles one chunk at a time: */
+	size_t trianglesToCopy=source.numTriangles;
+	for(const IndexChunk* chPtr=source.indexHead;trianglesToCopy>0;chPtr=chPtr->succ)
+		{
+		/* Calculate the number of triangles in this chunk: */
+		size_t numChunkTriangles=trianglesToCopy;
+		if(numChunkTriangles>indexChunkSize)
+			numChunkTriangles=indexChunkSize;
+		
+		/* Copy the triangles and remap their vertex indices: */
+		const Index* sPtr=chPtr->indices;
+		for(size_t i=0;i<numChunkTriangles;++i,sPtr+=3)
+			{
+			Index* iPtr=getNextTriangle();
+			for(int j=0;j<3;++j)
+				iPtr[j]=vertexIndexMap!=0?vertexIndexMap[sPtr[j]]:sPtr[j]+indexOffset;
+			addTriangle();
+			}
+		trianglesToCopy-=numChunkTriangles;
+		}
+	}
+
 template <class VertexParam>
 inline
 void
@@ -260,6 +340,24 @@ IndexedTriangleSet<VertexParam>::receive(
 		if(numBatchVertices==0&&numBatchTriangles==0)
 			break;
 		
+		/* Check if the batch was compressed: */
+		size_t numEncodedBytes=pipe->read<unsigned int>();
+		std::vector<Vertex> decodedVertices;
+		std::vector<Index> decodedIndices;
+		const Vertex* dvPtr=0;
+		const Index* diPtr=0;
+		if(numEncodedBytes>0)
+			{
+			/* Receive and decompress the entire batch: */
+			streamBuffer.resize(numEncodedBytes);
+			pipe->read<unsigned char>(&streamBuffer[0],numEncodedBytes);
+			decodedVertices.resize(numBatchVertices);
+			decodedIndices.resize(numBatchTriangles*3);
+			codec.decode(&streamBuffer[0],numBatchVertices>0?&decodedVertices[0]:0,numBatchVertices,numBatchTriangles>0?&decodedIndices[0]:0,numBatchTriangles*3,Index(numVertices));
+			dvPtr=numBatchVertices>0?&decodedVertices[0]:0;
+			diPtr=numBatchTriangles>0?&decodedIndices[0]:0;
+			}
+		
 		/* Read the vertex data one chunk at a time: */
 		while(numBatchVertices>0)
 			{
@@ -282,7 +380,13 @@ IndexedTriangleSet<VertexParam>::receive(
 			size_t numReadVertices=numBatchVertices;
 			if(numReadVertices>numVerticesLeft)
 				numReadVertices=numVerticesLeft;
-			pipe->read<Vertex>(nextVertex,numReadVertices);
+			if(dvPtr!=0)
+				{
+				for(size_t i=0;i<numReadVertices;++i,++dvPtr)
+					nextVertex[i]=*dvPtr;
+				}
+			else
+				pipe->read<Vertex>(nextVertex,numReadVertices);
 			numBatchVertices-=numReadVertices;
 			
 			/* Update the vertex storage: */
@@ -313,7 +417,13 @@ IndexedTriangleSet<VertexParam>::receive(
 			size_t numReadTriangles=numBatchTriangles;
 			if(numReadTriangles>numTrianglesLeft)
 				numReadTriangles=numTrianglesLeft;
-			pipe->read<Index>(nextTriangle,numReadTriangles*3);
+			if(diPtr!=0)
+				{
+				for(size_t i=0;i<numReadTriangles*3;++i,++diPtr)
+					nextTriangle[i]=*diPtr;
+				}
+			else
+				pipe->read<Index>(nextTriangle,numReadTriangles*3);
 			numBatchTriangles-=numReadTriangles;
 			
 			/* Update the triangle storage: */
@@ -338,18 +448,9 @@ IndexedTriangleSet<VertexParam>::flush(
 		if(numUnsentVertices>0||numUnsentTriangles>0)
 			{
 			/* Send all unsent vertices and triangles across the pipe: */
-			pipe->write<unsigned int>((unsigned int)numUnsentVertices);
-			pipe->write<unsigned int>((unsigned int)numUnsentTriangles);
-			if(numUnsentVertices>0)
-				{
-				pipe->write<Vertex>(vertexTail->vertices+tailNumSentVertices,numUnsentVertices);
-				tailNumSentVertices+=numUnsentVertices;
-				}
-			if(numUnsentTriangles>0)
-				{
-				pipe->write<Index>(indexTail->indices+tailNumSentTriangles*3,numUnsentTriangles*3);
-				tailNumSentTriangles+=numUnsentTriangles;
-				}
+			writeBatch(numUnsentVertices>0?vertexTail->vertices+tailNumSentVertices:0,numUnsentVertices,numUnsentTriangles>0?indexTail->indices+tailNumSentTriangles*3:0,numUnsentTriangles);
+			tailNumSentVertices+=numUnsentVertices;
+			tailNumSentTriangles+=numUnsentTriangles;
 			}
 		
 		/* Send a flush signal: */
@@ -359,6 +460,41 @@ IndexedTriangleSet<VertexParam>::flush(
 		}
 	}
 
+template <class VertexParam>
+inline
+unsigned int
+IndexedTriangleSet<VertexParam>::calcChecksum(
+	void) const
+	{
+	ElementChecksum checksum;
+	checksum.add(numVertices);
+	checksum.add(numTriangles);
+	
+	/* Add all vertices: */
+	size_t verticesLeft=numVertices;
+	for(const VertexChunk* chPtr=vertexHead;verticesLeft>0;chPtr=chPtr->succ)
+		{
+		size_t numChunkVertices=verticesLeft;
+		if(numChunkVertices>vertexChunkSize)
+			numChunkVertices=vertexChunkSize;
+		checksum.add(chPtr->vertices,numChunkVertices*sizeof(Vertex));
+		verticesLeft-=numChunkVertices;
+		}
+	
+	/* Add all vertex indices: */
+	size_t trianglesLeft=numTriangles;
+	for(const IndexChunk* chPtr=indexHead;trianglesLeft>0;chPtr=chPtr->succ)
+		{
+		size_t numChunkTriangles=trianglesLeft;
+		if(numChunkTriangles>indexChunkSize)
+			numChunkTriangles=indexChunkSize;
+		checksum.add(chPtr->indices,numChunkTriangles*3*sizeof(Index));
+		trianglesLeft-=numChunkTriangles;
+		}
+	
+	return checksum.getChecksum();
+	}
+
 template <class VertexParam>
 inline
 void
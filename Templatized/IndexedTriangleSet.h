@@ -26,6 +26,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 
+#include <Templatized/ElementStreamCodec.h>
+
 /* Forward declarations: */
 namespace Comm {
 class MulticastPipe;
@@ -93,6 +95,8 @@ class IndexedTriangleSet:public GLObject
 	/* Elements: */
 	private:
 	Comm::MulticastPipe* pipe; // Pipe to stream triangle set data in a cluster environment (owned by caller)
+	ElementStreamCodec<Vertex> codec; // Codec to compress triangle set data streamed across the pipe
+	typename ElementStreamCodec<Vertex>::Buffer streamBuffer; // Buffer holding compressed triangle set data
 	unsigned int version; // Version number of the triangle set (incremented on each clear operation)
 	size_t numVertices; // Number of vertices in the triangle set
 	size_t numTriangles; // Number of triangles (index triples) in the triangle set
@@ -110,6 +114,7 @@ class IndexedTriangleSet:public GLObject
 	/* Private methods: */
 	void addNewVertexChunk(void); // Adds a new chunk to the vertex buffer
 	void addNewIndexChunk(void); // Adds a new chunk to the index buffer
+	void writeBatch(const Vertex* batchVertices,size_t numBatchVertices,const Index* batchIndices,size_t numBatchTriangles); // Writes the most recently added vertices and a set of triangles to the pipe, compressed if compression is enabled
 	
 	/* Constructors and destructors: */
 	public:
@@ -122,6 +127,12 @@ class IndexedTriangleSet:public GLObject
 	
 	/* Methods: */
 	virtual void initContext(GLContextData& contextData) const;
+	template <class BoxParam>
+	void setStreamCompression(const BoxParam& domain,unsigned int positionBits,unsigned int normalBits) // Compresses data streamed across the pipe by quantizing positions relative to the given domain box with the given number of bits; zero position bits streams uncompressed data
+		{
+		codec.setDomain(domain);
+		codec.setPrecision(positionBits,normalBits);
+		}
 	void clear(void); // Removes all triangles from the set
 	Vertex* getNextVertex(void) // Returns pointer to next vertex in buffer
 		{
@@ -158,6 +169,7 @@ class IndexedTriangleSet:public GLObject
 		--numTrianglesLeft;
 		nextTriangle+=3;
 		}
+	void append(const IndexedTriangleSet& source,Index* vertexIndexMap); // Appends all triangles of the source set; source vertices with map entry ~Index(0) are appended and their new indices stored in the map, all others are replaced by their mapped indices; a null map appends all source vertices
 	void receive(void); // Receives triangle set data via multicast pipe until next flush() point
 	void flush(void); // Sends pending triangle set data across the multicast pipe and terminates receive() method on slaves
 	size_t getNumVertices(void) const // Returns number of vertices currently in buffer
@@ -168,6 +180,7 @@ class IndexedTriangleSet:public GLObject
 		{
 		return numTriangles;
 		}
+	unsigned int calcChecksum(void) const; // Returns a checksum over all vertices and triangles in the buffer
 	void glRenderAction(GLContextData& contextData) const; // Renders all triangles in the buffer
 	};
 
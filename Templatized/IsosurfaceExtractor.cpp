@@ -22,6 +22,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTOR_IMPLEMENTATION
 
+#include <vector>
+
 #include <Templatized/IsosurfaceExtractor.h>
 
 namespace Visualization {
@@ -108,7 +110,7 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IsosurfaceParam>::extractS
 	Vector cvgs[CellTopology::numVertices];
 	for(int i=0;i<CellTopology::numVertices;++i)
 		if(cvgns[i])
-			cvgs[i]=cell.calcVertexGradient(i,scalarExtractor);
+			cvgs[i]=gradientCache!=0?gradientCache->getVertexGradient(cell.getVertexID(i)):cell.calcVertexGradient(i,scalarExtractor);
 	
 	/* Calculate the edge intersection points: */
 	typename Vertex::Position edgeVertices[CellTopology::numEdges];
@@ -151,6 +153,7 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IsosurfaceParam>::Isosurfa
 	:dataSet(sDataSet),
 	 scalarExtractor(sScalarExtractor),
 	 extractionMode(FLAT),
+	 gradientCache(0),
 	 isosurface(0),
 	 cellQueue(101)
 	{
@@ -206,6 +209,49 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IsosurfaceParam>::extractI
 	isosurface=0;
 	}
 
+template <class DataSetParam,class ScalarExtractorParam,class IsosurfaceParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IsosurfaceParam>::extractIsosurface(
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IsosurfaceParam>::VScalar newIsovalue,
+	const typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IsosurfaceParam>::CellTree& cellTree,
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IsosurfaceParam>::Isosurface& newIsosurface)
+	{
+	/* Set the isosurface extraction parameters: */
+	isovalue=newIsovalue;
+	isosurface=&newIsosurface;
+	
+	/* Find all cells whose value ranges contain the isovalue: */
+	std::vector<typename CellTree::CellRange> activeCells;
+	cellTree.findActiveCells(isovalue,activeCells);
+	
+	/* Extract isosurface fragments from all active cells: */
+	for(typename std::vector<typename CellTree::CellRange>::const_iterator acIt=activeCells.begin();acIt!=activeCells.end();++acIt)
+		{
+		Cell cell=dataSet->getCell(acIt->firstCellID);
+		if(extractionMode==FLAT)
+			{
+			for(size_t i=0;i<acIt->numCells;++i,++cell)
+				{
+				/* Extract the cell's isosurface fragment: */
+				extractFlatIsosurfaceFragment(cell);
+				}
+			}
+		else
+			{
+			for(size_t i=0;i<acIt->numCells;++i,++cell)
+				{
+				/* Extract the cell's isosurface fragment: */
+				extractSmoothIsosurfaceFragment(cell);
+				}
+			}
+		}
+	isosurface->flush();
+	
+	/* Clean up: */
+	isosurface=0;
+	}
+
 template <class DataSetParam,class ScalarExtractorParam,class IsosurfaceParam>
 inline
 void
@@ -24,6 +24,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTOR_INCLUDED
 
 #include <Misc/OneTimeQueue.h>
+#include <Templatized/CellValueRangeTree.h>
+#include <Templatized/VertexGradientCache.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -51,6 +53,8 @@ class IsosurfaceExtractor
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef IsosurfaceParam Isosurface; // Type of isosurface representation
+	typedef CellValueRangeTree<DataSet,ScalarExtractor> CellTree; // Type of interval trees to find active cells for global isosurface extraction
+	typedef VertexGradientCache<DataSet,ScalarExtractor> GradientCache; // Type of caches of precalculated vertex gradients for smooth-shaded extraction
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
 		{
@@ -70,6 +74,7 @@ class IsosurfaceExtractor
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	ExtractionMode extractionMode; // Surface extraction mode
+	const GradientCache* gradientCache; // Cache of precalculated vertex gradients of the current scalar variable, or 0 to calculate gradients on the fly
 	
 	/* Isosurface extraction state: */
 	VScalar isovalue; // The current isovalue
@@ -106,13 +111,23 @@ class IsosurfaceExtractor
 		{
 		return extractionMode;
 		}
-	void update(const DataSet* newDataSet,const ScalarExtractor& newScalarExtractor) // Sets a new data set and scalar extractor for subsequent isosurface extraction
+	void update(const DataSet* newDataSet,const ScalarExtractor& newScalarExtractor) // Sets a new data set and scalar extractor for subsequent isosurface extraction; stops using the gradient cache
 		{
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
+		gradientCache=0;
 		}
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
+	const GradientCache* getGradientCache(void) const // Returns the cache of vertex gradients used for smooth-shaded extraction, or 0
+		{
+		return gradientCache;
+		}
+	void setGradientCache(const GradientCache* newGradientCache) // Looks up vertex gradients in the given cache, which must have been created for the current data set and scalar extractor, instead of calculating them; null pointer calculates gradients on the fly
+		{
+		gradientCache=newGradientCache;
+		}
 	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
+	void extractIsosurface(VScalar newIsovalue,const CellTree& cellTree,Isosurface& newIsosurface); // Ditto; only visits the cells found by the given interval tree, which must have been created for the current data set and scalar extractor
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
 	void startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Starts extracting a seeded isosurface for the given isovalue from the given cell
 	template <class ContinueFunctorParam>
@@ -22,6 +22,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTORINDEXEDTRIANGLESET_IMPLEMENTATION
 
+#include <algorithm>
+#include <vector>
+#include <Math/Math.h>
+#include <Threads/Thread.h>
+
+#include <Templatized/Tesseract.h>
+#include <Templatized/IsosurfaceCaseTableTesseract.h>
 #include <Templatized/IsosurfaceExtractorIndexedTriangleSet.h>
 
 namespace Visualization {
@@ -32,6 +39,25 @@ namespace Templatized {
 Methods of class IsosurfaceExtractor:
 ************************************/
 
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::startVertexSharing(
+	bool cellOrder)
+	{
+	/* Only use edge slabs for smooth extraction if cells are visited in iteration order, and the data set's edge IDs are dense linear indices: */
+	useEdgeSlabs=false;
+	if(cellOrder&&extractionMode==SMOOTH&&edgeSlabsEnabled&&SlabTraits::denseEdgeIDs)
+		{
+		size_t slabSize=SlabTraits::getSlabSize(*dataSet);
+		if(slabSize>0)
+			{
+			vertexIndexSlabs.setSlabSize(slabSize);
+			useEdgeSlabs=true;
+			}
+		}
+	}
+
 template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
 inline
 int
@@ -111,17 +137,9 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 			EdgeID edgeID=cell.getEdgeID(edge);
 			
 			/* Check if the edge already has a vertex in the isosurface: */
-			typename VertexIndexHasher::Iterator vIt=vertexIndices.findEntry(edgeID);
-			if(!vIt.isFinished())
+			edgeVertexIndices[edge]=findEdgeVertex(edgeID);
+			if(edgeVertexIndices[edge]==~Index(0))
 				{
-				/* Store the vertex index: */
-				edgeVertexIndices[edge]=vIt->getDest();
-				}
-			else
-				{
-				/* Mark the vertex as invalid: */
-				edgeVertexIndices[edge]=~Index(0);
-				
 				/* Mark the edge's gradients as required: */
 				for(int i=0;i<2;++i)
 					cvgns[CellTopology::edgeVertexIndices[edge][i]]=true;
@@ -132,7 +150,7 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 	Vector cvgs[CellTopology::numVertices];
 	for(int i=0;i<CellTopology::numVertices;++i)
 		if(cvgns[i])
-			cvgs[i]=cell.calcVertexGradient(i,scalarExtractor);
+			cvgs[i]=gradientCache!=0?gradientCache->getVertexGradient(cell.getVertexID(i)):cell.calcVertexGradient(i,scalarExtractor);
 	
 	/* Calculate the edge intersection points: */
 	for(int edge=0;edge<CellTopology::numEdges;++edge)
@@ -152,9 +170,12 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 			vertex->normal=v.getComponents();
 			vertex->position=cell.calcEdgePosition(edge,w1).getComponents();
 			
-			/* Store the vertex in the isosurface, and its index in the hash table: */
+			/* Store the vertex in the isosurface, and its index in the edge-to-vertex map: */
 			edgeVertexIndices[edge]=isosurface->addVertex();
-			vertexIndices.setEntry(typename VertexIndexHasher::Entry(cell.getEdgeID(edge),edgeVertexIndices[edge]));
+			EdgeID edgeID=cell.getEdgeID(edge);
+			setEdgeVertex(edgeID,edgeVertexIndices[edge]);
+			if(recordVertexEdgeIDs)
+				vertexEdgeIDs.push_back(edgeID);
 			}
 	
 	/* Store the resulting isosurface fragment in the isosurface: */
@@ -169,6 +190,189 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 	return caseIndex;
 	}
 
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::extractCellRanges(
+	const typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::CellRange* rangesBegin,
+	const typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::CellRange* rangesEnd)
+	{
+	for(const CellRange* crPtr=rangesBegin;crPtr!=rangesEnd;++crPtr)
+		{
+		Cell cell=dataSet->getCell(crPtr->firstCellID);
+		numVisitedCells+=crPtr->numCells;
+		if(extractionMode==FLAT)
+			{
+			for(size_t i=0;i<crPtr->numCells;++i,++cell)
+				{
+				/* Extract the cell's isosurface fragment: */
+				extractFlatIsosurfaceFragment(cell);
+				}
+			}
+		else
+			{
+			for(size_t i=0;i<crPtr->numCells;++i,++cell)
+				{
+				/* Extract the cell's isosurface fragment: */
+				extractSmoothIsosurfaceFragment(cell);
+				}
+			}
+		}
+	}
+
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void*
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::extractSliceThreadMethod(
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::ExtractionSlice* slice)
+	{
+	/* Extract the slice's fragments into the slice's private isosurface: */
+	IsosurfaceExtractor* sliceExtractor=slice->extractor;
+	sliceExtractor->isovalue=isovalue;
+	sliceExtractor->isosurface=slice->surface;
+	sliceExtractor->startVertexSharing(true);
+	sliceExtractor->extractCellRanges(slice->rangesBegin,slice->rangesEnd);
+	sliceExtractor->isosurface=0;
+	
+	/* Find the range of edge indices the slice's vertices lie on, to limit seam merging to edges shared with other slices: */
+	slice->minEdgeIndex=~size_t(0);
+	slice->maxEdgeIndex=0;
+	if(SlabTraits::denseEdgeIDs)
+		{
+		for(typename std::vector<EdgeID>::const_iterator eIt=sliceExtractor->vertexEdgeIDs.begin();eIt!=sliceExtractor->vertexEdgeIDs.end();++eIt)
+			{
+			size_t edgeIndex=SlabTraits::getEdgeIndex(*eIt);
+			if(slice->minEdgeIndex>edgeIndex)
+				slice->minEdgeIndex=edgeIndex;
+			if(slice->maxEdgeIndex<edgeIndex)
+				slice->maxEdgeIndex=edgeIndex;
+			}
+		}
+	
+	return 0;
+	}
+
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::extractSlices(
+	const std::vector<typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::CellRange>& cellRanges,
+	size_t numCells,
+	unsigned int numThreads)
+	{
+	if(numCells==0)
+		return;
+	
+	/* Split the cell runs into contiguous slices of approximately equal size: */
+	const CellRange* crBase=&cellRanges[0];
+	ExtractionSlice* slices=new ExtractionSlice[numThreads];
+	size_t cellIndex=0;
+	size_t rangeIndex=0;
+	for(unsigned int i=0;i<numThreads;++i)
+		{
+		slices[i].rangesBegin=crBase+rangeIndex;
+		size_t sliceEnd=(numCells*(i+1))/numThreads;
+		while(rangeIndex<cellRanges.size()&&cellIndex<sliceEnd)
+			{
+			cellIndex+=cellRanges[rangeIndex].numCells;
+			++rangeIndex;
+			}
+		slices[i].rangesEnd=crBase+rangeIndex;
+		
+		/* Create a private extractor and isosurface for the slice: */
+		slices[i].extractor=new IsosurfaceExtractor(dataSet,scalarExtractor);
+		slices[i].extractor->extractionMode=extractionMode;
+		slices[i].extractor->gradientCache=gradientCache;
+		slices[i].extractor->edgeSlabsEnabled=edgeSlabsEnabled;
+		slices[i].extractor->recordVertexEdgeIDs=true;
+		slices[i].surface=new Isosurface(0);
+		}
+	
+	/* Extract the first slice in the calling thread, and all other slices in worker threads: */
+	Threads::Thread* workerThreads=new Threads::Thread[numThreads-1];
+	for(unsigned int i=1;i<numThreads;++i)
+		workerThreads[i-1].start(this,&IsosurfaceExtractor::extractSliceThreadMethod,&slices[i]);
+	extractSliceThreadMethod(&slices[0]);
+	for(unsigned int i=1;i<numThreads;++i)
+		workerThreads[i-1].join();
+	delete[] workerThreads;
+	
+	/* Find the smallest edge index used by any later slice for each slice: */
+	std::vector<size_t> laterMinEdgeIndices(numThreads);
+	size_t laterMinEdgeIndex=~size_t(0);
+	for(unsigned int i=numThreads;i>0;--i)
+		{
+		laterMinEdgeIndices[i-1]=laterMinEdgeIndex;
+		if(laterMinEdgeIndex>slices[i-1].minEdgeIndex)
+			laterMinEdgeIndex=slices[i-1].minEdgeIndex;
+		}
+	
+	/* Merge the partial isosurfaces in slice order: */
+	size_t earlierMaxEdgeIndex=0;
+	for(unsigned int i=0;i<numThreads;++i)
+		{
+		if(extractionMode==FLAT)
+			{
+			/* Flat-shaded fragments do not share vertices: */
+			isosurface->append(*slices[i].surface,0);
+			}
+		else
+			{
+			const std::vector<EdgeID>& sliceEdgeIDs=slices[i].extractor->vertexEdgeIDs;
+			size_t numSliceVertices=sliceEdgeIDs.size();
+			std::vector<Index> vertexIndexMap(numSliceVertices,~Index(0));
+			Index nextIndex=Index(isosurface->getNumVertices());
+			if(SlabTraits::denseEdgeIDs)
+				{
+				/* Only vertices on edges also used by an earlier or later slice can lie on a seam; all others are appended in order: */
+				for(size_t vi=0;vi<numSliceVertices;++vi)
+					{
+					size_t edgeIndex=SlabTraits::getEdgeIndex(sliceEdgeIDs[vi]);
+					if(i>0&&edgeIndex<=earlierMaxEdgeIndex)
+						{
+						/* Map the vertex to the vertex already created by an earlier slice: */
+						typename VertexIndexHasher::Iterator vIt=vertexIndices.findEntry(sliceEdgeIDs[vi]);
+						if(!vIt.isFinished())
+							{
+							vertexIndexMap[vi]=vIt->getDest();
+							continue;
+							}
+						}
+					if(edgeIndex>=laterMinEdgeIndices[i])
+						vertexIndices.setEntry(typename VertexIndexHasher::Entry(sliceEdgeIDs[vi],nextIndex));
+					++nextIndex;
+					}
+				if(earlierMaxEdgeIndex<slices[i].maxEdgeIndex)
+					earlierMaxEdgeIndex=slices[i].maxEdgeIndex;
+				}
+			else
+				{
+				/* Map all vertices on edges that already have a vertex to that vertex: */
+				for(size_t vi=0;vi<numSliceVertices;++vi)
+					{
+					typename VertexIndexHasher::Iterator vIt=vertexIndices.findEntry(sliceEdgeIDs[vi]);
+					if(vIt.isFinished())
+						{
+						/* The vertex will be appended in order: */
+						vertexIndices.setEntry(typename VertexIndexHasher::Entry(sliceEdgeIDs[vi],nextIndex));
+						++nextIndex;
+						}
+					else
+						vertexIndexMap[vi]=vIt->getDest();
+					}
+				}
+			if(numSliceVertices>0)
+				isosurface->append(*slices[i].surface,&vertexIndexMap[0]);
+			}
+		
+		/* Destroy the slice's private state: */
+		numVisitedCells+=slices[i].extractor->numVisitedCells;
+		delete slices[i].extractor;
+		delete slices[i].surface;
+		}
+	delete[] slices;
+	}
+
 template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
 inline
 IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::IsosurfaceExtractor(
@@ -177,9 +381,15 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 	:dataSet(sDataSet),
 	 scalarExtractor(sScalarExtractor),
 	 extractionMode(FLAT),
+	 gradientCache(0),
 	 isosurface(0),
 	 vertexIndices(101),
-	 cellQueue(101)
+	 edgeSlabsEnabled(true),useEdgeSlabs(false),
+	 recordVertexEdgeIDs(false),
+	 cellQueue(101),
+	 numVisitedCells(0),
+	 activeIsovalue(0),activeCellsValid(false),
+	 numRevisitedCells(0)
 	{
 	}
 
@@ -209,11 +419,13 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 	/* Set the isosurface extraction parameters: */
 	isovalue=newIsovalue;
 	isosurface=&newIsosurface;
+	startVertexSharing(true);
+	numVisitedCells=0;
 	
 	/* Extract isosurface fragments from all cells: */
 	if(extractionMode==FLAT)
 		{
-		for(typename DataSet::CellIterator cIt=dataSet->beginCells();cIt!=dataSet->endCells();++cIt)
+		for(typename DataSet::CellIterator cIt=dataSet->beginCells();cIt!=dataSet->endCells();++cIt,++numVisitedCells)
 			{
 			/* Extract the cell's isosurface fragment: */
 			extractFlatIsosurfaceFragment(*cIt);
@@ -221,7 +433,7 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 		}
 	else
 		{
-		for(typename DataSet::CellIterator cIt=dataSet->beginCells();cIt!=dataSet->endCells();++cIt)
+		for(typename DataSet::CellIterator cIt=dataSet->beginCells();cIt!=dataSet->endCells();++cIt,++numVisitedCells)
 			{
 			/* Extract the cell's isosurface fragment: */
 	  	extractSmoothIsosurfaceFragment(*cIt);
@@ -234,6 +446,468 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 	vertexIndices.clear();
 	}
 
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::extractIsosurface(
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::VScalar newIsovalue,
+	const typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::CellTree& cellTree,
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::Isosurface& newIsosurface)
+	{
+	/* Set the isosurface extraction parameters: */
+	isovalue=newIsovalue;
+	isosurface=&newIsosurface;
+	startVertexSharing(true);
+	numVisitedCells=0;
+	
+	/* Find all cells whose value ranges contain the isovalue: */
+	std::vector<CellRange> activeCells;
+	cellTree.findActiveCells(isovalue,activeCells);
+	
+	/* Extract isosurface fragments from all active cells: */
+	if(!activeCells.empty())
+		extractCellRanges(&activeCells[0],&activeCells[0]+activeCells.size());
+	isosurface->flush();
+	
+	/* Clean up: */
+	isosurface=0;
+	vertexIndices.clear();
+	}
+
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::extractIsosurface(
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::VScalar newIsovalue,
+	unsigned int numThreads,
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::Isosurface& newIsosurface)
+	{
+	/* Fall back to serial extraction if there is only one thread: */
+	if(numThreads<=1)
+		{
+		extractIsosurface(newIsovalue,newIsosurface);
+		return;
+		}
+	
+	/* Set the isosurface extraction parameters: */
+	isovalue=newIsovalue;
+	isosurface=&newIsosurface;
+	numVisitedCells=0;
+	
+	/* Split all cells into one run of consecutive cells per thread: */
+	size_t numCells=dataSet->getTotalNumCells();
+	std::vector<CellRange> cellRanges;
+	if(SlabTraits::denseEdgeIDs)
+		{
+		/* Look up the first cell of each run directly: */
+		for(unsigned int i=0;i<numThreads;++i)
+			{
+			size_t firstCell=(numCells*i)/numThreads;
+			size_t lastCell=(numCells*(i+1))/numThreads;
+			if(lastCell>firstCell)
+				{
+				CellRange range;
+				range.firstCellID=SlabTraits::getCellID(*dataSet,firstCell);
+				range.numCells=lastCell-firstCell;
+				cellRanges.push_back(range);
+				}
+			}
+		}
+	else
+		{
+		/* Find the first cell of each run by iterating through the cells: */
+		typename DataSet::CellIterator cIt=dataSet->beginCells();
+		size_t cellIndex=0;
+		for(unsigned int i=0;i<numThreads&&cIt!=dataSet->endCells();++i)
+			{
+			CellRange range;
+			range.firstCellID=cIt->getID();
+			range.numCells=0;
+			size_t lastCell=(numCells*(i+1))/numThreads;
+			for(;cellIndex<lastCell&&cIt!=dataSet->endCells();++cellIndex,++cIt)
+				++range.numCells;
+			if(range.numCells>0)
+				cellRanges.push_back(range);
+			}
+		}
+	
+	/* Extract isosurface fragments from all cells: */
+	extractSlices(cellRanges,numCells,numThreads);
+	isosurface->flush();
+	
+	/* Clean up: */
+	isosurface=0;
+	vertexIndices.clear();
+	}
+
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::extractIsosurface(
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::VScalar newIsovalue,
+	const typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::CellTree& cellTree,
+	unsigned int numThreads,
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::Isosurface& newIsosurface)
+	{
+	/* Fall back to serial extraction if there is only one thread: */
+	if(numThreads<=1)
+		{
+		extractIsosurface(newIsovalue,cellTree,newIsosurface);
+		return;
+		}
+	
+	/* Set the isosurface extraction parameters: */
+	isovalue=newIsovalue;
+	isosurface=&newIsosurface;
+	numVisitedCells=0;
+	
+	/* Find all cells whose value ranges contain the isovalue, in runs short enough to balance the threads' loads: */
+	std::vector<CellRange> activeCells;
+	size_t numActiveCells=cellTree.findActiveCells(isovalue,activeCells,size_t(cellTree.getBlockSize())*16);
+	
+	/* Extract isosurface fragments from all active cells: */
+	extractSlices(activeCells,numActiveCells,numThreads);
+	isosurface->flush();
+	
+	/* Clean up: */
+	isosurface=0;
+	vertexIndices.clear();
+	}
+
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::extractPreviewIsosurface(
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::VScalar newIsovalue,
+	unsigned int latticeSize,
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::Isosurface& newIsosurface)
+	{
+	typedef Tesseract<dimension> LatticeTopology;
+	typedef IsosurfaceCaseTable<LatticeTopology> LatticeCaseTable;
+	
+	/* Set the isosurface extraction parameters: */
+	isovalue=newIsovalue;
+	isosurface=&newIsosurface;
+	numVisitedCells=0;
+	
+	/* Lay a regular lattice over the data set's domain box, with the given number of cells along the box's longest side: */
+	const typename DataSet::Box& domainBox=dataSet->getDomainBox();
+	Scalar maxSize(0);
+	for(int i=0;i<dimension;++i)
+		if(maxSize<domainBox.getSize(i))
+			maxSize=domainBox.getSize(i);
+	int numVertices[dimension];
+	ptrdiff_t vertexStrides[dimension];
+	Scalar cellSize[dimension];
+	size_t numLatticeVertices=1;
+	for(int i=0;i<dimension;++i)
+		{
+		int numCells=int(Math::floor(domainBox.getSize(i)*Scalar(latticeSize)/maxSize+Scalar(0.5)));
+		if(numCells<1)
+			numCells=1;
+		numVertices[i]=numCells+1;
+		vertexStrides[i]=ptrdiff_t(numLatticeVertices);
+		cellSize[i]=domainBox.getSize(i)/Scalar(numCells);
+		numLatticeVertices*=size_t(numVertices[i]);
+		}
+	ptrdiff_t cornerOffsets[LatticeTopology::numVertices];
+	for(int corner=0;corner<LatticeTopology::numVertices;++corner)
+		{
+		cornerOffsets[corner]=0;
+		for(int i=0;i<dimension;++i)
+			if(corner&(1<<i))
+				cornerOffsets[corner]+=vertexStrides[i];
+		}
+	
+	/* Resample the scalar field at the lattice vertices, one row of vertices at a time: */
+	VScalar* values=new VScalar[numLatticeVertices];
+	bool* valids=new bool[numLatticeVertices];
+	Point* rowPositions=new Point[numVertices[0]];
+	Locator locator=dataSet->getLocator();
+	size_t numValidVertices=0;
+	for(size_t rowBase=0;rowBase<numLatticeVertices;rowBase+=numVertices[0])
+		{
+		Point rowStart=domainBox.min;
+		for(int i=1;i<dimension;++i)
+			rowStart[i]+=cellSize[i]*Scalar((rowBase/vertexStrides[i])%numVertices[i]);
+		for(int x=0;x<numVertices[0];++x)
+			{
+			rowPositions[x]=rowStart;
+			rowPositions[x][0]+=cellSize[0]*Scalar(x);
+			}
+		numValidVertices+=locator.calcValues(numVertices[0],rowPositions,false,scalarExtractor,values+rowBase,valids+rowBase);
+		}
+	delete[] rowPositions;
+	
+	if(numValidVertices>0)
+		{
+		/* Extend the field to lattice vertices outside the data set's domain by copying the nearest valid value along each lattice axis in turn: */
+		for(int axis=0;axis<dimension;++axis)
+			{
+			ptrdiff_t stride=vertexStrides[axis];
+			for(size_t lineBase=0;lineBase<numLatticeVertices;++lineBase)
+				if((lineBase/stride)%numVertices[axis]==0)
+					{
+					/* Fill the line's gaps from the left, and then its leading vertices from the right: */
+					size_t lineEnd=lineBase+size_t(numVertices[axis])*stride;
+					for(size_t v=lineBase+stride;v<lineEnd;v+=stride)
+						if(!valids[v]&&valids[v-stride])
+							{
+							values[v]=values[v-stride];
+							valids[v]=true;
+							}
+					for(size_t v=lineEnd-stride;v>lineBase;v-=stride)
+						if(!valids[v-stride]&&valids[v])
+							{
+							values[v-stride]=values[v];
+							valids[v-stride]=true;
+							}
+					}
+			}
+		
+		/* Share vertices between neighbouring lattice cells by mapping each lattice edge to its vertex index in the isosurface: */
+		Index* latticeEdgeVertices=0;
+		if(extractionMode==SMOOTH)
+			{
+			latticeEdgeVertices=new Index[numLatticeVertices*dimension];
+			for(size_t i=0;i<numLatticeVertices*dimension;++i)
+				latticeEdgeVertices[i]=~Index(0);
+			}
+		
+		/* Extract isosurface fragments from all lattice cells: */
+		for(size_t cellBase=0;cellBase<numLatticeVertices;++cellBase)
+			{
+			/* Skip the lattice vertices on the upper faces, which do not start a cell: */
+			int cellIndex[dimension];
+			bool isCell=true;
+			for(int i=0;i<dimension;++i)
+				{
+				cellIndex[i]=int((cellBase/vertexStrides[i])%numVertices[i]);
+				isCell=isCell&&cellIndex[i]<numVertices[i]-1;
+				}
+			if(!isCell)
+				continue;
+			++numVisitedCells;
+			
+			/* Determine cell vertex values and case index: */
+			VScalar cvvs[LatticeTopology::numVertices];
+			int caseIndex=0x0;
+			for(int corner=0;corner<LatticeTopology::numVertices;++corner)
+				{
+				cvvs[corner]=values[cellBase+cornerOffsets[corner]];
+				if(cvvs[corner]>=isovalue)
+					caseIndex|=1<<corner;
+				}
+			int cem=LatticeCaseTable::edgeMasks[caseIndex];
+			if(cem==0x0)
+				continue;
+			
+			/* Calculate the edge intersection points, or look up the vertices already created on the cell's edges: */
+			Point edgeVertices[LatticeTopology::numEdges];
+			Index edgeVertexIndices[LatticeTopology::numEdges];
+			for(int edge=0;edge<LatticeTopology::numEdges;++edge)
+				if(cem&(1<<edge))
+					{
+					int vi0=LatticeTopology::edgeVertexIndices[edge][0];
+					int vi1=LatticeTopology::edgeVertexIndices[edge][1];
+					int edgeAxis=0;
+					while(((vi0^vi1)>>edgeAxis)!=1)
+						++edgeAxis;
+					size_t edgeIndex=(cellBase+cornerOffsets[vi0])*dimension+edgeAxis;
+					if(latticeEdgeVertices!=0&&latticeEdgeVertices[edgeIndex]!=~Index(0))
+						{
+						edgeVertexIndices[edge]=latticeEdgeVertices[edgeIndex];
+						continue;
+						}
+					
+					/* Calculate the intersection point on the edge: */
+					VScalar d0=cvvs[vi0];
+					VScalar d1=cvvs[vi1];
+					Scalar w1=Scalar((isovalue-d0)/(d1-d0));
+					Point& p=edgeVertices[edge];
+					for(int i=0;i<dimension;++i)
+						p[i]=domainBox.min[i]+cellSize[i]*Scalar(cellIndex[i]+((vi0>>i)&1));
+					p[edgeAxis]+=cellSize[edgeAxis]*w1;
+					
+					if(latticeEdgeVertices!=0)
+						{
+						/* Interpolate the normal vector from the central-difference gradients at the edge's lattice vertices: */
+						Vector v=Vector::zero;
+						for(int ei=0;ei<2;++ei)
+							{
+							size_t vi=cellBase+cornerOffsets[LatticeTopology::edgeVertexIndices[edge][ei]];
+							Scalar w=ei==0?Scalar(1)-w1:w1;
+							for(int i=0;i<dimension;++i)
+								{
+								ptrdiff_t stride=vertexStrides[i];
+								int index=int((vi/stride)%numVertices[i]);
+								size_t vLow=index>0?vi-stride:vi;
+								size_t vHigh=index<numVertices[i]-1?vi+stride:vi;
+								v[i]+=w*Scalar(values[vHigh]-values[vLow])/(cellSize[i]*Scalar(vHigh-vLow)/Scalar(stride));
+								}
+							}
+						v/=-v.mag();
+						
+						/* Store the vertex in the isosurface, and its index in the lattice edge map: */
+						Vertex* vertex=isosurface->getNextVertex();
+						vertex->normal=v.getComponents();
+						vertex->position=p.getComponents();
+						edgeVertexIndices[edge]=isosurface->addVertex();
+						latticeEdgeVertices[edgeIndex]=edgeVertexIndices[edge];
+						}
+					}
+			
+			/* Store the resulting fragment in the isosurface: */
+			for(const int* ctei=LatticeCaseTable::triangleEdgeIndices[caseIndex];*ctei>=0;ctei+=3)
+				{
+				Index* iPtr=isosurface->getNextTriangle();
+				if(latticeEdgeVertices!=0)
+					{
+					for(int i=0;i<3;++i)
+						iPtr[i]=edgeVertexIndices[ctei[i]];
+					}
+				else
+					{
+					Vector normal=Geometry::cross(edgeVertices[ctei[1]]-edgeVertices[ctei[0]],edgeVertices[ctei[2]]-edgeVertices[ctei[0]]);
+					for(int i=0;i<3;++i)
+						{
+						Vertex* vertex=isosurface->getNextVertex();
+						vertex->normal=normal.getComponents();
+						vertex->position=edgeVertices[ctei[i]].getComponents();
+						iPtr[i]=isosurface->addVertex();
+						}
+					}
+				isosurface->addTriangle();
+				}
+			}
+		
+		delete[] latticeEdgeVertices;
+		}
+	isosurface->flush();
+	
+	/* Clean up: */
+	delete[] values;
+	delete[] valids;
+	isosurface=0;
+	}
+
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+inline
+void
+IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::extractIncrementalIsosurface(
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::VScalar newIsovalue,
+	const typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::CellTree* cellTree,
+	typename IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexParam> >::Isosurface& newIsosurface)
+	{
+	/* Set the isosurface extraction parameters: */
+	isovalue=newIsovalue;
+	isosurface=&newIsosurface;
+	startVertexSharing(false);
+	numVisitedCells=0;
+	numRevisitedCells=0;
+	
+	if(!activeCellsValid||(activeCellIDs.empty()&&cellTree==0))
+		{
+		/* Extract isosurface fragments from all cells and remember the active ones: */
+		activeCellIDs.clear();
+		for(typename DataSet::CellIterator cIt=dataSet->beginCells();cIt!=dataSet->endCells();++cIt,++numVisitedCells)
+			{
+			/* Extract the cell's isosurface fragment: */
+			int caseIndex;
+			if(extractionMode==FLAT)
+				caseIndex=extractFlatIsosurfaceFragment(*cIt);
+			else
+				caseIndex=extractSmoothIsosurfaceFragment(*cIt);
+			
+			/* Remember the cell if it is intersected by the isosurface: */
+			if(CaseTable::edgeMasks[caseIndex]!=0)
+				activeCellIDs.push_back(cIt->getID());
+			}
+		}
+	else
+		{
+		/* Calculate the interval of isovalues the isosurface swept through since the previous incremental extraction: */
+		VScalar sweptMin=activeIsovalue;
+		VScalar sweptMax=newIsovalue;
+		if(sweptMin>sweptMax)
+			std::swap(sweptMin,sweptMax);
+		
+		/* Seed the extraction with all previously active cells: */
+		cellQueue.clear();
+		for(typename std::vector<CellID>::const_iterator acIt=activeCellIDs.begin();acIt!=activeCellIDs.end();++acIt)
+			cellQueue.push(*acIt);
+		numRevisitedCells=activeCellIDs.size();
+		activeCellIDs.clear();
+		
+		if(cellTree!=0)
+			{
+			/* Also seed with all cells the interval tree finds for the swept interval, to catch isosurface components that appeared away from the previous isosurface: */
+			std::vector<CellRange> sweptCells;
+			cellTree->findActiveCells(sweptMin,sweptMax,sweptCells);
+			for(typename std::vector<CellRange>::const_iterator scIt=sweptCells.begin();scIt!=sweptCells.end();++scIt)
+				{
+				Cell cell=dataSet->getCell(scIt->firstCellID);
+				for(size_t i=0;i<scIt->numCells;++i,++cell)
+					cellQueue.push(cell.getID());
+				}
+			}
+		
+		/* Extract isosurface fragments until the queue is empty: */
+		while(!cellQueue.empty())
+			{
+			/* Get the next cell: */
+			Cell cell=dataSet->getCell(cellQueue.front());
+			cellQueue.pop();
+			++numVisitedCells;
+			
+			/* Extract the cell's isosurface fragment and remember the cell if it is intersected by the isosurface: */
+			int caseIndex;
+			if(extractionMode==FLAT)
+				caseIndex=extractFlatIsosurfaceFragment(cell);
+			else
+				caseIndex=extractSmoothIsosurfaceFragment(cell);
+			if(CaseTable::edgeMasks[caseIndex]!=0)
+				activeCellIDs.push_back(cell.getID());
+			
+			/* Get the cell's vertex values: */
+			VScalar vertexValues[CellTopology::numVertices];
+			for(int i=0;i<CellTopology::numVertices;++i)
+				vertexValues[i]=cell.getVertexValue(i,scalarExtractor);
+			
+			/* Walk across all faces the isosurface swept over between the previous and the new isovalue, whether the cell entered or left the active set: */
+			for(int i=0;i<CellTopology::numFaces;++i)
+				{
+				VScalar faceMin=vertexValues[CellTopology::faceVertexIndices[i][0]];
+				VScalar faceMax=faceMin;
+				for(int j=1;j<CellTopology::numFaceVertices;++j)
+					{
+					VScalar value=vertexValues[CellTopology::faceVertexIndices[i][j]];
+					if(faceMin>value)
+						faceMin=value;
+					if(faceMax<value)
+						faceMax=value;
+					}
+				if(faceMin<=sweptMax&&faceMax>=sweptMin)
+					{
+					CellID neighbourID=cell.getNeighbourID(i);
+					
+					/* Push the neighbour onto the queue if it is valid: */
+					if(neighbourID.isValid())
+						cellQueue.push(neighbourID);
+					}
+				}
+			}
+		cellQueue.clear();
+		}
+	activeIsovalue=newIsovalue;
+	activeCellsValid=true;
+	isosurface->flush();
+	
+	/* Clean up: */
+	isosurface=0;
+	vertexIndices.clear();
+	}
+
 template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
 inline
 void
@@ -244,6 +918,8 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 	/* Set the isosurface extraction parameters: */
 	isovalue=seedLocator.calcValue(scalarExtractor);
 	isosurface=&newIsosurface;
+	startVertexSharing(false);
+	numVisitedCells=0;
 	
 	/* Push the seed cell onto the queue: */
 	cellQueue.clear();
@@ -255,6 +931,7 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 		/* Get the next cell: */
 		Cell cell=dataSet->getCell(cellQueue.front());
 		cellQueue.pop();
+		++numVisitedCells;
 		
 		/* Extract the cell's isosurface fragment: */
 		int caseIndex;
@@ -292,6 +969,8 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 	/* Set the isosurface extraction parameters: */
 	isovalue=seedLocator.calcValue(scalarExtractor);
 	isosurface=&newIsosurface;
+	startVertexSharing(false);
+	numVisitedCells=0;
 	
 	/* Push the seed cell onto the queue: */
 	cellQueue.clear();
@@ -311,6 +990,7 @@ IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<VertexP
 		/* Get the next cell: */
 		Cell cell=dataSet->getCell(cellQueue.front());
 		cellQueue.pop();
+		++numVisitedCells;
 		
 		/* Extract the cell's isosurface fragment: */
 		int caseIndex;
@@ -23,8 +23,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTORINDEXEDTRIANGLESET_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTORINDEXEDTRIANGLESET_INCLUDED
 
+#include <vector>
 #include <Misc/HashTable.h>
 #include <Misc/OneTimeQueue.h>
+#include <Templatized/CellValueRangeTree.h>
+#include <Templatized/EdgeIndexSlabs.h>
+#include <Templatized/VertexGradientCache.h>
 #include <Templatized/IndexedTriangleSet.h>
 #include <Templatized/IsosurfaceExtractor.h>
 
@@ -54,6 +58,8 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef IndexedTriangleSet<VertexParam> Isosurface; // Type of isosurface representation
+	typedef CellValueRangeTree<DataSet,ScalarExtractor> CellTree; // Type of interval trees to find active cells for global isosurface extraction
+	typedef VertexGradientCache<DataSet,ScalarExtractor> GradientCache; // Type of caches of precalculated vertex gradients for smooth-shaded extraction
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
 		{
@@ -70,22 +76,67 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	typedef typename Isosurface::Vertex Vertex; // Type of vertices stored in isosurface
 	typedef typename Isosurface::Index Index; // Type for vertex indices
 	typedef Misc::HashTable<EdgeID,Index,EdgeID> VertexIndexHasher; // Hash table to map edge IDs to vertex indices in the isosurface
+	typedef EdgeIndexSlabTraits<DataSet> SlabTraits; // Traits class to check whether the data set's edge IDs can be mapped through edge slabs
+	typedef EdgeIndexSlabs<Index> VertexIndexSlabs; // Ring buffer to map edge IDs of structured data sets to vertex indices in the isosurface
+	typedef typename CellTree::CellRange CellRange; // Type for runs of consecutive active cells
+	
+	struct ExtractionSlice // Structure for contiguous slices of active cells processed by a single thread during parallel extraction
+		{
+		/* Elements: */
+		public:
+		const CellRange* rangesBegin; // First cell run in the slice
+		const CellRange* rangesEnd; // Cell run after the last one in the slice
+		IsosurfaceExtractor* extractor; // Private isosurface extractor holding the slice's edge-to-vertex map
+		Isosurface* surface; // Private isosurface receiving the slice's fragments
+		size_t minEdgeIndex,maxEdgeIndex; // Range of linear indices of the edges carrying the slice's vertices, if the data set has dense edge IDs
+		};
 	
 	/* Elements: */
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	ExtractionMode extractionMode; // Surface extraction mode
+	const GradientCache* gradientCache; // Cache of precalculated vertex gradients of the current scalar variable, or 0 to calculate gradients on the fly
 	
 	/* Isosurface extraction state: */
 	VScalar isovalue; // The current isovalue
 	Isosurface* isosurface; // Pointer to the isosurface representation storing extracted isosurface fragments
 	VertexIndexHasher vertexIndices; // Hasher mapping edge IDs to vertex indices in the isosurface
+	bool edgeSlabsEnabled; // Flag whether global extractions from structured data sets may map edge IDs to vertex indices through edge slabs
+	bool useEdgeSlabs; // Flag whether the current extraction maps edge IDs to vertex indices through edge slabs instead of the hasher
+	VertexIndexSlabs vertexIndexSlabs; // Ring buffer mapping edge IDs to vertex indices in the isosurface while cells are visited in iteration order
+	bool recordVertexEdgeIDs; // Flag whether to record the edge ID of every created vertex to merge partial isosurfaces
+	std::vector<EdgeID> vertexEdgeIDs; // Edge IDs of all vertices created in the current extraction, in vertex index order
 	CellQueue cellQueue; // Queue of cells waiting for fragment extraction
+	size_t numVisitedCells; // Number of cells visited by the most recent extraction
+	
+	/* Incremental isosurface extraction state: */
+	std::vector<CellID> activeCellIDs; // IDs of all cells that contributed fragments to the most recent incrementally extracted isosurface
+	VScalar activeIsovalue; // Isovalue of the most recent incrementally extracted isosurface
+	bool activeCellsValid; // Flag whether the active cell set was extracted from the current data set and scalar extractor
+	size_t numRevisitedCells; // Number of visited cells that were already active in the previous incremental extraction
 	
 	/* Private methods: */
+	void startVertexSharing(bool cellOrder); // Selects the edge-to-vertex index map for an extraction that visits cells in iteration order, or in arbitrary order
+	Index findEdgeVertex(const EdgeID& edgeID) // Returns the index of the vertex already created on the given edge, or ~Index(0)
+		{
+		if(useEdgeSlabs)
+			return vertexIndexSlabs.findVertex(SlabTraits::getEdgeIndex(edgeID));
+		typename VertexIndexHasher::Iterator vIt=vertexIndices.findEntry(edgeID);
+		return vIt.isFinished()?~Index(0):vIt->getDest();
+		}
+	void setEdgeVertex(const EdgeID& edgeID,Index vertexIndex) // Stores the index of the vertex created on the given edge
+		{
+		if(useEdgeSlabs)
+			vertexIndexSlabs.setVertex(SlabTraits::getEdgeIndex(edgeID),vertexIndex);
+		else
+			vertexIndices.setEntry(typename VertexIndexHasher::Entry(edgeID,vertexIndex));
+		}
 	int extractFlatIsosurfaceFragment(const Cell& cell); // Extracts a flat-shaded isosurface fragment from a cell and stores it in the current isosurface representation
 	int extractSmoothIsosurfaceFragment(const Cell& cell); // Extracts a gradient-shaded isosurface fragment from a cell and stores it in the current isosurface representation
+	void extractCellRanges(const CellRange* rangesBegin,const CellRange* rangesEnd); // Extracts isosurface fragments from all cells in the given runs of cells
+	void* extractSliceThreadMethod(ExtractionSlice* slice); // Extracts the given slice of active cells using the slice's private extractor and isosurface
+	void extractSlices(const std::vector<CellRange>& cellRanges,size_t numCells,unsigned int numThreads); // Extracts isosurface fragments from all cells in the given runs containing the given total number of cells on the given number of threads, and merges them into the current isosurface
 	
 	/* Constructors and destructors: */
 	public:
@@ -113,13 +164,49 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 		{
 		return extractionMode;
 		}
-	void update(const DataSet* newDataSet,const ScalarExtractor& newScalarExtractor) // Sets a new data set and scalar extractor for subsequent isosurface extraction
+	void update(const DataSet* newDataSet,const ScalarExtractor& newScalarExtractor) // Sets a new data set and scalar extractor for subsequent isosurface extraction; stops using the gradient cache
 		{
+		if(newDataSet!=dataSet)
+			activeCellsValid=false;
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
+		gradientCache=0;
+		}
+	void invalidateActiveCells(void) // Forces the next incremental extraction to visit all cells; must be called when the scalar extractor changes to a different variable
+		{
+		activeCellsValid=false;
+		}
+	size_t getNumVisitedCells(void) const // Returns the number of cells visited by the most recent extraction
+		{
+		return numVisitedCells;
+		}
+	size_t getNumRevisitedCells(void) const // Returns the number of cells visited by the most recent incremental extraction that were already active in the extraction before
+		{
+		return numRevisitedCells;
 		}
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
+	const GradientCache* getGradientCache(void) const // Returns the cache of vertex gradients used for smooth-shaded extraction, or 0
+		{
+		return gradientCache;
+		}
+	void setGradientCache(const GradientCache* newGradientCache) // Looks up vertex gradients in the given cache, which must have been created for the current data set and scalar extractor, instead of calculating them; null pointer calculates gradients on the fly
+		{
+		gradientCache=newGradientCache;
+		}
+	bool getEdgeSlabsEnabled(void) const // Returns true if global extractions from structured data sets share vertices through edge slabs
+		{
+		return edgeSlabsEnabled;
+		}
+	void setEdgeSlabsEnabled(bool newEdgeSlabsEnabled) // Enables or disables sharing vertices through edge slabs; always uses the hasher if disabled
+		{
+		edgeSlabsEnabled=newEdgeSlabsEnabled;
+		}
 	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
+	void extractIsosurface(VScalar newIsovalue,unsigned int numThreads,Isosurface& newIsosurface); // Ditto; distributes all cells across the given number of threads, and merges the partial isosurfaces such that the result is identical to a single-threaded extraction
+	void extractIsosurface(VScalar newIsovalue,const CellTree& cellTree,Isosurface& newIsosurface); // Ditto; only visits the cells found by the given interval tree, which must have been created for the current data set and scalar extractor
+	void extractIsosurface(VScalar newIsovalue,const CellTree& cellTree,unsigned int numThreads,Isosurface& newIsosurface); // Ditto; distributes the active cells across the given number of threads, and merges the partial isosurfaces such that the result is identical to a single-threaded extraction
+	void extractPreviewIsosurface(VScalar newIsovalue,unsigned int latticeSize,Isosurface& newIsosurface); // Extracts a coarse preview of a global isosurface from the data set resampled onto a regular lattice with the given number of cells along the longest side of its domain box
+	void extractIncrementalIsosurface(VScalar newIsovalue,const CellTree* cellTree,Isosurface& newIsosurface); // Ditto; only visits the cells that were active in the previous incremental extraction, and walks from them through all cells the isosurface swept over since then; if an interval tree is given, additionally visits the cells it finds for the swept isovalue interval to find isosurface components that do not touch the previous isosurface, which are missed otherwise
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
 	void startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Starts extracting a seeded isosurface for the given isovalue from the given cell
 	template <class ContinueFunctorParam>
@@ -0,0 +1,128 @@
+/***********************************************************************
+LocatorBatch - Helper functions to locate arrays of positions with a
+data set locator and evaluate value extractors at each located position.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_LOCATORBATCH_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_LOCATORBATCH_INCLUDED
+
+#include <stddef.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class LocatorParam,class PointParam,class ValueExtractorParam>
+inline
+size_t
+batchCalcValues(
+	LocatorParam& locator,
+	size_t numPoints,
+	const PointParam positions[],
+	bool traceHint,
+	const ValueExtractorParam& extractor,
+	typename ValueExtractorParam::DestValue values[],
+	bool valids[]) // Locates the given positions in order and calculates their values based on given value extractor; traces first position from last located position if traceHint is true; returns number of positions inside the data set
+	{
+	/* Locate and evaluate all positions in order, tracing each position from the previous one: */
+	size_t numValidPoints=0;
+	bool valid=traceHint;
+	for(size_t i=0;i<numPoints;++i)
+		{
+		valid=locator.locatePoint(positions[i],valid);
+		valids[i]=valid;
+		if(valid)
+			{
+			values[i]=locator.calcValue(extractor);
+			++numValidPoints;
+			}
+		}
+	
+	return numValidPoints;
+	}
+
+template <class LocatorParam,class PointParam,class ValueExtractorParam1,class ValueExtractorParam2>
+inline
+size_t
+batchCalcValues(
+	LocatorParam& locator,
+	size_t numPoints,
+	const PointParam positions[],
+	bool traceHint,
+	const ValueExtractorParam1& extractor1,
+	typename ValueExtractorParam1::DestValue values1[],
+	const ValueExtractorParam2& extractor2,
+	typename ValueExtractorParam2::DestValue values2[],
+	bool valids[]) // Ditto; calculates the values of two value extractors from a single point location per position
+	{
+	/* Locate all positions in order and evaluate both extractors at each one, tracing each position from the previous one: */
+	size_t numValidPoints=0;
+	bool valid=traceHint;
+	for(size_t i=0;i<numPoints;++i)
+		{
+		valid=locator.locatePoint(positions[i],valid);
+		valids[i]=valid;
+		if(valid)
+			{
+			values1[i]=locator.calcValue(extractor1);
+			values2[i]=locator.calcValue(extractor2);
+			++numValidPoints;
+			}
+		}
+	
+	return numValidPoints;
+	}
+
+template <class LocatorParam,class PointParam,class ScalarExtractorParam,class VectorParam>
+inline
+size_t
+batchCalcValuesAndGradients(
+	LocatorParam& locator,
+	size_t numPoints,
+	const PointParam positions[],
+	bool traceHint,
+	const ScalarExtractorParam& extractor,
+	typename ScalarExtractorParam::DestValue values[],
+	VectorParam gradients[],
+	bool valids[]) // Ditto; additionally calculates gradients based on given scalar extractor
+	{
+	/* Locate and evaluate all positions in order, tracing each position from the previous one: */
+	size_t numValidPoints=0;
+	bool valid=traceHint;
+	for(size_t i=0;i<numPoints;++i)
+		{
+		valid=locator.locatePoint(positions[i],valid);
+		valids[i]=valid;
+		if(valid)
+			{
+			values[i]=locator.calcValue(extractor);
+			gradients[i]=locator.calcGradient(extractor);
+			++numValidPoints;
+			}
+		}
+	
+	return numValidPoints;
+	}
+
+}
+
+}
+
+#endif
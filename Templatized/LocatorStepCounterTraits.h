@@ -0,0 +1,110 @@
+/***********************************************************************
+LocatorStepCounterTraits - Traits class to query the step counters of
+data set locators that keep them, and to ignore the locators of data sets
+that do not.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_LOCATORSTEPCOUNTERTRAITS_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_LOCATORSTEPCOUNTERTRAITS_INCLUDED
+
+#include <Templatized/CellBoxTree.h>
+
+#ifdef PERF_COUNTLOCATORSTEPS
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class Curvilinear;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCurvilinear;
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class MultiCurvilinear;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedMultiCurvilinear;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedHypercubic;
+}
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class LocatorStepCounterTraits // Generic traits class for data sets whose locators do not count their steps, e.g., Cartesian data sets
+	{
+	/* Elements: */
+	public:
+	static const bool hasStepCounters=false; // Flag whether the data set's locators count their steps
+	
+	/* Methods: */
+	static LocatorStepCounters getStepCounters(const typename DataSetParam::Locator&) // Returns the counts of the work done by the given locator
+		{
+		return LocatorStepCounters();
+		}
+	};
+
+template <class DataSetParam>
+class CountingLocatorStepCounterTraits // Traits class for data sets whose locators count their steps
+	{
+	/* Elements: */
+	public:
+	static const bool hasStepCounters=true;
+	
+	/* Methods: */
+	static LocatorStepCounters getStepCounters(const typename DataSetParam::Locator& locator)
+		{
+		return locator.getStepCounters();
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class LocatorStepCounterTraits<Curvilinear<ScalarParam,dimensionParam,ValueParam> >:public CountingLocatorStepCounterTraits<Curvilinear<ScalarParam,dimensionParam,ValueParam> >
+	{
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class LocatorStepCounterTraits<SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >:public CountingLocatorStepCounterTraits<SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class LocatorStepCounterTraits<MultiCurvilinear<ScalarParam,dimensionParam,ValueParam> >:public CountingLocatorStepCounterTraits<MultiCurvilinear<ScalarParam,dimensionParam,ValueParam> >
+	{
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class LocatorStepCounterTraits<SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >:public CountingLocatorStepCounterTraits<SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class LocatorStepCounterTraits<SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam> >:public CountingLocatorStepCounterTraits<SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	};
+
+}
+
+}
+
+#endif
+
+#endif
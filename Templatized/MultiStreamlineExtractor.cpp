@@ -92,7 +92,8 @@ template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorPar
 inline
 bool
 MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::stepStreamline(
-	unsigned int index)
+	unsigned int index,
+	typename MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::Vertex& vertex)
 	{
 	/* Define constants for the adaptive step: */
 	static const Scalar safety=0.9;
@@ -108,12 +109,10 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 	Vector vfp1=Vector(ss.locator.calcValue(vectorExtractor));
 	VScalar scalar=ss.locator.calcValue(scalarExtractor);
 	
-	/* Store the current vertex in the streamline: */
-	Vertex* vPtr=multiStreamline->getNextVertex(index);
-	vPtr->texCoord[0]=scalar;
-	vPtr->normal=typename Vertex::Normal(vfp1.getComponents());
-	vPtr->position=typename Vertex::Position(ss.p1.getComponents());
-	multiStreamline->addVertex(index);
+	/* Store the current vertex: */
+	vertex.texCoord[0]=scalar;
+	vertex.normal=typename Vertex::Normal(vfp1.getComponents());
+	vertex.position=typename Vertex::Position(ss.p1.getComponents());
 	
 	/*********************************************************************
 	Integrate the streamline using an embedded adaptive-step size fourth-
@@ -156,12 +155,14 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 			
 			/* Go to the next streamline vertex: */
 			ss.p1+=step;
+			++ss.numSteps;
 			
 			/* Done with the step: */
 			return true;
 			}
 		
 		/* Adapt the trial step size for the next trial step: */
+		++ss.numRejectedSteps;
 		Scalar tempStepSize=safety*trialStepSize*Math::pow(errorMax,shrinkExp);
 		trialStepSize*=Scalar(0.1); // Don't reduce by more than a factor of 10
 		if(trialStepSize<tempStepSize)
@@ -169,6 +170,153 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 		}
 	}
 
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
+inline
+void
+MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::integrateRoundStreamlines(
+	void)
+	{
+	while(true)
+		{
+		/* Grab the next streamline: */
+		unsigned int index;
+		{
+		Threads::Mutex::Lock integrationLock(integrationMutex);
+		if(nextStreamlineIndex==numStreamlines)
+			break;
+		index=nextStreamlineIndex;
+		++nextStreamlineIndex;
+		}
+		
+		/* Advance the streamline into its private vertex buffer: */
+		StreamlineState& ss=streamlineStates[index];
+		std::vector<Vertex>& vertices=roundVertices[index];
+		for(unsigned int step=0;step<roundNumSteps&&ss.valid;++step)
+			{
+			Vertex vertex;
+			ss.valid=stepStreamline(index,vertex);
+			if(ss.valid)
+				vertices.push_back(vertex);
+			}
+		}
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
+inline
+void*
+MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::integrationThreadMethod(
+	void)
+	{
+	unsigned int lastRoundIndex=0;
+	while(true)
+		{
+		/* Wait for the next round: */
+		{
+		Threads::Mutex::Lock integrationLock(integrationMutex);
+		while(!shutdownThreads&&roundIndex==lastRoundIndex)
+			roundStartCond.wait(integrationMutex);
+		if(shutdownThreads)
+			break;
+		lastRoundIndex=roundIndex;
+		}
+		
+		/* Advance streamlines until the round is finished: */
+		integrateRoundStreamlines();
+		
+		/* Notify the calling thread if this was the last busy worker: */
+		{
+		Threads::Mutex::Lock integrationLock(integrationMutex);
+		--numBusyWorkers;
+		if(numBusyWorkers==0)
+			roundFinishedCond.signal();
+		}
+		}
+	
+	return 0;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
+inline
+void
+MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::startThreads(
+	void)
+	{
+	if(numThreads>1&&integrationThreads==0)
+		{
+		/* Start the worker threads: */
+		shutdownThreads=false;
+		roundIndex=0;
+		integrationThreads=new Threads::Thread[numThreads-1];
+		for(unsigned int i=1;i<numThreads;++i)
+			integrationThreads[i-1].start(this,&MultiStreamlineExtractor::integrationThreadMethod);
+		}
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
+inline
+void
+MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::stopThreads(
+	void)
+	{
+	if(integrationThreads!=0)
+		{
+		/* Tell the worker threads to shut down: */
+		{
+		Threads::Mutex::Lock integrationLock(integrationMutex);
+		shutdownThreads=true;
+		roundStartCond.broadcast();
+		}
+		
+		/* Wait for all worker threads to terminate: */
+		for(unsigned int i=1;i<numThreads;++i)
+			integrationThreads[i-1].join();
+		delete[] integrationThreads;
+		integrationThreads=0;
+		}
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
+inline
+bool
+MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::integrateRound(
+	void)
+	{
+	/* Start the round on the worker threads: */
+	{
+	Threads::Mutex::Lock integrationLock(integrationMutex);
+	nextStreamlineIndex=0;
+	numBusyWorkers=numThreads-1;
+	++roundIndex;
+	roundStartCond.broadcast();
+	}
+	
+	/* Advance streamlines on the calling thread until all are handed out: */
+	integrateRoundStreamlines();
+	
+	/* Wait for the worker threads to finish the round: */
+	{
+	Threads::Mutex::Lock integrationLock(integrationMutex);
+	while(numBusyWorkers>0)
+		roundFinishedCond.wait(integrationMutex);
+	}
+	
+	/* Append the round's vertices to the multi-streamline in streamline order, independent of the number of threads: */
+	bool anyValid=false;
+	for(unsigned int i=0;i<numStreamlines;++i)
+		{
+		std::vector<Vertex>& vertices=roundVertices[i];
+		for(typename std::vector<Vertex>::const_iterator vIt=vertices.begin();vIt!=vertices.end();++vIt)
+			{
+			*multiStreamline->getNextVertex(i)=*vIt;
+			multiStreamline->addVertex(i);
+			}
+		vertices.clear();
+		anyValid=anyValid||streamlineStates[i].valid;
+		}
+	
+	return anyValid;
+	}
+
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
 inline
 MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::MultiStreamlineExtractor(
@@ -180,7 +328,12 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 	 epsilon(1.0e-8),
 	 numStreamlines(0),
 	 streamlineStates(0),
-	 multiStreamline(0)
+	 multiStreamline(0),
+	 numThreads(1),roundNumSteps(16),
+	 roundVertices(0),
+	 integrationThreads(0),
+	 roundIndex(0),nextStreamlineIndex(0),numBusyWorkers(0),
+	 shutdownThreads(false)
 	{
 	}
 
@@ -189,7 +342,9 @@ inline
 MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::~MultiStreamlineExtractor(
 	void)
 	{
+	stopThreads();
 	delete[] streamlineStates;
+	delete[] roundVertices;
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
@@ -201,6 +356,20 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 	epsilon=newEpsilon;
 	}
 
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
+inline
+void
+MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,MultiStreamlineParam>::setNumThreads(
+	unsigned int newNumThreads)
+	{
+	if(numThreads!=newNumThreads)
+		{
+		/* Shut down the worker threads; they are restarted on the next extraction: */
+		stopThreads();
+		numThreads=newNumThreads>0?newNumThreads:1;
+		}
+	}
+
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
 inline
 void
@@ -209,12 +378,14 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 	{
 	if(numStreamlines!=newNumStreamlines)
 		{
-		/* Delete the old state array: */
+		/* Delete the old state array and vertex buffers: */
 		delete[] streamlineStates;
+		delete[] roundVertices;
 		
-		/* Initialize the state array: */
+		/* Initialize the state array and vertex buffers: */
 		numStreamlines=newNumStreamlines;
 		streamlineStates=numStreamlines!=0?new StreamlineState[numStreamlines]:0;
+		roundVertices=numStreamlines!=0?new std::vector<Vertex>[numStreamlines]:0;
 		}
 	}
 
@@ -244,6 +415,8 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 	streamlineStates[index].p1=startPoint;
 	streamlineStates[index].locator=startLocator;
 	streamlineStates[index].stepSize=startStepSize;
+	streamlineStates[index].numSteps=0;
+	streamlineStates[index].numRejectedSteps=0;
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
@@ -256,18 +429,31 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 		streamlineStates[i].valid=true;
 	
 	/* Integrate the streamlines until all leave the data set's domain: */
-	bool anyValid;
-	do
+	if(numThreads>1)
 		{
-		anyValid=false;
-		for(unsigned int i=0;i<numStreamlines;++i)
-			if(streamlineStates[i].valid)
-				{
-				streamlineStates[i].valid=stepStreamline(i);
-				anyValid=anyValid||streamlineStates[i].valid;
-				}
+		startThreads();
+		while(integrateRound())
+			;
+		stopThreads();
+		}
+	else
+		{
+		bool anyValid;
+		do
+			{
+			anyValid=false;
+			for(unsigned int i=0;i<numStreamlines;++i)
+				if(streamlineStates[i].valid)
+					{
+					Vertex* vPtr=multiStreamline->getNextVertex(i);
+					streamlineStates[i].valid=stepStreamline(i,*vPtr);
+					if(streamlineStates[i].valid)
+						multiStreamline->addVertex(i);
+					anyValid=anyValid||streamlineStates[i].valid;
+					}
+			}
+		while(anyValid);
 		}
-	while(anyValid);
 	multiStreamline->flush();
 	
 	/* Clean up: */
@@ -282,6 +468,9 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 	{
 	for(unsigned int i=0;i<numStreamlines;++i)
 		streamlineStates[i].valid=true;
+	
+	/* Start the worker threads for multi-threaded extraction: */
+	startThreads();
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class MultiStreamlineParam>
@@ -293,17 +482,33 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 	{
 	/* Integrate the streamlines until all leave the domain or the functor interrupts: */
 	bool anyValid;
-	do
+	if(numThreads>1)
 		{
-		anyValid=false;
-		for(unsigned int i=0;i<numStreamlines;++i)
-			if(streamlineStates[i].valid)
-				{
-				anyValid=true;
-				streamlineStates[i].valid=stepStreamline(i);
-				}
+		/* Integrate in rounds of several steps per streamline, checking the functor between rounds: */
+		startThreads();
+		do
+			{
+			anyValid=integrateRound();
+			}
+		while(anyValid&&cf());
+		}
+	else
+		{
+		do
+			{
+			anyValid=false;
+			for(unsigned int i=0;i<numStreamlines;++i)
+				if(streamlineStates[i].valid)
+					{
+					anyValid=true;
+					Vertex* vPtr=multiStreamline->getNextVertex(i);
+					streamlineStates[i].valid=stepStreamline(i,*vPtr);
+					if(streamlineStates[i].valid)
+						multiStreamline->addVertex(i);
+					}
+			}
+		while(anyValid&&cf());
 		}
-	while(anyValid&&cf());
 	multiStreamline->flush();
 	
 	return !anyValid;
@@ -316,6 +521,7 @@ MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,
 	void)
 	{
 	/* Clean up: */
+	stopThreads();
 	multiStreamline=0;
 	}
 
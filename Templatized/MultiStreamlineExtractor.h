@@ -23,6 +23,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_MULTISTREAMLINEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_MULTISTREAMLINEEXTRACTOR_INCLUDED
 
+#include <vector>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
+
 namespace Visualization {
 
 namespace Templatized {
@@ -52,6 +57,8 @@ class MultiStreamlineExtractor
 		Locator locator; // Locator following the current streamline position
 		bool valid; // Flag if the streamline locator is valid
 		Scalar stepSize; // Step size for the current streamline integration step
+		unsigned int numSteps; // Number of accepted integration steps since the streamline was initialized
+		unsigned int numRejectedSteps; // Number of trial steps that were rejected due to exceeding the accuracy threshold
 		};
 	
 	private:
@@ -69,9 +76,27 @@ class MultiStreamlineExtractor
 	StreamlineState* streamlineStates; // Array of streamline states
 	MultiStreamline* multiStreamline; // Pointer to the multi-streamline representations
 	
+	/* Parallel integration state: */
+	unsigned int numThreads; // Number of threads integrating streamlines concurrently, including the calling thread
+	unsigned int roundNumSteps; // Maximum number of steps each streamline is advanced by in one parallel integration round
+	std::vector<Vertex>* roundVertices; // Array of per-streamline buffers of vertices created during the current parallel integration round
+	Threads::Thread* integrationThreads; // Array of worker threads integrating streamlines alongside the calling thread, or 0 if not started
+	Threads::Mutex integrationMutex; // Mutex protecting the parallel integration state
+	Threads::Cond roundStartCond; // Condition variable to wake up worker threads at the start of a round or on shutdown
+	Threads::Cond roundFinishedCond; // Condition variable signalled when the last worker thread finishes a round
+	unsigned int roundIndex; // Index of the current parallel integration round
+	unsigned int nextStreamlineIndex; // Index of the next streamline to be advanced by any thread in the current round
+	unsigned int numBusyWorkers; // Number of worker threads that have not yet finished the current round
+	bool shutdownThreads; // Flag to tell the worker threads to shut down
+	
 	/* Private methods: */
 	Vector cashKarpStep(unsigned int index,const Vector& vfp1,Scalar trialStepSize,Vector& error); // Computes a trial step vector with Cash-Karp coefficients
-	bool stepStreamline(unsigned int index); // Advances one current streamline position by one step
+	bool stepStreamline(unsigned int index,Vertex& vertex); // Stores one current streamline position in the given vertex and advances it by one step; returns false if the position is outside the data set
+	void integrateRoundStreamlines(void); // Advances streamlines of the current round until all streamlines have been handed out to a thread
+	void* integrationThreadMethod(void); // Advances streamlines in every parallel integration round until shut down
+	void startThreads(void); // Starts the worker threads if more than one thread is requested
+	void stopThreads(void); // Shuts down the worker threads
+	bool integrateRound(void); // Advances all valid streamlines by up to a round's number of steps on all threads and appends the new vertices to the multi-streamline in streamline order; returns true if any streamline is still valid
 	
 	/* Constructors and destructors: */
 	public:
@@ -111,6 +136,22 @@ class MultiStreamlineExtractor
 		{
 		return numStreamlines;
 		}
+	unsigned int getNumThreads(void) const // Returns the number of threads integrating streamlines
+		{
+		return numThreads;
+		}
+	unsigned int getNumSteps(unsigned int index) const // Returns the number of accepted integration steps of the given streamline in the last extraction
+		{
+		return streamlineStates[index].numSteps;
+		}
+	unsigned int getNumRejectedSteps(unsigned int index) const // Returns the number of rejected trial steps of the given streamline in the last extraction
+		{
+		return streamlineStates[index].numRejectedSteps;
+		}
+	const Locator& getLocator(unsigned int index) const // Returns the locator following the given streamline
+		{
+		return streamlineStates[index].locator;
+		}
 	void update(const DataSet* newDataSet,const VectorExtractor& newVectorExtractor,const ScalarExtractor& newScalarExtractor) // Sets a new data set and scalar / vector extractors for subsequent multi-streamline extraction
 		{
 		dataSet=newDataSet;
@@ -118,6 +159,7 @@ class MultiStreamlineExtractor
 		scalarExtractor=newScalarExtractor;
 		}
 	void setEpsilon(Scalar newEpsilon); // Sets the integration accuracy threshold
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads integrating streamlines; multi-threaded extraction advances streamlines in rounds of several steps
 	void setNumStreamlines(unsigned int newNumStreamlines); // Sets number of streamlines without setting the multi-streamline itself
 	void setMultiStreamline(MultiStreamline& newMultiStreamline); // Sets the multi-streamline object
 	void initializeStreamline(unsigned int index,const Point& startPoint,const Locator& startLocator,Scalar startEpsilon); // Initializes one streamline
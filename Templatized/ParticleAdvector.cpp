@@ -21,6 +21,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_TEMPLATIZED_PARTICLEADVECTOR_IMPLEMENTATION
 
+#include <Misc/ThrowStdErr.h>
+
 #include <Templatized/ParticleAdvector.h>
 
 namespace Visualization {
@@ -31,6 +33,243 @@ namespace Templatized {
 Methods of class ParticleAdvector:
 *********************************/
 
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+typename ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::Scalar
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::calcRandom(
+	size_t index)
+	{
+	/* Advance the particle's xorshift generator: */
+	unsigned int& state=randomStates[index];
+	state^=state<<13;
+	state^=state>>17;
+	state^=state<<5;
+	
+	/* Use the upper 24 bits to get a number that is exactly representable in any scalar type: */
+	return Scalar(double(state>>8)/16777216.0);
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+void
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::seedParticle(
+	size_t index,
+	typename ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::Scalar age)
+	{
+	/* Try random positions inside the seed sphere until one is inside the data set: */
+	Point& position=positions[index];
+	Locator& locator=locators[index];
+	bool inside=false;
+	for(unsigned int trial=0;trial<maxNumSeedTrials&&!inside;++trial)
+		{
+		/* Pick a uniformly distributed point inside the unit sphere: */
+		Vector offset;
+		do
+			{
+			for(int i=0;i<dimension;++i)
+				offset[i]=calcRandom(index)*Scalar(2)-Scalar(1);
+			}
+		while(offset.sqr()>Scalar(1));
+		
+		/* Trace the seed locator to the new position: */
+		position=seedCenter;
+		position+=offset*seedRadius;
+		locator=seedLocator;
+		inside=locator.locatePoint(position,true);
+		}
+	
+	if(!inside)
+		{
+		/* Fall back to the seed sphere's center, which is always inside the data set: */
+		position=seedCenter;
+		locator=seedLocator;
+		}
+	
+	/* Initialize the particle's state: */
+	values[index]=locator.calcValue(scalarExtractor);
+	ages[index]=age;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+bool
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::stepParticle(
+	size_t index)
+	{
+	Point& position=positions[index];
+	Locator& locator=locators[index];
+	
+	/* Calculate first half-step vector: */
+	Vector v0=Vector(locator.calcValue(vectorExtractor));
+	v0*=stepSize*Scalar(0.5);
+	
+	/* Move to second evaluation point: */
+	Point p1=position;
+	p1+=v0;
+	if(!locator.locatePoint(p1,true))
+		return false;
+	
+	/* Calculate second half-step vector: */
+	Vector v1=Vector(locator.calcValue(vectorExtractor));
+	v1*=stepSize*Scalar(0.5);
+	
+	/* Move to third evaluation point: */
+	Point p2=position;
+	p2+=v1;
+	if(!locator.locatePoint(p2,true))
+		return false;
+	
+	/* Calculate full-step vector: */
+	Vector v2=Vector(locator.calcValue(vectorExtractor));
+	v2*=stepSize;
+	
+	/* Move to fourth evaluation point: */
+	Point p3=position;
+	p3+=v2;
+	if(!locator.locatePoint(p3,true))
+		return false;
+	
+	/* Calculate second full-step vector: */
+	Vector v3=Vector(locator.calcValue(vectorExtractor));
+	v3*=stepSize;
+	
+	/* Calculate final step vector: */
+	v1*=Scalar(2);
+	v2+=v1;
+	v2+=v0;
+	v2*=Scalar(2);
+	v3+=v2;
+	v3/=Scalar(6);
+	
+	/* Move the particle to the final position: */
+	position+=v3;
+	if(!locator.locatePoint(position,true))
+		return false;
+	
+	/* Update the particle's scalar value and age: */
+	values[index]=locator.calcValue(scalarExtractor);
+	ages[index]+=stepSize;
+	
+	return true;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+void
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::advectRoundBlocks(
+	void)
+	{
+	size_t blockNumParticleSteps=0;
+	size_t blockNumReseeds=0;
+	while(true)
+		{
+		/* Update the counters and grab the next block of particles: */
+		size_t begin,end;
+		{
+		Threads::Mutex::Lock advectionLock(advectionMutex);
+		numParticleSteps+=blockNumParticleSteps;
+		numReseeds+=blockNumReseeds;
+		if(nextBlockIndex==numParticles)
+			break;
+		begin=nextBlockIndex;
+		end=numParticles-begin>blockSize?begin+blockSize:numParticles;
+		nextBlockIndex=end;
+		}
+		
+		/* Advect all particles in the block: */
+		blockNumParticleSteps=0;
+		blockNumReseeds=0;
+		for(size_t index=begin;index<end;++index)
+			for(unsigned int step=0;step<roundNumSteps;++step)
+				{
+				bool valid=stepParticle(index);
+				if(valid)
+					++blockNumParticleSteps;
+				
+				/* Re-seed the particle if it left the data set or died of old age: */
+				if(!valid||ages[index]>=lifeTime)
+					{
+					seedParticle(index,Scalar(0));
+					++blockNumReseeds;
+					}
+				}
+		}
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+void*
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::advectionThreadMethod(
+	void)
+	{
+	unsigned int lastRoundIndex=0;
+	while(true)
+		{
+		/* Wait for the next round: */
+		{
+		Threads::Mutex::Lock advectionLock(advectionMutex);
+		while(!shutdownThreads&&roundIndex==lastRoundIndex)
+			roundStartCond.wait(advectionMutex);
+		if(shutdownThreads)
+			break;
+		lastRoundIndex=roundIndex;
+		}
+		
+		/* Advect blocks of particles until the round is finished: */
+		advectRoundBlocks();
+		
+		/* Notify the calling thread if this was the last busy worker: */
+		{
+		Threads::Mutex::Lock advectionLock(advectionMutex);
+		--numBusyWorkers;
+		if(numBusyWorkers==0)
+			roundFinishedCond.signal();
+		}
+		}
+	
+	return 0;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+void
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::startThreads(
+	void)
+	{
+	if(numThreads>1&&advectionThreads==0)
+		{
+		/* Start the worker threads: */
+		shutdownThreads=false;
+		roundIndex=0;
+		advectionThreads=new Threads::Thread[numThreads-1];
+		for(unsigned int i=1;i<numThreads;++i)
+			advectionThreads[i-1].start(this,&ParticleAdvector::advectionThreadMethod);
+		}
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+void
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::stopThreads(
+	void)
+	{
+	if(advectionThreads!=0)
+		{
+		/* Tell the worker threads to shut down: */
+		{
+		Threads::Mutex::Lock advectionLock(advectionMutex);
+		shutdownThreads=true;
+		roundStartCond.broadcast();
+		}
+		
+		/* Wait for all worker threads to terminate: */
+		for(unsigned int i=1;i<numThreads;++i)
+			advectionThreads[i-1].join();
+		delete[] advectionThreads;
+		advectionThreads=0;
+		}
+	}
+
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
 inline
 ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::ParticleAdvector(
@@ -39,7 +278,16 @@ ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::Partic
 	const typename ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::ScalarExtractor& sScalarExtractor)
 	:dataSet(sDataSet),
 	 vectorExtractor(sVectorExtractor),scalarExtractor(sScalarExtractor),
-	 stepSize(1.0e-4),lifeTime(1.0)
+	 stepSize(1.0e-4),lifeTime(1.0),
+	 seedRadius(0),seedValid(false),
+	 numParticles(0),
+	 numParticleSteps(0),numReseeds(0),
+	 numThreads(1),
+	 advectionThreads(0),
+	 roundIndex(0),roundNumSteps(0),
+	 nextBlockIndex(0),
+	 numBusyWorkers(0),
+	 shutdownThreads(false)
 	{
 	}
 
@@ -48,6 +296,8 @@ inline
 ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::~ParticleAdvector(
 	void)
 	{
+	/* Shut down the worker threads: */
+	stopThreads();
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
@@ -71,105 +321,108 @@ ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::setLif
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
 inline
 void
-ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::addParticle(
-	const typename ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::Point& newPosition,
-	const typename ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::Locator& newLocator)
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::setNumThreads(
+	unsigned int newNumThreads)
+	{
+	/* Shut down the current worker threads; new ones are started on demand: */
+	stopThreads();
+	numThreads=newNumThreads>0?newNumThreads:1;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+bool
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::setSeed(
+	const typename ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::Point& newSeedCenter,
+	typename ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::Scalar newSeedRadius,
+	const typename ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::Locator& newSeedLocator)
 	{
-	/* Create a new particle: */
-	Particle newP;
-	newP.position=newPosition;
-	newP.locator=newLocator;
+	/* Store the seed sphere and locate its center: */
+	seedCenter=newSeedCenter;
+	seedRadius=newSeedRadius;
+	seedLocator=newSeedLocator;
+	seedValid=seedLocator.locatePoint(seedCenter,true);
 	
-	/* Locate the particle and check whether it is inside the domain: */
-	if(newP.locator.locate(newP.position,true))
+	return seedValid;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+void
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::setNumParticles(
+	size_t newNumParticles,
+	unsigned int randomSeed)
+	{
+	if(newNumParticles>0&&!seedValid)
+		Misc::throwStdErr("ParticleAdvector::setNumParticles: Seed sphere center is outside the data set");
+	
+	/* Re-allocate the particle arrays: */
+	numParticles=newNumParticles;
+	positions.resize(numParticles);
+	locators.resize(numParticles);
+	values.resize(numParticles);
+	ages.resize(numParticles);
+	randomStates.resize(numParticles);
+	
+	/* Seed all particles with staggered ages, so they do not all die at the same time: */
+	for(size_t index=0;index<numParticles;++index)
 		{
-		/* Get the particle's initial scalar value: */
-		newP.value=newP.locator.calcValue(scalarExtractor);
-		
-		/* Set the particle's life time: */
-		newP.lifeTime=lifeTime;
-		
-		/* Store the new particle: */
-		particles.push_back(newP);
+		randomStates[index]=(unsigned int)(index+1)*2654435761U^randomSeed;
+		if(randomStates[index]==0)
+			randomStates[index]=1;
+		seedParticle(index,calcRandom(index)*lifeTime);
 		}
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
 inline
 void
-ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::advectParticles(
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::resetCounters(
 	void)
 	{
-	for(size_t i=0;i<particles.size();++i)
+	Threads::Mutex::Lock advectionLock(advectionMutex);
+	numParticleSteps=0;
+	numReseeds=0;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam>
+inline
+void
+ParticleAdvector<DataSetParam,VectorExtractorParam,ScalarExtractorParam>::advect(
+	unsigned int numSteps)
+	{
+	if(numParticles==0)
+		return;
+	
+	if(numThreads>1)
 		{
-		/* Advect the particle and check whether it is still inside the domain: */
-		Particle& p=particles[i];
-		bool valid=stepSize>p.lifeTime;
-		if(valid)
-			{
-			/* Calculate first half-step vector: */
-			Vector v0=Vector(p.locator.calcValue(vectorExtractor));
-			v0*=stepSize*Scalar(0.5);
-			
-			/* Move to second evaluation point: */
-			Point p1=p.position;
-			p1+=v0;
-			valid=p.locator.locatePoint(p1,true);
-			if(valid)
-				{
-				/* Calculate second half-step vector: */
-				Vector v1=Vector(p.locator.calcValue(vectorExtractor));
-				v1*=stepSize*Scalar(0.5);
-				
-				/* Move to third evaluation point: */
-				Point p2=p.position;
-				p2+=v1;
-				valid=p.locator.locatePoint(p2,true);
-				if(valid)
-					{
-					Vector v2=Vector(p.locator.calcValue(vectorExtractor));
-					v2*=stepSize;
-					
-					/* Move to fourth evaluation point: */
-					Point p3=p.position;
-					p3+=v2;
-					valid=p.locator.locatePoint(p3,true);
-					if(valid)
-						{
-						Vector v3=Vector(p.locator.calcValue(vectorExtractor));
-						v3*=stepSize;
-						
-						/* Calculate final step vector: */
-						v1*=Scalar(2);
-						v2+=v1;
-						v2+=v0;
-						v2*=Scalar(2);
-						v3+=v2;
-						v3/=Scalar(6);
-						
-						/* Move the particle to the final position: */
-						p.position+=v3;
-						valid=p.locator.locatePoint(p.position,true);
-						if(valid)
-							{
-							/* Calculate the particle's new scalar value: */
-							p.value=p.locator.calcValue(scalarExtractor);
-							
-							/* Update the particles' life time: */
-							p.lifeTime-=stepSize;
-							}
-						}
-					}
-				}
-			}
+		/* Start the round on the worker threads: */
+		startThreads();
+		{
+		Threads::Mutex::Lock advectionLock(advectionMutex);
+		roundNumSteps=numSteps;
+		nextBlockIndex=0;
+		numBusyWorkers=numThreads-1;
+		++roundIndex;
+		roundStartCond.broadcast();
+		}
 		
-		if(!valid)
-			{
-			/* Remove the particle from the list: */
-			particles[i]=particles[particles.size()-1];
-			particles.pop_back();
-			--i;
-			}
+		/* Advect blocks of particles on the calling thread until all are handed out: */
+		advectRoundBlocks();
+		
+		/* Wait for the worker threads to finish the round: */
+		{
+		Threads::Mutex::Lock advectionLock(advectionMutex);
+		while(numBusyWorkers>0)
+			roundFinishedCond.wait(advectionMutex);
+		}
+		}
+	else
+		{
+		/* Advect all particles on the calling thread: */
+		roundNumSteps=numSteps;
+		nextBlockIndex=0;
+		advectRoundBlocks();
 		}
 	}
 
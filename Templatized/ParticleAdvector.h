@@ -22,9 +22,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_PARTICLEADVECTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_PARTICLEADVECTOR_INCLUDED
 
+#include <stddef.h>
 #include <vector>
-#include <GL/gl.h>
-#include <GL/GLVertex.h>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
 
 namespace Visualization {
 
@@ -35,40 +37,63 @@ class ParticleAdvector
 	{
 	/* Embedded classes: */
 	public:
-	typedef DataSetParam DataSet; // Type of the data set the streamline extractor works on
+	typedef DataSetParam DataSet; // Type of the data set the particle advector works on
 	typedef typename DataSet::Scalar Scalar; // Scalar type of the data set's domain
 	static const int dimension=DataSet::dimension; // Dimension of the data set's domain
 	typedef typename DataSet::Point Point; // Type for points in the data set's domain
 	typedef typename DataSet::Vector Vector; // Type for vectors in the data set's domain
 	typedef typename DataSet::Locator Locator; // Type of data set locators
-	typedef VectorExtractorParam VectorExtractor; // Type to extract vector values from a data set (to trace the streamline)
+	typedef VectorExtractorParam VectorExtractor; // Type to extract vector values from a data set (to advect the particles)
 	typedef typename VectorExtractor::Vector VVector; // Value type of vector extractor
-	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set (to color the streamline)
+	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set (to color the particles)
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	
-	private:
-	struct Particle // Structure to represent advected particles
-		{
-		/* Elements: */
-		public:
-		Point position; // Particle position
-		Locator locator; // Locator to evaluate the data set at the particle's position
-		VScalar value; // Scalar value at particle position
-		Scalar lifeTime; // Remaining life time of the particle
-		};
-	
-	typedef GLVertex<GLfloat,1,void,0,void,GLfloat,3> Vertex; // Data type for graphical representation of particles
-	
 	/* Elements: */
 	private:
-	const DataSet* dataSet; // Data set the streamline extractor works on
+	static const size_t blockSize=256; // Number of consecutive particles handed to an advection thread at a time
+	static const unsigned int maxNumSeedTrials=16; // Maximum number of random positions tried when seeding a particle
+	const DataSet* dataSet; // Data set the particle advector works on
 	VectorExtractor vectorExtractor; // Vector extractor working on data set
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	Scalar stepSize; // The fixed particle advection step size
 	Scalar lifeTime; // The life time for new particles
 	
-	/* Particle advection state: */
-	std::vector<Particle> particles; // Vector of currently advected particles
+	/* Particle seeding state: */
+	Point seedCenter; // Center of the sphere in which particles are seeded
+	Scalar seedRadius; // Radius of the sphere in which particles are seeded
+	Locator seedLocator; // Locator at the seed sphere's center; copied to warm-start the locators of new particles
+	bool seedValid; // Flag if the seed sphere's center is inside the data set
+	
+	/* Particle state, stored as one array per particle attribute: */
+	size_t numParticles; // Number of advected particles
+	std::vector<Point> positions; // Array of particle positions
+	std::vector<Locator> locators; // Array of locators following the particle positions
+	std::vector<VScalar> values; // Array of scalar values at the particle positions
+	std::vector<Scalar> ages; // Array of particle ages
+	std::vector<unsigned int> randomStates; // Array of per-particle random number generator states to seed particles independently of the order in which they are advected
+	size_t numParticleSteps; // Number of particle advection steps since the counters were reset
+	size_t numReseeds; // Number of particles re-seeded since the counters were reset
+	
+	/* Parallel advection state: */
+	unsigned int numThreads; // Number of threads advecting particles concurrently, including the calling thread
+	Threads::Thread* advectionThreads; // Array of worker threads advecting particles alongside the calling thread, or 0 if not started
+	Threads::Mutex advectionMutex; // Mutex protecting the parallel advection state and the counters
+	Threads::Cond roundStartCond; // Condition variable to wake up worker threads at the start of a round or on shutdown
+	Threads::Cond roundFinishedCond; // Condition variable signalled when the last worker thread finishes a round
+	unsigned int roundIndex; // Index of the current advection round
+	unsigned int roundNumSteps; // Number of steps each particle is advanced by in the current advection round
+	size_t nextBlockIndex; // Index of the first particle of the next block to be advected by any thread in the current round
+	unsigned int numBusyWorkers; // Number of worker threads that have not yet finished the current round
+	bool shutdownThreads; // Flag to tell the worker threads to shut down
+	
+	/* Private methods: */
+	Scalar calcRandom(size_t index); // Returns a uniformly distributed random number in [0, 1) from the given particle's random number generator
+	void seedParticle(size_t index,Scalar age); // Places the given particle at a random position inside the seed sphere and sets its age
+	bool stepParticle(size_t index); // Advances the given particle by one fourth-order Runge-Kutta step; returns false if the particle left the data set
+	void advectRoundBlocks(void); // Advects blocks of particles in the current round until all blocks have been handed out to a thread
+	void* advectionThreadMethod(void); // Advects blocks of particles in every advection round until shut down
+	void startThreads(void); // Starts the worker threads if more than one thread is requested
+	void stopThreads(void); // Shuts down the worker threads
 	
 	/* Constructors and destructors: */
 	public:
@@ -108,10 +133,41 @@ class ParticleAdvector
 		{
 		return lifeTime;
 		}
+	unsigned int getNumThreads(void) const // Returns the number of threads advecting particles
+		{
+		return numThreads;
+		}
+	size_t getNumParticles(void) const // Returns the number of advected particles
+		{
+		return numParticles;
+		}
+	const Point& getPosition(size_t index) const // Returns the position of the given particle
+		{
+		return positions[index];
+		}
+	VScalar getValue(size_t index) const // Returns the scalar value at the position of the given particle
+		{
+		return values[index];
+		}
+	Scalar getAge(size_t index) const // Returns the age of the given particle
+		{
+		return ages[index];
+		}
+	size_t getNumParticleSteps(void) const // Returns the number of particle advection steps since the counters were reset
+		{
+		return numParticleSteps;
+		}
+	size_t getNumReseeds(void) const // Returns the number of re-seeded particles since the counters were reset
+		{
+		return numReseeds;
+		}
 	void setStepSize(Scalar newStepSize); // Sets the advection step size
 	void setLifeTime(Scalar newLifeTime); // Sets the life time for new particles
-	void addParticle(const Point& newPosition,const Locator& newLocator); // Adds a new particle to the advector
-	void advect(void); // Advects all current particles
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads advecting particles
+	bool setSeed(const Point& newSeedCenter,Scalar newSeedRadius,const Locator& newSeedLocator); // Sets the sphere in which particles are seeded; returns false if the sphere's center is outside the data set
+	void setNumParticles(size_t newNumParticles,unsigned int randomSeed =0); // Sets the number of particles and seeds all of them with staggered ages; seed sphere must be valid
+	void resetCounters(void); // Resets the step and re-seed counters
+	void advect(unsigned int numSteps =1); // Advances all particles by the given number of steps, re-seeding particles that leave the data set or exceed their life time
 	};
 
 }
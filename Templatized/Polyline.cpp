@@ -30,6 +30,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/GLExtensionManager.h>
 #include <GL/Extensions/GLARBVertexBufferObject.h>
 
+#include <Templatized/ElementChecksum.h>
 #include <Templatized/Polyline.h>
 
 namespace Visualization {
@@ -244,6 +245,29 @@ Polyline<VertexParam>::flush(
 		}
 	}
 
+template <class VertexParam>
+inline
+unsigned int
+Polyline<VertexParam>::calcChecksum(
+	void) const
+	{
+	ElementChecksum checksum;
+	checksum.add(numVertices);
+	
+	/* Add all vertices: */
+	size_t verticesLeft=numVertices;
+	for(const Chunk* chPtr=head;verticesLeft>0;chPtr=chPtr->succ)
+		{
+		size_t numChunkVertices=verticesLeft;
+		if(numChunkVertices>chunkSize)
+			numChunkVertices=chunkSize;
+		checksum.add(chPtr->vertices,numChunkVertices*sizeof(Vertex));
+		verticesLeft-=numChunkVertices;
+		}
+	
+	return checksum.getChecksum();
+	}
+
 template <class VertexParam>
 inline
 void
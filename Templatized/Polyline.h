@@ -119,6 +119,7 @@ class Polyline:public GLObject
 		{
 		return numVertices;
 		}
+	unsigned int calcChecksum(void) const; // Returns a checksum over all vertices in the buffer
 	void glRenderAction(GLContextData& contextData) const; // Renders the polyline
 	};
 
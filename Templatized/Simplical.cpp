@@ -24,10 +24,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_TEMPLATIZED_SIMPLICAL_IMPLEMENTATION
 
 #include <new>
-#include <Misc/OneTimeQueue.h>
+#include <stdexcept>
 #include <Math/Math.h>
 #include <Geometry/AffineCombiner.h>
 #include <Geometry/Matrix.h>
+#include <Threads/Thread.h>
 
 #include <Templatized/LinearInterpolator.h>
 
@@ -97,6 +98,23 @@ Simplical<ScalarParam,dimensionParam,ValueParam>::EdgeID::EdgeID(
 		}
 	}
 
+/***********************************************
+Methods of class Simplical::GradientMatrixChunk:
+***********************************************/
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+inline
+void*
+Simplical<ScalarParam,dimensionParam,ValueParam>::GradientMatrixChunk::calcGradientMatrices(
+	void)
+	{
+	/* Calculate the gradient matrix of each grid vertex in the chunk: */
+	for(const GridVertex* vPtr=begin;vPtr!=end;vPtr=vPtr->succ)
+		ds->gradientMatrices[vPtr->index]=ds->calcGradientMatrix(vPtr);
+	
+	return 0;
+	}
+
 /********************************
 Methods of class Simplical::Cell:
 ********************************/
@@ -109,59 +127,7 @@ Simplical<ScalarParam,dimensionParam,ValueParam>::Cell::calcVertexGradient(
 	int vertexIndex,
 	const ScalarExtractorParam& extractor) const
 	{
-	#ifdef PERF_COUNTGRADIENTCALCULATIONS
-	++numGradients;
-	#endif
-	
-	/* Gather a least-squares system of linear equations describing the gradient at the cell vertex: */
-	Geometry::Matrix<double,dimension,dimension> a(0.0);
-	Geometry::ComponentArray<double,dimension> b(0.0);
-	
-	/* Add one linear equation for each vertex connected to the query vertex by an edge: */
-	const GridVertex* centralVertex=cell->vertices[vertexIndex];
-	Geometry::Point<double,dimension> c=Geometry::Point<double,dimension>(centralVertex->pos);
-	double fc=extractor.getValue(centralVertex->value);
-	Misc::HashTable<const GridVertex*,void> vertexHasher(17);
-	Misc::OneTimeQueue<const GridCell*> cellQueue(17);
-	cellQueue.push(cell);
-	while(!cellQueue.empty())
-		{
-		/* Get the next cell from the queue: */
-		const GridCell* cellPtr=cellQueue.front();
-		cellQueue.pop();
-		
-		/* Process all vertices of the cell: */
-		for(int vi=0;vi<CellTopology::numVertices;++vi)
-			if(cellPtr->vertices[vi]!=centralVertex)
-				{
-				/* Check if the vertex needs to be processed: */
-				const GridVertex* vertexPtr=cellPtr->vertices[vi];
-				if(!vertexHasher.isEntry(vertexPtr))
-					{
-					/* Add a linear equation for the vertex: */
-					Geometry::Vector<double,dimension> d;
-					for(int i=0;i<dimension;++i)
-						d[i]=double(vertexPtr->pos[i])-c[i];
-					double df=double(extractor.getValue(vertexPtr->value))-fc;
-					for(int i=0;i<dimension;++i)
-						{
-						for(int j=0;j<dimension;++j)
-							a(i,j)+=d[i]*d[j];
-						b[i]+=d[i]*df;
-						}
-					
-					/* Mark the vertex as processed: */
-					vertexHasher.setEntry(vertexPtr);
-					}
-				
-				/* Add the cell neighbour opposite from the vertex to the queue: */
-				if(cellPtr->neighbours[vi]!=0)
-					cellQueue.push(cellPtr->neighbours[vi]);
-				}
-		}
-	
-	/* Solve the linear system and return the gradient: */
-	return Vector(b/a);
+	return ds->calcVertexGradient(cell->vertices[vertexIndex],extractor);
 	}
 
 template <class ScalarParam,int dimensionParam,class ValueParam>
@@ -374,6 +340,150 @@ Simplical<ScalarParam,dimensionParam,ValueParam>::connectCells(
 		}
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueParam>
+inline
+void
+Simplical<ScalarParam,dimensionParam,ValueParam>::calcVertexNeighbours(
+	void)
+	{
+	/* Count the number of cells incident to each grid vertex: */
+	std::vector<size_t> vertexCellOffsets(totalNumVertices+1,0);
+	for(const GridCell* cPtr=firstGridCell;cPtr!=0;cPtr=cPtr->succ)
+		for(int i=0;i<CellTopology::numVertices;++i)
+			++vertexCellOffsets[cPtr->vertices[i]->index+1];
+	for(size_t i=0;i<totalNumVertices;++i)
+		vertexCellOffsets[i+1]+=vertexCellOffsets[i];
+	
+	/* Collect the cells incident to each grid vertex: */
+	std::vector<const GridCell*> vertexCells(vertexCellOffsets[totalNumVertices]);
+	std::vector<size_t> vertexCellEnds(vertexCellOffsets.begin(),vertexCellOffsets.end()-1);
+	for(const GridCell* cPtr=firstGridCell;cPtr!=0;cPtr=cPtr->succ)
+		for(int i=0;i<CellTopology::numVertices;++i)
+			{
+			vertexCells[vertexCellEnds[cPtr->vertices[i]->index]]=cPtr;
+			++vertexCellEnds[cPtr->vertices[i]->index];
+			}
+	
+	/* Collect the distinct vertices of all cells incident to each grid vertex; in a simplex, all pairs of vertices share an edge: */
+	vertexNeighbourOffsets.clear();
+	vertexNeighbourOffsets.reserve(totalNumVertices+1);
+	vertexNeighbours.clear();
+	vertexNeighbours.reserve(vertexCells.size()*(CellTopology::numVertices-1)/2);
+	std::vector<size_t> marks(totalNumVertices,totalNumVertices); // Index of the grid vertex whose neighbours last contained each grid vertex
+	for(const GridVertex* vPtr=firstGridVertex;vPtr!=0;vPtr=vPtr->succ)
+		{
+		vertexNeighbourOffsets.push_back(vertexNeighbours.size());
+		marks[vPtr->index]=vPtr->index;
+		for(size_t ci=vertexCellOffsets[vPtr->index];ci<vertexCellOffsets[vPtr->index+1];++ci)
+			for(int i=0;i<CellTopology::numVertices;++i)
+				{
+				const GridVertex* neighbour=vertexCells[ci]->vertices[i];
+				if(marks[neighbour->index]!=vPtr->index)
+					{
+					vertexNeighbours.push_back(neighbour);
+					marks[neighbour->index]=vPtr->index;
+					}
+				}
+		}
+	vertexNeighbourOffsets.push_back(vertexNeighbours.size());
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+inline
+typename Simplical<ScalarParam,dimensionParam,ValueParam>::GradientMatrix
+Simplical<ScalarParam,dimensionParam,ValueParam>::calcGradientMatrix(
+	const typename Simplical<ScalarParam,dimensionParam,ValueParam>::GridVertex* vertex) const
+	{
+	/* Gather the least-squares matrix describing the gradient at the grid vertex: */
+	Geometry::Matrix<double,dimension,dimension> a(0.0);
+	for(size_t ni=vertexNeighbourOffsets[vertex->index];ni<vertexNeighbourOffsets[vertex->index+1];++ni)
+		{
+		Geometry::Vector<double,dimension> d;
+		for(int i=0;i<dimension;++i)
+			d[i]=double(vertexNeighbours[ni]->pos[i])-double(vertex->pos[i]);
+		for(int i=0;i<dimension;++i)
+			for(int j=0;j<dimension;++j)
+				a(i,j)+=d[i]*d[j];
+		}
+	
+	/* Invert the matrix one column at a time: */
+	GradientMatrix result(Scalar(0));
+	try
+		{
+		for(int j=0;j<dimension;++j)
+			{
+			Geometry::ComponentArray<double,dimension> e(0.0);
+			e[j]=1.0;
+			Geometry::ComponentArray<double,dimension> column=e/a;
+			for(int i=0;i<dimension;++i)
+				result(i,j)=Scalar(column[i]);
+			}
+		}
+	catch(const std::runtime_error&)
+		{
+		/* Leave the matrix of a degenerate grid vertex zero; its gradient will be zero as well */
+		result=GradientMatrix(Scalar(0));
+		}
+	
+	return result;
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+template <class ScalarExtractorParam>
+inline
+typename Simplical<ScalarParam,dimensionParam,ValueParam>::Vector
+Simplical<ScalarParam,dimensionParam,ValueParam>::calcVertexGradient(
+	const typename Simplical<ScalarParam,dimensionParam,ValueParam>::GridVertex* vertex,
+	const ScalarExtractorParam& extractor) const
+	{
+	#ifdef PERF_COUNTGRADIENTCALCULATIONS
+	++numGradients;
+	#endif
+	
+	/* Gather a least-squares system of linear equations describing the gradient at the grid vertex: */
+	bool haveMatrix=!gradientMatrices.empty();
+	Geometry::Matrix<double,dimension,dimension> a(0.0);
+	Geometry::ComponentArray<double,dimension> b(0.0);
+	
+	/* Add one linear equation for each vertex connected to the grid vertex by an edge: */
+	double fc=extractor.getValue(vertex->value);
+	for(size_t ni=vertexNeighbourOffsets[vertex->index];ni<vertexNeighbourOffsets[vertex->index+1];++ni)
+		{
+		const GridVertex* vertexPtr=vertexNeighbours[ni];
+		Geometry::Vector<double,dimension> d;
+		for(int i=0;i<dimension;++i)
+			d[i]=double(vertexPtr->pos[i])-double(vertex->pos[i]);
+		double df=double(extractor.getValue(vertexPtr->value))-fc;
+		for(int i=0;i<dimension;++i)
+			{
+			if(!haveMatrix)
+				for(int j=0;j<dimension;++j)
+					a(i,j)+=d[i]*d[j];
+			b[i]+=d[i]*df;
+			}
+		}
+	
+	if(haveMatrix)
+		{
+		/* Multiply the right-hand side with the precomputed inverse matrix: */
+		const GradientMatrix& m=gradientMatrices[vertex->index];
+		Vector result;
+		for(int i=0;i<dimension;++i)
+			{
+			double r=0.0;
+			for(int j=0;j<dimension;++j)
+				r+=double(m(i,j))*b[j];
+			result[i]=Scalar(r);
+			}
+		return result;
+		}
+	else
+		{
+		/* Solve the linear system and return the gradient: */
+		return Vector(b/a);
+		}
+	}
+
 template <class ScalarParam,int dimensionParam,class ValueParam>
 inline
 Simplical<ScalarParam,dimensionParam,ValueParam>::Simplical(
@@ -416,8 +526,9 @@ Simplical<ScalarParam,dimensionParam,ValueParam>::addVertex(
 	const typename Simplical<ScalarParam,dimensionParam,ValueParam>::Value& value)
 	{
 	/* Create a new vertex: */
-	++totalNumVertices;
 	GridVertex* newGridVertex=new(vertexAllocator.allocate()) GridVertex(pos,value);
+	newGridVertex->index=totalNumVertices;
+	++totalNumVertices;
 	
 	/* Link new vertex to main vertex list: */
 	if(lastGridVertex!=0)
@@ -505,6 +616,10 @@ Simplical<ScalarParam,dimensionParam,ValueParam>::finalizeGrid(
 	/* Connect all cells in the data set: */
 	connectCells();
 	
+	/* Create the grid vertex adjacency used for gradient calculation, and invalidate any precomputed gradient matrices: */
+	calcVertexNeighbours();
+	gradientMatrices.clear();
+	
 	/* Calculate the center of each cell: */
 	CellCenter* ccPtr=cellCenterTree.createTree(totalNumCells);
 	for(GridCell* cPtr=firstGridCell;cPtr!=0;cPtr=cPtr->succ)
@@ -531,6 +646,52 @@ Simplical<ScalarParam,dimensionParam,ValueParam>::finalizeGrid(
 	lastCell=Cell(this,0);
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueParam>
+inline
+void
+Simplical<ScalarParam,dimensionParam,ValueParam>::calcGradientMatrices(
+	unsigned int numThreads)
+	{
+	gradientMatrices.resize(totalNumVertices);
+	
+	/* Split the grid vertex list into contiguous chunks in a single pass: */
+	size_t numChunks=numThreads>0?numThreads:1;
+	if(numChunks>totalNumVertices)
+		numChunks=totalNumVertices>0?totalNumVertices:1;
+	std::vector<GradientMatrixChunk> chunks(numChunks);
+	const GridVertex* vPtr=firstGridVertex;
+	size_t vertexIndex=0;
+	for(size_t chunk=0;chunk<numChunks;++chunk)
+		{
+		chunks[chunk].ds=this;
+		chunks[chunk].begin=vPtr;
+		size_t chunkEnd=(totalNumVertices*(chunk+1))/numChunks;
+		for(;vertexIndex<chunkEnd;++vertexIndex)
+			vPtr=vPtr->succ;
+		chunks[chunk].end=vPtr;
+		}
+	
+	/* Calculate the gradient matrices of all chunks but the first on their own threads: */
+	Threads::Thread* threads=0;
+	if(numChunks>1)
+		{
+		threads=new Threads::Thread[numChunks-1];
+		for(size_t i=1;i<numChunks;++i)
+			threads[i-1].start(&chunks[i],&GradientMatrixChunk::calcGradientMatrices);
+		}
+	
+	/* Calculate the first chunk's gradient matrices on the calling thread: */
+	chunks[0].calcGradientMatrices();
+	
+	/* Wait for all other chunks: */
+	if(threads!=0)
+		{
+		for(size_t i=1;i<numChunks;++i)
+			threads[i-1].join();
+		delete[] threads;
+		}
+	}
+
 template <class ScalarParam,int dimensionParam,class ValueParam>
 inline
 void
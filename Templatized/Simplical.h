@@ -24,12 +24,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SIMPLICAL_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SIMPLICAL_INCLUDED
 
+#include <stddef.h>
 #include <utility>
+#include <vector>
 #include <Misc/PoolAllocator.h>
 #include <Misc/HashTable.h>
 #include <Geometry/ComponentArray.h>
 #include <Geometry/Point.h>
 #include <Geometry/Vector.h>
+#include <Geometry/Matrix.h>
 #include <Geometry/Box.h>
 #include <Geometry/ValuedPoint.h>
 #include <Geometry/ArrayKdTree.h>
@@ -37,6 +40,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Templatized/Simplex.h>
 #include <Templatized/PointerID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/LocatorBatch.h>
 
 namespace Visualization {
 
@@ -68,16 +72,17 @@ class Simplical
 		public:
 		Point pos; // Position of grid vertex in data set's domain
 		Value value; // Grid vertex' value
+		size_t index; // Index of grid vertex in data set's vertex list
 		GridVertex* succ; // Pointer to next grid vertex in data set
 		
 		/* Constructors and destructors: */
 		GridVertex(void) // Dummy constructor
-			:succ(0)
+			:index(0),succ(0)
 			{
 			}
 		GridVertex(const Point& sPos,const Value& sValue) // Elementwise constructor
 			:pos(sPos),value(sValue),
-			 succ(0)
+			 index(0),succ(0)
 			{
 			}
 		};
@@ -169,6 +174,19 @@ class Simplical
 	typedef Misc::PoolAllocator<GridVertex> GridVertexAllocator; // Type of memory allocators for grid vertices
 	typedef Misc::PoolAllocator<GridCell> GridCellAllocator; // Type of memory allocators for grid cells
 	typedef Misc::HashTable<GridFace,std::pair<GridCell*,int>,GridFace> FaceHasher; // Data type for hash tables used during data set construction
+	typedef Geometry::Matrix<Scalar,dimensionParam,dimensionParam> GradientMatrix; // Type for inverted least-squares matrices to calculate vertex gradients
+	
+	struct GradientMatrixChunk // Structure for contiguous ranges of grid vertices whose gradient matrices are calculated by a single thread
+		{
+		/* Elements: */
+		public:
+		Simplical* ds; // Pointer to the data set
+		const GridVertex* begin; // First grid vertex in the chunk
+		const GridVertex* end; // Grid vertex after the last one in the chunk, or 0
+		
+		/* Methods: */
+		void* calcGradientMatrices(void); // Calculates the gradient matrices of all grid vertices in the chunk
+		};
 	
 	/* Data set interface classes: */
 	public:
@@ -379,6 +397,21 @@ class Simplical
 		typename ValueExtractorParam::DestValue calcValue(const ValueExtractorParam& extractor) const; // Calculates value at last located position
 		template <class ScalarExtractorParam>
 		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position
+		template <class ValueExtractorParam>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam& extractor,typename ValueExtractorParam::DestValue values[],bool valids[]) // Locates the given positions in order and calculates their values based on given value extractor; traces first position from last located position if traceHint is true; returns number of positions inside the data set
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor,values,valids);
+			}
+		template <class ValueExtractorParam1,class ValueExtractorParam2>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam1& extractor1,typename ValueExtractorParam1::DestValue values1[],const ValueExtractorParam2& extractor2,typename ValueExtractorParam2::DestValue values2[],bool valids[]) // Ditto; calculates the values of two value extractors from a single point location per position
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor1,values1,extractor2,values2,valids);
+			}
+		template <class ScalarExtractorParam>
+		size_t calcValuesAndGradients(size_t numPoints,const Point positions[],bool traceHint,const ScalarExtractorParam& extractor,typename ScalarExtractorParam::DestValue values[],Vector gradients[],bool valids[]) // Ditto; additionally calculates gradients based on given scalar extractor
+			{
+			return batchCalcValuesAndGradients(*this,numPoints,positions,traceHint,extractor,values,gradients,valids);
+			}
 		};
 	
 	private:
@@ -404,9 +437,16 @@ class Simplical
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
 	Scalar locatorEpsilon; // Default accuracy threshold for locators working on this data set
+	std::vector<size_t> vertexNeighbourOffsets; // Index of each grid vertex' first neighbour in the neighbour array, followed by the total number of neighbours
+	std::vector<const GridVertex*> vertexNeighbours; // Grid vertices sharing a cell edge with each grid vertex, in compressed sparse row order
+	std::vector<GradientMatrix> gradientMatrices; // Inverted least-squares gradient matrices of all grid vertices; empty if not precomputed
 	
 	/* Private methods: */
 	void connectCells(void); // Creates simplical mesh from unconnected simplices by connecting shared faces
+	void calcVertexNeighbours(void); // Creates the compressed sparse row adjacency of all grid vertices
+	GradientMatrix calcGradientMatrix(const GridVertex* vertex) const; // Returns the inverted least-squares gradient matrix of the given grid vertex
+	template <class ScalarExtractorParam>
+	Vector calcVertexGradient(const GridVertex* vertex,const ScalarExtractorParam& extractor) const; // Returns gradient at the given grid vertex, based on given scalar extractor
 	
 	/* Constructors and destructors: */
 	public:
@@ -427,6 +467,7 @@ class Simplical
 		return GridVertexIterator(0);
 		}
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
+	void calcGradientMatrices(unsigned int numThreads); // Precomputes the least-squares gradient matrices of all grid vertices on the given number of threads to turn gradient calculation into a table lookup; must be called after finalizeGrid
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
 	
 	/* Methods implementing the data set interface: */
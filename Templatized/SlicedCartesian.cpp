@@ -340,6 +340,57 @@ SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::calcVertexGradient
 	return result;
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+void
+SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::deleteSlices(
+	void)
+	{
+	/* Delete owned slice arrays and release adopted slice storage: */
+	for(int slice=0;slice<numSlices;++slice)
+		{
+		if(sliceStorages[slice].adopted)
+			delete sliceStorages[slice].storage;
+		else
+			delete[] slices[slice];
+		}
+	delete[] slices;
+	delete[] sliceStorages;
+	numSlices=0;
+	slices=0;
+	sliceStorages=0;
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+int
+SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::appendSlice(
+	typename SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::ValueScalar* newSlice,
+	bool adopted,
+	ExternalStorage* storage)
+	{
+	/* Create new slice and slice storage arrays: */
+	ValueScalar** newSlices=new ValueScalar*[numSlices+1];
+	SliceStorage* newSliceStorages=new SliceStorage[numSlices+1];
+	for(int slice=0;slice<numSlices;++slice)
+		{
+		newSlices[slice]=slices[slice];
+		newSliceStorages[slice]=sliceStorages[slice];
+		}
+	
+	/* Install the new slice: */
+	newSlices[numSlices]=newSlice;
+	newSliceStorages[numSlices].adopted=adopted;
+	newSliceStorages[numSlices].storage=storage;
+	delete[] slices;
+	delete[] sliceStorages;
+	++numSlices;
+	slices=newSlices;
+	sliceStorages=newSliceStorages;
+	
+	return numSlices-1;
+	}
+
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
 inline
 SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::SlicedCartesian(
@@ -349,7 +400,8 @@ SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::SlicedCartesian(
 	 cellSize(Scalar(0)),
 	 domainBox(Box::empty),
 	 numSlices(0),
-	 slices(0)
+	 slices(0),
+	 sliceStorages(0)
 	{
 	/* Initialize vertex stride array: */
 	for(int i=0;i<dimension;++i)
@@ -377,7 +429,9 @@ SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::SlicedCartesian(
 	const typename SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::Size& sCellSize,
 	int sNumSlices,
 	const typename SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::ValueScalar* sVertexValues)
-	:slices(0)
+	:numSlices(0),
+	 slices(0),
+	 sliceStorages(0)
 	{
 	setData(sNumVertices,sCellSize,sNumSlices,sVertexValues);
 	}
@@ -388,9 +442,7 @@ SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::~SlicedCartesian(
 	void)
 	{
 	/* Delete slice arrays: */
-	for(int slice=0;slice<numSlices;++slice)
-		delete[] slices[slice];
-	delete[] slices;
+	deleteSlices();
 	}
 
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
@@ -446,14 +498,17 @@ SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::setData(
 	
 	
 	/* Re-initialize the slice arrays: */
-	for(int slice=0;slice<numSlices;++slice)
-		delete[] slices[slice];
-	delete[] slices;
+	deleteSlices();
 	numSlices=sNumSlices;
 	slices=new ValueScalar*[numSlices];
+	sliceStorages=new SliceStorage[numSlices];
 	size_t totalNumVertices=size_t(numVertices.calcIncrement(-1));
 	for(int slice=0;slice<numSlices;++slice)
+		{
 		slices[slice]=new ValueScalar[totalNumVertices];
+		sliceStorages[slice].adopted=false;
+		sliceStorages[slice].storage=0;
+		}
 	
 	/* Copy source vertex values, if present: */
 	if(sVertexValues!=0)
@@ -475,29 +530,31 @@ int
 SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::addSlice(
 	const typename SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::ValueScalar* sSliceValues)
 	{
-	/* Create a new slice array: */
-	ValueScalar** newSlices=new ValueScalar*[numSlices+1];
-	for(int slice=0;slice<numSlices;++slice)
-		newSlices[slice]=slices[slice];
-	
 	/* Initialize the new slice: */
 	size_t totalNumVertices=size_t(numVertices.calcIncrement(-1));
-	newSlices[numSlices]=new ValueScalar[totalNumVertices];
+	ValueScalar* newSlice=new ValueScalar[totalNumVertices];
 	
 	if(sSliceValues!=0)
 		{
 		/* Copy the given slice values: */
-		ValueScalar* slicePtr=newSlices[numSlices];
+		ValueScalar* slicePtr=newSlice;
 		for(size_t i=0;i<totalNumVertices;++i,++slicePtr,++sSliceValues)
 			*slicePtr=*sSliceValues;
 		}
 	
-	/* Install the new slice array: */
-	delete[] slices;
-	++numSlices;
-	slices=newSlices;
-	
-	return numSlices-1;
+	/* Install the new slice: */
+	return appendSlice(newSlice,false,0);
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+int
+SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::adoptSlice(
+	typename SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam>::ValueScalar* sSliceValues,
+	ExternalStorage* sSliceStorage)
+	{
+	/* Install the given slice without copying: */
+	return appendSlice(sSliceValues,true,sSliceStorage);
 	}
 
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
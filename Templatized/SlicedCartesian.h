@@ -30,9 +30,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Box.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/ExternalStorage.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/LocatorBatch.h>
 
 namespace Visualization {
 
@@ -236,6 +238,30 @@ class SlicedCartesian
 		typename ValueExtractorParam::DestValue calcValue(const ValueExtractorParam& extractor) const; // Calculates value at last located position
 		template <class ScalarExtractorParam>
 		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position
+		template <class ValueExtractorParam>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam& extractor,typename ValueExtractorParam::DestValue values[],bool valids[]) // Locates the given positions in order and calculates their values based on given value extractor; traces first position from last located position if traceHint is true; returns number of positions inside the data set
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor,values,valids);
+			}
+		template <class ValueExtractorParam1,class ValueExtractorParam2>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam1& extractor1,typename ValueExtractorParam1::DestValue values1[],const ValueExtractorParam2& extractor2,typename ValueExtractorParam2::DestValue values2[],bool valids[]) // Ditto; calculates the values of two value extractors from a single point location per position
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor1,values1,extractor2,values2,valids);
+			}
+		template <class ScalarExtractorParam>
+		size_t calcValuesAndGradients(size_t numPoints,const Point positions[],bool traceHint,const ScalarExtractorParam& extractor,typename ScalarExtractorParam::DestValue values[],Vector gradients[],bool valids[]) // Ditto; additionally calculates gradients based on given scalar extractor
+			{
+			return batchCalcValuesAndGradients(*this,numPoints,positions,traceHint,extractor,values,gradients,valids);
+			}
+		};
+	
+	private:
+	struct SliceStorage // Structure describing who owns a vertex value slice
+		{
+		/* Elements: */
+		public:
+		bool adopted; // Flag whether the slice's values were adopted from external storage instead of allocated by the data set
+		ExternalStorage* storage; // Object owning an adopted slice's values; null if the data set or the caller owns the slice's values
 		};
 	
 	friend class Vertex;
@@ -254,8 +280,11 @@ class SlicedCartesian
 	Box domainBox; // Bounding box of all vertices
 	int numSlices; // Number of scalar value slices in the data set
 	ValueScalar** slices; // Array of vertex value slices
+	SliceStorage* sliceStorages; // Array of storage descriptors of the vertex value slices
 	
 	/* Private methods: */
+	void deleteSlices(void); // Releases all vertex value slices
+	int appendSlice(ValueScalar* newSlice,bool adopted,ExternalStorage* storage); // Appends the given vertex value slice to the data set; returns the new slice's index
 	template <class ScalarExtractorParam>
 	Vector calcVertexGradient(const Index& vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at a vertex based on the given scalar extractor
 	
@@ -268,6 +297,7 @@ class SlicedCartesian
 	/* Data set construction methods: */
 	void setData(const Index& sNumVertices,const Size& sCellSize,int sNumSlices,const ValueScalar* sVertexValues =0); // Sets the number of vertices and cell size of the data set; copies slice-major vertex data if pointer is not null
 	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies vertex data if pointer is not null
+	int adoptSlice(ValueScalar* sSliceValues,ExternalStorage* sSliceStorage); // Adds another slice to the data set that adopts the given vertex data without copying; takes ownership of the storage object if it is not null, which is deleted together with the slice
 	
 	/* Low-level data access methods: */
 	const Index& getNumVertices(void) const // Returns number of vertices in the data set
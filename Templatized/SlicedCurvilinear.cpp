@@ -29,7 +29,6 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Matrix.h>
 
 #include <Templatized/LinearInterpolator.h>
-#include <Templatized/FindClosestPointFunctor.h>
 
 #include <Templatized/SlicedCurvilinear.h>
 
@@ -230,157 +229,79 @@ SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::setEpsi
 
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
 inline
-bool
-SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::locatePoint(
-	const typename SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Point& position,
-	bool traceHint)
+void
+SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::startCell(
+	const typename SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::CellID& cellID)
 	{
-	/* If traceHint parameter is false or locator is invalid, start searching from scratch: */
-	if(!traceHint||cantTrace)
-		{
-		/* Start searching from cell whose cell center is closest to query position: */
-		FindClosestPointFunctor<CellCenter> f(position,ds->maxCellRadius2);
-		ds->cellCenterTree.traverseTreeDirected(f);
-		if(f.getClosestPoint()==0) // Bail out if no cell is close enough
-			return false;
-		
-		/* Go to the found cell: */
-		Cell::operator=(ds->getCell(f.getClosestPoint()->value));
-		
-		/* Initialize local cell position: */
-		for(int i=0;i<dimension;++i)
-			cellPos[i]=Scalar(0.5);
-		
-		/* Now we can trace: */
-		cantTrace=false;
-		}
+	Cell::operator=(ds->getCell(cellID));
+	for(int i=0;i<dimension;++i)
+		cellPos[i]=Scalar(0.5);
+	}
 
-	/* Perform Newton-Raphson iteration until it converges and the current cell contains the query point: */
-	Scalar maxOut;
-	CellID previousCellID; // Cell ID to detect "thrashing" between cells
-	CellID currentCellID=getCellID(); // Ditto
-	Scalar previousMaxMove=Scalar(0); // Reason we went into the current cell
-	int iteration=0;
-	for(iteration=0;iteration<10;++iteration)
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+bool
+SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::moveToNeighbour(
+	typename SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Scalar& maxMove)
+	{
+	/* Find the direction in which the last located point is farthest outside the current cell: */
+	maxMove=Scalar(0);
+	int moveDim=0;
+	int moveDir=0;
+	for(int i=0;i<dimension;++i)
 		{
-		/* Perform Newton-Raphson iteration in the current cell until it converges, or goes really bad: */
-		while(true)
-			{
-			/* Do one step: */
-			bool converged=newtonRaphsonStep(position);
-			
-			/* Check for signs of convergence failure: */
-			maxOut=Scalar(0);
-			for(int i=0;i<dimension;++i)
-				{
-				if(maxOut<-cellPos[i])
-					maxOut=-cellPos[i];
-				else if(maxOut<cellPos[i]-Scalar(1))
-					maxOut=cellPos[i]-Scalar(1);
-				}
-			if(converged||maxOut>Scalar(1)) // Tolerate at most one cell size out (this is somewhat ad-hoc)
-				break;
-			}
-		
-		/* Check if the current cell contains the query position: */
-		if(maxOut==Scalar(0))
-			return true;
-		
-		/* Check if this was the first step, and we're way off: */
-		if(iteration==0&&maxOut>Scalar(5))
+		if(maxMove<-cellPos[i])
 			{
-			/* We had a tracing failure; just start searching from scratch: */
-			FindClosestPointFunctor<CellCenter> f(position,ds->maxCellRadius2);
-			ds->cellCenterTree.traverseTreeDirected(f);
-			if(f.getClosestPoint()==0) // Bail out if no cell is close enough
+			/* Check if we can actually move in this direction: */
+			if(index[i]>0)
 				{
-				/* At this point, the locator is borked. Better not trace next time: */
-				cantTrace=true;
-				
-				/* And we're outside the grid, too: */
-				return false;
+				maxMove=-cellPos[i];
+				moveDim=i;
+				moveDir=-1;
 				}
-			
-			/* Go to the found cell: */
-			Cell::operator=(ds->getCell(f.getClosestPoint()->value));
-			previousCellID=currentCellID;
-			currentCellID=f.getClosestPoint()->value;
-			previousMaxMove=maxOut;
-			
-			/* Initialize the local cell position: */
-			for(int i=0;i<dimension;++i)
-				cellPos[i]=Scalar(0.5);
-			
-			/* Start over: */
-			continue;
 			}
-		
-		/* Otherwise, try moving to a different cell: */
-		Scalar maxMove=Scalar(0);
-		int moveDim=0;
-		int moveDir=0;
-		for(int i=0;i<dimension;++i)
+		else if(maxMove<cellPos[i]-Scalar(1))
 			{
-			if(maxMove<-cellPos[i])
-				{
-				/* Check if we can actually move in this direction: */
-				if(index[i]>0)
-					{
-					maxMove=-cellPos[i];
-					moveDim=i;
-					moveDir=-1;
-					}
-				}
-			else if(maxMove<cellPos[i]-Scalar(1))
+			/* Check if we can actually move in this direction: */
+			if(index[i]<ds->numCells[moveDim]-1)
 				{
-				/* Check if we can actually move in this direction: */
-				if(index[i]<ds->numCells[moveDim]-1)
-					{
-					maxMove=cellPos[i]-Scalar(1);
-					moveDim=i;
-					moveDir=1;
-					}
+				maxMove=cellPos[i]-Scalar(1);
+				moveDim=i;
+				moveDir=1;
 				}
 			}
-		
-		/* If we can move somewhere, do it: */
-		if(moveDir==-1)
-			{
-			cellPos[moveDim]+=Scalar(1);
-			--index[moveDim];
-			baseVertexIndex-=ds->vertexStrides[moveDim];
-			}
-		else if(moveDir==1)
-			{
-			cellPos[moveDim]-=Scalar(1);
-			++index[moveDim];
-			baseVertexIndex+=ds->vertexStrides[moveDim];
-			}
-		else
-			{
-			/* At this point, the locator is borked. Better not trace next time: */
-			cantTrace=true;
-			
-			/* We're not in the current cell, and can't move anywhere else -- we're outside the grid: */
-			return false;
-			}
-		
-		/* Check if we've just moved back into the cell we just came from: */
-		CellID nextCellID=getCellID();
-		if(nextCellID==previousCellID&&maxMove<=previousMaxMove)
-			return true;
-		
-		/* Check for thrashing on the next iteration step: */
-		previousCellID=currentCellID;
-		currentCellID=nextCellID;
-		previousMaxMove=maxMove;
 		}
 	
-	/* Just to be safe, don't trace on the next step: */
-	cantTrace=true;
+	/* If we can move somewhere, do it: */
+	if(moveDir==-1)
+		{
+		cellPos[moveDim]+=Scalar(1);
+		--index[moveDim];
+		baseVertexIndex-=ds->vertexStrides[moveDim];
+		}
+	else if(moveDir==1)
+		{
+		cellPos[moveDim]-=Scalar(1);
+		++index[moveDim];
+		baseVertexIndex+=ds->vertexStrides[moveDim];
+		}
+	else
+		{
+		/* We're not in the current cell, and can't move anywhere else -- we're outside the grid: */
+		return false;
+		}
 	
-	/* Return true if the final cell contains the query position, with some fudge: */
-	return maxOut<Scalar(1.0e-4);
+	return true;
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+bool
+SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::locatePoint(
+	const typename SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Point& position,
+	bool traceHint)
+	{
+	return ds->cellBoxTree.locatePoint(*this,position,traceHint);
 	}
 
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
@@ -703,14 +624,13 @@ SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::finalizeGrid(
 	for(int i=0;i<totalNumVertices;++i,++vPtr)
 		domainBox.addPoint(*vPtr);
 	
-	/* Create array containing all cell centers and cell indices: */
-	CellCenter* ccPtr=cellCenterTree.createTree(numCells.calcIncrement(-1));
+	/* Create array containing all cell bounding boxes and cell indices: */
+	CellBox* cbPtr=cellBoxTree.createTree(numCells.calcIncrement(-1));
 	
 	/* Calculate all cell centers: */
 	Scalar minCellRadius2(Math::Constants<Scalar>::max);
 	double cellRadiusSum=0.0;
-	maxCellRadius2=Scalar(0);
-	for(CellIterator cIt=beginCells();cIt!=endCells();++cIt,++ccPtr)
+	for(CellIterator cIt=beginCells();cIt!=endCells();++cIt,++cbPtr)
 		{
 		/* Calculate cell's center point: */
 		typename Point::AffineCombiner cc;
@@ -729,15 +649,16 @@ SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::finalizeGrid(
 		if(minCellRadius2>maxDist2)
 			minCellRadius2=maxDist2;
 		cellRadiusSum+=Math::sqrt(double(maxDist2));
-		if(maxCellRadius2<maxDist2)
-			maxCellRadius2=maxDist2;
 		
-		/* Store cell center and pointer: */
-		*ccPtr=CellCenter(center,cIt->getID());
+		/* Store cell bounding box and ID: */
+		cbPtr->box=Box::empty;
+		for(int i=0;i<CellTopology::numVertices;++i)
+			cbPtr->box.addPoint(cIt->getVertexPosition(i));
+		cbPtr->cellID=cIt->getID();
 		}
 	
-	/* Create the cell center tree: */
-	cellCenterTree.releasePoints(4); // Let's just go ahead and use the multithreaded version
+	/* Create the cell box hierarchy: */
+	cellBoxTree.releaseBoxes(4); // Let's just go ahead and use the multithreaded version
 	
 	/* Calculate the average cell radius: */
 	avgCellRadius=Scalar(cellRadiusSum/double(numCells.calcIncrement(-1)));
@@ -769,6 +690,66 @@ SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::setLocatorEpsilo
 	locatorEpsilon=newLocatorEpsilon;
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+template <class DataSinkParam>
+inline
+void
+SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::writeCache(
+	DataSinkParam& dataSink) const
+	{
+	/* Write the grid: */
+	for(int i=0;i<dimension;++i)
+		dataSink.template write<int>(numVertices[i]);
+	size_t totalNumVertices=numVertices.calcIncrement(-1);
+	dataSink.template write<Point>(grid.getArray(),totalNumVertices);
+	
+	/* Write all value slices: */
+	dataSink.template write<int>(numSlices);
+	for(int sliceIndex=0;sliceIndex<numSlices;++sliceIndex)
+		dataSink.template write<ValueScalar>(slices[sliceIndex].getArray(),totalNumVertices);
+	
+	/* Write the derived grid information: */
+	dataSink.template write<Box>(domainBox);
+	dataSink.template write<Scalar>(avgCellRadius);
+	dataSink.template write<Scalar>(locatorEpsilon);
+	cellBoxTree.writeCache(dataSink);
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+template <class DataSourceParam>
+inline
+void
+SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::readCache(
+	DataSourceParam& dataSource)
+	{
+	/* Remove all value slices: */
+	delete[] slices;
+	numSlices=0;
+	slices=0;
+	
+	/* Read the grid: */
+	Index newNumVertices;
+	for(int i=0;i<dimension;++i)
+		newNumVertices[i]=dataSource.template read<int>();
+	setGrid(newNumVertices);
+	size_t totalNumVertices=numVertices.calcIncrement(-1);
+	dataSource.template read<Point>(grid.getArray(),totalNumVertices);
+	
+	/* Read all value slices: */
+	int newNumSlices=dataSource.template read<int>();
+	for(int i=0;i<newNumSlices;++i)
+		{
+		int sliceIndex=addSlice();
+		dataSource.template read<ValueScalar>(slices[sliceIndex].getArray(),totalNumVertices);
+		}
+	
+	/* Read the derived grid information instead of recalculating it: */
+	domainBox=dataSource.template read<Box>();
+	avgCellRadius=dataSource.template read<Scalar>();
+	locatorEpsilon=dataSource.template read<Scalar>();
+	cellBoxTree.readCache(dataSource);
+	}
+
 }
 
 }
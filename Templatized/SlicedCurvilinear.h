@@ -29,13 +29,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Point.h>
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
-#include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/SlicedDataValue.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/CellBoxTree.h>
+#include <Templatized/LocatorBatch.h>
 
 namespace Visualization {
 
@@ -214,6 +214,7 @@ class SlicedCurvilinear
 	class Locator:private Cell // Class responsible for evaluating a data set at a given position
 		{
 		friend class SlicedCurvilinear;
+		friend class CellBoxTree<Scalar,dimensionParam,CellID>;
 		
 		/* Embedded classes: */
 		private:
@@ -226,9 +227,14 @@ class SlicedCurvilinear
 		CellPosition cellPos; // Local coordinates of last located point inside its cell
 		Scalar epsilon,epsilon2; // Accuracy threshold of point location algorithm
 		bool cantTrace; // Flag if the locator cannot trace on the next locatePoint call
+		#ifdef PERF_COUNTLOCATORSTEPS
+		LocatorStepCounters stepCounters; // Counts of the work done by this locator
+		#endif
 		
 		/* Private methods: */
 		bool newtonRaphsonStep(const Point& position); // Performs one Newton-Raphson step while tracing the given position
+		void startCell(const CellID& cellID); // Moves the locator to the center of the given cell to start a search
+		bool moveToNeighbour(Scalar& maxMove); // Moves the locator into the neighbouring cell in the direction in which the last located point is farthest outside the current cell; stores that distance in maxMove and returns false if there is no such neighbour
 		
 		/* Constructors and destructors: */
 		public:
@@ -239,6 +245,12 @@ class SlicedCurvilinear
 		/* Methods: */
 		public:
 		void setEpsilon(Scalar newEpsilon); // Sets a new accuracy threshold in local cell dimension
+		#ifdef PERF_COUNTLOCATORSTEPS
+		const LocatorStepCounters& getStepCounters(void) const // Returns the counts of the work done by this locator
+			{
+			return stepCounters;
+			}
+		#endif
 		CellID getCellID(void) const // Returns the ID of the cell containing the last located point
 			{
 			return Cell::getID();
@@ -248,11 +260,26 @@ class SlicedCurvilinear
 		typename ValueExtractorParam::DestValue calcValue(const ValueExtractorParam& extractor) const; // Calculates value at last located position
 		template <class ScalarExtractorParam>
 		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position
+		template <class ValueExtractorParam>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam& extractor,typename ValueExtractorParam::DestValue values[],bool valids[]) // Locates the given positions in order and calculates their values based on given value extractor; traces first position from last located position if traceHint is true; returns number of positions inside the data set
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor,values,valids);
+			}
+		template <class ValueExtractorParam1,class ValueExtractorParam2>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam1& extractor1,typename ValueExtractorParam1::DestValue values1[],const ValueExtractorParam2& extractor2,typename ValueExtractorParam2::DestValue values2[],bool valids[]) // Ditto; calculates the values of two value extractors from a single point location per position
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor1,values1,extractor2,values2,valids);
+			}
+		template <class ScalarExtractorParam>
+		size_t calcValuesAndGradients(size_t numPoints,const Point positions[],bool traceHint,const ScalarExtractorParam& extractor,typename ScalarExtractorParam::DestValue values[],Vector gradients[],bool valids[]) // Ditto; additionally calculates gradients based on given scalar extractor
+			{
+			return batchCalcValuesAndGradients(*this,numPoints,positions,traceHint,extractor,values,gradients,valids);
+			}
 		};
 	
 	private:
-	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	typedef CellBoxTree<Scalar,dimension,CellID> BoxTree; // Data type for bounding volume hierarchies to locate cells containing a point
+	typedef typename BoxTree::CellBox CellBox; // Data type to associate a cell's bounding box and its ID
 	
 	friend class Vertex;
 	friend class Cell;
@@ -267,12 +294,11 @@ class SlicedCurvilinear
 	int vertexStrides[dimension]; // Array of pointer stride values in the vertex array
 	Index numCells; // Number of cells in data set in each dimension
 	int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
-	CellCenterTree cellCenterTree; // Kd-tree containing cell centers
+	BoxTree cellBoxTree; // Bounding volume hierarchy containing cell bounding boxes
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
 	Scalar avgCellRadius; // Average "radius" of all cells
-	Scalar maxCellRadius2; // Squared maximum "radius" of any cell (used as trivial reject threshold during point location)
 	Scalar locatorEpsilon; // Default accuracy threshold for locators working on this data set
 	
 	/* Private methods: */
@@ -349,6 +375,10 @@ class SlicedCurvilinear
 		return locatorEpsilon;
 		}
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
+	template <class DataSinkParam>
+	void writeCache(DataSinkParam& dataSink) const; // Writes the data set's grid, value slices, and derived grid information to a binary data sink
+	template <class DataSourceParam>
+	void readCache(DataSourceParam& dataSource); // Replaces the data set with one previously written by writeCache, without recalculating derived grid information
 	
 	/* Methods implementing the data set interface: */
 	size_t getTotalNumVertices(void) const // Returns total number of vertices in the data set
@@ -395,6 +425,10 @@ class SlicedCurvilinear
 		{
 		return Locator(this,locatorEpsilon);
 		}
+	size_t getLocatorMemorySize(void) const // Returns the approximate memory size of the data set's point location structures in bytes
+		{
+		return cellBoxTree.getMemorySize();
+		}
 	};
 
 }
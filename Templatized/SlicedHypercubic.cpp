@@ -23,14 +23,14 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_TEMPLATIZED_SLICEDHYPERCUBIC_IMPLEMENTATION
 
-#include <Misc/OneTimeQueue.h>
+#include <stdexcept>
 #include <Math/Math.h>
 #include <Math/Constants.h>
 #include <Geometry/AffineCombiner.h>
 #include <Geometry/Matrix.h>
+#include <Threads/Thread.h>
 
 #include <Templatized/LinearInterpolator.h>
-#include <Templatized/FindClosestPointFunctor.h>
 
 #include <Templatized/SlicedHypercubic.h>
 
@@ -52,6 +52,23 @@ SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::GridCell::GridCel
 		neighbours[i]=~CellIndex(0);
 	}
 
+/******************************************************
+Methods of class SlicedHypercubic::GradientMatrixChunk:
+******************************************************/
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+void*
+SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::GradientMatrixChunk::calcGradientMatrices(
+	void)
+	{
+	/* Calculate the gradient matrix of each grid vertex in the chunk: */
+	for(VertexIndex vi=begin;vi!=end;++vi)
+		ds->gradientMatrices[vi]=ds->calcGradientMatrix(vi);
+	
+	return 0;
+	}
+
 /***************************************
 Methods of class SlicedHypercubic::Cell:
 ***************************************/
@@ -76,64 +93,7 @@ SlicedHypercubic<ScalarParam,dimensionParam,ValueParam>::Cell::calcVertexGradien
 	int vertexIndex,
 	const ScalarExtractorParam& extractor) const
 	{
-	/* Gather a least-squares system of linear equations describing the gradient at the cell vertex: */
-	Geometry::Matrix<double,dimension,dimension> a(0.0);
-	Geometry::ComponentArray<double,dimension> b(0.0);
-	VertexIndex centralVertex=cell->vertices[vertexIndex];
-	Geometry::Point<double,dimension> c=ds->gridVertices[centralVertex];
-	double fc=extractor.getValue(centralVertex);
-	
-	/* Add one linear equation for each vertex connected to the query vertex by an edge: */
-	Misc::HashTable<VertexIndex,void> processedVertices(17);
-	Misc::OneTimeQueue<CellIndex> cellQueue(17);
-	cellQueue.push(index);
-	while(!cellQueue.empty())
-		{
-		/* Get the next cell from the queue: */
-		CellIndex qcellIndex=cellQueue.front();
-		const GridCell* qcell=&ds->gridCells[qcellIndex];
-		cellQueue.pop();
-		
-		/* Find the index of the central vertex in the cell: */
-		int qvertexIndex;
-		for(qvertexIndex=0;qvertexIndex<CellTopology::numVertices&&qcell->vertices[qvertexIndex]!=centralVertex;++qvertexIndex)
-			;
-		
-		/* Process all neighbours of the vertex: */
-		int dimensionMask=0x1;
-		for(int dim=0;dim<dimension;++dim,dimensionMask<<=1)
-			{
-			/* Get the neighbour vertex: */
-			VertexIndex neighbour=qcell->vertices[qvertexIndex^dimensionMask];
-			
-			/* Check if the neighbour needs to be processed (and mark it as processed either way): */
-			if(!processedVertices.setEntry(neighbour))
-				{
-				/* Add a linear equation for the vertex: */
-				const GridVertex& n=ds->gridVertices[neighbour];
-				Geometry::Vector<double,dimension> d;
-				for(int i=0;i<dimension;++i)
-					d[i]=double(n[i])-c[i];
-				double df=double(extractor.getValue(neighbour))-fc;
-				for(int i=0;i<dimension;++i)
-					{
-					for(int j=0;j<dimension;++j)
-						a(i,j)+=d[i]*d[j];
-					b[i]+=d[i]*df;
-					}
-				}
-			
-			/* Add the cell adjacent to the central vertex to the cell queue, if it exists: */
-			int faceIndex=dim*2;
-			if(qvertexIndex&dimensionMask)
-				++faceIndex;
-			if(qcell->neighbours[faceIndex]!=~CellIndex(0))
-				cellQueue.push(qcell->neighbours[faceIndex]);
-			}
-		}
-	
-	/* Solve the linear system and return the gradient: */
-	return Vector(b/a);
+	return ds->calcVertexGradient(cell->vertices[vertexIndex],extractor);
 	}
 
 /******************************************
@@ -149,7 +109,7 @@ SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Locator::newtonRa
 	typedef Geometry::Matrix<Scalar,dimension,dimension> Matrix;
 	
 	/* Transform the current cell position to domain space: */
-
+	
 	/* Perform multilinear interpolation: */
 	Point p[CellTopology::numVertices>>1]; // Array of intermediate interpolation points
 	int interpolationDimension=dimension-1;
@@ -243,152 +203,74 @@ SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Locator::setEpsil
 	epsilon2=Math::sqr(epsilon);
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+void
+SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Locator::startCell(
+	const typename SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::CellID& cellID)
+	{
+	Cell::operator=(ds->getCell(cellID));
+	for(int i=0;i<dimension;++i)
+		cellPos[i]=Scalar(0.5);
+	}
+
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
 inline
 bool
-SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Locator::locatePoint(
-	const typename SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Point& position,
-	bool traceHint)
+SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Locator::moveToNeighbour(
+	typename SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Scalar& maxMove)
 	{
-	/* If traceHint parameter is false or locator can't trace, start searching from scratch: */
-	if(!traceHint||cantTrace)
-		{
-		/* Start searching from cell whose cell center is closest to query position: */
-		FindClosestPointFunctor<CellCenter> f(position,ds->maxCellRadius2);
-		ds->cellCenterTree.traverseTreeDirected(f);
-		if(f.getClosestPoint()==0) // Bail out if no cell is close enough
-			return false;
-		
-		/* Go to the found cell: */
-		Cell::operator=(ds->getCell(f.getClosestPoint()->value));
-		
-		/* Initialize local cell position: */
-		for(int i=0;i<dimension;++i)
-			cellPos[i]=Scalar(0.5);
-		
-		/* Now we can trace: */
-		cantTrace=false;
-		}
-	
-	/* Perform Newton-Raphson iteration until it converges and the current cell contains the query point: */
-	Scalar maxOut;
-	CellID previousCellID; // Cell ID to detect "thrashing" between cells
-	CellID currentCellID=getCellID(); // Ditto
-	Scalar previousMaxMove=Scalar(0); // Reason we went into the current cell
-	int iteration=0;
-	for(iteration=0;iteration<10;++iteration)
+	/* Find the direction in which the last located point is farthest outside the current cell: */
+	maxMove=Scalar(0);
+	CellIndex moveCellIndex=~CellIndex(0); // Cleverly keep track of this index to reduce work later!
+	for(int i=0;i<dimension;++i)
 		{
-		/* Perform Newton-Raphson iteration in the current cell until it converges, or goes really bad: */
-		while(true)
+		if(maxMove<-cellPos[i])
 			{
-			/* Do one step: */
-			bool converged=newtonRaphsonStep(position);
-			
-			/* Check for signs of convergence failure: */
-			maxOut=Scalar(0);
-			for(int i=0;i<dimension;++i)
+			/* Check if we can actually move in this direction: */
+			if(cell->neighbours[i*2+0]!=~CellIndex(0))
 				{
-				if(maxOut<-cellPos[i])
-					maxOut=-cellPos[i];
-				else if(maxOut<cellPos[i]-Scalar(1))
-					maxOut=cellPos[i]-Scalar(1);
+				maxMove=-cellPos[i];
+				moveCellIndex=cell->neighbours[i*2+0];
 				}
-			if(converged||maxOut>Scalar(1)) // Tolerate at most one cell size out (this is somewhat ad-hoc)
-				break;
-			}
-		
-		/* Check if the current cell contains the query position: */
-		if(maxOut==Scalar(0))
-			return true;
-		
-		/* Check if this was the first step, and we're way off: */
-		if(iteration==0&&maxOut>Scalar(5))
-			{
-			/* We had a tracing failure; just start searching from scratch: */
-			FindClosestPointFunctor<CellCenter> f(position,ds->maxCellRadius2);
-			ds->cellCenterTree.traverseTreeDirected(f);
-			if(f.getClosestPoint()==0) // Bail out if no cell is close enough
-				{
-				/* At this point, the locator is borked. Better not trace next time: */
-				cantTrace=true;
-				
-				/* And we're outside the grid, too: */
-				return false;
-				}
-			
-			/* Go to the found cell: */
-			Cell::operator=(ds->getCell(f.getClosestPoint()->value));
-			previousCellID=currentCellID;
-			currentCellID=f.getClosestPoint()->value;
-			previousMaxMove=maxOut;
-			
-			/* Initialize the local cell position: */
-			for(int i=0;i<dimension;++i)
-				cellPos[i]=Scalar(0.5);
-			
-			/* Start over: */
-			continue;
 			}
-		
-		/* Otherwise, try moving to a different cell: */
-		Scalar maxMove=Scalar(0);
-		CellIndex moveCellIndex=~CellIndex(0); // Cleverly keep track of this index to reduce work later!
-		for(int i=0;i<dimension;++i)
+		else if(maxMove<cellPos[i]-Scalar(1))
 			{
-			if(maxMove<-cellPos[i])
+			/* Check if we can actually move in this direction: */
+			if(cell->neighbours[i*2+1]!=~CellIndex(0))
 				{
-				/* Check if we can actually move in this direction: */
-				if(cell->neighbours[i*2+0]!=~CellIndex(0))
-					{
-					maxMove=-cellPos[i];
-					moveCellIndex=cell->neighbours[i*2+0];
-					}
-				}
-			else if(maxMove<cellPos[i]-Scalar(1))
-				{
-				/* Check if we can actually move in this direction: */
-				if(cell->neighbours[i*2+1]!=~CellIndex(0))
-					{
-					maxMove=cellPos[i]-Scalar(1);
-					moveCellIndex=cell->neighbours[i*2+1];
-					}
+				maxMove=cellPos[i]-Scalar(1);
+				moveCellIndex=cell->neighbours[i*2+1];
 				}
 			}
-		
-		/* If we can move somewhere, do it: */
-		if(moveCellIndex!=~CellIndex(0))
-			{
-			/* Move to the next cell: */
-			index=moveCellIndex;
-			cell=&ds->gridCells[index];
-			for(int i=0;i<dimension;++i)
-				cellPos[i]=Scalar(0.5);
-			}
-		else
-			{
-			/* At this point, the locator is borked. Better not trace next time: */
-			cantTrace=true;
-			
-			/* We're not in the current cell, and can't move anywhere else -- we're outside the grid: */
-			return false;
-			}
-		
-		/* Check if we've just moved back into the cell we just came from: */
-		CellID nextCellID=getCellID();
-		if(nextCellID==previousCellID&&maxMove<=previousMaxMove)
-			return true;
-		
-		/* Check for thrashing on the next iteration step: */
-		previousCellID=currentCellID;
-		currentCellID=nextCellID;
-		previousMaxMove=maxMove;
 		}
 	
-	/* Just to be safe, don't trace on the next step: */
-	cantTrace=true;
+	/* If we can move somewhere, do it: */
+	if(moveCellIndex!=~CellIndex(0))
+		{
+		/* Move to the next cell: */
+		index=moveCellIndex;
+		cell=&ds->gridCells[index];
+		for(int i=0;i<dimension;++i)
+			cellPos[i]=Scalar(0.5);
+		}
+	else
+		{
+		/* We're not in the current cell, and can't move anywhere else -- we're outside the grid: */
+		return false;
+		}
 	
-	/* Return true if the final cell contains the query position, with some fudge: */
-	return maxOut<Scalar(1.0e-4);
+	return true;
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+bool
+SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Locator::locatePoint(
+	const typename SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Point& position,
+	bool traceHint)
+	{
+	return ds->cellBoxTree.locatePoint(*this,position,traceHint);
 	}
 
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
@@ -487,6 +369,154 @@ SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::resizeSlices(
 	allocatedSliceSize=newAllocatedSize;
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+void
+SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::calcVertexNeighbours(
+	void)
+	{
+	/* Count the number of cells incident to each grid vertex: */
+	size_t numVertices=gridVertices.size();
+	std::vector<size_t> vertexCellOffsets(numVertices+1,0);
+	for(typename GridCellList::const_iterator gcIt=gridCells.begin();gcIt!=gridCells.end();++gcIt)
+		for(int i=0;i<CellTopology::numVertices;++i)
+			++vertexCellOffsets[gcIt->vertices[i]+1];
+	for(size_t i=0;i<numVertices;++i)
+		vertexCellOffsets[i+1]+=vertexCellOffsets[i];
+	
+	/* Collect the cells incident to each grid vertex, and the index of the grid vertex in each cell: */
+	std::vector<std::pair<CellIndex,int> > vertexCells(vertexCellOffsets[numVertices]);
+	std::vector<size_t> vertexCellEnds(vertexCellOffsets.begin(),vertexCellOffsets.end()-1);
+	for(CellIndex ci=0;ci<CellIndex(gridCells.size());++ci)
+		for(int i=0;i<CellTopology::numVertices;++i)
+			{
+			VertexIndex vi=gridCells[ci].vertices[i];
+			vertexCells[vertexCellEnds[vi]]=std::pair<CellIndex,int>(ci,i);
+			++vertexCellEnds[vi];
+			}
+	
+	/* Collect the distinct vertices connected to each grid vertex by a cell edge: */
+	vertexNeighbourOffsets.clear();
+	vertexNeighbourOffsets.reserve(numVertices+1);
+	vertexNeighbours.clear();
+	vertexNeighbours.reserve(vertexCells.size()*dimension/2);
+	std::vector<VertexIndex> marks(numVertices,VertexIndex(numVertices)); // Index of the grid vertex whose neighbours last contained each grid vertex
+	for(VertexIndex vi=0;vi<VertexIndex(numVertices);++vi)
+		{
+		vertexNeighbourOffsets.push_back(vertexNeighbours.size());
+		for(size_t ci=vertexCellOffsets[vi];ci<vertexCellOffsets[vi+1];++ci)
+			{
+			const GridCell& cell=gridCells[vertexCells[ci].first];
+			for(int dim=0;dim<dimension;++dim)
+				{
+				VertexIndex neighbour=cell.vertices[vertexCells[ci].second^(0x1<<dim)];
+				if(marks[neighbour]!=vi)
+					{
+					vertexNeighbours.push_back(neighbour);
+					marks[neighbour]=vi;
+					}
+				}
+			}
+		}
+	vertexNeighbourOffsets.push_back(vertexNeighbours.size());
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+typename SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::GradientMatrix
+SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::calcGradientMatrix(
+	typename SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::VertexIndex vertexIndex) const
+	{
+	/* Gather the least-squares matrix describing the gradient at the grid vertex: */
+	Geometry::Matrix<double,dimension,dimension> a(0.0);
+	const GridVertex& c=gridVertices[vertexIndex];
+	for(size_t ni=vertexNeighbourOffsets[vertexIndex];ni<vertexNeighbourOffsets[vertexIndex+1];++ni)
+		{
+		const GridVertex& n=gridVertices[vertexNeighbours[ni]];
+		Geometry::Vector<double,dimension> d;
+		for(int i=0;i<dimension;++i)
+			d[i]=double(n[i])-double(c[i]);
+		for(int i=0;i<dimension;++i)
+			for(int j=0;j<dimension;++j)
+				a(i,j)+=d[i]*d[j];
+		}
+	
+	/* Invert the matrix one column at a time: */
+	GradientMatrix result(Scalar(0));
+	try
+		{
+		for(int j=0;j<dimension;++j)
+			{
+			Geometry::ComponentArray<double,dimension> e(0.0);
+			e[j]=1.0;
+			Geometry::ComponentArray<double,dimension> column=e/a;
+			for(int i=0;i<dimension;++i)
+				result(i,j)=Scalar(column[i]);
+			}
+		}
+	catch(const std::runtime_error&)
+		{
+		/* Leave the matrix of a degenerate grid vertex zero; its gradient will be zero as well */
+		result=GradientMatrix(Scalar(0));
+		}
+	
+	return result;
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+template <class ScalarExtractorParam>
+inline
+typename SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::Vector
+SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::calcVertexGradient(
+	typename SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::VertexIndex vertexIndex,
+	const ScalarExtractorParam& extractor) const
+	{
+	/* Gather a least-squares system of linear equations describing the gradient at the grid vertex: */
+	bool haveMatrix=!gradientMatrices.empty();
+	Geometry::Matrix<double,dimension,dimension> a(0.0);
+	Geometry::ComponentArray<double,dimension> b(0.0);
+	const GridVertex& c=gridVertices[vertexIndex];
+	double fc=extractor.getValue(vertexIndex);
+	
+	/* Add one linear equation for each vertex connected to the grid vertex by an edge: */
+	for(size_t ni=vertexNeighbourOffsets[vertexIndex];ni<vertexNeighbourOffsets[vertexIndex+1];++ni)
+		{
+		VertexIndex neighbour=vertexNeighbours[ni];
+		const GridVertex& n=gridVertices[neighbour];
+		Geometry::Vector<double,dimension> d;
+		for(int i=0;i<dimension;++i)
+			d[i]=double(n[i])-double(c[i]);
+		double df=double(extractor.getValue(neighbour))-fc;
+		for(int i=0;i<dimension;++i)
+			{
+			if(!haveMatrix)
+				for(int j=0;j<dimension;++j)
+					a(i,j)+=d[i]*d[j];
+			b[i]+=d[i]*df;
+			}
+		}
+	
+	if(haveMatrix)
+		{
+		/* Multiply the right-hand side with the precomputed inverse matrix: */
+		const GradientMatrix& m=gradientMatrices[vertexIndex];
+		Vector result;
+		for(int i=0;i<dimension;++i)
+			{
+			double r=0.0;
+			for(int j=0;j<dimension;++j)
+				r+=double(m(i,j))*b[j];
+			result[i]=Scalar(r);
+			}
+		return result;
+		}
+	else
+		{
+		/* Solve the linear system and return the gradient: */
+		return Vector(b/a);
+		}
+	}
+
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
 inline
 SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::SlicedHypercubic(
@@ -664,13 +694,12 @@ SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::finalizeGrid(
 	firstCell=Cell(this,0);
 	lastCell=Cell(this,numCells);
 	
-	/* Create array containing all cell centers and cell indices: */
-	CellCenter* ccPtr=cellCenterTree.createTree(numCells);
+	/* Create array containing all cell bounding boxes and cell indices: */
+	CellBox* cbPtr=cellBoxTree.createTree(numCells);
 	
 	/* Calculate all cell centers: */
 	Scalar minCellRadius2=Math::Constants<Scalar>::max;
 	double cellRadiusSum=0.0;
-	maxCellRadius2=Scalar(0);
 	for(CellIterator cIt=firstCell;cIt!=lastCell;++cIt)
 		{
 		/* Calculate cell's center point: */
@@ -690,22 +719,69 @@ SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::finalizeGrid(
 		if(minCellRadius2>maxDist2)
 			minCellRadius2=maxDist2;
 		cellRadiusSum+=Math::sqrt(double(maxDist2));
-		if(maxCellRadius2<maxDist2)
-			maxCellRadius2=maxDist2;
 		
-		/* Store cell center and pointer: */
-		*ccPtr=CellCenter(center,cIt->getID());
-		++ccPtr;
+		/* Store cell bounding box and ID: */
+		cbPtr->box=Box::empty;
+		for(int i=0;i<CellTopology::numVertices;++i)
+			cbPtr->box.addPoint(cIt->getVertexPosition(i));
+		cbPtr->cellID=cIt->getID();
+		++cbPtr;
 		}
 	
-	/* Create the cell center tree: */
-	cellCenterTree.releasePoints(4); // Let's just go ahead and use the multithreaded version
+	/* Create the cell box hierarchy: */
+	cellBoxTree.releaseBoxes(4); // Let's just go ahead and use the multithreaded version
 	
 	/* Calculate the average cell radius: */
 	avgCellRadius=Scalar(cellRadiusSum/double(numCells));
 	
 	/* Calculate the initial locator epsilon based on the minimal cell size: */
 	locatorEpsilon=Math::sqrt(minCellRadius2)*Scalar(1.0e-4);
+	
+	/* Create the grid vertex adjacency used for gradient calculation, and invalidate any precomputed gradient matrices: */
+	calcVertexNeighbours();
+	gradientMatrices.clear();
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+void
+SlicedHypercubic<ScalarParam,dimensionParam,ValueScalarParam>::calcGradientMatrices(
+	unsigned int numThreads)
+	{
+	VertexIndex numVertices=gridVertices.size();
+	gradientMatrices.resize(numVertices);
+	
+	/* Split the grid vertex list into contiguous chunks: */
+	size_t numChunks=numThreads>0?numThreads:1;
+	if(numChunks>size_t(numVertices))
+		numChunks=numVertices>0?numVertices:1;
+	std::vector<GradientMatrixChunk> chunks(numChunks);
+	for(size_t chunk=0;chunk<numChunks;++chunk)
+		{
+		chunks[chunk].ds=this;
+		chunks[chunk].begin=VertexIndex((size_t(numVertices)*chunk)/numChunks);
+		chunks[chunk].end=VertexIndex((size_t(numVertices)*(chunk+1))/numChunks);
+		}
+	
+	/* Calculate the gradient matrices of all chunks but the first on their own threads: */
+	Threads::Thread* threads=0;
+	if(numChunks>1)
+		{
+		threads=new Threads::Thread[numChunks-1];
+		for(size_t i=1;i<numChunks;++i)
+			threads[i-1].start(&chunks[i],&GradientMatrixChunk::calcGradientMatrices);
+		}
+	
+	/* Calculate the first chunk's gradient matrices on the calling thread: */
+	chunks[0].calcGradientMatrices();
+	
+	/* Wait for all other chunks: */
+	if(threads!=0)
+		{
+		for(size_t i=1;i<numChunks;++i)
+			threads[i-1].join();
+		delete[] threads;
+		}
 	}
 
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SLICEDHYPERCUBIC_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SLICEDHYPERCUBIC_INCLUDED
 
+#include <stddef.h>
 #include <utility>
 #include <vector>
 #include <Misc/UnorderedTuple.h>
@@ -31,14 +32,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/ComponentArray.h>
 #include <Geometry/Point.h>
 #include <Geometry/Vector.h>
+#include <Geometry/Matrix.h>
 #include <Geometry/Box.h>
-#include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/SlicedDataValue.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/CellBoxTree.h>
+#include <Templatized/LocatorBatch.h>
 
 namespace Visualization {
 
@@ -90,6 +92,19 @@ class SlicedHypercubic
 	typedef std::vector<GridCell> GridCellList; // Type to store the list of grid cells
 	typedef Misc::UnorderedTuple<VertexIndex,CellTopology::numFaceVertices> GridFace; // Type to identify faces of grid cells
 	typedef Misc::HashTable<GridFace,std::pair<CellIndex,int>,GridFace> GridFaceHasher; // Data type from grid faces to grid cell and cell face indices; used during data set construction
+	typedef Geometry::Matrix<Scalar,dimensionParam,dimensionParam> GradientMatrix; // Type for inverted least-squares matrices to calculate vertex gradients
+	
+	struct GradientMatrixChunk // Structure for contiguous ranges of grid vertices whose gradient matrices are calculated by a single thread
+		{
+		/* Elements: */
+		public:
+		SlicedHypercubic* ds; // Pointer to the data set
+		VertexIndex begin; // Index of the first grid vertex in the chunk
+		VertexIndex end; // Index behind the last grid vertex in the chunk
+		
+		/* Methods: */
+		void* calcGradientMatrices(void); // Calculates the gradient matrices of all grid vertices in the chunk
+		};
 	
 	/* Data set interface classes: */
 	public:
@@ -240,6 +255,7 @@ class SlicedHypercubic
 	class Locator:private Cell // Class responsible for evaluating a data set at a given position
 		{
 		friend class SlicedHypercubic;
+		friend class CellBoxTree<Scalar,dimensionParam,CellID>;
 		
 		/* Embedded classes: */
 		private:
@@ -252,9 +268,14 @@ class SlicedHypercubic
 		CellPosition cellPos; // Local coordinates of last located point inside its cell
 		Scalar epsilon,epsilon2; // Accuracy threshold of point location algorithm
 		bool cantTrace; // Flag if the locator cannot trace from the current state
+		#ifdef PERF_COUNTLOCATORSTEPS
+		LocatorStepCounters stepCounters; // Counts of the work done by this locator
+		#endif
 		
 		/* Private methods: */
 		bool newtonRaphsonStep(const Point& position); // Performs one Newton-Raphson step while tracing the given position
+		void startCell(const CellID& cellID); // Moves the locator to the center of the given cell to start a search
+		bool moveToNeighbour(Scalar& maxMove); // Moves the locator into the neighbouring cell in the direction in which the last located point is farthest outside the current cell; stores that distance in maxMove and returns false if there is no such neighbour
 		
 		/* Constructors and destructors: */
 		public:
@@ -265,6 +286,12 @@ class SlicedHypercubic
 		/* Methods: */
 		public:
 		void setEpsilon(Scalar newEpsilon); // Sets a new accuracy threshold in local cell dimension
+		#ifdef PERF_COUNTLOCATORSTEPS
+		const LocatorStepCounters& getStepCounters(void) const // Returns the counts of the work done by this locator
+			{
+			return stepCounters;
+			}
+		#endif
 		CellID getCellID(void) const // Returns the ID of the cell containing the last located point
 			{
 			return Cell::getID();
@@ -274,11 +301,26 @@ class SlicedHypercubic
 		typename ValueExtractorParam::DestValue calcValue(const ValueExtractorParam& extractor) const; // Calculates value at last located position
 		template <class ScalarExtractorParam>
 		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position
+		template <class ValueExtractorParam>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam& extractor,typename ValueExtractorParam::DestValue values[],bool valids[]) // Locates the given positions in order and calculates their values based on given value extractor; traces first position from last located position if traceHint is true; returns number of positions inside the data set
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor,values,valids);
+			}
+		template <class ValueExtractorParam1,class ValueExtractorParam2>
+		size_t calcValues(size_t numPoints,const Point positions[],bool traceHint,const ValueExtractorParam1& extractor1,typename ValueExtractorParam1::DestValue values1[],const ValueExtractorParam2& extractor2,typename ValueExtractorParam2::DestValue values2[],bool valids[]) // Ditto; calculates the values of two value extractors from a single point location per position
+			{
+			return batchCalcValues(*this,numPoints,positions,traceHint,extractor1,values1,extractor2,values2,valids);
+			}
+		template <class ScalarExtractorParam>
+		size_t calcValuesAndGradients(size_t numPoints,const Point positions[],bool traceHint,const ScalarExtractorParam& extractor,typename ScalarExtractorParam::DestValue values[],Vector gradients[],bool valids[]) // Ditto; additionally calculates gradients based on given scalar extractor
+			{
+			return batchCalcValuesAndGradients(*this,numPoints,positions,traceHint,extractor,values,gradients,valids);
+			}
 		};
 	
 	private:
-	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	typedef CellBoxTree<Scalar,dimension,CellID> BoxTree; // Data type for bounding volume hierarchies to locate cells containing a point
+	typedef typename BoxTree::CellBox CellBox; // Data type to associate a cell's bounding box and its ID
 	
 	friend class Vertex;
 	friend class Cell;
@@ -291,17 +333,23 @@ class SlicedHypercubic
 	int numSlices; // Number of scalar value slices in data set
 	size_t allocatedSliceSize; // Allocated size of all slice arrays
 	ValueScalar** slices; // Array of 1D arrays defining data set's value slices
-	CellCenterTree cellCenterTree; // Kd-tree containing cell centers
+	BoxTree cellBoxTree; // Bounding volume hierarchy containing cell bounding boxes
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
 	Scalar avgCellRadius; // Average "radius" of all cells
-	Scalar maxCellRadius2; // Squared maximum "radius" of any cell (used as trivial reject threshold during point location)
 	Scalar locatorEpsilon; // Default accuracy threshold for locators working on this data set
 	GridFaceHasher* gridFaces; // Pointer to grid face hasher used during data set construction to connect grid cells
+	std::vector<size_t> vertexNeighbourOffsets; // Index of each grid vertex' first neighbour in the neighbour array, followed by the total number of neighbours
+	std::vector<VertexIndex> vertexNeighbours; // Indices of grid vertices sharing a cell edge with each grid vertex, in compressed sparse row order
+	std::vector<GradientMatrix> gradientMatrices; // Inverted least-squares gradient matrices of all grid vertices; empty if not precomputed
 	
 	/* Private methods: */
 	void resizeSlices(size_t newAllocatedSize); // Resizes all existing value slices
+	void calcVertexNeighbours(void); // Creates the compressed sparse row adjacency of all grid vertices
+	GradientMatrix calcGradientMatrix(VertexIndex vertexIndex) const; // Returns the inverted least-squares gradient matrix of the given grid vertex
+	template <class ScalarExtractorParam>
+	Vector calcVertexGradient(VertexIndex vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at the given grid vertex, based on given scalar extractor
 	
 	/* Constructors and destructors: */
 	public:
@@ -342,6 +390,7 @@ class SlicedHypercubic
 		}
 	void setVertexValue(int sliceIndex,VertexIndex vertexIndex,ValueScalar newValue); // Sets the given vertex' value in the given slice
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
+	void calcGradientMatrices(unsigned int numThreads); // Precomputes the least-squares gradient matrices of all grid vertices on the given number of threads to turn gradient calculation into a table lookup; must be called after finalizeGrid
 	Scalar getLocatorEpsilon(void) const // Returns the current default accuracy threshold for locators working on this data set
 		{
 		return locatorEpsilon;
@@ -393,6 +442,10 @@ class SlicedHypercubic
 		{
 		return Locator(this,locatorEpsilon);
 		}
+	size_t getLocatorMemorySize(void) const // Returns the approximate memory size of the data set's point location structures in bytes
+		{
+		return cellBoxTree.getMemorySize();
+		}
 	};
 
 }
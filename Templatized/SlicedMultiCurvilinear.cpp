@@ -30,7 +30,6 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Matrix.h>
 
 #include <Templatized/LinearInterpolator.h>
-#include <Templatized/FindClosestPointFunctor.h>
 
 #include <Templatized/SlicedMultiCurvilinear.h>
 
@@ -312,171 +311,93 @@ SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::se
 	epsilon2=Math::sqr(epsilon);
 	}
 
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+void
+SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::startCell(
+	const typename SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::CellID& cellID)
+	{
+	Cell::operator=(ds->getCell(cellID));
+	for(int i=0;i<dimension;++i)
+		cellPos[i]=Scalar(0.5);
+	}
+
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
 inline
 bool
-SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::locatePoint(
-	const typename SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Point& position,
-	bool traceHint)
+SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::moveToNeighbour(
+	typename SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Scalar& maxMove)
 	{
-	/* If traceHint parameter is false or locator can't trace, start searching from scratch: */
-	if(!traceHint||cantTrace)
-		{
-		/* Start searching from cell whose cell center is closest to query position: */
-		FindClosestPointFunctor<CellCenter> f(position,ds->maxCellRadius2);
-		ds->cellCenterTree.traverseTreeDirected(f);
-		if(f.getClosestPoint()==0) // Bail out if no cell is close enough
-			return false;
-		
-		/* Go to the found cell: */
-		Cell::operator=(ds->getCell(f.getClosestPoint()->value));
-		
-		/* Initialize local cell position: */
-		for(int i=0;i<dimension;++i)
-			cellPos[i]=Scalar(0.5);
-		
-		/* Now we can trace: */
-		cantTrace=false;
-		}
-	
-	/* Perform Newton-Raphson iteration until it converges and the current cell contains the query point: */
-	Scalar maxOut;
-	CellID previousCellID; // Cell ID to detect "thrashing" between cells
-	CellID currentCellID=getCellID(); // Ditto
-	Scalar previousMaxMove=Scalar(0); // Reason we went into the current cell
-	int iteration=0;
-	for(iteration=0;iteration<10;++iteration)
+	/* Find the direction in which the last located point is farthest outside the current cell: */
+	maxMove=Scalar(0);
+	int moveDim=0;
+	int moveDir=0;
+	CellID moveCellID; // Cleverly keep track of this ID to reduce work later!
+	for(int i=0;i<dimension;++i)
 		{
-		/* Perform Newton-Raphson iteration in the current cell until it converges, or goes really bad: */
-		while(true)
+		if(maxMove<-cellPos[i])
 			{
-			/* Do one step: */
-			bool converged=newtonRaphsonStep(position);
-			
-			/* Check for signs of convergence failure: */
-			maxOut=Scalar(0);
-			for(int i=0;i<dimension;++i)
+			/* Check if we can actually move in this direction: */
+			moveCellID=CellID();
+			if(index[i]>0||(moveCellID=ds->retrieveGridConnector(*this,i*2+0)).isValid())
 				{
-				if(maxOut<-cellPos[i])
-					maxOut=-cellPos[i];
-				else if(maxOut<cellPos[i]-Scalar(1))
-					maxOut=cellPos[i]-Scalar(1);
+				maxMove=-cellPos[i];
+				moveDim=i;
+				moveDir=-1;
 				}
-			if(converged||maxOut>Scalar(1)) // Tolerate at most one cell size out (this is somewhat ad-hoc)
-				break;
 			}
-		
-		/* Check if the current cell contains the query position: */
-		if(maxOut==Scalar(0))
-			return true;
-		
-		/* Check if this was the first step, and we're way off: */
-		if(iteration==0&&maxOut>Scalar(5))
+		else if(maxMove<cellPos[i]-Scalar(1))
 			{
-			/* We had a tracing failure; just start searching from scratch: */
-			FindClosestPointFunctor<CellCenter> f(position,ds->maxCellRadius2);
-			ds->cellCenterTree.traverseTreeDirected(f);
-			if(f.getClosestPoint()==0) // Bail out if no cell is close enough
+			/* Check if we can actually move in this direction: */
+			moveCellID=CellID();
+			if(index[i]<ds->grids[gridIndex].numCells[i]-1||(moveCellID=ds->retrieveGridConnector(*this,i*2+1)).isValid())
 				{
-				/* At this point, the locator is borked. Better not trace next time: */
-				cantTrace=true;
-				
-				/* And we're outside the grid, too: */
-				return false;
-				}
-			
-			/* Go to the found cell: */
-			Cell::operator=(ds->getCell(f.getClosestPoint()->value));
-			previousCellID=currentCellID;
-			currentCellID=f.getClosestPoint()->value;
-			previousMaxMove=maxOut;
-			
-			/* Initialize the local cell position: */
-			for(int i=0;i<dimension;++i)
-				cellPos[i]=Scalar(0.5);
-			
-			/* Start over: */
-			continue;
-			}
-		
-		/* Otherwise, try moving to a different cell: */
-		Scalar maxMove=Scalar(0);
-		int moveDim=0;
-		int moveDir=0;
-		CellID moveCellID; // Cleverly keep track of this ID to reduce work later!
-		for(int i=0;i<dimension;++i)
-			{
-			if(maxMove<-cellPos[i])
-				{
-				/* Check if we can actually move in this direction: */
-				moveCellID=CellID();
-				if(index[i]>0||(moveCellID=ds->retrieveGridConnector(*this,i*2+0)).isValid())
-					{
-					maxMove=-cellPos[i];
-					moveDim=i;
-					moveDir=-1;
-					}
-				}
-			else if(maxMove<cellPos[i]-Scalar(1))
-				{
-				/* Check if we can actually move in this direction: */
-				moveCellID=CellID();
-				if(index[i]<ds->grids[gridIndex].numCells[i]-1||(moveCellID=ds->retrieveGridConnector(*this,i*2+1)).isValid())
-					{
-					maxMove=cellPos[i]-Scalar(1);
-					moveDim=i;
-					moveDir=1;
-					}
+				maxMove=cellPos[i]-Scalar(1);
+				moveDim=i;
+				moveDir=1;
 				}
 			}
-		
-		/* If we can move somewhere, do it: */
-		if(moveCellID.isValid())
-			{
-			/* Move to another grid: */
-			Cell::operator=(ds->getCell(moveCellID));
-			for(int i=0;i<dimension;++i)
-				cellPos[i]=Scalar(0.5);
-			}
-		else if(moveDir==-1)
-			{
-			/* Move in the same grid: */
-			cellPos[moveDim]+=Scalar(1);
-			--index[moveDim];
-			baseVertexIndex-=ds->grids[gridIndex].vertexStrides[moveDim];
-			}
-		else if(moveDir==1)
-			{
-			/* Move in the same grid: */
-			cellPos[moveDim]-=Scalar(1);
-			++index[moveDim];
-			baseVertexIndex+=ds->grids[gridIndex].vertexStrides[moveDim];
-			}
-		else
-			{
-			/* At this point, the locator is borked. Better not trace next time: */
-			cantTrace=true;
-			
-			/* We're not in the current cell, and can't move anywhere else -- we're outside the grid: */
-			return false;
-			}
-		
-		/* Check if we've just moved back into the cell we just came from: */
-		CellID nextCellID=getCellID();
-		if(nextCellID==previousCellID&&maxMove<=previousMaxMove)
-			return true;
-		
-		/* Check for thrashing on the next iteration step: */
-		previousCellID=currentCellID;
-		currentCellID=nextCellID;
-		previousMaxMove=maxMove;
 		}
 	
-	/* Just to be safe, don't trace on the next step: */
-	cantTrace=true;
+	/* If we can move somewhere, do it: */
+	if(moveCellID.isValid())
+		{
+		/* Move to another grid: */
+		Cell::operator=(ds->getCell(moveCellID));
+		for(int i=0;i<dimension;++i)
+			cellPos[i]=Scalar(0.5);
+		}
+	else if(moveDir==-1)
+		{
+		/* Move in the same grid: */
+		cellPos[moveDim]+=Scalar(1);
+		--index[moveDim];
+		baseVertexIndex-=ds->grids[gridIndex].vertexStrides[moveDim];
+		}
+	else if(moveDir==1)
+		{
+		/* Move in the same grid: */
+		cellPos[moveDim]-=Scalar(1);
+		++index[moveDim];
+		baseVertexIndex+=ds->grids[gridIndex].vertexStrides[moveDim];
+		}
+	else
+		{
+		/* We're not in the current cell, and can't move anywhere else -- we're outside the grid: */
+		return false;
+		}
 	
-	/* Return true if the final cell contains the query position, with some fudge: */
-	return maxOut<Scalar(1.0e-4);
+	return true;
+	}
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+inline
+bool
+SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Locator::locatePoint(
+	const typename SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Point& position,
+	bool traceHint)
+	{
+	return ds->cellBoxTree.locatePoint(*this,position,traceHint);
 	}
 
 template <class ScalarParam,int dimensionParam,class ValueScalarParam>
@@ -668,7 +589,7 @@ SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::retrieveGri
 		{
 		const Grid& grid=grids[cell.gridIndex];
 		int faceDimension=faceIndex>>1;
-
+		
 		/* Retrieve the other cell's ID: */
 		int gcIndex=0;
 		for(int i=0;i<dimension;++i)
@@ -926,14 +847,13 @@ SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::finalizeGri
 			domainBox.addPoint(*vPtr);
 		}
 	
-	/* Create array containing all cell centers and cell indices: */
-	CellCenter* ccPtr=cellCenterTree.createTree(totalNumCells);
+	/* Create array containing all cell bounding boxes and cell indices: */
+	CellBox* cbPtr=cellBoxTree.createTree(totalNumCells);
 	
 	/* Calculate all cell centers: */
 	Scalar minCellRadius2(Math::Constants<Scalar>::max);
 	double cellRadiusSum=0.0;
-	maxCellRadius2=Scalar(0);
-	for(CellIterator cIt=beginCells();cIt!=endCells();++cIt,++ccPtr)
+	for(CellIterator cIt=beginCells();cIt!=endCells();++cIt,++cbPtr)
 		{
 		/* Calculate cell's center point: */
 		typename Point::AffineCombiner cc;
@@ -952,15 +872,16 @@ SlicedMultiCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::finalizeGri
 		if(minCellRadius2>maxDist2)
 			minCellRadius2=maxDist2;
 		cellRadiusSum+=Math::sqrt(double(maxDist2));
-		if(maxCellRadius2<maxDist2)
-			maxCellRadius2=maxDist2;
 		
-		/* Store cell center and pointer: */
-		*ccPtr=CellCenter(center,cIt->getID());
+		/* Store cell bounding box and ID: */
+		cbPtr->box=Box::empty;
+		for(int i=0;i<CellTopology::numVertices;++i)
+			cbPtr->box.addPoint(cIt->getVertexPosition(i));
+		cbPtr->cellID=cIt->getID();
 		}
 	
-	/* Create the cell center tree: */
-	cellCenterTree.releasePoints(4); // Let's just go ahead and use the multithreaded version
+	/* Create the cell box hierarchy: */
+	cellBoxTree.releaseBoxes(4); // Let's just go ahead and use the multithreaded version
 	
 	/* Calculate the average cell radius: */
 	avgCellRadius=Scalar(cellRadiusSum/double(totalNumCells));
@@ -1,7 +1,7 @@
 /***********************************************************************
 StreamsurfaceExtractor - Class to extract stream surfaces from data
 sets.
-Copyright (c) 2006-2007 Oliver Kreylos
+Copyright (c) 2006-2009 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -22,6 +22,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_TEMPLATIZED_STREAMSURFACEEXTRACTOR_IMPLEMENTATION
 
+#include <Math/Math.h>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+
 #include <Templatized/StreamsurfaceExtractor.h>
 
 namespace Visualization {
@@ -35,47 +39,60 @@ Methods of class StreamsurfaceExtractor:
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
 inline
 bool
-StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::stepStreamline(
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::locateStreamline(
 	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamline& s)
 	{
-	/* Calculate the vector and the auxiliary scalar value at the locator's current position: */
-	s.pos0=s.pos1;
-	if(!s.locator.locatePoint(s.pos0,true))
+	/* Locate the streamline's current position: */
+	if(!s.locator.locatePoint(s.pos,true))
 		return false;
-	s.vec0=Vector(s.locator.calcValue(vectorExtractor));
-	s.scalar0=s.locator.calcValue(scalarExtractor);
 	
+	/* Calculate the vector and the auxiliary scalar value at the current position: */
+	s.vec=Vector(s.locator.calcValue(vectorExtractor));
+	s.scalar=s.locator.calcValue(scalarExtractor);
+	
+	return true;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+bool
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::stepStreamline(
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamline& s)
+	{
 	/****************************************************************
 	Integrate the streamline using a fourth-order Runge-Kutta method:
 	****************************************************************/
 	
 	/* Calculate the first half-step vector: */
-	Vector v0=s.vec0*(stepSize*Scalar(0.5));
+	Vector v0=s.vec*(stepSize*Scalar(0.5));
 	
 	/* Move to the second evaluation point: */
-	Point p1=s.pos0;
+	Point p1=s.pos;
 	p1+=v0;
 	
 	/* Calculate the second half-step vector: */
-	s.locator.locatePoint(p1,true);
+	if(!s.locator.locatePoint(p1,true))
+		return false;
 	Vector v1=Vector(s.locator.calcValue(vectorExtractor));
 	v1*=stepSize*Scalar(0.5);
 	
 	/* Move to the third evaluation point: */
-	Point p2=s.pos0;
+	Point p2=s.pos;
 	p2+=v1;
 	
 	/* Calculate the third half-step vector: */
-	s.locator.locatePoint(p2,true);
+	if(!s.locator.locatePoint(p2,true))
+		return false;
 	Vector v2=Vector(s.locator.calcValue(vectorExtractor));
 	v2*=stepSize;
 	
 	/* Move to the fourth evaluation point: */
-	Point p3=s.pos0;
+	Point p3=s.pos;
 	p3+=v2;
 	
 	/* Calculate the fourth half-step vector: */
-	s.locator.locatePoint(p3,true);
+	if(!s.locator.locatePoint(p3,true))
+		return false;
 	Vector v3=Vector(s.locator.calcValue(vectorExtractor));
 	v3*=stepSize;
 	
@@ -88,93 +105,379 @@ StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,St
 	v3/=Scalar(6);
 	
 	/* Go to the next streamline vertex: */
-	s.pos1+=v3;
+	s.pos+=v3;
 	
-	return true;
+	return locateStreamline(s);
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
 inline
-bool
-StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::stepStreamsurface(
-	void)
+typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamline*
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::getLayerPred(
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamline* s) const
 	{
-	/* Advance all streamlines: */
-	Streamline* s=streamlineHead;
-	do
+	/* Skip a predecessor that is removed in the current layer: */
+	Streamline* p=s->pred;
+	if(!p->connectSucc)
+		return 0;
+	if(p->remove)
 		{
-		/* Advance the streamline: */
-		stepStreamline(s);
+		p=p->pred;
+		if(!p->connectSucc)
+			return 0;
 		}
-	while(s!=streamlineHead);
-	
-	
-	
-	
-	
-	
 	
+	return p->valid?p:0;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamline*
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::getLayerSucc(
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamline* s) const
+	{
+	/* Skip a successor that is removed in the current layer: */
+	if(!s->connectSucc)
+		return 0;
+	Streamline* n=s->succ;
+	if(n->remove)
+		{
+		if(!n->connectSucc)
+			return 0;
+		n=n->succ;
+		}
 	
+	return n->valid?n:0;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::addLayerVertex(
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamline& s)
+	{
+	/* Calculate the front tangent from the streamline's neighbours in the new layer: */
+	Streamline* p=getLayerPred(&s);
+	Streamline* n=getLayerSucc(&s);
+	Vector tangent=(n!=0?n->pos:s.pos)-(p!=0?p->pos:s.pos);
+	if(n!=0)
+		{
+		/* Update the front spacing metric: */
+		Scalar spacing=Geometry::dist(s.pos,n->pos);
+		if(maxFrontSpacing<spacing)
+			maxFrontSpacing=spacing;
+		}
 	
+	/* Calculate the surface normal: */
+	Vector normal=Geometry::cross(tangent,s.vec);
+	Scalar normalMag=Geometry::mag(normal);
+	if(normalMag>Scalar(0))
+		normal/=normalMag;
 	
+	/* Store the streamline's vertex: */
+	Vertex* vPtr=streamsurface->getNextVertex();
+	vPtr->texCoord[0]=s.scalar;
+	vPtr->normal=typename Vertex::Normal(normal.getComponents());
+	vPtr->position=typename Vertex::Position(s.pos.getComponents());
+	s.newIndex=streamsurface->addVertex();
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::addTriangle(
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Index i0,
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Index i1,
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Index i2)
+	{
+	Index* tPtr=streamsurface->getNextTriangle();
+	tPtr[0]=i0;
+	tPtr[1]=i1;
+	tPtr[2]=i2;
+	streamsurface->addTriangle();
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::adaptFront(
+	void)
+	{
+	if(seedSpacing==Scalar(0))
+		return;
+	Scalar minDist2=Math::sqr(minSpacingFactor*seedSpacing);
+	Scalar maxDist2=Math::sqr(maxSpacingFactor*seedSpacing);
 	
+	/* Mark streamlines between converging neighbours for removal; never remove two neighbouring streamlines in the same layer: */
+	unsigned int numRemaining=numFrontStreamlines;
+	Streamline* s=frontHead;
+	do
+		{
+		Streamline* p=s->pred;
+		Streamline* n=s->succ;
+		if(numRemaining>3&&p->connectSucc&&s->connectSucc&&p!=n&&!p->remove&&!n->remove
+		   &&Geometry::sqrDist(p->pos,s->pos)<minDist2&&Geometry::sqrDist(s->pos,n->pos)<minDist2)
+			{
+			s->remove=true;
+			--numRemaining;
+			++numRemovals;
+			}
+		s=n;
+		}
+	while(s!=frontHead);
 	
-	if(allValid)
+	/* Insert streamlines between diverging neighbours, as long as the front budget allows: */
+	s=frontHead;
+	do
 		{
-		/* Store the new layer of streamline vertices in the stream surface: */
-		Vertex* vPtr0=streamsurface->getNextVertex();
-		vPtr0->texCoord[0]=scalars[0];
-		Vector normal0;
-		if(closed)
-			normal0=Geometry::cross(positions[1]-positions[numStreamlines-1],tangents[0]);
-		else
-			normal0=Geometry::cross(positions[1]-positions[0],tangents[0]);
-		normal0.normalize();
-		vPtr0->normal=typename Vertex::Normal(normal0.getComponents());
-		vPtr0->position=typename Vertex::Position(positions[0].getComponents());
-		streamsurface->addVertex();
-		for(int index=1;index<numStreamlines-1;++index)
+		Streamline* n=s->succ;
+		if(numFrontStreamlines<maxNumFrontStreamlines&&s->connectSucc&&!s->remove&&!n->remove
+		   &&Geometry::sqrDist(s->pos,n->pos)>maxDist2)
 			{
-			Vertex* vPtr=streamsurface->getNextVertex();
-			vPtr->texCoord[0]=scalars[index];
-			Vector normal=Geometry::cross(positions[index+1]-positions[index-1],tangents[index]);
-			normal.normalize();
-			vPtr->normal=typename Vertex::Normal(normal.getComponents());
-			vPtr->position=typename Vertex::Position(positions[index].getComponents());
-			streamsurface->addVertex();
+			/* Create a new streamline at the midpoint of the front segment: */
+			Streamline* m=new Streamline;
+			m->pos=Geometry::mid(s->pos,n->pos);
+			m->locator=s->locator;
+			if(locateStreamline(*m))
+				{
+				/* Link the new streamline into the front: */
+				m->index=invalidIndex;
+				m->pred=s;
+				m->succ=n;
+				m->connectSucc=true;
+				m->valid=true;
+				m->remove=false;
+				s->succ=m;
+				n->pred=m;
+				++numFrontStreamlines;
+				++numInsertions;
+				}
+			else
+				delete m;
 			}
-		Vertex* vPtrn=streamsurface->getNextVertex();
-		vPtrn->texCoord[0]=scalars[numStreamlines-1];
-		Vector normaln;
-		if(closed)
-			normaln=Geometry::cross(positions[0]-positions[numStreamlines-2],tangents[numStreamlines-1]);
-		else
-			normaln=Geometry::cross(positions[numStreamlines-1]-positions[numStreamlines-2],tangents[numStreamlines-1]);
-		normaln.normalize();
-		vPtrn->normal=typename Vertex::Normal(normaln.getComponents());
-		vPtrn->position=typename Vertex::Position(positions[numStreamlines-1].getComponents());
-		streamsurface->addVertex();
-		
-		if(layerIndex>0)
+		s=n;
+		}
+	while(s!=frontHead);
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::stitchLayer(
+	void)
+	{
+	/*********************************************************************
+	Create the triangles covering each connected front segment between the
+	previous layer and the new layer. Inserted streamlines only have
+	vertices in the new layer; removed streamlines only have vertices in
+	the previous layer.
+	*********************************************************************/
+	
+	Streamline* s=frontHead;
+	do
+		{
+		Streamline* n=s->succ;
+		if(s->connectSucc)
 			{
-			/* Create indices for the triangle strips connecting the current streamlines positions to the previous ones: */
-			int layer0=(layerIndex-1)*numStreamlines;
-			int layer1=layerIndex*numStreamlines;
-			for(int i=0;i<numStreamlines;++i)
+			if(s->remove)
+				{
+				/* Close the fan around the removed streamline's last vertex: */
+				Streamline* p=s->pred;
+				if(p->valid&&n->valid)
+					addTriangle(s->index,n->newIndex,p->newIndex);
+				if(n->valid)
+					addTriangle(s->index,n->index,n->newIndex);
+				}
+			else if(n->remove)
+				{
+				/* Open the fan around the removed successor's last vertex: */
+				if(s->valid)
+					addTriangle(s->index,n->index,s->newIndex);
+				}
+			else if(n->index==invalidIndex)
+				{
+				/* Connect to the inserted successor's first vertex: */
+				if(s->valid&&n->valid)
+					addTriangle(s->index,n->newIndex,s->newIndex);
+				}
+			else if(s->index==invalidIndex)
 				{
-				streamsurface->addIndex(layer1+i);
-				streamsurface->addIndex(layer0+i);
+				/* Cover the previous layer's segment spanned by the inserted streamline: */
+				Streamline* p=s->pred;
+				if(s->valid)
+					{
+					addTriangle(p->index,n->index,s->newIndex);
+					if(n->valid)
+						addTriangle(n->index,n->newIndex,s->newIndex);
+					}
 				}
-			if(closed)
+			else if(s->valid&&n->valid)
 				{
-				streamsurface->addIndex(layer1);
-				streamsurface->addIndex(layer0);
+				/* Split the quadrilateral between the two layers: */
+				addTriangle(s->index,n->index,n->newIndex);
+				addTriangle(s->index,n->newIndex,s->newIndex);
 				}
-			streamsurface->addStrip();
+			else if(n->valid)
+				addTriangle(s->index,n->index,n->newIndex);
+			else if(s->valid)
+				addTriangle(s->index,n->index,s->newIndex);
 			}
+		s=n;
 		}
+	while(s!=frontHead);
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::cleanFront(
+	void)
+	{
+	Streamline* survivor=0;
+	unsigned int numStreamlinesToCheck=numFrontStreamlines;
+	Streamline* s=frontHead;
+	for(unsigned int i=0;i<numStreamlinesToCheck;++i)
+		{
+		Streamline* next=s->succ;
+		if(s->remove||!s->valid)
+			{
+			/* Unlink the streamline; a dead streamline disconnects its neighbours: */
+			Streamline* p=s->pred;
+			p->succ=s->succ;
+			s->succ->pred=p;
+			p->connectSucc=s->remove?s->connectSucc:false;
+			delete s;
+			--numFrontStreamlines;
+			}
+		else
+			{
+			/* Promote the streamline's vertex in the new layer: */
+			s->index=s->newIndex;
+			survivor=s;
+			}
+		s=next;
+		}
+	frontHead=survivor;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::deleteFront(
+	void)
+	{
+	for(unsigned int i=0;i<numFrontStreamlines;++i)
+		{
+		Streamline* next=frontHead->succ;
+		delete frontHead;
+		frontHead=next;
+		}
+	frontHead=0;
+	numFrontStreamlines=0;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::startFront(
+	void)
+	{
+	/* Reset the extraction state: */
+	deleteFront();
+	numLayers=0;
+	numInsertions=0;
+	numRemovals=0;
+	seedSpacing=Scalar(0);
+	maxFrontSpacing=Scalar(0);
+	if(numStreamlines==0)
+		return;
+	
+	/* Create the initial front: */
+	Streamline* tail=0;
+	for(unsigned int i=0;i<numStreamlines;++i)
+		{
+		Streamline* s=new Streamline;
+		s->pos=seedPoints[i];
+		s->locator=seedLocators[i];
+		s->index=invalidIndex;
+		s->connectSucc=true;
+		s->valid=locateStreamline(*s);
+		s->remove=false;
+		if(tail!=0)
+			{
+			s->pred=tail;
+			tail->succ=s;
+			}
+		else
+			frontHead=s;
+		tail=s;
+		++numFrontStreamlines;
+		}
+	tail->succ=frontHead;
+	frontHead->pred=tail;
+	tail->connectSucc=closed&&numStreamlines>1;
 	
-	return allValid;
+	/* Calculate the seed spacing as the average distance between connected seed streamlines: */
+	Scalar spacingSum=Scalar(0);
+	unsigned int numSegments=0;
+	Streamline* s=frontHead;
+	do
+		{
+		if(s->connectSucc&&s->valid&&s->succ->valid)
+			{
+			spacingSum+=Geometry::dist(s->pos,s->succ->pos);
+			++numSegments;
+			}
+		s=s->succ;
+		}
+	while(s!=frontHead);
+	if(numSegments>0)
+		seedSpacing=spacingSum/Scalar(numSegments);
+	
+	/* Create the first surface layer: */
+	do
+		{
+		if(s->valid)
+			addLayerVertex(*s);
+		s=s->succ;
+		}
+	while(s!=frontHead);
+	cleanFront();
+	numLayers=1;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+bool
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::stepStreamsurface(
+	void)
+	{
+	/* Refine and coarsen the front based on the current streamline spacing: */
+	adaptFront();
+	
+	/* Advance all streamlines remaining on the front: */
+	Streamline* s=frontHead;
+	do
+		{
+		if(!s->remove)
+			s->valid=stepStreamline(*s);
+		s=s->succ;
+		}
+	while(s!=frontHead);
+	
+	/* Create the new surface layer: */
+	do
+		{
+		if(!s->remove&&s->valid)
+			addLayerVertex(*s);
+		s=s->succ;
+		}
+	while(s!=frontHead);
+	stitchLayer();
+	cleanFront();
+	++numLayers;
+	
+	return frontHead!=0;
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
@@ -186,9 +489,15 @@ StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,St
 	:dataSet(sDataSet),
 	 vectorExtractor(sVectorExtractor),scalarExtractor(sScalarExtractor),
 	 stepSize(0.1),
+	 maxSpacingFactor(2),minSpacingFactor(0.5),
+	 maxNumFrontStreamlines(1024),
+	 closed(false),
 	 numStreamlines(0),
-	 p0s(0),locators(0),positions(0),tangents(0),scalars(0),
-	 streamsurface(0)
+	 streamsurface(0),
+	 frontHead(0),numFrontStreamlines(0),
+	 seedSpacing(0),
+	 numLayers(0),numInsertions(0),numRemovals(0),
+	 maxFrontSpacing(0)
 	{
 	}
 
@@ -197,11 +506,7 @@ inline
 StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::~StreamsurfaceExtractor(
 	void)
 	{
-	delete[] p0s;
-	delete[] locators;
-	delete[] positions;
-	delete[] tangents;
-	delete[] scalars;
+	deleteFront();
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
@@ -213,44 +518,36 @@ StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,St
 	stepSize=newStepSize;
 	}
 
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::setSpacingFactors(
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Scalar newMinSpacingFactor,
+	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Scalar newMaxSpacingFactor)
+	{
+	minSpacingFactor=newMinSpacingFactor;
+	maxSpacingFactor=newMaxSpacingFactor;
+	}
+
+template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
+inline
+void
+StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::setMaxNumFrontStreamlines(
+	unsigned int newMaxNumFrontStreamlines)
+	{
+	maxNumFrontStreamlines=newMaxNumFrontStreamlines;
+	}
+
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
 inline
 void
 StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::setNumStreamlines(
-	int newNumStreamlines)
+	unsigned int newNumStreamlines)
 	{
-	if(newNumStreamlines!=numStreamlines)
-		{
-		/* Delete the old state arrays: */
-		delete[] p0s;
-		delete[] locators;
-		delete[] positions;
-		delete[] tangents;
-		delete[] scalars;
-		
-		/* Set the new number of streamlines: */
-		numStreamlines=newNumStreamlines;
-		
-		/* Initialize the state arrays: */
-		if(newNumStreamlines!=0)
-			{
-			/* Allocate the state arrays: */
-			p0s=new Point[numStreamlines];
-			locators=new Locator[numStreamlines];
-			positions=new Point[numStreamlines];
-			tangents=new Vector[numStreamlines];
-			scalars=new VScalar[numStreamlines];
-			}
-		else
-			{
-			/* Set the state arrays to invalid: */
-			p0s=0;
-			locators=0;
-			positions=0;
-			tangents=0;
-			scalars=0;
-			}
-		}
+	/* Set the new number of seed streamlines: */
+	numStreamlines=newNumStreamlines;
+	seedPoints.resize(numStreamlines);
+	seedLocators.resize(numStreamlines);
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
@@ -266,13 +563,13 @@ template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorPar
 inline
 void
 StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::initializeStreamline(
-	int index,
+	unsigned int index,
 	const typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Point& startPoint,
 	const typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Locator& startLocator)
 	{
 	/* Set the streamline extraction parameters: */
-	p0s[index]=startPoint;
-	locators[index]=startLocator;
+	seedPoints[index]=startPoint;
+	seedLocators[index]=startLocator;
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
@@ -282,13 +579,16 @@ StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,St
 	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamsurface& newStreamsurface)
 	{
 	streamsurface=&newStreamsurface;
-	layerIndex=0;
+	startFront();
 	
-	/* Integrate the streamlines until one leaves the data set's domain: */
-	while(stepStreamsurface())
-		++layerIndex;
+	/* Integrate the streamlines until all leave the data set's domain: */
+	if(frontHead!=0)
+		while(stepStreamsurface())
+			;
+	streamsurface->flush();
 	
 	/* Clean up: */
+	deleteFront();
 	streamsurface=0;
 	}
 
@@ -299,7 +599,7 @@ StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,St
 	typename StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StreamsurfaceParam>::Streamsurface& newStreamsurface)
 	{
 	streamsurface=&newStreamsurface;
-	layerIndex=0;
+	startFront();
 	}
 
 template <class DataSetParam,class VectorExtractorParam,class ScalarExtractorParam,class StreamsurfaceParam>
@@ -310,9 +610,10 @@ StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,St
 	const ContinueFunctorParam& cf)
 	{
 	/* Integrate the streamlines until all leave the domain or the functor interrupts: */
-	bool valid;
-	while((valid=stepStreamsurface())&&cf())
-		++layerIndex;
+	bool valid=frontHead!=0;
+	while(valid&&cf())
+		valid=stepStreamsurface();
+	streamsurface->flush();
 	
 	return !valid;
 	}
@@ -324,6 +625,7 @@ StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,St
 	void)
 	{
 	/* Clean up: */
+	deleteFront();
 	streamsurface=0;
 	}
 
@@ -1,7 +1,7 @@
 /***********************************************************************
 StreamsurfaceExtractor - Class to extract stream surfaces from data
 sets.
-Copyright (c) 2006-2007 Oliver Kreylos
+Copyright (c) 2006-2009 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -23,6 +23,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_STREAMSURFACEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_STREAMSURFACEEXTRACTOR_INCLUDED
 
+#include <stddef.h>
+#include <vector>
+
 namespace Visualization {
 
 namespace Templatized {
@@ -46,38 +49,65 @@ class StreamsurfaceExtractor
 	
 	private:
 	typedef typename Streamsurface::Vertex Vertex; // Type of vertices stored in stream surface
+	typedef typename Streamsurface::Index Index; // Type of vertex indices in stream surface
 	
-	struct Streamline // Structure storing the current state of one streamline defining the surface
+	struct Streamline // Structure storing the current state of one streamline on the surface's front
 		{
 		/* Elements: */
 		public:
-		Point pos0; // Tracing position at beginning of iteration step
+		Point pos; // Current tracing position
 		Locator locator; // Data set locator for current tracing position
-		VScalar scalar0; // Associated scalar value at the initial position
-		Vector vec0; // Vector value at the initial position
-		Point pos1; // Tracing position at end of iteration step
-		Scalar arclength; // Accumulated arc length of the streamline including the initial position
-		typename Streamsurface::Index index; // Index of most recently created vertex
-		Streamline* pred; // Pointer to previous streamline in the surface
-		Streamline* succ; // Pointer to next streamline in the surface
-		bool connectPred; // Flag whether this streamline is connected to the previous one
-		bool connectSucc; // Flag whether this streamline is connected to the next one
+		Vector vec; // Vector value at the current tracing position
+		VScalar scalar; // Auxiliary scalar value at the current tracing position
+		Index index; // Index of the streamline's vertex in the most recent surface layer, or invalidIndex if the streamline was inserted after the layer was created
+		Index newIndex; // Index of the streamline's vertex in the surface layer being created
+		Streamline* pred; // Pointer to previous streamline on the front
+		Streamline* succ; // Pointer to next streamline on the front
+		bool connectSucc; // Flag whether this streamline is connected to the next one by surface triangles
+		bool valid; // Flag whether the streamline is still inside the data set's domain
+		bool remove; // Flag whether the streamline is removed from the front in the current layer
 		};
 	
 	/* Elements: */
 	private:
-	const DataSet* dataSet; // Data set the isosurface extractor works on
+	static const Index invalidIndex=~Index(0); // Index value for streamlines that do not have a vertex in the most recent surface layer
+	const DataSet* dataSet; // Data set the stream surface extractor works on
 	VectorExtractor vectorExtractor; // Vector extractor working on data set
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	Scalar stepSize; // Fixed step size for streamline integration
+	Scalar maxSpacingFactor; // A streamline is inserted between two neighbours whose distance exceeds this multiple of the seed spacing
+	Scalar minSpacingFactor; // A streamline is removed if its distances to both neighbours fall below this multiple of the seed spacing
+	unsigned int maxNumFrontStreamlines; // Maximum number of streamlines on the front; limits the cost of refinement in divergent flow
+	bool closed; // Flag whether the seed curve is closed, i.e., the last seed streamline is connected to the first one
+	
+	/* Seed curve definition: */
+	unsigned int numStreamlines; // Number of streamlines seeded along the seed curve
+	std::vector<Point> seedPoints; // Array of seed positions along the seed curve
+	std::vector<Locator> seedLocators; // Array of locators used to locate the seed positions
 	
-	/* Streamline extraction state: */
-	Streamline* streamlineHead; // Pointer to one of the streamlines defining the surface
+	/* Stream surface extraction state: */
 	Streamsurface* streamsurface; // Pointer to the stream surface representation
+	Streamline* frontHead; // Pointer to one of the streamlines on the surface's front, or 0 if all streamlines left the domain
+	unsigned int numFrontStreamlines; // Current number of streamlines on the front
+	Scalar seedSpacing; // Average distance between connected seed streamlines
+	unsigned int numLayers; // Number of surface layers created so far
+	size_t numInsertions; // Number of streamlines inserted into the front since extraction was started
+	size_t numRemovals; // Number of streamlines removed from the front since extraction was started
+	Scalar maxFrontSpacing; // Maximum distance between connected streamlines in any created surface layer
 	
 	/* Private methods: */
+	bool locateStreamline(Streamline& s); // Locates the streamline's current position and evaluates vector and scalar values; returns false if the streamline left the domain
 	bool stepStreamline(Streamline& s); // Advances the given streamline by one step
-	bool stepStreamsurface(void); // Advances all current streamline positions by one step and adds a new layer to the stream surface
+	Streamline* getLayerPred(Streamline* s) const; // Returns the connected predecessor of the given streamline in the layer being created, or 0
+	Streamline* getLayerSucc(Streamline* s) const; // Returns the connected successor of the given streamline in the layer being created, or 0
+	void addLayerVertex(Streamline& s); // Adds the given streamline's current position as vertex of the layer being created
+	void addTriangle(Index i0,Index i1,Index i2); // Adds a triangle to the stream surface
+	void adaptFront(void); // Inserts streamlines between diverging neighbours and marks streamlines between converging neighbours for removal
+	void stitchLayer(void); // Creates triangles connecting the most recent surface layer to the layer being created
+	void cleanFront(void); // Removes dead and removed streamlines from the front after a layer has been created
+	void deleteFront(void); // Deletes all streamlines on the front
+	void startFront(void); // Creates the initial front from the seed positions and creates the first surface layer
+	bool stepStreamsurface(void); // Adapts the front, advances all streamlines by one step and adds a new layer to the stream surface; returns false if all streamlines left the domain
 	
 	/* Constructors and destructors: */
 	public:
@@ -109,23 +139,71 @@ class StreamsurfaceExtractor
 		{
 		return scalarExtractor;
 		}
+	void update(const DataSet* newDataSet,const VectorExtractor& newVectorExtractor,const ScalarExtractor& newScalarExtractor) // Sets a new data set and scalar / vector extractors for subsequent stream surface extraction
+		{
+		dataSet=newDataSet;
+		vectorExtractor=newVectorExtractor;
+		scalarExtractor=newScalarExtractor;
+		}
 	Scalar getStepSize(void) const // Returns the integration step size
 		{
 		return stepSize;
 		}
 	void setStepSize(Scalar newStepSize); // Sets the integration step size
-	int getNumStreamlines(void) const // Returns the number of streamlines extracted in parallel
+	Scalar getMaxSpacingFactor(void) const // Returns the front refinement threshold
+		{
+		return maxSpacingFactor;
+		}
+	Scalar getMinSpacingFactor(void) const // Returns the front coarsening threshold
+		{
+		return minSpacingFactor;
+		}
+	void setSpacingFactors(Scalar newMinSpacingFactor,Scalar newMaxSpacingFactor); // Sets the front coarsening and refinement thresholds relative to the seed spacing; maximum factor must be larger than twice the minimum factor
+	unsigned int getMaxNumFrontStreamlines(void) const // Returns the maximum number of streamlines on the front
+		{
+		return maxNumFrontStreamlines;
+		}
+	void setMaxNumFrontStreamlines(unsigned int newMaxNumFrontStreamlines); // Sets the maximum number of streamlines on the front
+	unsigned int getNumStreamlines(void) const // Returns the number of seed streamlines
 		{
 		return numStreamlines;
 		}
-	void setNumStreamlines(int newNumStreamlines); // Sets the number of streamlines extracted in parallel
+	void setNumStreamlines(unsigned int newNumStreamlines); // Sets the number of seed streamlines
+	bool isClosed(void) const // Returns true if the seed curve is closed
+		{
+		return closed;
+		}
 	void setClosed(bool newClosed); // Sets if the stream surface is open or a closed tube
-	void initializeStreamline(int index,const Point& startPoint,const Locator& startLocator); // Initializes one streamline
+	void initializeStreamline(unsigned int index,const Point& startPoint,const Locator& startLocator); // Initializes one seed streamline
 	void extractStreamsurface(Streamsurface& newStreamsurface); // Extracts stream surface for the previously initialized positions and locators
 	void startStreamsurface(Streamsurface& newStreamsurface); // Starts extracting stream surface for the previously initialized positions and locators
 	template <class ContinueFunctorParam>
 	bool continueStreamsurface(const ContinueFunctorParam& cf); // Continues extracting stream surface while the continue functor returns true; returns true if the stream surface is finished
 	void finishStreamsurface(void); // Cleans up after creating stream surface
+	unsigned int getNumFrontStreamlines(void) const // Returns the current number of streamlines on the front
+		{
+		return numFrontStreamlines;
+		}
+	unsigned int getNumLayers(void) const // Returns the number of surface layers created by the most recent extraction
+		{
+		return numLayers;
+		}
+	size_t getNumInsertions(void) const // Returns the number of streamlines inserted by the most recent extraction
+		{
+		return numInsertions;
+		}
+	size_t getNumRemovals(void) const // Returns the number of streamlines removed by the most recent extraction
+		{
+		return numRemovals;
+		}
+	Scalar getSeedSpacing(void) const // Returns the average distance between connected seed streamlines
+		{
+		return seedSpacing;
+		}
+	Scalar getMaxFrontSpacing(void) const // Returns the maximum distance between connected streamlines in any surface layer of the most recent extraction
+		{
+		return maxFrontSpacing;
+		}
 	};
 
 }
@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_TEMPLATIZED_TRIANGLESET_IMPLEMENTATION
 
+#include <vector>
 #include <Comm/MulticastPipe.h>
 #include <GL/gl.h>
 #include <GL/GLVertexArrayParts.h>
@@ -31,6 +32,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/GLExtensionManager.h>
 #include <GL/Extensions/GLARBVertexBufferObject.h>
 
+#include <Templatized/ElementChecksum.h>
 #include <Templatized/TriangleSet.h>
 
 namespace Visualization {
@@ -88,8 +90,7 @@ TriangleSet<VertexParam>::addNewChunk(
 		if(tail!=0&&(numUnsentTriangles=chunkSize-tailNumSentTriangles)>0)
 			{
 			/* Send unsent triangles in the last chunk across the pipe: */
-			pipe->write<unsigned int>((unsigned int)numUnsentTriangles);
-			pipe->write<Vertex>(tail->vertices+tailNumSentTriangles*3,numUnsentTriangles*3);
+			writeBatch(tail->vertices+tailNumSentTriangles*3,numUnsentTriangles);
 			pipe->finishMessage();
 			}
 		
@@ -109,6 +110,32 @@ TriangleSet<VertexParam>::addNewChunk(
 	nextVertex=tail->vertices;
 	}
 
+template <class VertexParam>
+inline
+void
+TriangleSet<VertexParam>::writeBatch(
+	const typename TriangleSet<VertexParam>::Vertex* batchVertices,
+	size_t numBatchTriangles)
+	{
+	/* Write the batch header: */
+	pipe->write<unsigned int>((unsigned int)numBatchTriangles);
+	
+	if(codec.isEnabled())
+		{
+		/* Compress and send the batch: */
+		streamBuffer.clear();
+		codec.encode(batchVertices,numBatchTriangles*3,0,0,0,streamBuffer);
+		pipe->write<unsigned int>((unsigned int)streamBuffer.size());
+		pipe->write<unsigned char>(&streamBuffer[0],streamBuffer.size());
+		}
+	else
+		{
+		/* Send the batch uncompressed: */
+		pipe->write<unsigned int>(0U);
+		pipe->write<Vertex>(batchVertices,numBatchTriangles*3);
+		}
+	}
+
 template <class VertexParam>
 inline
 TriangleSet<VertexParam>::TriangleSet(
@@ -180,6 +207,20 @@ TriangleSet<VertexParam>::receive(
 	size_t numBatchTriangles;
 	while((numBatchTriangles=pipe->read<unsigned int>())>0)
 		{
+		/* Check if the batch was compressed: */
+		size_t numEncodedBytes=pipe->read<unsigned int>();
+		std::vector<Vertex> decodedVertices;
+		const Vertex* dvPtr=0;
+		if(numEncodedBytes>0)
+			{
+			/* Receive and decompress the entire batch: */
+			streamBuffer.resize(numEncodedBytes);
+			pipe->read<unsigned char>(&streamBuffer[0],numEncodedBytes);
+			decodedVertices.resize(numBatchTriangles*3);
+			codec.decode(&streamBuffer[0],&decodedVertices[0],numBatchTriangles*3,0,0,0);
+			dvPtr=&decodedVertices[0];
+			}
+		
 		/* Read the triangle data one chunk at a time: */
 		while(numBatchTriangles>0)
 			{
@@ -202,7 +243,13 @@ TriangleSet<VertexParam>::receive(
 			size_t numReadTriangles=numBatchTriangles;
 			if(numReadTriangles>tailRoomLeft)
 				numReadTriangles=tailRoomLeft;
-			pipe->read<Vertex>(nextVertex,numReadTriangles*3);
+			if(dvPtr!=0)
+				{
+				for(size_t i=0;i<numReadTriangles*3;++i,++dvPtr)
+					nextVertex[i]=*dvPtr;
+				}
+			else
+				pipe->read<Vertex>(nextVertex,numReadTriangles*3);
 			numBatchTriangles-=numReadTriangles;
 			
 			/* Update the vertex storage: */
@@ -225,8 +272,7 @@ TriangleSet<VertexParam>::flush(
 		size_t numUnsentTriangles;
 		if(tail!=0&&(numUnsentTriangles=chunkSize-tailRoomLeft-tailNumSentTriangles)>0)
 			{
-			pipe->write<unsigned int>((unsigned int)numUnsentTriangles);
-			pipe->write<Vertex>(tail->vertices+tailNumSentTriangles*3,numUnsentTriangles*3);
+			writeBatch(tail->vertices+tailNumSentTriangles*3,numUnsentTriangles);
 			tailNumSentTriangles+=numUnsentTriangles;
 			}
 		
@@ -236,6 +282,29 @@ TriangleSet<VertexParam>::flush(
 		}
 	}
 
+template <class VertexParam>
+inline
+unsigned int
+TriangleSet<VertexParam>::calcChecksum(
+	void) const
+	{
+	ElementChecksum checksum;
+	checksum.add(numTriangles);
+	
+	/* Add all triangle vertices: */
+	size_t trianglesLeft=numTriangles;
+	for(const Chunk* chPtr=head;trianglesLeft>0;chPtr=chPtr->succ)
+		{
+		size_t numChunkTriangles=trianglesLeft;
+		if(numChunkTriangles>chunkSize)
+			numChunkTriangles=chunkSize;
+		checksum.add(chPtr->vertices,numChunkTriangles*3*sizeof(Vertex));
+		trianglesLeft-=numChunkTriangles;
+		}
+	
+	return checksum.getChecksum();
+	}
+
 template <class VertexParam>
 inline
 void
@@ -26,6 +26,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 
+#include <Templatized/ElementStreamCodec.h>
+
 /* Forward declarations: */
 namespace Comm {
 class MulticastPipe;
@@ -75,6 +77,8 @@ class TriangleSet:public GLObject
 	/* Elements: */
 	private:
 	Comm::MulticastPipe* pipe; // Pipe to stream triangle set data in a cluster environment (owned by caller)
+	ElementStreamCodec<Vertex> codec; // Codec to compress triangle set data streamed across the pipe
+	typename ElementStreamCodec<Vertex>::Buffer streamBuffer; // Buffer holding compressed triangle set data
 	unsigned int version; // Version number of the triangle set (incremented on each clear operation)
 	size_t numTriangles; // Total number of triangles currently in set
 	Chunk* head; // Pointer to first triangle buffer chunk
@@ -85,6 +89,7 @@ class TriangleSet:public GLObject
 	
 	/* Private methods: */
 	void addNewChunk(void); // Adds a new chunk to the triangle buffer
+	void writeBatch(const Vertex* batchVertices,size_t numBatchTriangles); // Writes a set of triangles to the pipe, compressed if compression is enabled
 	
 	/* Constructors and destructors: */
 	public:
@@ -97,6 +102,12 @@ class TriangleSet:public GLObject
 	
 	/* Methods: */
 	virtual void initContext(GLContextData& contextData) const;
+	template <class BoxParam>
+	void setStreamCompression(const BoxParam& domain,unsigned int positionBits,unsigned int normalBits) // Compresses data streamed across the pipe by quantizing positions relative to the given domain box with the given number of bits; zero position bits streams uncompressed data
+		{
+		codec.setDomain(domain);
+		codec.setPrecision(positionBits,normalBits);
+		}
 	void clear(void); // Removes all triangles from the set
 	Vertex* getNextTriangleVertices(void) // Returns pointer to next vertex triple in buffer
 		{
@@ -120,6 +131,7 @@ class TriangleSet:public GLObject
 		{
 		return numTriangles;
 		}
+	unsigned int calcChecksum(void) const; // Returns a checksum over all triangles in the buffer
 	void glRenderAction(GLContextData& contextData) const; // Renders all triangles in the buffer
 	};
 
@@ -0,0 +1,115 @@
+/***********************************************************************
+VertexGradientCache - Class to store the gradients of a scalar variable
+at all vertices of a structured data set, calculated on multiple threads,
+to turn the repeated gradient calculations of smooth-shaded isosurface
+extraction into table lookups.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_VERTEXGRADIENTCACHE_IMPLEMENTATION
+
+#include <Threads/Thread.h>
+
+#include <Templatized/VertexGradientCache.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/*******************************************
+Methods of class VertexGradientCache::Chunk:
+*******************************************/
+
+template <class DataSetParam,class ScalarExtractorParam>
+inline
+void*
+VertexGradientCache<DataSetParam,ScalarExtractorParam>::Chunk::calcGradients(
+	void)
+	{
+	/* Calculate the gradient of each vertex in the chunk: */
+	Vector* gPtr=&cache->gradients[beginIndex];
+	for(VertexIterator vIt=begin;vIt!=end;++vIt,++gPtr)
+		*gPtr=Traits::calcVertexGradient(*vIt,cache->scalarExtractor);
+	
+	return 0;
+	}
+
+/************************************
+Methods of class VertexGradientCache:
+************************************/
+
+template <class DataSetParam,class ScalarExtractorParam>
+inline
+VertexGradientCache<DataSetParam,ScalarExtractorParam>::VertexGradientCache(
+	const typename VertexGradientCache<DataSetParam,ScalarExtractorParam>::DataSet* sDataSet,
+	const typename VertexGradientCache<DataSetParam,ScalarExtractorParam>::ScalarExtractor& sScalarExtractor,
+	unsigned int numThreads)
+	:dataSet(sDataSet),
+	 scalarExtractor(sScalarExtractor)
+	{
+	/* Bail out if the data set's vertex gradients can not be cached: */
+	size_t numVertices=dataSet->getTotalNumVertices();
+	if(!Traits::denseVertexIDs||numVertices==0)
+		return;
+	gradients.resize(numVertices);
+	
+	/* Use at most one chunk per vertex: */
+	size_t numChunks=numThreads>0?size_t(numThreads):1;
+	if(numChunks>numVertices)
+		numChunks=numVertices;
+	
+	/* Split the vertex list into chunks in a single walk: */
+	std::vector<Chunk> chunks(numChunks);
+	VertexIterator vIt=dataSet->beginVertices();
+	size_t vertexIndex=0;
+	for(size_t chunk=0;chunk<numChunks;++chunk)
+		{
+		chunks[chunk].cache=this;
+		chunks[chunk].begin=vIt;
+		chunks[chunk].beginIndex=vertexIndex;
+		size_t chunkEnd=(numVertices*(chunk+1))/numChunks;
+		for(;vertexIndex<chunkEnd;++vertexIndex)
+			++vIt;
+		chunks[chunk].end=vIt;
+		}
+	
+	/* Calculate the gradients of all chunks but the first on their own threads: */
+	Threads::Thread* threads=0;
+	if(numChunks>1)
+		{
+		threads=new Threads::Thread[numChunks-1];
+		for(size_t i=1;i<numChunks;++i)
+			threads[i-1].start(&chunks[i],&Chunk::calcGradients);
+		}
+	
+	/* Calculate the first chunk's gradients on the calling thread: */
+	chunks[0].calcGradients();
+	
+	/* Wait for all other chunks: */
+	if(threads!=0)
+		{
+		for(size_t i=1;i<numChunks;++i)
+			threads[i-1].join();
+		delete[] threads;
+		}
+	}
+
+}
+
+}
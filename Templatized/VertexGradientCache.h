@@ -0,0 +1,188 @@
+/***********************************************************************
+VertexGradientCache - Class to store the gradients of a scalar variable
+at all vertices of a structured data set, calculated on multiple threads,
+to turn the repeated gradient calculations of smooth-shaded isosurface
+extraction into table lookups.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_VERTEXGRADIENTCACHE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_VERTEXGRADIENTCACHE_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+
+#include <Templatized/LinearIndexID.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class Cartesian;
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class Curvilinear;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCurvilinear;
+}
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class VertexGradientCacheTraits // Generic traits class for data sets whose vertex IDs are not dense linear indices in vertex iteration order
+	{
+	/* Elements: */
+	public:
+	static const bool denseVertexIDs=false; // Flag whether the data set's vertex IDs are linear indices that enumerate the vertices in iteration order
+	
+	/* Methods: */
+	template <class VertexIDParam>
+	static size_t getVertexIndex(const VertexIDParam&) // Returns the linear index of the given vertex ID; never called for data sets without dense vertex IDs
+		{
+		return 0;
+		}
+	template <class VertexParam,class ScalarExtractorParam>
+	static typename DataSetParam::Vector calcVertexGradient(const VertexParam&,const ScalarExtractorParam&) // Returns the gradient at the given vertex; never called for data sets without dense vertex IDs
+		{
+		return typename DataSetParam::Vector();
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class VertexGradientCacheTraits<Cartesian<ScalarParam,dimensionParam,ValueParam> >
+	{
+	/* Elements: */
+	public:
+	static const bool denseVertexIDs=true;
+	
+	/* Methods: */
+	static size_t getVertexIndex(const LinearIndexID& vertexID)
+		{
+		return size_t(vertexID.getIndex());
+		}
+	template <class VertexParam,class ScalarExtractorParam>
+	static typename Cartesian<ScalarParam,dimensionParam,ValueParam>::Vector calcVertexGradient(const VertexParam& vertex,const ScalarExtractorParam& extractor)
+		{
+		return vertex.calcGradient(extractor);
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class VertexGradientCacheTraits<Curvilinear<ScalarParam,dimensionParam,ValueParam> >
+	{
+	/* Elements: */
+	public:
+	static const bool denseVertexIDs=true;
+	
+	/* Methods: */
+	static size_t getVertexIndex(const LinearIndexID& vertexID)
+		{
+		return size_t(vertexID.getIndex());
+		}
+	template <class VertexParam,class ScalarExtractorParam>
+	static typename Curvilinear<ScalarParam,dimensionParam,ValueParam>::Vector calcVertexGradient(const VertexParam& vertex,const ScalarExtractorParam& extractor)
+		{
+		return vertex.calcGradient(extractor);
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class VertexGradientCacheTraits<SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	/* Elements: */
+	public:
+	static const bool denseVertexIDs=true;
+	
+	/* Methods: */
+	static size_t getVertexIndex(const LinearIndexID& vertexID)
+		{
+		return size_t(vertexID.getIndex());
+		}
+	template <class VertexParam,class ScalarExtractorParam>
+	static typename SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam>::Vector calcVertexGradient(const VertexParam& vertex,const ScalarExtractorParam& extractor)
+		{
+		return vertex.calcGradient(extractor);
+		}
+	};
+
+template <class DataSetParam,class ScalarExtractorParam>
+class VertexGradientCache
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of the data set whose vertex gradients are cached
+	typedef ScalarExtractorParam ScalarExtractor; // Type of scalar extractor for the cached scalar variable
+	typedef typename DataSet::Vector Vector; // Type for gradient vectors
+	typedef typename DataSet::VertexID VertexID; // Type of the data set's vertex IDs
+	typedef typename DataSet::VertexIterator VertexIterator; // Type of iterators over the data set's vertices
+	typedef VertexGradientCacheTraits<DataSet> Traits; // Traits class to check whether the data set's vertex gradients can be cached
+	
+	private:
+	struct Chunk // Structure for a contiguous range of vertices whose gradients are calculated by a single thread
+		{
+		/* Elements: */
+		public:
+		VertexGradientCache* cache; // Pointer to the gradient cache
+		VertexIterator begin; // Iterator to the first vertex in the chunk
+		VertexIterator end; // Iterator behind the last vertex in the chunk
+		size_t beginIndex; // Linear index of the first vertex in the chunk
+		
+		/* Methods: */
+		void* calcGradients(void); // Calculates the gradients of all vertices in the chunk
+		};
+	
+	/* Elements: */
+	const DataSet* dataSet; // Pointer to the data set
+	ScalarExtractor scalarExtractor; // Scalar extractor for the cached scalar variable
+	std::vector<Vector> gradients; // Gradients of the scalar variable at all vertices, in vertex iteration order
+	
+	/* Constructors and destructors: */
+	public:
+	VertexGradientCache(const DataSet* sDataSet,const ScalarExtractor& sScalarExtractor,unsigned int numThreads); // Calculates the gradients of the given scalar variable at all vertices of the given data set on the given number of threads
+	
+	/* Methods: */
+	static bool isSupported(void) // Returns true if the data set type's vertex gradients can be cached
+		{
+		return Traits::denseVertexIDs;
+		}
+	static size_t calcMemorySize(const DataSet& dataSet) // Returns the number of bytes a gradient cache for the given data set would occupy
+		{
+		return dataSet.getTotalNumVertices()*sizeof(Vector);
+		}
+	size_t getMemorySize(void) const // Returns the number of bytes occupied by the cached gradients
+		{
+		return gradients.size()*sizeof(Vector);
+		}
+	const Vector& getVertexGradient(const VertexID& vertexID) const // Returns the cached gradient at the vertex of the given ID
+		{
+		return gradients[Traits::getVertexIndex(vertexID)];
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_VERTEXGRADIENTCACHE_IMPLEMENTATION
+#include <Templatized/VertexGradientCache.cpp>
+#endif
+
+#endif
@@ -0,0 +1,351 @@
+/***********************************************************************
+VertexValueStatistics - Class to calculate value ranges and histograms
+of the vertex values of a data set on multiple threads, by splitting the
+data set's vertex list into contiguous chunks.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_VERTEXVALUESTATISTICS_IMPLEMENTATION
+
+#include <Threads/Thread.h>
+#include <Math/Math.h>
+#include <Geometry/Vector.h>
+
+#include <Templatized/VertexValueStatistics.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/*********************************************************
+Methods of class VertexValueStatistics::ScalarRangesChunk:
+*********************************************************/
+
+template <class DataSetParam>
+template <class ScalarExtractorParam>
+inline
+void*
+VertexValueStatistics<DataSetParam>::ScalarRangesChunk<ScalarExtractorParam>::reduce(
+	void)
+	{
+	/* Initialize the value ranges from the chunk's first vertex: */
+	ranges.resize(numExtractors);
+	VertexIterator vIt=this->begin;
+	for(size_t i=0;i<numExtractors;++i)
+		{
+		Scalar v=vIt->getValue(extractors[i]);
+		ranges[i]=Range(v,v);
+		}
+	
+	/* Extend the value ranges by all other vertices in the chunk: */
+	for(++vIt;vIt!=this->end;++vIt)
+		for(size_t i=0;i<numExtractors;++i)
+			{
+			Scalar v=vIt->getValue(extractors[i]);
+			if(ranges[i].first>v)
+				ranges[i].first=v;
+			else if(ranges[i].second<v)
+				ranges[i].second=v;
+			}
+	
+	return 0;
+	}
+
+/***********************************************************
+Methods of class VertexValueStatistics::MagnitudeRangeChunk:
+***********************************************************/
+
+template <class DataSetParam>
+template <class VectorExtractorParam>
+inline
+void*
+VertexValueStatistics<DataSetParam>::MagnitudeRangeChunk<VectorExtractorParam>::reduce(
+	void)
+	{
+	/* Reduce the range of squared magnitudes to avoid taking a square root per vertex: */
+	VertexIterator vIt=this->begin;
+	min2=max2=Geometry::sqr(vIt->getValue(*extractor));
+	for(++vIt;vIt!=this->end;++vIt)
+		{
+		Scalar v2=Geometry::sqr(vIt->getValue(*extractor));
+		if(min2>v2)
+			min2=v2;
+		else if(max2<v2)
+			max2=v2;
+		}
+	
+	return 0;
+	}
+
+/*******************************************************
+Methods of class VertexValueStatistics::HistogramsChunk:
+*******************************************************/
+
+template <class DataSetParam>
+template <class ScalarExtractorParam>
+inline
+void*
+VertexValueStatistics<DataSetParam>::HistogramsChunk<ScalarExtractorParam>::reduce(
+	void)
+	{
+	bins.assign(numExtractors*numBins,0);
+	
+	/* Calculate the mappings from values to bin indices: */
+	std::vector<double> offsets(numExtractors);
+	std::vector<double> scales(numExtractors);
+	for(size_t i=0;i<numExtractors;++i)
+		{
+		offsets[i]=double(ranges[i].first);
+		scales[i]=ranges[i].second>ranges[i].first?double(numBins)/(double(ranges[i].second)-double(ranges[i].first)):0.0;
+		}
+	double lastBin=double(numBins-1);
+	
+	/* Count all vertices in the chunk: */
+	for(VertexIterator vIt=this->begin;vIt!=this->end;++vIt)
+		{
+		size_t* histogram=&bins[0];
+		for(size_t i=0;i<numExtractors;++i,histogram+=numBins)
+			{
+			double binIndex=(double(vIt->getValue(extractors[i]))-offsets[i])*scales[i];
+			if(binIndex>=0.0)
+				++histogram[binIndex<lastBin?size_t(binIndex):numBins-1];
+			else
+				++histogram[0];
+			}
+		}
+	
+	return 0;
+	}
+
+/**************************************
+Methods of class VertexValueStatistics:
+**************************************/
+
+template <class DataSetParam>
+template <class ChunkParam>
+inline
+void
+VertexValueStatistics<DataSetParam>::reduceChunks(
+	std::vector<ChunkParam>& chunks) const
+	{
+	/* Reduce all chunks but the first on their own threads: */
+	size_t numChunks=chunks.size();
+	Threads::Thread* threads=0;
+	if(numChunks>1)
+		{
+		threads=new Threads::Thread[numChunks-1];
+		for(size_t i=1;i<numChunks;++i)
+			threads[i-1].start(&chunks[i],&ChunkParam::reduce);
+		}
+	
+	/* Reduce the first chunk on the calling thread: */
+	chunks[0].reduce();
+	
+	/* Wait for all other chunks: */
+	if(threads!=0)
+		{
+		for(size_t i=1;i<numChunks;++i)
+			threads[i-1].join();
+		delete[] threads;
+		}
+	}
+
+template <class DataSetParam>
+inline
+VertexValueStatistics<DataSetParam>::VertexValueStatistics(
+	const typename VertexValueStatistics<DataSetParam>::DataSet* sDataSet,
+	unsigned int numThreads)
+	:dataSet(sDataSet)
+	{
+	/* Use at most one chunk per vertex: */
+	size_t numVertices=dataSet->getTotalNumVertices();
+	if(numVertices==0)
+		return;
+	size_t numChunks=numThreads>0?size_t(numThreads):1;
+	if(numChunks>numVertices)
+		numChunks=numVertices;
+	
+	/* Find the first vertex of each chunk in a single walk over the vertex list: */
+	chunkBounds.reserve(numChunks+1);
+	VertexIterator vIt=dataSet->beginVertices();
+	size_t vertexIndex=0;
+	for(size_t chunk=0;chunk<numChunks;++chunk)
+		{
+		size_t chunkBegin=(numVertices*chunk)/numChunks;
+		for(;vertexIndex<chunkBegin;++vertexIndex)
+			++vIt;
+		chunkBounds.push_back(vIt);
+		}
+	chunkBounds.push_back(dataSet->endVertices());
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam>
+inline
+std::pair<typename ScalarExtractorParam::Scalar,typename ScalarExtractorParam::Scalar>
+VertexValueStatistics<DataSetParam>::calcScalarRange(
+	const ScalarExtractorParam& extractor) const
+	{
+	std::pair<typename ScalarExtractorParam::Scalar,typename ScalarExtractorParam::Scalar> result;
+	calcScalarRanges(1,&extractor,&result);
+	return result;
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam>
+inline
+void
+VertexValueStatistics<DataSetParam>::calcScalarRanges(
+	size_t numExtractors,
+	const ScalarExtractorParam extractors[],
+	std::pair<typename ScalarExtractorParam::Scalar,typename ScalarExtractorParam::Scalar> ranges[]) const
+	{
+	typedef ScalarRangesChunk<ScalarExtractorParam> RangesChunk;
+	typedef typename RangesChunk::Scalar Scalar;
+	
+	size_t numChunks=getNumChunks();
+	if(numChunks==0)
+		{
+		/* Return empty ranges for empty data sets: */
+		for(size_t i=0;i<numExtractors;++i)
+			ranges[i]=typename RangesChunk::Range(Scalar(0),Scalar(0));
+		return;
+		}
+	
+	/* Reduce all chunks: */
+	std::vector<RangesChunk> chunks(numChunks);
+	for(size_t chunk=0;chunk<numChunks;++chunk)
+		{
+		chunks[chunk].begin=chunkBounds[chunk];
+		chunks[chunk].end=chunkBounds[chunk+1];
+		chunks[chunk].numExtractors=numExtractors;
+		chunks[chunk].extractors=extractors;
+		}
+	reduceChunks(chunks);
+	
+	/* Merge the chunks' value ranges: */
+	for(size_t i=0;i<numExtractors;++i)
+		{
+		ranges[i]=chunks[0].ranges[i];
+		for(size_t chunk=1;chunk<numChunks;++chunk)
+			{
+			if(ranges[i].first>chunks[chunk].ranges[i].first)
+				ranges[i].first=chunks[chunk].ranges[i].first;
+			if(ranges[i].second<chunks[chunk].ranges[i].second)
+				ranges[i].second=chunks[chunk].ranges[i].second;
+			}
+		}
+	}
+
+template <class DataSetParam>
+template <class VectorExtractorParam>
+inline
+std::pair<typename VectorExtractorParam::Vector::Scalar,typename VectorExtractorParam::Vector::Scalar>
+VertexValueStatistics<DataSetParam>::calcMagnitudeRange(
+	const VectorExtractorParam& extractor) const
+	{
+	typedef MagnitudeRangeChunk<VectorExtractorParam> RangeChunk;
+	typedef typename RangeChunk::Scalar Scalar;
+	
+	size_t numChunks=getNumChunks();
+	if(numChunks==0)
+		return std::pair<Scalar,Scalar>(Scalar(0),Scalar(0));
+	
+	/* Reduce all chunks: */
+	std::vector<RangeChunk> chunks(numChunks);
+	for(size_t chunk=0;chunk<numChunks;++chunk)
+		{
+		chunks[chunk].begin=chunkBounds[chunk];
+		chunks[chunk].end=chunkBounds[chunk+1];
+		chunks[chunk].extractor=&extractor;
+		}
+	reduceChunks(chunks);
+	
+	/* Merge the chunks' squared magnitude ranges: */
+	Scalar min2=chunks[0].min2;
+	Scalar max2=chunks[0].max2;
+	for(size_t chunk=1;chunk<numChunks;++chunk)
+		{
+		if(min2>chunks[chunk].min2)
+			min2=chunks[chunk].min2;
+		if(max2<chunks[chunk].max2)
+			max2=chunks[chunk].max2;
+		}
+	
+	return std::pair<Scalar,Scalar>(Math::sqrt(min2),Math::sqrt(max2));
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam>
+inline
+void
+VertexValueStatistics<DataSetParam>::calcScalarHistogram(
+	const ScalarExtractorParam& extractor,
+	typename ScalarExtractorParam::Scalar min,
+	typename ScalarExtractorParam::Scalar max,
+	size_t numBins,
+	size_t bins[]) const
+	{
+	std::pair<typename ScalarExtractorParam::Scalar,typename ScalarExtractorParam::Scalar> range(min,max);
+	calcScalarHistograms(1,&extractor,&range,numBins,bins);
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam>
+inline
+void
+VertexValueStatistics<DataSetParam>::calcScalarHistograms(
+	size_t numExtractors,
+	const ScalarExtractorParam extractors[],
+	const std::pair<typename ScalarExtractorParam::Scalar,typename ScalarExtractorParam::Scalar> ranges[],
+	size_t numBins,
+	size_t bins[]) const
+	{
+	typedef HistogramsChunk<ScalarExtractorParam> BinsChunk;
+	
+	/* Clear the histograms: */
+	size_t numTotalBins=numExtractors*numBins;
+	for(size_t i=0;i<numTotalBins;++i)
+		bins[i]=0;
+	size_t numChunks=getNumChunks();
+	if(numChunks==0||numTotalBins==0)
+		return;
+	
+	/* Reduce all chunks: */
+	std::vector<BinsChunk> chunks(numChunks);
+	for(size_t chunk=0;chunk<numChunks;++chunk)
+		{
+		chunks[chunk].begin=chunkBounds[chunk];
+		chunks[chunk].end=chunkBounds[chunk+1];
+		chunks[chunk].numExtractors=numExtractors;
+		chunks[chunk].extractors=extractors;
+		chunks[chunk].ranges=ranges;
+		chunks[chunk].numBins=numBins;
+		}
+	reduceChunks(chunks);
+	
+	/* Sum up the chunks' bin counts: */
+	for(size_t chunk=0;chunk<numChunks;++chunk)
+		for(size_t i=0;i<numTotalBins;++i)
+			bins[i]+=chunks[chunk].bins[i];
+	}
+
+}
+
+}
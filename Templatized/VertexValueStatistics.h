@@ -0,0 +1,140 @@
+/***********************************************************************
+VertexValueStatistics - Class to calculate value ranges and histograms
+of the vertex values of a data set on multiple threads, by splitting the
+data set's vertex list into contiguous chunks.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_VERTEXVALUESTATISTICS_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_VERTEXVALUESTATISTICS_INCLUDED
+
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class VertexValueStatistics
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of the data set whose vertex values are reduced
+	typedef typename DataSet::VertexIterator VertexIterator; // Type of iterators over the data set's vertices
+	
+	private:
+	struct Chunk // Base structure for a contiguous range of vertices reduced by a single thread
+		{
+		/* Elements: */
+		public:
+		VertexIterator begin; // Iterator to the first vertex in the chunk
+		VertexIterator end; // Iterator behind the last vertex in the chunk
+		};
+	
+	template <class ScalarExtractorParam>
+	struct ScalarRangesChunk:public Chunk // Structure to reduce the value ranges of one or more scalar variables in a single pass over a chunk
+		{
+		/* Embedded classes: */
+		public:
+		typedef typename ScalarExtractorParam::Scalar Scalar;
+		typedef std::pair<Scalar,Scalar> Range;
+		
+		/* Elements: */
+		size_t numExtractors; // Number of reduced scalar variables
+		const ScalarExtractorParam* extractors; // Array of scalar extractors for the reduced scalar variables
+		std::vector<Range> ranges; // Value ranges of the scalar variables inside the chunk
+		
+		/* Methods: */
+		void* reduce(void); // Reduces the chunk
+		};
+	
+	template <class VectorExtractorParam>
+	struct MagnitudeRangeChunk:public Chunk // Structure to reduce the magnitude range of a vector variable over a chunk
+		{
+		/* Embedded classes: */
+		public:
+		typedef typename VectorExtractorParam::Vector::Scalar Scalar;
+		
+		/* Elements: */
+		const VectorExtractorParam* extractor; // Vector extractor for the reduced vector variable
+		Scalar min2,max2; // Range of squared vector magnitudes inside the chunk
+		
+		/* Methods: */
+		void* reduce(void); // Reduces the chunk
+		};
+	
+	template <class ScalarExtractorParam>
+	struct HistogramsChunk:public Chunk // Structure to count the values of one or more scalar variables inside a chunk into histogram bins in a single pass
+		{
+		/* Embedded classes: */
+		public:
+		typedef typename ScalarExtractorParam::Scalar Scalar;
+		typedef std::pair<Scalar,Scalar> Range;
+		
+		/* Elements: */
+		size_t numExtractors; // Number of counted scalar variables
+		const ScalarExtractorParam* extractors; // Array of scalar extractors for the counted scalar variables
+		const Range* ranges; // Array of value ranges covered by the scalar variables' histograms
+		size_t numBins; // Number of bins per histogram
+		std::vector<size_t> bins; // Bin counts of the chunk, one block of bins per scalar variable
+		
+		/* Methods: */
+		void* reduce(void); // Reduces the chunk
+		};
+	
+	/* Elements: */
+	const DataSet* dataSet; // Pointer to the data set
+	std::vector<VertexIterator> chunkBounds; // Iterators to the first vertex of each chunk, followed by the data set's end iterator; empty if the data set has no vertices
+	
+	/* Private methods: */
+	template <class ChunkParam>
+	void reduceChunks(std::vector<ChunkParam>& chunks) const; // Reduces all chunks, each one on its own thread
+	
+	/* Constructors and destructors: */
+	public:
+	VertexValueStatistics(const DataSet* sDataSet,unsigned int numThreads); // Splits the given data set's vertex list into chunks for the given number of threads
+	
+	/* Methods: */
+	size_t getNumChunks(void) const // Returns the number of vertex chunks
+		{
+		return chunkBounds.empty()?0:chunkBounds.size()-1;
+		}
+	template <class ScalarExtractorParam>
+	std::pair<typename ScalarExtractorParam::Scalar,typename ScalarExtractorParam::Scalar> calcScalarRange(const ScalarExtractorParam& extractor) const; // Returns the value range of the given scalar variable
+	template <class ScalarExtractorParam>
+	void calcScalarRanges(size_t numExtractors,const ScalarExtractorParam extractors[],std::pair<typename ScalarExtractorParam::Scalar,typename ScalarExtractorParam::Scalar> ranges[]) const; // Calculates the value ranges of several scalar variables in a single pass over the vertices
+	template <class VectorExtractorParam>
+	std::pair<typename VectorExtractorParam::Vector::Scalar,typename VectorExtractorParam::Vector::Scalar> calcMagnitudeRange(const VectorExtractorParam& extractor) const; // Returns the magnitude range of the given vector variable
+	template <class ScalarExtractorParam>
+	void calcScalarHistogram(const ScalarExtractorParam& extractor,typename ScalarExtractorParam::Scalar min,typename ScalarExtractorParam::Scalar max,size_t numBins,size_t bins[]) const; // Counts the values of the given scalar variable into equally-sized bins covering the given value range; values outside the range are clamped to the first or last bin
+	template <class ScalarExtractorParam>
+	void calcScalarHistograms(size_t numExtractors,const ScalarExtractorParam extractors[],const std::pair<typename ScalarExtractorParam::Scalar,typename ScalarExtractorParam::Scalar> ranges[],size_t numBins,size_t bins[]) const; // Counts the values of several scalar variables into equally-sized bins covering their respective value ranges in a single pass over the vertices; stores one block of bins per scalar variable
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_VERTEXVALUESTATISTICS_IMPLEMENTATION
+#include <Templatized/VertexValueStatistics.cpp>
+#endif
+
+#endif
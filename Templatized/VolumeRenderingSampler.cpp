@@ -25,22 +25,392 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Templatized/VolumeRenderingSampler.h>
 
 #include <Misc/Utility.h>
+#include <Threads/Thread.h>
 #include <Comm/MulticastPipe.h>
 
 #include <Abstract/Algorithm.h>
+#include <VoxelBrickStore.h>
 
 namespace Visualization {
 
 namespace Templatized {
 
+/*****************************************************
+Methods of class VolumeRenderingSampler::SliceSampler:
+*****************************************************/
+
+template <class DataSetParam>
+template <class ScalarExtractorParam,class VoxelParam>
+inline
+VolumeRenderingSampler<DataSetParam>::SliceSampler<ScalarExtractorParam,VoxelParam>::SliceSampler(
+	const VolumeRenderingSampler<DataSetParam>& sSampler,
+	const ScalarExtractorParam& sScalarExtractor,
+	typename VolumeRenderingSampler<DataSetParam>::template SliceSampler<ScalarExtractorParam,VoxelParam>::VScalar sMinValue,
+	typename VolumeRenderingSampler<DataSetParam>::template SliceSampler<ScalarExtractorParam,VoxelParam>::VScalar sMaxValue,
+	unsigned int sNumThreads)
+	:sampler(sSampler),
+	 scalarExtractor(sScalarExtractor),
+	 minValue(sMinValue),maxValue(sMaxValue),
+	 voxels(0),voxelStrides(0),
+	 maxSpanSize(0),
+	 numSlices(0),nextSliceIndex(0),
+	 sliceFinisheds(0),
+	 shutdown(false),
+	 numSamplerThreads(sNumThreads>1?sNumThreads:0),samplerThreads(0)
+	{
+	/* Calculate the grid point coordinates along each dimension by accumulation: */
+	for(int i=0;i<3;++i)
+		{
+		sampleCoords[i]=new Scalar[sampler.samplerSize[i]];
+		Scalar coord=sampler.samplerOrigin[i];
+		for(unsigned int j=0;j<sampler.samplerSize[i];++j,coord+=sampler.samplerCellSize[i])
+			sampleCoords[i][j]=coord;
+		if(maxSpanSize<sampler.samplerSize[i])
+			maxSpanSize=sampler.samplerSize[i];
+		}
+	
+	/* Start the sampling threads; they wait for the first voxel block: */
+	if(numSamplerThreads>0)
+		{
+		samplerThreads=new Threads::Thread[numSamplerThreads];
+		for(unsigned int i=0;i<numSamplerThreads;++i)
+			samplerThreads[i].start(this,&SliceSampler::samplerThreadMethod);
+		}
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam,class VoxelParam>
+inline
+VolumeRenderingSampler<DataSetParam>::SliceSampler<ScalarExtractorParam,VoxelParam>::~SliceSampler(
+	void)
+	{
+	if(samplerThreads!=0)
+		{
+		/* Shut down the sampling threads: */
+		{
+		Threads::Mutex::Lock sliceLock(sliceMutex);
+		shutdown=true;
+		blockCond.broadcast();
+		}
+		for(unsigned int i=0;i<numSamplerThreads;++i)
+			samplerThreads[i].join();
+		delete[] samplerThreads;
+		}
+	
+	for(int i=0;i<3;++i)
+		delete[] sampleCoords[i];
+	delete[] sliceFinisheds;
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam,class VoxelParam>
+inline
+void
+VolumeRenderingSampler<DataSetParam>::SliceSampler<ScalarExtractorParam,VoxelParam>::setBlock(
+	const unsigned int sBlockOrigin[3],
+	const unsigned int sBlockSize[3],
+	VoxelParam* sVoxels,
+	const ptrdiff_t* sVoxelStrides)
+	{
+	Threads::Mutex::Lock sliceLock(sliceMutex);
+	
+	/* Copy the voxel block layout: */
+	for(int i=0;i<3;++i)
+		{
+		blockOrigin[i]=sBlockOrigin[i];
+		blockSize[i]=sBlockSize[i];
+		}
+	voxels=sVoxels;
+	voxelStrides=sVoxelStrides;
+	sortDimensions(voxelStrides,dims);
+	
+	/* Mark all slices as unsampled: */
+	numSlices=blockSize[dims[0]];
+	delete[] sliceFinisheds;
+	sliceFinisheds=new bool[numSlices];
+	for(unsigned int i=0;i<numSlices;++i)
+		sliceFinisheds[i]=false;
+	nextSliceIndex=0;
+	
+	/* Wake up the sampling threads: */
+	blockCond.broadcast();
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam,class VoxelParam>
+inline
+void
+VolumeRenderingSampler<DataSetParam>::SliceSampler<ScalarExtractorParam,VoxelParam>::sampleSlice(
+	unsigned int sliceIndex,
+	typename VolumeRenderingSampler<DataSetParam>::DataSet::Locator& locator,
+	typename VolumeRenderingSampler<DataSetParam>::Point* spanPositions,
+	typename VolumeRenderingSampler<DataSetParam>::template SliceSampler<ScalarExtractorParam,VoxelParam>::VScalar* spanValues,
+	bool* spanValids)
+	{
+	typedef VoxelParam Voxel;
+	
+	/* Start each slice from scratch so that results do not depend on how slices are assigned to threads: */
+	bool sampleValid=false;
+	unsigned int spanSize=blockSize[dims[2]];
+	const Scalar* coords1=sampleCoords[dims[1]]+blockOrigin[dims[1]];
+	const Scalar* coords2=sampleCoords[dims[2]]+blockOrigin[dims[2]];
+	Point samplePos;
+	samplePos[dims[0]]=sampleCoords[dims[0]][blockOrigin[dims[0]]+sliceIndex];
+	Voxel* base1=voxels+ptrdiff_t(sliceIndex)*voxelStrides[dims[0]];
+	for(unsigned int index1=0;index1<blockSize[dims[1]];++index1,base1+=voxelStrides[dims[1]])
+		{
+		/* Calculate the span's grid point positions: */
+		samplePos[dims[1]]=coords1[index1];
+		for(unsigned int index2=0;index2<spanSize;++index2)
+			{
+			samplePos[dims[2]]=coords2[index2];
+			spanPositions[index2]=samplePos;
+			}
+		
+		/* Locate the span's grid points and get their scalar values, tracing from the previous span: */
+		locator.calcValues(spanSize,spanPositions,sampleValid,scalarExtractor,spanValues,spanValids);
+		sampleValid=spanValids[spanSize-1];
+		
+		Voxel* base2=base1;
+		for(unsigned int i=0;i<spanSize;++i,base2+=voxelStrides[dims[2]])
+			{
+			if(spanValids[i])
+				{
+				/* Convert the grid point's scalar value: */
+				*base2=Voxel((spanValues[i]-minValue)*VScalar(255)/(maxValue-minValue)+VScalar(0.5));
+				}
+			else
+				{
+				/* Assign a default value: */
+				*base2=Voxel(0);
+				}
+			}
+		}
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam,class VoxelParam>
+inline
+void*
+VolumeRenderingSampler<DataSetParam>::SliceSampler<ScalarExtractorParam,VoxelParam>::samplerThreadMethod(
+	void)
+	{
+	/* Create a private locator and span buffers large enough for any voxel block: */
+	typename DataSet::Locator locator=sampler.dataSet.getLocator();
+	Point* spanPositions=new Point[maxSpanSize];
+	VScalar* spanValues=new VScalar[maxSpanSize];
+	bool* spanValids=new bool[maxSpanSize];
+	
+	while(true)
+		{
+		/* Grab the next unsampled slice, waiting for the next voxel block if all slices are taken: */
+		unsigned int sliceIndex;
+		{
+		Threads::Mutex::Lock sliceLock(sliceMutex);
+		while(!shutdown&&nextSliceIndex==numSlices)
+			blockCond.wait(sliceMutex);
+		if(shutdown)
+			break;
+		sliceIndex=nextSliceIndex;
+		++nextSliceIndex;
+		}
+		
+		/* Sample the slice: */
+		sampleSlice(sliceIndex,locator,spanPositions,spanValues,spanValids);
+		
+		/* Mark the slice as sampled: */
+		{
+		Threads::Mutex::Lock sliceLock(sliceMutex);
+		sliceFinisheds[sliceIndex]=true;
+		sliceCond.broadcast();
+		}
+		}
+	
+	delete[] spanPositions;
+	delete[] spanValues;
+	delete[] spanValids;
+	
+	return 0;
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam,class VoxelParam>
+inline
+void
+VolumeRenderingSampler<DataSetParam>::SliceSampler<ScalarExtractorParam,VoxelParam>::waitForSlice(
+	unsigned int sliceIndex)
+	{
+	Threads::Mutex::Lock sliceLock(sliceMutex);
+	while(!sliceFinisheds[sliceIndex])
+		sliceCond.wait(sliceMutex);
+	}
+
 /***************************************
 Methods of class VolumeRenderingSampler:
 ***************************************/
 
+template <class DataSetParam>
+inline
+void
+VolumeRenderingSampler<DataSetParam>::sortDimensions(
+	const ptrdiff_t voxelStrides[3],
+	int dims[3])
+	{
+	for(int i=0;i<3;++i)
+		dims[i]=i;
+	if(voxelStrides[dims[0]]<voxelStrides[dims[1]])
+		Misc::swap(dims[0],dims[1]);
+	if(voxelStrides[dims[1]]<voxelStrides[dims[2]])
+		Misc::swap(dims[1],dims[2]);
+	if(voxelStrides[dims[0]]<voxelStrides[dims[1]])
+		Misc::swap(dims[0],dims[1]);
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam>
+inline
+void
+VolumeRenderingSampler<DataSetParam>::calcValueRange(
+	const ScalarExtractorParam& scalarExtractor,
+	typename ScalarExtractorParam::Scalar& minValue,
+	typename ScalarExtractorParam::Scalar& maxValue) const
+	{
+	typedef typename ScalarExtractorParam::Scalar VScalar;
+	
+	typename DataSet::VertexIterator vIt=dataSet.beginVertices();
+	minValue=maxValue=vIt->getValue(scalarExtractor);
+	for(++vIt;vIt!=dataSet.endVertices();++vIt)
+		{
+		VScalar value=vIt->getValue(scalarExtractor);
+		if(minValue>value)
+			minValue=value;
+		if(maxValue<value)
+			maxValue=value;
+		}
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam,class VoxelParam>
+inline
+void
+VolumeRenderingSampler<DataSetParam>::sampleBlock(
+	typename VolumeRenderingSampler<DataSetParam>::template SliceSampler<ScalarExtractorParam,VoxelParam>& sliceSampler,
+	Comm::MulticastPipe* pipe,
+	float percentageScale,
+	float percentageOffset,
+	Visualization::Abstract::Algorithm* algorithm) const
+	{
+	typedef typename ScalarExtractorParam::Scalar VScalar;
+	typedef VoxelParam Voxel;
+	
+	const unsigned int* blockSize=sliceSampler.blockSize;
+	const ptrdiff_t* voxelStrides=sliceSampler.voxelStrides;
+	const int* dims=sliceSampler.dims;
+	
+	/* The current thread only samples if the slice sampler has no sampling threads: */
+	bool sampleLocally=sliceSampler.numSamplerThreads==0;
+	typename DataSet::Locator sampleLocator;
+	Point* spanPositions=0;
+	VScalar* spanValues=0;
+	bool* spanValids=0;
+	if(sampleLocally)
+		{
+		/* Create a locator and span buffers for the current thread: */
+		sampleLocator=dataSet.getLocator();
+		spanPositions=new Point[blockSize[dims[2]]];
+		spanValues=new VScalar[blockSize[dims[2]]];
+		spanValids=new bool[blockSize[dims[2]]];
+		}
+	Voxel* spanBuffer=0;
+	if(pipe!=0)
+		spanBuffer=new Voxel[blockSize[dims[2]]];
+	
+	/* Process the sampled slices in order: */
+	Voxel* base0=sliceSampler.voxels;
+	for(unsigned int index0=0;index0<blockSize[dims[0]];++index0,base0+=voxelStrides[dims[0]])
+		{
+		if(sampleLocally)
+			{
+			/* Sample the slice: */
+			sliceSampler.sampleSlice(index0,sampleLocator,spanPositions,spanValues,spanValids);
+			}
+		else
+			{
+			/* Wait until the sampling threads have finished the slice: */
+			sliceSampler.waitForSlice(index0);
+			}
+		
+		if(pipe!=0)
+			{
+			/* Write the slice's spans of voxels to the pipe: */
+			Voxel* base1=base0;
+			for(unsigned int index1=0;index1<blockSize[dims[1]];++index1,base1+=voxelStrides[dims[1]])
+				{
+				Voxel* base2=base1;
+				for(unsigned int i=0;i<blockSize[dims[2]];++i,base2+=voxelStrides[dims[2]])
+					spanBuffer[i]=*base2;
+				pipe->write<Voxel>(spanBuffer,blockSize[dims[2]]);
+				}
+			}
+		
+		/* Update the busy dialog: */
+		algorithm->callBusyFunction(float(index0+1)*percentageScale/float(blockSize[dims[0]])+percentageOffset);
+		}
+	
+	if(sampleLocally)
+		{
+		delete[] spanPositions;
+		delete[] spanValues;
+		delete[] spanValids;
+		}
+	delete[] spanBuffer;
+	}
+
+template <class DataSetParam>
+template <class VoxelParam>
+inline
+void
+VolumeRenderingSampler<DataSetParam>::receiveBlock(
+	const unsigned int blockSize[3],
+	VoxelParam* voxels,
+	const ptrdiff_t voxelStrides[3],
+	Comm::MulticastPipe* pipe,
+	float percentageScale,
+	float percentageOffset,
+	Visualization::Abstract::Algorithm* algorithm) const
+	{
+	typedef VoxelParam Voxel;
+	
+	/* Sort the voxel block's dimensions according to their stride values: */
+	int dims[3];
+	sortDimensions(voxelStrides,dims);
+	
+	/* Receive the resampled voxel block from the multicast pipe: */
+	Voxel* spanBuffer=new Voxel[blockSize[dims[2]]];
+	Voxel* base0=voxels;
+	for(unsigned int index0=0;index0<blockSize[dims[0]];++index0,base0+=voxelStrides[dims[0]])
+		{
+		Voxel* base1=base0;
+		for(unsigned int index1=0;index1<blockSize[dims[1]];++index1,base1+=voxelStrides[dims[1]])
+			{
+			/* Read a span of voxels: */
+			pipe->read<Voxel>(spanBuffer,blockSize[dims[2]]);
+			Voxel* base2=base1;
+			for(unsigned int i=0;i<blockSize[dims[2]];++i,base2+=voxelStrides[dims[2]])
+				*base2=spanBuffer[i];
+			}
+		
+		/* Update the busy dialog: */
+		algorithm->callBusyFunction(float(index0+1)*percentageScale/float(blockSize[dims[0]])+percentageOffset);
+		}
+	delete[] spanBuffer;
+	}
+
 template <class DataSetParam>
 inline
 VolumeRenderingSampler<DataSetParam>::VolumeRenderingSampler(
-	const typename VolumeRenderingSampler<DataSetParam>::DataSet& sDataSet)
+	const typename VolumeRenderingSampler<DataSetParam>::DataSet& sDataSet,
+	unsigned int maxSamplerSize)
 	:dataSet(sDataSet)
 	{
 	/* Calculate the optimal Cartesian volume size: */
@@ -51,7 +421,7 @@ VolumeRenderingSampler<DataSetParam>::VolumeRenderingSampler(
 		{
 		/* Find a power-of-two grid size that approximates the data set's average cell size: */
 		Scalar optSize=Scalar(2)*boxSize[i]/avgCellSize;
-		for(samplerSize[i]=2;samplerSize[i]<512&&Scalar(samplerSize[i])*Math::sqrt(Scalar(2))<optSize;samplerSize[i]<<=1)
+		for(samplerSize[i]=2;samplerSize[i]<maxSamplerSize&&Scalar(samplerSize[i])*Math::sqrt(Scalar(2))<optSize;samplerSize[i]<<=1)
 			;
 		samplerCellSize[i]=boxSize[i]/Scalar(samplerSize[i]-1);
 		}
@@ -71,104 +441,79 @@ VolumeRenderingSampler<DataSetParam>::sample(
 	Visualization::Abstract::Algorithm* algorithm) const
 	{
 	typedef typename ScalarExtractorParam::Scalar VScalar;
-	typedef VoxelParam Voxel;
-	
-	/* Sort the voxel block's dimensions according to their stride values: */
-	int dims[3];
-	for(int i=0;i<3;++i)
-		dims[i]=i;
-	if(voxelStrides[dims[0]]<voxelStrides[dims[1]])
-		Misc::swap(dims[0],dims[1]);
-	if(voxelStrides[dims[1]]<voxelStrides[dims[2]])
-		Misc::swap(dims[1],dims[2]);
-	if(voxelStrides[dims[0]]<voxelStrides[dims[1]])
-		Misc::swap(dims[0],dims[1]);
 	
 	/* Sample volume data on the master, and receive results on the slaves: */
-	Voxel* spanBuffer=0;
-	if(pipe!=0)
-		spanBuffer=new Voxel[samplerSize[dims[2]]];
 	if(pipe==0||pipe->isMaster())
 		{
 		/* Determine the data set's value range: */
 		VScalar minValue,maxValue;
-		typename DataSet::VertexIterator vIt=dataSet.beginVertices();
-		minValue=maxValue=vIt->getValue(scalarExtractor);
-		for(++vIt;vIt!=dataSet.endVertices();++vIt)
-			{
-			VScalar value=vIt->getValue(scalarExtractor);
-			if(minValue>value)
-				minValue=value;
-			if(maxValue<value)
-				maxValue=value;
-			}
+		calcValueRange(scalarExtractor,minValue,maxValue);
 		
-		/* Sample the data set's scalar values into the voxel block: */
-		typename DataSet::Locator sampleLocator=dataSet.getLocator();
-		bool sampleValid=false;
-		unsigned int index[3];
-		Point samplePos;
-		Voxel* base0;
-		for(index[dims[0]]=0,samplePos[dims[0]]=samplerOrigin[dims[0]],base0=voxels;index[dims[0]]<samplerSize[dims[0]];++index[dims[0]],samplePos[dims[0]]+=samplerCellSize[dims[0]],base0+=voxelStrides[dims[0]])
-			{
-			Voxel* base1;
-			for(index[dims[1]]=0,samplePos[dims[1]]=samplerOrigin[dims[1]],base1=base0;index[dims[1]]<samplerSize[dims[1]];++index[dims[1]],samplePos[dims[1]]+=samplerCellSize[dims[1]],base1+=voxelStrides[dims[1]])
-				{
-				Voxel* base2;
-				for(index[dims[2]]=0,samplePos[dims[2]]=samplerOrigin[dims[2]],base2=base1;index[dims[2]]<samplerSize[dims[2]];++index[dims[2]],samplePos[dims[2]]+=samplerCellSize[dims[2]],base2+=voxelStrides[dims[2]])
-					{
-					/* Locate the grid point: */
-					sampleValid=sampleLocator.locatePoint(samplePos,sampleValid);
-					if(sampleValid)
-						{
-						/* Get the vertex' scalar value: */
-						VScalar value=sampleLocator.calcValue(scalarExtractor);
-						*base2=Voxel((value-minValue)*VScalar(255)/(maxValue-minValue)+VScalar(0.5));
-						}
-					else
-						{
-						/* Assign a default value: */
-						*base2=Voxel(0);
-						}
-					}
-				
-				if(pipe!=0)
-					{
-					/* Write the most recent span of voxels to the pipe: */
-					base2=base1;
-					for(unsigned int i=0;i<samplerSize[dims[2]];++i,base2+=voxelStrides[dims[2]])
-						spanBuffer[i]=*base2;
-					pipe->write<Voxel>(spanBuffer,samplerSize[dims[2]]);
-					}
-				}
-			
-			/* Update the busy dialog: */
-			algorithm->callBusyFunction(float(index[dims[0]]+1)*percentageScale/float(samplerSize[dims[0]])+percentageOffset);
-			}
+		/* Sample the entire voxel block: */
+		SliceSampler<ScalarExtractorParam,VoxelParam> sliceSampler(*this,scalarExtractor,minValue,maxValue,algorithm->getNumThreads());
+		unsigned int blockOrigin[3]={0,0,0};
+		sliceSampler.setBlock(blockOrigin,samplerSize,voxels,voxelStrides);
+		sampleBlock(sliceSampler,pipe,percentageScale,percentageOffset,algorithm);
 		}
 	else
+		receiveBlock(samplerSize,voxels,voxelStrides,pipe,percentageScale,percentageOffset,algorithm);
+	}
+
+template <class DataSetParam>
+template <class ScalarExtractorParam>
+inline
+void
+VolumeRenderingSampler<DataSetParam>::sample(
+	const ScalarExtractorParam& scalarExtractor,
+	VoxelBrickStore& brickStore,
+	Comm::MulticastPipe* pipe,
+	float percentageScale,
+	float percentageOffset,
+	Visualization::Abstract::Algorithm* algorithm) const
+	{
+	typedef typename ScalarExtractorParam::Scalar VScalar;
+	typedef VoxelBrickStore::Voxel Voxel;
+	
+	/* Determine the data set's value range on the master: */
+	SliceSampler<ScalarExtractorParam,Voxel>* sliceSampler=0;
+	if(pipe==0||pipe->isMaster())
 		{
-		/* Receive the resampled data set from the multicast pipe: */
-		unsigned int index[3];
-		Voxel* base0;
-		for(index[dims[0]]=0,base0=voxels;index[dims[0]]<samplerSize[dims[0]];++index[dims[0]],base0+=voxelStrides[dims[0]])
-			{
-			Voxel* base1;
-			for(index[dims[1]]=0,base1=base0;index[dims[1]]<samplerSize[dims[1]];++index[dims[1]],base1+=voxelStrides[dims[1]])
+		VScalar minValue,maxValue;
+		calcValueRange(scalarExtractor,minValue,maxValue);
+		
+		/* Create a slice sampler whose sampling threads sample all bricks: */
+		sliceSampler=new SliceSampler<ScalarExtractorParam,Voxel>(*this,scalarExtractor,minValue,maxValue,algorithm->getNumThreads());
+		}
+	
+	/* Sample or receive the brick store one brick at a time: */
+	const unsigned int* numBricks=brickStore.getNumBricks();
+	float brickPercentageScale=percentageScale/float(brickStore.getTotalNumBricks());
+	unsigned int brickIndex[3];
+	size_t brickCounter=0;
+	for(brickIndex[2]=0;brickIndex[2]<numBricks[2];++brickIndex[2])
+		for(brickIndex[1]=0;brickIndex[1]<numBricks[1];++brickIndex[1])
+			for(brickIndex[0]=0;brickIndex[0]<numBricks[0];++brickIndex[0],++brickCounter)
 				{
-				/* Read a span of voxels: */
-				pipe->read<VoxelParam>(spanBuffer,samplerSize[dims[2]]);
-				Voxel* base2=base1;
-				for(unsigned int i=0;i<samplerSize[dims[2]];++i,base2+=voxelStrides[dims[2]])
-					*base2=spanBuffer[i];
+				/* Get the brick's layout: */
+				unsigned int brickOrigin[3],brickExtent[3];
+				brickStore.getBrickBox(brickIndex,brickOrigin,brickExtent);
+				ptrdiff_t brickStrides[3];
+				brickStore.getBrickStrides(brickIndex,brickStrides);
+				float brickPercentageOffset=percentageOffset+float(brickCounter)*brickPercentageScale;
+				
+				/* Fill the brick: */
+				Voxel* brickVoxels=brickStore.lockBrick(brickIndex,true);
+				if(sliceSampler!=0)
+					{
+					sliceSampler->setBlock(brickOrigin,brickExtent,brickVoxels,brickStrides);
+					sampleBlock(*sliceSampler,pipe,brickPercentageScale,brickPercentageOffset,algorithm);
+					}
+				else
+					receiveBlock(brickExtent,brickVoxels,brickStrides,pipe,brickPercentageScale,brickPercentageOffset,algorithm);
+				brickStore.unlockBrick(brickIndex);
 				}
-			
-			/* Update the busy dialog: */
-			algorithm->callBusyFunction(float(index[dims[0]]+1)*percentageScale/float(samplerSize[dims[0]])+percentageOffset);
-			}
-		}
-	if(pipe!=0)
-		delete[] spanBuffer;
+	
+	delete sliceSampler;
 	}
 
 }
@@ -23,10 +23,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_VOLUMERENDERINGSAMPLER_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_VOLUMERENDERINGSAMPLER_INCLUDED
 
+#include <stddef.h>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+
 /* Forward declarations: */
 namespace Comm {
 class MulticastPipe;
 }
+class VoxelBrickStore;
 namespace Visualization {
 namespace Abstract {
 class Algorithm;
@@ -48,16 +53,64 @@ class VolumeRenderingSampler
 	typedef typename DataSet::Box Box; // Type for domain boxes
 	typedef typename Box::Size Size; // Type for domain sizes
 	
-	/* Elements: */
 	private:
+	template <class ScalarExtractorParam,class VoxelParam>
+	class SliceSampler // Helper class to sample slices of a sequence of voxel blocks on a pool of threads
+		{
+		/* Embedded classes: */
+		public:
+		typedef typename ScalarExtractorParam::Scalar VScalar; // Value type of scalar extractor
+		
+		/* Elements: */
+		const VolumeRenderingSampler& sampler; // The volume rendering sampler
+		const ScalarExtractorParam& scalarExtractor; // The sampled scalar extractor
+		VScalar minValue,maxValue; // Scalar value range mapped to the voxel value range
+		unsigned int blockOrigin[3]; // Index of the voxel block's first grid point in the sampler's grid
+		unsigned int blockSize[3]; // Size of the voxel block
+		VoxelParam* voxels; // Pointer to the voxel block
+		const ptrdiff_t* voxelStrides; // Strides of the voxel block
+		int dims[3]; // Voxel block dimensions sorted by descending stride
+		Scalar* sampleCoords[3]; // Grid point coordinates along each dimension of the sampler's grid
+		unsigned int maxSpanSize; // Maximum number of grid points in a span of any voxel block
+		Threads::Mutex sliceMutex; // Mutex protecting the slice processing state
+		Threads::Cond blockCond; // Condition variable signalling a new voxel block or shutdown to the sampling threads
+		Threads::Cond sliceCond; // Condition variable signalling finished slices
+		unsigned int numSlices; // Number of slices in the current voxel block
+		unsigned int nextSliceIndex; // Index of the next slice to be sampled by any thread
+		bool* sliceFinisheds; // Flags for each slice whether it has been sampled
+		bool shutdown; // Flag to shut down the sampling threads
+		unsigned int numSamplerThreads; // Number of sampling threads; 0 if slices are sampled by the calling thread
+		Threads::Thread* samplerThreads; // Pool of sampling threads living as long as the slice sampler
+		
+		/* Constructors and destructors: */
+		SliceSampler(const VolumeRenderingSampler& sSampler,const ScalarExtractorParam& sScalarExtractor,VScalar sMinValue,VScalar sMaxValue,unsigned int sNumThreads); // Creates a slice sampler with a pool of the given number of sampling threads if more than one
+		~SliceSampler(void); // Shuts down the sampling threads
+		
+		/* Methods: */
+		void setBlock(const unsigned int sBlockOrigin[3],const unsigned int sBlockSize[3],VoxelParam* sVoxels,const ptrdiff_t* sVoxelStrides); // Selects the voxel block to be sampled next and wakes up the sampling threads; must not be called while a previous block is still being sampled
+		void sampleSlice(unsigned int sliceIndex,typename DataSet::Locator& locator,Point* spanPositions,VScalar* spanValues,bool* spanValids); // Samples the given slice of the voxel block using the given locator and span buffers
+		void* samplerThreadMethod(void); // Samples slices of each voxel block until shut down
+		void waitForSlice(unsigned int sliceIndex); // Blocks until the given slice has been sampled
+		};
+	
+	/* Elements: */
 	const DataSet& dataSet; // The data set from which the sampler samples
 	unsigned int samplerSize[3]; // Optimal size of the resulting Cartesian volume
 	Point samplerOrigin; // Origin point of the resulting Cartesian volume
 	Size samplerCellSize; // Cell size of the resulting Cartesian volume
 	
+	/* Private methods: */
+	static void sortDimensions(const ptrdiff_t voxelStrides[3],int dims[3]); // Sorts the dimensions of a voxel block by descending stride
+	template <class ScalarExtractorParam>
+	void calcValueRange(const ScalarExtractorParam& scalarExtractor,typename ScalarExtractorParam::Scalar& minValue,typename ScalarExtractorParam::Scalar& maxValue) const; // Calculates the range of scalar values of the given scalar extractor
+	template <class ScalarExtractorParam,class VoxelParam>
+	void sampleBlock(SliceSampler<ScalarExtractorParam,VoxelParam>& sliceSampler,Comm::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Samples the slice sampler's current voxel block and writes it to the given pipe in slice order
+	template <class VoxelParam>
+	void receiveBlock(const unsigned int blockSize[3],VoxelParam* voxels,const ptrdiff_t voxelStrides[3],Comm::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Reads a voxel block of the given size from the given pipe
+	
 	/* Constructors and destructors: */
 	public:
-	VolumeRenderingSampler(const DataSet& sDataSet); // Creates a sampler for the given data set
+	VolumeRenderingSampler(const DataSet& sDataSet,unsigned int maxSamplerSize =512); // Creates a sampler for the given data set, not exceeding the given size in any dimension
 	
 	/* Methods: */
 	const unsigned int* getSamplerSize(void) const // Returns the size of the resulting Cartesian volume
@@ -65,7 +118,9 @@ class VolumeRenderingSampler
 		return samplerSize;
 		}
 	template <class ScalarExtractorParam,class VoxelParam>
-	void sample(const ScalarExtractorParam& scalarExtractor,VoxelParam* voxels,const ptrdiff_t voxelStrides[3],Comm::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Samples scalar values from the given scalar extractor into the given voxel block
+	void sample(const ScalarExtractorParam& scalarExtractor,VoxelParam* voxels,const ptrdiff_t voxelStrides[3],Comm::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Samples scalar values from the given scalar extractor into the given voxel block, using as many threads as the given algorithm may use
+	template <class ScalarExtractorParam>
+	void sample(const ScalarExtractorParam& scalarExtractor,VoxelBrickStore& brickStore,Comm::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Samples scalar values from the given scalar extractor into the given brick store of the sampler's size, one brick at a time
 	};
 
 }
@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Templatized/VolumeRenderingSamplerCartesian.h>
 
 #include <Abstract/Algorithm.h>
+#include <VoxelBrickStore.h>
 #include <Templatized/Cartesian.h>
 
 namespace Visualization {
@@ -35,10 +36,34 @@ namespace Templatized {
 Methods of class VolumeRenderingSamplerCartesian:
 ************************************************/
 
+template <class ScalarParam,class ValueParam>
+template <class ScalarExtractorParam>
+inline
+void
+VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >::calcValueRange(
+	const ScalarExtractorParam& scalarExtractor,
+	typename ScalarExtractorParam::Scalar& minValue,
+	typename ScalarExtractorParam::Scalar& maxValue) const
+	{
+	typedef typename ScalarExtractorParam::Scalar VScalar;
+	
+	typename DataSet::VertexIterator vIt=dataSet.beginVertices();
+	minValue=maxValue=vIt->getValue(scalarExtractor);
+	for(++vIt;vIt!=dataSet.endVertices();++vIt)
+		{
+		VScalar value=vIt->getValue(scalarExtractor);
+		if(minValue>value)
+			minValue=value;
+		if(maxValue<value)
+			maxValue=value;
+		}
+	}
+
 template <class ScalarParam,class ValueParam>
 inline
 VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >::VolumeRenderingSampler(
-	const typename VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >::DataSet& sDataSet)
+	const typename VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >::DataSet& sDataSet,
+	unsigned int)
 	:dataSet(sDataSet)
 	{
 	/* Copy the original Cartesian volume size: */
@@ -64,16 +89,7 @@ VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >::sample(
 	
 	/* Determine the data set's value range: */
 	VScalar minValue,maxValue;
-	typename DataSet::VertexIterator vIt=dataSet.beginVertices();
-	minValue=maxValue=vIt->getValue(scalarExtractor);
-	for(++vIt;vIt!=dataSet.endVertices();++vIt)
-		{
-		VScalar value=vIt->getValue(scalarExtractor);
-		if(minValue>value)
-			minValue=value;
-		if(maxValue<value)
-			maxValue=value;
-		}
+	calcValueRange(scalarExtractor,minValue,maxValue);
 	
 	typename DataSet::Index index;
 	Voxel* vPtr0=voxels;
@@ -98,6 +114,68 @@ VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >::sample(
 		}
 	}
 
+template <class ScalarParam,class ValueParam>
+template <class ScalarExtractorParam>
+inline
+void
+VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >::sample(
+	const ScalarExtractorParam& scalarExtractor,
+	VoxelBrickStore& brickStore,
+	Comm::MulticastPipe*,
+	float percentageScale,
+	float percentageOffset,
+	Visualization::Abstract::Algorithm* algorithm) const
+	{
+	typedef typename ScalarExtractorParam::Scalar VScalar;
+	typedef VoxelBrickStore::Voxel Voxel;
+	
+	/* Determine the data set's value range: */
+	VScalar minValue,maxValue;
+	calcValueRange(scalarExtractor,minValue,maxValue);
+	
+	/* Copy the data set's vertex values into the brick store one brick at a time: */
+	const unsigned int* numBricks=brickStore.getNumBricks();
+	size_t totalNumBricks=brickStore.getTotalNumBricks();
+	unsigned int brickIndex[3];
+	size_t brickCounter=0;
+	for(brickIndex[2]=0;brickIndex[2]<numBricks[2];++brickIndex[2])
+		for(brickIndex[1]=0;brickIndex[1]<numBricks[1];++brickIndex[1])
+			for(brickIndex[0]=0;brickIndex[0]<numBricks[0];++brickIndex[0])
+				{
+				/* Get the brick's layout: */
+				unsigned int brickOrigin[3],brickExtent[3];
+				brickStore.getBrickBox(brickIndex,brickOrigin,brickExtent);
+				ptrdiff_t brickStrides[3];
+				brickStore.getBrickStrides(brickIndex,brickStrides);
+				
+				/* Fill the brick: */
+				Voxel* brickVoxels=brickStore.lockBrick(brickIndex,true);
+				typename DataSet::Index index;
+				Voxel* vPtr2=brickVoxels;
+				for(index[2]=brickOrigin[2];index[2]<int(brickOrigin[2]+brickExtent[2]);++index[2],vPtr2+=brickStrides[2])
+					{
+					Voxel* vPtr1=vPtr2;
+					for(index[1]=brickOrigin[1];index[1]<int(brickOrigin[1]+brickExtent[1]);++index[1],vPtr1+=brickStrides[1])
+						{
+						Voxel* vPtr0=vPtr1;
+						for(index[0]=brickOrigin[0];index[0]<int(brickOrigin[0]+brickExtent[0]);++index[0],vPtr0+=brickStrides[0])
+							{
+							/* Get the vertex' scalar value: */
+							VScalar value=scalarExtractor.getValue(dataSet.getVertexValue(index));
+							
+							/* Convert the value to unsigned char: */
+							*vPtr0=Voxel((value-minValue)*VScalar(255)/(maxValue-minValue)+VScalar(0.5));
+							}
+						}
+					}
+				brickStore.unlockBrick(brickIndex);
+				
+				/* Update the busy dialog: */
+				++brickCounter;
+				algorithm->callBusyFunction(float(brickCounter)*percentageScale/float(totalNumBricks)+percentageOffset);
+				}
+	}
+
 }
 
 }
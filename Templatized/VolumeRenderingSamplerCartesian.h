@@ -29,6 +29,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 namespace Comm {
 class MulticastPipe;
 }
+class VoxelBrickStore;
 namespace Visualization {
 namespace Abstract {
 class Algorithm;
@@ -59,9 +60,13 @@ class VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >
 	const DataSet& dataSet; // The data set from which the sampler samples
 	unsigned int samplerSize[3]; // Size of the Cartesian volume
 	
+	/* Private methods: */
+	template <class ScalarExtractorParam>
+	void calcValueRange(const ScalarExtractorParam& scalarExtractor,typename ScalarExtractorParam::Scalar& minValue,typename ScalarExtractorParam::Scalar& maxValue) const; // Calculates the range of scalar values of the given scalar extractor
+	
 	/* Constructors and destructors: */
 	public:
-	VolumeRenderingSampler(const DataSet& sDataSet); // Creates a sampler for the given data set
+	VolumeRenderingSampler(const DataSet& sDataSet,unsigned int maxSamplerSize =512); // Creates a sampler for the given data set; always uses the data set's native size
 	
 	/* Methods: */
 	const unsigned int* getSamplerSize(void) const // Returns the size of the Cartesian volume
@@ -70,6 +75,8 @@ class VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >
 		}
 	template <class ScalarExtractorParam,class VoxelParam>
 	void sample(const ScalarExtractorParam& scalarExtractor,VoxelParam* voxels,const ptrdiff_t voxelStrides[3],Comm::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Samples scalar values from the given scalar extractor into the given voxel block
+	template <class ScalarExtractorParam>
+	void sample(const ScalarExtractorParam& scalarExtractor,VoxelBrickStore& brickStore,Comm::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Samples scalar values from the given scalar extractor into the given brick store of the sampler's size, one brick at a time
 	};
 
 }
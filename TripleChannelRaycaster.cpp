@@ -133,6 +133,7 @@ void TripleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const R
 	/* Bind the color map textures: */
 	GLint colorMapSamplers[3];
 	GLint channelEnabledsValues[3];
+	float channelOpacities[3][256];
 	for(int channel=0;channel<3;++channel)
 		{
 		channelEnabledsValues[channel]=channelEnableds[channel]?1:0;
@@ -146,13 +147,29 @@ void TripleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const R
 		adjustedColorMap.changeTransparency(stepSize*transparencyGammas[channel]);
 		adjustedColorMap.premultiplyAlpha();
 		glTexImage1D(GL_TEXTURE_1D,0,myDataItem->haveFloatTextures?GL_RGBA32F_ARB:GL_RGBA,256,0,GL_RGBA,GL_FLOAT,adjustedColorMap.getColors());
+		
+		/* Remember the channel's opacities to classify the macro cells: */
+		for(int i=0;i<256;++i)
+			channelOpacities[channel][i]=channelEnableds[channel]?adjustedColorMap.getColors()[i].getRgba()[3]:0.0f;
 		}
 	glUniform1ivARB(myDataItem->channelEnabledsLoc,3,channelEnabledsValues);
 	glUniform1ivARB(myDataItem->colorMapSamplersLoc,3,colorMapSamplers);
+	
+	/* Reclassify the macro cells if any channel's transparent entries changed: */
+	const float* opacities[3];
+	for(int channel=0;channel<3;++channel)
+		opacities[channel]=channelOpacities[channel];
+	macroCellGrid.classify(opacities,1);
+	
+	/* Bind the macro cell occupancy texture: */
+	bindMacroCells(myDataItem,5);
 	}
 
 void TripleChannelRaycaster::unbindShader(Raycaster::DataItem* dataItem) const
 	{
+	/* Unbind the macro cell occupancy texture: */
+	unbindMacroCells(dataItem,5);
+	
 	/* Unbind the color map textures: */
 	for(int channel=0;channel<3;++channel)
 		{
@@ -169,7 +186,7 @@ void TripleChannelRaycaster::unbindShader(Raycaster::DataItem* dataItem) const
 	}
 
 TripleChannelRaycaster::TripleChannelRaycaster(const unsigned int sDataSize[3],const Raycaster::Box& sDomain)
-	:Raycaster(sDataSize,sDomain),
+	:Raycaster(sDataSize,sDomain,3),
 	 data(new Voxel[dataSize[0]*dataSize[1]*dataSize[2]*3]),dataVersion(0)
 	{
 	/* Multiply the data stride values with the number of channels: */
@@ -221,6 +238,12 @@ void TripleChannelRaycaster::setStepSize(Raycaster::Scalar newStepSize)
 
 void TripleChannelRaycaster::updateData(void)
 	{
+	/* Recalculate the macro cells' value ranges for all channels: */
+	macroCellGrid.resetRanges();
+	unsigned int blockOrigin[3]={0,0,0};
+	for(int channel=0;channel<3;++channel)
+		macroCellGrid.updateRanges(channel,blockOrigin,dataSize,data+channel,dataStrides);
+	
 	/* Bump up the data version number: */
 	++dataVersion;
 	}
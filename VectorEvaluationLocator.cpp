@@ -50,8 +50,10 @@ Methods of class VectorEvaluationLocator:
 
 VectorEvaluationLocator::VectorEvaluationLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* sApplication)
 	:EvaluationLocator(sLocatorTool,sApplication,"Vector Evaluation Dialog"),
-	 vectorExtractor(application->variableManager->getCurrentVectorExtractor()),
-	 scalarExtractor(application->variableManager->getCurrentScalarExtractor()),
+	 vectorVariableIndex(application->variableManager->getCurrentVectorVariable()),
+	 scalarVariableIndex(application->variableManager->getCurrentScalarVariable()),
+	 vectorExtractor(application->variableManager->getVectorExtractor(vectorVariableIndex)),
+	 scalarExtractor(application->variableManager->getScalarExtractor(scalarVariableIndex)),
 	 colorMap(application->variableManager->getCurrentColorMap()),
 	 valueValid(false),
 	 arrowLengthScale(1)
@@ -165,6 +167,17 @@ void VectorEvaluationLocator::highlightLocator(GLContextData& contextData) const
 		}
 	}
 
+void VectorEvaluationLocator::dataSetChanged(void)
+	{
+	/* Call the base class method: */
+	EvaluationLocator::dataSetChanged();
+	
+	/* Get the vector and scalar extractors for the new data set: */
+	vectorExtractor=application->variableManager->getVectorExtractor(vectorVariableIndex);
+	scalarExtractor=application->variableManager->getScalarExtractor(scalarVariableIndex);
+	valueValid=false;
+	}
+
 void VectorEvaluationLocator::arrowScaleSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData)
 	{
 	/* Get the new slider value and convert to step size: */
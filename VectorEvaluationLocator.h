@@ -46,6 +46,8 @@ class VectorEvaluationLocator:public EvaluationLocator
 	typedef VectorExtractor::Vector Vector;
 	
 	/* Elements: */
+	int vectorVariableIndex; // Index of the evaluated vector variable
+	int scalarVariableIndex; // Index of the evaluated scalar variable
 	const VectorExtractor* vectorExtractor; // Extractor for the evaluated vector value
 	const ScalarExtractor* scalarExtractor; // Extractor for the evaluated scalar value (to color arrow rendering)
 	const GLColorMap* colorMap; // Color map for the evaluated scalar value
@@ -67,6 +69,7 @@ class VectorEvaluationLocator:public EvaluationLocator
 	
 	/* Methods from class BaseLocator: */
 	virtual void highlightLocator(GLContextData& contextData) const;
+	virtual void dataSetChanged(void);
 	
 	/* New methods: */
 	void arrowScaleSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
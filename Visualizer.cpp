@@ -51,6 +51,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GLMotif/TextField.h>
 #include <GLMotif/Button.h>
 #include <GLMotif/CascadeButton.h>
+#include <GLMotif/Slider.h>
 #include <Vrui/Vrui.h>
 #ifdef VISUALIZER_USE_COLLABORATION
 #include <Collaboration/CollaborationClient.h>
@@ -62,6 +63,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
 #include <Abstract/Module.h>
+#include <Abstract/TimeVaryingDataSet.h>
 
 #include "CuttingPlane.h"
 #ifdef VISUALIZER_USE_COLLABORATION
@@ -73,6 +75,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "VectorEvaluationLocator.h"
 #include "ExtractorLocator.h"
 #include "ElementList.h"
+#include "ElementLoader.h"
+#include "VoxelBrickStore.h"
+#ifdef VISUALIZATION_USE_SHADERS
+#include "SingleChannelRaycaster.h"
+#endif
 
 namespace {
 
@@ -220,7 +227,7 @@ GLMotif::Popup* Visualizer::createAlgorithmsMenu(void)
 			++algorithmIndex;
 			}
 		}
-		
+	
 	algorithms->setSelectedToggle(algorithm);
 	algorithms->getValueChangedCallbacks().add(this,&Visualizer::changeAlgorithmCallback);
 	
@@ -357,6 +364,12 @@ GLMotif::PopupMenu* Visualizer::createMainMenu(void)
 	GLMotif::CascadeButton* colorCascade=new GLMotif::CascadeButton("ColorCascade",mainMenu,"Color Maps");
 	colorCascade->setPopup(createColorMenu());
 	
+	if(timeVaryingDataSet!=0)
+		{
+		GLMotif::ToggleButton* showTimeStepDialogToggle=new GLMotif::ToggleButton("ShowTimeStepDialogToggle",mainMenu,"Show Time Step Dialog");
+		showTimeStepDialogToggle->getValueChangedCallbacks().add(this,&Visualizer::showTimeStepDialogCallback);
+		}
+	
 	GLMotif::Button* centerDisplayButton=new GLMotif::Button("CenterDisplayButton",mainMenu,"Center Display");
 	centerDisplayButton->getSelectCallbacks().add(this,&Visualizer::centerDisplayCallback);
 	
@@ -365,177 +378,101 @@ GLMotif::PopupMenu* Visualizer::createMainMenu(void)
 	return mainMenuPopup;
 	}
 
+GLMotif::PopupWindow* Visualizer::createTimeStepDialog(void)
+	{
+	const GLMotif::StyleSheet& ss=*Vrui::getWidgetManager()->getStyleSheet();
+	
+	GLMotif::PopupWindow* timeStepDialogPopup=new GLMotif::PopupWindow("TimeStepDialogPopup",Vrui::getWidgetManager(),"Time Step");
+	
+	GLMotif::RowColumn* timeStepDialog=new GLMotif::RowColumn("TimeStepDialog",timeStepDialogPopup,false);
+	timeStepDialog->setOrientation(GLMotif::RowColumn::HORIZONTAL);
+	timeStepDialog->setPacking(GLMotif::RowColumn::PACK_TIGHT);
+	
+	GLMotif::Button* previousTimeStepButton=new GLMotif::Button("PreviousTimeStepButton",timeStepDialog,"<");
+	previousTimeStepButton->getSelectCallbacks().add(this,&Visualizer::previousTimeStepCallback);
+	
+	timeStepIndexValue=new GLMotif::TextField("TimeStepIndexValue",timeStepDialog,8);
+	
+	timeStepSlider=new GLMotif::Slider("TimeStepSlider",timeStepDialog,GLMotif::Slider::HORIZONTAL,ss.fontHeight*15.0f);
+	timeStepSlider->setValueRange(0.0,double(timeVaryingDataSet->getNumTimeSteps()-1),1.0);
+	timeStepSlider->getValueChangedCallbacks().add(this,&Visualizer::timeStepSliderCallback);
+	
+	GLMotif::Button* nextTimeStepButton=new GLMotif::Button("NextTimeStepButton",timeStepDialog,">");
+	nextTimeStepButton->getSelectCallbacks().add(this,&Visualizer::nextTimeStepCallback);
+	
+	timeStepDialog->manageChild();
+	
+	/* Show the current time step: */
+	updateTimeStepDialog();
+	
+	return timeStepDialogPopup;
+	}
+
+void Visualizer::updateTimeStepDialog(void)
+	{
+	unsigned int currentTimeStep=timeVaryingDataSet->getCurrentTimeStep();
+	timeStepIndexValue->setValue(timeVaryingDataSet->getTimeStepIndex(currentTimeStep));
+	timeStepSlider->setValue(double(currentTimeStep));
+	}
+
 void Visualizer::loadElements(const char* elementFileName,bool ascii)
 	{
-	/* Open a pipe for cluster communication: */
-	Comm::MulticastPipe* pipe=Vrui::openPipe();
+	/* Read the element file and extract its visualization elements on the element loader's threads: */
+	elementLoader->loadElements(elementFileName,ascii);
+	}
+
+void Visualizer::setTimeStep(unsigned int newTimeStep)
+	{
+	if(newTimeStep==timeVaryingDataSet->getCurrentTimeStep())
+		return;
 	
-	if(pipe==0||pipe->isMaster())
+	try
 		{
-		/* Open the element file: */
-		Misc::File elementFile(elementFileName,ascii?"r":"rb",ascii?Misc::File::DontCare:Misc::File::LittleEndian);
+		/* Get the new time step from the time step cache, or load it if it is not cached: */
+		DataSet* newDataSet=timeVaryingDataSet->getTimeStep(newTimeStep);
 		
-		/* Read all elements from the file: */
-		while(true)
-			{
-			/* Read the next algorithm name: */
-			unsigned int nameLength=0;
-			char name[256];
-			if(ascii)
-				{
-				/* Skip whitespace: */
-				int nextChar;
-				while((nextChar=elementFile.getc())!=EOF&&isspace(nextChar))
-					;
-				
-				/* Read until end of line: */
-				while(nextChar!='\n'&&nextChar!=EOF)
-					{
-					name[nameLength]=char(nextChar);
-					++nameLength;
-					nextChar=elementFile.getc();
-					}
-				
-				if(nextChar==EOF) // Check for end-of-file indicator
-					{
-					/* Tell the slaves to bail out: */
-					if(pipe!=0)
-						pipe->write<unsigned int>(0);
-					
-					/* Bail out: */
-					break;
-					}
-				
-				/* Remove trailing whitespace: */
-				while(isspace(name[nameLength-1]))
-					--nameLength;
-				}
-			else
-				{
-				nameLength=elementFile.read<unsigned int>();
-				if(nameLength==0) // Check for end-of-file indicator
-					{
-					/* Tell the slaves to bail out: */
-					if(pipe!=0)
-						pipe->write<unsigned int>(0);
-					
-					/* Bail out: */
-					break;
-					}
-				elementFile.read(name,nameLength);
-				}
-			name[nameLength]='\0';
-			
-			if(pipe!=0)
-				{
-				/* Send the algorithm name to the slaves: */
-				pipe->write<unsigned int>(nameLength);
-				pipe->write(name,nameLength);
-				}
-			
-			/* Create an extractor for the given name: */
-			Algorithm* algorithm=0;
-			for(int i=0;algorithm==0&&i<module->getNumScalarAlgorithms();++i)
-				if(strcmp(name,module->getScalarAlgorithmName(i))==0)
-					algorithm=module->getScalarAlgorithm(i,variableManager,Vrui::openPipe());
-			for(int i=0;algorithm==0&&i<module->getNumVectorAlgorithms();++i)
-				if(strcmp(name,module->getVectorAlgorithmName(i))==0)
-					algorithm=module->getVectorAlgorithm(i,variableManager,Vrui::openPipe());
-			
-			/* Extract an element using the given extractor: */
-			if(algorithm!=0)
-				{
-				std::cout<<"Creating "<<name<<"..."<<std::flush;
-				Misc::Timer extractionTimer;
-				
-				/* Read the element's extraction parameters from the file: */
-				Parameters* parameters=algorithm->cloneParameters();
-				parameters->read(elementFile,ascii,variableManager);
-				
-				if(pipe!=0)
-					{
-					/* Send the extraction parameters to the slaves: */
-					parameters->write(*pipe,variableManager);
-					pipe->finishMessage();
-					}
-				
-				/* Extract the element: */
-				Element* element=algorithm->createElement(parameters);
-				
-				/* Store the element: */
-				elementList->addElement(element,name);
-				
-				/* Destroy the extractor: */
-				delete algorithm;
-				
-				extractionTimer.elapse();
-				std::cout<<" done in "<<extractionTimer.getTime()*1000.0<<" ms"<<std::endl;
-				}
-			}
+		/* Wait for all visualization elements still being loaded: */
+		elementLoader->deliverElements(*elementList,true);
+		
+		/* Switch to the new time step: */
+		variableManager->setDataSet(newDataSet);
+		dataSet=newDataSet;
+		int renderingMode=dataSetRenderer->getRenderingMode();
+		delete dataSetRenderer;
+		dataSetRenderer=module->getRenderer(dataSet);
+		dataSetRenderer->setRenderingMode(renderingMode);
+		for(BaseLocatorList::iterator blIt=baseLocators.begin();blIt!=baseLocators.end();++blIt)
+			(*blIt)->dataSetChanged();
+		timeVaryingDataSet->setCurrentTimeStep(newTimeStep);
+		
+		/* Re-extract all visible elements from the new time step, using copies of their extraction parameters: */
+		elementLoader->reloadElements(*elementList);
+		elementList->clear();
 		}
-	else
+	catch(const std::runtime_error& err)
 		{
-		/* Receive all visualization elements from the master: */
-		while(true)
-			{
-			/* Receive the algorithm name from the master: */
-			unsigned int nameLength=pipe->read<unsigned int>();
-			if(nameLength==0) // Check for end-of-file indicator
-				break;
-			char name[256];
-			pipe->read(name,nameLength);
-			name[nameLength]=0;
-			
-			/* Create an extractor for the given name: */
-			Algorithm* algorithm=0;
-			for(int i=0;algorithm==0&&i<module->getNumScalarAlgorithms();++i)
-				if(strcmp(name,module->getScalarAlgorithmName(i))==0)
-					algorithm=module->getScalarAlgorithm(i,variableManager,Vrui::openPipe());
-			for(int i=0;algorithm==0&&i<module->getNumVectorAlgorithms();++i)
-				if(strcmp(name,module->getVectorAlgorithmName(i))==0)
-					algorithm=module->getVectorAlgorithm(i,variableManager,Vrui::openPipe());
-			
-			/* Extract an element using the given extractor: */
-			if(algorithm!=0)
-				{
-				/* Receive the extraction parameters: */
-				Parameters* parameters=algorithm->cloneParameters();
-				parameters->read(*pipe,variableManager);
-				
-				/* Receive the element: */
-				Element* element=algorithm->startSlaveElement(parameters);
-				algorithm->continueSlaveElement();
-				
-				/* Store the element: */
-				elementList->addElement(element,name);
-				
-				/* Destroy the extractor: */
-				delete algorithm;
-				}
-			}
+		std::cerr<<"Caught exception "<<err.what()<<" while changing to time step "<<timeVaryingDataSet->getTimeStepIndex(newTimeStep)<<std::endl;
 		}
 	
-	if(pipe!=0)
-		{
-		/* Close the communication pipe: */
-		delete pipe;
-		}
+	updateTimeStepDialog();
+	Vrui::requestUpdate();
 	}
 
 Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	:Vrui::Application(argc,argv,appDefaults),
 	 moduleManager(VISUALIZER_MODULENAMETEMPLATE),
-	 module(0),dataSet(0),variableManager(0),
+	 module(0),timeVaryingDataSet(0),dataSet(0),variableManager(0),
 	 dataSetRenderer(0),coordinateTransformer(0),
 	 firstScalarAlgorithmIndex(0),firstVectorAlgorithmIndex(0),
 	 #ifdef VISUALIZER_USE_COLLABORATION
 	 collaborationClient(0),sharedVisualizationClient(0),
 	 #endif
 	 numCuttingPlanes(0),cuttingPlanes(0),
-	 elementList(0),
+	 elementList(0),elementLoader(0),
 	 algorithm(0),
 	 mainMenu(0),
 	 showElementListToggle(0),
+	 timeStepDialogPopup(0),timeStepIndexValue(0),timeStepSlider(0),
 	 inLoadPalette(false),inLoadElements(false)
 	{
 	/* Parse the command line: */
@@ -543,6 +480,10 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	std::vector<std::string> dataSetArgs;
 	const char* argColorMapName=0;
 	std::vector<const char*> loadFileNames;
+	unsigned int numElementLoadThreads=0;
+	bool timeVarying=false;
+	int firstTimeStepIndex=0,lastTimeStepIndex=0,timeStepIndexIncrement=1;
+	unsigned int maxNumCachedTimeSteps=3;
 	for(int i=1;i<argc;++i)
 		{
 		if(argv[i][0]=='-')
@@ -580,6 +521,126 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 				else
 					std::cerr<<"Missing element file name after -load"<<std::endl;
 				}
+			else if(strcasecmp(argv[i]+1,"threads")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the number of threads used to extract visualization elements: */
+					Algorithm::setDefaultNumThreads((unsigned int)atoi(argv[i]));
+					}
+				else
+					std::cerr<<"Missing number of threads after -threads"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"elementThreads")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the number of threads used to extract visualization elements loaded from element files: */
+					numElementLoadThreads=(unsigned int)atoi(argv[i]);
+					}
+				else
+					std::cerr<<"Missing number of threads after -elementThreads"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"loadThreads")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the number of threads used to read data set source files: */
+					Visualization::Abstract::Module::setNumLoadThreads((unsigned int)atoi(argv[i]));
+					}
+				else
+					std::cerr<<"Missing number of threads after -loadThreads"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"streamPrecision")==0)
+				{
+				if(i+2<argc)
+					{
+					/* Set the quantization precision of visualization elements streamed to the slave nodes: */
+					Algorithm::setElementStreamPrecision((unsigned int)atoi(argv[i+1]),(unsigned int)atoi(argv[i+2]));
+					i+=2;
+					}
+				else
+					{
+					std::cerr<<"Missing position and normal bits after -streamPrecision"<<std::endl;
+					i=argc;
+					}
+				}
+			else if(strcasecmp(argv[i]+1,"localSlaveExtraction")==0)
+				{
+				/* Let the slave nodes extract visualization elements of deterministic algorithms themselves: */
+				Algorithm::setLocalSlaveExtraction(true);
+				}
+			else if(strcasecmp(argv[i]+1,"gradientCacheSize")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Let each data set cache the vertex gradients of its scalar variables in up to the given number of megabytes: */
+					DataSet::setGradientCacheBudget(size_t(atoi(argv[i]))*size_t(1024*1024));
+					}
+				else
+					std::cerr<<"Missing cache size in megabytes after -gradientCacheSize"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"timeSteps")==0)
+				{
+				if(i+3<argc)
+					{
+					/* Load a sequence of time steps by replacing the time step placeholder in the data set arguments: */
+					timeVarying=true;
+					firstTimeStepIndex=atoi(argv[i+1]);
+					lastTimeStepIndex=atoi(argv[i+2]);
+					timeStepIndexIncrement=atoi(argv[i+3]);
+					i+=3;
+					}
+				else
+					{
+					std::cerr<<"Missing time step range after -timeSteps"<<std::endl;
+					i=argc;
+					}
+				}
+			else if(strcasecmp(argv[i]+1,"timeStepCache")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the maximum number of loaded time steps to keep in memory: */
+					maxNumCachedTimeSteps=(unsigned int)atoi(argv[i]);
+					}
+				else
+					std::cerr<<"Missing number of time steps after -timeStepCache"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"volumeMemory")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the memory budget in megabytes for bricked volume renderer voxel blocks: */
+					VoxelBrickStore::setDefaultMemoryBudget(size_t(atoi(argv[i]))*size_t(1024*1024));
+					}
+				else
+					std::cerr<<"Missing memory size after -volumeMemory"<<std::endl;
+				}
+			#ifdef VISUALIZATION_USE_SHADERS
+			else if(strcasecmp(argv[i]+1,"volumeTextureMemory")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the memory budget in megabytes for the brick textures of bricked volume renderers in each OpenGL context: */
+					SingleChannelRaycaster::setBrickTextureMemory(size_t(atoi(argv[i]))*size_t(1024*1024));
+					}
+				else
+					std::cerr<<"Missing memory size after -volumeTextureMemory"<<std::endl;
+				}
+			#endif
+			else if(strcasecmp(argv[i]+1,"noCache")==0)
+				{
+				/* Always parse data set source files, and do not write data set cache files: */
+				Visualization::Abstract::DataSetCache::setEnabled(false);
+				}
 			#ifdef VISUALIZER_USE_COLLABORATION
 			else if(strcasecmp(argv[i]+1,"share")==0)
 				{
@@ -641,7 +702,7 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 				std::string arg=readToken(inputFile,nextChar);
 				if(arg=="")
 					break;
-
+				
 				/* Store the argument in the list: */
 				dataSetArgs.push_back(arg);
 				}
@@ -663,7 +724,15 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 		/* Load a data set: */
 		Misc::Timer t;
 		Comm::MulticastPipe* pipe=Vrui::openPipe(); // Implicit synchronization point
-		dataSet=module->load(dataSetArgs,pipe);
+		if(timeVarying)
+			{
+			/* Create a time-varying data set and load its first time step: */
+			timeVaryingDataSet=new TimeVaryingDataSet(module,dataSetArgs,firstTimeStepIndex,lastTimeStepIndex,timeStepIndexIncrement,maxNumCachedTimeSteps,pipe==0||pipe->isMaster());
+			dataSet=timeVaryingDataSet->getTimeStep(0);
+			timeVaryingDataSet->setCurrentTimeStep(0);
+			}
+		else
+			dataSet=module->loadCached(dataSetArgs,pipe);
 		delete pipe; // Implicit synchronization point
 		t.elapse();
 		if(Vrui::isMaster())
@@ -721,9 +790,16 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	mainMenu=createMainMenu();
 	Vrui::setMainMenu(mainMenu);
 	
+	/* Create the time step dialog: */
+	if(timeVaryingDataSet!=0)
+		timeStepDialogPopup=createTimeStepDialog();
+	
 	/* Create the element list: */
 	elementList=new ElementList(Vrui::getWidgetManager());
 	
+	/* Create the element loader: */
+	elementLoader=new ElementLoader(module,variableManager,Vrui::openPipe(),numElementLoadThreads);
+	
 	/* Load all element files listed on the command line: */
 	for(std::vector<const char*>::const_iterator lfnIt=loadFileNames.begin();lfnIt!=loadFileNames.end();++lfnIt)
 		{
@@ -748,6 +824,9 @@ Visualizer::~Visualizer(void)
 	{
 	delete mainMenu;
 	
+	/* Stop loading visualization elements: */
+	delete elementLoader;
+	
 	/* Delete all finished visualization elements: */
 	delete elementList;
 	
@@ -773,7 +852,14 @@ Visualizer::~Visualizer(void)
 	delete variableManager;
 	
 	/* Delete the data set: */
-	delete dataSet;
+	if(timeVaryingDataSet!=0)
+		{
+		/* Delete the time step dialog and all cached time steps: */
+		delete timeStepDialogPopup;
+		delete timeVaryingDataSet;
+		}
+	else
+		delete dataSet;
 	}
 
 void Visualizer::toolCreationCallback(Vrui::ToolManager::ToolCreationCallbackData* cbData)
@@ -838,6 +924,12 @@ void Visualizer::toolDestructionCallback(Vrui::ToolManager::ToolDestructionCallb
 
 void Visualizer::frame(void)
 	{
+	/* Add all visualization elements finished by the element loader to the element list: */
+	elementLoader->deliverElements(*elementList,false);
+	
+	/* Update all visualization elements: */
+	elementList->frame();
+	
 	#ifdef VISUALIZER_USE_COLLABORATION
 	if(collaborationClient!=0)
 		{
@@ -884,7 +976,7 @@ void Visualizer::display(GLContextData& contextData) const
 	elementList->renderElements(contextData,false);
 	for(BaseLocatorList::const_iterator blIt=baseLocators.begin();blIt!=baseLocators.end();++blIt)
 		(*blIt)->glRenderAction(contextData);
-
+	
 	/* Render all transparent visualization elements: */
 	elementList->renderElements(contextData,true);
 	for(BaseLocatorList::const_iterator blIt=baseLocators.begin();blIt!=baseLocators.end();++blIt)
@@ -1093,6 +1185,34 @@ void Visualizer::centerDisplayCallback(Misc::CallbackData*)
 	Vrui::setNavigationTransformation(center,radius);
 	}
 
+void Visualizer::showTimeStepDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	/* Hide or show the time step dialog based on toggle button state: */
+	if(cbData->set)
+		Vrui::popupPrimaryWidget(timeStepDialogPopup,Vrui::getNavigationTransformation().transform(Vrui::getDisplayCenter()));
+	else
+		Vrui::popdownPrimaryWidget(timeStepDialogPopup);
+	}
+
+void Visualizer::timeStepSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData)
+	{
+	setTimeStep((unsigned int)(cbData->value+0.5));
+	}
+
+void Visualizer::previousTimeStepCallback(Misc::CallbackData*)
+	{
+	unsigned int currentTimeStep=timeVaryingDataSet->getCurrentTimeStep();
+	if(currentTimeStep>0)
+		setTimeStep(currentTimeStep-1);
+	}
+
+void Visualizer::nextTimeStepCallback(Misc::CallbackData*)
+	{
+	unsigned int currentTimeStep=timeVaryingDataSet->getCurrentTimeStep();
+	if(currentTimeStep+1<timeVaryingDataSet->getNumTimeSteps())
+		setTimeStep(currentTimeStep+1);
+	}
+
 int main(int argc,char* argv[])
 	{
 	try
@@ -60,6 +60,7 @@ class Algorithm;
 class Element;
 class CoordinateTransformer;
 class Module;
+class TimeVaryingDataSet;
 }
 }
 struct CuttingPlane;
@@ -70,6 +71,7 @@ class SharedVisualizationClient;
 #endif
 class BaseLocator;
 class ElementList;
+class ElementLoader;
 
 class Visualizer:public Vrui::Application
 	{
@@ -83,6 +85,7 @@ class Visualizer:public Vrui::Application
 	typedef Visualization::Abstract::Element Element;
 	typedef Visualization::Abstract::CoordinateTransformer CoordinateTransformer;
 	typedef Visualization::Abstract::Module Module;
+	typedef Visualization::Abstract::TimeVaryingDataSet TimeVaryingDataSet;
 	typedef Plugins::FactoryManager<Module> ModuleManager;
 	
 	typedef std::vector<BaseLocator*> BaseLocatorList;
@@ -101,7 +104,8 @@ class Visualizer:public Vrui::Application
 	private:
 	ModuleManager moduleManager; // Manager to load 3D visualization modules from dynamic libraries
 	Module* module; // Visualization module
-	DataSet* dataSet; // Data set to visualize
+	TimeVaryingDataSet* timeVaryingDataSet; // Sequence of time steps of the data set, or null if the data set is not time-varying
+	DataSet* dataSet; // Data set to visualize; owned by the time-varying data set if there is one
 	VariableManager* variableManager; // Manager to organize data sets and scalar and vector variables
 	GLColor<GLfloat,4> dataSetRenderColor; // Color to use when rendering the data set
 	DataSetRenderer* dataSetRenderer; // Renderer for the data set
@@ -116,9 +120,13 @@ class Visualizer:public Vrui::Application
 	CuttingPlane* cuttingPlanes; // Array of available cutting planes
 	BaseLocatorList baseLocators; // List of active locators
 	ElementList* elementList; // List of previously extracted visualization elements
+	ElementLoader* elementLoader; // Loader re-extracting visualization elements from element files in the background
 	int algorithm; // The currently selected algorithm
 	GLMotif::PopupMenu* mainMenu; // The main menu widget
 	GLMotif::ToggleButton* showElementListToggle; // Toggle button to show the element list dialog
+	GLMotif::PopupWindow* timeStepDialogPopup; // Dialog to select the current time step of a time-varying data set
+	GLMotif::TextField* timeStepIndexValue; // Text field showing the time step index of the current time step
+	GLMotif::Slider* timeStepSlider; // Slider to select the current time step
 	
 	/* Lock flags for modal dialogs: */
 	bool inLoadPalette; // Flag whether the user is currently selecting a palette to load
@@ -134,7 +142,10 @@ class Visualizer:public Vrui::Application
 	GLMotif::Popup* createStandardSaturationPalettesMenu(void);
 	GLMotif::Popup* createColorMenu(void);
 	GLMotif::PopupMenu* createMainMenu(void);
-	void loadElements(const char* elementFileName,bool ascii); // Loads all visualization elements defined in the given file
+	GLMotif::PopupWindow* createTimeStepDialog(void);
+	void updateTimeStepDialog(void); // Updates the time step dialog to show the current time step
+	void loadElements(const char* elementFileName,bool ascii); // Queues all visualization elements defined in the given file for extraction in the background
+	void setTimeStep(unsigned int newTimeStep); // Switches to the given time step of a time-varying data set and re-extracts all visible visualization elements
 	
 	/* Constructors and destructors: */
 	public:
@@ -166,6 +177,10 @@ class Visualizer:public Vrui::Application
 	void saveElementsCallback(Misc::CallbackData* cbData);
 	void clearElementsCallback(Misc::CallbackData* cbData);
 	void centerDisplayCallback(Misc::CallbackData* cbData);
+	void showTimeStepDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
+	void timeStepSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
+	void previousTimeStepCallback(Misc::CallbackData* cbData);
+	void nextTimeStepCallback(Misc::CallbackData* cbData);
 	};
 
 #endif
@@ -0,0 +1,282 @@
+/***********************************************************************
+VoxelBrickStore - Class to store large voxel blocks as fixed-size bricks
+that are paged in and out of a swap file to keep the set of resident
+bricks within a memory budget.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <VoxelBrickStore.h>
+
+#include <sys/types.h>
+#include <string.h>
+#include <Misc/ThrowStdErr.h>
+
+/****************************************
+Static elements of class VoxelBrickStore:
+****************************************/
+
+size_t VoxelBrickStore::defaultMemoryBudget=0;
+
+/********************************
+Methods of class VoxelBrickStore:
+********************************/
+
+size_t VoxelBrickStore::getBrickLinearIndex(const unsigned int brickIndex[3]) const
+	{
+	return (size_t(brickIndex[2])*size_t(numBricks[1])+size_t(brickIndex[1]))*size_t(numBricks[0])+size_t(brickIndex[0]);
+	}
+
+void VoxelBrickStore::evictBricks(size_t requiredSize)
+	{
+	/* Exceed the memory budget if all resident bricks are locked: */
+	while(memoryBudget!=0&&residentSize+requiredSize>memoryBudget&&!lruList.empty())
+		{
+		/* Take the least-recently used unlocked resident brick off the eviction list: */
+		size_t brickLinearIndex=lruList.front();
+		lruList.pop_front();
+		std::vector<Brick>::iterator victim=bricks.begin()+brickLinearIndex;
+		
+		/* Calculate the victim's size: */
+		unsigned int brickIndex[3];
+		brickIndex[0]=(unsigned int)(brickLinearIndex%numBricks[0]);
+		brickIndex[1]=(unsigned int)((brickLinearIndex/numBricks[0])%numBricks[1]);
+		brickIndex[2]=(unsigned int)(brickLinearIndex/(size_t(numBricks[0])*size_t(numBricks[1])));
+		unsigned int brickOrigin[3],brickExtent[3];
+		getBrickBox(brickIndex,brickOrigin,brickExtent);
+		size_t victimVoxels=size_t(brickExtent[0])*size_t(brickExtent[1])*size_t(brickExtent[2]);
+		
+		if(victim->dirty)
+			{
+			/* Write the victim's voxels to its slot in the swap file: */
+			if(fseeko(swapFile,off_t(brickLinearIndex)*off_t(brickVoxels*sizeof(Voxel)),SEEK_SET)!=0||fwrite(victim->voxels,sizeof(Voxel),victimVoxels,swapFile)!=victimVoxels)
+				Misc::throwStdErr("VoxelBrickStore::evictBricks: Error while writing brick to swap file");
+			victim->swapped=true;
+			victim->dirty=false;
+			}
+		
+		/* Release the victim's memory: */
+		delete[] victim->voxels;
+		victim->voxels=0;
+		residentSize-=victimVoxels*sizeof(Voxel);
+		++numEvictions;
+		}
+	}
+
+VoxelBrickStore::VoxelBrickStore(const unsigned int sSize[3],unsigned int sBrickSize,size_t sMemoryBudget)
+	:brickSize(sBrickSize),brickVoxels(size_t(brickSize)*size_t(brickSize)*size_t(brickSize)),
+	 memoryBudget(sMemoryBudget),
+	 residentSize(0),
+	 swapFile(0),
+	 numLoads(0),numEvictions(0)
+	{
+	/* Calculate the number of bricks: */
+	size_t totalNumBricks=1;
+	for(int i=0;i<3;++i)
+		{
+		size[i]=sSize[i];
+		numBricks[i]=(size[i]+brickSize-1)/brickSize;
+		totalNumBricks*=size_t(numBricks[i]);
+		}
+	
+	/* Initialize the page table: */
+	Brick emptyBrick;
+	emptyBrick.voxels=0;
+	emptyBrick.dirty=false;
+	emptyBrick.swapped=false;
+	emptyBrick.lockCount=0;
+	bricks.resize(totalNumBricks,emptyBrick);
+	
+	if(memoryBudget!=0)
+		{
+		/* Create the swap file: */
+		swapFile=tmpfile();
+		if(swapFile==0)
+			Misc::throwStdErr("VoxelBrickStore::VoxelBrickStore: Unable to create swap file");
+		}
+	}
+
+VoxelBrickStore::~VoxelBrickStore(void)
+	{
+	/* Delete all resident bricks: */
+	for(std::vector<Brick>::iterator bIt=bricks.begin();bIt!=bricks.end();++bIt)
+		delete[] bIt->voxels;
+	
+	/* Close and thereby delete the swap file: */
+	if(swapFile!=0)
+		fclose(swapFile);
+	}
+
+void VoxelBrickStore::setDefaultMemoryBudget(size_t newDefaultMemoryBudget)
+	{
+	defaultMemoryBudget=newDefaultMemoryBudget;
+	}
+
+void VoxelBrickStore::getBrickBox(const unsigned int brickIndex[3],unsigned int brickOrigin[3],unsigned int brickExtent[3]) const
+	{
+	for(int i=0;i<3;++i)
+		{
+		brickOrigin[i]=brickIndex[i]*brickSize;
+		brickExtent[i]=size[i]-brickOrigin[i];
+		if(brickExtent[i]>brickSize)
+			brickExtent[i]=brickSize;
+		}
+	}
+
+void VoxelBrickStore::getBrickStrides(const unsigned int brickIndex[3],ptrdiff_t brickStrides[3]) const
+	{
+	unsigned int brickOrigin[3],brickExtent[3];
+	getBrickBox(brickIndex,brickOrigin,brickExtent);
+	ptrdiff_t stride=1;
+	for(int i=0;i<3;++i)
+		{
+		brickStrides[i]=stride;
+		stride*=ptrdiff_t(brickExtent[i]);
+		}
+	}
+
+VoxelBrickStore::Voxel* VoxelBrickStore::lockBrick(const unsigned int brickIndex[3],bool write)
+	{
+	Threads::Mutex::Lock brickLock(brickMutex);
+	
+	size_t brickLinearIndex=getBrickLinearIndex(brickIndex);
+	Brick& brick=bricks[brickLinearIndex];
+	if(brick.voxels!=0)
+		{
+		/* Take a resident unlocked brick off the eviction list: */
+		if(brick.lockCount==0)
+			lruList.erase(brick.lruPos);
+		}
+	else
+		{
+		/* Make room for the brick: */
+		unsigned int brickOrigin[3],brickExtent[3];
+		getBrickBox(brickIndex,brickOrigin,brickExtent);
+		size_t numVoxels=size_t(brickExtent[0])*size_t(brickExtent[1])*size_t(brickExtent[2]);
+		evictBricks(numVoxels*sizeof(Voxel));
+		
+		/* Page the brick in: */
+		brick.voxels=new Voxel[numVoxels];
+		residentSize+=numVoxels*sizeof(Voxel);
+		if(brick.swapped)
+			{
+			/* Read the brick's voxels from its slot in the swap file: */
+			if(fseeko(swapFile,off_t(brickLinearIndex)*off_t(brickVoxels*sizeof(Voxel)),SEEK_SET)!=0||fread(brick.voxels,sizeof(Voxel),numVoxels,swapFile)!=numVoxels)
+				Misc::throwStdErr("VoxelBrickStore::lockBrick: Error while reading brick from swap file");
+			++numLoads;
+			}
+		else
+			{
+			/* Initialize a never-written brick: */
+			memset(brick.voxels,0,numVoxels*sizeof(Voxel));
+			}
+		}
+	
+	/* Lock the brick: */
+	++brick.lockCount;
+	if(write)
+		brick.dirty=true;
+	
+	return brick.voxels;
+	}
+
+void VoxelBrickStore::unlockBrick(const unsigned int brickIndex[3])
+	{
+	Threads::Mutex::Lock brickLock(brickMutex);
+	
+	/* Release the lock: */
+	size_t brickLinearIndex=getBrickLinearIndex(brickIndex);
+	Brick& brick=bricks[brickLinearIndex];
+	if(--brick.lockCount==0)
+		{
+		/* Append the brick to the eviction list as the most recently used brick: */
+		brick.lruPos=lruList.insert(lruList.end(),brickLinearIndex);
+		}
+	
+	/* Evict bricks if the store exceeded its memory budget while the brick was locked: */
+	evictBricks(0);
+	}
+
+bool VoxelBrickStore::isResident(const unsigned int brickIndex[3])
+	{
+	Threads::Mutex::Lock brickLock(brickMutex);
+	
+	return bricks[getBrickLinearIndex(brickIndex)].voxels!=0;
+	}
+
+VoxelBrickStore::Voxel VoxelBrickStore::getVoxel(const unsigned int index[3])
+	{
+	/* Find the brick containing the voxel and the voxel's position inside the brick: */
+	unsigned int brickIndex[3];
+	for(int i=0;i<3;++i)
+		brickIndex[i]=index[i]/brickSize;
+	ptrdiff_t brickStrides[3];
+	getBrickStrides(brickIndex,brickStrides);
+	ptrdiff_t offset=0;
+	for(int i=0;i<3;++i)
+		offset+=ptrdiff_t(index[i]%brickSize)*brickStrides[i];
+	
+	/* Read the voxel: */
+	Voxel result=lockBrick(brickIndex,false)[offset];
+	unlockBrick(brickIndex);
+	return result;
+	}
+
+void VoxelBrickStore::copyBox(const unsigned int boxOrigin[3],const unsigned int boxSize[3],VoxelBrickStore::Voxel* dest,const ptrdiff_t destStrides[3])
+	{
+	/* Find the range of bricks overlapping the box: */
+	unsigned int brickMin[3],brickMax[3];
+	for(int i=0;i<3;++i)
+		{
+		if(boxSize[i]==0)
+			return;
+		brickMin[i]=boxOrigin[i]/brickSize;
+		brickMax[i]=(boxOrigin[i]+boxSize[i]-1)/brickSize;
+		}
+	
+	/* Copy the overlap of the box with each brick: */
+	unsigned int brickIndex[3];
+	for(brickIndex[2]=brickMin[2];brickIndex[2]<=brickMax[2];++brickIndex[2])
+		for(brickIndex[1]=brickMin[1];brickIndex[1]<=brickMax[1];++brickIndex[1])
+			for(brickIndex[0]=brickMin[0];brickIndex[0]<=brickMax[0];++brickIndex[0])
+				{
+				/* Calculate the overlap of the box and the brick: */
+				unsigned int brickOrigin[3],brickExtent[3];
+				getBrickBox(brickIndex,brickOrigin,brickExtent);
+				ptrdiff_t brickStrides[3];
+				getBrickStrides(brickIndex,brickStrides);
+				unsigned int overlapMin[3],overlapMax[3];
+				for(int i=0;i<3;++i)
+					{
+					overlapMin[i]=boxOrigin[i]>brickOrigin[i]?boxOrigin[i]:brickOrigin[i];
+					overlapMax[i]=boxOrigin[i]+boxSize[i]<brickOrigin[i]+brickExtent[i]?boxOrigin[i]+boxSize[i]:brickOrigin[i]+brickExtent[i];
+					}
+				
+				/* Copy the overlap one voxel row at a time: */
+				const Voxel* brickVoxels=lockBrick(brickIndex,false);
+				for(unsigned int z=overlapMin[2];z<overlapMax[2];++z)
+					for(unsigned int y=overlapMin[1];y<overlapMax[1];++y)
+						{
+						const Voxel* sPtr=brickVoxels+(ptrdiff_t(overlapMin[0]-brickOrigin[0])*brickStrides[0]+ptrdiff_t(y-brickOrigin[1])*brickStrides[1]+ptrdiff_t(z-brickOrigin[2])*brickStrides[2]);
+						Voxel* dPtr=dest+(ptrdiff_t(overlapMin[0]-boxOrigin[0])*destStrides[0]+ptrdiff_t(y-boxOrigin[1])*destStrides[1]+ptrdiff_t(z-boxOrigin[2])*destStrides[2]);
+						for(unsigned int x=overlapMin[0];x<overlapMax[0];++x,++sPtr,dPtr+=destStrides[0])
+							*dPtr=*sPtr;
+						}
+				unlockBrick(brickIndex);
+				}
+	}
@@ -0,0 +1,128 @@
+/***********************************************************************
+VoxelBrickStore - Class to store large voxel blocks as fixed-size bricks
+that are paged in and out of a swap file to keep the set of resident
+bricks within a memory budget.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VOXELBRICKSTORE_INCLUDED
+#define VOXELBRICKSTORE_INCLUDED
+
+#include <stddef.h>
+#include <stdio.h>
+#include <list>
+#include <vector>
+#include <Threads/Mutex.h>
+
+class VoxelBrickStore
+	{
+	/* Embedded classes: */
+	public:
+	typedef unsigned char Voxel; // Type for voxel data
+	
+	private:
+	typedef std::list<size_t> BrickList; // Type for lists of bricks identified by page table index
+	
+	struct Brick // Structure for page table entries
+		{
+		/* Elements: */
+		public:
+		Voxel* voxels; // Pointer to the brick's voxels if the brick is resident; null otherwise
+		bool dirty; // Flag whether the brick's resident voxels differ from its swapped-out voxels
+		bool swapped; // Flag whether the brick's voxels have ever been written to the swap file
+		unsigned int lockCount; // Number of outstanding locks on the brick; locked bricks are never evicted
+		BrickList::iterator lruPos; // Position of the brick in the eviction list if the brick is resident and unlocked
+		};
+	
+	/* Elements: */
+	static size_t defaultMemoryBudget; // Memory budget for newly created brick stores in bytes; zero means no bricking
+	unsigned int size[3]; // Size of the entire voxel block
+	unsigned int brickSize; // Edge length of a full brick in voxels
+	unsigned int numBricks[3]; // Number of bricks in each dimension
+	size_t brickVoxels; // Number of voxels in a full brick
+	size_t memoryBudget; // Maximum total size of resident bricks in bytes; zero means unlimited
+	Threads::Mutex brickMutex; // Mutex serializing access to the page table
+	std::vector<Brick> bricks; // Page table of all bricks in x-fastest order
+	size_t residentSize; // Total size of all resident bricks in bytes
+	BrickList lruList; // List of resident unlocked bricks, from least to most recently used
+	FILE* swapFile; // Temporary file receiving evicted bricks; null if the memory budget is unlimited
+	size_t numLoads; // Number of bricks read back from the swap file
+	size_t numEvictions; // Number of bricks evicted from memory
+	
+	/* Private methods: */
+	size_t getBrickLinearIndex(const unsigned int brickIndex[3]) const; // Returns the page table index of the given brick
+	void evictBricks(size_t requiredSize); // Evicts least-recently used unlocked bricks until the given number of bytes fits into the memory budget
+	
+	/* Constructors and destructors: */
+	public:
+	VoxelBrickStore(const unsigned int sSize[3],unsigned int sBrickSize,size_t sMemoryBudget); // Creates an all-zero voxel block of the given size, using bricks of the given edge length and the given memory budget
+	private:
+	VoxelBrickStore(const VoxelBrickStore& source); // Prohibit copy constructor
+	VoxelBrickStore& operator=(const VoxelBrickStore& source); // Prohibit assignment operator
+	public:
+	~VoxelBrickStore(void); // Destroys the brick store and its swap file
+	
+	/* Methods: */
+	static size_t getDefaultMemoryBudget(void) // Returns the memory budget for newly created brick stores
+		{
+		return defaultMemoryBudget;
+		}
+	static void setDefaultMemoryBudget(size_t newDefaultMemoryBudget); // Sets the memory budget for subsequently created brick stores
+	const unsigned int* getSize(void) const // Returns the size of the voxel block
+		{
+		return size;
+		}
+	unsigned int getBrickSize(void) const // Returns the edge length of a full brick
+		{
+		return brickSize;
+		}
+	const unsigned int* getNumBricks(void) const // Returns the number of bricks in each dimension
+		{
+		return numBricks;
+		}
+	size_t getTotalNumBricks(void) const // Returns the total number of bricks
+		{
+		return bricks.size();
+		}
+	void getBrickBox(const unsigned int brickIndex[3],unsigned int brickOrigin[3],unsigned int brickExtent[3]) const; // Returns the index of the given brick's first voxel and the brick's size, which is smaller than a full brick along the voxel block's upper faces
+	void getBrickStrides(const unsigned int brickIndex[3],ptrdiff_t brickStrides[3]) const; // Returns the voxel strides of the given brick
+	bool isResident(const unsigned int brickIndex[3]); // Returns true if the given brick is currently held in memory
+	size_t getMemoryBudget(void) const // Returns the memory budget
+		{
+		return memoryBudget;
+		}
+	size_t getResidentSize(void) const // Returns the total size of all resident bricks
+		{
+		return residentSize;
+		}
+	size_t getNumLoads(void) const // Returns the number of bricks read back from the swap file so far
+		{
+		return numLoads;
+		}
+	size_t getNumEvictions(void) const // Returns the number of bricks evicted from memory so far
+		{
+		return numEvictions;
+		}
+	Voxel* lockBrick(const unsigned int brickIndex[3],bool write); // Makes the given brick resident and locks it; marks the brick as modified if write is true; returns pointer to the brick's voxels
+	void unlockBrick(const unsigned int brickIndex[3]); // Releases a lock on the given brick
+	Voxel getVoxel(const unsigned int index[3]); // Returns the voxel of the given index
+	void copyBox(const unsigned int boxOrigin[3],const unsigned int boxSize[3],Voxel* dest,const ptrdiff_t destStrides[3]); // Copies the voxels of the given box, which may span several bricks, into the given voxel array
+	};
+
+#endif
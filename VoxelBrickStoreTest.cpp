@@ -0,0 +1,245 @@
+/***********************************************************************
+VoxelBrickStoreTest - Headless program to check brick building, least-
+recently used eviction, and voxel lookup of the memory-budgeted voxel
+brick store on an analytically defined voxel block.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <vector>
+#include <iostream>
+#include <Misc/Timer.h>
+
+#include <VoxelBrickStore.h>
+
+typedef VoxelBrickStore::Voxel Voxel;
+
+Voxel voxelValue(unsigned int x,unsigned int y,unsigned int z) // Returns the analytic value of the voxel of the given index
+	{
+	return Voxel((x*7U+y*13U+z*29U+(x*y*z>>3))&0xffU);
+	}
+
+bool check(bool condition,const char* description,unsigned int& numFailures) // Reports the outcome of a single check
+	{
+	std::cout<<(condition?"  passed: ":"  FAILED: ")<<description<<std::endl;
+	if(!condition)
+		++numFailures;
+	return condition;
+	}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	unsigned int size[3]={150,101,77}; // Size of the tested voxel block, deliberately not a multiple of the brick size
+	unsigned int brickSize=16; // Edge length of a full brick
+	unsigned int budgetBricks=8; // Memory budget in full bricks
+	unsigned int numBoxes=1000; // Number of random voxel boxes copied out of the store
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"size")==0)
+				{
+				if(i+3<argc)
+					{
+					for(int j=0;j<3;++j)
+						size[j]=(unsigned int)atoi(argv[i+1+j]);
+					i+=3;
+					}
+				else
+					{
+					std::cerr<<"VoxelBrickStoreTest: ignored dangling -size option"<<std::endl;
+					i=argc;
+					}
+				}
+			else if(strcasecmp(argv[i]+1,"brickSize")==0)
+				{
+				++i;
+				if(i<argc)
+					brickSize=(unsigned int)atoi(argv[i]);
+				else
+					std::cerr<<"VoxelBrickStoreTest: ignored dangling -brickSize option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"budget")==0)
+				{
+				++i;
+				if(i<argc)
+					budgetBricks=(unsigned int)atoi(argv[i]);
+				else
+					std::cerr<<"VoxelBrickStoreTest: ignored dangling -budget option"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"boxes")==0)
+				{
+				++i;
+				if(i<argc)
+					numBoxes=(unsigned int)atoi(argv[i]);
+				else
+					std::cerr<<"VoxelBrickStoreTest: ignored dangling -boxes option"<<std::endl;
+				}
+			else
+				std::cerr<<"VoxelBrickStoreTest: ignored unrecognized option "<<argv[i]<<std::endl;
+			}
+		}
+	if(brickSize<2||budgetBricks<2||budgetBricks>=64)
+		{
+		std::cerr<<"VoxelBrickStoreTest: invalid test parameters"<<std::endl;
+		return 1;
+		}
+	for(int i=0;i<3;++i)
+		if(size[i]<brickSize*3)
+			{
+			std::cerr<<"VoxelBrickStoreTest: voxel block must be at least three bricks wide"<<std::endl;
+			return 1;
+			}
+	
+	/* Create a brick store whose budget only holds a few full bricks: */
+	size_t fullBrickSize=size_t(brickSize)*size_t(brickSize)*size_t(brickSize)*sizeof(Voxel);
+	VoxelBrickStore store(size,brickSize,size_t(budgetBricks)*fullBrickSize);
+	const unsigned int* numBricks=store.getNumBricks();
+	std::cout<<"Voxel block        : "<<size[0]<<"x"<<size[1]<<"x"<<size[2]<<" voxels, "<<numBricks[0]<<"x"<<numBricks[1]<<"x"<<numBricks[2]<<" bricks of "<<brickSize<<"^3"<<std::endl;
+	std::cout<<"Memory budget      : "<<budgetBricks<<" full bricks, "<<store.getMemoryBudget()<<" bytes"<<std::endl;
+	
+	unsigned int numFailures=0;
+	
+	/* Build the voxel block one brick at a time, as the volume rendering sampler does: */
+	std::cout<<"Brick building:"<<std::endl;
+	Misc::Timer buildTimer;
+	unsigned int brickIndex[3];
+	for(brickIndex[2]=0;brickIndex[2]<numBricks[2];++brickIndex[2])
+		for(brickIndex[1]=0;brickIndex[1]<numBricks[1];++brickIndex[1])
+			for(brickIndex[0]=0;brickIndex[0]<numBricks[0];++brickIndex[0])
+				{
+				unsigned int brickOrigin[3],brickExtent[3];
+				store.getBrickBox(brickIndex,brickOrigin,brickExtent);
+				ptrdiff_t brickStrides[3];
+				store.getBrickStrides(brickIndex,brickStrides);
+				Voxel* brickVoxels=store.lockBrick(brickIndex,true);
+				for(unsigned int z=0;z<brickExtent[2];++z)
+					for(unsigned int y=0;y<brickExtent[1];++y)
+						for(unsigned int x=0;x<brickExtent[0];++x)
+							brickVoxels[x*brickStrides[0]+y*brickStrides[1]+z*brickStrides[2]]=voxelValue(brickOrigin[0]+x,brickOrigin[1]+y,brickOrigin[2]+z);
+				store.unlockBrick(brickIndex);
+				}
+	buildTimer.elapse();
+	std::cout<<"  build time       : "<<buildTimer.getTime()*1000.0<<" ms"<<std::endl;
+	check(store.getResidentSize()<=store.getMemoryBudget(),"resident bricks fit into the memory budget after building",numFailures);
+	check(store.getNumEvictions()>0,"bricks beyond the budget were evicted while building",numFailures);
+	
+	/* Look up every voxel and compare against the analytic values: */
+	std::cout<<"Voxel lookup:"<<std::endl;
+	size_t numLoadsBefore=store.getNumLoads();
+	Misc::Timer lookupTimer;
+	size_t numMismatches=0;
+	unsigned int index[3];
+	for(index[2]=0;index[2]<size[2];++index[2])
+		for(index[1]=0;index[1]<size[1];++index[1])
+			for(index[0]=0;index[0]<size[0];++index[0])
+				if(store.getVoxel(index)!=voxelValue(index[0],index[1],index[2]))
+					++numMismatches;
+	lookupTimer.elapse();
+	std::cout<<"  lookup time      : "<<lookupTimer.getTime()*1000.0<<" ms, "<<store.getNumLoads()-numLoadsBefore<<" bricks read back"<<std::endl;
+	check(numMismatches==0,"every voxel reads back its written value through the swap file",numFailures);
+	check(store.getNumLoads()>numLoadsBefore,"evicted bricks were read back from the swap file",numFailures);
+	check(store.getResidentSize()<=store.getMemoryBudget(),"resident bricks fit into the memory budget after lookup",numFailures);
+	
+	/* Copy random boxes spanning several bricks, with a one-voxel border like the renderer's texture bricks: */
+	std::cout<<"Box copies:"<<std::endl;
+	srand(1);
+	Misc::Timer copyTimer;
+	size_t numBoxMismatches=0;
+	std::vector<Voxel> boxVoxels;
+	for(unsigned int boxIndex=0;boxIndex<numBoxes;++boxIndex)
+		{
+		unsigned int boxOrigin[3],boxSize[3];
+		ptrdiff_t boxStrides[3];
+		ptrdiff_t stride=1;
+		for(int i=0;i<3;++i)
+			{
+			boxSize[i]=1+(unsigned int)(rand()%int(brickSize*2+1));
+			boxOrigin[i]=(unsigned int)(rand()%int(size[i]-boxSize[i]+1));
+			boxStrides[i]=stride;
+			stride*=ptrdiff_t(boxSize[i]);
+			}
+		boxVoxels.resize(size_t(stride));
+		store.copyBox(boxOrigin,boxSize,&boxVoxels[0],boxStrides);
+		for(unsigned int z=0;z<boxSize[2];++z)
+			for(unsigned int y=0;y<boxSize[1];++y)
+				for(unsigned int x=0;x<boxSize[0];++x)
+					if(boxVoxels[x*boxStrides[0]+y*boxStrides[1]+z*boxStrides[2]]!=voxelValue(boxOrigin[0]+x,boxOrigin[1]+y,boxOrigin[2]+z))
+						++numBoxMismatches;
+		}
+	copyTimer.elapse();
+	std::cout<<"  copy time        : "<<copyTimer.getTime()*1000.0<<" ms for "<<numBoxes<<" boxes"<<std::endl;
+	check(numBoxMismatches==0,"boxes copied across brick boundaries match the analytic values",numFailures);
+	
+	/* Check that eviction picks the least-recently used brick: */
+	std::cout<<"Eviction order:"<<std::endl;
+	std::vector<unsigned int> interiorBricks; // Linear indices of full bricks in the store's lowest layer of bricks
+	for(unsigned int y=0;y<numBricks[1]-1&&interiorBricks.size()<budgetBricks+1;++y)
+		for(unsigned int x=0;x<numBricks[0]-1&&interiorBricks.size()<budgetBricks+1;++x)
+			interiorBricks.push_back(y*numBricks[0]+x);
+	if(check(interiorBricks.size()==budgetBricks+1,"voxel block has enough full bricks to fill the budget",numFailures))
+		{
+		unsigned int bricks[64][3];
+		for(unsigned int i=0;i<=budgetBricks;++i)
+			{
+			bricks[i][0]=interiorBricks[i]%numBricks[0];
+			bricks[i][1]=interiorBricks[i]/numBricks[0];
+			bricks[i][2]=0;
+			}
+		
+		/* Make the first budget's worth of full bricks resident, oldest first, then touch the oldest brick again: */
+		for(unsigned int i=0;i<budgetBricks;++i)
+			{
+			store.lockBrick(bricks[i],false);
+			store.unlockBrick(bricks[i]);
+			}
+		store.lockBrick(bricks[0],false);
+		store.unlockBrick(bricks[0]);
+		
+		/* Page in one more brick: */
+		store.lockBrick(bricks[budgetBricks],false);
+		store.unlockBrick(bricks[budgetBricks]);
+		check(store.isResident(bricks[0]),"recently touched brick survives eviction",numFailures);
+		check(!store.isResident(bricks[1]),"least-recently used brick is evicted first",numFailures);
+		
+		/* Lock a brick and sweep the entire store past it: */
+		Voxel* lockedVoxels=store.lockBrick(bricks[2],false);
+		for(brickIndex[2]=0;brickIndex[2]<numBricks[2];++brickIndex[2])
+			for(brickIndex[1]=0;brickIndex[1]<numBricks[1];++brickIndex[1])
+				for(brickIndex[0]=0;brickIndex[0]<numBricks[0];++brickIndex[0])
+					{
+					store.lockBrick(brickIndex,false);
+					store.unlockBrick(brickIndex);
+					}
+		check(store.isResident(bricks[2])&&lockedVoxels[0]==voxelValue(bricks[2][0]*brickSize,bricks[2][1]*brickSize,0),"locked brick is never evicted",numFailures);
+		store.unlockBrick(bricks[2]);
+		check(store.getResidentSize()<=store.getMemoryBudget(),"resident bricks fit into the memory budget after unlocking",numFailures);
+		}
+	
+	std::cout<<"Total              : "<<store.getNumEvictions()<<" evictions, "<<store.getNumLoads()<<" loads"<<std::endl;
+	if(numFailures!=0)
+		{
+		std::cout<<numFailures<<" check(s) failed"<<std::endl;
+		return 1;
+		}
+	std::cout<<"All checks passed"<<std::endl;
+	return 0;
+	}
@@ -300,6 +300,49 @@ const char* ArrowRakeExtractor<DataSetWrapperParam>::name="Arrow Rake";
 Methods of class ArrowRakeExtractor:
 ***********************************/
 
+template <class DataSetWrapperParam>
+inline
+void
+ArrowRakeExtractor<DataSetWrapperParam>::calcArrows(
+	typename ArrowRakeExtractor<DataSetWrapperParam>::Parameters* extractParameters,
+	typename ArrowRakeExtractor<DataSetWrapperParam>::Rake& rake)
+	{
+	/* Calculate the arrow base points in rake order: */
+	size_t numArrows=extractParameters->rakeSize.calcIncrement(-1);
+	Point* bases=new Point[numArrows];
+	Point* bPtr=bases;
+	for(Index index(0);index[0]<extractParameters->rakeSize[0];index.preInc(extractParameters->rakeSize),++bPtr)
+		{
+		*bPtr=extractParameters->base;
+		for(int i=0;i<2;++i)
+			*bPtr+=extractParameters->frame[i]*(Scalar(index[i])*extractParameters->cellSize[i]);
+		}
+	
+	/* Locate all arrow base points once, and evaluate the vector and color scalar variables at each: */
+	typename VE::DestValue* directions=new typename VE::DestValue[numArrows];
+	typename SE::DestValue* scalarValues=new typename SE::DestValue[numArrows];
+	bool* valids=new bool[numArrows];
+	extractParameters->dsl.calcValues(numArrows,bases,false,*extractParameters->ve,directions,*extractParameters->cse,scalarValues,valids);
+	
+	/* Store the arrows in the rake: */
+	size_t arrowIndex=0;
+	for(Index index(0);index[0]<extractParameters->rakeSize[0];index.preInc(extractParameters->rakeSize),++arrowIndex)
+		{
+		Arrow& arrow=rake(index);
+		arrow.base=bases[arrowIndex];
+		if((arrow.valid=valids[arrowIndex]))
+			{
+			arrow.direction=Vector(directions[arrowIndex]);
+			arrow.scalarValue=Scalar(scalarValues[arrowIndex]);
+			}
+		}
+	
+	delete[] bases;
+	delete[] directions;
+	delete[] scalarValues;
+	delete[] valids;
+	}
+
 template <class DataSetWrapperParam>
 inline
 ArrowRakeExtractor<DataSetWrapperParam>::ArrowRakeExtractor(
@@ -425,19 +468,7 @@ ArrowRakeExtractor<DataSetWrapperParam>::createElement(
 	ArrowRake* result=new ArrowRake(myParameters,myParameters->rakeSize,myParameters->lengthScale,myParameters->shaftRadius,myParameters->numArrowVertices,getVariableManager()->getColorMap(csvi),getPipe());
 	
 	/* Calculate the arrow base points and directions: */
-	for(Index index(0);index[0]<myParameters->rakeSize[0];index.preInc(myParameters->rakeSize))
-		{
-		Arrow& arrow=result->getRake()(index);
-		arrow.base=myParameters->base;
-		for(int i=0;i<2;++i)
-			arrow.base+=myParameters->frame[i]*(Scalar(index[i])*myParameters->cellSize[i]);
-		
-		if((arrow.valid=myParameters->dsl.locatePoint(arrow.base)))
-			{
-			arrow.direction=Vector(myParameters->dsl.calcValue(*myParameters->ve));
-			arrow.scalarValue=Scalar(myParameters->dsl.calcValue(*myParameters->cse));
-			}
-		}
+	calcArrows(myParameters,result->getRake());
 	result->update();
 	
 	/* Return the result: */
@@ -473,19 +504,7 @@ ArrowRakeExtractor<DataSetWrapperParam>::continueElement(
 	const Realtime::AlarmTimer& alarm)
 	{
 	/* Calculate the arrow base points and directions: */
-	for(Index index(0);index[0]<currentParameters->rakeSize[0];index.preInc(currentParameters->rakeSize))
-		{
-		Arrow& arrow=currentArrowRake->getRake()(index);
-		arrow.base=currentParameters->base;
-		for(int i=0;i<2;++i)
-			arrow.base+=currentParameters->frame[i]*(Scalar(index[i])*currentParameters->cellSize[i]);
-		
-		if((arrow.valid=currentParameters->dsl.locatePoint(arrow.base)))
-			{
-			arrow.direction=Vector(currentParameters->dsl.calcValue(*currentParameters->ve));
-			arrow.scalarValue=Scalar(currentParameters->dsl.calcValue(*currentParameters->cse));
-			}
-		}
+	calcArrows(currentParameters,currentArrowRake->getRake());
 	currentArrowRake->update();
 	
 	return true;
@@ -131,6 +131,11 @@ class ArrowRakeExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual void dataSetChanged(Visualization::Abstract::VariableManager* variableManager)
+			{
+			/* Re-locate the seed point in the new data set: */
+			update(variableManager,true);
+			}
 		
 		/* New methods: */
 		void update(Visualization::Abstract::VariableManager* variableManager,bool track); // Updates derived parameters after a read operation
@@ -152,6 +157,9 @@ class ArrowRakeExtractor:public Visualization::Abstract::Algorithm
 	GLMotif::TextField* lengthScaleValue; // Text field to display the current arrow length scaling factor
 	GLMotif::Slider* lengthScaleSlider; // Sliders to adjust the current arrow length scaling factor
 	
+	/* Private methods: */
+	void calcArrows(Parameters* extractParameters,Rake& rake); // Locates and evaluates all arrows of the given rake in one batch
+	
 	/* Constructors and destructors: */
 	public:
 	ArrowRakeExtractor(Visualization::Abstract::VariableManager* sVariableManager,Comm::MulticastPipe* sPipe); // Creates an arrow rake extractor
@@ -76,6 +76,38 @@ ColoredIsosurface<DataSetWrapperParam>::getSize(
 	return surface.getNumTriangles();
 	}
 
+template <class DataSetWrapperParam>
+inline
+size_t
+ColoredIsosurface<DataSetWrapperParam>::getNumVertices(
+	void) const
+	{
+	#if 0
+	return surface.getNumVertices();
+	#else
+	/* Triangle sets store three separate vertices per triangle: */
+	return surface.getNumTriangles()*3;
+	#endif
+	}
+
+template <class DataSetWrapperParam>
+inline
+size_t
+ColoredIsosurface<DataSetWrapperParam>::getNumTriangles(
+	void) const
+	{
+	return surface.getNumTriangles();
+	}
+
+template <class DataSetWrapperParam>
+inline
+unsigned int
+ColoredIsosurface<DataSetWrapperParam>::calcChecksum(
+	void) const
+	{
+	return surface.calcChecksum();
+	}
+
 template <class DataSetWrapperParam>
 inline
 void
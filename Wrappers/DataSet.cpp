@@ -27,10 +27,14 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 
 #include <Templatized/ScalarExtractor.h>
+#include <Templatized/CellValueRangeTree.h>
+#include <Templatized/VertexGradientCache.h>
+#include <Templatized/VertexValueStatistics.h>
 #include <Wrappers/ScalarExtractor.h>
 #include <Templatized/VectorExtractor.h>
 #include <Wrappers/VectorExtractor.h>
 #include <Wrappers/CartesianCoordinateTransformer.h>
+#include <Abstract/Module.h>
 
 #include <Wrappers/DataSet.h>
 
@@ -99,7 +103,7 @@ DataSet<DSParam,VScalarParam,DataValueParam>::Locator::calcScalar(
 	/* Check if the locator is valid: */
 	if(!valid)
 		Misc::throwStdErr("DataSet::Locator::calcScalar: Attempt to evaluate invalid locator");
-		
+	
 	/* Calculate and return the value: */
 	return VScalar(dsl.calcValue(myScalarExtractor->getSe()));
 	}
@@ -118,7 +122,7 @@ DataSet<DSParam,VScalarParam,DataValueParam>::Locator::calcVector(
 	/* Check if the locator is valid: */
 	if(!valid)
 		Misc::throwStdErr("DataSet::Locator::calcVector: Attempt to evaluate invalid locator");
-		
+	
 	/* Calculate and return the value: */
 	return VVector(dsl.calcValue(myVectorExtractor->getVe()));
 	}
@@ -127,6 +131,57 @@ DataSet<DSParam,VScalarParam,DataValueParam>::Locator::calcVector(
 Methods of class DataSet:
 ************************/
 
+template <class DSParam,class VScalarParam,class DataValueParam>
+inline
+const typename DataSet<DSParam,VScalarParam,DataValueParam>::Statistics&
+DataSet<DSParam,VScalarParam,DataValueParam>::getStatistics(
+	void) const
+	{
+	Threads::Mutex::Lock statisticsLock(statisticsMutex);
+	
+	/* Split the vertex list into one chunk per loader thread if it has not been requested before: */
+	if(statistics==0)
+		statistics=new Statistics(&ds,Visualization::Abstract::Module::getNumLoadThreads());
+	
+	return *statistics;
+	}
+
+template <class DSParam,class VScalarParam,class DataValueParam>
+inline
+void
+DataSet<DSParam,VScalarParam,DataValueParam>::calcScalarVariableRanges(
+	void) const
+	{
+	/* Calculate the value ranges of all slices in a single pass: */
+	int numScalarVariables=dataValue.getNumScalarVariables();
+	std::vector<SE> extractors;
+	extractors.reserve(numScalarVariables);
+	for(int i=0;i<numScalarVariables;++i)
+		extractors.push_back(dataValue.getScalarExtractor(i));
+	std::vector<std::pair<VScalar,VScalar> > ranges(numScalarVariables);
+	getStatistics().calcScalarRanges(numScalarVariables,&extractors[0],&ranges[0]);
+	scalarVariableRanges.reserve(numScalarVariables);
+	for(int i=0;i<numScalarVariables;++i)
+		scalarVariableRanges.push_back(DestScalarRange(ranges[i].first,ranges[i].second));
+	}
+
+template <class DSParam,class VScalarParam,class DataValueParam>
+inline
+DataSet<DSParam,VScalarParam,DataValueParam>::~DataSet(
+	void)
+	{
+	/* Delete the vertex value reducer: */
+	delete statistics;
+	
+	/* Delete all cached cell trees: */
+	for(typename std::vector<CellTree*>::iterator ctIt=cellTrees.begin();ctIt!=cellTrees.end();++ctIt)
+		delete *ctIt;
+	
+	/* Delete all cached vertex gradients: */
+	for(typename std::vector<GradientCache*>::iterator gcIt=gradientCaches.begin();gcIt!=gradientCaches.end();++gcIt)
+		delete *gcIt;
+	}
+
 template <class DSParam,class VScalarParam,class DataValueParam>
 inline
 Visualization::Abstract::CoordinateTransformer*
@@ -179,21 +234,111 @@ DataSet<DSParam,VScalarParam,DataValueParam>::calcScalarValueRange(
 	const ScalarExtractor* myScalarExtractor=dynamic_cast<const ScalarExtractor*>(scalarExtractor);
 	if(myScalarExtractor==0)
 		Misc::throwStdErr("DataSet::Locator::calcScalar: Mismatching scalar extractor type");
-	const SE& se=myScalarExtractor->getSe();
 	
-	VScalar min,max;
-	typename DS::VertexIterator vIt=ds.beginVertices();
-	min=max=vIt->getValue(se);
-	for(++vIt;vIt!=ds.endVertices();++vIt)
+	/* Reduce the value range on the module's loader threads: */
+	std::pair<VScalar,VScalar> range=getStatistics().calcScalarRange(myScalarExtractor->getSe());
+	
+	return DestScalarRange(range.first,range.second);
+	}
+
+template <class DSParam,class VScalarParam,class DataValueParam>
+inline
+typename DataSet<DSParam,VScalarParam,DataValueParam>::DestScalarRange
+DataSet<DSParam,VScalarParam,DataValueParam>::calcScalarVariableRange(
+	int scalarVariableIndex) const
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=dataValue.getNumScalarVariables())
+		Misc::throwStdErr("DataSet::calcScalarVariableRange: invalid variable index %d",scalarVariableIndex);
+	
+	if(!dataValue.hasSlicedScalarVariables())
+		{
+		/* Calculate the value range of only the requested scalar variable: */
+		std::pair<VScalar,VScalar> range=getStatistics().calcScalarRange(dataValue.getScalarExtractor(scalarVariableIndex));
+		return DestScalarRange(range.first,range.second);
+		}
+	
+	Threads::Mutex::Lock scalarVariableRangesLock(scalarVariableRangesMutex);
+	
+	/* Calculate the value ranges of all slices if they have not been requested before: */
+	if(scalarVariableRanges.empty())
+		calcScalarVariableRanges();
+	
+	return scalarVariableRanges[scalarVariableIndex];
+	}
+
+template <class DSParam,class VScalarParam,class DataValueParam>
+inline
+void
+DataSet<DSParam,VScalarParam,DataValueParam>::calcScalarValueHistogram(
+	const Visualization::Abstract::ScalarExtractor* scalarExtractor,
+	const typename DataSet<DSParam,VScalarParam,DataValueParam>::DestScalarRange& valueRange,
+	typename DataSet<DSParam,VScalarParam,DataValueParam>::DestScalarHistogram& histogram) const
+	{
+	/* Convert the extractor base class pointer to the proper type: */
+	const ScalarExtractor* myScalarExtractor=dynamic_cast<const ScalarExtractor*>(scalarExtractor);
+	if(myScalarExtractor==0)
+		Misc::throwStdErr("DataSet::calcScalarValueHistogram: Mismatching scalar extractor type");
+	
+	if(histogram.empty())
+		return;
+	
+	/* Count the values on the module's loader threads: */
+	getStatistics().calcScalarHistogram(myScalarExtractor->getSe(),VScalar(valueRange.first),VScalar(valueRange.second),histogram.size(),&histogram[0]);
+	}
+
+template <class DSParam,class VScalarParam,class DataValueParam>
+inline
+void
+DataSet<DSParam,VScalarParam,DataValueParam>::calcScalarVariableHistogram(
+	int scalarVariableIndex,
+	const typename DataSet<DSParam,VScalarParam,DataValueParam>::DestScalarRange& valueRange,
+	typename DataSet<DSParam,VScalarParam,DataValueParam>::DestScalarHistogram& histogram) const
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=dataValue.getNumScalarVariables())
+		Misc::throwStdErr("DataSet::calcScalarVariableHistogram: invalid variable index %d",scalarVariableIndex);
+	
+	if(histogram.empty())
+		return;
+	
+	if(dataValue.hasSlicedScalarVariables())
 		{
-		VScalar v=vIt->getValue(se);
-		if(min>v)
-			min=v;
-		else if(max<v)
-			max=v;
+		Threads::Mutex::Lock scalarVariableRangesLock(scalarVariableRangesMutex);
+		
+		/* Calculate the value ranges of all slices if they have not been requested before: */
+		if(scalarVariableRanges.empty())
+			calcScalarVariableRanges();
+		
+		/* Check if the histogram covers the slice's cached value range: */
+		if(valueRange==scalarVariableRanges[scalarVariableIndex])
+			{
+			/* Count the values of all slices across their cached value ranges in a single pass if they have not been requested with the same number of bins before: */
+			size_t numBins=histogram.size();
+			if(scalarVariableHistograms.empty()||scalarVariableHistograms[0].size()!=numBins)
+				{
+				int numScalarVariables=dataValue.getNumScalarVariables();
+				std::vector<SE> extractors;
+				std::vector<std::pair<VScalar,VScalar> > ranges;
+				extractors.reserve(numScalarVariables);
+				ranges.reserve(numScalarVariables);
+				for(int i=0;i<numScalarVariables;++i)
+					{
+					extractors.push_back(dataValue.getScalarExtractor(i));
+					ranges.push_back(std::pair<VScalar,VScalar>(VScalar(scalarVariableRanges[i].first),VScalar(scalarVariableRanges[i].second)));
+					}
+				std::vector<size_t> bins(size_t(numScalarVariables)*numBins);
+				getStatistics().calcScalarHistograms(numScalarVariables,&extractors[0],&ranges[0],numBins,&bins[0]);
+				scalarVariableHistograms.resize(numScalarVariables);
+				for(int i=0;i<numScalarVariables;++i)
+					scalarVariableHistograms[i].assign(bins.begin()+size_t(i)*numBins,bins.begin()+size_t(i+1)*numBins);
+				}
+			
+			histogram=scalarVariableHistograms[scalarVariableIndex];
+			return;
+			}
 		}
 	
-	return DestScalarRange(min,max);
+	/* Count the values of only the requested scalar variable: */
+	getStatistics().calcScalarHistogram(dataValue.getScalarExtractor(scalarVariableIndex),VScalar(valueRange.first),VScalar(valueRange.second),histogram.size(),&histogram[0]);
 	}
 
 template <class DSParam,class VScalarParam,class DataValueParam>
@@ -239,21 +384,63 @@ DataSet<DSParam,VScalarParam,DataValueParam>::calcVectorValueMagnitudeRange(
 	const VectorExtractor* myVectorExtractor=dynamic_cast<const VectorExtractor*>(vectorExtractor);
 	if(myVectorExtractor==0)
 		Misc::throwStdErr("DataSet::Locator::calcVector: Mismatching vector extractor type");
-	const VE& ve=myVectorExtractor->getVe();
 	
-	VScalar min2,max2;
-	typename DS::VertexIterator vIt=ds.beginVertices();
-	min2=max2=Geometry::sqr(vIt->getValue(ve));
-	for(++vIt;vIt!=ds.endVertices();++vIt)
+	/* Reduce the magnitude range on the module's loader threads: */
+	std::pair<VScalar,VScalar> range=getStatistics().calcMagnitudeRange(myVectorExtractor->getVe());
+	
+	return DestScalarRange(range.first,range.second);
+	}
+
+template <class DSParam,class VScalarParam,class DataValueParam>
+inline
+const typename DataSet<DSParam,VScalarParam,DataValueParam>::CellTree&
+DataSet<DSParam,VScalarParam,DataValueParam>::getCellTree(
+	int scalarVariableIndex) const
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=dataValue.getNumScalarVariables())
+		Misc::throwStdErr("DataSet::getCellTree: invalid variable index %d",scalarVariableIndex);
+	
+	Threads::Mutex::Lock cellTreesLock(cellTreesMutex);
+	
+	/* Create the scalar variable's cell tree if it has not been requested before: */
+	if(cellTrees.empty())
+		cellTrees.resize(dataValue.getNumScalarVariables(),0);
+	if(cellTrees[scalarVariableIndex]==0)
+		cellTrees[scalarVariableIndex]=new CellTree(&ds,dataValue.getScalarExtractor(scalarVariableIndex));
+	
+	return *cellTrees[scalarVariableIndex];
+	}
+
+template <class DSParam,class VScalarParam,class DataValueParam>
+inline
+const typename DataSet<DSParam,VScalarParam,DataValueParam>::GradientCache*
+DataSet<DSParam,VScalarParam,DataValueParam>::getGradientCache(
+	int scalarVariableIndex) const
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=dataValue.getNumScalarVariables())
+		Misc::throwStdErr("DataSet::getGradientCache: invalid variable index %d",scalarVariableIndex);
+	
+	/* Bail out if the data set type does not support gradient caching: */
+	if(!GradientCache::isSupported())
+		return 0;
+	
+	Threads::Mutex::Lock gradientCachesLock(gradientCachesMutex);
+	
+	/* Create the scalar variable's gradient cache if it has not been requested before and fits into the budget: */
+	if(gradientCaches.empty())
+		gradientCaches.resize(dataValue.getNumScalarVariables(),0);
+	if(gradientCaches[scalarVariableIndex]==0)
 		{
-		VScalar v2=Geometry::sqr(vIt->getValue(ve));
-		if(min2>v2)
-			min2=v2;
-		else if(max2<v2)
-			max2=v2;
+		/* Fall back to calculating gradients on the fly if the cache would exceed the budget: */
+		size_t cacheSize=GradientCache::calcMemorySize(ds);
+		if(gradientCachesSize+cacheSize>getGradientCacheBudget())
+			return 0;
+		
+		gradientCaches[scalarVariableIndex]=new GradientCache(&ds,dataValue.getScalarExtractor(scalarVariableIndex),Visualization::Abstract::Module::getNumLoadThreads());
+		gradientCachesSize+=gradientCaches[scalarVariableIndex]->getMemorySize();
 		}
 	
-	return DestScalarRange(Math::sqrt(min2),Math::sqrt(max2));
+	return gradientCaches[scalarVariableIndex];
 	}
 
 }
@@ -23,6 +23,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_WRAPPERS_DATASET_INCLUDED
 #define VISUALIZATION_WRAPPERS_DATASET_INCLUDED
 
+#include <vector>
+#include <Threads/Mutex.h>
+
 #include <Abstract/DataSet.h>
 
 /* Forward declarations: */
@@ -36,6 +39,12 @@ template <class ScalarParam,class SourceValueParam>
 class ScalarExtractor;
 template <class VectorParam,class SourceValueParam>
 class VectorExtractor;
+template <class DataSetParam,class ScalarExtractorParam>
+class CellValueRangeTree;
+template <class DataSetParam,class ScalarExtractorParam>
+class VertexGradientCache;
+template <class DataSetParam>
+class VertexValueStatistics;
 }
 namespace Wrappers {
 template <class SEParam>
@@ -59,6 +68,7 @@ class DataSet:public Visualization::Abstract::DataSet
 	typedef Base::VScalar DestScalar; // Destination type for scalar extraction
 	typedef Base::VVector DestVector; // Destination type for vector extraction
 	typedef Base::VScalarRange DestScalarRange; // Destination type for scalar range extraction
+	typedef Base::VScalarHistogram DestScalarHistogram; // Destination type for scalar histogram extraction
 	typedef Base::Locator BaseLocator; // Base class for locators
 	typedef DSParam DS; // Type of templatized data set
 	typedef typename DS::Value DSValue; // Value type of templatized data set
@@ -70,6 +80,9 @@ class DataSet:public Visualization::Abstract::DataSet
 	typedef Visualization::Templatized::VectorExtractor<VVector,DSValue> VE; // Type of templatized vector extractor
 	typedef Visualization::Wrappers::VectorExtractor<VE> VectorExtractor; // Compatible vector extractor wrapper class
 	typedef DataValueParam DataValue; // Type of data value descriptor
+	typedef Visualization::Templatized::CellValueRangeTree<DS,SE> CellTree; // Type of interval trees indexing cells by scalar value range
+	typedef Visualization::Templatized::VertexGradientCache<DS,SE> GradientCache; // Type of caches of vertex gradients of scalar variables
+	typedef Visualization::Templatized::VertexValueStatistics<DS> Statistics; // Type of parallel reducers over the data set's vertex values
 	
 	class Locator:public BaseLocator
 		{
@@ -106,19 +119,33 @@ class DataSet:public Visualization::Abstract::DataSet
 	private:
 	DataValue dataValue; // Descriptor for data values stored in the data set
 	DS ds; // The templatized data set
+	mutable Threads::Mutex cellTreesMutex; // Mutex protecting the cell tree cache
+	mutable std::vector<CellTree*> cellTrees; // Lazily created interval trees for each scalar variable
+	mutable Threads::Mutex gradientCachesMutex; // Mutex protecting the gradient cache
+	mutable std::vector<GradientCache*> gradientCaches; // Lazily created vertex gradient caches for each scalar variable
+	mutable size_t gradientCachesSize; // Total number of bytes occupied by all vertex gradient caches
+	mutable Threads::Mutex statisticsMutex; // Mutex protecting the vertex value reducer
+	mutable Statistics* statistics; // Lazily created reducer holding the vertex chunks of the data set's vertex list
+	mutable Threads::Mutex scalarVariableRangesMutex; // Mutex protecting the scalar variable range and histogram caches
+	mutable std::vector<DestScalarRange> scalarVariableRanges; // Value ranges of all scalar variables, calculated together on first request if the data value stores its scalar variables in slices
+	mutable std::vector<DestScalarHistogram> scalarVariableHistograms; // Histograms of all scalar variables across their cached value ranges, counted together on first request if the data value stores its scalar variables in slices
+	
+	/* Private methods: */
+	const Statistics& getStatistics(void) const; // Returns the vertex value reducer, splitting the vertex list into chunks on first use
+	void calcScalarVariableRanges(void) const; // Calculates the value ranges of all scalar variables in a single pass; must be called with the range cache mutex locked
 	
 	/* Constructors and destructors: */
 	public:
 	DataSet(void) // Default constructor
+		:gradientCachesSize(0),
+		 statistics(0)
 		{
 		}
 	private:
 	DataSet(const DataSet& source); // Prohibit copy constructor
 	DataSet& operator=(const DataSet& source); // Prohibit assignment operator
 	public:
-	virtual ~DataSet(void)
-		{
-		}
+	virtual ~DataSet(void);
 	
 	/* Methods: */
 	const DataValue& getDataValue(void) const // Returns the data value descriptor
@@ -150,6 +177,9 @@ class DataSet:public Visualization::Abstract::DataSet
 	virtual const char* getScalarVariableName(int scalarVariableIndex) const;
 	virtual Visualization::Abstract::ScalarExtractor* getScalarExtractor(int scalarVariableIndex) const;
 	virtual DestScalarRange calcScalarValueRange(const Visualization::Abstract::ScalarExtractor* scalarExtractor) const;
+	virtual DestScalarRange calcScalarVariableRange(int scalarVariableIndex) const;
+	virtual void calcScalarValueHistogram(const Visualization::Abstract::ScalarExtractor* scalarExtractor,const DestScalarRange& valueRange,DestScalarHistogram& histogram) const;
+	virtual void calcScalarVariableHistogram(int scalarVariableIndex,const DestScalarRange& valueRange,DestScalarHistogram& histogram) const;
 	virtual int getNumVectorVariables(void) const;
 	virtual const char* getVectorVariableName(int vectorVariableIndex) const;
 	virtual Visualization::Abstract::VectorExtractor* getVectorExtractor(int vectorVariableIndex) const;
@@ -158,6 +188,10 @@ class DataSet:public Visualization::Abstract::DataSet
 		{
 		return new Locator(ds);
 		}
+	
+	/* New methods: */
+	const CellTree& getCellTree(int scalarVariableIndex) const; // Returns an interval tree indexing the data set's cells by the value range of the given scalar variable; creates the tree on first use
+	const GradientCache* getGradientCache(int scalarVariableIndex) const; // Returns a cache of the given scalar variable's vertex gradients, creating it on first use; returns null if the data set type does not support gradient caching or the cache would exceed the gradient cache budget
 	};
 
 }
@@ -0,0 +1,120 @@
+/***********************************************************************
+DataSetCacheIOHelper - Helper class to write templatized data sets and
+their data value descriptors to data set cache files, and to read them
+back.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_WRAPPERS_DATASETCACHEIOHELPER_IMPLEMENTATION
+
+#include <Misc/ThrowStdErr.h>
+
+#include <Templatized/SlicedCurvilinear.h>
+#include <Wrappers/SlicedScalarVectorDataValue.h>
+
+#include <Wrappers/DataSetCacheIOHelper.h>
+
+namespace Visualization {
+
+namespace Wrappers {
+
+/*************************************
+Methods of class DataSetCacheIOHelper:
+*************************************/
+
+template <class DSParam,class DataValueParam>
+inline
+void
+DataSetCacheIOHelper<DSParam,DataValueParam>::write(
+	const typename DataSetCacheIOHelper<DSParam,DataValueParam>::DS&,
+	const typename DataSetCacheIOHelper<DSParam,DataValueParam>::DataValue&,
+	Visualization::Abstract::DataSetCache::Writer&)
+	{
+	Misc::throwStdErr("DataSetCacheIOHelper::write: Data set type can not be cached");
+	}
+
+template <class DSParam,class DataValueParam>
+inline
+void
+DataSetCacheIOHelper<DSParam,DataValueParam>::read(
+	typename DataSetCacheIOHelper<DSParam,DataValueParam>::DS&,
+	typename DataSetCacheIOHelper<DSParam,DataValueParam>::DataValue&,
+	Visualization::Abstract::DataSetCache::Reader&)
+	{
+	Misc::throwStdErr("DataSetCacheIOHelper::read: Data set type can not be cached");
+	}
+
+/*****************************************************************
+Methods of class DataSetCacheIOHelper for sliced curvilinear grids:
+*****************************************************************/
+
+template <class ScalarParam,int dimensionParam,class VScalarParam>
+inline
+void
+DataSetCacheIOHelper<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,SlicedScalarVectorDataValue<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,VScalarParam> >::write(
+	const typename DataSetCacheIOHelper<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,SlicedScalarVectorDataValue<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,VScalarParam> >::DS& ds,
+	const typename DataSetCacheIOHelper<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,SlicedScalarVectorDataValue<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,VScalarParam> >::DataValue& dataValue,
+	Visualization::Abstract::DataSetCache::Writer& cache)
+	{
+	/* Write the data set: */
+	ds.writeCache(cache);
+	
+	/* Write the scalar variable names: */
+	for(int i=0;i<dataValue.getNumScalarVariables();++i)
+		cache.writeString(dataValue.getScalarVariableName(i));
+	
+	/* Write the vector variable names and the scalar variables defining their components: */
+	cache.write<int>(dataValue.getNumVectorVariables());
+	for(int i=0;i<dataValue.getNumVectorVariables();++i)
+		{
+		cache.writeString(dataValue.getVectorVariableName(i));
+		for(int j=0;j<dimensionParam;++j)
+			cache.write<int>(dataValue.getVectorVariableScalarIndex(i,j));
+		}
+	}
+
+template <class ScalarParam,int dimensionParam,class VScalarParam>
+inline
+void
+DataSetCacheIOHelper<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,SlicedScalarVectorDataValue<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,VScalarParam> >::read(
+	typename DataSetCacheIOHelper<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,SlicedScalarVectorDataValue<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,VScalarParam> >::DS& ds,
+	typename DataSetCacheIOHelper<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,SlicedScalarVectorDataValue<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,VScalarParam> >::DataValue& dataValue,
+	Visualization::Abstract::DataSetCache::Reader& cache)
+	{
+	/* Read the data set: */
+	ds.readCache(cache);
+	
+	/* Read the scalar variable names: */
+	dataValue.initialize(&ds,0);
+	for(int i=0;i<dataValue.getNumScalarVariables();++i)
+		dataValue.setScalarVariableName(i,cache.readString().c_str());
+	
+	/* Read the vector variable names and the scalar variables defining their components: */
+	int numVectorVariables=cache.read<int>();
+	for(int i=0;i<numVectorVariables;++i)
+		{
+		int vectorVariableIndex=dataValue.addVectorVariable(cache.readString().c_str());
+		for(int j=0;j<dimensionParam;++j)
+			dataValue.setVectorVariableScalarIndex(vectorVariableIndex,j,cache.read<int>());
+		}
+	}
+
+}
+
+}
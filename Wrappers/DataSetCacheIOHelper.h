@@ -0,0 +1,79 @@
+/***********************************************************************
+DataSetCacheIOHelper - Helper class to write templatized data sets and
+their data value descriptors to data set cache files, and to read them
+back.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_WRAPPERS_DATASETCACHEIOHELPER_INCLUDED
+#define VISUALIZATION_WRAPPERS_DATASETCACHEIOHELPER_INCLUDED
+
+#include <Abstract/DataSetCache.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCurvilinear;
+}
+namespace Wrappers {
+template <class DSParam,class VScalarParam>
+class SlicedScalarVectorDataValue;
+}
+}
+
+namespace Visualization {
+
+namespace Wrappers {
+
+template <class DSParam,class DataValueParam>
+class DataSetCacheIOHelper // Generic helper class for data set types that can not be cached
+	{
+	/* Embedded classes: */
+	public:
+	typedef DSParam DS; // Templatized data set type
+	typedef DataValueParam DataValue; // Data value descriptor type
+	
+	/* Methods: */
+	static void write(const DS& ds,const DataValue& dataValue,Visualization::Abstract::DataSetCache::Writer& cache); // Writes the given data set and data value descriptor to the given cache file
+	static void read(DS& ds,DataValue& dataValue,Visualization::Abstract::DataSetCache::Reader& cache); // Reads a data set and data value descriptor from the given cache file
+	};
+
+template <class ScalarParam,int dimensionParam,class VScalarParam>
+class DataSetCacheIOHelper<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,SlicedScalarVectorDataValue<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam>,VScalarParam> > // Helper class for sliced curvilinear data sets with named scalar and vector variables
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,VScalarParam> DS; // Templatized data set type
+	typedef SlicedScalarVectorDataValue<DS,VScalarParam> DataValue; // Data value descriptor type
+	
+	/* Methods: */
+	static void write(const DS& ds,const DataValue& dataValue,Visualization::Abstract::DataSetCache::Writer& cache); // Writes the given data set and data value descriptor to the given cache file
+	static void read(DS& ds,DataValue& dataValue,Visualization::Abstract::DataSetCache::Reader& cache); // Reads a data set and data value descriptor from the given cache file
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_WRAPPERS_DATASETCACHEIOHELPER_IMPLEMENTATION
+#include <Wrappers/DataSetCacheIOHelper.cpp>
+#endif
+
+#endif
@@ -58,6 +58,10 @@ class DataValue
 	typedef Visualization::Templatized::VectorExtractor<VVector,Value> VE;
 	
 	/* Methods: */
+	bool hasSlicedScalarVariables(void) const // Returns true if the scalar variables are stored in separate value slices, whose value ranges are best calculated together
+		{
+		return false;
+		}
 	int getNumScalarVariables(void) const // Returns number of scalar variables contained in the data value
 		{
 		return 0;
@@ -41,6 +41,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/VariableManager.h>
 #include <Templatized/IsosurfaceExtractorIndexedTriangleSet.h>
+#include <Templatized/CellValueRangeTree.h>
 #include <Wrappers/ScalarExtractor.h>
 #include <Wrappers/ParametersIOHelper.h>
 
@@ -245,14 +246,18 @@ GlobalIsosurfaceExtractor<DataSetWrapperParam>::GlobalIsosurfaceExtractor(
 	 parameters(sVariableManager->getCurrentScalarVariable()),
 	 ise(getDs(sVariableManager->getDataSetByScalarVariable(parameters.scalarVariableIndex)),getSe(sVariableManager->getScalarExtractor(parameters.scalarVariableIndex))),
 	 valueRange(sVariableManager->getScalarValueRange(parameters.scalarVariableIndex)),
-	 extractionModeBox(0),isovalueValue(0),isovalueSlider(0)
+	 useCellTree(getDefaultUseCellIndex()),useGradientCache(getDefaultUseGradientCache()),
+	 incrementalUpdate(getDefaultIncrementalUpdate()),activeCellsScalarVariableIndex(-1),activeCellsRestartCount(0),
+	 progressiveRefinement(getDefaultProgressiveRefinement()),
+	 extractionModeBox(0),isovalueValue(0),isovalueSlider(0),cellTreeToggle(0),incrementalUpdateToggle(0),progressiveRefinementToggle(0)
 	{
 	/* Initialize parameters: */
 	parameters.smoothShading=true;
 	parameters.isovalue=Math::mid(valueRange.first,valueRange.second);
 	
-	/* Set the templatized isosurface extractor's extraction mode: */
+	/* Set the templatized isosurface extractor's extraction mode and vertex sharing method: */
 	ise.setExtractionMode(parameters.smoothShading?ISE::SMOOTH:ISE::FLAT);
+	ise.setEdgeSlabsEnabled(getDefaultUseEdgeSlabs());
 	}
 
 template <class DataSetWrapperParam>
@@ -309,6 +314,30 @@ GlobalIsosurfaceExtractor<DataSetWrapperParam>::createSettingsDialog(
 	
 	isovalueBox->manageChild();
 	
+	new GLMotif::Label("CellTreeLabel",settingsDialog,"Acceleration");
+	
+	cellTreeToggle=new GLMotif::ToggleButton("CellTreeToggle",settingsDialog,"Use Cell Index");
+	cellTreeToggle->setBorderWidth(0.0f);
+	cellTreeToggle->setHAlignment(GLFont::Left);
+	cellTreeToggle->setToggle(useCellTree);
+	cellTreeToggle->getValueChangedCallbacks().add(this,&GlobalIsosurfaceExtractor::cellTreeToggleCallback);
+	
+	new GLMotif::Label("IncrementalUpdateLabel",settingsDialog,"Isovalue Changes");
+	
+	incrementalUpdateToggle=new GLMotif::ToggleButton("IncrementalUpdateToggle",settingsDialog,"Incremental Update");
+	incrementalUpdateToggle->setBorderWidth(0.0f);
+	incrementalUpdateToggle->setHAlignment(GLFont::Left);
+	incrementalUpdateToggle->setToggle(incrementalUpdate);
+	incrementalUpdateToggle->getValueChangedCallbacks().add(this,&GlobalIsosurfaceExtractor::incrementalUpdateToggleCallback);
+	
+	new GLMotif::Label("ProgressiveRefinementLabel",settingsDialog,"Previews");
+	
+	progressiveRefinementToggle=new GLMotif::ToggleButton("ProgressiveRefinementToggle",settingsDialog,"Progressive Refinement");
+	progressiveRefinementToggle->setBorderWidth(0.0f);
+	progressiveRefinementToggle->setHAlignment(GLFont::Left);
+	progressiveRefinementToggle->setToggle(progressiveRefinement);
+	progressiveRefinementToggle->getValueChangedCallbacks().add(this,&GlobalIsosurfaceExtractor::progressiveRefinementToggleCallback);
+	
 	settingsDialog->manageChild();
 	
 	return settingsDialogPopup;
@@ -326,17 +355,79 @@ GlobalIsosurfaceExtractor<DataSetWrapperParam>::createElement(
 		Misc::throwStdErr("GlobalIsosurfaceExtractor::createElement: Mismatching parameter object type");
 	int svi=myParameters->scalarVariableIndex;
 	
+	/* Take a snapshot of the extraction settings, which can change while the extraction runs: */
+	bool extractUseCellTree,extractIncrementalUpdate;
+	getExtractionSettings(extractUseCellTree,extractIncrementalUpdate);
+	
 	/* Create a new isosurface visualization element: */
 	Isosurface* result=new Isosurface(myParameters,myParameters->isovalue,getVariableManager()->getColorMap(svi),getPipe());
 	
 	/* Update the isosurface extractor: */
 	ise.update(getDs(getVariableManager()->getDataSetByScalarVariable(svi)),getSe(getVariableManager()->getScalarExtractor(svi)));
+	result->getSurface().setStreamCompression(ise.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
 	
 	/* Set the templatized isosurface extractor's extraction mode: */
 	ise.setExtractionMode(myParameters->smoothShading?ISE::SMOOTH:ISE::FLAT);
 	
+	/* Look up smooth shading gradients in the scalar variable's gradient cache, if the data set provides one: */
+	const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(getVariableManager()->getDataSetByScalarVariable(svi));
+	if(myParameters->smoothShading&&useGradientCache)
+		ise.setGradientCache(myDataSet->getGradientCache(svi));
+	
 	/* Extract the isosurface into the visualization element: */
-	ise.extractIsosurface(myParameters->isovalue,result->getSurface());
+	if(extractIncrementalUpdate)
+		{
+		/* Only walk from the previous isosurface if it was extracted for the same scalar variable, and the user did not request a restart since: */
+		if(activeCellsScalarVariableIndex!=svi||activeCellsRestartCount!=myParameters->incrementalRestartCount)
+			{
+			ise.invalidateActiveCells();
+			activeCellsScalarVariableIndex=svi;
+			activeCellsRestartCount=myParameters->incrementalRestartCount;
+			}
+		
+		/* Let the interval tree find isosurface components that do not touch the previous isosurface, if it is enabled: */
+		ise.extractIncrementalIsosurface(myParameters->isovalue,extractUseCellTree?&myDataSet->getCellTree(svi):0,result->getSurface());
+		}
+	else if(extractUseCellTree)
+		{
+		/* Only visit cells whose value ranges contain the isovalue, using all available extraction threads: */
+		ise.extractIsosurface(myParameters->isovalue,myDataSet->getCellTree(svi),getNumThreads(),result->getSurface());
+		}
+	else
+		{
+		/* Sweep all cells, using all available extraction threads: */
+		ise.extractIsosurface(myParameters->isovalue,getNumThreads(),result->getSurface());
+		}
+	
+	/* Return the result: */
+	return result;
+	}
+
+template <class DataSetWrapperParam>
+inline
+Visualization::Abstract::Element*
+GlobalIsosurfaceExtractor<DataSetWrapperParam>::createPreviewElement(
+	Visualization::Abstract::Parameters* extractParameters,
+	unsigned int stage)
+	{
+	/* Get proper pointer to parameter object: */
+	Parameters* myParameters=dynamic_cast<Parameters*>(extractParameters);
+	if(myParameters==0)
+		Misc::throwStdErr("GlobalIsosurfaceExtractor::createPreviewElement: Mismatching parameter object type");
+	int svi=myParameters->scalarVariableIndex;
+	
+	/* Create a new isosurface visualization element: */
+	Isosurface* result=new Isosurface(myParameters,myParameters->isovalue,getVariableManager()->getColorMap(svi),getPipe());
+	
+	/* Update the isosurface extractor: */
+	ise.update(getDs(getVariableManager()->getDataSetByScalarVariable(svi)),getSe(getVariableManager()->getScalarExtractor(svi)));
+	result->getSurface().setStreamCompression(ise.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
+	
+	/* Set the templatized isosurface extractor's extraction mode: */
+	ise.setExtractionMode(myParameters->smoothShading?ISE::SMOOTH:ISE::FLAT);
+	
+	/* Extract the preview from a resampled lattice whose resolution doubles with every stage: */
+	ise.extractPreviewIsosurface(myParameters->isovalue,previewLatticeSize<<stage,result->getSurface());
 	
 	/* Return the result: */
 	return result;
@@ -398,6 +489,39 @@ GlobalIsosurfaceExtractor<DataSetWrapperParam>::isovalueSliderCallback(
 	isovalueValue->setValue(parameters.isovalue);
 	}
 
+template <class DataSetWrapperParam>
+inline
+void
+GlobalIsosurfaceExtractor<DataSetWrapperParam>::cellTreeToggleCallback(
+	GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	Threads::Mutex::Lock settingsLock(settingsMutex);
+	useCellTree=cbData->set;
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+GlobalIsosurfaceExtractor<DataSetWrapperParam>::incrementalUpdateToggleCallback(
+	GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	Threads::Mutex::Lock settingsLock(settingsMutex);
+	incrementalUpdate=cbData->set;
+	
+	/* Ask the extraction thread to start the next incremental extraction from scratch, as sweeping all cells is cheaper than walking a large isovalue change: */
+	++parameters.incrementalRestartCount;
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+GlobalIsosurfaceExtractor<DataSetWrapperParam>::progressiveRefinementToggleCallback(
+	GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	Threads::Mutex::Lock settingsLock(settingsMutex);
+	progressiveRefinement=cbData->set;
+	}
+
 }
 
 }
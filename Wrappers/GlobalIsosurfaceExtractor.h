@@ -25,6 +25,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_WRAPPERS_GLOBALISOSURFACEEXTRACTOR_INCLUDED
 
 #include <Misc/Autopointer.h>
+#include <Threads/Mutex.h>
+#include <GLMotif/ToggleButton.h>
 #include <GLMotif/RadioBox.h>
 #include <GLMotif/Slider.h>
 
@@ -85,6 +87,7 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		int scalarVariableIndex; // Index of the scalar variable to color the isosurface
 		bool smoothShading; // Flag to enable smooth shading by calculating scalar field gradients at each vertex position
 		VScalar isovalue; // The isosurface's isovalue
+		unsigned int incrementalRestartCount; // Number of times the user requested incremental extraction to start from scratch; not saved or sent to slave nodes
 		
 		/* Private methods: */
 		template <class DataSourceParam>
@@ -95,7 +98,8 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		/* Constructors and destructors: */
 		public:
 		Parameters(int sScalarVariableIndex)
-			:scalarVariableIndex(sScalarVariableIndex)
+			:scalarVariableIndex(sScalarVariableIndex),
+			 incrementalRestartCount(0)
 			{
 			}
 		
@@ -114,23 +118,46 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual bool setSmoothShading(bool newSmoothShading)
+			{
+			smoothShading=newSmoothShading;
+			return true;
+			}
 		};
 	
 	/* Elements: */
 	private:
 	static const char* name; // Identifying name of this algorithm
+	static const unsigned int numPreviewStages=2; // Number of coarse previews delivered before the complete isosurface in progressive refinement mode
+	static const unsigned int previewLatticeSize=32; // Number of lattice cells along the longest side of the domain box for the coarsest preview
 	Parameters parameters; // The isosurface extraction parameters used by this extractor
 	ISE ise; // The templatized isosurface extractor
 	Visualization::Abstract::DataSet::VScalarRange valueRange; // Value range of the scalar variable used by this extractor
+	bool useCellTree; // Flag whether to only visit cells found by the data set's interval tree instead of sweeping all cells
+	bool useGradientCache; // Flag whether to look up smooth shading gradients in the data set's gradient cache
+	bool incrementalUpdate; // Flag whether to only visit cells near the previously extracted isosurface
+	int activeCellsScalarVariableIndex; // Index of the scalar variable for which the isosurface extractor's active cell set was extracted
+	unsigned int activeCellsRestartCount; // Incremental restart count of the parameters for which the isosurface extractor's active cell set was extracted
+	bool progressiveRefinement; // Flag whether to deliver coarse previews extracted from resampled lattices before the complete isosurface
+	mutable Threads::Mutex settingsMutex; // Mutex protecting the extraction settings changed from the settings dialog while the extraction thread reads them
 	
 	/* UI components: */
 	GLMotif::RadioBox* extractionModeBox; // Radio box with toggles for extraction modes
 	GLMotif::TextField* isovalueValue; // Text field to display the current isovalue
 	GLMotif::Slider* isovalueSlider; // Slider to select the current isovalue
+	GLMotif::ToggleButton* cellTreeToggle; // Toggle button to enable interval tree-accelerated extraction
+	GLMotif::ToggleButton* incrementalUpdateToggle; // Toggle button to enable incremental extraction from the previous isosurface
+	GLMotif::ToggleButton* progressiveRefinementToggle; // Toggle button to enable coarse previews
 	
 	/* Private methods: */
 	static const DS* getDs(const Visualization::Abstract::DataSet* sDataSet);
 	static const SE& getSe(const Visualization::Abstract::ScalarExtractor* sScalarExtractor);
+	void getExtractionSettings(bool& sUseCellTree,bool& sIncrementalUpdate) const // Returns the current extraction settings
+		{
+		Threads::Mutex::Lock settingsLock(settingsMutex);
+		sUseCellTree=useCellTree;
+		sIncrementalUpdate=incrementalUpdate;
+		}
 	
 	/* Constructors and destructors: */
 	public:
@@ -151,8 +178,22 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		{
 		return new Parameters(parameters);
 		}
+	virtual unsigned int getNumPreviewStages(void) const
+		{
+		Threads::Mutex::Lock settingsLock(settingsMutex);
+		return progressiveRefinement?numPreviewStages:0;
+		}
 	virtual Visualization::Abstract::Element* createElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual Visualization::Abstract::Element* createPreviewElement(Visualization::Abstract::Parameters* extractParameters,unsigned int stage);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual size_t getNumVisitedCells(void) const
+		{
+		return ise.getNumVisitedCells();
+		}
+	virtual size_t getNumRevisitedCells(void) const
+		{
+		return ise.getNumRevisitedCells();
+		}
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
@@ -169,6 +210,9 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		}
 	void extractionModeBoxCallback(GLMotif::RadioBox::ValueChangedCallbackData* cbData);
 	void isovalueSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
+	void cellTreeToggleCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
+	void incrementalUpdateToggleCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
+	void progressiveRefinementToggleCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
 	};
 
 }
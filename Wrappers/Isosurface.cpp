@@ -75,6 +75,33 @@ Isosurface<DataSetWrapperParam>::getSize(
 	return surface.getNumTriangles();
 	}
 
+template <class DataSetWrapperParam>
+inline
+size_t
+Isosurface<DataSetWrapperParam>::getNumVertices(
+	void) const
+	{
+	return surface.getNumVertices();
+	}
+
+template <class DataSetWrapperParam>
+inline
+size_t
+Isosurface<DataSetWrapperParam>::getNumTriangles(
+	void) const
+	{
+	return surface.getNumTriangles();
+	}
+
+template <class DataSetWrapperParam>
+inline
+unsigned int
+Isosurface<DataSetWrapperParam>::calcChecksum(
+	void) const
+	{
+	return surface.calcChecksum();
+	}
+
 template <class DataSetWrapperParam>
 inline
 void
@@ -69,6 +69,9 @@ class Isosurface:public Visualization::Abstract::Element
 	/* Methods from Visualization::Abstract::Element: */
 	virtual std::string getName(void) const;
 	virtual size_t getSize(void) const;
+	virtual size_t getNumVertices(void) const;
+	virtual size_t getNumTriangles(void) const;
+	virtual unsigned int calcChecksum(void) const;
 	virtual void glRenderAction(GLContextData& contextData) const;
 	
 	/* New methods: */
@@ -22,10 +22,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_WRAPPERS_MODULE_IMPLEMENTATION
 
+#include <Misc/SelfDestructPointer.h>
 #include <Misc/ThrowStdErr.h>
 
 #include <Abstract/VariableManager.h>
 #include <Wrappers/DataSet.h>
+#include <Wrappers/DataSetCacheIOHelper.h>
 #include <Wrappers/DataSetRenderer.h>
 #include <Wrappers/SeededSliceExtractor.h>
 #include <Wrappers/SeededIsosurfaceExtractor.h>
@@ -36,7 +38,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Wrappers/ArrowRakeExtractor.h>
 #include <Wrappers/StreamlineExtractor.h>
 #include <Wrappers/MultiStreamlineExtractor.h>
-// #include <Wrappers/StreamsurfaceExtractor.h>
+#include <Wrappers/ParticleSystemExtractor.h>
+#include <Wrappers/StreamsurfaceExtractor.h>
 
 #include <Wrappers/Module.h>
 
@@ -56,6 +59,33 @@ Module<DSParam,DataValueParam>::Module(
 	{
 	}
 
+template <class DSParam,class DataValueParam>
+inline
+void
+Module<DSParam,DataValueParam>::writeDataSetCache(
+	const Visualization::Abstract::DataSet* dataSet,
+	Visualization::Abstract::DataSetCache::Writer& cache) const
+	{
+	const DataSet* myDataSet=dynamic_cast<const DataSet*>(dataSet);
+	if(myDataSet==0)
+		Misc::throwStdErr("Module::writeDataSetCache: Mismatching data set type");
+	
+	/* Write the templatized data set and the data value descriptor: */
+	DataSetCacheIOHelper<DS,DataValue>::write(myDataSet->getDs(),myDataSet->getDataValue(),cache);
+	}
+
+template <class DSParam,class DataValueParam>
+inline
+Visualization::Abstract::DataSet*
+Module<DSParam,DataValueParam>::readDataSetCache(
+	Visualization::Abstract::DataSetCache::Reader& cache) const
+	{
+	/* Read the templatized data set and the data value descriptor into a new data set: */
+	Misc::SelfDestructPointer<DataSet> result(new DataSet);
+	DataSetCacheIOHelper<DS,DataValue>::read(result->getDs(),result->getDataValue(),cache);
+	return result.releaseTarget();
+	}
+
 template <class DSParam,class DataValueParam>
 inline
 Visualization::Abstract::DataSetRenderer*
@@ -160,7 +190,7 @@ int
 Module<DSParam,DataValueParam>::getNumVectorAlgorithms(
 	void) const
 	{
-	return 3;
+	return 5;
 	}
 
 template <class DSParam,class DataValueParam>
@@ -169,7 +199,7 @@ const char*
 Module<DSParam,DataValueParam>::getVectorAlgorithmName(
 	int vectorAlgorithmIndex) const
 	{
-	if(vectorAlgorithmIndex<0||vectorAlgorithmIndex>=3)
+	if(vectorAlgorithmIndex<0||vectorAlgorithmIndex>=5)
 		Misc::throwStdErr("Module::getVectorAlgorithmName: invalid algorithm index %d",vectorAlgorithmIndex);
 	
 	const char* result=0;
@@ -187,11 +217,13 @@ Module<DSParam,DataValueParam>::getVectorAlgorithmName(
 			result=MultiStreamlineExtractor::getClassName();
 			break;
 		
-		#if 0
 		case 3:
+			result=ParticleSystemExtractor::getClassName();
+			break;
+		
+		case 4:
 			result=StreamsurfaceExtractor::getClassName();
 			break;
-		#endif
 		}
 	return result;
 	}
@@ -204,7 +236,7 @@ Module<DSParam,DataValueParam>::getVectorAlgorithm(
 	Visualization::Abstract::VariableManager* variableManager,
 	Comm::MulticastPipe* pipe) const
 	{
-	if(vectorAlgorithmIndex<0||vectorAlgorithmIndex>=3)
+	if(vectorAlgorithmIndex<0||vectorAlgorithmIndex>=5)
 		Misc::throwStdErr("Module::getAlgorithm: invalid algorithm index %d",vectorAlgorithmIndex);
 	
 	Visualization::Abstract::Algorithm* result=0;
@@ -222,11 +254,13 @@ Module<DSParam,DataValueParam>::getVectorAlgorithm(
 			result=new MultiStreamlineExtractor(variableManager,pipe);
 			break;
 		
-		#if 0
 		case 3:
+			result=new ParticleSystemExtractor(variableManager,pipe);
+			break;
+		
+		case 4:
 			result=new StreamsurfaceExtractor(variableManager,pipe);
 			break;
-		#endif
 		}
 	return result;
 	}
@@ -51,6 +51,8 @@ class StreamlineExtractor;
 template <class DataSetWrapperParam>
 class MultiStreamlineExtractor;
 template <class DataSetWrapperParam>
+class ParticleSystemExtractor;
+template <class DataSetWrapperParam>
 class StreamsurfaceExtractor;
 }
 }
@@ -78,12 +80,15 @@ class Module:public Visualization::Abstract::Module
 	typedef Visualization::Wrappers::ArrowRakeExtractor<DataSet> ArrowRakeExtractor; // Arrow rake extractor class
 	typedef Visualization::Wrappers::StreamlineExtractor<DataSet> StreamlineExtractor; // Streamline extractor class
 	typedef Visualization::Wrappers::MultiStreamlineExtractor<DataSet> MultiStreamlineExtractor; // Streamline bundle extractor class
+	typedef Visualization::Wrappers::ParticleSystemExtractor<DataSet> ParticleSystemExtractor; // Animated particle system extractor class
 	typedef Visualization::Wrappers::StreamsurfaceExtractor<DataSet> StreamsurfaceExtractor; // Stream surface extractor class
 	
 	/* Constructors and destructors: */
 	Module(const char* sClassName);
 	
 	/* Methods: */
+	virtual void writeDataSetCache(const Visualization::Abstract::DataSet* dataSet,Visualization::Abstract::DataSetCache::Writer& cache) const;
+	virtual Visualization::Abstract::DataSet* readDataSetCache(Visualization::Abstract::DataSetCache::Reader& cache) const;
 	virtual Visualization::Abstract::DataSetRenderer* getRenderer(const Visualization::Abstract::DataSet* dataSet) const;
 	virtual int getNumScalarAlgorithms(void) const;
 	virtual const char* getScalarAlgorithmName(int scalarAlgorithmIndex) const;
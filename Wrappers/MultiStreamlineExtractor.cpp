@@ -23,6 +23,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_WRAPPERS_MULTISTREAMLINEEXTRACTOR_IMPLEMENTATION
 
+#ifdef PERF_COUNTSTREAMLINESTEPS
+#include <iostream>
+#endif
 #include <Misc/ThrowStdErr.h>
 #include <Misc/File.h>
 #include <Comm/MulticastPipe.h>
@@ -38,6 +41,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/VariableManager.h>
 #include <Templatized/MultiStreamlineExtractor.h>
+#ifdef PERF_COUNTSTREAMLINESTEPS
+#include <Templatized/LocatorStepCounterTraits.h>
+#endif
 #include <Wrappers/VectorExtractor.h>
 #include <Wrappers/ScalarExtractor.h>
 #include <Wrappers/ElementSizeLimit.h>
@@ -298,6 +304,50 @@ const char* MultiStreamlineExtractor<DataSetWrapperParam>::name="Streamline Bund
 Methods of class MultiStreamlineExtractor:
 *****************************************/
 
+#ifdef PERF_COUNTSTREAMLINESTEPS
+
+template <class DataSetWrapperParam>
+inline
+void
+MultiStreamlineExtractor<DataSetWrapperParam>::reportStreamlineSteps(
+	const typename MultiStreamlineExtractor<DataSetWrapperParam>::DSL& seedLocator) const
+	{
+	#ifdef PERF_COUNTLOCATORSTEPS
+	/* Only data sets with cell box trees count the work done by their locators: */
+	typedef Visualization::Templatized::LocatorStepCounterTraits<DS> LSCT;
+	Visualization::Templatized::LocatorStepCounters seedCounters=LSCT::getStepCounters(seedLocator);
+	Visualization::Templatized::LocatorStepCounters totalCounters;
+	#endif
+	
+	unsigned int totalNumSteps=0;
+	unsigned int totalNumRejectedSteps=0;
+	for(unsigned int i=0;i<msle.getNumStreamlines();++i)
+		{
+		std::cout<<"Streamline "<<i<<": "<<msle.getNumSteps(i)<<" steps, "<<msle.getNumRejectedSteps(i)<<" rejected steps";
+		totalNumSteps+=msle.getNumSteps(i);
+		totalNumRejectedSteps+=msle.getNumRejectedSteps(i);
+		#ifdef PERF_COUNTLOCATORSTEPS
+		if(LSCT::hasStepCounters)
+			{
+			/* Count the work done by the streamline's locator since it was copied from the seed locator: */
+			Visualization::Templatized::LocatorStepCounters counters=LSCT::getStepCounters(msle.getLocator(i));
+			counters-=seedCounters;
+			std::cout<<", "<<counters.numRestarts<<" locator restarts, "<<counters.numSteps<<" locator steps";
+			totalCounters+=counters;
+			}
+		#endif
+		std::cout<<std::endl;
+		}
+	std::cout<<"Total on "<<msle.getNumThreads()<<" threads: "<<totalNumSteps<<" steps, "<<totalNumRejectedSteps<<" rejected steps";
+	#ifdef PERF_COUNTLOCATORSTEPS
+	if(LSCT::hasStepCounters)
+		std::cout<<", "<<totalCounters.numRestarts<<" locator restarts, "<<totalCounters.numSteps<<" locator steps";
+	#endif
+	std::cout<<std::endl;
+	}
+
+#endif
+
 template <class DataSetWrapperParam>
 inline
 MultiStreamlineExtractor<DataSetWrapperParam>::MultiStreamlineExtractor(
@@ -447,10 +497,14 @@ MultiStreamlineExtractor<DataSetWrapperParam>::createElement(
 		}
 	
 	/* Extract the streamline into the visualization element: */
+	msle.setNumThreads(getNumThreads());
 	msle.startStreamlines();
 	ElementSizeLimit<MultiStreamline> esl(*result,myParameters->maxNumVertices);
 	msle.continueStreamlines(esl);
 	msle.finishStreamlines();
+	#ifdef PERF_COUNTSTREAMLINESTEPS
+	reportStreamlineSteps(myParameters->dsl);
+	#endif
 	
 	/* Return the result: */
 	return result;
@@ -485,6 +539,7 @@ MultiStreamlineExtractor<DataSetWrapperParam>::startElement(
 		}
 	
 	/* Extract the streamline into the visualization element: */
+	msle.setNumThreads(getNumThreads());
 	msle.startStreamlines();
 	
 	/* Return the result: */
@@ -510,6 +565,9 @@ MultiStreamlineExtractor<DataSetWrapperParam>::finishElement(
 	void)
 	{
 	msle.finishStreamlines();
+	#ifdef PERF_COUNTSTREAMLINESTEPS
+	reportStreamlineSteps(dynamic_cast<Parameters*>(currentMultiStreamline->getParameters())->dsl);
+	#endif
 	currentMultiStreamline=0;
 	}
 
@@ -133,6 +133,11 @@ class MultiStreamlineExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual void dataSetChanged(Visualization::Abstract::VariableManager* variableManager)
+			{
+			/* Re-locate the seed point in the new data set: */
+			update(variableManager,true);
+			}
 		
 		/* New methods: */
 		void update(Visualization::Abstract::VariableManager* variableManager,bool track); // Updates derived parameters after a read operation
@@ -155,6 +160,11 @@ class MultiStreamlineExtractor:public Visualization::Abstract::Algorithm
 	GLMotif::TextField* diskRadiusValue; // Text field to display current seed disk radius
 	GLMotif::Slider* diskRadiusSlider; // Slider to change current seed disk radius
 	
+	/* Private methods: */
+	#ifdef PERF_COUNTSTREAMLINESTEPS
+	void reportStreamlineSteps(const DSL& seedLocator) const; // Prints the per-streamline step counts of the last extraction, and the work done by each streamline's locator since it was copied from the given seed locator
+	#endif
+	
 	/* Constructors and destructors: */
 	public:
 	MultiStreamlineExtractor(Visualization::Abstract::VariableManager* sVariableManager,Comm::MulticastPipe* sPipe); // Creates a multi-streamline extractor
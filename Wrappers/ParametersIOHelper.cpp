@@ -242,6 +242,47 @@ size_t getVectorVariableNameLength(int vectorVariableIndex,const Visualization::
 	return sizeof(unsigned int)+strlen(variableManager->getVectorVariableName(vectorVariableIndex));
 	}
 
+bool readElementAlgorithmName(Misc::File& elementFile,bool ascii,char name[256])
+	{
+	unsigned int nameLength=0;
+	if(ascii)
+		{
+		/* Skip whitespace: */
+		int nextChar;
+		while((nextChar=elementFile.getc())!=EOF&&isspace(nextChar))
+			;
+		
+		/* Read until end of line: */
+		while(nextChar!='\n'&&nextChar!=EOF)
+			{
+			if(nameLength<255)
+				{
+				name[nameLength]=char(nextChar);
+				++nameLength;
+				}
+			nextChar=elementFile.getc();
+			}
+		if(nextChar==EOF) // Check for end-of-file indicator
+			return false;
+		
+		/* Remove trailing whitespace: */
+		while(nameLength>0&&isspace(name[nameLength-1]))
+			--nameLength;
+		}
+	else
+		{
+		nameLength=elementFile.read<unsigned int>();
+		if(nameLength==0) // Check for end-of-file indicator
+			return false;
+		if(nameLength>255)
+			Misc::throwStdErr("readElementAlgorithmName: Algorithm name of length %u in element file is too long",nameLength);
+		elementFile.read(name,nameLength);
+		}
+	name[nameLength]='\0';
+	
+	return true;
+	}
+
 template <class DataSourceParam>
 int
 readScalarVariableNameBinary(
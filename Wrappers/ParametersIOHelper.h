@@ -27,6 +27,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 /* Forward declarations: */
 namespace Misc {
+class File;
 template <class Source>
 class StandardHashFunction;
 template <class Source,class Dest,class HashFunction>
@@ -92,6 +93,7 @@ int readVectorVariableNameAscii(const AsciiParameterFileSectionHash* hash,std::s
 void deleteAsciiParameterFileSectionHash(AsciiParameterFileSectionHash* hash);
 size_t getScalarVariableNameLength(int scalarVariableIndex,const Visualization::Abstract::VariableManager* variableManager);
 size_t getVectorVariableNameLength(int vectorVariableIndex,const Visualization::Abstract::VariableManager* variableManager);
+bool readElementAlgorithmName(Misc::File& elementFile,bool ascii,char name[256]); // Reads the name of the algorithm that created the next visualization element in an element file, truncating ASCII names to 255 characters; returns false at the end of the file
 
 template <class DataSourceParam>
 int
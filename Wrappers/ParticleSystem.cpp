@@ -0,0 +1,312 @@
+/***********************************************************************
+ParticleSystem - Wrapper class for animated particles advected through
+a vector field as visualization elements.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_WRAPPERS_PARTICLESYSTEM_IMPLEMENTATION
+
+#include <string.h>
+#include <Math/Math.h>
+#include <GL/gl.h>
+#include <GL/GLVertexArrayParts.h>
+#include <GL/GLColorMap.h>
+#include <GL/GLContextData.h>
+#include <Vrui/Vrui.h>
+
+#include <Wrappers/ParticleSystem.h>
+
+namespace Visualization {
+
+namespace Wrappers {
+
+/*****************************************
+Methods of class ParticleSystem::DataItem:
+*****************************************/
+
+template <class DataSetWrapperParam>
+inline
+ParticleSystem<DataSetWrapperParam>::DataItem::DataItem(
+	void)
+	:colorMapTextureId(0)
+	{
+	/* Create the color map texture object: */
+	glGenTextures(1,&colorMapTextureId);
+	}
+
+template <class DataSetWrapperParam>
+inline
+ParticleSystem<DataSetWrapperParam>::DataItem::~DataItem(
+	void)
+	{
+	/* Delete the color map texture object: */
+	glDeleteTextures(1,&colorMapTextureId);
+	}
+
+/*******************************
+Methods of class ParticleSystem:
+*******************************/
+
+template <class DataSetWrapperParam>
+inline
+void*
+ParticleSystem<DataSetWrapperParam>::animationThreadMethod(
+	void)
+	{
+	unsigned int numAdvectedFrames=0;
+	while(true)
+		{
+		/* Wait until the rendering loop requests more particle frames: */
+		unsigned int numFrames;
+		int nextIndex;
+		{
+		Threads::Mutex::Lock frameLock(frameMutex);
+		while(!shutdownAnimation&&numAdvectedFrames==numRequestedFrames)
+			frameRequestCond.wait(frameMutex);
+		if(shutdownAnimation)
+			break;
+		numFrames=numRequestedFrames-numAdvectedFrames;
+		numAdvectedFrames=numRequestedFrames;
+		
+		/* Get the next free particle frame: */
+		nextIndex=(lockedIndex+1)%3;
+		if(nextIndex==mostRecentIndex)
+			nextIndex=(nextIndex+1)%3;
+		}
+		
+		/* Advance the particles by all requested frames at once, which results in the same state as advancing them frame by frame: */
+		particleAdvector.advect(numStepsPerFrame*numFrames);
+		
+		/* Copy the particle states into the particle frame: */
+		std::vector<Vertex>& frame=frames[nextIndex];
+		frame.resize(particleAdvector.getNumParticles());
+		for(size_t i=0;i<particleAdvector.getNumParticles();++i)
+			{
+			frame[i].texCoord[0]=particleAdvector.getValue(i);
+			frame[i].position=typename Vertex::Position(particleAdvector.getPosition(i).getComponents());
+			}
+		
+		/* Push the particle frame to the rendering thread: */
+		{
+		Threads::Mutex::Lock frameLock(frameMutex);
+		mostRecentIndex=nextIndex;
+		}
+		Vrui::requestUpdate();
+		}
+	
+	return 0;
+	}
+
+template <class DataSetWrapperParam>
+inline
+ParticleSystem<DataSetWrapperParam>::ParticleSystem(
+	Visualization::Abstract::Parameters* sParameters,
+	const typename ParticleSystem<DataSetWrapperParam>::DS* sDs,
+	const typename ParticleSystem<DataSetWrapperParam>::VE& sVe,
+	const typename ParticleSystem<DataSetWrapperParam>::SE& sSe,
+	const typename ParticleSystem<DataSetWrapperParam>::Point& seedCenter,
+	typename ParticleSystem<DataSetWrapperParam>::Scalar seedRadius,
+	const typename ParticleSystem<DataSetWrapperParam>::DSL& seedLocator,
+	size_t numParticles,
+	typename ParticleSystem<DataSetWrapperParam>::Scalar stepSize,
+	typename ParticleSystem<DataSetWrapperParam>::Scalar lifeTime,
+	double sStartTime,
+	unsigned int numThreads,
+	const GLColorMap* sColorMap)
+	:Visualization::Abstract::Element(sParameters),
+	 colorMap(sColorMap),
+	 particleAdvector(sDs,sVe,sSe),
+	 numStepsPerFrame(1),minFrameTime(1.0/60.0),
+	 pointSize(2.0f),
+	 startTime(sStartTime),
+	 shutdownAnimation(false),
+	 numRequestedFrames(0),
+	 lockedIndex(0),mostRecentIndex(0)
+	{
+	/* Seed the particles; all cluster nodes use the same random seed to start from the same state: */
+	particleAdvector.setStepSize(stepSize);
+	particleAdvector.setLifeTime(lifeTime);
+	particleAdvector.setNumThreads(numThreads);
+	if(particleAdvector.setSeed(seedCenter,seedRadius,seedLocator))
+		particleAdvector.setNumParticles(numParticles);
+	
+	/* Start the animation thread: */
+	animationThread.start(this,&ParticleSystem::animationThreadMethod);
+	}
+
+template <class DataSetWrapperParam>
+inline
+ParticleSystem<DataSetWrapperParam>::~ParticleSystem(
+	void)
+	{
+	/* Shut down the animation thread: */
+	{
+	Threads::Mutex::Lock frameLock(frameMutex);
+	shutdownAnimation=true;
+	frameRequestCond.signal();
+	}
+	animationThread.join();
+	}
+
+template <class DataSetWrapperParam>
+inline
+std::string
+ParticleSystem<DataSetWrapperParam>::getName(
+	void) const
+	{
+	return "Particle System";
+	}
+
+template <class DataSetWrapperParam>
+inline
+size_t
+ParticleSystem<DataSetWrapperParam>::getSize(
+	void) const
+	{
+	return particleAdvector.getNumParticles();
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystem<DataSetWrapperParam>::frame(
+	void)
+	{
+	/* Calculate the number of particle frames due at the current application time, which the master node distributes to all cluster nodes: */
+	double animationTime=Vrui::getApplicationTime()-startTime;
+	unsigned int numDueFrames=animationTime>0.0?(unsigned int)(Math::floor(animationTime/minFrameTime))+1U:1U;
+	
+	{
+	Threads::Mutex::Lock frameLock(frameMutex);
+	
+	/* Request the due particle frames from the animation thread: */
+	if(numRequestedFrames<numDueFrames)
+		{
+		numRequestedFrames=numDueFrames;
+		frameRequestCond.signal();
+		}
+	
+	/* Lock the most recent particle frame for all rendering passes of this frame: */
+	lockedIndex=mostRecentIndex;
+	}
+	
+	/* Keep the animation running: */
+	Vrui::requestUpdate();
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystem<DataSetWrapperParam>::glRenderAction(
+	GLContextData& contextData) const
+	{
+	const std::vector<Vertex>& frame=frames[lockedIndex];
+	if(frame.empty())
+		return;
+	
+	/* Set up OpenGL state for particle rendering: */
+	GLboolean lightingEnabled=glIsEnabled(GL_LIGHTING);
+	if(lightingEnabled)
+		glDisable(GL_LIGHTING);
+	GLboolean texture1DEnabled=glIsEnabled(GL_TEXTURE_1D);
+	if(!texture1DEnabled)
+		glEnable(GL_TEXTURE_1D);
+	GLboolean texture2DEnabled=glIsEnabled(GL_TEXTURE_2D);
+	if(texture2DEnabled)
+		glDisable(GL_TEXTURE_2D);
+	GLboolean texture3DEnabled=glIsEnabled(GL_TEXTURE_3D);
+	if(texture3DEnabled)
+		glDisable(GL_TEXTURE_3D);
+	GLfloat oldPointSize;
+	glGetFloatv(GL_POINT_SIZE,&oldPointSize);
+	glPointSize(pointSize);
+	
+	/* Bind the color map texture, and only upload the color map again if it was edited since the last upload: */
+	DataItem* dataItem=contextData.template retrieveDataItem<DataItem>(this);
+	GLint oldTexture1D;
+	glGetIntegerv(GL_TEXTURE_BINDING_1D,&oldTexture1D);
+	glBindTexture(GL_TEXTURE_1D,dataItem->colorMapTextureId);
+	const GLfloat* colors=reinterpret_cast<const GLfloat*>(colorMap->getColors());
+	if(memcmp(dataItem->colorMapColors,colors,sizeof(dataItem->colorMapColors))!=0)
+		{
+		glTexImage1D(GL_TEXTURE_1D,0,GL_RGBA8,256,0,GL_RGBA,GL_FLOAT,colors);
+		memcpy(dataItem->colorMapColors,colors,sizeof(dataItem->colorMapColors));
+		}
+	glTexEnvi(GL_TEXTURE_ENV,GL_TEXTURE_ENV_MODE,GL_REPLACE);
+	
+	GLint matrixMode;
+	glGetIntegerv(GL_MATRIX_MODE,&matrixMode);
+	if(matrixMode!=GL_TEXTURE)
+		glMatrixMode(GL_TEXTURE);
+	glPushMatrix();
+	glLoadIdentity();
+	double mapMin=colorMap->getScalarRangeMin();
+	double mapRange=colorMap->getScalarRangeMax()-mapMin;
+	glScaled(1.0/mapRange,1.0,1.0);
+	glTranslated(-mapMin,0.0,0.0);
+	glColor4f(1.0f,1.0f,1.0f,1.0f);
+	
+	/* Render the particles as a vertex array of points: */
+	GLVertexArrayParts::enable(Vertex::getPartsMask());
+	glVertexPointer(&frame[0]);
+	glDrawArrays(GL_POINTS,0,frame.size());
+	GLVertexArrayParts::disable(Vertex::getPartsMask());
+	
+	/* Reset OpenGL state: */
+	glPopMatrix();
+	glBindTexture(GL_TEXTURE_1D,oldTexture1D);
+	if(matrixMode!=GL_TEXTURE)
+		glMatrixMode(matrixMode);
+	glPointSize(oldPointSize);
+	if(texture3DEnabled)
+		glEnable(GL_TEXTURE_3D);
+	if(texture2DEnabled)
+		glEnable(GL_TEXTURE_2D);
+	if(!texture1DEnabled)
+		glDisable(GL_TEXTURE_1D);
+	if(lightingEnabled)
+		glEnable(GL_LIGHTING);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystem<DataSetWrapperParam>::initContext(
+	GLContextData& contextData) const
+	{
+	/* Create a new context data item: */
+	DataItem* dataItem=new DataItem;
+	contextData.addDataItem(this,dataItem);
+	
+	/* Set up the color map texture and upload the current color map: */
+	glBindTexture(GL_TEXTURE_1D,dataItem->colorMapTextureId);
+	glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_BASE_LEVEL,0);
+	glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_MAX_LEVEL,0);
+	glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
+	const GLfloat* colors=reinterpret_cast<const GLfloat*>(colorMap->getColors());
+	glTexImage1D(GL_TEXTURE_1D,0,GL_RGBA8,256,0,GL_RGBA,GL_FLOAT,colors);
+	memcpy(dataItem->colorMapColors,colors,sizeof(dataItem->colorMapColors));
+	glBindTexture(GL_TEXTURE_1D,0);
+	}
+
+}
+
+}
@@ -0,0 +1,128 @@
+/***********************************************************************
+ParticleSystem - Wrapper class for animated particles advected through
+a vector field as visualization elements.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_WRAPPERS_PARTICLESYSTEM_INCLUDED
+#define VISUALIZATION_WRAPPERS_PARTICLESYSTEM_INCLUDED
+
+#include <vector>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
+#define NONSTANDARD_GLVERTEX_TEMPLATES
+#include <GL/gl.h>
+#include <GL/GLVertex.h>
+#include <GL/GLObject.h>
+
+#include <Abstract/Element.h>
+#include <Templatized/ParticleAdvector.h>
+
+/* Forward declarations: */
+class GLColorMap;
+
+namespace Visualization {
+
+namespace Wrappers {
+
+template <class DataSetWrapperParam>
+class ParticleSystem:public Visualization::Abstract::Element,public GLObject
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::Element Base; // Base class
+	typedef DataSetWrapperParam DataSetWrapper; // Compatible data set type
+	typedef typename DataSetWrapper::DS DS; // Type of templatized data set
+	typedef typename DS::Scalar Scalar; // Scalar type of data set's domain
+	static const int dimension=DS::dimension; // Dimension of data set's domain
+	typedef typename DS::Point Point; // Point type of data set's domain
+	typedef typename DataSetWrapper::DSL DSL; // Type of templatized locator
+	typedef typename DataSetWrapper::VE VE; // Type of templatized vector extractor
+	typedef typename DataSetWrapper::SE SE; // Type of templatized scalar extractor
+	typedef typename DataSetWrapper::VScalar VScalar; // Scalar type of scalar extractor
+	typedef Visualization::Templatized::ParticleAdvector<DS,VE,SE> ParticleAdvector; // Type of templatized particle advector
+	typedef GLVertex<VScalar,1,void,0,void,Scalar,dimension> Vertex; // Data type for particle vertices
+	
+	private:
+	struct DataItem:public GLObject::DataItem
+		{
+		/* Elements: */
+		public:
+		GLuint colorMapTextureId; // ID of the 1D texture object holding the color map
+		GLfloat colorMapColors[256*4]; // Color map entries most recently uploaded into the texture object
+		
+		/* Constructors and destructors: */
+		DataItem(void);
+		virtual ~DataItem(void);
+		};
+	
+	/* Elements: */
+	const GLColorMap* colorMap; // Color map for particle scalar values
+	ParticleAdvector particleAdvector; // The templatized particle advector
+	unsigned int numStepsPerFrame; // Number of advection steps between published particle frames
+	double minFrameTime; // Minimum time between published particle frames in seconds, to limit the animation speed
+	float pointSize; // Size of the points rendering the particles in pixels
+	double startTime; // Application time at which the animation started on the master node
+	Threads::Thread animationThread; // Thread advecting the particles independently of the rendering loop
+	volatile bool shutdownAnimation; // Flag to tell the animation thread to shut down
+	std::vector<Vertex> frames[3]; // Triple buffer of particle frames shared between the animation thread and the rendering thread
+	Threads::Mutex frameMutex; // Mutex protecting the triple buffer indices and the requested number of particle frames
+	Threads::Cond frameRequestCond; // Condition variable to wake up the animation thread when more particle frames are requested
+	unsigned int numRequestedFrames; // Total number of particle frames the animation thread has to advect since the animation started
+	volatile int lockedIndex; // Index of the particle frame currently being rendered
+	volatile int mostRecentIndex; // Index of the most recently published particle frame
+	
+	/* Private methods: */
+	void* animationThreadMethod(void); // Advects the particles and publishes particle frames until shut down
+	
+	/* Constructors and destructors: */
+	public:
+	ParticleSystem(Visualization::Abstract::Parameters* sParameters,const DS* sDs,const VE& sVe,const SE& sSe,const Point& seedCenter,Scalar seedRadius,const DSL& seedLocator,size_t numParticles,Scalar stepSize,Scalar lifeTime,double sStartTime,unsigned int numThreads,const GLColorMap* sColorMap); // Creates a particle system for the given parameters and starts animating it from the given application time
+	private:
+	ParticleSystem(const ParticleSystem& source); // Prohibit copy constructor
+	ParticleSystem& operator=(const ParticleSystem& source); // Prohibit assignment operator
+	public:
+	virtual ~ParticleSystem(void); // Stops the animation and destroys the particle system
+	
+	/* Methods from Visualization::Abstract::Element: */
+	virtual std::string getName(void) const;
+	virtual size_t getSize(void) const;
+	virtual void frame(void);
+	virtual void glRenderAction(GLContextData& contextData) const;
+	
+	/* Methods from GLObject: */
+	virtual void initContext(GLContextData& contextData) const;
+	
+	/* New methods: */
+	const GLColorMap* getColorMap(void) const // Returns the color map
+		{
+		return colorMap;
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_WRAPPERS_PARTICLESYSTEM_IMPLEMENTATION
+#include <Wrappers/ParticleSystem.cpp>
+#endif
+
+#endif
@@ -0,0 +1,530 @@
+/***********************************************************************
+ParticleSystemExtractor - Wrapper class to map from the abstract
+visualization algorithm interface to a templatized particle advector
+implementation.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_WRAPPERS_PARTICLESYSTEMEXTRACTOR_IMPLEMENTATION
+
+#include <Misc/ThrowStdErr.h>
+#include <Misc/File.h>
+#include <Comm/MulticastPipe.h>
+#include <Comm/ClusterPipe.h>
+#include <Math/Math.h>
+#include <GLMotif/StyleSheet.h>
+#include <GLMotif/WidgetManager.h>
+#include <GLMotif/PopupWindow.h>
+#include <GLMotif/RowColumn.h>
+#include <GLMotif/Label.h>
+#include <GLMotif/TextField.h>
+#include <GLMotif/Slider.h>
+#include <Vrui/Vrui.h>
+
+#include <Abstract/VariableManager.h>
+#include <Wrappers/VectorExtractor.h>
+#include <Wrappers/ScalarExtractor.h>
+#include <Wrappers/ParametersIOHelper.h>
+
+#include <Wrappers/ParticleSystemExtractor.h>
+
+namespace Visualization {
+
+namespace Wrappers {
+
+/****************************************************
+Methods of class ParticleSystemExtractor::Parameters:
+****************************************************/
+
+template <class DataSetWrapperParam>
+template <class DataSourceParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::readBinary(
+	DataSourceParam& dataSource,
+	bool raw,
+	const Visualization::Abstract::VariableManager* variableManager)
+	{
+	/* Read all elements: */
+	if(raw)
+		vectorVariableIndex=dataSource.template read<int>();
+	else
+		vectorVariableIndex=readVectorVariableNameBinary<DataSourceParam>(dataSource,variableManager);
+	if(raw)
+		colorScalarVariableIndex=dataSource.template read<int>();
+	else
+		colorScalarVariableIndex=readScalarVariableNameBinary<DataSourceParam>(dataSource,variableManager);
+	numParticles=dataSource.template read<unsigned int>();
+	stepSize=dataSource.template read<Scalar>();
+	lifeTime=dataSource.template read<Scalar>();
+	seedRadius=dataSource.template read<Scalar>();
+	dataSource.template read<Scalar>(base.getComponents(),dimension);
+	if(raw)
+		startTime=dataSource.template read<double>();
+	}
+
+template <class DataSetWrapperParam>
+template <class DataSinkParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::writeBinary(
+	DataSinkParam& dataSink,
+	bool raw,
+	const Visualization::Abstract::VariableManager* variableManager) const
+	{
+	/* Write all elements: */
+	if(raw)
+		dataSink.template write<int>(vectorVariableIndex);
+	else
+		writeVectorVariableNameBinary<DataSinkParam>(dataSink,vectorVariableIndex,variableManager);
+	if(raw)
+		dataSink.template write<int>(colorScalarVariableIndex);
+	else
+		writeScalarVariableNameBinary<DataSinkParam>(dataSink,colorScalarVariableIndex,variableManager);
+	dataSink.template write<unsigned int>(numParticles);
+	dataSink.template write<Scalar>(stepSize);
+	dataSink.template write<Scalar>(lifeTime);
+	dataSink.template write<Scalar>(seedRadius);
+	dataSink.template write<Scalar>(base.getComponents(),dimension);
+	if(raw)
+		dataSink.template write<double>(startTime);
+	}
+
+template <class DataSetWrapperParam>
+inline
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::Parameters(
+	Visualization::Abstract::VariableManager* variableManager)
+	:vectorVariableIndex(variableManager->getCurrentVectorVariable()),
+	 colorScalarVariableIndex(variableManager->getCurrentScalarVariable()),
+	 startTime(0.0),
+	 locatorValid(false)
+	{
+	update(variableManager,false);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::read(
+	Misc::File& file,
+	bool ascii,
+	Visualization::Abstract::VariableManager* variableManager)
+	{
+	if(ascii)
+		{
+		/* Parse the parameter section: */
+		AsciiParameterFileSectionHash* hash=parseAsciiParameterFileSection<Misc::File>(file);
+		
+		/* Extract the parameters: */
+		vectorVariableIndex=readVectorVariableNameAscii(hash,"vectorVariable",variableManager);
+		colorScalarVariableIndex=readScalarVariableNameAscii(hash,"colorScalarVariable",variableManager);
+		numParticles=readParameterAscii<unsigned int>(hash,"numParticles",numParticles);
+		stepSize=readParameterAscii<Scalar>(hash,"stepSize",stepSize);
+		lifeTime=readParameterAscii<Scalar>(hash,"lifeTime",lifeTime);
+		seedRadius=readParameterAscii<Scalar>(hash,"seedRadius",seedRadius);
+		base=readParameterAscii<Point>(hash,"base",base);
+		
+		/* Clean up: */
+		deleteAsciiParameterFileSectionHash(hash);
+		}
+	else
+		{
+		/* Read from binary file: */
+		readBinary(file,false,variableManager);
+		}
+	
+	/* Update derived parameters: */
+	update(variableManager,true);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::read(
+	Comm::MulticastPipe& pipe,
+	Visualization::Abstract::VariableManager* variableManager)
+	{
+	/* Read from multicast pipe: */
+	readBinary(pipe,true,variableManager);
+	
+	/* Update derived parameters: */
+	update(variableManager,true);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::read(
+	Comm::ClusterPipe& pipe,
+	Visualization::Abstract::VariableManager* variableManager)
+	{
+	/* Read (and ignore) the parameter packet size from the cluster pipe: */
+	pipe.read<unsigned int>();
+	
+	/* Read from cluster pipe: */
+	readBinary(pipe,false,variableManager);
+	
+	/* Update derived parameters: */
+	update(variableManager,true);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::write(
+	Misc::File& file,
+	bool ascii,
+	const Visualization::Abstract::VariableManager* variableManager) const
+	{
+	if(ascii)
+		{
+		/* Write to ASCII file: */
+		file.write("{\n",2);
+		writeVectorVariableNameAscii<Misc::File>(file,"vectorVariable",vectorVariableIndex,variableManager);
+		writeScalarVariableNameAscii<Misc::File>(file,"colorScalarVariable",colorScalarVariableIndex,variableManager);
+		writeParameterAscii<Misc::File,unsigned int>(file,"numParticles",numParticles);
+		writeParameterAscii<Misc::File,Scalar>(file,"stepSize",stepSize);
+		writeParameterAscii<Misc::File,Scalar>(file,"lifeTime",lifeTime);
+		writeParameterAscii<Misc::File,Scalar>(file,"seedRadius",seedRadius);
+		writeParameterAscii<Misc::File,Point>(file,"base",base);
+		file.write("}\n",2);
+		}
+	else
+		{
+		/* Write to binary file: */
+		writeBinary(file,false,variableManager);
+		}
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::write(
+	Comm::MulticastPipe& pipe,
+	const Visualization::Abstract::VariableManager* variableManager) const
+	{
+	/* Write to multicast pipe: */
+	writeBinary(pipe,true,variableManager);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::write(
+	Comm::ClusterPipe& pipe,
+	const Visualization::Abstract::VariableManager* variableManager) const
+	{
+	/* Calculate the byte size of the marshalled parameter packet: */
+	size_t packetSize=0;
+	packetSize+=getVectorVariableNameLength(vectorVariableIndex,variableManager);
+	packetSize+=getScalarVariableNameLength(colorScalarVariableIndex,variableManager);
+	packetSize+=sizeof(unsigned int)+sizeof(Scalar)*3;
+	packetSize+=sizeof(Scalar)*dimension;
+	
+	/* Write the packet size to the cluster pipe: */
+	pipe.write<unsigned int>(packetSize);
+	
+	/* Write to cluster pipe: */
+	writeBinary(pipe,false,variableManager);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::Parameters::update(
+	Visualization::Abstract::VariableManager* variableManager,
+	bool track)
+	{
+	/* Get the abstract data set pointer: */
+	const Visualization::Abstract::DataSet* ds1=variableManager->getDataSetByVectorVariable(vectorVariableIndex);
+	const Visualization::Abstract::DataSet* ds2=variableManager->getDataSetByScalarVariable(colorScalarVariableIndex);
+	if(ds1!=ds2)
+		Misc::throwStdErr("ParticleSystemExtractor::Parameters::update: Incompatible vector and scalar variables");
+	
+	/* Get a pointer to the data set wrapper: */
+	const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(ds1);
+	if(myDataSet==0)
+		Misc::throwStdErr("ParticleSystemExtractor::Parameters::update: Mismatching data set type");
+	ds=&myDataSet->getDs();
+	
+	/* Get a pointer to the vector extractor wrapper: */
+	const VectorExtractor* myVectorExtractor=dynamic_cast<const VectorExtractor*>(variableManager->getVectorExtractor(vectorVariableIndex));
+	if(myVectorExtractor==0)
+		Misc::throwStdErr("ParticleSystemExtractor::Parameters::update: Mismatching vector extractor type");
+	ve=&myVectorExtractor->getVe();
+	
+	/* Get a pointer to the color scalar extractor wrapper: */
+	const ScalarExtractor* myScalarExtractor=dynamic_cast<const ScalarExtractor*>(variableManager->getScalarExtractor(colorScalarVariableIndex));
+	if(myScalarExtractor==0)
+		Misc::throwStdErr("ParticleSystemExtractor::Parameters::update: Mismatching scalar extractor type");
+	cse=&myScalarExtractor->getSe();
+	
+	/* Get a templatized locator: */
+	dsl=ds->getLocator();
+	if(track)
+		{
+		/* Locate the base point: */
+		locatorValid=dsl.locatePoint(base);
+		}
+	}
+
+/************************************************
+Static elements of class ParticleSystemExtractor:
+************************************************/
+
+template <class DataSetWrapperParam>
+const char* ParticleSystemExtractor<DataSetWrapperParam>::name="Particle System";
+
+/****************************************
+Methods of class ParticleSystemExtractor:
+****************************************/
+
+template <class DataSetWrapperParam>
+inline
+typename ParticleSystemExtractor<DataSetWrapperParam>::ParticleSystem*
+ParticleSystemExtractor<DataSetWrapperParam>::createParticleSystem(
+	typename ParticleSystemExtractor<DataSetWrapperParam>::Parameters* myParameters) const
+	{
+	/* Create a new particle system, which starts animating immediately: */
+	const GLColorMap* colorMap=getVariableManager()->getColorMap(myParameters->colorScalarVariableIndex);
+	return new ParticleSystem(myParameters,myParameters->ds,*myParameters->ve,*myParameters->cse,myParameters->base,myParameters->seedRadius,myParameters->dsl,myParameters->numParticles,myParameters->stepSize,myParameters->lifeTime,myParameters->startTime,getNumThreads(),colorMap);
+	}
+
+template <class DataSetWrapperParam>
+inline
+ParticleSystemExtractor<DataSetWrapperParam>::ParticleSystemExtractor(
+	Visualization::Abstract::VariableManager* sVariableManager,
+	Comm::MulticastPipe* sPipe)
+	:Abstract::Algorithm(sVariableManager,sPipe),
+	 parameters(sVariableManager),
+	 numParticlesValue(0),numParticlesSlider(0),
+	 stepSizeValue(0),stepSizeSlider(0),
+	 lifeTimeValue(0),lifeTimeSlider(0),
+	 seedRadiusValue(0),seedRadiusSlider(0)
+	{
+	/* Initialize parameters: */
+	parameters.numParticles=10000;
+	parameters.stepSize=Scalar(1.0e-4);
+	parameters.lifeTime=Scalar(0.1);
+	parameters.seedRadius=parameters.ds->calcAverageCellSize();
+	}
+
+template <class DataSetWrapperParam>
+inline
+ParticleSystemExtractor<DataSetWrapperParam>::~ParticleSystemExtractor(
+	void)
+	{
+	}
+
+template <class DataSetWrapperParam>
+inline
+GLMotif::Widget*
+ParticleSystemExtractor<DataSetWrapperParam>::createSettingsDialog(
+	GLMotif::WidgetManager* widgetManager)
+	{
+	/* Get the style sheet: */
+	const GLMotif::StyleSheet* ss=widgetManager->getStyleSheet();
+	
+	/* Create the settings dialog window: */
+	GLMotif::PopupWindow* settingsDialogPopup=new GLMotif::PopupWindow("ParticleSystemExtractorSettingsDialogPopup",widgetManager,"Particle System Extractor Settings");
+	settingsDialogPopup->setResizableFlags(true,false);
+	
+	GLMotif::RowColumn* settingsDialog=new GLMotif::RowColumn("settingsDialog",settingsDialogPopup,false);
+	settingsDialog->setNumMinorWidgets(3);
+	
+	new GLMotif::Label("NumParticlesLabel",settingsDialog,"Number Of Particles");
+	
+	numParticlesValue=new GLMotif::TextField("NumParticlesValue",settingsDialog,12);
+	numParticlesValue->setValue(parameters.numParticles);
+	
+	numParticlesSlider=new GLMotif::Slider("NumParticlesSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
+	numParticlesSlider->setValueRange(2.0,6.0,0.1);
+	numParticlesSlider->setValue(Math::log10(double(parameters.numParticles)));
+	numParticlesSlider->getValueChangedCallbacks().add(this,&ParticleSystemExtractor::numParticlesSliderCallback);
+	
+	new GLMotif::Label("StepSizeLabel",settingsDialog,"Step Size");
+	
+	stepSizeValue=new GLMotif::TextField("StepSizeValue",settingsDialog,12);
+	stepSizeValue->setPrecision(6);
+	stepSizeValue->setValue(double(parameters.stepSize));
+	
+	stepSizeSlider=new GLMotif::Slider("StepSizeSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
+	stepSizeSlider->setValueRange(-8.0,2.0,0.1);
+	stepSizeSlider->setValue(Math::log10(double(parameters.stepSize)));
+	stepSizeSlider->getValueChangedCallbacks().add(this,&ParticleSystemExtractor::stepSizeSliderCallback);
+	
+	new GLMotif::Label("LifeTimeLabel",settingsDialog,"Particle Life Time");
+	
+	lifeTimeValue=new GLMotif::TextField("LifeTimeValue",settingsDialog,12);
+	lifeTimeValue->setPrecision(6);
+	lifeTimeValue->setValue(double(parameters.lifeTime));
+	
+	lifeTimeSlider=new GLMotif::Slider("LifeTimeSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
+	lifeTimeSlider->setValueRange(-6.0,4.0,0.1);
+	lifeTimeSlider->setValue(Math::log10(double(parameters.lifeTime)));
+	lifeTimeSlider->getValueChangedCallbacks().add(this,&ParticleSystemExtractor::lifeTimeSliderCallback);
+	
+	new GLMotif::Label("SeedRadiusLabel",settingsDialog,"Seed Sphere Radius");
+	
+	seedRadiusValue=new GLMotif::TextField("SeedRadiusValue",settingsDialog,12);
+	seedRadiusValue->setPrecision(6);
+	seedRadiusValue->setValue(double(parameters.seedRadius));
+	
+	seedRadiusSlider=new GLMotif::Slider("SeedRadiusSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
+	double srl=Math::log10(double(parameters.seedRadius));
+	seedRadiusSlider->setValueRange(srl-4.0,srl+4.0,0.1);
+	seedRadiusSlider->setValue(srl);
+	seedRadiusSlider->getValueChangedCallbacks().add(this,&ParticleSystemExtractor::seedRadiusSliderCallback);
+	
+	settingsDialog->manageChild();
+	
+	return settingsDialogPopup;
+	}
+
+template <class DataSetWrapperParam>
+inline
+Visualization::Abstract::Parameters*
+ParticleSystemExtractor<DataSetWrapperParam>::cloneParameters(
+	void) const
+	{
+	/* Start animating the particle system at the current application time; the slave nodes receive the master's start time with the other parameters: */
+	Parameters* result=new Parameters(parameters);
+	result->startTime=Vrui::getApplicationTime();
+	return result;
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::setSeedLocator(
+	const Visualization::Abstract::DataSet::Locator* seedLocator)
+	{
+	/* Get a pointer to the locator wrapper: */
+	const Locator* myLocator=dynamic_cast<const Locator*>(seedLocator);
+	if(myLocator==0)
+		Misc::throwStdErr("ParticleSystemExtractor::setSeedLocator: Mismatching locator type");
+	
+	/* Copy the locator: */
+	parameters.dsl=myLocator->getDsl();
+	parameters.locatorValid=myLocator->isValid();
+	
+	/* Set the seed sphere's center: */
+	parameters.base=Point(seedLocator->getPosition());
+	}
+
+template <class DataSetWrapperParam>
+inline
+Visualization::Abstract::Element*
+ParticleSystemExtractor<DataSetWrapperParam>::createElement(
+	Visualization::Abstract::Parameters* extractParameters)
+	{
+	/* Get proper pointer to parameter object: */
+	Parameters* myParameters=dynamic_cast<Parameters*>(extractParameters);
+	if(myParameters==0)
+		Misc::throwStdErr("ParticleSystemExtractor::createElement: Mismatching parameter object type");
+	
+	/* Create a new particle system visualization element: */
+	return createParticleSystem(myParameters);
+	}
+
+template <class DataSetWrapperParam>
+inline
+Visualization::Abstract::Element*
+ParticleSystemExtractor<DataSetWrapperParam>::startSlaveElement(
+	Visualization::Abstract::Parameters* extractParameters)
+	{
+	if(isMaster())
+		Misc::throwStdErr("ParticleSystemExtractor::startSlaveElement: Cannot be called on master node");
+	
+	/* Get proper pointer to parameter object: */
+	Parameters* myParameters=dynamic_cast<Parameters*>(extractParameters);
+	if(myParameters==0)
+		Misc::throwStdErr("ParticleSystemExtractor::startSlaveElement: Mismatching parameter object type");
+	
+	/* Create a new particle system visualization element; particles are advected locally on each node: */
+	return createParticleSystem(myParameters);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::continueSlaveElement(
+	void)
+	{
+	if(isMaster())
+		Misc::throwStdErr("ParticleSystemExtractor::continueSlaveElement: Cannot be called on master node");
+	
+	/* Nothing to receive; the particle system is animated locally: */
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::numParticlesSliderCallback(
+	GLMotif::Slider::ValueChangedCallbackData* cbData)
+	{
+	/* Get the new slider value and convert to number of particles: */
+	parameters.numParticles=(unsigned int)(Math::floor(Math::pow(10.0,double(cbData->value))+0.5));
+	
+	/* Update the text field: */
+	numParticlesValue->setValue(parameters.numParticles);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::stepSizeSliderCallback(
+	GLMotif::Slider::ValueChangedCallbackData* cbData)
+	{
+	/* Get the new slider value and convert to step size: */
+	parameters.stepSize=Scalar(Math::pow(10.0,double(cbData->value)));
+	
+	/* Update the text field: */
+	stepSizeValue->setValue(double(parameters.stepSize));
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::lifeTimeSliderCallback(
+	GLMotif::Slider::ValueChangedCallbackData* cbData)
+	{
+	/* Get the new slider value and convert to life time: */
+	parameters.lifeTime=Scalar(Math::pow(10.0,double(cbData->value)));
+	
+	/* Update the text field: */
+	lifeTimeValue->setValue(double(parameters.lifeTime));
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+ParticleSystemExtractor<DataSetWrapperParam>::seedRadiusSliderCallback(
+	GLMotif::Slider::ValueChangedCallbackData* cbData)
+	{
+	/* Get the new slider value and convert to seed sphere radius: */
+	parameters.seedRadius=Scalar(Math::pow(10.0,double(cbData->value)));
+	
+	/* Update the text field: */
+	seedRadiusValue->setValue(double(parameters.seedRadius));
+	}
+
+}
+
+}
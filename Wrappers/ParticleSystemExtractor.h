@@ -0,0 +1,190 @@
+/***********************************************************************
+ParticleSystemExtractor - Wrapper class to map from the abstract
+visualization algorithm interface to a templatized particle advector
+implementation.
+Copyright (c) 2026 agent
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_WRAPPERS_PARTICLESYSTEMEXTRACTOR_INCLUDED
+#define VISUALIZATION_WRAPPERS_PARTICLESYSTEMEXTRACTOR_INCLUDED
+
+#include <GLMotif/Slider.h>
+
+#include <Abstract/DataSet.h>
+#include <Abstract/Parameters.h>
+#include <Abstract/Algorithm.h>
+
+#include <Wrappers/ParticleSystem.h>
+
+/* Forward declarations: */
+namespace GLMotif {
+class TextField;
+}
+namespace Visualization {
+namespace Abstract {
+class VectorExtractor;
+class ScalarExtractor;
+class Element;
+}
+namespace Wrappers {
+template <class VEParam>
+class VectorExtractor;
+template <class SEParam>
+class ScalarExtractor;
+}
+}
+
+namespace Visualization {
+
+namespace Wrappers {
+
+template <class DataSetWrapperParam>
+class ParticleSystemExtractor:public Visualization::Abstract::Algorithm
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::Algorithm Base; // Base class
+	typedef DataSetWrapperParam DataSetWrapper; // Compatible data set type
+	typedef typename DataSetWrapper::DS DS; // Type of templatized data set
+	typedef typename DS::Scalar Scalar; // Scalar type of templatized data set's domain
+	static const int dimension=DS::dimension; // Dimension of data set's domain
+	typedef typename DS::Point Point; // Point type of templatized data set's domain
+	typedef typename DataSetWrapper::DSL DSL; // Type of templatized locator
+	typedef typename DataSetWrapper::Locator Locator; // Type of locator wrapper
+	typedef typename DataSetWrapper::VE VE; // Type of templatized vector extractor
+	typedef typename DataSetWrapper::VectorExtractor VectorExtractor; // Compatible vector extractor wrapper class
+	typedef typename DataSetWrapper::SE SE; // Type of templatized scalar extractor
+	typedef typename DataSetWrapper::ScalarExtractor ScalarExtractor; // Compatible scalar extractor wrapper class
+	typedef Visualization::Wrappers::ParticleSystem<DataSetWrapper> ParticleSystem; // Type of created visualization elements
+	
+	private:
+	class Parameters:public Visualization::Abstract::Parameters // Class to store extraction parameters for particle systems
+		{
+		friend class ParticleSystemExtractor;
+		
+		/* Elements: */
+		private:
+		int vectorVariableIndex; // Index of the vector variable advecting the particles
+		int colorScalarVariableIndex; // Index of the scalar variable used to color the particles
+		unsigned int numParticles; // Number of simultaneously advected particles
+		Scalar stepSize; // Fixed particle advection step size
+		Scalar lifeTime; // Life time of particles before they are re-seeded
+		Scalar seedRadius; // Radius of sphere of particle seed positions around the query position
+		Point base; // The particle system's query position
+		double startTime; // Application time at which the particle system starts animating; sent to the slave nodes, but not saved
+		const DS* ds; // Data set in which to advect particles
+		const VE* ve; // Vector extractor for data set
+		const SE* cse; // Color scalar extractor for data set
+		DSL dsl; // Templatized data set locator following the seed point
+		bool locatorValid; // Flag if the locator has been properly initialized, and is inside the data set's domain
+		
+		/* Private methods: */
+		template <class DataSourceParam>
+		void readBinary(DataSourceParam& dataSource,bool raw,const Visualization::Abstract::VariableManager* variableManager); // Reads parameters from a binary data source
+		template <class DataSinkParam>
+		void writeBinary(DataSinkParam& dataSink,bool raw,const Visualization::Abstract::VariableManager* variableManager) const; // Writes parameters to a binary data sink
+		
+		/* Constructors and destructors: */
+		public:
+		Parameters(Visualization::Abstract::VariableManager* variableManager);
+		
+		/* Methods from Abstract::Parameters: */
+		virtual bool isValid(void) const
+			{
+			return locatorValid;
+			}
+		virtual void read(Misc::File& file,bool ascii,Visualization::Abstract::VariableManager* variableManager);
+		virtual void read(Comm::MulticastPipe& pipe,Visualization::Abstract::VariableManager* variableManager);
+		virtual void read(Comm::ClusterPipe& pipe,Visualization::Abstract::VariableManager* variableManager);
+		virtual void write(Misc::File& file,bool ascii,const Visualization::Abstract::VariableManager* variableManager) const;
+		virtual void write(Comm::MulticastPipe& pipe,const Visualization::Abstract::VariableManager* variableManager) const;
+		virtual void write(Comm::ClusterPipe& pipe,const Visualization::Abstract::VariableManager* variableManager) const;
+		virtual Visualization::Abstract::Parameters* clone(void) const
+			{
+			return new Parameters(*this);
+			}
+		virtual void dataSetChanged(Visualization::Abstract::VariableManager* variableManager)
+			{
+			/* Re-locate the seed point in the new data set: */
+			update(variableManager,true);
+			}
+		
+		/* New methods: */
+		void update(Visualization::Abstract::VariableManager* variableManager,bool track); // Updates derived parameters after a read operation
+		};
+	
+	/* Elements: */
+	private:
+	static const char* name; // Identifying name of this algorithm
+	Parameters parameters; // The particle system parameters used by this extractor
+	
+	/* UI components: */
+	GLMotif::TextField* numParticlesValue; // Text field to display current number of particles
+	GLMotif::Slider* numParticlesSlider; // Slider to change current number of particles
+	GLMotif::TextField* stepSizeValue; // Text field to display current advection step size
+	GLMotif::Slider* stepSizeSlider; // Slider to change current advection step size
+	GLMotif::TextField* lifeTimeValue; // Text field to display current particle life time
+	GLMotif::Slider* lifeTimeSlider; // Slider to change current particle life time
+	GLMotif::TextField* seedRadiusValue; // Text field to display current seed sphere radius
+	GLMotif::Slider* seedRadiusSlider; // Slider to change current seed sphere radius
+	
+	/* Private methods: */
+	ParticleSystem* createParticleSystem(Parameters* myParameters) const; // Creates a particle system for the given parameters
+	
+	/* Constructors and destructors: */
+	public:
+	ParticleSystemExtractor(Visualization::Abstract::VariableManager* sVariableManager,Comm::MulticastPipe* sPipe); // Creates a particle system extractor
+	virtual ~ParticleSystemExtractor(void);
+	
+	/* Methods from Visualization::Abstract::Algorithm: */
+	virtual const char* getName(void) const
+		{
+		return name;
+		}
+	virtual bool hasSeededCreator(void) const
+		{
+		return true;
+		}
+	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager);
+	virtual Visualization::Abstract::Parameters* cloneParameters(void) const;
+	virtual void setSeedLocator(const Visualization::Abstract::DataSet::Locator* seedLocator);
+	virtual Visualization::Abstract::Element* createElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual void continueSlaveElement(void);
+	
+	/* New methods: */
+	static const char* getClassName(void) // Returns the algorithm class name
+		{
+		return name;
+		}
+	void numParticlesSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
+	void stepSizeSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
+	void lifeTimeSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
+	void seedRadiusSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_WRAPPERS_PARTICLESYSTEMEXTRACTOR_IMPLEMENTATION
+#include <Wrappers/ParticleSystemExtractor.cpp>
+#endif
+
+#endif
@@ -242,6 +242,20 @@ SeededColoredIsosurfaceExtractor<DataSetWrapperParam>::Parameters::write(
 	writeBinary(pipe,false,variableManager);
 	}
 
+template <class DataSetWrapperParam>
+inline
+void
+SeededColoredIsosurfaceExtractor<DataSetWrapperParam>::Parameters::dataSetChanged(
+	Visualization::Abstract::VariableManager* variableManager)
+	{
+	/* Get a templatized locator to track the seed point in the new data set: */
+	const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(variableManager->getDataSetByScalarVariable(scalarVariableIndex));
+	if(myDataSet==0)
+		Misc::throwStdErr("SeededColoredIsosurfaceExtractor::Parameters::dataSetChanged: Mismatching data set type");
+	dsl=myDataSet->getDs().getLocator();
+	locatorValid=dsl.locatePoint(seedPoint);
+	}
+
 /*********************************************************
 Static elements of class SeededColoredIsosurfaceExtractor:
 *********************************************************/
@@ -457,10 +471,11 @@ SeededColoredIsosurfaceExtractor<DataSetWrapperParam>::createElement(
 	int csvi=myParameters->colorScalarVariableIndex;
 	
 	/* Create a new colored isosurface visualization element: */
-	ColoredIsosurface* result=new ColoredIsosurface(myParameters,myParameters->lighting,getVariableManager()->getColorMap(csvi),getPipe());
+	ColoredIsosurface* result=new ColoredIsosurface(myParameters,myParameters->lighting,getVariableManager()->getColorMap(csvi),getElementPipe());
 	
 	/* Update the colored isosurface extractor: */
 	cise.update(getDs(getVariableManager(),svi,csvi),getSe(getVariableManager()->getScalarExtractor(svi)));
+	result->getSurface().setStreamCompression(cise.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
 	cise.setColorScalarExtractor(getSe(getVariableManager()->getScalarExtractor(csvi)));
 	cise.setExtractionMode(myParameters->smoothShading?CISE::SMOOTH:CISE::FLAT);
 	
@@ -488,10 +503,11 @@ SeededColoredIsosurfaceExtractor<DataSetWrapperParam>::startElement(
 	int csvi=myParameters->colorScalarVariableIndex;
 	
 	/* Create a new colored isosurface visualization element: */
-	currentColoredIsosurface=new ColoredIsosurface(myParameters,myParameters->lighting,getVariableManager()->getColorMap(csvi),getPipe());
+	currentColoredIsosurface=new ColoredIsosurface(myParameters,myParameters->lighting,getVariableManager()->getColorMap(csvi),getElementPipe());
 	
 	/* Update the colored isosurface extractor: */
 	cise.update(getDs(getVariableManager(),svi,csvi),getSe(getVariableManager()->getScalarExtractor(svi)));
+	currentColoredIsosurface->getSurface().setStreamCompression(cise.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
 	cise.setColorScalarExtractor(getSe(getVariableManager()->getScalarExtractor(csvi)));
 	cise.setExtractionMode(myParameters->smoothShading?CISE::SMOOTH:CISE::FLAT);
 	
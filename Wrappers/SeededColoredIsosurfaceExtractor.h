@@ -130,6 +130,12 @@ class SeededColoredIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual bool setSmoothShading(bool newSmoothShading)
+			{
+			smoothShading=newSmoothShading;
+			return true;
+			}
+		virtual void dataSetChanged(Visualization::Abstract::VariableManager* variableManager);
 		};
 	
 	/* Elements: */
@@ -169,6 +175,10 @@ class SeededColoredIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		{
 		return true;
 		}
+	virtual bool hasDeterministicCreator(void) const
+		{
+		return true;
+		}
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager);
 	virtual Visualization::Abstract::Parameters* cloneParameters(void) const
 		{
@@ -227,6 +227,20 @@ SeededIsosurfaceExtractor<DataSetWrapperParam>::Parameters::write(
 	writeBinary(pipe,false,variableManager);
 	}
 
+template <class DataSetWrapperParam>
+inline
+void
+SeededIsosurfaceExtractor<DataSetWrapperParam>::Parameters::dataSetChanged(
+	Visualization::Abstract::VariableManager* variableManager)
+	{
+	/* Get a templatized locator to track the seed point in the new data set: */
+	const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(variableManager->getDataSetByScalarVariable(scalarVariableIndex));
+	if(myDataSet==0)
+		Misc::throwStdErr("SeededIsosurfaceExtractor::Parameters::dataSetChanged: Mismatching data set type");
+	dsl=myDataSet->getDs().getLocator();
+	locatorValid=dsl.locatePoint(seedPoint);
+	}
+
 /**************************************************
 Static elements of class SeededIsosurfaceExtractor:
 **************************************************/
@@ -274,6 +288,7 @@ SeededIsosurfaceExtractor<DataSetWrapperParam>::SeededIsosurfaceExtractor(
 	:Abstract::Algorithm(sVariableManager,sPipe),
 	 parameters(sVariableManager->getCurrentScalarVariable()),
 	 ise(getDs(sVariableManager->getDataSetByScalarVariable(parameters.scalarVariableIndex)),getSe(sVariableManager->getScalarExtractor(parameters.scalarVariableIndex))),
+	 useGradientCache(getDefaultUseGradientCache()),
 	 currentIsosurface(0),
 	 maxNumTrianglesValue(0),maxNumTrianglesSlider(0),
 	 extractionModeBox(0),currentValue(0)
@@ -403,11 +418,18 @@ SeededIsosurfaceExtractor<DataSetWrapperParam>::createElement(
 	int svi=myParameters->scalarVariableIndex;
 	
 	/* Create a new isosurface visualization element: */
-	Isosurface* result=new Isosurface(myParameters,myParameters->isovalue,getVariableManager()->getColorMap(svi),getPipe());
+	Isosurface* result=new Isosurface(myParameters,myParameters->isovalue,getVariableManager()->getColorMap(svi),getElementPipe());
 	
 	/* Update the isosurface extractor: */
 	ise.update(getDs(getVariableManager()->getDataSetByScalarVariable(svi)),getSe(getVariableManager()->getScalarExtractor(svi)));
+	result->getSurface().setStreamCompression(ise.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
 	ise.setExtractionMode(myParameters->smoothShading?ISE::SMOOTH:ISE::FLAT);
+	if(myParameters->smoothShading&&useGradientCache)
+		{
+		/* Look up smooth shading gradients in the scalar variable's gradient cache, if the data set provides one: */
+		const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(getVariableManager()->getDataSetByScalarVariable(svi));
+		ise.setGradientCache(myDataSet->getGradientCache(svi));
+		}
 	
 	/* Extract the isosurface into the visualization element: */
 	ise.startSeededIsosurface(myParameters->dsl,result->getSurface());
@@ -432,11 +454,18 @@ SeededIsosurfaceExtractor<DataSetWrapperParam>::startElement(
 	int svi=myParameters->scalarVariableIndex;
 	
 	/* Create a new isosurface visualization element: */
-	currentIsosurface=new Isosurface(myParameters,myParameters->isovalue,getVariableManager()->getColorMap(svi),getPipe());
+	currentIsosurface=new Isosurface(myParameters,myParameters->isovalue,getVariableManager()->getColorMap(svi),getElementPipe());
 	
 	/* Update the isosurface extractor: */
 	ise.update(getDs(getVariableManager()->getDataSetByScalarVariable(svi)),getSe(getVariableManager()->getScalarExtractor(svi)));
+	currentIsosurface->getSurface().setStreamCompression(ise.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
 	ise.setExtractionMode(myParameters->smoothShading?ISE::SMOOTH:ISE::FLAT);
+	if(myParameters->smoothShading&&useGradientCache)
+		{
+		/* Look up smooth shading gradients in the scalar variable's gradient cache, if the data set provides one: */
+		const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(getVariableManager()->getDataSetByScalarVariable(svi));
+		ise.setGradientCache(myDataSet->getGradientCache(svi));
+		}
 	
 	/* Start extracting the isosurface into the visualization element: */
 	ise.startSeededIsosurface(myParameters->dsl,currentIsosurface->getSurface());
@@ -498,7 +527,7 @@ SeededIsosurfaceExtractor<DataSetWrapperParam>::continueSlaveElement(
 	
 	currentIsosurface->getSurface().receive();
 	}
-	
+
 template <class DataSetWrapperParam>
 inline
 void
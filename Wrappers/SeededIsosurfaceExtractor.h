@@ -125,6 +125,12 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual bool setSmoothShading(bool newSmoothShading)
+			{
+			smoothShading=newSmoothShading;
+			return true;
+			}
+		virtual void dataSetChanged(Visualization::Abstract::VariableManager* variableManager);
 		};
 	
 	/* Elements: */
@@ -132,6 +138,7 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 	static const char* name; // Identifying name of this algorithm
 	Parameters parameters; // The isosurface extraction parameters used by this extractor
 	ISE ise; // The templatized isosurface extractor
+	bool useGradientCache; // Flag whether to look up smooth shading gradients in the data set's gradient cache
 	IsosurfacePointer currentIsosurface; // The currently extracted isosurface visualization element
 	
 	/* UI components: */
@@ -162,6 +169,10 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		{
 		return true;
 		}
+	virtual bool hasDeterministicCreator(void) const
+		{
+		return true;
+		}
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager);
 	virtual Visualization::Abstract::Parameters* cloneParameters(void) const
 		{
@@ -174,6 +185,10 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 	virtual void finishElement(void);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual void continueSlaveElement(void);
+	virtual size_t getNumVisitedCells(void) const
+		{
+		return ise.getNumVisitedCells();
+		}
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
@@ -214,6 +214,20 @@ SeededSliceExtractor<DataSetWrapperParam>::Parameters::write(
 	writeBinary(pipe,false,variableManager);
 	}
 
+template <class DataSetWrapperParam>
+inline
+void
+SeededSliceExtractor<DataSetWrapperParam>::Parameters::dataSetChanged(
+	Visualization::Abstract::VariableManager* variableManager)
+	{
+	/* Get a templatized locator to track the seed point in the new data set: */
+	const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(variableManager->getDataSetByScalarVariable(scalarVariableIndex));
+	if(myDataSet==0)
+		Misc::throwStdErr("SeededSliceExtractor::Parameters::dataSetChanged: Mismatching data set type");
+	dsl=myDataSet->getDs().getLocator();
+	locatorValid=dsl.locatePoint(seedPoint);
+	}
+
 /*********************************************
 Static elements of class SeededSliceExtractor:
 *********************************************/
@@ -305,10 +319,11 @@ SeededSliceExtractor<DataSetWrapperParam>::createElement(
 	int svi=myParameters->scalarVariableIndex;
 	
 	/* Create a new slice visualization element: */
-	Slice* result=new Slice(myParameters,getVariableManager()->getColorMap(svi),getPipe());
+	Slice* result=new Slice(myParameters,getVariableManager()->getColorMap(svi),getElementPipe());
 	
 	/* Update the slice extractor: */
 	sle.update(getDs(getVariableManager()->getDataSetByScalarVariable(svi)),getSe(getVariableManager()->getScalarExtractor(svi)));
+	result->getSurface().setStreamCompression(sle.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
 	
 	/* Extract the slice into the visualization element: */
 	sle.startSeededSlice(myParameters->dsl,myParameters->plane,result->getSurface());
@@ -333,10 +348,11 @@ SeededSliceExtractor<DataSetWrapperParam>::startElement(
 	int svi=myParameters->scalarVariableIndex;
 	
 	/* Create a new slice visualization element: */
-	currentSlice=new Slice(myParameters,getVariableManager()->getColorMap(svi),getPipe());
+	currentSlice=new Slice(myParameters,getVariableManager()->getColorMap(svi),getElementPipe());
 	
 	/* Update the slice extractor: */
 	sle.update(getDs(getVariableManager()->getDataSetByScalarVariable(svi)),getSe(getVariableManager()->getScalarExtractor(svi)));
+	currentSlice->getSurface().setStreamCompression(sle.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
 	
 	/* Start extracting the slice into the visualization element: */
 	sle.startSeededSlice(myParameters->dsl,myParameters->plane,currentSlice->getSurface());
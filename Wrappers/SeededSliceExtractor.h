@@ -118,6 +118,7 @@ class SeededSliceExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual void dataSetChanged(Visualization::Abstract::VariableManager* variableManager);
 		};
 	
 	/* Elements: */
@@ -149,6 +150,10 @@ class SeededSliceExtractor:public Visualization::Abstract::Algorithm
 		{
 		return true;
 		}
+	virtual bool hasDeterministicCreator(void) const
+		{
+		return true;
+		}
 	virtual Visualization::Abstract::Parameters* cloneParameters(void) const
 		{
 		return new Parameters(parameters);
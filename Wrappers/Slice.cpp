@@ -73,6 +73,33 @@ Slice<DataSetWrapperParam>::getSize(
 	return surface.getNumTriangles();
 	}
 
+template <class DataSetWrapperParam>
+inline
+size_t
+Slice<DataSetWrapperParam>::getNumVertices(
+	void) const
+	{
+	return surface.getNumVertices();
+	}
+
+template <class DataSetWrapperParam>
+inline
+size_t
+Slice<DataSetWrapperParam>::getNumTriangles(
+	void) const
+	{
+	return surface.getNumTriangles();
+	}
+
+template <class DataSetWrapperParam>
+inline
+unsigned int
+Slice<DataSetWrapperParam>::calcChecksum(
+	void) const
+	{
+	return surface.calcChecksum();
+	}
+
 template <class DataSetWrapperParam>
 inline
 void
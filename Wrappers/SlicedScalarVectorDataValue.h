@@ -112,6 +112,10 @@ class SlicedScalarVectorDataValue:public SlicedScalarVectorDataValueBase,public
 		/* Initialize the base class: */
 		SlicedScalarVectorDataValueBase::initialize(dataSet->getNumSlices(),dimension,sNumVectorVariables);
 		}
+	bool hasSlicedScalarVariables(void) const
+		{
+		return true;
+		}
 	using SlicedScalarVectorDataValueBase::getNumScalarVariables;
 	using SlicedScalarVectorDataValueBase::getScalarVariableName;
 	using SlicedScalarVectorDataValueBase::getNumVectorVariables;
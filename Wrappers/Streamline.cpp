@@ -72,6 +72,24 @@ Streamline<DataSetWrapperParam>::getSize(
 	return polyline.getNumVertices();
 	}
 
+template <class DataSetWrapperParam>
+inline
+size_t
+Streamline<DataSetWrapperParam>::getNumVertices(
+	void) const
+	{
+	return polyline.getNumVertices();
+	}
+
+template <class DataSetWrapperParam>
+inline
+unsigned int
+Streamline<DataSetWrapperParam>::calcChecksum(
+	void) const
+	{
+	return polyline.calcChecksum();
+	}
+
 template <class DataSetWrapperParam>
 inline
 void
@@ -382,7 +382,7 @@ StreamlineExtractor<DataSetWrapperParam>::createElement(
 	int csvi=myParameters->colorScalarVariableIndex;
 	
 	/* Create a new streamline visualization element: */
-	Streamline* result=new Streamline(myParameters,getVariableManager()->getColorMap(csvi),getPipe());
+	Streamline* result=new Streamline(myParameters,getVariableManager()->getColorMap(csvi),getElementPipe());
 	
 	/* Update the streamline extractor: */
 	sle.update(myParameters->ds,*myParameters->ve,*myParameters->cse);
@@ -410,7 +410,7 @@ StreamlineExtractor<DataSetWrapperParam>::startElement(
 	int csvi=myParameters->colorScalarVariableIndex;
 	
 	/* Create a new streamline visualization element: */
-	currentStreamline=new Streamline(myParameters,getVariableManager()->getColorMap(csvi),getPipe());
+	currentStreamline=new Streamline(myParameters,getVariableManager()->getColorMap(csvi),getElementPipe());
 	
 	/* Update the streamline extractor: */
 	sle.update(myParameters->ds,*myParameters->ve,*myParameters->cse);
@@ -129,6 +129,11 @@ class StreamlineExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual void dataSetChanged(Visualization::Abstract::VariableManager* variableManager)
+			{
+			/* Re-locate the seed point in the new data set: */
+			update(variableManager,true);
+			}
 		
 		/* New methods: */
 		void update(Visualization::Abstract::VariableManager* variableManager,bool track); // Updates derived parameters after a read operation
@@ -165,6 +170,10 @@ class StreamlineExtractor:public Visualization::Abstract::Algorithm
 		{
 		return true;
 		}
+	virtual bool hasDeterministicCreator(void) const
+		{
+		return true;
+		}
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager);
 	virtual Visualization::Abstract::Parameters* cloneParameters(void) const
 		{
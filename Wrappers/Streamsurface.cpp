@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_WRAPPERS_STREAMSURFACE_IMPLEMENTATION
 
 #include <GL/gl.h>
+#include <GL/GLMaterial.h>
 
 #include <Wrappers/Streamsurface.h>
 
@@ -39,8 +40,12 @@ Methods of class Streamsurface:
 template <class DataSetWrapperParam>
 inline
 Streamsurface<DataSetWrapperParam>::Streamsurface(
-	const GLColorMap* sColorMap)
-	:colorMap(sColorMap)
+	Visualization::Abstract::Parameters* sParameters,
+	const GLColorMap* sColorMap,
+	Comm::MulticastPipe* pipe)
+	:Visualization::Abstract::Element(sParameters),
+	 colorMap(sColorMap),
+	 surface(pipe)
 	{
 	}
 
@@ -60,6 +65,33 @@ Streamsurface<DataSetWrapperParam>::getName(
 	return "Stream Surface";
 	}
 
+template <class DataSetWrapperParam>
+inline
+size_t
+Streamsurface<DataSetWrapperParam>::getSize(
+	void) const
+	{
+	return surface.getNumTriangles();
+	}
+
+template <class DataSetWrapperParam>
+inline
+size_t
+Streamsurface<DataSetWrapperParam>::getNumVertices(
+	void) const
+	{
+	return surface.getNumVertices();
+	}
+
+template <class DataSetWrapperParam>
+inline
+size_t
+Streamsurface<DataSetWrapperParam>::getNumTriangles(
+	void) const
+	{
+	return surface.getNumTriangles();
+	}
+
 template <class DataSetWrapperParam>
 inline
 void
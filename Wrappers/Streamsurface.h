@@ -29,7 +29,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/GLVertex.h>
 
 #include <Abstract/Element.h>
-#include <Templatized/IndexedTrianglestripSet.h>
+#include <Templatized/IndexedTriangleSet.h>
 
 /* Forward declarations: */
 class GLColorMap;
@@ -50,7 +50,7 @@ class Streamsurface:public Visualization::Abstract::Element
 	static const int dimension=DS::dimension; // Dimension of data set's domain
 	typedef typename DataSetWrapper::VScalar VScalar; // Scalar type of scalar extractor
 	typedef GLVertex<Scalar,1,void,0,Scalar,Scalar,dimension> Vertex; // Data type for stream surface vertices
-	typedef Visualization::Templatized::IndexedTrianglestripSet<Vertex> Surface; // Data structure to represent stream surfaces
+	typedef Visualization::Templatized::IndexedTriangleSet<Vertex> Surface; // Data structure to represent stream surfaces
 	
 	/* Elements: */
 	private:
@@ -59,28 +59,33 @@ class Streamsurface:public Visualization::Abstract::Element
 	
 	/* Constructors and destructors: */
 	public:
-	Streamsurface(const GLColorMap* sColorMap); // Creates an empty stream surface for the given color map
+	Streamsurface(Visualization::Abstract::Parameters* sParameters,const GLColorMap* sColorMap,Comm::MulticastPipe* pipe); // Creates an empty stream surface for the given parameters
 	private:
 	Streamsurface(const Streamsurface& source); // Prohibit copy constructor
 	Streamsurface& operator=(const Streamsurface& source); // Prohibit assignment operator
 	public:
 	virtual ~Streamsurface(void);
 	
-	/* Methods: */
+	/* Methods from Visualization::Abstract::Element: */
+	virtual std::string getName(void) const;
+	virtual size_t getSize(void) const;
+	virtual size_t getNumVertices(void) const;
+	virtual size_t getNumTriangles(void) const;
+	virtual void glRenderAction(GLContextData& contextData) const;
+	
+	/* New methods: */
 	const GLColorMap* getColorMap(void) const // Returns the color map
 		{
 		return colorMap;
 		}
-	Surface& getSurface(void) // Returns the stream surface representations
+	Surface& getSurface(void) // Returns the stream surface representation
 		{
 		return surface;
 		}
-	size_t getElementSize(void) const // Returns the number of vertex layers in the stream surface
+	size_t getElementSize(void) const // Returns the number of triangles in the stream surface
 		{
-		return surface.getNumStrips()+1;
+		return surface.getNumTriangles();
 		}
-	virtual std::string getName(void) const;
-	virtual void glRenderAction(GLContextData& contextData) const;
 	};
 
 }
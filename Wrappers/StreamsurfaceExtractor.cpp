@@ -2,7 +2,7 @@
 StreamsurfaceExtractor - Wrapper class to map from the abstract
 visualization algorithm interface to a templatized stream surface
 extractor implementation.
-Copyright (c) 2006-2007 Oliver Kreylos
+Copyright (c) 2006-2009 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -23,9 +23,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #define VISUALIZATION_WRAPPERS_STREAMSURFACEEXTRACTOR_IMPLEMENTATION
 
-#include <stdio.h>
 #include <Misc/ThrowStdErr.h>
+#include <Misc/File.h>
+#include <Comm/MulticastPipe.h>
+#include <Comm/ClusterPipe.h>
 #include <Math/Math.h>
+#include <Math/Constants.h>
 #include <Geometry/Vector.h>
 #include <Geometry/Point.h>
 #include <GLMotif/StyleSheet.h>
@@ -36,11 +39,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GLMotif/TextField.h>
 #include <GLMotif/Slider.h>
 
+#include <Abstract/VariableManager.h>
 #include <Templatized/StreamsurfaceExtractor.h>
 #include <Wrappers/VectorExtractor.h>
 #include <Wrappers/ScalarExtractor.h>
-#include <Wrappers/Streamsurface.h>
+#include <Wrappers/ElementSizeLimit.h>
 #include <Wrappers/AlarmTimerElement.h>
+#include <Wrappers/ParametersIOHelper.h>
 
 #include <Wrappers/StreamsurfaceExtractor.h>
 
@@ -48,106 +53,319 @@ namespace Visualization {
 
 namespace Wrappers {
 
-/***************************************
-Methods of class StreamsurfaceExtractor:
-***************************************/
+/***************************************************
+Methods of class StreamsurfaceExtractor::Parameters:
+***************************************************/
 
 template <class DataSetWrapperParam>
+template <class DataSourceParam>
 inline
-const typename StreamsurfaceExtractor<DataSetWrapperParam>::DS*
-StreamsurfaceExtractor<DataSetWrapperParam>::getDs(
-	const Visualization::Abstract::DataSet* sDataSet)
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::readBinary(
+	DataSourceParam& dataSource,
+	bool raw,
+	const Visualization::Abstract::VariableManager* variableManager)
 	{
-	/* Get a pointer to the data set wrapper: */
-	const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(sDataSet);
-	if(myDataSet==0)
-		Misc::throwStdErr("StreamsurfaceExtractor::StreamsurfaceExtractor: Mismatching data set type");
+	/* Read all elements: */
+	if(raw)
+		vectorVariableIndex=dataSource.template read<int>();
+	else
+		vectorVariableIndex=readVectorVariableNameBinary<DataSourceParam>(dataSource,variableManager);
+	if(raw)
+		colorScalarVariableIndex=dataSource.template read<int>();
+	else
+		colorScalarVariableIndex=readScalarVariableNameBinary<DataSourceParam>(dataSource,variableManager);
+	maxNumTriangles=dataSource.template read<unsigned int>();
+	stepSize=dataSource.template read<Scalar>();
+	numStreamlines=dataSource.template read<unsigned int>();
+	maxNumFrontStreamlines=dataSource.template read<unsigned int>();
+	diskRadius=dataSource.template read<Scalar>();
+	dataSource.template read<Scalar>(base.getComponents(),dimension);
+	for(int i=0;i<2;++i)
+		dataSource.template read<Scalar>(frame[i].getComponents(),dimension);
+	}
+
+template <class DataSetWrapperParam>
+template <class DataSinkParam>
+inline
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::writeBinary(
+	DataSinkParam& dataSink,
+	bool raw,
+	const Visualization::Abstract::VariableManager* variableManager) const
+	{
+	/* Write all elements: */
+	if(raw)
+		dataSink.template write<int>(vectorVariableIndex);
+	else
+		writeVectorVariableNameBinary<DataSinkParam>(dataSink,vectorVariableIndex,variableManager);
+	if(raw)
+		dataSink.template write<int>(colorScalarVariableIndex);
+	else
+		writeScalarVariableNameBinary<DataSinkParam>(dataSink,colorScalarVariableIndex,variableManager);
+	dataSink.template write<unsigned int>(maxNumTriangles);
+	dataSink.template write<Scalar>(stepSize);
+	dataSink.template write<unsigned int>(numStreamlines);
+	dataSink.template write<unsigned int>(maxNumFrontStreamlines);
+	dataSink.template write<Scalar>(diskRadius);
+	dataSink.template write<Scalar>(base.getComponents(),dimension);
+	for(int i=0;i<2;++i)
+		dataSink.template write<Scalar>(frame[i].getComponents(),dimension);
+	}
+
+template <class DataSetWrapperParam>
+inline
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::Parameters(
+	Visualization::Abstract::VariableManager* variableManager)
+	:vectorVariableIndex(variableManager->getCurrentVectorVariable()),
+	 colorScalarVariableIndex(variableManager->getCurrentScalarVariable()),
+	 locatorValid(false)
+	{
+	update(variableManager,false);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::read(
+	Misc::File& file,
+	bool ascii,
+	Visualization::Abstract::VariableManager* variableManager)
+	{
+	if(ascii)
+		{
+		/* Parse the parameter section: */
+		AsciiParameterFileSectionHash* hash=parseAsciiParameterFileSection<Misc::File>(file);
+		
+		/* Extract the parameters: */
+		vectorVariableIndex=readVectorVariableNameAscii(hash,"vectorVariable",variableManager);
+		colorScalarVariableIndex=readScalarVariableNameAscii(hash,"colorScalarVariable",variableManager);
+		maxNumTriangles=readParameterAscii<unsigned int>(hash,"maxNumTriangles",maxNumTriangles);
+		stepSize=readParameterAscii<Scalar>(hash,"stepSize",stepSize);
+		numStreamlines=readParameterAscii<unsigned int>(hash,"numStreamlines",numStreamlines);
+		maxNumFrontStreamlines=readParameterAscii<unsigned int>(hash,"maxNumFrontStreamlines",maxNumFrontStreamlines);
+		diskRadius=readParameterAscii<Scalar>(hash,"diskRadius",diskRadius);
+		base=readParameterAscii<Point>(hash,"base",base);
+		readParameterAscii<Vector>(hash,"frame",frame,2);
+		
+		/* Clean up: */
+		deleteAsciiParameterFileSectionHash(hash);
+		}
+	else
+		{
+		/* Read from binary file: */
+		readBinary(file,false,variableManager);
+		}
 	
-	return &myDataSet->getDs();
+	/* Update derived parameters: */
+	update(variableManager,true);
 	}
 
 template <class DataSetWrapperParam>
 inline
-const typename StreamsurfaceExtractor<DataSetWrapperParam>::VE&
-StreamsurfaceExtractor<DataSetWrapperParam>::getVe(
-	const Visualization::Abstract::VectorExtractor* sVectorExtractor)
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::read(
+	Comm::MulticastPipe& pipe,
+	Visualization::Abstract::VariableManager* variableManager)
 	{
-	/* Get a pointer to the vector extractor wrapper: */
-	const VectorExtractor* myVectorExtractor=dynamic_cast<const VectorExtractor*>(sVectorExtractor);
-	if(myVectorExtractor==0)
-		Misc::throwStdErr("StreamsurfaceExtractor::StreamsurfaceExtractor: Mismatching vector extractor type");
+	/* Read from multicast pipe: */
+	readBinary(pipe,true,variableManager);
 	
-	return myVectorExtractor->getVe();
+	/* Update derived parameters: */
+	update(variableManager,true);
 	}
 
 template <class DataSetWrapperParam>
 inline
-const typename StreamsurfaceExtractor<DataSetWrapperParam>::SE&
-StreamsurfaceExtractor<DataSetWrapperParam>::getSe(
-	const Visualization::Abstract::ScalarExtractor* sScalarExtractor)
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::read(
+	Comm::ClusterPipe& pipe,
+	Visualization::Abstract::VariableManager* variableManager)
 	{
-	/* Get a pointer to the scalar extractor wrapper: */
-	const ScalarExtractor* myScalarExtractor=dynamic_cast<const ScalarExtractor*>(sScalarExtractor);
-	if(myScalarExtractor==0)
-		Misc::throwStdErr("StreamsurfaceExtractor::StreamsurfaceExtractor: Mismatching scalar extractor type");
+	/* Read (and ignore) the parameter packet size from the cluster pipe: */
+	pipe.read<unsigned int>();
+	
+	/* Read from cluster pipe: */
+	readBinary(pipe,false,variableManager);
 	
-	return myScalarExtractor->getSe();
+	/* Update derived parameters: */
+	update(variableManager,true);
 	}
 
 template <class DataSetWrapperParam>
 inline
-StreamsurfaceExtractor<DataSetWrapperParam>::StreamsurfaceExtractor(
-	const GLColorMap* sColorMap,
-	const Visualization::Abstract::DataSet* sDataSet,
-	const Visualization::Abstract::VectorExtractor* sVectorExtractor,
-	const Visualization::Abstract::ScalarExtractor* sScalarExtractor,
-	Visualization::Abstract::DataSet::Scalar sDiskRadius)
-	:colorMap(sColorMap),
-	 sse(getDs(sDataSet),getVe(sVectorExtractor),getSe(sScalarExtractor)),
-	 diskRadius(sDiskRadius),
-	 maxNumVertices(100000),
-	 currentStreamsurface(0),
-	 numStreamlinesValue(0),numStreamlinesSlider(0),
-	 diskRadiusValue(0),diskRadiusSlider(0),
-	 stepSizeValue(0),stepSizeSlider(0),
-	 maxNumVerticesValue(0),maxNumVerticesSlider(0)
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::write(
+	Misc::File& file,
+	bool ascii,
+	const Visualization::Abstract::VariableManager* variableManager) const
 	{
-	sse.setNumStreamlines(16);
-	sse.setClosed(true);
+	if(ascii)
+		{
+		/* Write to ASCII file: */
+		file.write("{\n",2);
+		writeVectorVariableNameAscii<Misc::File>(file,"vectorVariable",vectorVariableIndex,variableManager);
+		writeScalarVariableNameAscii<Misc::File>(file,"colorScalarVariable",colorScalarVariableIndex,variableManager);
+		writeParameterAscii<Misc::File,unsigned int>(file,"maxNumTriangles",maxNumTriangles);
+		writeParameterAscii<Misc::File,Scalar>(file,"stepSize",stepSize);
+		writeParameterAscii<Misc::File,unsigned int>(file,"numStreamlines",numStreamlines);
+		writeParameterAscii<Misc::File,unsigned int>(file,"maxNumFrontStreamlines",maxNumFrontStreamlines);
+		writeParameterAscii<Misc::File,Scalar>(file,"diskRadius",diskRadius);
+		writeParameterAscii<Misc::File,Point>(file,"base",base);
+		writeParameterAscii<Misc::File,Vector>(file,"frame",frame,2);
+		file.write("}\n",2);
+		}
+	else
+		{
+		/* Write to binary file: */
+		writeBinary(file,false,variableManager);
+		}
 	}
 
 template <class DataSetWrapperParam>
 inline
-StreamsurfaceExtractor<DataSetWrapperParam>::~StreamsurfaceExtractor(
-	void)
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::write(
+	Comm::MulticastPipe& pipe,
+	const Visualization::Abstract::VariableManager* variableManager) const
 	{
+	/* Write to multicast pipe: */
+	writeBinary(pipe,true,variableManager);
 	}
 
 template <class DataSetWrapperParam>
 inline
 void
-StreamsurfaceExtractor<DataSetWrapperParam>::setMaxNumVertices(
-	size_t newMaxNumVertices)
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::write(
+	Comm::ClusterPipe& pipe,
+	const Visualization::Abstract::VariableManager* variableManager) const
 	{
-	maxNumVertices=newMaxNumVertices;
+	/* Calculate the byte size of the marshalled parameter packet: */
+	size_t packetSize=0;
+	packetSize+=getVectorVariableNameLength(vectorVariableIndex,variableManager);
+	packetSize+=getScalarVariableNameLength(colorScalarVariableIndex,variableManager);
+	packetSize+=sizeof(unsigned int)+sizeof(Scalar)+sizeof(unsigned int)+sizeof(unsigned int)+sizeof(Scalar);
+	packetSize+=sizeof(Scalar)*dimension+2*sizeof(Scalar)*dimension;
+	
+	/* Write the packet size to the cluster pipe: */
+	pipe.write<unsigned int>(packetSize);
+	
+	/* Write to cluster pipe: */
+	writeBinary(pipe,false,variableManager);
 	}
 
 template <class DataSetWrapperParam>
 inline
-bool
-StreamsurfaceExtractor<DataSetWrapperParam>::hasSeededCreator(
-	void) const
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::Parameters::update(
+	Visualization::Abstract::VariableManager* variableManager,
+	bool track)
 	{
-	return true;
+	/* Get the abstract data set pointer: */
+	const Visualization::Abstract::DataSet* ds1=variableManager->getDataSetByVectorVariable(vectorVariableIndex);
+	const Visualization::Abstract::DataSet* ds2=variableManager->getDataSetByScalarVariable(colorScalarVariableIndex);
+	if(ds1!=ds2)
+		Misc::throwStdErr("StreamsurfaceExtractor::Parameters::update: Incompatible vector and scalar variables");
+	
+	/* Get a pointer to the data set wrapper: */
+	const DataSetWrapper* myDataSet=dynamic_cast<const DataSetWrapper*>(ds1);
+	if(myDataSet==0)
+		Misc::throwStdErr("StreamsurfaceExtractor::Parameters::update: Mismatching data set type");
+	ds=&myDataSet->getDs();
+	
+	/* Get a pointer to the vector extractor wrapper: */
+	const VectorExtractor* myVectorExtractor=dynamic_cast<const VectorExtractor*>(variableManager->getVectorExtractor(vectorVariableIndex));
+	if(myVectorExtractor==0)
+		Misc::throwStdErr("StreamsurfaceExtractor::Parameters::update: Mismatching vector extractor type");
+	ve=&myVectorExtractor->getVe();
+	
+	/* Get a pointer to the color scalar extractor wrapper: */
+	const ScalarExtractor* myScalarExtractor=dynamic_cast<const ScalarExtractor*>(variableManager->getScalarExtractor(colorScalarVariableIndex));
+	if(myScalarExtractor==0)
+		Misc::throwStdErr("StreamsurfaceExtractor::Parameters::update: Mismatching scalar extractor type");
+	cse=&myScalarExtractor->getSe();
+	
+	/* Get a templatized locator: */
+	dsl=ds->getLocator();
+	if(track)
+		{
+		/* Locate the base point: */
+		locatorValid=dsl.locatePoint(base);
+		}
 	}
 
+/***********************************************
+Static elements of class StreamsurfaceExtractor:
+***********************************************/
+
+template <class DataSetWrapperParam>
+const char* StreamsurfaceExtractor<DataSetWrapperParam>::name="Stream Surface";
+
+/***************************************
+Methods of class StreamsurfaceExtractor:
+***************************************/
+
 template <class DataSetWrapperParam>
 inline
-bool
-StreamsurfaceExtractor<DataSetWrapperParam>::hasIncrementalCreator(
-	void) const
+typename StreamsurfaceExtractor<DataSetWrapperParam>::Streamsurface*
+StreamsurfaceExtractor<DataSetWrapperParam>::startStreamsurface(
+	typename StreamsurfaceExtractor<DataSetWrapperParam>::Parameters* myParameters)
+	{
+	/* Create a new stream surface visualization element: */
+	Streamsurface* result=new Streamsurface(myParameters,getVariableManager()->getColorMap(myParameters->colorScalarVariableIndex),getPipe());
+	
+	/* Update the stream surface extractor: */
+	sse.update(myParameters->ds,*myParameters->ve,*myParameters->cse);
+	result->getSurface().setStreamCompression(sse.getDataSet()->getDomainBox(),getElementStreamPositionBits(),getElementStreamNormalBits());
+	sse.setStepSize(typename SSE::Scalar(myParameters->stepSize));
+	sse.setNumStreamlines(myParameters->numStreamlines);
+	sse.setMaxNumFrontStreamlines(myParameters->maxNumFrontStreamlines);
+	sse.setClosed(true);
+	
+	/* Calculate all seed streamlines' starting points on the seed circle: */
+	for(unsigned int i=0;i<myParameters->numStreamlines;++i)
+		{
+		Scalar angle=Scalar(2)*Math::Constants<Scalar>::pi*Scalar(i)/Scalar(myParameters->numStreamlines);
+		Point p=myParameters->base;
+		p+=myParameters->frame[0]*(Math::cos(angle)*myParameters->diskRadius);
+		p+=myParameters->frame[1]*(Math::sin(angle)*myParameters->diskRadius);
+		sse.initializeStreamline(i,p,myParameters->dsl);
+		}
+	
+	/* Start extracting the stream surface into the visualization element: */
+	sse.startStreamsurface(result->getSurface());
+	
+	return result;
+	}
+
+template <class DataSetWrapperParam>
+inline
+StreamsurfaceExtractor<DataSetWrapperParam>::StreamsurfaceExtractor(
+	Visualization::Abstract::VariableManager* sVariableManager,
+	Comm::MulticastPipe* sPipe)
+	:Abstract::Algorithm(sVariableManager,sPipe),
+	 parameters(sVariableManager),
+	 sse(parameters.ds,*parameters.ve,*parameters.cse),
+	 currentStreamsurface(0),
+	 maxNumTrianglesValue(0),maxNumTrianglesSlider(0),
+	 stepSizeValue(0),stepSizeSlider(0),
+	 numStreamlinesValue(0),numStreamlinesSlider(0),
+	 maxNumFrontStreamlinesValue(0),maxNumFrontStreamlinesSlider(0),
+	 diskRadiusValue(0),diskRadiusSlider(0)
+	{
+	/* Initialize parameters: */
+	parameters.maxNumTriangles=100000;
+	parameters.stepSize=Scalar(sse.getStepSize());
+	parameters.numStreamlines=16;
+	parameters.maxNumFrontStreamlines=sse.getMaxNumFrontStreamlines();
+	parameters.diskRadius=parameters.ds->calcAverageCellSize();
+	}
+
+template <class DataSetWrapperParam>
+inline
+StreamsurfaceExtractor<DataSetWrapperParam>::~StreamsurfaceExtractor(
+	void)
 	{
-	return true;
 	}
 
 template <class DataSetWrapperParam>
@@ -160,54 +378,65 @@ StreamsurfaceExtractor<DataSetWrapperParam>::createSettingsDialog(
 	const GLMotif::StyleSheet* ss=widgetManager->getStyleSheet();
 	
 	/* Create the settings dialog window: */
-	GLMotif::PopupWindow* settingsDialogPopup=new GLMotif::PopupWindow("StreamlineExtractorSettingsDialogPopup",widgetManager,"Stream Surface Extractor Settings");
+	GLMotif::PopupWindow* settingsDialogPopup=new GLMotif::PopupWindow("StreamsurfaceExtractorSettingsDialogPopup",widgetManager,"Stream Surface Extractor Settings");
+	settingsDialogPopup->setResizableFlags(true,false);
 	
 	GLMotif::RowColumn* settingsDialog=new GLMotif::RowColumn("settingsDialog",settingsDialogPopup,false);
 	settingsDialog->setNumMinorWidgets(3);
 	
-	GLMotif::Label* numStreamlinesLabel=new GLMotif::Label("NumStreamlinesLabel",settingsDialog,"Number Of Streamlines");
+	new GLMotif::Label("MaxNumTrianglesLabel",settingsDialog,"Maximum Number of Triangles");
+	
+	maxNumTrianglesValue=new GLMotif::TextField("MaxNumTrianglesValue",settingsDialog,12);
+	maxNumTrianglesValue->setValue((unsigned int)(parameters.maxNumTriangles));
+	
+	maxNumTrianglesSlider=new GLMotif::Slider("MaxNumTrianglesSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
+	maxNumTrianglesSlider->setValueRange(3.0,7.0,0.1);
+	maxNumTrianglesSlider->setValue(Math::log10(double(parameters.maxNumTriangles)));
+	maxNumTrianglesSlider->getValueChangedCallbacks().add(this,&StreamsurfaceExtractor::maxNumTrianglesSliderCallback);
+	
+	new GLMotif::Label("StepSizeLabel",settingsDialog,"Step Size");
+	
+	stepSizeValue=new GLMotif::TextField("StepSizeValue",settingsDialog,12);
+	stepSizeValue->setPrecision(6);
+	stepSizeValue->setValue(double(parameters.stepSize));
+	
+	stepSizeSlider=new GLMotif::Slider("StepSizeSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
+	stepSizeSlider->setValueRange(-4.0,4.0,0.1);
+	stepSizeSlider->setValue(Math::log10(double(parameters.stepSize)));
+	stepSizeSlider->getValueChangedCallbacks().add(this,&StreamsurfaceExtractor::stepSizeSliderCallback);
+	
+	new GLMotif::Label("NumStreamlinesLabel",settingsDialog,"Number Of Seed Streamlines");
 	
 	numStreamlinesValue=new GLMotif::TextField("NumStreamlinesValue",settingsDialog,2);
-	numStreamlinesValue->setValue(sse.getNumStreamlines());
+	numStreamlinesValue->setValue(parameters.numStreamlines);
 	
 	numStreamlinesSlider=new GLMotif::Slider("NumStreamlinesSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
 	numStreamlinesSlider->setValueRange(3.0,32.0,1.0);
-	numStreamlinesSlider->setValue(double(sse.getNumStreamlines()));
+	numStreamlinesSlider->setValue(double(parameters.numStreamlines));
 	numStreamlinesSlider->getValueChangedCallbacks().add(this,&StreamsurfaceExtractor::numStreamlinesSliderCallback);
 	
-	GLMotif::Label* diskRadiusLabel=new GLMotif::Label("DiskRadiusLabel",settingsDialog,"Seed Disk Radius");
+	new GLMotif::Label("MaxNumFrontStreamlinesLabel",settingsDialog,"Maximum Number Of Streamlines");
+	
+	maxNumFrontStreamlinesValue=new GLMotif::TextField("MaxNumFrontStreamlinesValue",settingsDialog,6);
+	maxNumFrontStreamlinesValue->setValue(parameters.maxNumFrontStreamlines);
+	
+	maxNumFrontStreamlinesSlider=new GLMotif::Slider("MaxNumFrontStreamlinesSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
+	maxNumFrontStreamlinesSlider->setValueRange(1.0,4.0,0.1);
+	maxNumFrontStreamlinesSlider->setValue(Math::log10(double(parameters.maxNumFrontStreamlines)));
+	maxNumFrontStreamlinesSlider->getValueChangedCallbacks().add(this,&StreamsurfaceExtractor::maxNumFrontStreamlinesSliderCallback);
+	
+	new GLMotif::Label("DiskRadiusLabel",settingsDialog,"Seed Circle Radius");
 	
 	diskRadiusValue=new GLMotif::TextField("DiskRadiusValue",settingsDialog,12);
 	diskRadiusValue->setPrecision(6);
-	diskRadiusValue->setValue(double(diskRadius));
+	diskRadiusValue->setValue(double(parameters.diskRadius));
 	
 	diskRadiusSlider=new GLMotif::Slider("DiskRadiusSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
-	double drl=Math::log10(double(diskRadius));
+	double drl=Math::log10(double(parameters.diskRadius));
 	diskRadiusSlider->setValueRange(drl-4.0,drl+4.0,0.1);
 	diskRadiusSlider->setValue(drl);
 	diskRadiusSlider->getValueChangedCallbacks().add(this,&StreamsurfaceExtractor::diskRadiusSliderCallback);
 	
-	GLMotif::Label* stepSizeLabel=new GLMotif::Label("StepSizeLabel",settingsDialog,"Step Size");
-	
-	stepSizeValue=new GLMotif::TextField("StepSizeValue",settingsDialog,12);
-	stepSizeValue->setPrecision(6);
-	stepSizeValue->setValue(double(sse.getStepSize()));
-	
-	stepSizeSlider=new GLMotif::Slider("StepSizeSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
-	stepSizeSlider->setValueRange(-4.0,4.0,0.1);
-	stepSizeSlider->setValue(Math::log10(double(sse.getStepSize())));
-	stepSizeSlider->getValueChangedCallbacks().add(this,&StreamsurfaceExtractor::stepSizeSliderCallback);
-	
-	GLMotif::Label* maxNumVerticesLabel=new GLMotif::Label("MaxNumVerticesLabel",settingsDialog,"Maximum Number of Steps");
-	
-	maxNumVerticesValue=new GLMotif::TextField("MaxNumVerticesValue",settingsDialog,12);
-	maxNumVerticesValue->setValue((unsigned int)(maxNumVertices));
-	
-	maxNumVerticesSlider=new GLMotif::Slider("MaxNumVerticesSlider",settingsDialog,GLMotif::Slider::HORIZONTAL,ss->fontHeight*10.0f);
-	maxNumVerticesSlider->setValueRange(3.0,7.0,0.1);
-	maxNumVerticesSlider->setValue(Math::log10(double(maxNumVertices)));
-	maxNumVerticesSlider->getValueChangedCallbacks().add(this,&StreamsurfaceExtractor::maxNumVerticesSliderCallback);
-	
 	settingsDialog->manageChild();
 	
 	return settingsDialogPopup;
@@ -215,38 +444,44 @@ StreamsurfaceExtractor<DataSetWrapperParam>::createSettingsDialog(
 
 template <class DataSetWrapperParam>
 inline
-Visualization::Abstract::Element*
-StreamsurfaceExtractor<DataSetWrapperParam>::createElement(
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::setSeedLocator(
 	const Visualization::Abstract::DataSet::Locator* seedLocator)
 	{
 	/* Get a pointer to the locator wrapper: */
 	const Locator* myLocator=dynamic_cast<const Locator*>(seedLocator);
 	if(myLocator==0)
-		Misc::throwStdErr("StreamsurfaceExtractor::createElement: Mismatching locator type");
-	DSL dsl=myLocator->getDsl();
-	
-	/* Create a new stream surface visualization element: */
-	Streamsurface* result=new Streamsurface(colorMap);
-	
-	/* Create the seed disk: */
-	DSPoint seedPoint=seedLocator->getPosition();
-	dsl.locatePoint(seedPoint);
-	DSVector seedVector=dsl.calcValue(sse.getVectorExtractor());
-	DSVector x=Geometry::normal(seedVector);
-	x.normalize();
-	DSVector y=Geometry::cross(seedVector,x);
-	y.normalize();
-	for(int i=0;i<sse.getNumStreamlines();++i)
-		{
-		DSScalar angle=DSScalar(2)*Math::Constants<DSScalar>::pi*DSScalar(i)/DSScalar(sse.getNumStreamlines());
-		DSPoint p=seedPoint;
-		p+=x*(Math::cos(angle)*diskRadius);
-		p+=y*(Math::sin(angle)*diskRadius);
-		sse.initializeStreamline(i,p,dsl);
-		}
-	
-	/* Extract the streamline into the visualization element: */
-	sse.extractStreamsurface(result->getSurface());
+		Misc::throwStdErr("StreamsurfaceExtractor::setSeedLocator: Mismatching locator type");
+	
+	/* Copy the locator: */
+	parameters.dsl=myLocator->getDsl();
+	parameters.locatorValid=myLocator->isValid();
+	
+	/* Calculate the seeding point and seed circle frame: */
+	parameters.base=Point(seedLocator->getPosition());
+	Vector seedVector=parameters.dsl.calcValue(*parameters.ve);
+	parameters.frame[0]=Geometry::normal(seedVector);
+	parameters.frame[0].normalize();
+	parameters.frame[1]=Geometry::cross(seedVector,parameters.frame[0]);
+	parameters.frame[1].normalize();
+	}
+
+template <class DataSetWrapperParam>
+inline
+Visualization::Abstract::Element*
+StreamsurfaceExtractor<DataSetWrapperParam>::createElement(
+	Visualization::Abstract::Parameters* extractParameters)
+	{
+	/* Get proper pointer to parameter object: */
+	Parameters* myParameters=dynamic_cast<Parameters*>(extractParameters);
+	if(myParameters==0)
+		Misc::throwStdErr("StreamsurfaceExtractor::createElement: Mismatching parameter object type");
+	
+	/* Extract the stream surface into a new visualization element: */
+	Streamsurface* result=startStreamsurface(myParameters);
+	ElementSizeLimit<Streamsurface> esl(*result,myParameters->maxNumTriangles);
+	sse.continueStreamsurface(esl);
+	sse.finishStreamsurface();
 	
 	/* Return the result: */
 	return result;
@@ -256,36 +491,15 @@ template <class DataSetWrapperParam>
 inline
 Visualization::Abstract::Element*
 StreamsurfaceExtractor<DataSetWrapperParam>::startElement(
-	const Visualization::Abstract::DataSet::Locator* seedLocator)
+	Visualization::Abstract::Parameters* extractParameters)
 	{
-	/* Get a pointer to the locator wrapper: */
-	const Locator* myLocator=dynamic_cast<const Locator*>(seedLocator);
-	if(myLocator==0)
-		Misc::throwStdErr("StreamsurfaceExtractor::createElement: Mismatching locator type");
-	DSL dsl=myLocator->getDsl();
-	
-	/* Create a new streamline visualization element: */
-	currentStreamsurface=new Streamsurface(colorMap);
-	
-	/* Create the seed disk: */
-	DSPoint seedPoint=seedLocator->getPosition();
-	dsl.locatePoint(seedPoint);
-	DSVector seedVector=dsl.calcValue(sse.getVectorExtractor());
-	DSVector x=Geometry::normal(seedVector);
-	x.normalize();
-	DSVector y=Geometry::cross(seedVector,x);
-	y.normalize();
-	for(int i=0;i<sse.getNumStreamlines();++i)
-		{
-		DSScalar angle=DSScalar(2)*Math::Constants<DSScalar>::pi*DSScalar(i)/DSScalar(sse.getNumStreamlines());
-		DSPoint p=seedPoint;
-		p+=x*(Math::cos(angle)*diskRadius);
-		p+=y*(Math::sin(angle)*diskRadius);
-		sse.initializeStreamline(i,p,dsl);
-		}
+	/* Get proper pointer to parameter object: */
+	Parameters* myParameters=dynamic_cast<Parameters*>(extractParameters);
+	if(myParameters==0)
+		Misc::throwStdErr("StreamsurfaceExtractor::startElement: Mismatching parameter object type");
 	
-	/* Start extracting the streamline into the visualization element: */
-	sse.startStreamsurface(currentStreamsurface->getSurface());
+	/* Start extracting the stream surface into a new visualization element: */
+	currentStreamsurface=startStreamsurface(myParameters);
 	
 	/* Return the result: */
 	return currentStreamsurface.getPointer();
@@ -297,9 +511,10 @@ bool
 StreamsurfaceExtractor<DataSetWrapperParam>::continueElement(
 	const Realtime::AlarmTimer& alarm)
 	{
-	/* Continue extracting the streamline into the visualization element: */
-	AlarmTimerElement<Streamsurface> atcf(alarm,*currentStreamsurface,maxNumVertices);
-	return sse.continueStreamsurface(atcf)||currentStreamsurface->getElementSize()>=maxNumVertices;
+	/* Continue extracting the stream surface into the visualization element: */
+	size_t maxNumTriangles=dynamic_cast<Parameters*>(currentStreamsurface->getParameters())->maxNumTriangles;
+	AlarmTimerElement<Streamsurface> atcf(alarm,*currentStreamsurface,maxNumTriangles);
+	return sse.continueStreamsurface(atcf)||currentStreamsurface->getElementSize()>=maxNumTriangles;
 	}
 
 template <class DataSetWrapperParam>
@@ -314,31 +529,47 @@ StreamsurfaceExtractor<DataSetWrapperParam>::finishElement(
 
 template <class DataSetWrapperParam>
 inline
-void
-StreamsurfaceExtractor<DataSetWrapperParam>::numStreamlinesSliderCallback(
-	GLMotif::Slider::ValueChangedCallbackData* cbData)
+Visualization::Abstract::Element*
+StreamsurfaceExtractor<DataSetWrapperParam>::startSlaveElement(
+	Visualization::Abstract::Parameters* extractParameters)
 	{
-	/* Get the new slider value and convert to number of streamlines: */
-	int numStreamlines=int(Math::floor(double(cbData->value)+0.5));
+	if(isMaster())
+		Misc::throwStdErr("StreamsurfaceExtractor::startSlaveElement: Cannot be called on master node");
 	
-	/* Update the streamline extractor's number of streamlines: */
-	sse.setNumStreamlines(numStreamlines);
+	/* Get proper pointer to parameter object: */
+	Parameters* myParameters=dynamic_cast<Parameters*>(extractParameters);
+	if(myParameters==0)
+		Misc::throwStdErr("StreamsurfaceExtractor::startSlaveElement: Mismatching parameter object type");
 	
-	/* Update the text field: */
-	numStreamlinesValue->setValue(numStreamlines);
+	/* Create a new stream surface visualization element: */
+	currentStreamsurface=new Streamsurface(myParameters,getVariableManager()->getColorMap(myParameters->colorScalarVariableIndex),getPipe());
+	
+	return currentStreamsurface.getPointer();
 	}
 
 template <class DataSetWrapperParam>
 inline
 void
-StreamsurfaceExtractor<DataSetWrapperParam>::diskRadiusSliderCallback(
+StreamsurfaceExtractor<DataSetWrapperParam>::continueSlaveElement(
+	void)
+	{
+	if(isMaster())
+		Misc::throwStdErr("StreamsurfaceExtractor::continueSlaveElement: Cannot be called on master node");
+	
+	currentStreamsurface->getSurface().receive();
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::maxNumTrianglesSliderCallback(
 	GLMotif::Slider::ValueChangedCallbackData* cbData)
 	{
-	/* Get the new slider value and convert to disk radius: */
-	diskRadius=DSScalar(Math::pow(10.0,double(cbData->value)));
+	/* Get the new slider value and convert to maximum number of triangles: */
+	parameters.maxNumTriangles=size_t(Math::floor(Math::pow(10.0,double(cbData->value))+0.5));
 	
 	/* Update the text field: */
-	diskRadiusValue->setValue(double(diskRadius));
+	maxNumTrianglesValue->setValue((unsigned int)(parameters.maxNumTriangles));
 	}
 
 template <class DataSetWrapperParam>
@@ -348,26 +579,49 @@ StreamsurfaceExtractor<DataSetWrapperParam>::stepSizeSliderCallback(
 	GLMotif::Slider::ValueChangedCallbackData* cbData)
 	{
 	/* Get the new slider value and convert to step size: */
-	double stepSize=Math::pow(10.0,double(cbData->value));
+	parameters.stepSize=Scalar(Math::pow(10.0,double(cbData->value)));
 	
-	/* Update the streamline extractor's step size: */
-	sse.setStepSize(typename SSE::Scalar(stepSize));
+	/* Update the text field: */
+	stepSizeValue->setValue(double(parameters.stepSize));
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::numStreamlinesSliderCallback(
+	GLMotif::Slider::ValueChangedCallbackData* cbData)
+	{
+	/* Get the new slider value and convert to number of seed streamlines: */
+	parameters.numStreamlines=(unsigned int)(Math::floor(double(cbData->value)+0.5));
 	
 	/* Update the text field: */
-	stepSizeValue->setValue(stepSize);
+	numStreamlinesValue->setValue(parameters.numStreamlines);
 	}
 
 template <class DataSetWrapperParam>
 inline
 void
-StreamsurfaceExtractor<DataSetWrapperParam>::maxNumVerticesSliderCallback(
+StreamsurfaceExtractor<DataSetWrapperParam>::maxNumFrontStreamlinesSliderCallback(
+	GLMotif::Slider::ValueChangedCallbackData* cbData)
+	{
+	/* Get the new slider value and convert to maximum number of front streamlines: */
+	parameters.maxNumFrontStreamlines=(unsigned int)(Math::floor(Math::pow(10.0,double(cbData->value))+0.5));
+	
+	/* Update the text field: */
+	maxNumFrontStreamlinesValue->setValue(parameters.maxNumFrontStreamlines);
+	}
+
+template <class DataSetWrapperParam>
+inline
+void
+StreamsurfaceExtractor<DataSetWrapperParam>::diskRadiusSliderCallback(
 	GLMotif::Slider::ValueChangedCallbackData* cbData)
 	{
-	/* Get the new slider value and convert to maximum number of vertices: */
-	maxNumVertices=size_t(Math::floor(Math::pow(10.0,double(cbData->value))+0.5));
+	/* Get the new slider value and convert to seed circle radius: */
+	parameters.diskRadius=Scalar(Math::pow(10.0,double(cbData->value)));
 	
 	/* Update the text field: */
-	maxNumVerticesValue->setValue((unsigned int)(maxNumVertices));
+	diskRadiusValue->setValue(double(parameters.diskRadius));
 	}
 
 }
@@ -2,7 +2,7 @@
 StreamsurfaceExtractor - Wrapper class to map from the abstract
 visualization algorithm interface to a templatized stream surface
 extractor implementation.
-Copyright (c) 2006-2007 Oliver Kreylos
+Copyright (c) 2006-2009 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -28,10 +28,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GLMotif/Slider.h>
 
 #include <Abstract/DataSet.h>
+#include <Abstract/Parameters.h>
 #include <Abstract/Algorithm.h>
 
+#include <Wrappers/Streamsurface.h>
+
 /* Forward declarations: */
-class GLColorMap;
 namespace GLMotif {
 class TextField;
 }
@@ -54,8 +56,6 @@ template <class VEParam>
 class VectorExtractor;
 template <class SEParam>
 class ScalarExtractor;
-template <class DataSetWrapperParam>
-class Streamsurface;
 }
 }
 
@@ -71,9 +71,10 @@ class StreamsurfaceExtractor:public Visualization::Abstract::Algorithm
 	typedef Visualization::Abstract::Algorithm Base; // Base class
 	typedef DataSetWrapperParam DataSetWrapper; // Compatible data set type
 	typedef typename DataSetWrapper::DS DS; // Type of templatized data set
-	typedef typename DS::Scalar DSScalar; // Scalar type of templatized data set's domain
-	typedef typename DS::Point DSPoint; // Point type of templatized data set's domain
-	typedef typename DS::Vector DSVector; // Vector type of templatized data set's domain
+	typedef typename DS::Scalar Scalar; // Scalar type of templatized data set's domain
+	static const int dimension=DS::dimension; // Dimension of data set's domain
+	typedef typename DS::Point Point; // Point type of templatized data set's domain
+	typedef typename DS::Vector Vector; // Vector type of templatized data set's domain
 	typedef typename DS::Value DSValue; // Value type of templatized data set
 	typedef typename DataSetWrapper::DSL DSL; // Type of templatized locator
 	typedef typename DataSetWrapper::Locator Locator; // Type of locator wrapper
@@ -81,72 +82,139 @@ class StreamsurfaceExtractor:public Visualization::Abstract::Algorithm
 	typedef typename DataSetWrapper::VectorExtractor VectorExtractor; // Compatible vector extractor wrapper class
 	typedef typename DataSetWrapper::SE SE; // Type of templatized scalar extractor
 	typedef typename DataSetWrapper::ScalarExtractor ScalarExtractor; // Compatible scalar extractor wrapper class
-	typedef Streamsurface<DataSetWrapper> Streamsurface; // Type of created visualization elements
+	typedef Visualization::Wrappers::Streamsurface<DataSetWrapper> Streamsurface; // Type of created visualization elements
 	typedef Misc::Autopointer<Streamsurface> StreamsurfacePointer; // Type for pointers to created visualization elements
 	typedef typename Streamsurface::Surface Surface; // Type of low-level stream surface representation
 	typedef Visualization::Templatized::StreamsurfaceExtractor<DS,VE,SE,Surface> SSE; // Type of templatized stream surface extractor
 	
+	private:
+	class Parameters:public Visualization::Abstract::Parameters // Class to store extraction parameters for stream surfaces
+		{
+		friend class StreamsurfaceExtractor;
+		
+		/* Elements: */
+		private:
+		int vectorVariableIndex; // Index of the vector variable defining the stream surface
+		int colorScalarVariableIndex; // Index of the scalar variable used to color the stream surface
+		size_t maxNumTriangles; // Maximum number of triangles to be extracted
+		Scalar stepSize; // Step size for streamline integration
+		unsigned int numStreamlines; // Number of streamlines seeded along the seed circle
+		unsigned int maxNumFrontStreamlines; // Maximum number of streamlines on the stream surface's front after refinement
+		Scalar diskRadius; // Radius of circle of streamline seed positions around original query position
+		Point base; // The stream surface's original query position
+		Vector frame[2]; // Frame vectors of the stream surface's seed circle
+		const DS* ds; // Data set from which to extract stream surfaces
+		const VE* ve; // Vector extractor for data set
+		const SE* cse; // Color scalar extractor for data set
+		DSL dsl; // Templatized data set locator following the seed point
+		bool locatorValid; // Flag if the locator has been properly initialized, and is inside the data set's domain
+		
+		/* Private methods: */
+		template <class DataSourceParam>
+		void readBinary(DataSourceParam& dataSource,bool raw,const Visualization::Abstract::VariableManager* variableManager); // Reads parameters from a binary data source
+		template <class DataSinkParam>
+		void writeBinary(DataSinkParam& dataSink,bool raw,const Visualization::Abstract::VariableManager* variableManager) const; // Writes parameters to a binary data sink
+		
+		/* Constructors and destructors: */
+		public:
+		Parameters(Visualization::Abstract::VariableManager* variableManager);
+		
+		/* Methods from Abstract::Parameters: */
+		virtual bool isValid(void) const
+			{
+			return locatorValid;
+			}
+		virtual void read(Misc::File& file,bool ascii,Visualization::Abstract::VariableManager* variableManager);
+		virtual void read(Comm::MulticastPipe& pipe,Visualization::Abstract::VariableManager* variableManager);
+		virtual void read(Comm::ClusterPipe& pipe,Visualization::Abstract::VariableManager* variableManager);
+		virtual void write(Misc::File& file,bool ascii,const Visualization::Abstract::VariableManager* variableManager) const;
+		virtual void write(Comm::MulticastPipe& pipe,const Visualization::Abstract::VariableManager* variableManager) const;
+		virtual void write(Comm::ClusterPipe& pipe,const Visualization::Abstract::VariableManager* variableManager) const;
+		virtual Visualization::Abstract::Parameters* clone(void) const
+			{
+			return new Parameters(*this);
+			}
+		virtual void dataSetChanged(Visualization::Abstract::VariableManager* variableManager)
+			{
+			/* Re-locate the seed point in the new data set: */
+			update(variableManager,true);
+			}
+		
+		/* New methods: */
+		void update(Visualization::Abstract::VariableManager* variableManager,bool track); // Updates derived parameters after a read operation
+		};
+	
 	/* Elements: */
 	private:
-	const GLColorMap* colorMap; // Color map for the auxiliary scalar extractor of extracted streamlines
+	static const char* name; // Identifying name of this algorithm
+	Parameters parameters; // The stream surface extraction parameters used by this extractor
 	SSE sse; // The templatized stream surface extractor
-	DSScalar diskRadius; // Radius of disk of streamline seed positions around original query position
-	size_t maxNumVertices; // The maximum number of vertices to be extracted
 	StreamsurfacePointer currentStreamsurface; // The currently extracted stream surface visualization element
 	
 	/* UI components: */
-	GLMotif::TextField* numStreamlinesValue; // Text field to display current number of streamlines
-	GLMotif::Slider* numStreamlinesSlider; // Slider to change current number of streamlines
-	GLMotif::TextField* diskRadiusValue; // Text field to display current seed disk radius
-	GLMotif::Slider* diskRadiusSlider; // Slider to change current seed disk radius
+	GLMotif::TextField* maxNumTrianglesValue; // Text field to display maximum number of extracted triangles
+	GLMotif::Slider* maxNumTrianglesSlider; // Slider to change maximum number of extracted triangles
 	GLMotif::TextField* stepSizeValue; // Text field to display current step size value
 	GLMotif::Slider* stepSizeSlider; // Slider to change current step size value
-	GLMotif::TextField* maxNumVerticesValue; // Text field to display maximum number of extracted vertices
-	GLMotif::Slider* maxNumVerticesSlider; // Slider to change maximum number of extracted vertices
+	GLMotif::TextField* numStreamlinesValue; // Text field to display current number of seed streamlines
+	GLMotif::Slider* numStreamlinesSlider; // Slider to change current number of seed streamlines
+	GLMotif::TextField* maxNumFrontStreamlinesValue; // Text field to display maximum number of front streamlines
+	GLMotif::Slider* maxNumFrontStreamlinesSlider; // Slider to change maximum number of front streamlines
+	GLMotif::TextField* diskRadiusValue; // Text field to display current seed circle radius
+	GLMotif::Slider* diskRadiusSlider; // Slider to change current seed circle radius
 	
 	/* Private methods: */
-	static const DS* getDs(const Visualization::Abstract::DataSet* sDataSet);
-	static const VE& getVe(const Visualization::Abstract::VectorExtractor* sVectorExtractor);
-	static const SE& getSe(const Visualization::Abstract::ScalarExtractor* sScalarExtractor);
+	Streamsurface* startStreamsurface(Parameters* myParameters); // Creates a stream surface visualization element and starts extracting it
 	
 	/* Constructors and destructors: */
 	public:
-	StreamsurfaceExtractor(const GLColorMap* sColorMap,const Visualization::Abstract::DataSet* sDataSet,const Visualization::Abstract::VectorExtractor* sVectorExtractor,const Visualization::Abstract::ScalarExtractor* sScalarExtractor,Visualization::Abstract::DataSet::Scalar sDiskRadius); // Creates a stream surface extractor for the given data set, vector extractor, and auxiliary scalar extractor
+	StreamsurfaceExtractor(Visualization::Abstract::VariableManager* sVariableManager,Comm::MulticastPipe* sPipe); // Creates a stream surface extractor
 	virtual ~StreamsurfaceExtractor(void);
 	
-	/* Methods: */
-	const GLColorMap* getColorMap(void) const // Returns the color map
+	/* Methods from Visualization::Abstract::Algorithm: */
+	virtual const char* getName(void) const
 		{
-		return colorMap;
+		return name;
 		}
-	const SSE& getSse(void) const // Returns the templatized stream surface extractor
+	virtual bool hasSeededCreator(void) const
 		{
-		return sse;
+		return true;
 		}
-	SSE& getSse(void) // Ditto
-		{
-		return sse;
-		}
-	Visualization::Abstract::DataSet::Scalar getDiskRadius(void) const // Returns the radius of the seed disk
+	virtual bool hasIncrementalCreator(void) const
 		{
-		return Visualization::Abstract::DataSet::Scalar(diskRadius);
+		return true;
 		}
-	size_t getMaxNumVertices(void) const // Returns the maximum number of vertices to be extracted
+	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager);
+	virtual Visualization::Abstract::Parameters* cloneParameters(void) const
 		{
-		return maxNumVertices;
+		return new Parameters(parameters);
 		}
-	void setMaxNumVertices(size_t newMaxNumVertices); // Sets the maximum number of vertices to be extracted
-	virtual bool hasSeededCreator(void) const;
-	virtual bool hasIncrementalCreator(void) const;
-	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager);
-	virtual Visualization::Abstract::Element* createElement(const Visualization::Abstract::DataSet::Locator* seedLocator);
-	virtual Visualization::Abstract::Element* startElement(const Visualization::Abstract::DataSet::Locator* seedLocator);
+	virtual void setSeedLocator(const Visualization::Abstract::DataSet::Locator* seedLocator);
+	virtual Visualization::Abstract::Element* createElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual Visualization::Abstract::Element* startElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual bool continueElement(const Realtime::AlarmTimer& alarm);
 	virtual void finishElement(void);
+	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual void continueSlaveElement(void);
+	
+	/* New methods: */
+	static const char* getClassName(void) // Returns the algorithm class name
+		{
+		return name;
+		}
+	const SSE& getSse(void) const // Returns the templatized stream surface extractor
+		{
+		return sse;
+		}
+	SSE& getSse(void) // Ditto
+		{
+		return sse;
+		}
+	void maxNumTrianglesSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
+	void stepSizeSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
 	void numStreamlinesSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
+	void maxNumFrontStreamlinesSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
 	void diskRadiusSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
-	void stepSizeSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
-	void maxNumVerticesSliderCallback(GLMotif::Slider::ValueChangedCallbackData* cbData);
 	};
 
 }
@@ -110,6 +110,7 @@ TripleChannelVolumeRenderer<DataSetWrapperParam>::TripleChannelVolumeRenderer(
 		raycaster->setColorMap(channel,variableManager->getColorMap(svi));
 		raycaster->setTransparencyGamma(channel,myParameters->transparencyGammas[channel]);
 		}
+	raycaster->getMacroCellGrid().setNumThreads(algorithm->getNumThreads());
 	raycaster->updateData();
 	
 	/* Set the raycaster's step size: */
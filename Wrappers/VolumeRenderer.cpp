@@ -44,6 +44,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Wrappers/VolumeRendererExtractor.h>
 
 #ifdef VISUALIZATION_USE_SHADERS
+#include <VoxelBrickStore.h>
 #include <SingleChannelRaycaster.h>
 #else
 #include <PaletteRenderer.h>
@@ -93,18 +94,42 @@ VolumeRenderer<DataSetWrapperParam>::VolumeRenderer(
 	if(myScalarExtractor==0)
 		Misc::throwStdErr("VolumeRenderer: Mismatching scalar extractor type");
 	const SE& se=myScalarExtractor->getSe();
-
-	/* Create a volume rendering sampler: */
-	Visualization::Templatized::VolumeRenderingSampler<DS> sampler(ds);
 	
 	#ifdef VISUALIZATION_USE_SHADERS
 	
-	/* Initialize the raycaster: */
-	renderer=new SingleChannelRaycaster(sampler.getSamplerSize(),ds.getDomainBox());
-	
-	/* Sample the scalar variable: */
-	sampler.sample(se,renderer->getData(),renderer->getDataStrides(),algorithm->getPipe(),100.0f,0.0f,algorithm);
+	if(VoxelBrickStore::getDefaultMemoryBudget()!=0)
+		{
+		/* Create a volume rendering sampler that is not limited by the size of a single in-core voxel block: */
+		Visualization::Templatized::VolumeRenderingSampler<DS> sampler(ds,2048);
+		
+		/* Sample the scalar variable into a brick store that keeps its resident bricks within the memory budget: */
+		VoxelBrickStore* brickStore=new VoxelBrickStore(sampler.getSamplerSize(),64,VoxelBrickStore::getDefaultMemoryBudget());
+		try
+			{
+			sampler.sample(se,*brickStore,algorithm->getPipe(),100.0f,0.0f,algorithm);
+			}
+		catch(...)
+			{
+			delete brickStore;
+			throw;
+			}
+		
+		/* Initialize the raycaster: */
+		renderer=new SingleChannelRaycaster(brickStore,ds.getDomainBox());
+		}
+	else
+		{
+		/* Create a volume rendering sampler: */
+		Visualization::Templatized::VolumeRenderingSampler<DS> sampler(ds);
+		
+		/* Initialize the raycaster: */
+		renderer=new SingleChannelRaycaster(sampler.getSamplerSize(),ds.getDomainBox());
+		
+		/* Sample the scalar variable: */
+		sampler.sample(se,renderer->getData(),renderer->getDataStrides(),algorithm->getPipe(),100.0f,0.0f,algorithm);
+		}
 	
+	renderer->getMacroCellGrid().setNumThreads(algorithm->getNumThreads());
 	renderer->updateData();
 	
 	/* Set the raycaster's parameters: */
@@ -114,6 +139,9 @@ VolumeRenderer<DataSetWrapperParam>::VolumeRenderer(
 	
 	#else
 	
+	/* Create a volume rendering sampler: */
+	Visualization::Templatized::VolumeRenderingSampler<DS> sampler(ds);
+	
 	/* Initialize the slice-based volume renderer: */
 	renderer=new PaletteRenderer;
 	
@@ -11,6 +11,12 @@ uniform sampler3D volumeSampler;
 uniform bool channelEnableds[3];
 uniform sampler1D colorMapSamplers[3];
 
+uniform sampler3D occupancySampler;
+uniform vec3 mcellScale;
+uniform vec3 mcellOffset;
+uniform vec3 mcellTexScale;
+uniform vec3 mcellMax;
+
 varying vec3 mcPosition;
 varying vec3 dcPosition;
 
@@ -38,17 +44,40 @@ void main()
 	/* Convert the ray direction to data coordinates: */
 	vec3 dcDir=mcDir*mcScale;
 	
+	/* Convert the ray direction to macro cell coordinates, avoiding division by zero for axis-aligned rays: */
+	vec3 cellDir=dcDir*mcellScale;
+	cellDir+=vec3(equal(cellDir,vec3(0.0)))*1.0e-10;
+	vec3 cellSide=step(vec3(0.0),cellDir);
+	
 	/* Cast the ray and accumulate opacities and colors: */
 	vec4 accum=vec4(0.0,0.0,0.0,0.0);
 	
 	/* Move the ray starting position forward to an integer multiple of the step size: */
-	vec3 samplePos=dcPosition;
 	float lambda=ceil(eyeDist)-eyeDist;
 	if(lambda<lambdaMax)
 		{
-		samplePos+=dcDir*lambda;
+		/* Limit the ray to 1500 samples: */
+		float lambdaEnd=min(lambdaMax,lambda+1499.0);
 		for(int i=0;i<1500;++i)
 			{
+			/* Calculate the current sample position: */
+			vec3 samplePos=dcPosition+dcDir*lambda;
+			
+			/* Find the macro cell containing the sample position: */
+			vec3 cellPos=samplePos*mcellScale+mcellOffset;
+			vec3 cell=clamp(floor(cellPos),vec3(0.0),mcellMax);
+			if(texture3D(occupancySampler,(cell+vec3(0.5))*mcellTexScale).a==0.0)
+				{
+				if(lambda>=lambdaEnd)
+					break;
+				
+				/* Skip all samples inside the empty macro cell: */
+				vec3 exits=(cell+cellSide-cellPos)/cellDir;
+				float numSkips=floor(max(min(min(exits.x,exits.y),exits.z),0.0))+1.0;
+				lambda+=min(numSkips,ceil(lambdaEnd-lambda));
+				continue;
+				}
+			
 			/* Get the volume data value at the current sample position: */
 			vec3 data=texture3D(volumeSampler,samplePos);
 			
@@ -65,11 +94,10 @@ void main()
 			accum+=vol*(1.0-accum.a);
 			
 			/* Bail out when opacity hits 1.0: */
-			if(accum.a>=1.0-1.0/256.0||lambda>=lambdaMax)
+			if(accum.a>=1.0-1.0/256.0||lambda>=lambdaEnd)
 				break;
 			
 			/* Advance the sample position: */
-			samplePos+=dcDir;
 			lambda+=1.0;
 			}
 		}